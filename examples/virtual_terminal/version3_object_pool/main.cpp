@@ -145,17 +145,18 @@ int main()
 	TestDeviceNAME.set_device_class_instance(0);
 	TestDeviceNAME.set_manufacturer_code(1407);
 
-	std::vector<std::uint8_t> testPool = isobus::IOPFileInterface::read_iop_file("VT3TestPool.iop");
+	// Map the file instead of reading it, the pool is uploaded straight from the mapping
+	isobus::MappedIOPFile testPool("VT3TestPool.iop");
 
-	if (testPool.empty())
+	if (!testPool.is_valid())
 	{
 		std::cout << "Failed to load object pool from VT3TestPool.iop" << std::endl;
 		return -3;
 	}
 	std::cout << "Loaded object pool from VT3TestPool.iop" << std::endl;
 
-	// Generate a unique version string for this object pool (this is optional, and is entirely application specific behavior)
-	std::string objectPoolHash = isobus::IOPFileInterface::hash_object_pool_to_version(testPool);
+	// A unique version string for this object pool is generated while loading it (using it is optional, and is entirely application specific behavior)
+	const std::string &objectPoolHash = testPool.get_version();
 
 	const isobus::NAMEFilter filterVirtualTerminal(isobus::NAME::NAMEParameters::FunctionCode, static_cast<std::uint8_t>(isobus::NAME::Function::VirtualTerminal));
 	const std::vector<isobus::NAMEFilter> vtNameFilters = { filterVirtualTerminal };
@@ -163,7 +164,7 @@ int main()
 	auto TestPartnerVT = isobus::CANNetworkManager::CANNetwork.create_partnered_control_function(0, vtNameFilters);
 
 	virtualTerminalClient = std::make_shared<isobus::VirtualTerminalClient>(TestPartnerVT, TestInternalECU);
-	virtualTerminalClient->set_object_pool(0, testPool.data(), testPool.size(), objectPoolHash);
+	virtualTerminalClient->set_object_pool(0, testPool.get_data(), objectPoolHash);
 	virtualTerminalClient->get_vt_soft_key_event_dispatcher().add_listener(handle_softkey_event);
 	virtualTerminalClient->get_vt_button_event_dispatcher().add_listener(handle_button_event);
 	virtualTerminalClient->initialize(true);
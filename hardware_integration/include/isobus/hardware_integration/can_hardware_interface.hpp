@@ -15,6 +15,7 @@
 #include "isobus/isobus/can_message_frame.hpp"
 #include "isobus/utility/event_dispatcher.hpp"
 
+#include <array>
 #include <atomic>
 #include <cstdint>
 #include <cstring>
@@ -36,6 +37,17 @@ namespace isobus
 	class CANHardwareInterface
 	{
 	public:
+		/// @brief The number of transmit lanes per channel, one for each value of the 3 bit identifier priority
+		static constexpr std::uint8_t NUMBER_OF_TRANSMIT_LANES = 8;
+
+		/// @brief Counters for one transmit lane of a CAN channel
+		struct TransmitLaneStatistics
+		{
+			std::uint32_t framesQueued = 0; ///< The number of frames accepted into the lane
+			std::uint32_t queueFullCount = 0; ///< The number of frames refused because the lane was full
+			std::uint32_t framesDropped = 0; ///< The number of accepted frames discarded before reaching the hardware, for example when the interface was stopped
+		};
+
 		/// @brief Returns the number of configured CAN channels that the class is managing
 		/// @returns The number of configured CAN channels that the class is managing
 		static std::uint8_t get_number_of_can_channels();
@@ -46,7 +58,7 @@ namespace isobus
 		/// already configured, it will delete the unneeded `CanHardware` objects.
 		/// @note The function will fail if the channel is already assigned to a driver or the interface is already started
 		/// @param value The number of CAN channels to manage
-		/// @param queueCapacity The capacity of the transmit and receive queues
+		/// @param queueCapacity The capacity of the receive queue and of each transmit lane
 		/// @returns `true` if the channel count was set, otherwise `false`.
 		static bool set_number_of_can_channels(std::uint8_t value, std::size_t queueCapacity = 40);
 
@@ -81,10 +93,19 @@ namespace isobus
 		static bool is_running();
 
 		/// @brief Called externally, adds a message to a CAN channel's Tx queue
+		/// @details Safe to call from multiple threads. Frames are queued in a lane chosen by the priority bits of
+		/// their identifier, and higher priority lanes are always sent to the hardware first.
+		/// Frames of the same priority are sent in the order they were queued.
 		/// @param[in] frame The frame to add to the Tx queue
-		/// @returns `true` if the frame was accepted, otherwise `false` (maybe wrong channel assigned)
+		/// @returns `true` if the frame was accepted, otherwise `false` (maybe wrong channel assigned, or the lane is full)
 		static bool transmit_can_frame(const CANMessageFrame &frame);
 
+		/// @brief Returns the counters of one of a channel's transmit lanes
+		/// @param[in] channelIndex The channel to get the counters for
+		/// @param[in] priority The priority of the lane, 0 is the highest priority
+		/// @returns The counters of the lane, or all zeros if the channel or lane doesn't exist
+		static TransmitLaneStatistics get_transmit_lane_statistics(std::uint8_t channelIndex, std::uint8_t priority);
+
 		/// @brief Get the event dispatcher for when a CAN message frame is received from hardware event
 		/// @returns The event dispatcher which can be used to register callbacks/listeners to
 		static EventDispatcher<const CANMessageFrame &> &get_can_frame_received_event_dispatcher();
@@ -109,13 +130,38 @@ namespace isobus
 		/// @returns The interval between update calls in milliseconds
 		static std::uint32_t get_periodic_update_interval();
 
+		/// @brief Enables or disables updating the stack as soon as frames are received
+		/// @details Received frames are always handed to the stack right away, but are normally only processed
+		/// (and passed to your callbacks) on the next periodic update. When this is enabled, every batch of received
+		/// frames also triggers an update, so the latency from the bus to your callbacks no longer depends on the
+		/// periodic update interval. This costs some extra CPU time on a busy bus.
+		/// @param[in] value `true` to update the stack whenever frames are received, `false` to only update periodically
+		static void set_event_driven_update_enabled(bool value);
+
+		/// @brief Returns if the stack is updated as soon as frames are received
+		/// @returns `true` if the stack is updated whenever frames are received, otherwise `false`
+		static bool get_event_driven_update_enabled();
+
+		/// @brief Enables or disables serving all pollable drivers from a single receive thread
+		/// @details Normally each channel has its own receive thread. When this is enabled, channels whose driver
+		/// provides a file descriptor (see CANHardwarePlugin::get_file_descriptor) are instead waited on together
+		/// using `epoll` by one thread. Channels with other drivers keep their own thread. Only supported on Linux.
+		/// @note The function will fail if the interface is already started, or if the platform doesn't support it
+		/// @param[in] value `true` to share a receive thread between pollable drivers, otherwise `false`
+		/// @returns `true` if the setting was changed, otherwise `false`
+		static bool set_receive_multiplexing_enabled(bool value);
+
+		/// @brief Returns if pollable drivers are served by a single receive thread
+		/// @returns `true` if receive multiplexing is enabled, otherwise `false`
+		static bool get_receive_multiplexing_enabled();
+
 	private:
 		/// @brief Stores the data for a single CAN channel
 		class CANHardware
 		{
 		public:
 			/// @brief Constructor for the CANHardware
-			/// @param[in] queueCapacity The capacity of the transmit and receive queues
+			/// @param[in] queueCapacity The capacity of the receive queue and of each transmit lane
 			explicit CANHardware(std::size_t queueCapacity);
 
 			/// @brief Destructor for the CANHardware
@@ -129,14 +175,30 @@ namespace isobus
 			/// @returns `true` if the channel was stopped, otherwise `false`
 			bool stop();
 
-			/// @brief Try to transmit the frame to the hardware
-			/// @param[in] frame The frame to transmit
-			/// @returns `true` if the frame was transmitted, otherwise `false`
-			bool transmit_can_frame(const CANMessageFrame &frame) const;
+			/// @brief Try to transmit frames to the hardware
+			/// @param[in] frames The frames to transmit
+			/// @param[in] numberOfFrames The number of frames to transmit
+			/// @returns The number of frames that were transmitted, starting from the first one
+			std::size_t transmit_can_frames(const CANMessageFrame *frames, std::size_t numberOfFrames) const;
 
-			/// @brief Receives a frame from the hardware and adds it to the receive queue
-			/// @returns `true` if a frame was received, otherwise `false`
-			bool receive_can_frame();
+			/// @brief Adds a frame to the transmit lane matching its priority
+			/// @param[in] frame The frame to queue
+			/// @returns `true` if the frame was queued, otherwise `false` if the lane is full
+			bool queue_frame_for_transmit(const CANMessageFrame &frame);
+
+			/// @brief Sends queued frames to the hardware, highest priority lane first, until the lanes are empty or the hardware refuses a frame
+			void transmit_queued_frames();
+
+			/// @brief Discards all frames waiting in the transmit lanes, counting them as dropped
+			void clear_transmit_lanes();
+
+			/// @brief Receives as many frames as are available from the hardware, up to a batch, and adds them to the receive queue
+			/// @returns `true` if any frames were received, otherwise `false`
+			bool receive_can_frames();
+
+			/// @brief Returns if this channel is served by the shared receive thread instead of its own
+			/// @returns `true` if the channel should be served by the shared receive thread, otherwise `false`
+			bool uses_receive_multiplexer() const;
 
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
 			/// @brief Starts the receiving thread for this CAN channel
@@ -151,10 +213,26 @@ namespace isobus
 			std::unique_ptr<std::thread> receiveMessageThread; ///< Thread to manage getting messages from a CAN channel
 			bool receiveThreadRunning = false; ///< Flag to indicate if the receive thread is running
 #endif
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO && defined __linux__
+			std::atomic_bool receiveMultiplexingPaused = { false }; ///< Set while the shared receive thread ignores this channel because its receive queue is full
+#endif
+
+			/// @brief A transmit queue for frames of a single priority, with its counters
+			struct TransmitLane
+			{
+				/// @brief Constructor for a TransmitLane
+				/// @param[in] queueCapacity The capacity of the lane
+				explicit TransmitLane(std::size_t queueCapacity);
+
+				LockFreeMultiProducerQueue<CANMessageFrame> queue; ///< The frames waiting to be transmitted
+				std::atomic<std::uint32_t> framesQueued = { 0 }; ///< The number of frames accepted into the lane
+				std::atomic<std::uint32_t> queueFullCount = { 0 }; ///< The number of frames refused because the lane was full
+				std::atomic<std::uint32_t> framesDropped = { 0 }; ///< The number of accepted frames that were discarded before transmission
+			};
 
 			std::shared_ptr<CANHardwarePlugin> frameHandler; ///< The CAN driver to use for a CAN channel
 
-			LockFreeQueue<CANMessageFrame> messagesToBeTransmittedQueue; ///< Transmit message queue for a CAN channel
+			std::array<std::unique_ptr<TransmitLane>, NUMBER_OF_TRANSMIT_LANES> transmitLanes; ///< Transmit queues for a CAN channel, indexed by priority
 			LockFreeQueue<CANMessageFrame> receivedMessagesQueue; ///< Receive message queue for a CAN channel
 		};
 
@@ -165,6 +243,12 @@ namespace isobus
 		/// @brief The default update interval for the CAN stack. Mostly arbitrary
 		static constexpr std::uint32_t PERIODIC_UPDATE_INTERVAL = 4;
 
+		/// @brief The maximum number of received frames read from the hardware, or passed to the stack, at once
+		static constexpr std::size_t RECEIVE_BATCH_SIZE = 32;
+
+		/// @brief The maximum number of frames written to the hardware at once
+		static constexpr std::size_t TRANSMIT_BATCH_SIZE = 32;
+
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
 		/// @brief Deconstructor for the CANHardwareInterface class for stopping threads
 		virtual ~CANHardwareInterface();
@@ -178,9 +262,35 @@ namespace isobus
 		/// @brief Stops all threads related to the hardware interface
 		static void stop_threads();
 
+		/// @brief Wakes up the main thread, for example because frames were received or queued for transmission
+		static void notify_update_thread();
+
 		static std::unique_ptr<std::thread> updateThread; ///< The main thread
 		static std::condition_variable updateThreadWakeupCondition; ///< A condition variable to allow for signaling the `updateThread` to wakeup
+		static bool updateThreadWakeupRequested; ///< Set when the `updateThread` should run, so a wakeup isn't lost while it is busy. Protected by `updateMutex`
+#endif
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO && defined __linux__
+		/// @brief Registers the pollable channels with `epoll` and starts the shared receive thread
+		static void start_receive_multiplexer();
+
+		/// @brief Stops the shared receive thread and releases the `epoll` instance
+		static void stop_receive_multiplexer();
+
+		/// @brief The shared receive thread loop, waits for any of the registered channels to have a frame
+		static void receive_multiplexer_thread_function();
+
+		/// @brief Starts or stops waiting for frames on a channel in the shared receive thread
+		/// @details Does nothing if the shared receive thread isn't running
+		/// @param[in] channel The channel to change, must be registered with the shared receive thread
+		/// @param[in] enabled `true` to wait for frames on the channel, `false` to ignore it until re-enabled
+		static void set_receive_multiplexing_events(CANHardware &channel, bool enabled);
+
+		static std::unique_ptr<std::thread> receiveMultiplexerThread; ///< The shared receive thread for pollable channels
+		static int receiveMultiplexerDescriptor; ///< The `epoll` instance used by the shared receive thread
+		static std::atomic_bool receiveMultiplexerRunning; ///< Flag to indicate if the shared receive thread is running
 #endif
+		static std::atomic_bool eventDrivenUpdateEnabled; ///< Stores if the stack is updated whenever frames are received
+		static bool receiveMultiplexingEnabled; ///< Stores if pollable channels share a receive thread
 		static std::uint32_t lastUpdateTimestamp; ///< The last time the network manager was updated
 		static std::uint32_t periodicUpdateInterval; ///< The period between calls to the network manager update function in milliseconds
 		static EventDispatcher<const CANMessageFrame &> frameReceivedEventDispatcher; ///< The event dispatcher for when a CAN message frame is received from hardware event
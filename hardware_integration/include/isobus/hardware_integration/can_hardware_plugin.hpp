@@ -11,6 +11,8 @@
 
 #include "isobus/isobus/can_message_frame.hpp"
 
+#include <cstddef>
+
 namespace isobus
 {
 	//================================================================================================
@@ -43,6 +45,48 @@ namespace isobus
 		/// @param[in] canFrame The frame to write to the bus
 		/// @returns `true` if the frame was written, otherwise `false`
 		virtual bool write_frame(const isobus::CANMessageFrame &canFrame) = 0;
+
+		/// @brief Reads several frames from the bus at once
+		/// @details Drivers that can receive several frames with one call to the hardware should override this.
+		/// The default implementation reads a single frame with `read_frame`, so it blocks in the same way.
+		/// @param[out] canFrames The buffer to read the frames into
+		/// @param[in] maxNumberOfFrames The number of frames that fit in the buffer
+		/// @returns The number of frames that were read
+		virtual std::size_t read_frames(isobus::CANMessageFrame *canFrames, std::size_t maxNumberOfFrames)
+		{
+			std::size_t retVal = 0;
+			if ((nullptr != canFrames) && (0 != maxNumberOfFrames) && read_frame(canFrames[0]))
+			{
+				retVal = 1;
+			}
+			return retVal;
+		}
+
+		/// @brief Writes several frames to the bus at once
+		/// @details Drivers that can send several frames with one call to the hardware should override this.
+		/// The default implementation writes the frames one by one with `write_frame`, until one fails.
+		/// @param[in] canFrames The frames to write to the bus
+		/// @param[in] numberOfFrames The number of frames to write
+		/// @returns The number of frames that were written, starting from the first one
+		virtual std::size_t write_frames(const isobus::CANMessageFrame *canFrames, std::size_t numberOfFrames)
+		{
+			std::size_t retVal = 0;
+			while ((nullptr != canFrames) && (retVal < numberOfFrames) && write_frame(canFrames[retVal]))
+			{
+				retVal++;
+			}
+			return retVal;
+		}
+
+		/// @brief Returns a file descriptor that becomes readable when a frame can be read, if the driver has one
+		/// @details Drivers that return a descriptor here can be served by a shared receive thread,
+		/// see CANHardwareInterface::set_receive_multiplexing_enabled.
+		/// When the descriptor is readable, `read_frame` must return a frame without blocking.
+		/// @returns The file descriptor, or -1 if the driver doesn't have one (the default)
+		virtual int get_file_descriptor() const
+		{
+			return -1;
+		}
 	};
 }
 #endif // CAN_HARDEWARE_PLUGIN_HPP
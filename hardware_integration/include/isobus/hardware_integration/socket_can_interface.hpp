@@ -17,6 +17,8 @@
 #include "isobus/isobus/can_message_frame.hpp"
 
 struct sockaddr_can; ///< Forward declare the linux sockaddr_can struct
+struct can_frame; ///< Forward declare the linux can_frame struct
+struct msghdr; ///< Forward declare the linux msghdr struct
 
 namespace isobus
 {
@@ -59,17 +61,56 @@ namespace isobus
 		/// @returns `true` if a CAN frame was read, otherwise `false`
 		bool read_frame(isobus::CANMessageFrame &canFrame) override;
 
+		/// @brief Reads the frames that are waiting in the socket with a single `recvmmsg` call
+		/// @details Blocks like read_frame until at least one frame is available, or the wait times out.
+		/// @param[out] canFrames The buffer to read the frames into
+		/// @param[in] maxNumberOfFrames The number of frames that fit in the buffer
+		/// @returns The number of frames that were read
+		std::size_t read_frames(isobus::CANMessageFrame *canFrames, std::size_t maxNumberOfFrames) override;
+
 		/// @brief Writes a frame to the bus (synchronous)
 		/// @param[in] canFrame The frame to write to the bus
 		/// @returns `true` if the frame was written, otherwise `false`
 		bool write_frame(const isobus::CANMessageFrame &canFrame) override;
 
+		/// @brief Writes several frames to the bus with a single `sendmmsg` call
+		/// @param[in] canFrames The frames to write to the bus
+		/// @param[in] numberOfFrames The number of frames to write
+		/// @returns The number of frames that were written, starting from the first one
+		std::size_t write_frames(const isobus::CANMessageFrame *canFrames, std::size_t numberOfFrames) override;
+
+		/// @brief Returns the file descriptor of the socket, which can be polled for received frames
+		/// @returns The file descriptor of the socket, or -1 if the socket isn't open
+		int get_file_descriptor() const override;
+
 		/// @brief Changes the name of the device to use, which only works if the device is not open
 		/// @param[in] newName The new name for the device (such as "can0" or "vcan0")
 		/// @returns `true` if the name was changed, otherwise `false` (if the device is open this will return false)
 		bool set_name(const std::string &newName);
 
 	private:
+		/// @brief Waits until the socket has a frame to read, and recovers the socket if it reports an error or the wait times out
+		/// @returns `true` if a frame can be read, otherwise `false`
+		bool wait_until_readable();
+
+		/// @brief Converts a frame received from the socket, including its timestamp, into a frame for the stack
+		/// @param[in] rxFrame The frame received from the socket
+		/// @param[in] message The message header the frame was received with, which holds the timestamps
+		/// @param[out] canFrame The converted frame
+		/// @returns `true` if the frame was converted, or `false` if it is an error frame
+		bool convert_received_frame(const struct can_frame &rxFrame, struct msghdr &message, isobus::CANMessageFrame &canFrame) const;
+
+		/// @brief Converts a frame from the stack into a frame for the socket
+		/// @param[in] canFrame The frame from the stack
+		/// @param[out] txFrame The converted frame
+		static void convert_transmit_frame(const isobus::CANMessageFrame &canFrame, struct can_frame &txFrame);
+
+		/// @brief Recovers the socket after a failed write, if possible
+		void handle_write_failure();
+
+		/// @brief The maximum number of frames read or written with a single system call
+		static constexpr std::size_t MAX_FRAMES_PER_SYSTEM_CALL = 32;
+
 		struct sockaddr_can *pCANDevice; ///< The structure for CAN sockets
 		std::string name; ///< The device name
 		int fileDescriptor; ///< File descriptor for the socket
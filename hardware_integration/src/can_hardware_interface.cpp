@@ -8,19 +8,34 @@
 /// @copyright 2024 The Open-Agriculture Developers
 //================================================================================================
 #include "isobus/hardware_integration/can_hardware_interface.hpp"
+#include "isobus/isobus/can_identifier.hpp"
 #include "isobus/isobus/can_stack_logger.hpp"
 #include "isobus/utility/system_timing.hpp"
 #include "isobus/utility/to_string.hpp"
 
 #include <algorithm>
+#include <array>
 #include <limits>
 
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO && defined __linux__
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
+
 namespace isobus
 {
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
 	std::unique_ptr<std::thread> CANHardwareInterface::updateThread;
 	std::condition_variable CANHardwareInterface::updateThreadWakeupCondition;
+	bool CANHardwareInterface::updateThreadWakeupRequested = false;
+#endif
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO && defined __linux__
+	std::unique_ptr<std::thread> CANHardwareInterface::receiveMultiplexerThread;
+	int CANHardwareInterface::receiveMultiplexerDescriptor = -1;
+	std::atomic_bool CANHardwareInterface::receiveMultiplexerRunning = { false };
 #endif
+	std::atomic_bool CANHardwareInterface::eventDrivenUpdateEnabled = { false };
+	bool CANHardwareInterface::receiveMultiplexingEnabled = false;
 	std::uint32_t CANHardwareInterface::periodicUpdateInterval = PERIODIC_UPDATE_INTERVAL;
 	std::uint32_t CANHardwareInterface::lastUpdateTimestamp;
 
@@ -35,9 +50,18 @@ namespace isobus
 
 	CANHardwareInterface CANHardwareInterface::SINGLETON;
 
+	CANHardwareInterface::CANHardware::TransmitLane::TransmitLane(std::size_t queueCapacity) :
+	  queue(queueCapacity)
+	{
+	}
+
 	CANHardwareInterface::CANHardware::CANHardware(std::size_t queueCapacity) :
-	  messagesToBeTransmittedQueue(queueCapacity), receivedMessagesQueue(queueCapacity)
+	  receivedMessagesQueue(queueCapacity)
 	{
+		for (auto &lane : transmitLanes)
+		{
+			lane.reset(new TransmitLane(queueCapacity));
+		}
 	}
 
 	CANHardwareInterface::CANHardware::~CANHardware()
@@ -56,7 +80,10 @@ namespace isobus
 			if (frameHandler->get_is_valid())
 			{
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
-				start_threads();
+				if (!uses_receive_multiplexer())
+				{
+					start_threads();
+				}
 #endif
 				retVal = true;
 			}
@@ -73,34 +100,102 @@ namespace isobus
 		{
 			frameHandler = nullptr;
 		}
-		messagesToBeTransmittedQueue.clear();
+		clear_transmit_lanes();
 		receivedMessagesQueue.clear();
 		return false;
 	}
 
-	bool CANHardwareInterface::CANHardware::transmit_can_frame(const CANMessageFrame &frame) const
+	std::size_t CANHardwareInterface::CANHardware::transmit_can_frames(const CANMessageFrame *frames, std::size_t numberOfFrames) const
 	{
-		if ((nullptr != frameHandler) && frameHandler->get_is_valid() && frameHandler->write_frame(frame))
+		if ((nullptr != frameHandler) && frameHandler->get_is_valid())
 		{
+			return frameHandler->write_frames(frames, numberOfFrames);
+		}
+		return 0;
+	}
+
+	bool CANHardwareInterface::CANHardware::queue_frame_for_transmit(const CANMessageFrame &frame)
+	{
+		// Standard identifiers have no priority bits, and are treated as the highest priority like CANIdentifier does
+		TransmitLane &lane = *transmitLanes[static_cast<std::uint8_t>(CANIdentifier(frame.identifier).get_priority())];
+
+		if (lane.queue.push(frame))
+		{
+			lane.framesQueued++;
 			return true;
 		}
+		lane.queueFullCount++;
 		return false;
 	}
 
-	bool CANHardwareInterface::CANHardware::receive_can_frame()
+	void CANHardwareInterface::CANHardware::transmit_queued_frames()
+	{
+		std::uint8_t laneIndex = 0;
+		std::array<isobus::CANMessageFrame, TRANSMIT_BATCH_SIZE> frameBatch;
+
+		while (laneIndex < NUMBER_OF_TRANSMIT_LANES)
+		{
+			TransmitLane &lane = *transmitLanes[laneIndex];
+			const std::size_t numberOfFramesInBatch = lane.queue.peek_many(frameBatch.data(), frameBatch.size());
+			if (0 == numberOfFramesInBatch)
+			{
+				laneIndex++;
+				continue;
+			}
+
+			const std::size_t numberOfFramesTransmitted = transmit_can_frames(frameBatch.data(), numberOfFramesInBatch);
+			for (std::size_t i = 0; i < numberOfFramesTransmitted; i++)
+			{
+				frameTransmittedEventDispatcher.invoke(frameBatch[i]);
+				on_transmit_can_message_frame_from_hardware(frameBatch[i]);
+			}
+			lane.queue.pop_many(numberOfFramesTransmitted);
+
+			if (numberOfFramesTransmitted < numberOfFramesInBatch)
+			{
+				// The hardware is busy, try again on the next update
+				break;
+			}
+
+			// Something of a higher priority may have been queued in the meantime
+			laneIndex = 0;
+		}
+	}
+
+	void CANHardwareInterface::CANHardware::clear_transmit_lanes()
+	{
+		for (auto &lane : transmitLanes)
+		{
+			while (lane->queue.pop())
+			{
+				lane->framesDropped++;
+			}
+		}
+	}
+
+	bool CANHardwareInterface::CANHardware::receive_can_frames()
 	{
-		if ((nullptr != frameHandler) && frameHandler->get_is_valid() && (!receivedMessagesQueue.is_full()))
+		const std::size_t availableSpace = receivedMessagesQueue.available_space();
+
+		if ((nullptr != frameHandler) && frameHandler->get_is_valid() && (0 != availableSpace))
 		{
-			CANMessageFrame frame;
-			if (frameHandler->read_frame(frame))
+			std::array<CANMessageFrame, RECEIVE_BATCH_SIZE> frameBatch;
+			const std::size_t numberOfFramesRead = frameHandler->read_frames(frameBatch.data(), std::min(availableSpace, frameBatch.size()));
+
+			for (std::size_t i = 0; i < numberOfFramesRead; i++)
 			{
-				receivedMessagesQueue.push(frame);
-				return true; // Indicate that a frame was read
+				receivedMessagesQueue.push(frameBatch[i]);
 			}
+			return (0 != numberOfFramesRead); // Indicate if any frames were read
 		}
 		return false;
 	}
 
+	bool CANHardwareInterface::CANHardware::uses_receive_multiplexer() const
+	{
+		return receiveMultiplexingEnabled && (nullptr != frameHandler) && (frameHandler->get_file_descriptor() >= 0);
+	}
+
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
 	CANHardwareInterface::~CANHardwareInterface()
 	{
@@ -135,14 +230,14 @@ namespace isobus
 		{
 			if ((nullptr != frameHandler) && frameHandler->get_is_valid())
 			{
-				if (!receive_can_frame())
+				if (!receive_can_frames())
 				{
 					// There was no frame to receive, so if any other thread wants to do something, let it.
 					std::this_thread::yield();
 				}
 				else
 				{
-					CANHardwareInterface::updateThreadWakeupCondition.notify_all();
+					CANHardwareInterface::notify_update_thread();
 				}
 			}
 			else
@@ -260,6 +355,12 @@ namespace isobus
 		std::for_each(hardwareChannels.begin(), hardwareChannels.end(), [](const std::unique_ptr<CANHardware> &channel) {
 			channel->start();
 		});
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO && defined __linux__
+		if (receiveMultiplexingEnabled)
+		{
+			start_receive_multiplexer();
+		}
+#endif
 
 		started = true;
 		return true;
@@ -314,17 +415,31 @@ namespace isobus
 			return false;
 		}
 
-		if (channel->frameHandler->get_is_valid())
+		if (channel->frameHandler->get_is_valid() && channel->queue_frame_for_transmit(frame))
 		{
-			channel->messagesToBeTransmittedQueue.push(frame);
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
-			updateThreadWakeupCondition.notify_all();
+			notify_update_thread();
 #endif
 			return true;
 		}
 		return false;
 	}
 
+	CANHardwareInterface::TransmitLaneStatistics CANHardwareInterface::get_transmit_lane_statistics(std::uint8_t channelIndex, std::uint8_t priority)
+	{
+		TransmitLaneStatistics retVal;
+		LOCK_GUARD(Mutex, hardwareChannelsMutex);
+
+		if ((channelIndex < hardwareChannels.size()) && (priority < NUMBER_OF_TRANSMIT_LANES))
+		{
+			const CANHardware::TransmitLane &lane = *hardwareChannels[channelIndex]->transmitLanes[priority];
+			retVal.framesQueued = lane.framesQueued;
+			retVal.queueFullCount = lane.queueFullCount;
+			retVal.framesDropped = lane.framesDropped;
+		}
+		return retVal;
+	}
+
 	EventDispatcher<const CANMessageFrame &> &CANHardwareInterface::get_can_frame_received_event_dispatcher()
 	{
 		return frameReceivedEventDispatcher;
@@ -350,10 +465,50 @@ namespace isobus
 		return periodicUpdateInterval;
 	}
 
+	void CANHardwareInterface::set_event_driven_update_enabled(bool value)
+	{
+		eventDrivenUpdateEnabled = value;
+	}
+
+	bool CANHardwareInterface::get_event_driven_update_enabled()
+	{
+		return eventDrivenUpdateEnabled;
+	}
+
+	bool CANHardwareInterface::set_receive_multiplexing_enabled(bool value)
+	{
+		LOCK_GUARD(Mutex, hardwareChannelsMutex);
+
+		if (started)
+		{
+			LOG_ERROR("[HardwareInterface] Cannot change receive multiplexing after interface is started.");
+			return false;
+		}
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO && defined __linux__
+		receiveMultiplexingEnabled = value;
+		return true;
+#else
+		if (value)
+		{
+			LOG_ERROR("[HardwareInterface] Receive multiplexing is not supported on this platform.");
+			return false;
+		}
+		return true;
+#endif
+	}
+
+	bool CANHardwareInterface::get_receive_multiplexing_enabled()
+	{
+		return receiveMultiplexingEnabled;
+	}
+
 	void CANHardwareInterface::update()
 	{
 		if (started)
 		{
+			bool framesReceived = false;
+
 			{
 				// Stage 1 - Receiving messages from hardware
 				LOCK_GUARD(Mutex, hardwareChannelsMutex);
@@ -361,22 +516,41 @@ namespace isobus
 				{
 #if defined CAN_STACK_DISABLE_THREADS || defined ARDUINO
 					// If we don't have threads, we need to poll the hardware for messages here
-					hardwareChannels[i]->receive_can_frame();
+					hardwareChannels[i]->receive_can_frames();
 #endif
 
-					isobus::CANMessageFrame frame;
-					while (hardwareChannels[i]->receivedMessagesQueue.peek(frame))
+					// Pass frames on to the stack in batches, so it only needs to lock its queue once per batch
+					std::array<isobus::CANMessageFrame, RECEIVE_BATCH_SIZE> frameBatch;
+					std::size_t numberOfFramesInBatch = 0;
+					do
+					{
+						numberOfFramesInBatch = 0;
+						while ((numberOfFramesInBatch < frameBatch.size()) &&
+						       hardwareChannels[i]->receivedMessagesQueue.peek(frameBatch[numberOfFramesInBatch]))
+						{
+							isobus::CANMessageFrame &frame = frameBatch[numberOfFramesInBatch];
+							frame.channel = i;
+							frameReceivedEventDispatcher.invoke(frame);
+							hardwareChannels[i]->receivedMessagesQueue.pop();
+							numberOfFramesInBatch++;
+						}
+						receive_can_message_frames_from_hardware(frameBatch.data(), numberOfFramesInBatch);
+						framesReceived = framesReceived || (0 != numberOfFramesInBatch);
+					} while (frameBatch.size() == numberOfFramesInBatch);
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO && defined __linux__
+					if (hardwareChannels[i]->receiveMultiplexingPaused.exchange(false))
 					{
-						frame.channel = i;
-						frameReceivedEventDispatcher.invoke(frame);
-						receive_can_message_frame_from_hardware(frame);
-						hardwareChannels[i]->receivedMessagesQueue.pop();
+						// The receive queue has room again
+						set_receive_multiplexing_events(*hardwareChannels[i], true);
 					}
+#endif
 				}
 			}
 
 			// Stage 2 - Update stack. That will fill up the transmit queues if needed
-			if (SystemTiming::time_expired_ms(lastUpdateTimestamp, periodicUpdateInterval))
+			if (SystemTiming::time_expired_ms(lastUpdateTimestamp, periodicUpdateInterval) ||
+			    (framesReceived && eventDrivenUpdateEnabled))
 			{
 				periodicUpdateEventDispatcher.invoke();
 				periodic_update_from_hardware();
@@ -387,20 +561,7 @@ namespace isobus
 			{
 				LOCK_GUARD(Mutex, hardwareChannelsMutex);
 				std::for_each(hardwareChannels.begin(), hardwareChannels.end(), [](const std::unique_ptr<CANHardware> &channel) {
-					isobus::CANMessageFrame frame;
-					while (channel->messagesToBeTransmittedQueue.peek(frame))
-					{
-						if (channel->transmit_can_frame(frame))
-						{
-							frameTransmittedEventDispatcher.invoke(frame);
-							on_transmit_can_message_frame_from_hardware(frame);
-							channel->messagesToBeTransmittedQueue.pop();
-						}
-						else
-						{
-							break;
-						}
-					}
+					channel->transmit_queued_frames();
 				});
 			}
 		}
@@ -415,12 +576,24 @@ namespace isobus
 
 		while (started)
 		{
-			std::unique_lock<std::mutex> threadLock(updateMutex);
-			updateThreadWakeupCondition.wait_for(threadLock, std::chrono::milliseconds(periodicUpdateInterval)); // Update with at least the periodic interval
+			{
+				std::unique_lock<std::mutex> threadLock(updateMutex);
+				updateThreadWakeupCondition.wait_for(threadLock, std::chrono::milliseconds(periodicUpdateInterval), []() { return updateThreadWakeupRequested || !started; }); // Update with at least the periodic interval
+				updateThreadWakeupRequested = false;
+			}
 			update();
 		}
 	}
 
+	void CANHardwareInterface::notify_update_thread()
+	{
+		{
+			LOCK_GUARD(Mutex, updateMutex);
+			updateThreadWakeupRequested = true;
+		}
+		updateThreadWakeupCondition.notify_all();
+	}
+
 	void CANHardwareInterface::start_threads()
 	{
 		started = true;
@@ -437,11 +610,123 @@ namespace isobus
 		{
 			if (updateThread->joinable())
 			{
-				updateThreadWakeupCondition.notify_all();
+				notify_update_thread();
 				updateThread->join();
 			}
 			updateThread = nullptr;
 		}
+#if defined __linux__
+		stop_receive_multiplexer();
+#endif
+	}
+#endif
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO && defined __linux__
+	void CANHardwareInterface::start_receive_multiplexer()
+	{
+		receiveMultiplexerDescriptor = epoll_create1(EPOLL_CLOEXEC);
+		if (receiveMultiplexerDescriptor < 0)
+		{
+			LOG_ERROR("[HardwareInterface] Unable to create the epoll instance, falling back to a receive thread per channel.");
+		}
+
+		std::size_t numberOfRegisteredChannels = 0;
+		for (const auto &channel : hardwareChannels)
+		{
+			if ((nullptr == channel->frameHandler) || (!channel->frameHandler->get_is_valid()) || (!channel->uses_receive_multiplexer()))
+			{
+				continue;
+			}
+
+			struct epoll_event event = {};
+			event.events = EPOLLIN;
+			event.data.ptr = channel.get();
+			channel->receiveMultiplexingPaused = false;
+			if ((receiveMultiplexerDescriptor >= 0) &&
+			    (0 == epoll_ctl(receiveMultiplexerDescriptor, EPOLL_CTL_ADD, channel->frameHandler->get_file_descriptor(), &event)))
+			{
+				numberOfRegisteredChannels++;
+			}
+			else
+			{
+				channel->start_threads();
+			}
+		}
+
+		if (0 != numberOfRegisteredChannels)
+		{
+			receiveMultiplexerRunning = true;
+			receiveMultiplexerThread.reset(new std::thread(receive_multiplexer_thread_function));
+		}
+	}
+
+	void CANHardwareInterface::stop_receive_multiplexer()
+	{
+		receiveMultiplexerRunning = false;
+		if (nullptr != receiveMultiplexerThread)
+		{
+			if (receiveMultiplexerThread->joinable())
+			{
+				receiveMultiplexerThread->join();
+			}
+			receiveMultiplexerThread = nullptr;
+		}
+		if (receiveMultiplexerDescriptor >= 0)
+		{
+			close(receiveMultiplexerDescriptor);
+			receiveMultiplexerDescriptor = -1;
+		}
+	}
+
+	void CANHardwareInterface::receive_multiplexer_thread_function()
+	{
+		constexpr int MAX_EVENTS = 16;
+		constexpr int WAIT_TIMEOUT_MS = 100; // Bounds how long stopping the thread can take
+		std::array<struct epoll_event, MAX_EVENTS> events;
+
+		while (receiveMultiplexerRunning)
+		{
+			const int numberOfEvents = epoll_wait(receiveMultiplexerDescriptor, events.data(), MAX_EVENTS, WAIT_TIMEOUT_MS);
+			bool framesReceived = false;
+
+			for (int i = 0; i < numberOfEvents; i++)
+			{
+				// Read what fits in one batch, the descriptor stays readable while there are more
+				CANHardware *channel = static_cast<CANHardware *>(events[i].data.ptr);
+
+				if (channel->receive_can_frames())
+				{
+					framesReceived = true;
+				}
+				else if (0 == channel->receivedMessagesQueue.available_space())
+				{
+					// The descriptor stays readable until the update thread empties the queue, so stop waiting on it until then.
+					// The update thread waits on it again once it has passed the queued frames on to the stack.
+					set_receive_multiplexing_events(*channel, false);
+					channel->receiveMultiplexingPaused = true;
+					framesReceived = true;
+				}
+			}
+
+			if (framesReceived)
+			{
+				notify_update_thread();
+			}
+		}
+	}
+
+	void CANHardwareInterface::set_receive_multiplexing_events(CANHardware &channel, bool enabled)
+	{
+		struct epoll_event event = {};
+		event.events = enabled ? static_cast<std::uint32_t>(EPOLLIN) : 0;
+		event.data.ptr = &channel;
+
+		// The shared receive thread may have been stopped already, in which case there's nothing to change
+		if ((receiveMultiplexerDescriptor >= 0) &&
+		    (0 != epoll_ctl(receiveMultiplexerDescriptor, EPOLL_CTL_MOD, channel.frameHandler->get_file_descriptor(), &event)))
+		{
+			LOG_ERROR("[HardwareInterface] Unable to change the receive events of a channel.");
+		}
 	}
 #endif
 }
@@ -18,6 +18,7 @@
 #include <sys/time.h>
 #include <unistd.h>
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstdint>
 #include <cstring>
@@ -148,23 +149,17 @@ namespace isobus
 
 	bool SocketCANInterface::read_frame(isobus::CANMessageFrame &canFrame)
 	{
-		struct pollfd pollingFileDescriptor;
 		bool retVal = false;
 
-		pollingFileDescriptor.fd = fileDescriptor;
-		pollingFileDescriptor.events = POLLIN;
-		pollingFileDescriptor.revents = 0;
-
-		if (1 == poll(&pollingFileDescriptor, 1, 100))
+		if (wait_until_readable())
 		{
-			canFrame.timestamp_us = std::numeric_limits<std::uint64_t>::max();
-			struct can_frame txFrame;
+			struct can_frame rxFrame;
 			struct msghdr message;
 			struct iovec segment;
 
 			char lControlMessage[CMSG_SPACE(sizeof(struct timeval) + (3 * sizeof(struct timespec)) + sizeof(std::uint32_t))];
 
-			segment.iov_base = &txFrame;
+			segment.iov_base = &rxFrame;
 			segment.iov_len = sizeof(struct can_frame);
 			message.msg_iov = &segment;
 			message.msg_iovlen = 1;
@@ -176,54 +171,127 @@ namespace isobus
 
 			if (recvmsg(fileDescriptor, &message, 0) > 0)
 			{
-				if (0 == (txFrame.can_id & CAN_ERR_FLAG))
-				{
-					if (0 != (txFrame.can_id & CAN_EFF_FLAG))
-					{
-						canFrame.identifier = (txFrame.can_id & CAN_EFF_MASK);
-						canFrame.isExtendedFrame = true;
-					}
-					else
-					{
-						canFrame.identifier = (txFrame.can_id & CAN_SFF_MASK);
-						canFrame.isExtendedFrame = false;
-					}
-					canFrame.dataLength = txFrame.can_dlc;
-					memset(canFrame.data, 0, sizeof(canFrame.data));
-					memcpy(canFrame.data, txFrame.data, canFrame.dataLength);
+				retVal = convert_received_frame(rxFrame, message, canFrame);
+			}
+			else if (errno == ENETDOWN)
+			{
+				LOG_CRITICAL("[SocketCAN] " + get_device_name() + " interface is down.");
+				close();
+			}
+		}
+		return retVal;
+	}
 
-					for (struct cmsghdr *pControlMessage = CMSG_FIRSTHDR(&message); (nullptr != pControlMessage) && (SOL_SOCKET == pControlMessage->cmsg_level); pControlMessage = CMSG_NXTHDR(&message, pControlMessage))
-					{
-						switch (pControlMessage->cmsg_type)
-						{
-							case SO_TIMESTAMP:
-							{
-								struct timeval *time = (struct timeval *)CMSG_DATA(pControlMessage);
-
-								if (std::numeric_limits<std::uint64_t>::max() == canFrame.timestamp_us)
-								{
-									canFrame.timestamp_us = static_cast<std::uint64_t>(time->tv_usec) + (static_cast<std::uint64_t>(time->tv_sec) * 1000000);
-								}
-							}
-							break;
-
-							case SO_TIMESTAMPING:
-							{
-								struct timespec *time = (struct timespec *)(CMSG_DATA(pControlMessage));
-								canFrame.timestamp_us = (static_cast<std::uint64_t>(time[2].tv_nsec) / 1000) + (static_cast<std::uint64_t>(time[2].tv_sec) * 1000000);
-							}
-							break;
-						}
-					}
-					retVal = true;
+	std::size_t SocketCANInterface::read_frames(isobus::CANMessageFrame *canFrames, std::size_t maxNumberOfFrames)
+	{
+		std::size_t retVal = 0;
+
+		if ((nullptr != canFrames) && (0 != maxNumberOfFrames) && wait_until_readable())
+		{
+			typedef char ControlMessageBuffer[CMSG_SPACE(sizeof(struct timeval) + (3 * sizeof(struct timespec)) + sizeof(std::uint32_t))];
+			std::array<struct can_frame, MAX_FRAMES_PER_SYSTEM_CALL> rxFrames;
+			std::array<struct mmsghdr, MAX_FRAMES_PER_SYSTEM_CALL> messages;
+			std::array<struct iovec, MAX_FRAMES_PER_SYSTEM_CALL> segments;
+			std::array<ControlMessageBuffer, MAX_FRAMES_PER_SYSTEM_CALL> controlMessages;
+			const std::size_t numberOfFramesToRead = (maxNumberOfFrames < MAX_FRAMES_PER_SYSTEM_CALL) ? maxNumberOfFrames : MAX_FRAMES_PER_SYSTEM_CALL;
+
+			for (std::size_t i = 0; i < numberOfFramesToRead; i++)
+			{
+				segments[i].iov_base = &rxFrames[i];
+				segments[i].iov_len = sizeof(struct can_frame);
+				memset(&messages[i], 0, sizeof(struct mmsghdr));
+				messages[i].msg_hdr.msg_iov = &segments[i];
+				messages[i].msg_hdr.msg_iovlen = 1;
+				messages[i].msg_hdr.msg_control = &controlMessages[i];
+				messages[i].msg_hdr.msg_controllen = sizeof(ControlMessageBuffer);
+			}
+
+			// The socket was readable, so at least one frame is waiting. Take whatever else is there without blocking.
+			const int numberOfMessages = recvmmsg(fileDescriptor, messages.data(), static_cast<unsigned int>(numberOfFramesToRead), MSG_DONTWAIT, nullptr);
+
+			for (int i = 0; i < numberOfMessages; i++)
+			{
+				if (convert_received_frame(rxFrames[i], messages[i].msg_hdr, canFrames[retVal]))
+				{
+					retVal++;
 				}
 			}
-			else if (errno == ENETDOWN)
+
+			if ((numberOfMessages < 0) && (errno == ENETDOWN))
 			{
 				LOG_CRITICAL("[SocketCAN] " + get_device_name() + " interface is down.");
 				close();
 			}
 		}
+		return retVal;
+	}
+
+	bool SocketCANInterface::write_frame(const isobus::CANMessageFrame &canFrame)
+	{
+		struct can_frame txFrame;
+		bool retVal = false;
+
+		convert_transmit_frame(canFrame, txFrame);
+
+		if (write(fileDescriptor, &txFrame, sizeof(struct can_frame)) > 0)
+		{
+			retVal = true;
+		}
+		else
+		{
+			handle_write_failure();
+		}
+		return retVal;
+	}
+
+	std::size_t SocketCANInterface::write_frames(const isobus::CANMessageFrame *canFrames, std::size_t numberOfFrames)
+	{
+		std::size_t retVal = 0;
+
+		if ((nullptr != canFrames) && (0 != numberOfFrames))
+		{
+			std::array<struct can_frame, MAX_FRAMES_PER_SYSTEM_CALL> txFrames;
+			std::array<struct mmsghdr, MAX_FRAMES_PER_SYSTEM_CALL> messages;
+			std::array<struct iovec, MAX_FRAMES_PER_SYSTEM_CALL> segments;
+			const std::size_t numberOfFramesToWrite = (numberOfFrames < MAX_FRAMES_PER_SYSTEM_CALL) ? numberOfFrames : MAX_FRAMES_PER_SYSTEM_CALL;
+
+			for (std::size_t i = 0; i < numberOfFramesToWrite; i++)
+			{
+				convert_transmit_frame(canFrames[i], txFrames[i]);
+				segments[i].iov_base = &txFrames[i];
+				segments[i].iov_len = sizeof(struct can_frame);
+				memset(&messages[i], 0, sizeof(struct mmsghdr));
+				messages[i].msg_hdr.msg_iov = &segments[i];
+				messages[i].msg_hdr.msg_iovlen = 1;
+			}
+
+			const int numberOfMessages = sendmmsg(fileDescriptor, messages.data(), static_cast<unsigned int>(numberOfFramesToWrite), 0);
+
+			if (numberOfMessages > 0)
+			{
+				retVal = static_cast<std::size_t>(numberOfMessages);
+			}
+			else
+			{
+				handle_write_failure();
+			}
+		}
+		return retVal;
+	}
+
+	bool SocketCANInterface::wait_until_readable()
+	{
+		struct pollfd pollingFileDescriptor;
+		bool retVal = false;
+
+		pollingFileDescriptor.fd = fileDescriptor;
+		pollingFileDescriptor.events = POLLIN;
+		pollingFileDescriptor.revents = 0;
+
+		if (1 == poll(&pollingFileDescriptor, 1, 100))
+		{
+			retVal = true;
+		}
 		else if (pollingFileDescriptor.revents & (POLLERR | POLLHUP))
 		{
 			close();
@@ -233,18 +301,65 @@ namespace isobus
 			// Poll timed out.  Restart the hardware.
 			close();
 			open();
-			
+
 			// Wait for the network to be fully up.
 			std::this_thread::sleep_for(std::chrono::milliseconds(250));
 		}
 		return retVal;
 	}
 
-	bool SocketCANInterface::write_frame(const isobus::CANMessageFrame &canFrame)
+	bool SocketCANInterface::convert_received_frame(const struct can_frame &rxFrame, struct msghdr &message, isobus::CANMessageFrame &canFrame) const
 	{
-		struct can_frame txFrame;
 		bool retVal = false;
 
+		if (0 == (rxFrame.can_id & CAN_ERR_FLAG))
+		{
+			canFrame.timestamp_us = std::numeric_limits<std::uint64_t>::max();
+
+			if (0 != (rxFrame.can_id & CAN_EFF_FLAG))
+			{
+				canFrame.identifier = (rxFrame.can_id & CAN_EFF_MASK);
+				canFrame.isExtendedFrame = true;
+			}
+			else
+			{
+				canFrame.identifier = (rxFrame.can_id & CAN_SFF_MASK);
+				canFrame.isExtendedFrame = false;
+			}
+			canFrame.dataLength = rxFrame.can_dlc;
+			memset(canFrame.data, 0, sizeof(canFrame.data));
+			memcpy(canFrame.data, rxFrame.data, canFrame.dataLength);
+
+			for (struct cmsghdr *pControlMessage = CMSG_FIRSTHDR(&message); (nullptr != pControlMessage) && (SOL_SOCKET == pControlMessage->cmsg_level); pControlMessage = CMSG_NXTHDR(&message, pControlMessage))
+			{
+				switch (pControlMessage->cmsg_type)
+				{
+					case SO_TIMESTAMP:
+					{
+						struct timeval *time = (struct timeval *)CMSG_DATA(pControlMessage);
+
+						if (std::numeric_limits<std::uint64_t>::max() == canFrame.timestamp_us)
+						{
+							canFrame.timestamp_us = static_cast<std::uint64_t>(time->tv_usec) + (static_cast<std::uint64_t>(time->tv_sec) * 1000000);
+						}
+					}
+					break;
+
+					case SO_TIMESTAMPING:
+					{
+						struct timespec *time = (struct timespec *)(CMSG_DATA(pControlMessage));
+						canFrame.timestamp_us = (static_cast<std::uint64_t>(time[2].tv_nsec) / 1000) + (static_cast<std::uint64_t>(time[2].tv_sec) * 1000000);
+					}
+					break;
+				}
+			}
+			retVal = true;
+		}
+		return retVal;
+	}
+
+	void SocketCANInterface::convert_transmit_frame(const isobus::CANMessageFrame &canFrame, struct can_frame &txFrame)
+	{
 		txFrame.can_id = canFrame.identifier;
 		txFrame.can_dlc = canFrame.dataLength;
 		memcpy(txFrame.data, canFrame.data, canFrame.dataLength);
@@ -253,12 +368,11 @@ namespace isobus
 		{
 			txFrame.can_id |= CAN_EFF_FLAG;
 		}
+	}
 
-		if (write(fileDescriptor, &txFrame, sizeof(struct can_frame)) > 0)
-		{
-			retVal = true;
-		}
-		else if (errno == ENETDOWN)
+	void SocketCANInterface::handle_write_failure()
+	{
+		if (errno == ENETDOWN)
 		{
 			LOG_CRITICAL("[SocketCAN] " + get_device_name() + " interface is down.");
 			close();
@@ -268,11 +382,15 @@ namespace isobus
 			// Unknown write fail.  Restart the hardware.
 			close();
 			open();
-			
+
 			// Wait for the network to be fully up.
 			std::this_thread::sleep_for(std::chrono::milliseconds(250));
 		}
-		return retVal;
+	}
+
+	int SocketCANInterface::get_file_descriptor() const
+	{
+		return fileDescriptor;
 	}
 
 	bool SocketCANInterface::set_name(const std::string &newName)
@@ -13,6 +13,8 @@
 
 #include "isobus/isobus/can_NAME.hpp"
 
+#include <vector>
+
 namespace isobus
 {
 	//================================================================================================
@@ -43,11 +45,61 @@ namespace isobus
 		/// @returns true if a NAME matches this filter class's components
 		bool check_name_matches_filter(const NAME &nameToCompare) const;
 
+		/// @brief Returns the bits of the 64-bit NAME this filter checks, and the value they must have
+		/// @details A NAME matches the filter when `(NAME & mask) == value`.
+		/// @param[out] mask The bits of the NAME that belong to this filter's component
+		/// @param[out] maskedValue The value those bits must have for a NAME to match
+		/// @returns true if the filter can match a NAME, false if its value doesn't fit in its component
+		bool get_mask_and_value(std::uint64_t &mask, std::uint64_t &maskedValue) const;
+
 	private:
 		NAME::NAMEParameters parameter; ///< The NAME component to filter against
 		std::uint32_t value; ///< The value of the data associated with the filter component
 	};
 
+	//================================================================================================
+	/// @class NAMEMatcher
+	///
+	/// @brief A list of NAME filters compiled into a single mask and value
+	/// @details Every component of a NAME sits in its own bits of the 64-bit NAME, so a list of
+	/// filters that must all match can be checked with one AND and one compare instead of
+	/// extracting and comparing each component in turn.
+	//================================================================================================
+	class NAMEMatcher
+	{
+	public:
+		/// @brief Constructor for a NAMEMatcher that matches no NAME
+		NAMEMatcher() = default;
+
+		/// @brief Constructor for the NAMEMatcher
+		/// @param[in] filters The filters that a NAME must all match. An empty list matches no NAME.
+		explicit NAMEMatcher(const std::vector<NAMEFilter> &filters);
+
+		/// @brief Returns true if a NAME matches all of the filters this matcher was built from
+		/// @param[in] nameToCompare A NAME to compare against the filters
+		/// @returns true if the NAME matches all of the filters
+		bool matches(const NAME &nameToCompare) const;
+
+		/// @brief Returns the bits of the NAME that the filters check
+		/// @returns The combined mask of all of the filters
+		std::uint64_t get_mask() const;
+
+		/// @brief Returns the value the masked bits of a NAME must have to match
+		/// @returns The combined value of all of the filters
+		std::uint64_t get_value() const;
+
+		/// @brief Returns if any NAME can match the filters
+		/// @details This is false if there were no filters, if a filter's value doesn't fit in its
+		/// component, or if two filters require different values for the same component.
+		/// @returns true if a NAME can match the filters
+		bool get_can_match() const;
+
+	private:
+		std::uint64_t mask = 0; ///< The bits of the NAME that the filters check
+		std::uint64_t value = 0; ///< The value the masked bits must have
+		bool canMatch = false; ///< Whether any NAME can match the filters
+	};
+
 } // namespace isobus
 
 #endif // CAN_NAME_FILTER_HPP
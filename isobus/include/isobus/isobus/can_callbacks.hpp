@@ -11,7 +11,10 @@
 #define CAN_CALLBACKS_HPP
 
 #include <functional>
+#include <memory>
+#include <vector>
 #include "isobus/isobus/can_message.hpp"
+#include "isobus/isobus/can_message_view.hpp"
 
 namespace isobus
 {
@@ -37,6 +40,11 @@ namespace isobus
 
 	/// @brief A callback for control functions to get CAN messages
 	using CANLibCallback = void (*)(const CANMessage &message, void *parentPointer);
+	/// @brief A callback for control functions to get a non-owning view of received CAN messages
+	/// @details Received frames are still queued and reassembled as CANMessage objects, so the view is
+	/// created from that message when the callback is dispatched. It avoids copying the message again for
+	/// each callback, not the construction of the message itself.
+	using CANMessageViewCallback = void (*)(const CANMessageView &message, void *parentPointer);
 	/// @brief A callback for communicating CAN messages
 	using CANMessageCallback = std::function<void(const CANMessage &message)>;
 	/// @brief A callback for communicating CAN message frames
@@ -79,10 +87,11 @@ namespace isobus
 	public:
 		/// @brief A constructor for holding callback data
 		/// @param[in] parameterGroupNumber The PGN you want to register a callback for
-		/// @param[in] callback The function you want the stack to call when it gets receives a message with a matching PGN
+		/// @param[in] callback The function you want the stack to call when it gets receives a message with a matching PGN, or nullptr to only use the view callback
 		/// @param[in] parentPointer A generic variable that can provide context to which object the callback was meant for
 		/// @param[in] internalControlFunction An internal control function to use as an additional filter for the callback
-		ParameterGroupNumberCallbackData(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parentPointer, std::shared_ptr<InternalControlFunction> internalControlFunction);
+		/// @param[in] viewCallback A function taking a message view that the stack calls instead of `callback`, or nullptr if not used
+		ParameterGroupNumberCallbackData(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parentPointer, std::shared_ptr<InternalControlFunction> internalControlFunction, CANMessageViewCallback viewCallback = nullptr);
 
 		/// @brief Equality operator for this class
 		/// @param[in] obj The object to check equality against
@@ -94,9 +103,21 @@ namespace isobus
 		std::uint32_t get_parameter_group_number() const;
 
 		/// @brief Returns the callback pointer for this data object
-		/// @returns The callback pointer for this data object
+		/// @returns The callback pointer for this data object, or nullptr if this is a view callback
 		CANLibCallback get_callback() const;
 
+		/// @brief Returns the view callback pointer for this data object
+		/// @returns The view callback pointer for this data object, or nullptr if this is a regular callback
+		CANMessageViewCallback get_view_callback() const;
+
+		/// @brief Returns if either kind of callback is set
+		/// @returns `true` if a callback or view callback is set, otherwise `false`
+		bool has_callback() const;
+
+		/// @brief Calls the callback with a message, passing a view of it for view callbacks
+		/// @param[in] message The message to pass to the callback
+		void invoke(const CANMessage &message) const;
+
 		/// @brief Returns the parent pointer for this data object
 		/// @returns The parent pointer for this data object
 		void *get_parent() const;
@@ -107,10 +128,103 @@ namespace isobus
 
 	private:
 		CANLibCallback callback; ///< The callback that will get called when a matching PGN is received
+		CANMessageViewCallback viewCallback; ///< The view callback that will get called when a matching PGN is received
 		std::uint32_t parameterGroupNumber; ///< The PGN assocuiated with this callback
 		void *parent; ///< A generic variable that can provide context to which object the callback was meant for
 		std::shared_ptr<InternalControlFunction> internalControlFunctionFilter; ///< An optional way to filter callbacks based on the destination of messages from the partner
 	};
+
+	/// @brief A PGN indexed container of PGN callbacks, used to dispatch received messages
+	/// @details Callbacks are stored contiguously, sorted by PGN, while keeping the order in which callbacks
+	/// for the same PGN were added. A small open-addressed hash table maps each PGN to its span of callbacks,
+	/// so finding the callbacks for a received message doesn't depend on how many callbacks are registered.
+	/// The index is rebuilt when callbacks are added or removed, which is expected to be rare compared to lookups.
+	/// Adding or removing a callback replaces the list of callbacks instead of changing it in place,
+	/// so a dispatch that is in progress keeps going over the list it started with.
+	class ParameterGroupNumberCallbackTable
+	{
+	public:
+		/// @brief Adds a callback to the table
+		/// @param[in] callbackData The callback to add
+		void add_callback(const ParameterGroupNumberCallbackData &callbackData);
+
+		/// @brief Removes the first callback that is equal to the one passed in
+		/// @param[in] callbackData The callback to remove
+		/// @returns `true` if a callback was removed, otherwise `false`
+		bool remove_callback(const ParameterGroupNumberCallbackData &callbackData);
+
+		/// @brief Checks if a callback equal to the one passed in is in the table
+		/// @param[in] callbackData The callback to look for
+		/// @returns `true` if the callback is in the table, otherwise `false`
+		bool contains(const ParameterGroupNumberCallbackData &callbackData) const;
+
+		/// @brief Returns the total number of callbacks in the table
+		/// @returns The number of callbacks in the table
+		std::size_t size() const;
+
+		/// @brief Returns a callback by index, where callbacks are ordered by PGN
+		/// @param[in] index The index of the callback to get, must be less than size()
+		/// @returns The callback at the specified index
+		const ParameterGroupNumberCallbackData &get_callback(std::size_t index) const;
+
+		/// @brief Returns the number of callbacks registered for a specific PGN
+		/// @param[in] parameterGroupNumber The PGN to look up
+		/// @returns The number of callbacks registered for the PGN
+		std::size_t get_number_callbacks(std::uint32_t parameterGroupNumber) const;
+
+		/// @brief Calls a function for each callback registered for a PGN, in the order they were added
+		/// @details Goes over the callbacks as they were when the call started, so it's safe for the function
+		/// to add or remove callbacks. Those changes are only visible from the next call on.
+		/// @param[in] parameterGroupNumber The PGN to look up
+		/// @param[in] function The function to call for each matching callback
+		template<typename Function>
+		void for_each_callback(std::uint32_t parameterGroupNumber, Function function) const
+		{
+			// Keeps the list alive if the function replaces it
+			const std::shared_ptr<const std::vector<ParameterGroupNumberCallbackData>> snapshot = callbacks;
+			std::size_t callbackIndex = find_first_index(parameterGroupNumber);
+
+			while ((callbackIndex < snapshot->size()) &&
+			       (parameterGroupNumber == (*snapshot)[callbackIndex].get_parameter_group_number()))
+			{
+				function((*snapshot)[callbackIndex]);
+				callbackIndex++;
+			}
+		}
+
+	private:
+		/// @brief Stores the location of all callbacks for a single PGN
+		struct IndexEntry
+		{
+			std::uint32_t parameterGroupNumber; ///< The PGN of this entry, or EMPTY_ENTRY if the slot is free
+			std::uint32_t firstIndex; ///< The index of the first callback for the PGN
+			std::uint32_t count; ///< The number of callbacks for the PGN
+		};
+
+		static constexpr std::uint32_t EMPTY_ENTRY = 0xFFFFFFFF; ///< Marks an unused slot in the index, PGNs are only 18 bits
+		static constexpr std::size_t MINIMUM_INDEX_SIZE = 8; ///< The smallest number of index slots, must be a power of 2
+
+		/// @brief Finds the index of the first callback for a PGN
+		/// @param[in] parameterGroupNumber The PGN to look up
+		/// @returns The index of the first callback, or the size of the table if there is none
+		std::size_t find_first_index(std::uint32_t parameterGroupNumber) const;
+
+		/// @brief Finds the slot in the index for a PGN
+		/// @param[in] parameterGroupNumber The PGN to look up
+		/// @returns Pointer to the entry for the PGN, or nullptr if no callbacks are registered for it
+		const IndexEntry *find_entry(std::uint32_t parameterGroupNumber) const;
+
+		/// @brief Returns the starting slot in the index for a PGN
+		/// @param[in] parameterGroupNumber The PGN to hash
+		/// @returns The first slot to probe for the PGN
+		std::size_t hash_slot(std::uint32_t parameterGroupNumber) const;
+
+		/// @brief Rebuilds the PGN index from the sorted list of callbacks
+		void rebuild_index();
+
+		std::shared_ptr<const std::vector<ParameterGroupNumberCallbackData>> callbacks = std::make_shared<std::vector<ParameterGroupNumberCallbackData>>(); ///< All callbacks, sorted by PGN then by the order they were added, replaced on every change
+		std::vector<IndexEntry> index; ///< Open-addressed hash table of PGN to callback spans, size is a power of 2
+	};
 } // namespace isobus
 
 #endif // CAN_CALLBACKS_HPP
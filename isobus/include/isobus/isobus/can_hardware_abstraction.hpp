@@ -12,6 +12,7 @@
 
 #include "isobus/isobus/can_message_frame.hpp"
 
+#include <cstddef>
 #include <cstdint>
 
 namespace isobus
@@ -25,6 +26,11 @@ namespace isobus
 	/// @param[in] frame The frame to receive from the hardware
 	void receive_can_message_frame_from_hardware(const CANMessageFrame &frame);
 
+	/// @brief The receiving abstraction layer between the hardware and the stack, for a batch of frames
+	/// @param[in] frames Pointer to the first frame to receive from the hardware
+	/// @param[in] numberOfFrames The number of frames to receive
+	void receive_can_message_frames_from_hardware(const CANMessageFrame *frames, std::size_t numberOfFrames);
+
 	/// @brief Informs the network manager whenever messages are emitted on the bus
 	/// @param[in] txFrame The CAN frame that was just emitted
 	void on_transmit_can_message_frame_from_hardware(const CANMessageFrame &txFrame);
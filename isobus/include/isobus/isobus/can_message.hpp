@@ -15,6 +15,7 @@
 #include "isobus/isobus/can_control_function.hpp"
 #include "isobus/isobus/can_general_parameter_group_numbers.hpp"
 #include "isobus/isobus/can_identifier.hpp"
+#include "isobus/isobus/can_message_payload.hpp"
 #include "isobus/utility/data_span.hpp"
 
 #include <vector>
@@ -91,8 +92,9 @@ namespace isobus
 		Type get_type() const;
 
 		/// @brief Gets a reference to the data in the CAN message
+		/// @details Single frame payloads are stored inline in the message, so this doesn't require a heap allocation
 		/// @returns A reference to the data in the CAN message
-		const std::vector<std::uint8_t> &get_data() const;
+		const CANMessagePayload &get_data() const;
 
 		/// @brief Returns the length of the data in the CAN message
 		/// @returns The message data payload length
@@ -159,6 +161,11 @@ namespace isobus
 		/// @param[in] length The desired length of the data payload
 		void set_data_size(std::uint32_t length);
 
+		/// @brief Moves the data payload out of the message, leaving the message without data
+		/// @details Used by the transport protocols to take their receive buffer back once a message has been delivered
+		/// @returns The data payload of the message
+		std::vector<std::uint8_t> release_data();
+
 		/// @brief Sets the CAN ID of the message
 		/// @param[in] value The CAN ID for the message
 		void set_identifier(const CANIdentifier &value);
@@ -260,9 +267,11 @@ namespace isobus
 		std::uint64_t get_data_custom_length(const std::uint32_t startBitIndex, const std::uint32_t length, const ByteFormat format = ByteFormat::LittleEndian) const;
 
 	private:
+		friend class CANMessageView; ///< Allows a view to reference the message's control functions without sharing ownership
+
 		Type messageType; ///< The internal message type associated with the message
 		CANIdentifier identifier; ///< The CAN ID of the message
-		std::vector<std::uint8_t> data; ///< A data buffer for the message, used when not using data chunk callbacks
+		CANMessagePayload data; ///< A data buffer for the message, stored inline for single frame messages
 		std::shared_ptr<ControlFunction> source; ///< The source control function of the message
 		std::shared_ptr<ControlFunction> destination; ///< The destination control function of the message
 		std::uint8_t CANPortIndex; ///< The CAN channel index associated with the message
@@ -0,0 +1,173 @@
+//================================================================================================
+/// @file can_message_payload.hpp
+///
+/// @brief A byte container for CAN message payloads, which stores single frame payloads
+/// inline and only uses the heap for larger (multi-frame) payloads.
+/// @author Adrian Del Grosso
+/// @author Daan Steenbergen
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+
+#ifndef CAN_MESSAGE_PAYLOAD_HPP
+#define CAN_MESSAGE_PAYLOAD_HPP
+
+#include "isobus/isobus/can_constants.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace isobus
+{
+	//================================================================================================
+	/// @class CANMessagePayload
+	///
+	/// @brief Holds the data bytes of a CAN message.
+	/// @details Payloads that fit in a single classic CAN frame are stored inside the object itself, so
+	/// creating a message from a received frame doesn't need a heap allocation. Larger payloads, like the ones
+	/// reassembled by the transport protocols, are kept in a vector, which can be moved in without a copy.
+	/// The interface mirrors the parts of `std::vector` that are commonly used to read message data.
+	//================================================================================================
+	class CANMessagePayload
+	{
+	public:
+		using value_type = std::uint8_t; ///< The type of the elements in the payload
+		using size_type = std::size_t; ///< The type used for sizes and indices
+		using iterator = std::uint8_t *; ///< Iterator over the payload
+		using const_iterator = const std::uint8_t *; ///< Read-only iterator over the payload
+
+		/// @brief The number of bytes that can be stored without allocating
+		static constexpr std::size_t INLINE_CAPACITY = CAN_DATA_LENGTH;
+
+		/// @brief Constructs an empty payload
+		CANMessagePayload() = default;
+
+		/// @brief Constructs a payload by copying from a buffer
+		/// @param[in] dataBuffer The start of the data to copy
+		/// @param[in] length The number of bytes to copy
+		CANMessagePayload(const std::uint8_t *dataBuffer, std::size_t length);
+
+		/// @brief Constructs a payload from a vector, taking ownership of the vector's buffer if it doesn't fit inline
+		/// @param[in] data The data for the payload
+		CANMessagePayload(std::vector<std::uint8_t> data);
+
+		/// @brief Constructs a payload from a list of bytes
+		/// @param[in] data The data for the payload
+		CANMessagePayload(std::initializer_list<std::uint8_t> data);
+
+		/// @brief Copy constructor
+		/// @param[in] other The payload to copy
+		CANMessagePayload(const CANMessagePayload &other);
+
+		/// @brief Move constructor
+		/// @param[in] other The payload to move from, it will be empty afterwards
+		CANMessagePayload(CANMessagePayload &&other) noexcept;
+
+		/// @brief Copy assignment
+		/// @param[in] other The payload to copy
+		/// @returns A reference to this payload
+		CANMessagePayload &operator=(const CANMessagePayload &other);
+
+		/// @brief Move assignment
+		/// @param[in] other The payload to move from, it will be empty afterwards
+		/// @returns A reference to this payload
+		CANMessagePayload &operator=(CANMessagePayload &&other) noexcept;
+
+		/// @brief Returns the number of bytes in the payload
+		/// @returns The number of bytes in the payload
+		std::size_t size() const;
+
+		/// @brief Returns if the payload has no bytes
+		/// @returns `true` if the payload is empty, otherwise `false`
+		bool empty() const;
+
+		/// @brief Returns if the payload is stored inside the object instead of on the heap
+		/// @returns `true` if the payload is stored inline, otherwise `false`
+		bool is_inline() const;
+
+		/// @brief Returns a pointer to the first byte of the payload
+		/// @returns A pointer to the first byte of the payload
+		std::uint8_t *data();
+
+		/// @brief Returns a pointer to the first byte of the payload
+		/// @returns A pointer to the first byte of the payload
+		const std::uint8_t *data() const;
+
+		/// @brief Returns an iterator to the start of the payload
+		/// @returns An iterator to the start of the payload
+		iterator begin();
+
+		/// @brief Returns an iterator past the end of the payload
+		/// @returns An iterator past the end of the payload
+		iterator end();
+
+		/// @brief Returns an iterator to the start of the payload
+		/// @returns An iterator to the start of the payload
+		const_iterator begin() const;
+
+		/// @brief Returns an iterator past the end of the payload
+		/// @returns An iterator past the end of the payload
+		const_iterator end() const;
+
+		/// @brief Returns the byte at an index, without bounds checking
+		/// @param[in] index The index of the byte
+		/// @returns The byte at the index
+		std::uint8_t &operator[](std::size_t index);
+
+		/// @brief Returns the byte at an index, without bounds checking
+		/// @param[in] index The index of the byte
+		/// @returns The byte at the index
+		const std::uint8_t &operator[](std::size_t index) const;
+
+		/// @brief Returns the byte at an index
+		/// @details Throws `std::out_of_range` if the index is out of range, like `std::vector::at`
+		/// @param[in] index The index of the byte
+		/// @returns The byte at the index
+		const std::uint8_t &at(std::size_t index) const;
+
+		/// @brief Changes the number of bytes in the payload, new bytes are set to zero
+		/// @param[in] length The new number of bytes
+		void resize(std::size_t length);
+
+		/// @brief Appends bytes to the end of the payload
+		/// @param[in] dataBuffer The start of the data to append
+		/// @param[in] length The number of bytes to append
+		void append(const std::uint8_t *dataBuffer, std::size_t length);
+
+		/// @brief Removes all bytes from the payload
+		void clear();
+
+		/// @brief Moves the bytes out of the payload, leaving it empty
+		/// @details Heap storage is handed over without a copy, so buffers can be reused by their original owner
+		/// @returns A vector containing the payload
+		std::vector<std::uint8_t> release();
+
+		/// @brief Returns a copy of the payload as a vector
+		/// @details This is explicit so that binding a payload to a vector reference doesn't silently copy it
+		/// @returns A vector containing the payload
+		explicit operator std::vector<std::uint8_t>() const;
+
+	private:
+		std::array<std::uint8_t, INLINE_CAPACITY> inlineData = { 0 }; ///< Storage for payloads of up to INLINE_CAPACITY bytes
+		std::vector<std::uint8_t> heapData; ///< Storage for payloads larger than INLINE_CAPACITY bytes
+		std::uint32_t length = 0; ///< The number of bytes in the payload
+		bool usesHeap = false; ///< Whether the payload is stored in heapData instead of inlineData
+	};
+
+	/// @brief Compares two payloads
+	/// @param[in] lhs The first payload to compare
+	/// @param[in] rhs The second payload to compare
+	/// @returns `true` if both payloads contain the same bytes
+	bool operator==(const CANMessagePayload &lhs, const CANMessagePayload &rhs);
+
+	/// @brief Compares two payloads
+	/// @param[in] lhs The first payload to compare
+	/// @param[in] rhs The second payload to compare
+	/// @returns `true` if the payloads contain different bytes
+	bool operator!=(const CANMessagePayload &lhs, const CANMessagePayload &rhs);
+} // namespace isobus
+
+#endif // CAN_MESSAGE_PAYLOAD_HPP
@@ -0,0 +1,193 @@
+//================================================================================================
+/// @file can_message_view.hpp
+///
+/// @brief A non-owning, read-only view of a CAN message, which can be created from a
+/// CANMessage or directly from a received CAN frame without copying its data.
+/// @author Adrian Del Grosso
+/// @author Daan Steenbergen
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+
+#ifndef CAN_MESSAGE_VIEW_HPP
+#define CAN_MESSAGE_VIEW_HPP
+
+#include "isobus/isobus/can_control_function.hpp"
+#include "isobus/isobus/can_general_parameter_group_numbers.hpp"
+#include "isobus/isobus/can_identifier.hpp"
+#include "isobus/isobus/can_message.hpp"
+#include "isobus/isobus/can_message_frame.hpp"
+
+namespace isobus
+{
+	//================================================================================================
+	/// @class CANMessageView
+	///
+	/// @brief A lightweight, non-owning view of a CAN message.
+	/// @details The view only references the data of the message or frame it was created from, and
+	/// the resolved source and destination control functions, so it must not outlive them. It offers
+	/// the same typed getters as CANMessage so protocol code can use either interchangeably.
+	//================================================================================================
+	class CANMessageView
+	{
+	public:
+		/// @brief Creates a view of a CAN message
+		/// @param[in] message The message to view, must outlive the view
+		explicit CANMessageView(const CANMessage &message);
+
+		/// @brief Creates a view of a CAN frame
+		/// @param[in] frame The frame to view, must outlive the view
+		/// @param[in] source The source control function of the frame, or nullptr if unknown
+		/// @param[in] destination The destination control function of the frame, or nullptr if broadcast
+		CANMessageView(const CANMessageFrame &frame, ControlFunction *source, ControlFunction *destination);
+
+		/// @brief Returns the identifier of the message
+		/// @returns The identifier of the message
+		CANIdentifier get_identifier() const;
+
+		/// @brief Compares the identifier of the message to the parameter group number (PGN) supplied
+		/// @param[in] parameterGroupNumber The parameter group number to compare to
+		/// @returns True if the message identifier matches the parameter group number, false otherwise
+		bool is_parameter_group_number(CANLibParameterGroupNumber parameterGroupNumber) const;
+
+		/// @brief Returns the data of the message
+		/// @returns A span over the data of the message
+		CANDataSpan get_data() const;
+
+		/// @brief Returns the length of the data in the message
+		/// @returns The message data payload length
+		std::uint32_t get_data_length() const;
+
+		/// @brief Returns the CAN channel index associated with the message
+		/// @returns The CAN channel index associated with the message
+		std::uint8_t get_can_port_index() const;
+
+		/// @brief Gets the source control function that the message is from
+		/// @returns The source control function that the message is from, or nullptr if unknown
+		ControlFunction *get_source_control_function() const;
+
+		/// @brief Gets the destination control function that the message is to
+		/// @returns The destination control function that the message is to, or nullptr if broadcast
+		ControlFunction *get_destination_control_function() const;
+
+		/// @brief Returns whether the message is originated from the control function.
+		/// @param[in] controlFunction The control function to check
+		/// @returns True if the message is originated from the control function, false otherwise
+		bool is_source(const std::shared_ptr<ControlFunction> &controlFunction) const;
+
+		/// @brief Returns whether the message is destined for the control function.
+		/// @param[in] controlFunction The control function to check
+		/// @returns True if the message is destined for the control function, false otherwise
+		bool is_destination(const std::shared_ptr<ControlFunction> &controlFunction) const;
+
+		/// @brief Get a 8-bit unsigned byte from the buffer at a specific index.
+		/// A 8-bit unsigned byte can hold a value between 0 and 255.
+		/// @details This function will return the byte at the specified index in the buffer.
+		/// @param[in] index The index to get the byte from
+		/// @return The 8-bit unsigned byte
+		std::uint8_t get_uint8_at(const std::uint32_t index) const;
+
+		/// @brief Get a 8-bit signed byte from the buffer at a specific index.
+		/// A 8-bit signed byte can hold a value between -128 and 127.
+		/// @details This function will return the byte at the specified index in the buffer.
+		/// @param[in] index The index to get the byte from
+		/// @return The 8-bit signed byte
+		std::int8_t get_int8_at(const std::uint32_t index) const;
+
+		/// @brief Get a 16-bit unsigned integer from the buffer at a specific index.
+		/// A 16-bit unsigned integer can hold a value between 0 and 65535.
+		/// @details This function will return the 2 bytes at the specified index in the buffer.
+		/// @param[in] index The index to get the 16-bit unsigned integer from
+		/// @param[in] format The byte format to use when reading the integer
+		/// @return The 16-bit unsigned integer
+		std::uint16_t get_uint16_at(const std::uint32_t index, const CANMessage::ByteFormat format = CANMessage::ByteFormat::LittleEndian) const;
+
+		/// @brief Get a 16-bit signed integer from the buffer at a specific index.
+		/// A 16-bit signed integer can hold a value between -32768 and 32767.
+		/// @details This function will return the 2 bytes at the specified index in the buffer.
+		/// @param[in] index The index to get the 16-bit signed integer from
+		/// @param[in] format The byte format to use when reading the integer
+		/// @return The 16-bit signed integer
+		std::int16_t get_int16_at(const std::uint32_t index, const CANMessage::ByteFormat format = CANMessage::ByteFormat::LittleEndian) const;
+
+		/// @brief Get a right-aligned 24-bit integer from the buffer (returned as a uint32_t) at a specific index.
+		/// A 24-bit number can hold a value between 0 and 16,777,215.
+		/// @details This function will return the 3 bytes at the specified index in the buffer.
+		/// @param[in] index The index to get the 24-bit unsigned integer from
+		/// @param[in] format The byte format to use when reading the integer
+		/// @return The 24-bit unsigned integer, right aligned into a uint32_t
+		std::uint32_t get_uint24_at(const std::uint32_t index, const CANMessage::ByteFormat format = CANMessage::ByteFormat::LittleEndian) const;
+
+		/// @brief Get a right-aligned 24-bit integer from the buffer (returned as a int32_t) at a specific index.
+		/// A 24-bit number can hold a value between -8388608 and 8388607.
+		/// @details This function will return the 3 bytes at the specified index in the buffer.
+		/// @param[in] index The index to get the 24-bit signed integer from
+		/// @param[in] format The byte format to use when reading the integer
+		/// @return The 24-bit signed integer, right aligned into a int32_t
+		std::int32_t get_int24_at(const std::uint32_t index, const CANMessage::ByteFormat format = CANMessage::ByteFormat::LittleEndian) const;
+
+		/// @brief Get a 32-bit unsigned integer from the buffer at a specific index.
+		/// A 32-bit unsigned integer can hold a value between 0 and 4294967295.
+		/// @details This function will return the 4 bytes at the specified index in the buffer.
+		/// @param[in] index The index to get the 32-bit unsigned integer from
+		/// @param[in] format The byte format to use when reading the integer
+		/// @return The 32-bit unsigned integer
+		std::uint32_t get_uint32_at(const std::uint32_t index, const CANMessage::ByteFormat format = CANMessage::ByteFormat::LittleEndian) const;
+
+		/// @brief Get a 32-bit signed integer from the buffer at a specific index.
+		/// A 32-bit signed integer can hold a value between -2147483648 and 2147483647.
+		/// @details This function will return the 4 bytes at the specified index in the buffer.
+		/// @param[in] index The index to get the 32-bit signed integer from
+		/// @param[in] format The byte format to use when reading the integer
+		/// @return The 32-bit signed integer
+		std::int32_t get_int32_at(const std::uint32_t index, const CANMessage::ByteFormat format = CANMessage::ByteFormat::LittleEndian) const;
+
+		/// @brief Get a 64-bit unsigned integer from the buffer at a specific index.
+		/// A 64-bit unsigned integer can hold a value between 0 and 18446744073709551615.
+		/// @details This function will return the 8 bytes at the specified index in the buffer.
+		/// @param[in] index The index to get the 64-bit unsigned integer from
+		/// @param[in] format The byte format to use when reading the integer
+		/// @return The 64-bit unsigned integer
+		std::uint64_t get_uint64_at(const std::uint32_t index, const CANMessage::ByteFormat format = CANMessage::ByteFormat::LittleEndian) const;
+
+		/// @brief Get a 64-bit signed integer from the buffer at a specific index.
+		/// A 64-bit signed integer can hold a value between -9223372036854775808 and 9223372036854775807.
+		/// @details This function will return the 8 bytes at the specified index in the buffer.
+		/// @param[in] index The index to get the 64-bit signed integer from
+		/// @param[in] format The byte format to use when reading the integer
+		/// @return The 64-bit signed integer
+		std::int64_t get_int64_at(const std::uint32_t index, const CANMessage::ByteFormat format = CANMessage::ByteFormat::LittleEndian) const;
+
+		/// @brief Get a bit-boolean from the buffer at a specific index.
+		/// @details This function will return whether the bit(s) at the specified index in the buffer is/are (all) equal to 1.
+		/// @param[in] byteIndex The byte index to start reading the boolean from
+		/// @param[in] bitIndex The bit index to start reading the boolean from, ranging from 0 to 7
+		/// @param[in] length The number of bits to read, maximum of (8 - bitIndex)
+		/// @return True if (all) the bit(s) are set, false otherwise
+		bool get_bool_at(const std::uint32_t byteIndex, const std::uint8_t bitIndex, const std::uint8_t length = 1) const;
+
+		/// @brief Get a 64-bit unsinged integer from the buffer at a specific index but custom length
+		/// Why 64 bit? Because we do not know the length and it could be 10 bits or 54 so better to convert everything into 64 bit
+		/// @details This function will return 8 bytes at a specified index in the buffer but custom bit length
+		/// We are iterating by full bytes (assembling a full byte) and shifting it into the final 64-bit value to return
+		/// @param[in] startBitIndex The index to get the 64-bit unsigned integer from
+		/// @param[in] length The length of bits to extract from the buffer
+		/// @param[in] format The byte format to use when reading the integer
+		/// @return The 64-bit unsigned integer
+		std::uint64_t get_data_custom_length(const std::uint32_t startBitIndex, const std::uint32_t length, const CANMessage::ByteFormat format = CANMessage::ByteFormat::LittleEndian) const;
+	private:
+		/// @brief Returns the byte at an index, throwing `std::out_of_range` if the index is out of range
+		/// @param[in] index The index of the byte to get
+		/// @returns The byte at the index
+		std::uint8_t byte_at(const std::uint32_t index) const;
+
+		CANIdentifier identifier; ///< The CAN ID of the message
+		CANDataSpan data; ///< The data of the message, owned by the message or frame being viewed
+		ControlFunction *source; ///< The source control function of the message
+		ControlFunction *destination; ///< The destination control function of the message
+		std::uint8_t CANPortIndex; ///< The CAN channel index associated with the message
+	};
+
+} // namespace isobus
+
+#endif // CAN_MESSAGE_VIEW_HPP
@@ -34,6 +34,13 @@
 #include <list>
 #include <memory>
 #include <queue>
+#include <unordered_map>
+#include <vector>
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+#include <condition_variable>
+#include <thread>
+#endif
 
 /// @brief This namespace encompasses all of the ISO11783 stack's functionality to reduce global namespace pollution
 namespace isobus
@@ -82,6 +89,13 @@ namespace isobus
 		/// @returns A control function that matches the parameters, or nullptr if no match was found
 		std::shared_ptr<ControlFunction> get_control_function(std::uint8_t channelIndex, std::uint8_t address) const;
 
+		/// @brief Getter for a control function based on certain port and NAME, whether it's online or not.
+		/// @details This is a hash lookup, so it doesn't depend on the number of control functions on the bus.
+		/// @param[in] channelIndex CAN Channel index of the control function
+		/// @param[in] controlFunctionNAME The NAME of the control function
+		/// @returns A control function that matches the parameters, or nullptr if no match was found
+		std::shared_ptr<ControlFunction> get_control_function_by_name(std::uint8_t channelIndex, NAME controlFunctionNAME) const;
+
 		/// @brief This is how you register a callback for any PGN destined for the global address (0xFF)
 		/// @param[in] parameterGroupNumber The PGN you want to register for
 		/// @param[in] callback The callback that will be called when parameterGroupNumber is received from the global address (0xFF)
@@ -96,6 +110,21 @@ namespace isobus
 		/// @param[in] internalControlFunction An optional internal function destination to filter messages by
 		void remove_global_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction = nullptr);
 
+		/// @brief Registers a callback for any PGN destined for the global address (0xFF), which receives a non-owning view of the message
+		/// @details Use this for listeners that only read a few bytes of a message, the view avoids copying the message.
+		/// @param[in] parameterGroupNumber The PGN you want to register for
+		/// @param[in] callback The callback that will be called when parameterGroupNumber is received from the global address (0xFF)
+		/// @param[in] parent A generic context variable that helps identify what object the callback is destined for. Can be nullptr if you don't want to use it.
+		/// @param[in] internalControlFunction An optional internal function destination to filter messages by
+		void add_global_parameter_group_number_view_callback(std::uint32_t parameterGroupNumber, CANMessageViewCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction = nullptr);
+
+		/// @brief Removes a callback added with add_global_parameter_group_number_view_callback
+		/// @param[in] parameterGroupNumber The PGN of the callback to remove
+		/// @param[in] callback The callback that will be removed
+		/// @param[in] parent A generic context variable that helps identify what object the callback was destined for
+		/// @param[in] internalControlFunction An optional internal function destination to filter messages by
+		void remove_global_parameter_group_number_view_callback(std::uint32_t parameterGroupNumber, CANMessageViewCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction = nullptr);
+
 		/// @brief Returns the number of global PGN callbacks that have been registered with the network manager
 		/// @returns The number of global PGN callbacks that have been registered with the network manager
 		std::size_t get_number_global_parameter_group_number_callbacks() const;
@@ -114,6 +143,20 @@ namespace isobus
 		/// @param[in] internalControlFunction An optional internal function destination to filter messages by
 		void remove_any_control_function_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction = nullptr);
 
+		/// @brief Registers a callback for ANY control function sending the associated PGN, which receives a non-owning view of the message
+		/// @param[in] parameterGroupNumber The PGN you want to register for
+		/// @param[in] callback The callback that will be called when parameterGroupNumber is received from any control function
+		/// @param[in] parent A generic context variable that helps identify what object the callback is destined for. Can be nullptr if you don't want to use it.
+		/// @param[in] internalControlFunction An optional internal function destination to filter messages by
+		void add_any_control_function_parameter_group_number_view_callback(std::uint32_t parameterGroupNumber, CANMessageViewCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction = nullptr);
+
+		/// @brief Removes a callback added with add_any_control_function_parameter_group_number_view_callback
+		/// @param[in] parameterGroupNumber The PGN of the callback to remove
+		/// @param[in] callback The callback that will be removed
+		/// @param[in] parent A generic context variable that helps identify what object the callback was destined for
+		/// @param[in] internalControlFunction An optional internal function destination to filter messages by
+		void remove_any_control_function_parameter_group_number_view_callback(std::uint32_t parameterGroupNumber, CANMessageViewCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction = nullptr);
+
 		/// @brief Returns the network manager's event dispatcher for notifying consumers whenever a
 		/// message is transmitted by our application
 		/// @returns An event dispatcher which can be used to get notified about transmitted messages
@@ -161,10 +204,33 @@ namespace isobus
 		/// @brief The main update function for the network manager. Updates all protocols.
 		void update();
 
+		/// @brief Enables or disables updating each CAN port on its own worker thread
+		/// @details When enabled, the received messages, heartbeats and transport protocols (TP, ETP and fast packet)
+		/// of each CAN port are processed in parallel during update(), one thread per port, and update() returns once all ports are done.
+		/// Changes to the shared control function lists and address tables are still made one port at a time.
+		/// @attention With this enabled, callbacks for messages received on different ports may be called at the same time
+		/// from different threads, so your callbacks must be thread safe if they share data between ports.
+		/// Only the ports in use get a thread, any other port is still updated on the calling thread.
+		/// @param[in] value `true` to update each port on its own thread, `false` to update all ports on the calling thread
+		/// @param[in] numberOfPorts The number of CAN ports in use, usually the number of channels of the hardware interface
+		/// @returns `true` if the setting was applied, otherwise `false` (threads are disabled in this build, or fewer than 2 ports are in use)
+		bool set_port_worker_threads_enabled(bool value, std::uint8_t numberOfPorts);
+
+		/// @brief Returns if each CAN port is updated on its own worker thread
+		/// @returns `true` if each port is updated on its own thread, otherwise `false`
+		bool get_port_worker_threads_enabled() const;
+
 		/// @brief Used to tell the network manager when frames are received on the bus.
 		/// @param[in] rxFrame Frame to process
 		void process_receive_can_message_frame(const CANMessageFrame &rxFrame);
 
+		/// @brief Used to tell the network manager when a batch of frames are received on the bus.
+		/// @details This is equivalent to calling process_receive_can_message_frame for each frame,
+		/// but only locks the received message queue once for the whole batch.
+		/// @param[in] rxFrames Pointer to the first frame to process
+		/// @param[in] numberOfFrames The number of frames to process
+		void process_receive_can_message_frames(const CANMessageFrame *rxFrames, std::size_t numberOfFrames);
+
 		/// @brief Used to tell the network manager when frames are emitted on the bus.
 		/// @param[in] txFrame The frame that was just emitted onto the bus
 		void process_transmitted_can_message_frame(const CANMessageFrame &txFrame);
@@ -180,29 +246,87 @@ namespace isobus
 
 		/// @brief Gets all the internal control functions that are currently registered in the network manager
 		/// @returns A list of all the internal control functions
-		const std::list<std::shared_ptr<InternalControlFunction>> &get_internal_control_functions() const;
+		const std::vector<std::shared_ptr<InternalControlFunction>> &get_internal_control_functions() const;
 
 		/// @brief Gets all the partnered control functions that are currently registered in the network manager
 		/// @returns A list of all the partnered control functions
-		const std::list<std::shared_ptr<PartneredControlFunction>> &get_partnered_control_functions() const;
+		const std::vector<std::shared_ptr<PartneredControlFunction>> &get_partnered_control_functions() const;
 
 		/// @brief Gets all the control functions that are known to the network manager
+		/// @note This builds a new list on each call, use for_each_control_function to avoid the allocations
 		/// @param[in] includingOffline If true, all control functions are returned, otherwise only online control functions are returned
 		/// @returns A list of all the control functions
 		std::list<std::shared_ptr<ControlFunction>> get_control_functions(bool includingOffline) const;
 
+		/// @brief Calls a function for each control function that is known to the network manager, without allocating
+		/// @details Online control functions are visited in CAN port and address order, followed by the offline ones.
+		/// The function must not create or remove control functions.
+		/// @param[in] includingOffline If true, all control functions are visited, otherwise only online control functions are visited
+		/// @param[in] function The function to call with each `const std::shared_ptr<ControlFunction> &`
+		template<typename Function>
+		void for_each_control_function(bool includingOffline, Function function) const
+		{
+			for (const auto &portTable : controlFunctionTable)
+			{
+				for (const auto &controlFunction : portTable)
+				{
+					if (nullptr != controlFunction)
+					{
+						function(controlFunction);
+					}
+				}
+			}
+
+			if (includingOffline)
+			{
+				for (const auto &controlFunction : inactiveControlFunctions)
+				{
+					function(controlFunction);
+				}
+			}
+		}
+
 		/// @brief Gets all the active transport protocol sessions that are currently active
-		/// @note The list returns pointers to the transport protocol sessions, but they can disappear at any time
+		/// @note The list returns pointers to the transport protocol sessions, but they can disappear at any time.
+		/// This builds a new list on each call, use for_each_active_transport_protocol_session to avoid the allocations.
 		/// @param[in] canPortIndex The CAN channel index to get the transport protocol sessions for
 		/// @returns A list of all the active transport protocol sessions
 		std::list<std::shared_ptr<TransportProtocolSessionBase>> get_active_transport_protocol_sessions(std::uint8_t canPortIndex) const;
 
+		/// @brief Calls a function for each active transport protocol session on a CAN port, without allocating
+		/// @details TP sessions are visited first, followed by ETP sessions. The sessions can disappear on the
+		/// next update, so the function should not hold on to them.
+		/// @param[in] canPortIndex The CAN channel index to visit the transport protocol sessions of
+		/// @param[in] function The function to call with each `const std::shared_ptr<TransportProtocolSessionBase> &`
+		template<typename Function>
+		void for_each_active_transport_protocol_session(std::uint8_t canPortIndex, Function function) const
+		{
+			if (canPortIndex < CAN_PORT_MAXIMUM)
+			{
+				for (const auto &session : transportProtocols[canPortIndex]->get_sessions())
+				{
+					const std::shared_ptr<TransportProtocolSessionBase> &baseSession = session;
+					function(baseSession);
+				}
+				for (const auto &session : extendedTransportProtocols[canPortIndex]->get_sessions())
+				{
+					const std::shared_ptr<TransportProtocolSessionBase> &baseSession = session;
+					function(baseSession);
+				}
+			}
+		}
+
 		/// @brief Returns the class instance of the NMEA2k fast packet protocol.
 		/// Use this to register for FP multipacket messages
 		/// @param[in] canPortIndex The CAN channel index to get the fast packet protocol for
 		/// @returns The class instance of the NMEA2k fast packet protocol.
 		std::unique_ptr<FastPacketProtocol> &get_fast_packet_protocol(std::uint8_t canPortIndex);
 
+		/// @brief Returns the buffer pool shared by the transport protocols of all CAN channels.
+		/// Use this to inspect the pool statistics or to change how much memory the pool may keep.
+		/// @returns The buffer pool used for receiving multi-frame messages
+		std::shared_ptr<TransportProtocolBufferPool> get_transport_protocol_buffer_pool() const;
+
 		/// @brief Returns an interface which can be used to manage ISO11783-7 heartbeat messages.
 		/// @param[in] canPortIndex The index of the CAN channel associated to the interface you're requesting
 		/// @returns ISO11783-7 heartbeat interface
@@ -265,9 +389,15 @@ namespace isobus
 		void protocol_message_callback(const CANMessage &message);
 
 	private:
+		/// @brief A member function that does part of the update for a single CAN port
+		using PortUpdateTask = void (CANNetworkManager::*)(std::uint8_t canPortIndex);
+
 		/// @brief Constructor for the network manager. Sets default values for members
 		CANNetworkManager();
 
+		/// @brief Destructor for the network manager, stops the port worker threads if they are running
+		~CANNetworkManager();
+
 		/// @brief Factory function to create an external control function, also automatically assigns it to the lookup table.
 		/// @param[in] desiredName The NAME of the control function
 		/// @param[in] address The address of the control function
@@ -279,6 +409,14 @@ namespace isobus
 		/// @param[in] controlFunction The control function to remove
 		void deactivate_control_function(std::shared_ptr<ControlFunction> controlFunction);
 
+		/// @brief Adds a control function to the NAME index of its CAN port, replacing any with the same NAME
+		/// @param[in] controlFunction The control function to add
+		void add_to_name_index(const std::shared_ptr<ControlFunction> &controlFunction);
+
+		/// @brief Removes a control function from the NAME index of its CAN port, if it's the one indexed for its NAME
+		/// @param[in] controlFunction The control function to remove
+		void remove_from_name_index(const std::shared_ptr<ControlFunction> &controlFunction);
+
 		/// @brief Updates the internal address table based on a received CAN message
 		/// @param[in] message A message being received by the stack
 		void update_address_table(const CANMessage &message);
@@ -322,15 +460,11 @@ namespace isobus
 		                                const void *data,
 		                                std::uint32_t size) const;
 
-		/// @brief Get the next CAN message from the received message queue, and remove it from the queue.
-		/// @note This will only ever get an 8 byte message because they are directly translated from CAN frames.
-		/// @returns The message that was at the front of the queue, or an invalid message if the queue is empty
-		CANMessage get_next_can_message_from_rx_queue();
-
-		/// @brief Get the next CAN message from the received message queue, and remove it from the queue
-		/// @note This will only ever get an 8 byte message because they are directly translated from CAN frames.
-		/// @returns The message that was at the front of the queue, or an invalid message if the queue is empty
-		CANMessage get_next_can_message_from_tx_queue();
+		/// @brief Creates a CAN message from a received or transmitted frame, resolving the source and destination
+		/// @param[in] type The type of message to create
+		/// @param[in] frame The frame to create the message from
+		/// @returns The message created from the frame
+		CANMessage create_message_from_frame(CANMessage::Type type, const CANMessageFrame &frame) const;
 
 		/// @brief Processes a can message for callbacks added with add_any_control_function_parameter_group_number_callback
 		/// @param[in] currentMessage The message to process
@@ -357,10 +491,37 @@ namespace isobus
 		/// @param[in] message A pointer to a CAN message to be processed
 		void process_can_message_for_global_and_partner_callbacks(const CANMessage &message);
 
-		/// @brief Processes the internal received message queue
+		/// @brief Processes the internal received message queue, and updates the heartbeat interfaces
+		/// @details The queue is swapped out under a single lock, split up by CAN port, and then processed without holding the lock
 		void process_rx_messages();
 
+		/// @brief Processes the received messages of a single CAN port, then updates that port's heartbeat interface
+		/// @param[in] canPortIndex The CAN port to process
+		void update_port_rx_messages(std::uint8_t canPortIndex);
+
+		/// @brief Updates the transport protocols of a single CAN port
+		/// @param[in] canPortIndex The CAN port to update
+		void update_port_protocols(std::uint8_t canPortIndex);
+
+		/// @brief Runs a task for every CAN port, either on the port worker threads or on the calling thread
+		/// @param[in] task The task to run for every port
+		void run_port_update_task(PortUpdateTask task);
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+		/// @brief Starts a worker thread for every CAN port in use except the first, which is updated by the calling thread
+		/// @param[in] numberOfPorts The number of CAN ports in use
+		void start_port_workers(std::uint8_t numberOfPorts);
+
+		/// @brief Stops and joins the port worker threads
+		void stop_port_workers();
+
+		/// @brief The loop for a port worker thread, runs each task it is given for its port
+		/// @param[in] canPortIndex The CAN port this thread updates
+		/// @param[in] initialGeneration The task generation when the thread was started
+		void port_worker_thread_function(std::uint8_t canPortIndex, std::uint32_t initialGeneration);
+#endif
+
 		/// @brief Processes the internal transmitted message queue
+		/// @details The queue is swapped out under a single lock, and then processed without holding the lock
 		void process_tx_messages();
 
 		/// @brief Checks to see if any control function didn't claim during a round of
@@ -384,15 +545,12 @@ namespace isobus
 		                          const void *data,
 		                          std::uint32_t size) const;
 
-		/// @brief Gets a PGN callback for the global address by index
-		/// @param[in] index The index of the callback to get
-		/// @returns A structure containing the global PGN callback data
-		ParameterGroupNumberCallbackData get_global_parameter_group_number_callback(std::uint32_t index) const;
-
 		static constexpr std::uint32_t BUSLOAD_SAMPLE_WINDOW_MS = 1000; ///< Using a 1s window to average the bus load, otherwise it's very erratic
 		static constexpr std::uint32_t BUSLOAD_UPDATE_FREQUENCY_MS = 100; ///< Bus load bit accumulation happens over a 100ms window
+		static constexpr std::uint32_t PORT_WORKER_WAIT_TIMEOUT_MS = 100; ///< The longest a port worker thread sleeps before checking its state again
 
 		CANNetworkConfiguration configuration; ///< The configuration for this network manager
+		std::shared_ptr<TransportProtocolBufferPool> transportProtocolBufferPool; ///< Receive buffers shared by the transport protocols of all channels
 		std::array<std::unique_ptr<TransportProtocolManager>, CAN_PORT_MAXIMUM> transportProtocols; ///< One instance of the transport protocol manager for each channel
 		std::array<std::unique_ptr<ExtendedTransportProtocolManager>, CAN_PORT_MAXIMUM> extendedTransportProtocols; ///< One instance of the extended transport protocol manager for each channel
 		std::array<std::unique_ptr<FastPacketProtocol>, CAN_PORT_MAXIMUM> fastPacketProtocol; ///< One instance of the fast packet protocol for each channel
@@ -403,24 +561,42 @@ namespace isobus
 		std::array<std::uint32_t, CAN_PORT_MAXIMUM> lastAddressClaimRequestTimestamp_ms; ///< Stores timestamps for when the last request for the address claim PGN was received. Used to prune stale CFs.
 
 		std::array<std::array<std::shared_ptr<ControlFunction>, NULL_CAN_ADDRESS>, CAN_PORT_MAXIMUM> controlFunctionTable; ///< Table to maintain address to NAME mappings
-		std::list<std::shared_ptr<ControlFunction>> inactiveControlFunctions; ///< A list of the control function that currently don't have a valid address
-		std::list<std::shared_ptr<InternalControlFunction>> internalControlFunctions; ///< A list of the internal control functions
-		std::list<std::shared_ptr<PartneredControlFunction>> partneredControlFunctions; ///< A list of the partnered control functions
+		std::array<std::unordered_map<std::uint64_t, std::shared_ptr<ControlFunction>>, CAN_PORT_MAXIMUM> controlFunctionNAMEIndex; ///< Maps the NAME of every known control function, online or not, to the control function, one map per channel
+		std::vector<std::shared_ptr<ControlFunction>> inactiveControlFunctions; ///< The control functions that currently don't have a valid address
+		std::vector<std::shared_ptr<InternalControlFunction>> internalControlFunctions; ///< The internal control functions, walked for every received message
+		std::vector<std::shared_ptr<PartneredControlFunction>> partneredControlFunctions; ///< The partnered control functions, walked for every received message
 
-		std::list<ParameterGroupNumberCallbackData> protocolPGNCallbacks; ///< A list of PGN callback registered by CAN protocols
+		ParameterGroupNumberCallbackTable protocolPGNCallbacks; ///< A table of PGN callbacks registered by CAN protocols
 		std::queue<CANMessage> receivedMessageQueue; ///< A queue of received messages to process
 		std::queue<CANMessage> transmittedMessageQueue; ///< A queue of transmitted messages to process (already sent, so changes to the message won't affect the bus)
-		std::list<ControlFunctionStateCallback> controlFunctionStateCallbacks; ///< List of all control function state callbacks
-		std::vector<ParameterGroupNumberCallbackData> globalParameterGroupNumberCallbacks; ///< A list of all global PGN callbacks
-		std::vector<ParameterGroupNumberCallbackData> anyControlFunctionParameterGroupNumberCallbacks; ///< A list of all global PGN callbacks
+		std::queue<CANMessage> receivedMessageBatch; ///< The batch of received messages currently being processed, swapped with receivedMessageQueue on each update
+		std::queue<CANMessage> transmittedMessageBatch; ///< The batch of transmitted messages currently being processed, swapped with transmittedMessageQueue on each update
+		std::vector<CANMessage> receivedFrameStaging; ///< Reused storage for messages created by process_receive_can_message_frames before they're queued
+		std::array<std::queue<CANMessage>, CAN_PORT_MAXIMUM> portReceivedMessageBatches; ///< The received messages currently being processed, split up by CAN port
+		std::array<std::vector<std::shared_ptr<PartneredControlFunction>>, CAN_PORT_MAXIMUM> portMatchingPartners; ///< Reused per port to hold the partners a message is dispatched to, so their callbacks run without the state lock
+		std::vector<ControlFunctionStateCallback> controlFunctionStateCallbacks; ///< All control function state callbacks
+		ParameterGroupNumberCallbackTable globalParameterGroupNumberCallbacks; ///< A table of all global PGN callbacks
+		ParameterGroupNumberCallbackTable anyControlFunctionParameterGroupNumberCallbacks; ///< A table of all "any CF" PGN callbacks
 		EventDispatcher<CANMessage> messageTransmittedEventDispatcher; ///< An event dispatcher for notifying consumers about transmitted messages by our application
 		EventDispatcher<std::shared_ptr<InternalControlFunction>> addressViolationEventDispatcher; ///< An event dispatcher for notifying consumers about address violations
 		Mutex receivedMessageQueueMutex; ///< A mutex for receive messages thread safety
+		Mutex receivedFrameStagingMutex; ///< Protects receivedFrameStaging, since frames can be received from more than one thread
 		Mutex protocolPGNCallbacksMutex; ///< A mutex for PGN callback thread safety
 		Mutex anyControlFunctionCallbacksMutex; ///< Mutex to protect the "any CF" callbacks
 		Mutex busloadUpdateMutex; ///< A mutex that protects the busload metrics since we calculate it on our own thread
 		Mutex controlFunctionStatusCallbacksMutex; ///< A Mutex that protects access to the control function status callback list
 		Mutex transmittedMessageQueueMutex; ///< A mutex for protecting the transmitted message queue
+		mutable RecursiveMutex controlFunctionStateMutex; ///< Protects the control function lists, address tables and NAME index, which the receiving thread, the updating thread and the port workers all change
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+		std::vector<std::thread> portWorkerThreads; ///< One worker thread for each CAN port in use except the first, empty if the port workers are disabled
+		std::condition_variable portWorkerWakeupCondition; ///< Signals the port workers that there is a new task
+		std::condition_variable portWorkerDoneCondition; ///< Signals the updating thread that all port workers finished their task
+		Mutex portWorkerMutex; ///< Protects the port worker task state
+		PortUpdateTask portWorkerTask = nullptr; ///< The task the port workers should run
+		std::uint32_t portWorkerGeneration = 0; ///< Incremented for every new task, so workers know when to run it
+		std::size_t portWorkersBusy = 0; ///< The number of port workers still running the current task
+		bool portWorkersRunning = false; ///< Tells the port workers to keep running
+#endif
 		std::uint32_t busloadUpdateTimestamp_ms = 0; ///< Tracks a time window for determining approximate busload
 		std::uint32_t updateTimestamp_ms = 0; ///< Keeps track of the last time the CAN stack was update in milliseconds
 		bool initialized = false; ///< True if the network manager has been initialized by the update function
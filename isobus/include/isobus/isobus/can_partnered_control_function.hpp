@@ -63,6 +63,21 @@ namespace isobus
 		/// @param[in] internalControlFunction The ICF being used to filter messages against
 		void remove_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction = nullptr);
 
+		/// @brief Adds a callback for destination specific messages from this control function, which receives a non-owning view of the message
+		/// @details This works like add_parameter_group_number_callback, but avoids copying the message for listeners that only read a few bytes.
+		/// @param[in] parameterGroupNumber The PGN you want to use to communicate
+		/// @param[in] callback The function you want to get called when a message is received with parameterGroupNumber from this CF
+		/// @param[in] parent A generic context variable that helps identify what object the callback was destined for
+		/// @param[in] internalControlFunction An internal control function to filter based on
+		void add_parameter_group_number_view_callback(std::uint32_t parameterGroupNumber, CANMessageViewCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction = nullptr);
+
+		/// @brief Removes a view callback matching *exactly* the parameters passed in
+		/// @param[in] parameterGroupNumber The PGN associated with the callback being removed
+		/// @param[in] callback The callback function being removed
+		/// @param[in] parent A generic context variable that helps identify what object the callback was destined for
+		/// @param[in] internalControlFunction The ICF being used to filter messages against
+		void remove_parameter_group_number_view_callback(std::uint32_t parameterGroupNumber, CANMessageViewCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction = nullptr);
+
 		/// @brief Returns the number of parameter group number callbacks associated with this control function
 		/// @returns The number of parameter group number callbacks associated with this control function
 		std::size_t get_number_parameter_group_number_callbacks() const;
@@ -89,15 +104,11 @@ namespace isobus
 		bool check_matches_name(NAME NAMEToCheck) const;
 
 	private:
-		friend class CANNetworkManager; ///< Allows the network manager to use get_parameter_group_number_callback
-
-		/// @brief Returns a parameter group number associated with this control function by index
-		/// @param[in] index The index from which to get the PGN callback data object
-		/// @returns A reference to the PGN callback data object at the index specified
-		ParameterGroupNumberCallbackData &get_parameter_group_number_callback(std::size_t index);
+		friend class CANNetworkManager; ///< Allows the network manager to dispatch messages to parameterGroupNumberCallbacks
 
 		const std::vector<NAMEFilter> NAMEFilterList; ///< A list of NAME parameters that describe this control function's identity
-		std::vector<ParameterGroupNumberCallbackData> parameterGroupNumberCallbacks; ///< A list of all parameter group number callbacks associated with this control function
+		const NAMEMatcher NAMEFilterMatcher; ///< The NAME filters compiled into a mask and value, so matching a NAME is a single compare
+		ParameterGroupNumberCallbackTable parameterGroupNumberCallbacks; ///< A table of all parameter group number callbacks associated with this control function
 		bool initialized = false; ///< A way to track if the network manager has processed this CF against existing CFs
 	};
 
@@ -15,6 +15,7 @@
 #include "isobus/isobus/can_message_frame.hpp"
 #include "isobus/isobus/can_network_configuration.hpp"
 #include "isobus/isobus/can_transport_protocol_base.hpp"
+#include "isobus/isobus/can_transport_protocol_buffer_pool.hpp"
 
 namespace isobus
 {
@@ -175,9 +176,11 @@ namespace isobus
 		/// @param[in] sendCANFrameCallback A callback for sending a CAN frame to hardware
 		/// @param[in] canMessageReceivedCallback A callback for when a complete CAN message is received using the TP protocol
 		/// @param[in] configuration The configuration to use for this protocol
+		/// @param[in] bufferPool The pool to take receive buffers from, or nullptr to give this protocol its own pool
 		TransportProtocolManager(const CANMessageFrameCallback &sendCANFrameCallback,
 		                         const CANMessageCallback &canMessageReceivedCallback,
-		                         const CANNetworkConfiguration *configuration);
+		                         const CANNetworkConfiguration *configuration,
+		                         std::shared_ptr<TransportProtocolBufferPool> bufferPool = nullptr);
 
 		/// @brief Updates all sessions managed by this protocol manager instance.
 		void update();
@@ -193,6 +196,10 @@ namespace isobus
 		/// @returns A list of all the active transport protocol sessions
 		const std::vector<std::shared_ptr<TransportProtocolSession>> &get_sessions() const;
 
+		/// @brief Returns the pool that receive sessions take their buffers from
+		/// @returns The buffer pool used by this protocol
+		std::shared_ptr<TransportProtocolBufferPool> get_buffer_pool() const;
+
 		/// @brief A generic way for a protocol to process a received message
 		/// @param[in] message A received CAN message
 		void process_message(const CANMessage &message);
@@ -315,9 +322,11 @@ namespace isobus
 		void update_state_machine(std::shared_ptr<TransportProtocolSession> &session);
 
 		std::vector<std::shared_ptr<TransportProtocolSession>> activeSessions; ///< A list of all active TP sessions
+		TransportProtocolSessionIndex sessionIndex{ false }; ///< Finds active TP sessions by source and destination
 		const CANMessageFrameCallback sendCANFrameCallback; ///< A callback for sending a CAN frame
 		const CANMessageCallback canMessageReceivedCallback; ///< A callback for when a complete CAN message is received using the TP protocol
 		const CANNetworkConfiguration *configuration; ///< The configuration to use for this protocol
+		const std::shared_ptr<TransportProtocolBufferPool> bufferPool; ///< Provides the buffers for received messages, and takes them back once delivered
 	};
 
 } // namespace isobus
@@ -14,6 +14,8 @@
 #include "isobus/isobus/can_message.hpp"
 #include "isobus/isobus/can_message_data.hpp"
 
+#include <vector>
+
 namespace isobus
 {
 	/// @brief An object to keep track of session information internally
@@ -128,6 +130,75 @@ namespace isobus
 		TransmitCompleteCallback sessionCompleteCallback = nullptr; ///< A callback that is to be called when the session is completed
 		void *parent = nullptr; ///< A generic context variable that helps identify what object callbacks are destined for. Can be nullptr
 	};
+	/// @brief A hash index over the active sessions of a transport protocol, to find a session in constant time
+	/// @details Sessions are keyed by the identity of their source and destination control functions, the same
+	/// way TransportProtocolSessionBase::matches compares them, and optionally by their PGN for protocols that allow
+	/// multiple sessions between the same pair of control functions. The index uses open addressing with linear probing
+	/// in a flat array, so a lookup for a received frame doesn't need to walk the list of all sessions.
+	/// The index only references the sessions, the protocol is expected to keep its own list of sessions in order.
+	class TransportProtocolSessionIndex
+	{
+	public:
+		/// @brief Constructor for the index
+		/// @param[in] keyIncludesParameterGroupNumber Whether the PGN of a session is part of its key
+		explicit TransportProtocolSessionIndex(bool keyIncludesParameterGroupNumber);
+
+		/// @brief Adds a session to the index
+		/// @param[in] session The session to add
+		void add(std::shared_ptr<TransportProtocolSessionBase> session);
+
+		/// @brief Removes a session from the index
+		/// @param[in] session The session to remove
+		/// @returns `true` if the session was in the index and was removed, otherwise `false`
+		bool remove(const std::shared_ptr<TransportProtocolSessionBase> &session);
+
+		/// @brief Finds a session by its source and destination control functions, and PGN if it is part of the key
+		/// @param[in] source The source control function of the session
+		/// @param[in] destination The destination control function of the session
+		/// @param[in] parameterGroupNumber The PGN of the session, ignored if the PGN is not part of the key
+		/// @returns The session if found, otherwise nullptr
+		std::shared_ptr<TransportProtocolSessionBase> find(const ControlFunction *source,
+		                                                   const ControlFunction *destination,
+		                                                   std::uint32_t parameterGroupNumber = 0) const;
+
+		/// @brief Returns the number of sessions in the index
+		/// @returns The number of sessions in the index
+		std::size_t size() const;
+
+		/// @brief Removes all sessions from the index
+		void clear();
+
+	private:
+		/// @brief A single slot of the index, which is free if it has no session
+		struct Slot
+		{
+			const ControlFunction *source; ///< The source control function of the session
+			const ControlFunction *destination; ///< The destination control function of the session
+			std::uint32_t parameterGroupNumber; ///< The PGN of the session, or 0 if the PGN is not part of the key
+			std::shared_ptr<TransportProtocolSessionBase> session; ///< The indexed session, or nullptr if the slot is free
+		};
+
+		static constexpr std::size_t MINIMUM_INDEX_SIZE = 16; ///< The smallest number of slots, must be a power of 2
+
+		/// @brief Returns the slot where probing starts for a key
+		/// @param[in] source The source control function of the key
+		/// @param[in] destination The destination control function of the key
+		/// @param[in] parameterGroupNumber The PGN of the key
+		/// @returns The preferred slot for the key
+		std::size_t hash_slot(const ControlFunction *source, const ControlFunction *destination, std::uint32_t parameterGroupNumber) const;
+
+		/// @brief Inserts a session into the slots, assumes there is a free slot
+		/// @param[in] session The session to insert
+		void insert_into_slots(std::shared_ptr<TransportProtocolSessionBase> session);
+
+		/// @brief Resizes the index and re-inserts all sessions
+		/// @param[in] newSize The new number of slots, must be a power of 2
+		void resize(std::size_t newSize);
+
+		std::vector<Slot> slots; ///< The slots of the index, the size is always 0 or a power of 2
+		std::size_t numberOfSessions = 0; ///< The number of sessions in the index
+		bool keyIncludesParameterGroupNumber; ///< Whether the PGN of a session is part of its key
+	};
 } // namespace isobus
 
 #endif // CAN_TRANSPORT_PROTOCOL_BASE_HPP
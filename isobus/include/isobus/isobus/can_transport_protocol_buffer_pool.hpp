@@ -0,0 +1,106 @@
+//================================================================================================
+/// @file can_transport_protocol_buffer_pool.hpp
+///
+/// @brief A pool of reusable receive buffers for the transport protocols.
+/// @author Adrian Del Grosso
+/// @author Daan Steenbergen
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+
+#ifndef CAN_TRANSPORT_PROTOCOL_BUFFER_POOL_HPP
+#define CAN_TRANSPORT_PROTOCOL_BUFFER_POOL_HPP
+
+#include "isobus/utility/thread_synchronization.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace isobus
+{
+	//================================================================================================
+	/// @class TransportProtocolBufferPool
+	///
+	/// @brief Keeps the buffers of completed transport protocol sessions around so they can be reused.
+	/// @details Buffers are grouped in power of two size classes. When a receive session starts, it takes
+	/// a buffer of the matching class from the pool, the buffer is then moved into the completed CANMessage,
+	/// and handed back to the pool once the message has been delivered. Repeated transfers of similar sizes,
+	/// like object pool or DDOP uploads, therefore stop allocating once the pool has warmed up.
+	/// Buffers larger than MAXIMUM_POOLED_BUFFER_SIZE are allocated with their exact size and never kept.
+	/// The pool is thread safe, so it can be shared between the protocols of all CAN ports.
+	//================================================================================================
+	class TransportProtocolBufferPool
+	{
+	public:
+		/// @brief Counters that describe how well the pool is doing
+		struct Statistics
+		{
+			std::size_t hits; ///< The number of buffers that were served from the pool
+			std::size_t misses; ///< The number of buffers that had to be allocated
+			std::size_t bytesInUse; ///< The number of bytes in buffers that are currently handed out, counted by size class
+			std::size_t highWaterBytes; ///< The largest value bytesInUse has reached
+			std::size_t retainedBytes; ///< The number of bytes in buffers that are waiting in the pool
+		};
+
+		static constexpr std::size_t MINIMUM_POOLED_BUFFER_SIZE = 16; ///< The smallest size class, must be a power of 2
+		static constexpr std::size_t MAXIMUM_POOLED_BUFFER_SIZE = 1024 * 1024; ///< The largest size class, must be a power of 2
+		static constexpr std::size_t DEFAULT_MAXIMUM_RETAINED_BYTES = 4 * 1024 * 1024; ///< The default limit on the memory kept in the pool
+
+		/// @brief Returns a buffer with the requested size, with all bytes set to zero
+		/// @param[in] size The number of bytes the buffer needs to hold
+		/// @returns A buffer of `size` bytes, reused from the pool if possible
+		std::vector<std::uint8_t> acquire(std::size_t size);
+
+		/// @brief Gives a buffer back to the pool
+		/// @details The buffer is kept for reuse if its capacity fits a size class and the pool is below
+		/// its retention limit, otherwise it is freed. Buffers without any capacity are ignored. The buffer's size
+		/// must still be the one it was acquired with, since that's what the bytes in use are counted from.
+		/// @param[in] buffer The buffer to give back, it will be empty afterwards
+		void release(std::vector<std::uint8_t> &&buffer);
+
+		/// @brief Sets the maximum number of bytes the pool keeps around for reuse
+		/// @param[in] maximumRetainedBytes The new limit in bytes, buffers above the limit are freed right away
+		void set_maximum_retained_bytes(std::size_t maximumRetainedBytes);
+
+		/// @brief Returns the maximum number of bytes the pool keeps around for reuse
+		/// @returns The limit in bytes
+		std::size_t get_maximum_retained_bytes() const;
+
+		/// @brief Returns the current statistics of the pool
+		/// @returns The statistics of the pool
+		Statistics get_statistics() const;
+
+		/// @brief Frees all buffers that are waiting in the pool
+		void clear();
+
+	private:
+		static constexpr std::size_t NUMBER_OF_SIZE_CLASSES = 17; ///< The number of power of two classes from the minimum to the maximum size
+
+		/// @brief Returns the index of the smallest size class that can hold a number of bytes
+		/// @param[in] size The number of bytes
+		/// @returns The index of the size class, or NUMBER_OF_SIZE_CLASSES if the size is too large to be pooled
+		static std::size_t get_size_class_for_size(std::size_t size);
+
+		/// @brief Returns the number of bytes the pool allocates for a request
+		/// @param[in] size The number of bytes requested
+		/// @returns The size of the matching size class, or `size` if it's too large to be pooled
+		static std::size_t get_buffer_size_for_size(std::size_t size);
+
+		/// @brief Returns the index of the largest size class that fits in a capacity
+		/// @param[in] capacity The capacity of a buffer
+		/// @returns The index of the size class, or NUMBER_OF_SIZE_CLASSES if the capacity doesn't fit a size class
+		static std::size_t get_size_class_for_capacity(std::size_t capacity);
+
+		/// @brief Frees pooled buffers until the retained bytes are within the limit, starting with the largest ones
+		void trim_to_maximum_retained_bytes();
+
+		std::array<std::vector<std::vector<std::uint8_t>>, NUMBER_OF_SIZE_CLASSES> freeBuffers; ///< The buffers available for reuse, per size class
+		Statistics statistics = { 0, 0, 0, 0, 0 }; ///< The statistics of the pool
+		std::size_t maximumRetainedBytes = DEFAULT_MAXIMUM_RETAINED_BYTES; ///< The limit on the memory kept in the pool
+		mutable Mutex poolMutex; ///< Protects the buffers and statistics, the pool is shared between protocols
+	};
+} // namespace isobus
+
+#endif // CAN_TRANSPORT_PROTOCOL_BUFFER_POOL_HPP
@@ -141,6 +141,8 @@ namespace isobus
 		bool generate_task_data_iso_xml(std::string &resultantString);
 
 		/// @brief Gets an object from the DDOP that corresponds to a certain object ID
+		/// @details The DDOP keeps an index of its objects by ID, so finding an object doesn't depend on the size of the DDOP.
+		/// Changing an object's ID after it was added makes the DDOP rebuild the index the next time it's used.
 		/// @param[in] objectID The ID of the object to get
 		/// @returns Pointer to the object matching the provided ID, or nullptr if no match was found
 		std::shared_ptr<task_controller_object::Object> get_object_by_id(std::uint16_t objectID);
@@ -179,7 +181,30 @@ namespace isobus
 		/// @returns The number of objects in the DDOP
 		std::uint16_t size() const;
 
+		/// @brief Sets if objects added to the DDOP, including by deserialize_binary_object_pool, are allocated from an arena
+		/// @details The arena hands out memory from a few large blocks instead of making a heap allocation for each object,
+		/// which is useful for something like a TC server that parses a whole DDOP for every client that connects.
+		/// The blocks are freed together once the DDOP is cleared or destroyed and nothing else holds any of its objects.
+		/// Memory of objects removed with remove_object_by_id is not reused until then.
+		/// @param[in] enabled true to allocate new objects from the arena, false to allocate each one on the heap (the default)
+		void set_object_arena_enabled(bool enabled);
+
+		/// @brief Returns if objects added to the DDOP are allocated from an arena
+		/// @returns true if new objects are allocated from the arena, otherwise false
+		bool get_object_arena_enabled() const;
+
 	private:
+		class ObjectArena; ///< Hands out memory for objects from large blocks, defined in the source file
+
+		template<typename T>
+		class ObjectArenaAllocator; ///< A standard allocator for objects in an ObjectArena, defined in the source file
+
+		/// @brief Creates an object for the DDOP, in the arena if it is enabled
+		/// @param[in] args The arguments to pass to the object's constructor
+		/// @returns The new object
+		template<typename T, typename... Args>
+		std::shared_ptr<T> create_object(Args &&...args);
+
 		/// @brief Checks to see that all parent object IDs correspond to an object in this DDOP
 		/// @returns `true` if all object IDs were validated, otherwise `false`
 		bool resolve_parent_ids_to_objects();
@@ -189,9 +214,25 @@ namespace isobus
 		/// @returns true if the object ID parameter is unique in the DDOP, otherwise false
 		bool check_object_id_unique(std::uint16_t uniqueID) const;
 
+		/// @brief Finds the position of an object in the object list by its ID
+		/// @param[in] objectID The ID of the object to find
+		/// @returns The position of the object in the object list plus one, or NO_OBJECT if there is no such object
+		std::uint32_t find_object(std::uint16_t objectID) const;
+
+		/// @brief Adds the object at the back of the object list to the ID index
+		void index_last_object();
+
+		/// @brief Rebuilds the ID index from the object list, used when the positions or IDs of objects change
+		void rebuild_object_index() const;
+
 		static constexpr std::uint8_t MAX_TC_VERSION_SUPPORTED = 4; ///< The max TC version a DDOP object can support as of today
+		static constexpr std::uint32_t NO_OBJECT = 0; ///< The index value for an object ID that is not in the DDOP
 
 		std::vector<std::shared_ptr<task_controller_object::Object>> objectList; ///< Maintains a list of all added objects
+		mutable std::vector<std::uint32_t> objectIndex; ///< Maps an object ID to its position in objectList plus one, or NO_OBJECT
+		mutable std::uint32_t objectIndexIDChangeCount = 0; ///< The object ID change count the index was last rebuilt at
+		std::shared_ptr<ObjectArena> objectArena; ///< The arena new objects are allocated from, created when it is first needed
+		bool objectArenaEnabled = false; ///< Whether new objects are allocated from objectArena
 		std::uint8_t taskControllerCompatibilityLevel = MAX_TC_VERSION_SUPPORTED; ///< Stores the max TC version
 	};
 } // namespace isobus
@@ -15,7 +15,11 @@
 #include "isobus/isobus/isobus_language_command_interface.hpp"
 #include "isobus/utility/processing_flags.hpp"
 
+#include <array>
 #include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
 #include <thread>
 #endif
@@ -312,6 +316,19 @@ namespace isobus
 		/// @param[in] DDI The DDI of the process data variable that changed
 		void on_value_changed_trigger(std::uint16_t elementNumber, std::uint16_t DDI);
 
+		/// @brief Publishes the current value of a process data variable to the TC client.
+		/// @details This is an alternative to providing the value through your request value callbacks, which is much
+		/// cheaper when the TC sets threshold or on-change measurement commands on lots of variables. Once you publish
+		/// a variable's value, the TC client uses the published value instead of calling your callbacks for it, and only
+		/// checks that variable's threshold and on-change measurement commands when you publish a value that's different
+		/// from the last one, rather than polling your callbacks on every update. Publish the value again whenever it changes.
+		/// @note This is safe to call from any thread, including from within your callbacks.
+		/// Published values are processed on the next update.
+		/// @param[in] elementNumber The element number of the process data variable
+		/// @param[in] DDI The DDI of the process data variable
+		/// @param[in] value The current value of the process data variable
+		void publish_process_data_value(std::uint16_t elementNumber, std::uint16_t DDI, std::int32_t value);
+
 		/// @brief Sends a broadcast request to TCs to identify themseleves.
 		/// @details Upon receipt of this message, the TC shall display, for a period of 3 s, the TC Number
 		/// @returns `true` if the message was sent, otherwise `false`
@@ -434,6 +451,12 @@ namespace isobus
 		/// @brief Processes measurement threshold/interval commands
 		void process_queued_threshold_commands();
 
+		/// @brief Processes the time interval measurement commands that are due, by advancing the timer wheel to the current time. Caller must hold the client mutex
+		void process_measurement_timer_wheel();
+
+		/// @brief Processes the values published since the last update, and checks the threshold commands of the ones that changed. Caller must hold the client mutex
+		void process_published_values();
+
 		/// @brief Processes a CAN message destined for any TC client
 		/// @param[in] message The CAN message being received
 		/// @param[in] parentPointer A context variable to find the relevant TC client class
@@ -566,6 +589,7 @@ namespace isobus
 
 		static constexpr std::uint32_t SIX_SECOND_TIMEOUT_MS = 6000; ///< The startup delay time defined in the standard
 		static constexpr std::uint16_t TWO_SECOND_TIMEOUT_MS = 2000; ///< Used for sending the status message to the TC
+		static constexpr std::uint32_t MEASUREMENT_TIMER_WHEEL_SLOTS = 256; ///< The number of 1 ms slots in the time interval measurement timer wheel
 
 	private:
 		/// @brief Stores data related to requests and commands from the TC
@@ -581,6 +605,17 @@ namespace isobus
 			std::uint16_t ddi; ///< The DDI for the command
 			bool ackRequested; ///< Stores if the TC used the mux that also requires a PDACK
 			bool thresholdPassed; ///< Used when the structure is being used to track measurement command thresholds to know if the threshold has been passed
+			bool valueIsPublished; ///< Used for measurement threshold commands to know that the application publishes the value, so it doesn't need to be polled
+		};
+
+		/// @brief Stores the latest value the application published for a process data variable
+		struct PublishedValueInfo
+		{
+			std::int32_t value; ///< The latest published value
+			ProcessDataCallbackInfo *maximumThresholdCommand; ///< The variable's maximum threshold command, or nullptr if there isn't one
+			ProcessDataCallbackInfo *minimumThresholdCommand; ///< The variable's minimum threshold command, or nullptr if there isn't one
+			ProcessDataCallbackInfo *changeThresholdCommand; ///< The variable's on-change threshold command, or nullptr if there isn't one
+			bool changed; ///< Whether the value changed since the threshold commands were last checked
 		};
 
 		/// @brief Stores a TC value command callback along with its parent pointer
@@ -605,6 +640,43 @@ namespace isobus
 			void *parent; ///< The parent pointer, generic context value
 		};
 
+		/// @brief Returns the key used to look up a process data variable's published value
+		/// @param[in] elementNumber The element number of the process data variable
+		/// @param[in] DDI The DDI of the process data variable
+		/// @returns The key for the process data variable
+		static std::uint32_t get_published_value_key(std::uint16_t elementNumber, std::uint16_t DDI);
+
+		/// @brief Gets the current value of a process data variable, from the published values or the request value callbacks
+		/// @param[in] elementNumber The element number of the process data variable
+		/// @param[in] DDI The DDI of the process data variable
+		/// @param[out] value The current value of the process data variable
+		/// @returns true if the value was published or a callback provided it, otherwise false
+		bool get_process_data_value(std::uint16_t elementNumber, std::uint16_t DDI, std::int32_t &value);
+
+		/// @brief Checks a measurement threshold command against a new value, and sends the value to the TC if it triggers
+		/// @param[in] commandType Which kind of threshold command this is
+		/// @param[in] command The threshold command to check
+		/// @param[in] newValue The current value of the process data variable
+		/// @returns `false` if the threshold triggered but the value could not be sent, otherwise `true`
+		bool process_threshold_command(ProcessDataCommands commandType, ProcessDataCallbackInfo &command, std::int32_t newValue);
+
+		/// @brief Links a measurement threshold command to its variable's published value, if the application publishes it
+		/// @param[in] commandType Which kind of threshold command this is
+		/// @param[in] command The threshold command to link
+		void link_threshold_command_to_published_value(ProcessDataCommands commandType, ProcessDataCallbackInfo &command);
+
+		/// @brief Marks a published value as changed, so its threshold commands get checked on the next update
+		/// @param[in] publishedValue The published value to mark
+		void mark_published_value_changed(PublishedValueInfo &publishedValue);
+
+		/// @brief Puts a time interval measurement command in the timer wheel slot for when it's next due
+		/// @param[in] command The time interval measurement command to schedule
+		void schedule_time_interval_command(ProcessDataCallbackInfo &command);
+
+		/// @brief Removes a time interval measurement command from the timer wheel
+		/// @param[in] command The time interval measurement command to remove
+		void unschedule_time_interval_command(const ProcessDataCallbackInfo &command);
+
 		/// @brief Enumerates the modes that the client may use when dealing with a DDOP
 		enum class DDOPUploadType
 		{
@@ -628,7 +700,14 @@ namespace isobus
 		std::list<ProcessDataCallbackInfo> measurementMinimumThresholdCommands; ///< A list of measurement commands that will be processed when the value drops below a threshold
 		std::list<ProcessDataCallbackInfo> measurementMaximumThresholdCommands; ///< A list of measurement commands that will be processed when the value above a threshold
 		std::list<ProcessDataCallbackInfo> measurementOnChangeThresholdCommands; ///< A list of measurement commands that will be processed when the value changes by the specified amount
+		std::array<std::vector<ProcessDataCallbackInfo *>, MEASUREMENT_TIMER_WHEEL_SLOTS> measurementTimerWheel; ///< The time interval measurement commands, in the slot for the millisecond they're next due
+		std::vector<ProcessDataCallbackInfo *> measurementTimerWheelSlotBeingProcessed; ///< Holds the commands of the slot being processed, reused to avoid allocating
+		std::unordered_map<std::uint32_t, PublishedValueInfo> publishedValues; ///< The latest published value of each process data variable, by element number and DDI
+		std::vector<PublishedValueInfo *> changedPublishedValues; ///< The published values whose threshold commands need to be checked
+		std::vector<std::pair<std::uint32_t, std::int32_t>> pendingPublishedValues; ///< Values published since the last update, by element number and DDI
+		std::vector<std::pair<std::uint32_t, std::int32_t>> publishedValuesBeingProcessed; ///< The pending published values taken by the current update
 		Mutex clientMutex; ///< A general mutex to protect data in the worker thread against data accessed by the app or the network manager
+		Mutex publishedValuesMutex; ///< Protects the pending published values, so values can be published from within callbacks
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
 		std::thread *workerThread = nullptr; ///< The worker thread that updates this interface
 #endif
@@ -642,6 +721,7 @@ namespace isobus
 		std::uint32_t serverStatusMessageTimestamp_ms = 0; ///< Timestamp corresponding to the last time we received a status message from the TC
 		std::uint32_t userSuppliedBinaryDDOPSize_bytes = 0; ///< The number of bytes in the user provided binary DDOP (if one was provided)
 		std::uint32_t languageCommandWaitingTimestamp_ms = 0; ///< Timestamp used to determine when to give up on waiting for a language command response
+		std::uint32_t measurementTimerWheelTimestamp_ms = 0; ///< The last millisecond the measurement timer wheel has processed
 		std::uint8_t numberOfWorkingSetMembers = 1; ///< The number of working set members that will be reported in the working set master message
 		std::uint8_t tcStatusBitfield = 0; ///< The last received TC/DL status from the status message
 		std::uint8_t sourceAddressOfCommandBeingExecuted = 0; ///< Source address of client for which the current command is being executed
@@ -10,6 +10,7 @@
 #define ISOBUS_TASK_CONTROLLER_CLIENT_OBJECTS_HPP
 
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -57,6 +58,11 @@ namespace isobus
 			/// @param[in] id The object ID to set. IDs must be unique in the DDOP and less than or equal to MAX_OBJECT_ID
 			void set_object_id(std::uint16_t id);
 
+			/// @brief Returns a counter that changes whenever the ID of any object is changed
+			/// @details A DDOP uses this to know when the index it keeps of its objects' IDs has to be rebuilt
+			/// @returns The number of object ID changes, wrapping around
+			static std::uint32_t get_object_id_change_count();
+
 			/// @brief Returns the XML namespace for the object
 			/// @returns the XML namespace for the object
 			virtual std::string get_table_id() const = 0;
@@ -81,6 +87,9 @@ namespace isobus
 		protected:
 			std::string designator; ///< UTF-8 Descriptive text to identify this object. Max length of 32.
 			std::uint16_t objectID; ///< Unique object ID in the DDOP
+
+		private:
+			static std::atomic<std::uint32_t> objectIDChangeCount; ///< Counts changes to the ID of any object
 		};
 
 		/// @brief Each device shall have one single DeviceObject in its device descriptor object pool.
@@ -13,10 +13,17 @@
 #include "isobus/isobus/can_constants.hpp"
 #include "isobus/isobus/isobus_language_command_interface.hpp"
 #include "isobus/isobus/isobus_task_controller_server_options.hpp"
+#include "isobus/utility/thread_synchronization.hpp"
 
+#include <array>
 #include <deque>
+#include <unordered_map>
+#include <vector>
 
 #include <condition_variable>
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+#include <thread>
+#endif
 
 namespace isobus
 {
@@ -117,6 +124,16 @@ namespace isobus
 			Unknown = 0xFF
 		};
 
+		/// @brief A process data command for one element of one client, used to send many commands in one call
+		struct ClientProcessDataCommand
+		{
+			std::shared_ptr<ControlFunction> clientControlFunction; ///< The control function to send the command to
+			ProcessDataCommands command; ///< The command to send, like Value, SetValueAndAcknowledge, RequestValue or one of the measurement commands
+			std::uint16_t dataDescriptionIndex; ///< The data description index of the data element to send the command for
+			std::uint16_t elementNumber; ///< The element number of the data element to send the command for
+			std::uint32_t processDataValue; ///< The process data value to send, ignored for RequestValue
+		};
+
 		/// @brief Constructor for a TC server.
 		/// @param[in] internalControlFunction The control function to use to communicate with the clients.
 		/// @param[in] numberBoomsSupported The number of booms to report as supported by the TC.
@@ -332,6 +349,15 @@ namespace isobus
 		/// @returns true if the message was sent, otherwise false
 		bool send_set_value(std::shared_ptr<ControlFunction> clientControlFunction, std::uint16_t dataDescriptionIndex, std::uint16_t elementNumber, std::uint32_t processDataValue) const;
 
+		/// @brief Sends value commands, requests and measurement commands to any number of clients and elements in one call.
+		/// @details This is meant for servers that update lots of elements on lots of clients at once, like setting the
+		/// rate of every section on every implement. Commands are coalesced before anything is sent: if the list has more than
+		/// one command of the same type for the same client, DDI and element, only the last one is sent, since each one
+		/// replaces the value of the one before it. The rest are sent in the order they appear in the list, one frame each.
+		/// @param[in] commands The commands to send
+		/// @returns The number of commands that were sent, not counting the ones that were coalesced
+		std::size_t send_process_data_commands(const std::vector<ClientProcessDataCommand> &commands) const;
+
 		/// @brief Use this to set the reported task state in the status message.
 		/// Basically, this should be set to true when the user starts a job, and false when the user stops a job.
 		/// @note Don't be like some terminals which set this to true all the time, that's very annoying for the client.
@@ -355,6 +381,22 @@ namespace isobus
 		std::condition_variable &get_condition_variable();
 #endif
 
+		/// @brief Sets how many extra threads process messages from different clients in parallel
+		/// @details By default, all received messages are processed one after the other by the thread that calls update().
+		/// With worker threads, the messages received since the last update are split up by client, and each client's messages
+		/// are processed by one of the workers or the updating thread, in the order they were received. update() returns once
+		/// all clients' messages have been processed. This helps when your overrides, like store_device_descriptor_object_pool
+		/// or activate_object_pool, take a long time for large object pools, so one client doesn't hold up the others.
+		/// @attention With worker threads, your overrides may be called at the same time for different clients
+		/// from different threads, so they must be thread safe if they share data between clients.
+		/// @param[in] numberOfThreads The number of worker threads to use, or 0 to process all messages on the updating thread
+		/// @returns `true` if the setting was applied, otherwise `false` (threads are disabled in this build)
+		bool set_number_of_worker_threads(std::uint8_t numberOfThreads);
+
+		/// @brief Returns how many extra threads process messages from different clients in parallel
+		/// @returns The number of worker threads, or 0 if all messages are processed on the updating thread
+		std::uint8_t get_number_of_worker_threads() const;
+
 		// **** Functions used to initialize and run the server ****
 
 		/// @brief Initializes the task controller server.
@@ -416,6 +458,13 @@ namespace isobus
 			ChangeDesignatorResponse = 0x0D /// Sent in response to Change Designator message
 		};
 
+		/// @brief The messages received from one client, in the order they were received
+		struct ClientMessageStream
+		{
+			std::shared_ptr<ControlFunction> clientControlFunction; ///< The control function that sent the messages
+			std::vector<const CANMessage *> messages; ///< The client's messages, pointing into the messages being processed
+		};
+
 		/// @brief Stores information about a client that is currently being communicated with.
 		class ActiveClient
 		{
@@ -448,6 +497,26 @@ namespace isobus
 		/// to process messages if you want to avoid polling the interface at a high rate.
 		void process_rx_messages();
 
+		/// @brief Processes a single message received from a task controller client.
+		/// @param[in] rxMessage The message to process
+		void process_rx_message(const CANMessage &rxMessage);
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+		/// @brief Splits the messages being processed into one stream per client, and processes
+		/// the streams in parallel on the worker threads and the calling thread
+		void process_rx_messages_on_workers();
+
+		/// @brief Processes client message streams until there are none left for the current update
+		void process_client_message_streams();
+
+		/// @brief Stops and joins the worker threads
+		void stop_worker_threads();
+
+		/// @brief The loop for a worker thread, helps process client message streams every time it is woken up
+		/// @param[in] initialGeneration The task generation when the thread was started
+		void worker_thread_function(std::uint32_t initialGeneration);
+#endif
+
 		/// @brief This sends a process data message with all FFs in the payload except for the command byte.
 		/// Useful for avoiding a lot of boilerplate code when sending process data messages.
 		/// @param[in] multiplexer The multiplexer value to send in the message.
@@ -559,14 +628,29 @@ namespace isobus
 		                                 CANIdentifier::CANPriority priority = CANIdentifier::CANPriority::Priority5) const;
 
 		static constexpr std::uint32_t STATUS_MESSAGE_RATE_MS = 2000; ///< The rate at which status messages are sent to the clients in milliseconds.
+		static constexpr std::uint32_t WORKER_WAIT_TIMEOUT_MS = 100; ///< The longest a worker thread sleeps before checking its state again
 
 		LanguageCommandInterface languageCommandInterface; ///< The language command interface used to communicate with the client which language/units are in use.
 		std::shared_ptr<InternalControlFunction> serverControlFunction; ///< The control function used to communicate with the clients.
 		std::deque<CANMessage> rxMessageQueue; ///< A queue of messages received from the clients which will be processed when update is called.
-		std::deque<std::shared_ptr<ActiveClient>> activeClients; ///< A list of clients that are currently being communicated with.
+		std::deque<CANMessage> messagesBeingProcessed; ///< The messages taken from the rxMessageQueue by the current update, processed without holding the messagesMutex
+		std::vector<std::shared_ptr<ActiveClient>> activeClients; ///< A list of clients that are currently being communicated with.
+		std::array<std::unordered_map<std::uint64_t, std::shared_ptr<ActiveClient>>, CAN_PORT_MAXIMUM> activeClientIndex; ///< The active clients on each CAN port, by NAME
+		mutable Mutex activeClientsMutex; ///< Protects the activeClients list and index, which the worker threads share
+		mutable Mutex transmitMutex; ///< Makes sure the worker threads send their messages one at a time
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
 		std::condition_variable updateWakeupCondition; ///< A condition variable you can optionally use to update the interface when messages are received
 		std::mutex messagesMutex; ///< A mutex used to protect the rxMessageQueue.
+		std::vector<std::thread> workerThreads; ///< Threads that process client message streams in parallel, empty if messages are processed on the updating thread
+		std::condition_variable workerWakeupCondition; ///< Signals the worker threads that there are client message streams to process
+		std::condition_variable workerDoneCondition; ///< Signals the updating thread that all worker threads are done
+		std::mutex workerMutex; ///< Protects the worker thread state
+		std::uint32_t workerGeneration = 0; ///< Incremented for every update that uses the workers, so they know when to help
+		std::size_t workersBusy = 0; ///< The number of worker threads still processing client message streams for the current update
+		std::vector<ClientMessageStream> clientMessageStreams; ///< The messages being processed split up by client, reused between updates
+		std::size_t numberOfClientMessageStreams = 0; ///< The number of client message streams in use for the current update
+		std::size_t nextClientMessageStream = 0; ///< The next client message stream that needs to be processed
+		bool workersRunning = false; ///< Tells the worker threads to keep running
 #endif
 		std::uint32_t lastStatusMessageTimestamp_ms = 0; ///< The timestamp of the last status message sent on the bus
 		const TaskControllerVersion reportedVersion; ///< The version of the TC that will be reported to the clients.
@@ -12,11 +12,14 @@
 #include "isobus/isobus/can_internal_control_function.hpp"
 #include "isobus/isobus/can_partnered_control_function.hpp"
 #include "isobus/isobus/isobus_language_command_interface.hpp"
+#include "isobus/isobus/isobus_virtual_terminal_client_command_queue.hpp"
 #include "isobus/isobus/isobus_virtual_terminal_objects.hpp"
+#include "isobus/utility/data_span.hpp"
 #include "isobus/utility/event_dispatcher.hpp"
 #include "isobus/utility/processing_flags.hpp"
 #include "isobus/utility/thread_synchronization.hpp"
 
+#include <array>
 #include <functional>
 #include <map>
 #include <memory>
@@ -599,6 +602,41 @@ namespace isobus
 
 		// Command Messages
 
+		/// @brief Sets if commands waiting in the queue are coalesced
+		/// @details Commands queue up when they are sent faster than the VT responds. When coalescing is enabled (the default), a command that sets some state to an absolute value,
+		/// like a numeric value, string value, attribute, visibility, size or position, replaces a queued command that sets
+		/// the same state of the same object, instead of queueing behind it.
+		/// @param[in] enabled true to coalesce queued commands, false to send every command
+		void set_command_coalescing(bool enabled);
+
+		/// @brief Returns if commands waiting in the queue are coalesced
+		/// @returns true if queued commands are coalesced
+		bool get_command_coalescing() const;
+
+		/// @brief Sets how many commands can be sent to the VT before its responses to them arrive
+		/// @details By default, each command waits for the VT's response to the previous one, so the round trip to the VT
+		/// limits how many commands can be sent per second. With more than one command in flight, commands to different objects
+		/// are pipelined, and each response is matched to its command by function code and object ID. Commands that don't
+		/// target a single object, like changing the active mask or executing a macro, are still sent one at a time.
+		/// The client drops back to one command at a time while the VT reports it's busy, and until the next reconnection
+		/// if the VT leaves a pipelined command unanswered or sends a response that doesn't match any command in flight.
+		/// @param[in] maximumCommands The number of commands that can be in flight, from 1 (the default) to MAX_COMMANDS_IN_FLIGHT
+		void set_maximum_commands_in_flight(std::uint8_t maximumCommands);
+
+		/// @brief Returns how many commands can be sent to the VT before its responses to them arrive
+		/// @returns The configured number of commands that can be in flight
+		std::uint8_t get_maximum_commands_in_flight() const;
+
+		/// @brief Returns the number of commands that were sent to the VT and haven't been responded to yet
+		/// @returns The number of commands in flight
+		std::uint8_t get_number_of_commands_in_flight() const;
+
+		/// @brief Returns if the client stopped pipelining commands because the VT misbehaved
+		/// @returns true if commands are sent one at a time until the client reconnects to the VT
+		bool get_command_pipelining_fallback_active() const;
+
+		static constexpr std::uint8_t MAX_COMMANDS_IN_FLIGHT = 16; ///< The most commands that can be in flight at once
+
 		/// @brief Sends a hide/show object command
 		/// @details This command is used to hide or show a Container object.
 		/// This pertains to the visibility of the object as well as its
@@ -1234,6 +1272,16 @@ namespace isobus
 		                     const std::vector<std::uint8_t> *pool,
 		                     std::string version = "");
 
+		/// @brief Assigns an object pool to the client using a read-only span.
+		/// @details The data is uploaded straight from the span without a copy, which makes this a good fit for
+		/// pools that are memory mapped with MappedIOPFile.
+		/// @param[in] poolIndex The index of the pool you are assigning
+		/// @param[in] pool A span over the object pool. The data must remain valid until client is connected!
+		/// @param[in] version An optional version string. The stack will automatically store/load your pool from the VT if this is provided.
+		void set_object_pool(std::uint8_t poolIndex,
+		                     DataSpan<const std::uint8_t> pool,
+		                     std::string version = "");
+
 		/// @brief Configures an object pool to be automatically scaled to match the target VT server
 		/// @param[in] poolIndex The index of the pool you want to auto-scale
 		/// @param[in] originalDataMaskDimensions_px The data mask width that your object pool was originally designed for
@@ -1242,6 +1290,40 @@ namespace isobus
 		                             std::uint32_t originalDataMaskDimensions_px,
 		                             std::uint32_t originalSoftKyeDesignatorHeight_px);
 
+		/// @brief Sets if auto-scaled object pools are scaled while they are being uploaded
+		/// @details When enabled (the default), objects are scaled one at a time as the transport protocol asks
+		/// for the next chunk of the pool, and only a small window of the scaled pool is kept in RAM.
+		/// When disabled, each pool is copied and scaled completely before its upload starts,
+		/// which can be spread over multiple threads with set_object_pool_scaling_thread_count.
+		/// @param[in] enabled true to scale pools during the upload, false to scale them before the upload
+		void set_streaming_object_pool_scaling(bool enabled);
+
+		/// @brief Returns if auto-scaled object pools are scaled while they are being uploaded
+		/// @returns true if pools are scaled during the upload, false if they are scaled before the upload
+		bool get_streaming_object_pool_scaling() const;
+
+		/// @brief Sets the number of threads used to scale object pools before they are uploaded
+		/// @details Only used when streaming scaling is disabled. Objects are independent of each other,
+		/// so once the pool has been indexed they are split evenly over the threads.
+		/// @param[in] threadCount The number of threads to use, 0 or 1 scales on the calling thread
+		void set_object_pool_scaling_thread_count(std::uint8_t threadCount);
+
+		/// @brief Returns the number of threads used to scale object pools before they are uploaded
+		/// @returns The number of threads used to scale object pools
+		std::uint8_t get_object_pool_scaling_thread_count() const;
+
+		/// @brief Sets a directory in which auto-scaled object pools are cached between connections
+		/// @details Each scaled pool is stored in its own file, named after the hash of the original pool and the
+		/// capabilities of the VT it was scaled for: resolution, soft key size, supported fonts and the original dimensions.
+		/// When connecting to a VT with capabilities that were seen before, the cached pool is uploaded without scaling it again.
+		/// The directory must already exist. An empty string disables the cache, which is the default.
+		/// @param[in] directory The directory to store scaled pools in
+		void set_scaled_object_pool_cache_directory(const std::string &directory);
+
+		/// @brief Returns the directory in which auto-scaled object pools are cached
+		/// @returns The cache directory, or an empty string if the cache is disabled
+		const std::string &get_scaled_object_pool_cache_directory() const;
+
 		/// @brief Assigns an object pool to the client where the client will get data in chunks during upload.
 		/// @details This is probably better for huge pools if you are RAM constrained, or if your
 		/// pool is stored on some external device that you need to get data from in pages.
@@ -1313,6 +1395,7 @@ namespace isobus
 			std::vector<std::uint8_t> scaledObjectPool; ///< Stores a copy of a pool to auto-scale in RAM before uploading it
 			DataChunkCallback dataCallback; ///< A callback used to get data in chunks as an alternative to loading the whole pool at once
 			std::string versionLabel; ///< An optional version label that will be used to load/store the pool to the VT. 7 character max!
+			std::string poolHash; ///< A hash of the original pool, remembered for pools set from a constant buffer
 			std::uint32_t objectPoolSize; ///< The size of the object pool
 			std::uint32_t autoScaleDataMaskOriginalDimension; ///< The original length or width of this object pool's data mask area (in pixels)
 			std::uint32_t autoScaleSoftKeyDesignatorOriginalHeight; ///< The original height of a soft key designator as designed in the pool (in pixels)
@@ -1320,6 +1403,17 @@ namespace isobus
 			bool uploaded; ///< The upload state of this pool
 		};
 
+		/// @brief Stores the state of an object pool that is being scaled while it is uploaded
+		struct StreamingObjectPoolScaler
+		{
+			std::vector<std::uint8_t> scaledWindow; ///< The scaled objects, starting at scaledWindowStart and ending at the next object to scale
+			std::vector<std::uint8_t> sourceWindow; ///< Unscaled bytes of the pool, starting at sourceWindowStart
+			std::uint32_t poolIndex = 0; ///< The index of the pool being scaled
+			std::uint32_t scaledWindowStart = 0; ///< The offset in the pool of the first byte in scaledWindow
+			std::uint32_t sourceWindowStart = 0; ///< The offset in the pool of the first byte in sourceWindow
+			std::uint32_t callbackIndex = 0; ///< The number of times the pool's data chunk callback has been called
+		};
+
 		/// @brief A struct for storing information about an auxiliary input device
 		struct AssignedAuxiliaryInputDevice
 		{
@@ -1339,6 +1433,15 @@ namespace isobus
 			std::uint16_t value2; ///< The second value of the auxiliary input. See Table J.5 of Part 6 of the standard for details
 		};
 
+		/// @brief Stores a command that was sent to the VT and is waiting for its response
+		struct CommandInFlight
+		{
+			std::uint32_t timestamp_ms = 0; ///< The time the command was sent
+			std::uint16_t objectID = NULL_OBJECT_ID; ///< The object the command targets, if it's pipelined
+			std::uint8_t functionCode = 0; ///< The function code of the command
+			bool pipelined = false; ///< Whether the command targets one object, so other commands can be in flight with it
+		};
+
 		static constexpr std::uint64_t AUXILIARY_INPUT_STATUS_DELAY = 1000; ///< The delay between the auxiliary input status messages, in milliseconds
 		static constexpr std::uint64_t AUXILIARY_INPUT_STATUS_DELAY_INTERACTION = 50; ///< The delay between the auxiliary input status messages when the input is interacted with, in milliseconds
 
@@ -1513,9 +1616,103 @@ namespace isobus
 		bool get_any_pool_needs_scaling() const;
 
 		/// @brief Iterates through each object pool and scales each object in the pool automatically
+		/// @details Each pool is copied, indexed, and then scaled on up to objectPoolScalingThreadCount threads
 		/// @returns true if all object pools scaled with no error
 		bool scale_object_pools();
 
+		/// @brief Copies an object pool into its scaling buffer, indexes it, and scales each object
+		/// @param[in] objectPool The object pool to scale
+		/// @returns true if the object pool scaled with no error
+		bool scale_object_pool(ObjectPoolDataStruct &objectPool);
+
+		/// @brief Prepares the auto-scaled object pools for upload, from the cache if possible
+		/// @details Pools that miss the cache are scaled up front and stored in the cache. Without a cache,
+		/// or for a pool that could not be hashed, pools are only scaled up front if streaming scaling is disabled.
+		/// @returns true if all object pools were prepared with no error
+		bool prepare_scaled_object_pools();
+
+		/// @brief Returns a hash of the original contents of an object pool
+		/// @details The hash of a pool set from a constant buffer is only computed once. Pools set from a vector
+		/// or a data chunk callback are hashed on every call, as their contents can change after being set.
+		/// @param[in] poolIndex The index of the object pool to hash
+		/// @returns The hash of the object pool, or an empty string if its data chunk callback failed
+		std::string get_object_pool_hash(std::uint32_t poolIndex);
+
+		/// @brief Returns the key that identifies an object pool scaled for the connected VT
+		/// @details The key is made from the pool's hash, the VT's resolution, soft key size and supported fonts,
+		/// and the original dimensions the pool was designed for. It is also used as the pool's cache file name.
+		/// @param[in] poolIndex The index of the object pool
+		/// @returns The scaling key of the object pool, or an empty string if the pool could not be hashed
+		std::string get_scaled_object_pool_key(std::uint32_t poolIndex);
+
+		/// @brief Returns the version label used to store and load the object pools on the VT
+		/// @details If any pool is auto-scaled, the label is derived from the scaling keys of the pools and the
+		/// configured label, so a pool scaled for one set of VT capabilities is never loaded for another.
+		/// Otherwise the configured label is used as is.
+		/// @returns The version label, which is empty if no label was configured or an auto-scaled pool could not be hashed
+		std::string get_object_pool_version_label();
+
+		/// @brief Returns the path of the cache file for a scaled object pool
+		/// @param[in] poolIndex The index of the object pool
+		/// @returns The path of the cache file, or an empty string if the pool could not be hashed
+		std::string get_scaled_object_pool_cache_path(std::uint32_t poolIndex);
+
+		/// @brief Loads a scaled object pool from the cache into its scaling buffer
+		/// @details The cache file holds the scaled pool followed by its hash, which must match for the file to be used.
+		/// @param[in] poolIndex The index of the object pool to load
+		/// @param[in] cachePath The path of the pool's cache file
+		/// @returns true if the pool was found in the cache and loaded
+		bool load_scaled_object_pool_from_cache(std::uint32_t poolIndex, const std::string &cachePath);
+
+		/// @brief Stores a scaled object pool in the cache, followed by its hash
+		/// @param[in] poolIndex The index of the object pool to store, it must have been scaled up front
+		/// @param[in] cachePath The path of the pool's cache file
+		void store_scaled_object_pool_in_cache(std::uint32_t poolIndex, const std::string &cachePath);
+
+		/// @brief Scales a range of objects in an object pool that has been copied into its scaling buffer
+		/// @param[in] objectPool The object pool that holds the objects
+		/// @param[in] objectOffsets The offset of each object in the pool
+		/// @param[in] firstObject The index in objectOffsets of the first object to scale
+		/// @param[in] endObject The index in objectOffsets one past the last object to scale
+		/// @returns true if all objects in the range were scaled with no error
+		bool scale_object_range(ObjectPoolDataStruct &objectPool,
+		                        const std::vector<std::uint32_t> &objectOffsets,
+		                        std::size_t firstObject,
+		                        std::size_t endObject);
+
+		/// @brief Scales a single object with the scale factor that matches its type
+		/// @param[in] buffer A pointer to the start of the VT object
+		/// @param[in] objectPool The object pool the object belongs to, which holds the original dimensions
+		/// @returns true if the object was scaled with no error
+		bool scale_object(std::uint8_t *buffer, const ObjectPoolDataStruct &objectPool);
+
+		/// @brief Returns a range of bytes of an object pool, scaling the objects it covers as needed
+		/// @details Used by the upload callback when streaming scaling is enabled. Objects are scaled in the order
+		/// they are requested, and some already scaled bytes are kept so the transport protocol can retransmit them.
+		/// Requesting data before that window restarts scaling from the start of the pool.
+		/// @param[in] poolIndex The index of the object pool being uploaded
+		/// @param[in] offset The offset in the pool of the first byte to return
+		/// @param[in] length The number of bytes to return
+		/// @param[out] destination The buffer to write the scaled bytes to
+		/// @returns true if the bytes were returned, false if the pool could not be read or scaled
+		bool get_streamed_scaled_object_pool_bytes(std::uint32_t poolIndex,
+		                                           std::uint32_t offset,
+		                                           std::uint32_t length,
+		                                           std::uint8_t *destination);
+
+		/// @brief Returns a pointer to unscaled bytes of an object pool
+		/// @details The bytes are followed by at least OBJECT_SIZE_LOOKAHEAD readable bytes, which are zero past the
+		/// end of the pool, so that get_number_bytes_in_object can't read out of bounds on a malformed pool.
+		/// @param[in] poolIndex The index of the object pool to read from
+		/// @param[in] offset The offset in the pool of the first byte to return
+		/// @param[in] length The number of bytes that must be available
+		/// @returns A pointer to the bytes, or nullptr if the pool's data chunk callback failed
+		const std::uint8_t *get_object_pool_source_bytes(std::uint32_t poolIndex, std::uint32_t offset, std::uint32_t length);
+
+		/// @brief Frees the buffers used for streaming scaling and starts over at the beginning of a pool
+		/// @param[in] poolIndex The index of the object pool to scale next
+		void reset_streaming_object_pool_scaler(std::uint32_t poolIndex);
+
 		/// @brief Returns if the specified object type can be scaled
 		/// @param[in] type The object type to check
 		/// @returns true if the object is inherently scalable
@@ -1576,7 +1773,7 @@ namespace isobus
 		/// @returns true if the message was sent/queued successfully
 		bool queue_command(const std::vector<std::uint8_t> &data, bool replace = false);
 
-		/// @brief Replaces the first message in the queue with the same function-code and priority, and removes the rest
+		/// @brief Replaces the first message in the queue with the same function-code, and removes the rest
 		/// @note This will not queue a message if one does not already exist.
 		/// @param[in] data The data to send, including the function-code
 		/// @returns true if the message was replaced successfully
@@ -1585,12 +1782,35 @@ namespace isobus
 		/// @brief Tries to send all messages in the queue
 		void process_command_queue();
 
+		/// @brief Determines if a command (or response) targets one object, so it can be pipelined with commands to other objects
+		/// @param[in] data The command or response, including the function-code
+		/// @param[in] length The number of bytes in data
+		/// @param[in] isResponse If true, the data is a response from the VT rather than a command
+		/// @param[out] objectID The object the command targets, only valid if this returns true
+		/// @returns true if the command can be pipelined
+		static bool get_pipelined_command_object_id(const std::uint8_t *data, std::size_t length, bool isResponse, std::uint16_t &objectID);
+
+		/// @brief Removes the command a response from the VT answers from the commands in flight
+		/// @param[in] message The response from the VT
+		void process_command_response(const CANMessage &message);
+
+		/// @brief Returns how many commands can be in flight right now, taking the VT's busy codes and fallback into account
+		/// @returns The number of commands that can be in flight right now
+		std::uint8_t get_effective_maximum_commands_in_flight() const;
+
 		/// @brief The worker thread will execute this function when it runs, if applicable
 		void worker_thread_function();
 
 		static constexpr std::uint32_t VT_STATUS_TIMEOUT_MS = 3000; ///< The max allowable time between VT status messages before its considered offline
 		static constexpr std::uint32_t WORKING_SET_MAINTENANCE_TIMEOUT_MS = 1000; ///< The delay between working set maintenance messages
 		static constexpr std::uint32_t AUXILIARY_MAINTENANCE_TIMEOUT_MS = 100; ///< The delay between auxiliary maintenance messages
+		static constexpr std::uint32_t OBJECT_SIZE_LOOKAHEAD = 16 + 0xFFFF + 1; ///< The furthest get_number_bytes_in_object can read into an object, for an output string
+		static constexpr std::uint32_t STREAMING_SCALER_HISTORY_BYTES = 4096; ///< The number of scaled bytes kept behind the upload position for retransmissions
+		static constexpr std::uint32_t STREAMING_SCALER_SOURCE_CHUNK_SIZE = 2 * OBJECT_SIZE_LOOKAHEAD; ///< The number of unscaled bytes read at once while streaming
+		static constexpr std::uint32_t OBJECT_POOL_COPY_CHUNK_SIZE = 4096; ///< The number of bytes requested per data chunk callback when copying a pool to scale it
+		static constexpr std::size_t MINIMUM_OBJECTS_PER_SCALING_THREAD = 64; ///< Pools with fewer objects per thread than this use fewer threads
+		static constexpr std::uint32_t COMMAND_RESPONSE_TIMEOUT_MS = 1500; ///< The time the VT has to respond to a command before it's considered lost
+		static constexpr std::uint8_t SERIAL_COMMAND_BUSY_CODES = 0x9D; ///< Busy codes (updating mask, executing command or macro, parsing pool, out of memory) that stop pipelining
 
 		std::shared_ptr<PartneredControlFunction> partnerControlFunction; ///< The partner control function this client will send to
 		std::shared_ptr<InternalControlFunction> myControlFunction; ///< The internal control function the client uses to send from
@@ -1631,6 +1851,10 @@ namespace isobus
 		std::uint32_t lastWorkingSetMaintenanceTimestamp_ms = 0; ///< The timestamp from the last time we sent the maintenance message
 		std::uint32_t lastAuxiliaryMaintenanceTimestamp_ms = 0; ///< The timestamp from the last time we sent the maintenance message
 		std::vector<ObjectPoolDataStruct> objectPools; ///< A container to hold all object pools that have been assigned to the interface
+		StreamingObjectPoolScaler streamingObjectPoolScaler; ///< The state of the pool currently being scaled while it is uploaded
+		bool streamingObjectPoolScaling = true; ///< Determines if pools are scaled while they are uploaded instead of before
+		std::uint8_t objectPoolScalingThreadCount = 1; ///< The number of threads used to scale pools before they are uploaded
+		std::string scaledObjectPoolCacheDirectory; ///< The directory in which scaled pools are cached, or empty if the cache is disabled
 		std::vector<std::uint8_t> unsupportedFunctions; ///< Holds the functions unsupported by the server.
 		std::vector<AssignedAuxiliaryInputDevice> assignedAuxiliaryInputDevices; ///< A container to hold all auxiliary input devices known
 		std::uint16_t ourModelIdentificationCode = 1; ///< The model identification code of this input device
@@ -1645,10 +1869,14 @@ namespace isobus
 		bool shouldTerminate = false; ///< Used to determine if the client should exit and join the worker thread
 
 		// Command queue
-		std::vector<std::vector<std::uint8_t>> commandQueue; ///< A queue of commands to send to the VT server
-		bool commandAwaitingResponse = false; ///< Determines if we are currently waiting for a response to a command
-		std::uint32_t lastCommandTimestamp_ms = 0; ///< The timestamp of the last command sent
+		VirtualTerminalClientCommandQueue commandQueue; ///< A queue of commands to send to the VT server
+		bool commandCoalescing = true; ///< Determines if queued commands are replaced by newer commands that set the same state
+		std::array<CommandInFlight, MAX_COMMANDS_IN_FLIGHT> commandsInFlight; ///< The commands that are waiting for a response, oldest first
+		std::uint8_t numberOfCommandsInFlight = 0; ///< The number of entries in commandsInFlight that are in use
+		std::uint8_t maximumCommandsInFlight = 1; ///< The configured number of commands that can be in flight
+		bool commandPipeliningFallback = false; ///< Set when the VT misbehaved with pipelined commands, cleared on disconnection
 		Mutex commandQueueMutex; ///< A mutex to protect the command queue
+		Mutex commandsInFlightMutex; ///< A mutex to protect the commands in flight
 
 		// Activation event callbacks
 		EventDispatcher<VTKeyEvent> softKeyEventDispatcher; ///< A list of all soft key event callbacks
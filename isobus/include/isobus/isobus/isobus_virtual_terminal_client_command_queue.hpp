@@ -0,0 +1,119 @@
+//================================================================================================
+/// @file isobus_virtual_terminal_client_command_queue.hpp
+///
+/// @brief Defines the queue a VT client uses to hold commands until the VT can accept them.
+/// @author Adrian Del Grosso
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+#ifndef ISOBUS_VIRTUAL_TERMINAL_CLIENT_COMMAND_QUEUE_HPP
+#define ISOBUS_VIRTUAL_TERMINAL_CLIENT_COMMAND_QUEUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace isobus
+{
+	//================================================================================================
+	/// @class VirtualTerminalClientCommandQueue
+	///
+	/// @brief A first in, first out queue of VT commands that can coalesce redundant commands
+	/// @details Commands are stored in a ring of slots that is allocated up front. Each slot keeps
+	/// its buffer when the command in it is sent, so once the queue has warmed up, queueing a
+	/// command doesn't allocate. The ring only grows if more commands are waiting than it has slots.
+	///
+	/// Commands that set a piece of VT state to an absolute value, like changing a numeric value or
+	/// an attribute, can be coalesced: a newer one removes a queued one that targets the same object
+	/// (and attribute) before being added to the back, so a value that's updated faster than the VT can
+	/// respond only ever has its latest value waiting to be sent, and it's still sent after any
+	/// command that was queued before it.
+	//================================================================================================
+	class VirtualTerminalClientCommandQueue
+	{
+	public:
+		/// @brief Constructor for the command queue
+		/// @param[in] initialCapacity The number of command slots to allocate up front
+		explicit VirtualTerminalClientCommandQueue(std::size_t initialCapacity = DEFAULT_CAPACITY);
+
+		/// @brief Adds a command to the back of the queue
+		/// @param[in] data The command, including the function code
+		/// @param[in] coalesce If true and the command can be coalesced, a queued command that sets
+		/// the same state is removed
+		/// @returns true if the command replaced a queued command, otherwise false
+		bool push(const std::vector<std::uint8_t> &data, bool coalesce);
+
+		/// @brief Replaces the first queued command with the same function code, and removes the rest
+		/// @note This will not queue a command if one does not already exist.
+		/// @param[in] data The command, including the function code
+		/// @returns true if a queued command was replaced
+		bool replace_function(const std::vector<std::uint8_t> &data);
+
+		/// @brief Returns a command in the queue
+		/// @param[in] index The position of the command, where 0 is the front of the queue
+		/// @returns The command at that position
+		const std::vector<std::uint8_t> &at(std::size_t index) const;
+
+		/// @brief Removes a command from the queue, keeping the order of the others
+		/// @param[in] index The position of the command, where 0 is the front of the queue
+		void remove(std::size_t index);
+
+		/// @brief Removes all commands from the queue, keeping the slots for reuse
+		void clear();
+
+		/// @brief Returns the number of queued commands
+		/// @returns The number of queued commands
+		std::size_t size() const;
+
+		/// @brief Returns if the queue has no commands
+		/// @returns true if the queue has no commands
+		bool empty() const;
+
+		/// @brief Returns the number of command slots in the ring
+		/// @returns The number of command slots in the ring
+		std::size_t capacity() const;
+
+		/// @brief Returns the number of commands that replaced an already queued command
+		/// @returns The number of coalesced commands since the queue was created
+		std::uint32_t get_number_of_coalesced_commands() const;
+
+		/// @brief Determines if a command sets VT state to an absolute value, and if so, which state
+		/// @details The key is made of the function code and the object ID, plus the attribute ID,
+		/// list index or child ID for commands that only set part of an object's state.
+		/// @param[in] data The command, including the function code
+		/// @param[out] key The key of the state the command sets, only valid if this returns true
+		/// @returns true if a newer command with the same key makes this one redundant
+		static bool get_coalescing_key(const std::vector<std::uint8_t> &data, std::uint64_t &key);
+
+		static constexpr std::size_t DEFAULT_CAPACITY = 32; ///< The default number of command slots
+
+	private:
+		/// @brief A slot in the ring that holds one command
+		struct QueuedCommand
+		{
+			std::vector<std::uint8_t> data; ///< The command, including the function code. Keeps its capacity when the slot is reused.
+			std::uint64_t coalescingKey = 0; ///< The key of the state the command sets, if it can be coalesced
+			bool canCoalesce = false; ///< Whether a newer command with the same key can replace this one
+		};
+
+		/// @brief Returns the slot that holds a command
+		/// @param[in] index The position of the command, where 0 is the front of the queue
+		/// @returns The slot that holds the command
+		QueuedCommand &get_slot(std::size_t index);
+
+		/// @brief Returns the slot that holds a command
+		/// @param[in] index The position of the command, where 0 is the front of the queue
+		/// @returns The slot that holds the command
+		const QueuedCommand &get_slot(std::size_t index) const;
+
+		/// @brief Doubles the number of slots, moving the queued commands to the front of the new ring
+		void grow();
+
+		std::vector<QueuedCommand> slots; ///< The ring of command slots
+		std::size_t head = 0; ///< The slot that holds the front of the queue
+		std::size_t count = 0; ///< The number of queued commands
+		std::uint32_t numberOfCoalescedCommands = 0; ///< The number of commands that replaced a queued command
+	};
+} // namespace isobus
+
+#endif // ISOBUS_VIRTUAL_TERMINAL_CLIENT_COMMAND_QUEUE_HPP
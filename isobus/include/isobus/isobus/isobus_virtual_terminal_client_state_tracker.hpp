@@ -14,8 +14,11 @@
 #include "isobus/isobus/can_control_function.hpp"
 #include "isobus/isobus/can_message.hpp"
 
+#include <algorithm>
 #include <deque>
 #include <map>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace isobus
@@ -55,6 +58,114 @@ namespace isobus
 		/// @return The current numeric value of the tracked object.
 		std::uint32_t get_numeric_value(std::uint16_t objectId) const;
 
+		/// @brief Adds the 'hide/show' state of an object to track.
+		/// @param[in] objectId The object id of the container to track.
+		/// @param[in] initiallyShown Whether the object is shown in the object pool.
+		void add_tracked_visibility(std::uint16_t objectId, bool initiallyShown = true);
+
+		/// @brief Removes the 'hide/show' state of an object from tracking.
+		/// @param[in] objectId The object id of the container to remove from tracking.
+		void remove_tracked_visibility(std::uint16_t objectId);
+
+		/// @brief Gets whether a tracked object is currently shown.
+		/// @param[in] objectId The object id of the container to get the state of.
+		/// @return True if the object is shown, false if it's hidden or not tracked.
+		bool is_object_shown(std::uint16_t objectId) const;
+
+		/// @brief Adds the 'enable/disable' state of an object to track.
+		/// @param[in] objectId The object id of the input object to track.
+		/// @param[in] initiallyEnabled Whether the object is enabled in the object pool.
+		void add_tracked_enable_state(std::uint16_t objectId, bool initiallyEnabled = true);
+
+		/// @brief Removes the 'enable/disable' state of an object from tracking.
+		/// @param[in] objectId The object id of the input object to remove from tracking.
+		void remove_tracked_enable_state(std::uint16_t objectId);
+
+		/// @brief Gets whether a tracked object is currently enabled.
+		/// @param[in] objectId The object id of the input object to get the state of.
+		/// @return True if the object is enabled, false if it's disabled or not tracked.
+		bool is_object_enabled(std::uint16_t objectId) const;
+
+		/// @brief Adds the position of an object within its parent to track.
+		/// @param[in] objectId The object id of the child object to track.
+		/// @param[in] parentId The object id of the parent the position is relative to.
+		/// @param[in] initialX The x position of the object in the object pool.
+		/// @param[in] initialY The y position of the object in the object pool.
+		void add_tracked_position(std::uint16_t objectId, std::uint16_t parentId, std::uint16_t initialX = 0, std::uint16_t initialY = 0);
+
+		/// @brief Removes the position of an object from tracking.
+		/// @param[in] objectId The object id of the child object to remove from tracking.
+		void remove_tracked_position(std::uint16_t objectId);
+
+		/// @brief Gets the current position of a tracked object within its parent.
+		/// @param[in] objectId The object id of the child object to get the position of.
+		/// @return The x and y position of the object, or (0, 0) if it's not tracked.
+		std::pair<std::uint16_t, std::uint16_t> get_position(std::uint16_t objectId) const;
+
+		/// @brief Adds the size of an object to track.
+		/// @param[in] objectId The object id of the object to track.
+		/// @param[in] initialWidth The width of the object in the object pool.
+		/// @param[in] initialHeight The height of the object in the object pool.
+		void add_tracked_size(std::uint16_t objectId, std::uint16_t initialWidth = 0, std::uint16_t initialHeight = 0);
+
+		/// @brief Removes the size of an object from tracking.
+		/// @param[in] objectId The object id of the object to remove from tracking.
+		void remove_tracked_size(std::uint16_t objectId);
+
+		/// @brief Gets the current size of a tracked object.
+		/// @param[in] objectId The object id of the object to get the size of.
+		/// @return The width and height of the object, or (0, 0) if it's not tracked.
+		std::pair<std::uint16_t, std::uint16_t> get_size(std::uint16_t objectId) const;
+
+		/// @brief Adds the background colour of an object to track.
+		/// @param[in] objectId The object id of the object to track.
+		/// @param[in] initialColour The background colour of the object in the object pool.
+		void add_tracked_background_colour(std::uint16_t objectId, std::uint8_t initialColour = 0);
+
+		/// @brief Removes the background colour of an object from tracking.
+		/// @param[in] objectId The object id of the object to remove from tracking.
+		void remove_tracked_background_colour(std::uint16_t objectId);
+
+		/// @brief Gets the current background colour of a tracked object.
+		/// @param[in] objectId The object id of the object to get the background colour of.
+		/// @return The background colour of the object, or 0 if it's not tracked.
+		std::uint8_t get_background_colour(std::uint16_t objectId) const;
+
+		/// @brief Adds a string value to track.
+		/// @param[in] objectId The object id of the string value to track.
+		/// @param[in] initialValue The initial value of the string value to track.
+		void add_tracked_string_value(std::uint16_t objectId, const std::string &initialValue = "");
+
+		/// @brief Removes a string value from tracking.
+		/// @param[in] objectId The object id of the string value to remove from tracking.
+		void remove_tracked_string_value(std::uint16_t objectId);
+
+		/// @brief Gets the current string value of a tracked object.
+		/// @param[in] objectId The object id of the string value to get.
+		/// @return The current string value of the tracked object, or an empty string if it's not tracked.
+		std::string get_string_value(std::uint16_t objectId) const;
+
+		/// @brief Adds an item of a list object to track.
+		/// @param[in] objectId The object id of the list to track.
+		/// @param[in] index The index of the list item to track.
+		/// @param[in] initialItem The object id of the list item in the object pool.
+		void add_tracked_list_item(std::uint16_t objectId, std::uint8_t index, std::uint16_t initialItem = NULL_OBJECT_ID);
+
+		/// @brief Removes an item of a list object from tracking.
+		/// @param[in] objectId The object id of the list to remove from tracking.
+		/// @param[in] index The index of the list item to remove from tracking.
+		void remove_tracked_list_item(std::uint16_t objectId, std::uint8_t index);
+
+		/// @brief Gets the object currently at an index of a tracked list.
+		/// @param[in] objectId The object id of the list.
+		/// @param[in] index The index of the list item to get.
+		/// @return The object id of the list item, or NULL_OBJECT_ID if it's not tracked.
+		std::uint16_t get_list_item(std::uint16_t objectId, std::uint8_t index) const;
+
+		/// @brief Gets the input object that is currently selected on the server for this client.
+		/// @return The selected input object, or NULL_OBJECT_ID if none is known to be selected.
+		std::uint16_t get_selected_input_object() const;
+
 		/// @brief Get the data/alarm mask currently active on the server for this client. It may not be displayed if the working set is not active.
 		/// @return The data/alarm mask currently active on the server for this client.
 		std::uint16_t get_active_mask() const;
@@ -111,19 +222,121 @@ namespace isobus
 		std::uint32_t get_attribute(std::uint16_t objectId, std::uint8_t attribute) const;
 
 	protected:
+		/// @brief The states of an object that can be tracked, as bits of TrackedObject::trackedStates
+		enum class TrackedState : std::uint8_t
+		{
+			NumericValue = 0x01, ///< The 'numeric value' state
+			Shown = 0x02, ///< The 'hide/show' state
+			Enabled = 0x04, ///< The 'enable/disable' state
+			Position = 0x08, ///< The 'position (x,y)' state within the parent
+			Size = 0x10, ///< The 'size (width,height)' state
+			BackgroundColour = 0x20 ///< The 'background colour' state
+		};
+
+		/// @brief The fixed size states of one object
+		struct ObjectStates
+		{
+			std::uint32_t numericValue = 0; ///< The 'numeric value' state
+			std::uint16_t xPosition = 0; ///< The x part of the 'position' state, relative to the parent
+			std::uint16_t yPosition = 0; ///< The y part of the 'position' state, relative to the parent
+			std::uint16_t width = 0; ///< The width part of the 'size' state
+			std::uint16_t height = 0; ///< The height part of the 'size' state
+			std::uint8_t backgroundColour = 0; ///< The 'background colour' state
+			bool shown = true; ///< The 'hide/show' state
+			bool enabled = true; ///< The 'enable/disable' state
+		};
+
+		/// @brief The tracked states of one object, next to the states the object has in the object pool
+		struct TrackedObject
+		{
+			ObjectStates current; ///< The states of the object as the client last left them
+			ObjectStates initial; ///< The states of the object in the object pool, which the server shows after a (re)upload
+			std::uint32_t key = 0; ///< The object id
+			std::uint16_t parentId = NULL_OBJECT_ID; ///< The object id of the parent the position is relative to
+			std::uint8_t trackedStates = 0; ///< Which TrackedState bits of the states are tracked
+		};
+
+		/// @brief The tracked value of one attribute of an object
+		struct TrackedAttribute
+		{
+			std::uint32_t current = 0; ///< The value of the attribute as the client last left it
+			std::uint32_t initial = 0; ///< The value of the attribute in the object pool
+			std::uint32_t key = 0; ///< The object id, shifted left by 8 bits, with the attribute id in the lowest byte
+		};
+
+		/// @brief The tracked object at one index of a list
+		struct TrackedListItem
+		{
+			std::uint32_t key = 0; ///< The object id of the list, shifted left by 8 bits, with the index in the lowest byte
+			std::uint16_t current = NULL_OBJECT_ID; ///< The object at the index as the client last left it
+			std::uint16_t initial = NULL_OBJECT_ID; ///< The object at the index in the object pool
+		};
+
+		/// @brief The tracked value of a string object
+		struct TrackedStringValue
+		{
+			std::string current; ///< The value as the client last left it
+			std::string initial; ///< The value in the object pool
+			std::uint32_t key = 0; ///< The object id
+		};
+
+		/// @brief Gets the tracked states of an object, if the requested state is tracked for it.
+		/// @param[in] objectId The object id of the object.
+		/// @param[in] state The state that must be tracked.
+		/// @return The tracked states of the object, or nullptr if the state isn't tracked for the object.
+		TrackedObject *get_tracked_object(std::uint16_t objectId, TrackedState state);
+
+		/// @brief Gets the tracked states of an object, if the requested state is tracked for it.
+		/// @param[in] objectId The object id of the object.
+		/// @param[in] state The state that must be tracked.
+		/// @return The tracked states of the object, or nullptr if the state isn't tracked for the object.
+		const TrackedObject *get_tracked_object(std::uint16_t objectId, TrackedState state) const;
+
+		/// @brief Finds the entry with a key in one of the sorted state containers.
+		/// @param[in] states The container to search.
+		/// @param[in] key The key of the entry to find.
+		/// @return An iterator to the entry, or the end of the container if there's no entry with the key.
+		template<typename Container>
+		static auto find_state(Container &states, std::uint32_t key) -> decltype(states.begin())
+		{
+			auto result = std::lower_bound(states.begin(), states.end(), key, [](const typename Container::value_type &state, std::uint32_t value) { return state.key < value; });
+			if ((result != states.end()) && (result->key != key))
+			{
+				result = states.end();
+			}
+			return result;
+		}
+
+		/// @brief Finds the entry with a key in one of the sorted state containers, or inserts one in order.
+		/// @param[in] states The container to search.
+		/// @param[in] key The key of the entry to find.
+		/// @param[out] inserted Set to true if the entry was inserted.
+		/// @return The entry with the key.
+		template<typename T>
+		static T &find_or_insert_state(std::vector<T> &states, std::uint32_t key, bool &inserted)
+		{
+			auto result = std::lower_bound(states.begin(), states.end(), key, [](const T &state, std::uint32_t value) { return state.key < value; });
+			inserted = ((result == states.end()) || (result->key != key));
+			if (inserted)
+			{
+				result = states.insert(result, T());
+				result->key = key;
+			}
+			return *result;
+		}
+
 		std::shared_ptr<ControlFunction> client; ///< The control function of the virtual terminal client to track.
 		std::shared_ptr<ControlFunction> server; ///< The control function of the server the client is connected to.
 
-		//! TODO: std::map<std::uint16_t, bool> shownStates; ///< Holds the 'hide/show' state of tracked objects.
-		//! TODO: std::map<std::uint16_t, bool> enabledStates; ///< Holds the 'enable/disable' state of tracked objects.
-		//! TODO: std::map<std::uint16_t, bool> selectedStates; ///< Holds the 'selected for input' state of tracked objects.
+		// The tracked states are stored in flat containers sorted by object id, and looked up with a binary search.
+		// Each entry keeps the state from the object pool next to the current one, so the difference can be restored after a reconnection.
+		std::vector<TrackedObject> trackedObjects; ///< Holds the numeric value, hide/show, enable/disable, position, size and background colour states of tracked objects.
+		std::vector<TrackedAttribute> attributeStates; ///< Holds the 'attribute' state of tracked objects.
+		std::vector<TrackedListItem> listItemStates; ///< Holds the 'list item' state of tracked objects.
+		std::vector<TrackedStringValue> stringValueStates; ///< Holds the 'string value' state of tracked objects.
+		std::uint16_t selectedInputObject = NULL_OBJECT_ID; ///< Holds the input object currently selected on the server for this client.
 		//! TODO: add current audio signal state
 		//! TODO: std::uint8_t audioVolumeState; ///< Holds the current audio volume.
-		//! TODO: std::map<std::uint16_t, std::pair<std::uint16_t, std::uint16_t>> positionStates; ///< Holds the 'position (x,y)' state of tracked objects.
-		//! TODO: std::map<std::uint16_t, std::pair<std::uint16_t, std::uint16_t>> sizeStates; ///< Holds the 'size (width,height)' state of tracked objects.
-		//! TODO: std::map<std::uint16_t, std::uint8_t> backgroundColourStates; ///< Holds the 'background colour' state of tracked objects.
-		std::map<std::uint16_t, std::uint32_t> numericValueStates; ///< Holds the 'numeric value' state of tracked objects.
-		//! TODO: std::map<std::uint16_t, std::string> stringValueStates; ///< Holds the 'string value' state of tracked objects.
 		//! TODO: std::map<std::uint16_t, std::uint8_t> endPointStates; ///< Holds the 'end point' state of tracked objects.
 		//! TODO: add font attribute state
 		//! TODO: add line attribute state
@@ -133,9 +346,8 @@ namespace isobus
 		std::size_t maxDataAndAlarmMaskHistorySize = 100; ///< Holds the maximum size of the data/alarm mask history.
 		std::uint8_t activeWorkingSetAddress = NULL_CAN_ADDRESS; ///< Holds the address of the control function that currently has
 		std::map<std::uint16_t, std::uint16_t> softKeyMasks; ///< Holds the data/alarms masks with their associated soft keys masks for tracked objects.
-		std::map<std::uint16_t, std::map<std::uint8_t, std::uint32_t>> attributeStates; ///< Holds the 'attribute' state of tracked objects.
+		std::map<std::uint16_t, std::uint16_t> initialSoftKeyMasks; ///< Holds the soft key mask each tracked data/alarm mask was added to tracking with.
 		//! TODO: std::map<std::uint16_t, std::uint8_t> alarmMaskPrioritiesStates; ///< Holds the 'alarm mask priority' state of tracked objects.
-		//! TODO: std::map<std::uint16_t, std::pair<std::uint8_t, std::uint16_t>> listItemStates; ///< Holds the 'list item' state of tracked objects.
 		//! TODO: add lock/unlock mask state
 		//! TODO: add object label state
 		//! TODO: add polygon point state
@@ -165,6 +377,19 @@ namespace isobus
 		/// @param[in] message The message to process.
 		void process_message_to_connected_server(const CANMessage &message);
 
+		/// @brief Adds a state of an object to track.
+		/// @param[in] objectId The object id of the object.
+		/// @param[in] state The state to track.
+		/// @param[in] functionName The name of the calling function, for logging.
+		/// @return The tracked states of the object, or nullptr if the state was already tracked.
+		TrackedObject *add_tracked_state(std::uint16_t objectId, TrackedState state, const char *functionName);
+
+		/// @brief Removes a state of an object from tracking, and the object once none of its states are tracked.
+		/// @param[in] objectId The object id of the object.
+		/// @param[in] state The state to remove from tracking.
+		/// @param[in] functionName The name of the calling function, for logging.
+		void remove_tracked_state(std::uint16_t objectId, TrackedState state, const char *functionName);
+
 		/// @brief Data structure to hold the properties of a change attribute command
 		struct ChangeAttributeCommand
 		{
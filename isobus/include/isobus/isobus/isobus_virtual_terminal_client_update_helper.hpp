@@ -13,12 +13,123 @@
 #include "isobus/isobus/isobus_virtual_terminal_client.hpp"
 #include "isobus/isobus/isobus_virtual_terminal_client_state_tracker.hpp"
 
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace isobus
 {
 	/// @brief A helper class to update and track the state of an active working set.
 	class VirtualTerminalClientUpdateHelper : public VirtualTerminalClientStateTracker
 	{
 	public:
+		/// @brief A batch of states that the working set should be in.
+		/// @details Applying it with apply_desired_state only sends a command for each state that differs from the
+		/// tracked state. Setting the same state more than once keeps only the last value.
+		class DesiredState
+		{
+		public:
+			/// @brief Sets the desired numeric value of an object.
+			/// @param[in] objectId The object id of the numeric value.
+			/// @param[in] value The desired value.
+			void set_numeric_value(std::uint16_t objectId, std::uint32_t value);
+
+			/// @brief Sets whether an object should be shown.
+			/// @param[in] objectId The object id of the container.
+			/// @param[in] shown True to show the object, false to hide it.
+			void set_shown(std::uint16_t objectId, bool shown);
+
+			/// @brief Sets whether an object should be enabled.
+			/// @param[in] objectId The object id of the input object.
+			/// @param[in] enabled True to enable the object, false to disable it.
+			void set_enabled(std::uint16_t objectId, bool enabled);
+
+			/// @brief Sets the desired position of an object within the parent it's tracked with.
+			/// @param[in] objectId The object id of the child object.
+			/// @param[in] xPosition The desired x position.
+			/// @param[in] yPosition The desired y position.
+			void set_position(std::uint16_t objectId, std::uint16_t xPosition, std::uint16_t yPosition);
+
+			/// @brief Sets the desired size of an object.
+			/// @param[in] objectId The object id of the object.
+			/// @param[in] width The desired width.
+			/// @param[in] height The desired height.
+			void set_size(std::uint16_t objectId, std::uint16_t width, std::uint16_t height);
+
+			/// @brief Sets the desired background colour of an object.
+			/// @param[in] objectId The object id of the object.
+			/// @param[in] colour The desired background colour.
+			void set_background_colour(std::uint16_t objectId, std::uint8_t colour);
+
+			/// @brief Sets the desired string value of an object.
+			/// @param[in] objectId The object id of the string value.
+			/// @param[in] value The desired value.
+			void set_string_value(std::uint16_t objectId, const std::string &value);
+
+			/// @brief Sets the desired object at an index of a list.
+			/// @param[in] objectId The object id of the list.
+			/// @param[in] index The index of the list item.
+			/// @param[in] item The object id of the desired list item.
+			void set_list_item(std::uint16_t objectId, std::uint8_t index, std::uint16_t item);
+
+			/// @brief Sets the desired value of an attribute of an object.
+			/// @param[in] objectId The object id of the object.
+			/// @param[in] attribute The attribute id.
+			/// @param[in] value The desired value.
+			void set_attribute(std::uint16_t objectId, std::uint8_t attribute, std::uint32_t value);
+
+			/// @brief Sets the desired active data/alarm mask.
+			/// @param[in] workingSetId The working set to set the active data/alarm mask for.
+			/// @param[in] dataOrAlarmMaskId The data/alarm mask that should be active.
+			void set_active_data_or_alarm_mask(std::uint16_t workingSetId, std::uint16_t dataOrAlarmMaskId);
+
+			/// @brief Removes all states from the batch, keeping the allocated memory for reuse.
+			void clear();
+
+			/// @brief Returns the number of states in the batch.
+			/// @return The number of states in the batch.
+			std::size_t size() const;
+
+		private:
+			friend class VirtualTerminalClientUpdateHelper;
+
+			/// @brief The kinds of state a batch can hold
+			enum class StateType : std::uint8_t
+			{
+				NumericValue, ///< A numeric value, in value
+				Shown, ///< A hide/show state, in value
+				Enabled, ///< An enable/disable state, in value
+				Position, ///< A position, with x in the low and y in the high half of value
+				Size, ///< A size, with width in the low and height in the high half of value
+				BackgroundColour, ///< A background colour, in value
+				StringValue, ///< A string value, with value as an index into stringValues
+				ListItem, ///< A list item, with the index in subId and the item in value
+				Attribute, ///< An attribute, with the attribute id in subId
+				ActiveMask ///< The active mask, with the mask in the low and the working set in the high half of value
+			};
+
+			/// @brief One desired state
+			struct Entry
+			{
+				std::uint32_t value; ///< The desired value, packed according to type
+				std::uint16_t objectId; ///< The object the state belongs to
+				StateType type; ///< The kind of state
+				std::uint8_t subId; ///< The attribute id or list index, if applicable
+			};
+
+			/// @brief Adds a state to the batch, or replaces the value of the same state if it's already in the batch
+			/// @param[in] type The kind of state
+			/// @param[in] objectId The object the state belongs to
+			/// @param[in] subId The attribute id or list index, if applicable
+			/// @param[in] value The desired value, packed according to type
+			/// @return The entry of the state
+			Entry &set(StateType type, std::uint16_t objectId, std::uint8_t subId, std::uint32_t value);
+
+			std::vector<Entry> entries; ///< The desired states, in the order they were first set
+			std::vector<std::string> stringValues; ///< The desired string values, referenced by the entries
+		};
+
 		/// @brief The constructor of class to help update the state of an active working set.
 		/// @param[in] client The virtual terminal client that provides the active working set.
 		explicit VirtualTerminalClientUpdateHelper(std::shared_ptr<VirtualTerminalClient> client);
@@ -51,6 +162,11 @@ namespace isobus
 		/// @param[in] callback The callback function to register, or nullptr to unregister.
 		void set_callback_validate_numeric_value(const std::function<bool(std::uint16_t, std::uint32_t)> &callback);
 
+		/// @brief Sets the data/alarm mask the working set object has active in the object pool.
+		/// @details Lets restore_tracked_state skip the active mask when it is the one the server shows after loading the pool.
+		/// @param[in] dataOrAlarmMaskId The active data/alarm mask of the working set object in the object pool.
+		void set_initial_active_mask(std::uint16_t dataOrAlarmMaskId);
+
 		/// @brief Sets the active data/alarm mask.
 		/// @param[in] workingSetId The working set to set the active data/alarm mask for.
 		/// @param[in] dataOrAlarmMaskId The data/alarm mask to set active.
@@ -74,12 +190,74 @@ namespace isobus
 		/// @return True if the attribute was set successfully, false otherwise.
 		bool set_attribute(std::uint16_t objectId, std::uint8_t attribute, std::uint32_t value);
 
+		/// @brief Shows or hides a tracked object.
+		/// @param[in] objectId The object id of the container to show or hide.
+		/// @param[in] shown True to show the object, false to hide it.
+		/// @return True if the state was set successfully, false otherwise.
+		bool set_object_shown(std::uint16_t objectId, bool shown);
+
+		/// @brief Enables or disables a tracked object.
+		/// @param[in] objectId The object id of the input object to enable or disable.
+		/// @param[in] enabled True to enable the object, false to disable it.
+		/// @return True if the state was set successfully, false otherwise.
+		bool set_object_enabled(std::uint16_t objectId, bool enabled);
+
+		/// @brief Sets the position of a tracked object within the parent it's tracked with.
+		/// @param[in] objectId The object id of the child object to move.
+		/// @param[in] xPosition The x position to move the object to.
+		/// @param[in] yPosition The y position to move the object to.
+		/// @return True if the position was set successfully, false otherwise.
+		bool set_position(std::uint16_t objectId, std::uint16_t xPosition, std::uint16_t yPosition);
+
+		/// @brief Sets the size of a tracked object.
+		/// @param[in] objectId The object id of the object to resize.
+		/// @param[in] width The width to set.
+		/// @param[in] height The height to set.
+		/// @return True if the size was set successfully, false otherwise.
+		bool set_size(std::uint16_t objectId, std::uint16_t width, std::uint16_t height);
+
+		/// @brief Sets the background colour of a tracked object.
+		/// @param[in] objectId The object id of the object to change.
+		/// @param[in] colour The background colour to set.
+		/// @return True if the background colour was set successfully, false otherwise.
+		bool set_background_colour(std::uint16_t objectId, std::uint8_t colour);
+
+		/// @brief Sets the string value of a tracked object.
+		/// @param[in] objectId The object id of the string value to set.
+		/// @param[in] value The value to set the string value to.
+		/// @return True if the value was set successfully, false otherwise.
+		bool set_string_value(std::uint16_t objectId, const std::string &value);
+
+		/// @brief Sets the object at an index of a tracked list.
+		/// @param[in] objectId The object id of the list.
+		/// @param[in] index The index of the list item to set.
+		/// @param[in] item The object id to put at the index.
+		/// @return True if the list item was set successfully, false otherwise.
+		bool set_list_item(std::uint16_t objectId, std::uint8_t index, std::uint16_t item);
+
+		/// @brief Moves the working set to a batch of desired states, sending only the commands for the states that differ from the tracked state.
+		/// @param[in] desiredState The states the working set should be in. All of them must be tracked.
+		/// @return True if every differing state was set successfully, false otherwise.
+		bool apply_desired_state(const DesiredState &desiredState);
+
+		/// @brief Sends the commands that bring a freshly (re)loaded object pool back to the tracked state.
+		/// @details After the client reconnects, the server shows the object pool as it was uploaded. Only the tracked states that
+		/// differ from the values they were added to tracking with are sent, so restoring the screen takes as few frames as possible.
+		/// The active data/alarm mask and soft key masks last set through this helper are restored after the other states,
+		/// unless they match the initial active mask and the initial soft key masks of the tracked data/alarm masks.
+		/// @return True if every differing state was sent successfully, false otherwise.
+		bool restore_tracked_state();
+
 	private:
 		/// @brief Processes a numeric value change event
 		/// @param[in] event The numeric value change event to process.
 		void process_numeric_value_change_event(const VirtualTerminalClient::VTChangeNumericValueEvent &event);
 
 		std::shared_ptr<VirtualTerminalClient> vtClient; ///< Holds the vt client.
+		std::uint16_t workingSetObjectId = NULL_OBJECT_ID; ///< Holds the working set the active data/alarm mask was last set for.
+		std::uint16_t initialDataOrAlarmMask = NULL_OBJECT_ID; ///< Holds the active data/alarm mask of the working set object in the object pool.
+		std::uint16_t selectedDataOrAlarmMask = NULL_OBJECT_ID; ///< Holds the data/alarm mask last set active through this helper.
+		std::map<std::uint16_t, std::pair<VirtualTerminalClient::MaskType, std::uint16_t>> selectedSoftKeyMasks; ///< Holds the soft key mask last set through this helper for each data/alarm mask.
 
 		std::function<bool(std::uint16_t, std::uint32_t)> callbackValidateNumericValue; ///< Holds the callback function to validate a numeric value change.
 		EventCallbackHandle numericValueChangeEventHandle; ///< Holds the handle to the numeric value change event listener
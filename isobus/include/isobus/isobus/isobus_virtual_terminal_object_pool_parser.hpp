@@ -0,0 +1,73 @@
+//================================================================================================
+/// @file isobus_virtual_terminal_object_pool_parser.hpp
+///
+/// @brief Defines a parser that turns binary (IOP) VT object pool data into VT objects.
+/// @author Adrian Del Grosso
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+#ifndef ISOBUS_VIRTUAL_TERMINAL_OBJECT_POOL_PARSER_HPP
+#define ISOBUS_VIRTUAL_TERMINAL_OBJECT_POOL_PARSER_HPP
+
+#include "isobus/isobus/isobus_virtual_terminal_objects.hpp"
+#include "isobus/utility/data_span.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace isobus
+{
+	//================================================================================================
+	/// @class VTObjectPoolParser
+	///
+	/// @brief Parses binary VT object pool data, like the content of an IOP file, into a VTObjectPool
+	/// @details The pool is read front to back straight out of the caller's bytes, without copying
+	/// them into an intermediate buffer first, and every read is bounds checked so malformed or
+	/// truncated data is reported instead of read past. Once all objects are built, each one is
+	/// checked with its own get_is_valid, and the child and macro references are resolved against
+	/// the pool. That second step can't happen while parsing because objects may reference
+	/// objects that come later in the pool.
+	///
+	/// Object types that have no VTObject class yet (like graphics contexts and animations) are
+	/// stepped over and counted, so a pool that uses them can still be checked. Their IDs are
+	/// remembered, so references to them resolve and duplicates of their IDs are reported.
+	//================================================================================================
+	class VTObjectPoolParser
+	{
+	public:
+		/// @brief Enumerates the reasons a pool can fail to parse
+		enum class Error : std::uint8_t
+		{
+			None = 0, ///< The pool was parsed successfully
+			Truncated, ///< An object extends past the end of the data
+			UnknownObjectType, ///< An object has a type that isn't defined by ISO 11783-6
+			DuplicateObjectID, ///< More than one object has the same object ID
+			InvalidObject, ///< An object failed its validity check, like having a child of a type it can't contain
+			UnresolvedReference ///< An object references a child or macro that isn't in the pool
+		};
+
+		/// @brief The outcome of parsing an object pool
+		struct Result
+		{
+			Error error = Error::None; ///< Why the pool failed to parse, or Error::None
+			std::size_t errorOffset = 0; ///< The byte offset of the object that caused the error
+			std::uint16_t errorObjectID = NULL_OBJECT_ID; ///< The ID of the object that caused the error, if it could be read
+			std::uint32_t numberOfParsedObjects = 0; ///< The number of objects that were added to the pool
+			std::uint32_t numberOfSkippedObjects = 0; ///< The number of objects that were stepped over because they have no VTObject class
+		};
+
+		/// @brief Parses a binary object pool and adds its objects to a VTObjectPool
+		/// @param[in] iopData The binary object pool data
+		/// @param[in,out] objectPool The pool to add the parsed objects to. On failure it may hold the objects parsed before the error.
+		/// @param[in] validateObjects If true, each object is validated and its references are resolved after parsing
+		/// @returns The outcome of parsing, with Result::error set to Error::None if the pool was parsed (and validated) successfully
+		static Result parse(DataSpan<const std::uint8_t> iopData, VTObjectPool &objectPool, bool validateObjects = true);
+
+		/// @brief Returns a readable name for a parse error, for logging
+		/// @param[in] error The error to describe
+		/// @returns A short description of the error
+		static const char *get_error_description(Error error);
+	};
+} // namespace isobus
+
+#endif // ISOBUS_VIRTUAL_TERMINAL_OBJECT_POOL_PARSER_HPP
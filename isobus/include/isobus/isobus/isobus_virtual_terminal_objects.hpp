@@ -12,7 +12,6 @@
 #include "isobus/isobus/can_constants.hpp"
 
 #include <array>
-#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -178,6 +177,72 @@ namespace isobus
 		std::array<VTColourVector, VT_COLOUR_TABLE_SIZE> colourTable; ///< Colour table data. Associates VT colour index with RGB value.
 	};
 
+	class VTObject;
+
+	/// @brief A container that holds all objects of a VT object pool, indexed by object ID
+	/// @details Objects are stored contiguously, and a dense index maps each object ID to its slot, so
+	/// looking up an object is a single array access that hands out a raw pointer without touching any
+	/// reference counts. The index is sized to the largest object ID in the pool, which is at most
+	/// 65535 entries of 4 bytes. The pool shares ownership of its objects with the caller that added them.
+	class VTObjectPool
+	{
+	public:
+		/// @brief Adds an object to the pool, replacing any object that has the same ID
+		/// @param[in] object The object to add
+		/// @returns true if the object was added, false if it was null
+		bool add_object(std::shared_ptr<VTObject> object);
+
+		/// @brief Removes an object from the pool
+		/// @details The last object in the pool takes the place of the removed one, so the order of objects may change
+		/// @param[in] objectID The ID of the object to remove
+		/// @returns true if an object with that ID was removed
+		bool remove_object(std::uint16_t objectID);
+
+		/// @brief Returns an object by its ID
+		/// @param[in] objectID The object ID to look up
+		/// @returns The object with that ID, or nullptr if the pool has no such object
+		VTObject *get_object_by_id(std::uint16_t objectID) const;
+
+		/// @brief Returns an object by its ID, sharing ownership of it with the caller
+		/// @param[in] objectID The object ID to look up
+		/// @returns The object with that ID, or nullptr if the pool has no such object
+		std::shared_ptr<VTObject> get_shared_object_by_id(std::uint16_t objectID) const;
+
+		/// @brief Returns if the pool has an object with the specified ID
+		/// @param[in] objectID The object ID to look up
+		/// @returns true if the pool has an object with that ID
+		bool contains(std::uint16_t objectID) const;
+
+		/// @brief Returns all objects in the pool, in no particular order
+		/// @returns The objects in the pool
+		const std::vector<std::shared_ptr<VTObject>> &get_objects() const;
+
+		/// @brief Returns the number of objects in the pool
+		/// @returns The number of objects in the pool
+		std::size_t size() const;
+
+		/// @brief Returns if the pool has no objects
+		/// @returns true if the pool has no objects
+		bool empty() const;
+
+		/// @brief Removes all objects from the pool
+		void clear();
+
+		/// @brief Returns an iterator to the first object in the pool
+		/// @returns An iterator to the first object in the pool
+		std::vector<std::shared_ptr<VTObject>>::const_iterator begin() const;
+
+		/// @brief Returns an iterator past the last object in the pool
+		/// @returns An iterator past the last object in the pool
+		std::vector<std::shared_ptr<VTObject>>::const_iterator end() const;
+
+	private:
+		static constexpr std::uint32_t NO_OBJECT = 0; ///< The index value for an object ID that is not in the pool
+
+		std::vector<std::shared_ptr<VTObject>> objects; ///< The objects in the pool, stored contiguously
+		std::vector<std::uint32_t> objectIndex; ///< Maps an object ID to its position in objects plus one, or NO_OBJECT
+	};
+
 	/// @brief Generic VT object base class
 	class VTObject
 	{
@@ -206,19 +271,19 @@ namespace isobus
 		virtual std::uint32_t get_minumum_object_length() const = 0;
 
 		/// @brief Performs basic error checking on the object and returns if the object is valid
-		/// @param[in] objectPool A map of all objects in the current object pool, keyed by their object ID
+		/// @param[in] objectPool All objects in the current object pool, indexed by their object ID
 		/// @returns `true` if the object passed basic error checks
-		virtual bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const = 0;
+		virtual bool get_is_valid(const VTObjectPool &objectPool) const = 0;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
 		/// @param[in] rawAttributeData The raw data to change the attribute to, as decoded in little endian format with unused
 		/// bytes/bits set to zero.
-		/// @param[in] objectPool A map of all objects in the current object pool, keyed by their object ID. Used to validate some object references.
+		/// @param[in] objectPool All objects in the current object pool, indexed by their object ID. Used to validate some object references.
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		virtual bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) = 0;
+		virtual bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) = 0;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -328,11 +393,11 @@ namespace isobus
 		/// @returns The macro metadata at the specified index, or NULL_OBJECT_ID + EventID::Reserved if the index is out of range
 		MacroMetadata get_macro(std::uint8_t index) const;
 
-		/// @brief Returns a VT object from its member pool by ID, or the null id if it does not exist
+		/// @brief Returns a VT object from its member pool by ID, or nullptr if it does not exist
 		/// @param[in] objectID The object ID to search for
 		/// @param[in] objectPool The object pool to search in
-		/// @returns The object with the corresponding ID
-		static std::shared_ptr<VTObject> get_object_by_id(std::uint16_t objectID, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool);
+		/// @returns The object with the corresponding ID, owned by the pool
+		static VTObject *get_object_by_id(std::uint16_t objectID, const VTObjectPool &objectPool);
 
 	protected:
 		/// @brief Storage for child object data
@@ -396,7 +461,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating this object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -406,7 +471,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -472,7 +537,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -482,7 +547,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -497,7 +562,7 @@ namespace isobus
 		/// @param[in] newMaskID The object ID of the new soft key mask to associate with this data mask
 		/// @param[in] objectPool The object pool to use when validating the objects affected by setting this attribute
 		/// @returns True if the mask was changed, false if the new ID was not valid and the mask was not changed
-		bool change_soft_key_mask(std::uint16_t newMaskID, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool);
+		bool change_soft_key_mask(std::uint16_t newMaskID, const VTObjectPool &objectPool);
 
 		/// @brief Changes the soft key mask associated to this data mask to a new object ID, but
 		/// does no checking on the validity of the new object ID.
@@ -565,7 +630,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -575,7 +640,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -610,7 +675,7 @@ namespace isobus
 		/// @param[in] newMaskID The object ID of the new soft key mask to associate with this data mask
 		/// @param[in] objectPool The object pool to use when validating the objects affected by setting this attribute
 		/// @returns True if the mask was changed, false if the new ID was not valid and the mask was not changed
-		bool change_soft_key_mask(std::uint16_t newMaskID, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool);
+		bool change_soft_key_mask(std::uint16_t newMaskID, const VTObjectPool &objectPool);
 
 		/// @brief Changes the soft key mask associated to this alarm mask to a new object ID, but
 		/// does no checking on the validity of the new object ID.
@@ -664,7 +729,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -674,7 +739,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -732,7 +797,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -742,7 +807,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -789,7 +854,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -799,7 +864,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -862,7 +927,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -872,7 +937,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -921,7 +986,7 @@ namespace isobus
 		/// @param[in] nameIDToValidate The name's object ID to validate
 		/// @param[in] objectPool The object pool to use when validating the name object
 		/// @returns True if the name ID is valid for this object, otherwise false
-		bool validate_name(std::uint16_t nameIDToValidate, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const;
+		bool validate_name(std::uint16_t nameIDToValidate, const VTObjectPool &objectPool) const;
 
 		static constexpr std::uint32_t MIN_OBJECT_LENGTH = 10; ///< The fewest bytes of IOP data that can represent this object
 
@@ -981,7 +1046,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -991,7 +1056,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1075,7 +1140,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1085,7 +1150,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1206,7 +1271,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1216,7 +1281,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1389,7 +1454,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1399,7 +1464,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1591,7 +1656,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1601,7 +1666,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1648,7 +1713,7 @@ namespace isobus
 		/// @param[in] newListItem The object ID to use as the new list item at the specified index
 		/// @param[in] objectPool The object pool to use to look up the object ID
 		/// @returns True if the operation was successful, otherwise false (perhaps the index is out of bounds?)
-		bool change_list_item(std::uint8_t index, std::uint16_t newListItem, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool);
+		bool change_list_item(std::uint8_t index, std::uint16_t newListItem, const VTObjectPool &objectPool);
 
 		/// @brief Returns the number of items in the list
 		/// @note This is not the number of children, it's the number of allocated
@@ -1734,7 +1799,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1744,7 +1809,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1884,7 +1949,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1894,7 +1959,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -2041,7 +2106,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -2051,7 +2116,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -2096,7 +2161,7 @@ namespace isobus
 		/// @param[in] newListItem The object ID to use as the new list item at the specified index
 		/// @param[in] objectPool The object pool to use to look up the object ID
 		/// @returns True if the operation was successful, otherwise false (perhaps the index is out of bounds?)
-		bool change_list_item(std::uint8_t index, std::uint16_t newListItem, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool);
+		bool change_list_item(std::uint8_t index, std::uint16_t newListItem, const VTObjectPool &objectPool);
 
 	private:
 		static constexpr std::uint32_t MIN_OBJECT_LENGTH = 12; ///< The fewest bytes of IOP data that can represent this object
@@ -2147,7 +2212,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -2157,7 +2222,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -2240,7 +2305,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -2250,7 +2315,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -2342,7 +2407,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -2352,7 +2417,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -2472,7 +2537,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -2482,7 +2547,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -2592,7 +2657,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -2602,7 +2667,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -2782,7 +2847,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -2792,7 +2857,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -2965,7 +3030,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -2975,7 +3040,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3167,7 +3232,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3177,7 +3242,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3297,7 +3362,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3307,7 +3372,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3361,7 +3426,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3371,7 +3436,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3478,7 +3543,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3488,7 +3553,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3590,7 +3655,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3600,7 +3665,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3666,7 +3731,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3676,7 +3741,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3748,7 +3813,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3758,7 +3823,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3831,7 +3896,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3841,7 +3906,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3914,7 +3979,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3924,7 +3989,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3982,7 +4047,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3992,7 +4057,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -4111,7 +4176,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -4121,7 +4186,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -4195,7 +4260,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -4205,7 +4270,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -4305,7 +4370,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -4315,7 +4380,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -4426,7 +4491,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -4436,7 +4501,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -4522,7 +4587,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -4532,7 +4597,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -4605,7 +4670,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -4615,7 +4680,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -4691,7 +4756,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -4701,7 +4766,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -4767,7 +4832,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectPool &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -4777,7 +4842,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
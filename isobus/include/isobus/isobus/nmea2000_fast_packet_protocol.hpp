@@ -28,6 +28,7 @@
 #define NMEA2000_FAST_PACKET_PROTOCOL_HPP
 
 #include "isobus/isobus/can_transport_protocol_base.hpp"
+#include "isobus/isobus/can_transport_protocol_buffer_pool.hpp"
 #include "isobus/utility/event_dispatcher.hpp"
 #include "isobus/utility/thread_synchronization.hpp"
 
@@ -113,7 +114,9 @@ namespace isobus
 		/// @brief The constructor for the FastPacketProtocol, for advanced use only.
 		/// In most cases, you should use the CANNetworkManager::get_fast_packet_protocol().send_message() function to transmit messages.
 		/// @param[in] sendCANFrameCallback A callback for sending a CAN frame to hardware
-		explicit FastPacketProtocol(const CANMessageFrameCallback &sendCANFrameCallback);
+		/// @param[in] bufferPool The pool to take receive buffers from, or nullptr to give this protocol its own pool
+		explicit FastPacketProtocol(const CANMessageFrameCallback &sendCANFrameCallback,
+		                            std::shared_ptr<TransportProtocolBufferPool> bufferPool = nullptr);
 
 		/// @brief Add a callback to be called when a message is received by the Fast Packet protocol
 		/// @param[in] parameterGroupNumber The PGN to parse as fast packet
@@ -161,6 +164,10 @@ namespace isobus
 		/// @param[in] allow Denotes if messages for non-internal control functions should be parsed by this protocol
 		void allow_any_control_function(bool allow);
 
+		/// @brief Returns the pool that receive sessions take their buffers from
+		/// @returns The buffer pool used by this protocol
+		std::shared_ptr<TransportProtocolBufferPool> get_buffer_pool() const;
+
 		/// @brief Updates all sessions managed by this protocol manager instance.
 		void update();
 
@@ -217,11 +224,13 @@ namespace isobus
 		static constexpr std::uint8_t PROTOCOL_BYTES_PER_FRAME = 7; ///< The number of payload bytes per frame for all but the first message, which has 6
 
 		std::vector<std::shared_ptr<FastPacketProtocolSession>> activeSessions; ///< A list of all active TP sessions
+		TransportProtocolSessionIndex sessionIndex{ true }; ///< Finds active sessions by PGN, source and destination
 		Mutex sessionMutex; ///< A mutex to lock the sessions list in case someone starts a Tx while the stack is processing sessions
 		std::vector<FastPacketHistory> sessionHistory; ///< Used to keep track of sequence numbers for future sessions
 		std::vector<ParameterGroupNumberCallbackData> parameterGroupNumberCallbacks; ///< A list of all parameter group number callbacks that will be parsed as fast packet messages
 		bool allowAnyControlFunction = false; ///< Denotes if messages for non-internal control functions should be parsed by this protocol
 		const CANMessageFrameCallback sendCANFrameCallback; ///< A callback for sending a CAN frame
+		const std::shared_ptr<TransportProtocolBufferPool> bufferPool; ///< Provides the buffers for received messages, and takes them back once delivered
 	};
 
 } // namespace isobus
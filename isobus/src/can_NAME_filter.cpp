@@ -29,70 +29,145 @@ namespace isobus
 
 	bool NAMEFilter::check_name_matches_filter(const NAME &nameToCompare) const
 	{
+		std::uint64_t mask = 0;
+		std::uint64_t maskedValue = 0;
 		bool retVal = false;
 
+		if (get_mask_and_value(mask, maskedValue))
+		{
+			retVal = ((nameToCompare.get_full_name() & mask) == maskedValue);
+		}
+		return retVal;
+	}
+
+	bool NAMEFilter::get_mask_and_value(std::uint64_t &mask, std::uint64_t &maskedValue) const
+	{
+		std::uint64_t fieldMask = 0;
+		std::uint8_t fieldOffset = 0;
+		std::uint64_t fieldValue = value;
+		bool retVal = true;
+
 		switch (parameter)
 		{
 			case NAME::NAMEParameters::IdentityNumber:
 			{
-				retVal = (nameToCompare.get_identity_number() == value);
+				fieldMask = 0x1FFFFF;
+				fieldOffset = 0;
 			}
 			break;
 
 			case NAME::NAMEParameters::ManufacturerCode:
 			{
-				retVal = (nameToCompare.get_manufacturer_code() == value);
+				fieldMask = 0x7FF;
+				fieldOffset = 21;
 			}
 			break;
 
 			case NAME::NAMEParameters::EcuInstance:
 			{
-				retVal = (nameToCompare.get_ecu_instance() == value);
+				fieldMask = 0x07;
+				fieldOffset = 32;
 			}
 			break;
 
 			case NAME::NAMEParameters::FunctionInstance:
 			{
-				retVal = (nameToCompare.get_function_instance() == value);
+				fieldMask = 0x1F;
+				fieldOffset = 35;
 			}
 			break;
 
 			case NAME::NAMEParameters::FunctionCode:
 			{
-				retVal = (nameToCompare.get_function_code() == value);
+				fieldMask = 0xFF;
+				fieldOffset = 40;
 			}
 			break;
 
 			case NAME::NAMEParameters::DeviceClass:
 			{
-				retVal = (nameToCompare.get_device_class() == value);
+				fieldMask = 0x7F;
+				fieldOffset = 49;
 			}
 			break;
 
 			case NAME::NAMEParameters::DeviceClassInstance:
 			{
-				retVal = (nameToCompare.get_device_class_instance() == value);
+				fieldMask = 0x0F;
+				fieldOffset = 56;
 			}
 			break;
 
 			case NAME::NAMEParameters::IndustryGroup:
 			{
-				retVal = (nameToCompare.get_industry_group() == value);
+				fieldMask = 0x07;
+				fieldOffset = 60;
 			}
 			break;
 
 			case NAME::NAMEParameters::ArbitraryAddressCapable:
 			{
-				retVal = (nameToCompare.get_arbitrary_address_capable() == (0 != value));
+				// Any non-zero value means the NAME must be arbitrary address capable
+				fieldMask = 0x01;
+				fieldOffset = 63;
+				fieldValue = (0 != value) ? 1 : 0;
 			}
 			break;
 
 			default:
 			{
+				retVal = false;
 			}
 			break;
 		}
+
+		if (fieldValue > fieldMask)
+		{
+			// A component can never have a value this large, so nothing matches
+			retVal = false;
+		}
+		mask = (fieldMask << fieldOffset);
+		maskedValue = ((fieldValue & fieldMask) << fieldOffset);
 		return retVal;
 	}
 
+	NAMEMatcher::NAMEMatcher(const std::vector<NAMEFilter> &filters) :
+	  canMatch(!filters.empty())
+	{
+		for (const auto &filter : filters)
+		{
+			std::uint64_t filterMask = 0;
+			std::uint64_t filterValue = 0;
+
+			if ((!filter.get_mask_and_value(filterMask, filterValue)) ||
+			    ((value & filterMask & mask) != (filterValue & mask)))
+			{
+				// Either the filter can't match anything, or it conflicts with an earlier one
+				canMatch = false;
+			}
+			mask |= filterMask;
+			value |= filterValue;
+		}
+	}
+
+	bool NAMEMatcher::matches(const NAME &nameToCompare) const
+	{
+		return canMatch && ((nameToCompare.get_full_name() & mask) == value);
+	}
+
+	std::uint64_t NAMEMatcher::get_mask() const
+	{
+		return mask;
+	}
+
+	std::uint64_t NAMEMatcher::get_value() const
+	{
+		return value;
+	}
+
+	bool NAMEMatcher::get_can_match() const
+	{
+		return canMatch;
+	}
+
 } // namespace isobus
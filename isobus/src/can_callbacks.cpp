@@ -8,10 +8,14 @@
 //================================================================================================
 #include "isobus/isobus/can_callbacks.hpp"
 
+#include <algorithm>
+#include <cassert>
+
 namespace isobus
 {
-	ParameterGroupNumberCallbackData::ParameterGroupNumberCallbackData(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parentPointer, std::shared_ptr<InternalControlFunction> internalControlFunction) :
+	ParameterGroupNumberCallbackData::ParameterGroupNumberCallbackData(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parentPointer, std::shared_ptr<InternalControlFunction> internalControlFunction, CANMessageViewCallback viewCallback) :
 	  callback(callback),
+	  viewCallback(viewCallback),
 	  parameterGroupNumber(parameterGroupNumber),
 	  parent(parentPointer),
 	  internalControlFunctionFilter(internalControlFunction)
@@ -21,6 +25,7 @@ namespace isobus
 	bool ParameterGroupNumberCallbackData::operator==(const ParameterGroupNumberCallbackData &obj) const
 	{
 		return ((obj.callback == this->callback) &&
+		        (obj.viewCallback == this->viewCallback) &&
 		        (obj.parameterGroupNumber == this->parameterGroupNumber) &&
 		        (obj.parent == this->parent) &&
 		        (obj.internalControlFunctionFilter == this->internalControlFunctionFilter));
@@ -36,6 +41,28 @@ namespace isobus
 		return callback;
 	}
 
+	CANMessageViewCallback ParameterGroupNumberCallbackData::get_view_callback() const
+	{
+		return viewCallback;
+	}
+
+	bool ParameterGroupNumberCallbackData::has_callback() const
+	{
+		return (nullptr != callback) || (nullptr != viewCallback);
+	}
+
+	void ParameterGroupNumberCallbackData::invoke(const CANMessage &message) const
+	{
+		if (nullptr != callback)
+		{
+			callback(message, parent);
+		}
+		else if (nullptr != viewCallback)
+		{
+			viewCallback(CANMessageView(message), parent);
+		}
+	}
+
 	void *ParameterGroupNumberCallbackData::get_parent() const
 	{
 		return parent;
@@ -45,4 +72,141 @@ namespace isobus
 	{
 		return internalControlFunctionFilter;
 	}
+
+	void ParameterGroupNumberCallbackTable::add_callback(const ParameterGroupNumberCallbackData &callbackData)
+	{
+		auto newCallbacks = std::make_shared<std::vector<ParameterGroupNumberCallbackData>>(*callbacks);
+
+		// Insert after any existing callbacks with the same PGN to preserve the order callbacks were added in
+		auto insertLocation = std::upper_bound(newCallbacks->begin(),
+		                                       newCallbacks->end(),
+		                                       callbackData.get_parameter_group_number(),
+		                                       [](std::uint32_t parameterGroupNumber, const ParameterGroupNumberCallbackData &callback) {
+			                                       return parameterGroupNumber < callback.get_parameter_group_number();
+		                                       });
+		newCallbacks->insert(insertLocation, callbackData);
+		callbacks = newCallbacks;
+		rebuild_index();
+	}
+
+	bool ParameterGroupNumberCallbackTable::remove_callback(const ParameterGroupNumberCallbackData &callbackData)
+	{
+		bool retVal = false;
+		auto callbackLocation = std::find(callbacks->begin(), callbacks->end(), callbackData);
+
+		if (callbacks->end() != callbackLocation)
+		{
+			auto newCallbacks = std::make_shared<std::vector<ParameterGroupNumberCallbackData>>(*callbacks);
+			newCallbacks->erase(newCallbacks->begin() + (callbackLocation - callbacks->begin()));
+			callbacks = newCallbacks;
+			rebuild_index();
+			retVal = true;
+		}
+		return retVal;
+	}
+
+	bool ParameterGroupNumberCallbackTable::contains(const ParameterGroupNumberCallbackData &callbackData) const
+	{
+		return callbacks->end() != std::find(callbacks->begin(), callbacks->end(), callbackData);
+	}
+
+	std::size_t ParameterGroupNumberCallbackTable::size() const
+	{
+		return callbacks->size();
+	}
+
+	const ParameterGroupNumberCallbackData &ParameterGroupNumberCallbackTable::get_callback(std::size_t index) const
+	{
+		assert(index < callbacks->size());
+		return (*callbacks)[index];
+	}
+
+	std::size_t ParameterGroupNumberCallbackTable::get_number_callbacks(std::uint32_t parameterGroupNumber) const
+	{
+		const IndexEntry *entry = find_entry(parameterGroupNumber);
+		return (nullptr != entry) ? entry->count : 0;
+	}
+
+	std::size_t ParameterGroupNumberCallbackTable::find_first_index(std::uint32_t parameterGroupNumber) const
+	{
+		const IndexEntry *entry = find_entry(parameterGroupNumber);
+		return (nullptr != entry) ? entry->firstIndex : callbacks->size();
+	}
+
+	const ParameterGroupNumberCallbackTable::IndexEntry *ParameterGroupNumberCallbackTable::find_entry(std::uint32_t parameterGroupNumber) const
+	{
+		const IndexEntry *retVal = nullptr;
+
+		if ((!index.empty()) && (EMPTY_ENTRY != parameterGroupNumber))
+		{
+			const std::size_t mask = index.size() - 1;
+
+			// The index is never more than half full, so this always finds an empty slot eventually
+			for (std::size_t slot = hash_slot(parameterGroupNumber); EMPTY_ENTRY != index[slot].parameterGroupNumber; slot = (slot + 1) & mask)
+			{
+				if (parameterGroupNumber == index[slot].parameterGroupNumber)
+				{
+					retVal = &index[slot];
+					break;
+				}
+			}
+		}
+		return retVal;
+	}
+
+	std::size_t ParameterGroupNumberCallbackTable::hash_slot(std::uint32_t parameterGroupNumber) const
+	{
+		// Fibonacci hashing, spreads the PGN bits over the whole 32 bit range before masking
+		return static_cast<std::size_t>((parameterGroupNumber * 2654435761u) >> 16) & (index.size() - 1);
+	}
+
+	void ParameterGroupNumberCallbackTable::rebuild_index()
+	{
+		const std::vector<ParameterGroupNumberCallbackData> &sortedCallbacks = *callbacks;
+		std::size_t numberOfParameterGroupNumbers = 0;
+
+		for (std::size_t i = 0; i < sortedCallbacks.size(); i++)
+		{
+			if ((0 == i) || (sortedCallbacks[i].get_parameter_group_number() != sortedCallbacks[i - 1].get_parameter_group_number()))
+			{
+				numberOfParameterGroupNumbers++;
+			}
+		}
+
+		std::size_t indexSize = MINIMUM_INDEX_SIZE;
+		while (indexSize < (2 * numberOfParameterGroupNumbers))
+		{
+			indexSize *= 2;
+		}
+
+		if (sortedCallbacks.empty())
+		{
+			index.clear();
+		}
+		else
+		{
+			index.assign(indexSize, IndexEntry{ EMPTY_ENTRY, 0, 0 });
+
+			const std::size_t mask = indexSize - 1;
+			std::size_t spanStart = 0;
+			while (spanStart < sortedCallbacks.size())
+			{
+				const std::uint32_t parameterGroupNumber = sortedCallbacks[spanStart].get_parameter_group_number();
+				std::size_t spanEnd = spanStart + 1;
+
+				while ((spanEnd < sortedCallbacks.size()) && (parameterGroupNumber == sortedCallbacks[spanEnd].get_parameter_group_number()))
+				{
+					spanEnd++;
+				}
+
+				std::size_t slot = hash_slot(parameterGroupNumber);
+				while (EMPTY_ENTRY != index[slot].parameterGroupNumber)
+				{
+					slot = (slot + 1) & mask;
+				}
+				index[slot] = { parameterGroupNumber, static_cast<std::uint32_t>(spanStart), static_cast<std::uint32_t>(spanEnd - spanStart) };
+				spanStart = spanEnd;
+			}
+		}
+	}
 } // namespace isobus
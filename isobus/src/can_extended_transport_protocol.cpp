@@ -121,10 +121,12 @@ namespace isobus
 
 	ExtendedTransportProtocolManager::ExtendedTransportProtocolManager(const CANMessageFrameCallback &sendCANFrameCallback,
 	                                                                   const CANMessageCallback &canMessageReceivedCallback,
-	                                                                   const CANNetworkConfiguration *configuration) :
+	                                                                   const CANNetworkConfiguration *configuration,
+	                                                                   std::shared_ptr<TransportProtocolBufferPool> bufferPool) :
 	  sendCANFrameCallback(sendCANFrameCallback),
 	  canMessageReceivedCallback(canMessageReceivedCallback),
-	  configuration(configuration)
+	  configuration(configuration),
+	  bufferPool((nullptr != bufferPool) ? bufferPool : std::make_shared<TransportProtocolBufferPool>())
 	{
 	}
 
@@ -160,7 +162,7 @@ namespace isobus
 			}
 
 			auto newSession = std::make_shared<ExtendedTransportProtocolSession>(ExtendedTransportProtocolSession::Direction::Receive,
-			                                                                     std::unique_ptr<CANMessageData>(new CANMessageDataVector(totalMessageSize)),
+			                                                                     std::unique_ptr<CANMessageData>(new CANMessageDataVector(bufferPool->acquire(totalMessageSize))),
 			                                                                     parameterGroupNumber,
 			                                                                     totalMessageSize,
 			                                                                     source,
@@ -173,6 +175,7 @@ namespace isobus
 
 			newSession->set_state(StateMachineState::SendClearToSend);
 			activeSessions.push_back(newSession);
+			sessionIndex.add(newSession);
 			LOG_DEBUG("[ETP]: New rx session for 0x%05X. Source: %hu, destination: %hu", parameterGroupNumber, source->get_address(), destination->get_address());
 			update_state_machine(newSession);
 		}
@@ -471,6 +474,7 @@ namespace isobus
 					                            0);
 
 					canMessageReceivedCallback(completedMessage);
+					bufferPool->release(completedMessage.release_data());
 					close_session(session, true);
 					LOG_DEBUG("[ETP]: Completed rx session for 0x%05X from %hu", session->get_parameter_group_number(), source->get_address());
 				}
@@ -554,6 +558,7 @@ namespace isobus
 		          destination->get_address());
 
 		activeSessions.push_back(session);
+		sessionIndex.add(session);
 		update_state_machine(session);
 		return true;
 	}
@@ -774,9 +779,17 @@ namespace isobus
 	void ExtendedTransportProtocolManager::close_session(std::shared_ptr<ExtendedTransportProtocolSession> &session, bool successful)
 	{
 		session->complete(successful);
+
+		if (ExtendedTransportProtocolSession::Direction::Receive == session->get_direction())
+		{
+			// Give the buffer back to the pool, it will be empty if it was already handed over to a completed message
+			bufferPool->release(std::move(static_cast<CANMessageDataVector &>(session->get_data())));
+		}
+
 		auto sessionLocation = std::find(activeSessions.begin(), activeSessions.end(), session);
 		if (activeSessions.end() != sessionLocation)
 		{
+			sessionIndex.remove(session);
 			activeSessions.erase(sessionLocation);
 			LOG_DEBUG("[ETP]: Session Closed");
 		}
@@ -902,22 +915,22 @@ namespace isobus
 
 	bool ExtendedTransportProtocolManager::has_session(std::shared_ptr<ControlFunction> source, std::shared_ptr<ControlFunction> destination)
 	{
-		return std::any_of(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<ExtendedTransportProtocolSession> &session) {
-			return session->matches(source, destination);
-		});
+		return nullptr != sessionIndex.find(source.get(), destination.get());
 	}
 
 	std::shared_ptr<ExtendedTransportProtocolManager::ExtendedTransportProtocolSession> ExtendedTransportProtocolManager::get_session(std::shared_ptr<ControlFunction> source,
 	                                                                                                                                  std::shared_ptr<ControlFunction> destination)
 	{
-		auto result = std::find_if(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<ExtendedTransportProtocolSession> &session) {
-			return session->matches(source, destination);
-		});
-		return (activeSessions.end() != result) ? (*result) : nullptr;
+		return std::static_pointer_cast<ExtendedTransportProtocolSession>(sessionIndex.find(source.get(), destination.get()));
 	}
 
 	const std::vector<std::shared_ptr<ExtendedTransportProtocolManager::ExtendedTransportProtocolSession>> &ExtendedTransportProtocolManager::get_sessions() const
 	{
 		return activeSessions;
 	}
+
+	std::shared_ptr<TransportProtocolBufferPool> ExtendedTransportProtocolManager::get_buffer_pool() const
+	{
+		return bufferPool;
+	}
 }
@@ -8,7 +8,7 @@
 /// @copyright 2022 The Open-Agriculture Developers
 //================================================================================================
 #include "isobus/isobus/can_message.hpp"
-#include "isobus/isobus/can_stack_logger.hpp"
+#include "isobus/isobus/can_message_view.hpp"
 
 #include <cassert>
 
@@ -23,7 +23,7 @@ namespace isobus
 	                       std::uint8_t CANPort) :
 	  messageType(type),
 	  identifier(identifier),
-	  data(dataBuffer, dataBuffer + length),
+	  data(dataBuffer, length),
 	  source(source),
 	  destination(destination),
 	  CANPortIndex(CANPort)
@@ -55,7 +55,7 @@ namespace isobus
 		return messageType;
 	}
 
-	const std::vector<std::uint8_t> &CANMessage::get_data() const
+	const CANMessagePayload &CANMessage::get_data() const
 	{
 		return data;
 	}
@@ -125,7 +125,7 @@ namespace isobus
 		assert(length <= ABSOLUTE_MAX_MESSAGE_LENGTH && "CANMessage::set_data() called with length greater than maximum supported");
 		assert(nullptr != dataBuffer && "CANMessage::set_data() called with nullptr dataBuffer");
 
-		data.insert(data.end(), dataBuffer, dataBuffer + length);
+		data.append(dataBuffer, length);
 	}
 
 	void CANMessage::set_data(std::uint8_t dataByte, const std::uint32_t insertPosition)
@@ -140,6 +140,11 @@ namespace isobus
 		data.resize(length);
 	}
 
+	std::vector<std::uint8_t> CANMessage::release_data()
+	{
+		return data.release();
+	}
+
 	void CANMessage::set_identifier(const CANIdentifier &value)
 	{
 		identifier = value;
@@ -147,233 +152,62 @@ namespace isobus
 
 	std::uint8_t CANMessage::get_uint8_at(const std::uint32_t index) const
 	{
-		return data.at(index);
+		return CANMessageView(*this).get_uint8_at(index);
 	}
 
 	std::int8_t CANMessage::get_int8_at(const std::uint32_t index) const
 	{
-		return static_cast<std::int8_t>(data.at(index));
+		return CANMessageView(*this).get_int8_at(index);
 	}
 
 	std::uint16_t CANMessage::get_uint16_at(const std::uint32_t index, const ByteFormat format) const
 	{
-		std::uint16_t retVal;
-		if (ByteFormat::LittleEndian == format)
-		{
-			retVal = data.at(index);
-			retVal |= static_cast<std::uint16_t>(data.at(index + 1)) << 8;
-		}
-		else
-		{
-			retVal = static_cast<std::uint16_t>(data.at(index)) << 8;
-			retVal |= data.at(index + 1);
-		}
-		return retVal;
+		return CANMessageView(*this).get_uint16_at(index, format);
 	}
 
 	std::int16_t CANMessage::get_int16_at(const std::uint32_t index, const ByteFormat format) const
 	{
-		std::int16_t retVal;
-		if (ByteFormat::LittleEndian == format)
-		{
-			retVal = static_cast<std::int16_t>(data.at(index));
-			retVal |= static_cast<std::int16_t>(data.at(index + 1)) << 8;
-		}
-		else
-		{
-			retVal = static_cast<std::int16_t>(data.at(index)) << 8;
-			retVal |= static_cast<std::int16_t>(data.at(index + 1));
-		}
-		return retVal;
+		return CANMessageView(*this).get_int16_at(index, format);
 	}
 
 	std::uint32_t CANMessage::get_uint24_at(const std::uint32_t index, const ByteFormat format) const
 	{
-		std::uint32_t retVal;
-		if (ByteFormat::LittleEndian == format)
-		{
-			retVal = data.at(index);
-			retVal |= static_cast<std::uint32_t>(data.at(index + 1)) << 8;
-			retVal |= static_cast<std::uint32_t>(data.at(index + 2)) << 16;
-		}
-		else
-		{
-			retVal = static_cast<std::uint32_t>(data.at(index + 2)) << 16;
-			retVal |= static_cast<std::uint32_t>(data.at(index + 1)) << 8;
-			retVal |= data.at(index + 2);
-		}
-		return retVal;
+		return CANMessageView(*this).get_uint24_at(index, format);
 	}
 
 	std::int32_t CANMessage::get_int24_at(const std::uint32_t index, const ByteFormat format) const
 	{
-		std::int32_t retVal;
-		if (ByteFormat::LittleEndian == format)
-		{
-			retVal = static_cast<std::int32_t>(data.at(index));
-			retVal |= static_cast<std::int32_t>(data.at(index + 1)) << 8;
-			retVal |= static_cast<std::int32_t>(data.at(index + 2)) << 16;
-		}
-		else
-		{
-			retVal = static_cast<std::int32_t>(data.at(index + 2)) << 16;
-			retVal |= static_cast<std::int32_t>(data.at(index + 1)) << 8;
-			retVal |= static_cast<std::int32_t>(data.at(index + 2));
-		}
-		return retVal;
+		return CANMessageView(*this).get_int24_at(index, format);
 	}
 
 	std::uint32_t CANMessage::get_uint32_at(const std::uint32_t index, const ByteFormat format) const
 	{
-		std::uint32_t retVal;
-		if (ByteFormat::LittleEndian == format)
-		{
-			retVal = data.at(index);
-			retVal |= static_cast<std::uint32_t>(data.at(index + 1)) << 8;
-			retVal |= static_cast<std::uint32_t>(data.at(index + 2)) << 16;
-			retVal |= static_cast<std::uint32_t>(data.at(index + 3)) << 24;
-		}
-		else
-		{
-			retVal = static_cast<std::uint32_t>(data.at(index)) << 24;
-			retVal |= static_cast<std::uint32_t>(data.at(index + 1)) << 16;
-			retVal |= static_cast<std::uint32_t>(data.at(index + 2)) << 8;
-			retVal |= data.at(index + 3);
-		}
-		return retVal;
+		return CANMessageView(*this).get_uint32_at(index, format);
 	}
 
 	std::int32_t CANMessage::get_int32_at(const std::uint32_t index, const ByteFormat format) const
 	{
-		std::int32_t retVal;
-		if (ByteFormat::LittleEndian == format)
-		{
-			retVal = static_cast<std::int32_t>(data.at(index));
-			retVal |= static_cast<std::int32_t>(data.at(index + 1)) << 8;
-			retVal |= static_cast<std::int32_t>(data.at(index + 2)) << 16;
-			retVal |= static_cast<std::int32_t>(data.at(index + 3)) << 24;
-		}
-		else
-		{
-			retVal = static_cast<std::int32_t>(data.at(index)) << 24;
-			retVal |= static_cast<std::int32_t>(data.at(index + 1)) << 16;
-			retVal |= static_cast<std::int32_t>(data.at(index + 2)) << 8;
-			retVal |= static_cast<std::int32_t>(data.at(index + 3));
-		}
-		return retVal;
+		return CANMessageView(*this).get_int32_at(index, format);
 	}
 
 	std::uint64_t CANMessage::get_uint64_at(const std::uint32_t index, const ByteFormat format) const
 	{
-		std::uint64_t retVal;
-		if (ByteFormat::LittleEndian == format)
-		{
-			retVal = data.at(index);
-			retVal |= static_cast<std::uint64_t>(data.at(index + 1)) << 8;
-			retVal |= static_cast<std::uint64_t>(data.at(index + 2)) << 16;
-			retVal |= static_cast<std::uint64_t>(data.at(index + 3)) << 24;
-			retVal |= static_cast<std::uint64_t>(data.at(index + 4)) << 32;
-			retVal |= static_cast<std::uint64_t>(data.at(index + 5)) << 40;
-			retVal |= static_cast<std::uint64_t>(data.at(index + 6)) << 48;
-			retVal |= static_cast<std::uint64_t>(data.at(index + 7)) << 56;
-		}
-		else
-		{
-			retVal = static_cast<std::uint64_t>(data.at(index)) << 56;
-			retVal |= static_cast<std::uint64_t>(data.at(index + 1)) << 48;
-			retVal |= static_cast<std::uint64_t>(data.at(index + 2)) << 40;
-			retVal |= static_cast<std::uint64_t>(data.at(index + 3)) << 32;
-			retVal |= static_cast<std::uint64_t>(data.at(index + 4)) << 24;
-			retVal |= static_cast<std::uint64_t>(data.at(index + 5)) << 16;
-			retVal |= static_cast<std::uint64_t>(data.at(index + 6)) << 8;
-			retVal |= data.at(index + 7);
-		}
-		return retVal;
+		return CANMessageView(*this).get_uint64_at(index, format);
 	}
 
 	std::int64_t CANMessage::get_int64_at(const std::uint32_t index, const ByteFormat format) const
 	{
-		std::int64_t retVal;
-		if (ByteFormat::LittleEndian == format)
-		{
-			retVal = static_cast<std::int64_t>(data.at(index));
-			retVal |= static_cast<std::int64_t>(data.at(index + 1)) << 8;
-			retVal |= static_cast<std::int64_t>(data.at(index + 2)) << 16;
-			retVal |= static_cast<std::int64_t>(data.at(index + 3)) << 24;
-			retVal |= static_cast<std::int64_t>(data.at(index + 4)) << 32;
-			retVal |= static_cast<std::int64_t>(data.at(index + 5)) << 40;
-			retVal |= static_cast<std::int64_t>(data.at(index + 6)) << 48;
-			retVal |= static_cast<std::int64_t>(data.at(index + 7)) << 56;
-		}
-		else
-		{
-			retVal = static_cast<std::int64_t>(data.at(index)) << 56;
-			retVal |= static_cast<std::int64_t>(data.at(index + 1)) << 48;
-			retVal |= static_cast<std::int64_t>(data.at(index + 2)) << 40;
-			retVal |= static_cast<std::int64_t>(data.at(index + 3)) << 32;
-			retVal |= static_cast<std::int64_t>(data.at(index + 4)) << 24;
-			retVal |= static_cast<std::int64_t>(data.at(index + 5)) << 16;
-			retVal |= static_cast<std::int64_t>(data.at(index + 6)) << 8;
-			retVal |= static_cast<std::int64_t>(data.at(index + 7));
-		}
-		return retVal;
-	}
-
-	bool isobus::CANMessage::get_bool_at(const std::uint32_t byteIndex, const std::uint8_t bitIndex, const std::uint8_t length) const
-	{
-		assert(length <= 8 - bitIndex && "length must be less than or equal to 8 - bitIndex");
-		std::uint8_t mask = ((1 << length) - 1) << bitIndex;
-		return (get_uint8_at(byteIndex) & mask) == mask;
-	}
-
-	std::uint64_t CANMessage::get_data_custom_length(const std::uint32_t startBitIndex, const std::uint32_t length, const isobus::CANMessage::ByteFormat format) const
-	{
-		std::uint64_t retVal = 0;
-		std::uint8_t currentByte = 0;
-		std::uint32_t endBitIndex = startBitIndex + length - 1;
-		std::uint32_t bitCounter = 0;
-		std::uint32_t amountOfBytesLeft = (length + 8 - 1) / 8;
-		std::uint32_t startAmountOfBytes = amountOfBytesLeft;
-		std::uint8_t indexOfFinalByteBit = 7;
-
-		if (endBitIndex > 8 * data.size() || length < 1 || startBitIndex >= 8 * data.size())
-		{
-			LOG_ERROR("End bit index is greater than length or startBitIndex is wrong or startBitIndex is greater than endBitIndex");
-			return retVal;
-		}
-
-		for (auto i = startBitIndex; i <= endBitIndex; i++)
-		{
-			auto byteIndex = i / 8;
-			auto bitIndexWithinByte = i % 8;
-			auto bit = (data.at(byteIndex) >> (indexOfFinalByteBit - bitIndexWithinByte)) & 1;
-			if (length - bitCounter < 8)
-			{
-				currentByte |= static_cast<uint8_t>(bit) << (length - 1 - bitCounter);
-			}
-			else
-			{
-				currentByte |= static_cast<uint8_t>(bit) << (indexOfFinalByteBit - bitIndexWithinByte);
-			}
-
-			if ((bitCounter + 1) % 8 == 0 || i == endBitIndex)
-			{
-				if (ByteFormat::LittleEndian == format)
-				{
-					retVal |= (static_cast<uint64_t>(currentByte) << (startAmountOfBytes - amountOfBytesLeft) * 8);
-				}
-				else
-				{
-					retVal |= (static_cast<uint64_t>(currentByte) << ((amountOfBytesLeft * 8) - 8));
-				}
-				currentByte = 0;
-				amountOfBytesLeft--;
-			}
-
-			bitCounter++;
-		}
-
-		return retVal;
+		return CANMessageView(*this).get_int64_at(index, format);
+	}
+
+	bool CANMessage::get_bool_at(const std::uint32_t byteIndex, const std::uint8_t bitIndex, const std::uint8_t length) const
+	{
+		return CANMessageView(*this).get_bool_at(byteIndex, bitIndex, length);
+	}
+
+	std::uint64_t CANMessage::get_data_custom_length(const std::uint32_t startBitIndex, const std::uint32_t length, const ByteFormat format) const
+	{
+		return CANMessageView(*this).get_data_custom_length(startBitIndex, length, format);
 	}
 
 } // namespace isobus
@@ -23,6 +23,11 @@ namespace isobus
 		vector::assign(data.begin(), data.end());
 	}
 
+	CANMessageDataVector::CANMessageDataVector(std::vector<std::uint8_t> &&data) :
+	  vector(std::move(data))
+	{
+	}
+
 	CANMessageDataVector::CANMessageDataVector(const std::uint8_t *data, std::size_t size)
 	{
 		vector::assign(data, data + size);
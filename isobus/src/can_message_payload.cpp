@@ -0,0 +1,219 @@
+//================================================================================================
+/// @file can_message_payload.cpp
+///
+/// @brief A byte container for CAN message payloads, which stores single frame payloads
+/// inline and only uses the heap for larger (multi-frame) payloads.
+/// @author Adrian Del Grosso
+/// @author Daan Steenbergen
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/isobus/can_message_payload.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace isobus
+{
+	CANMessagePayload::CANMessagePayload(const std::uint8_t *dataBuffer, std::size_t length)
+	{
+		append(dataBuffer, length);
+	}
+
+	CANMessagePayload::CANMessagePayload(std::vector<std::uint8_t> data)
+	{
+		if (data.size() <= INLINE_CAPACITY)
+		{
+			append(data.data(), data.size());
+		}
+		else
+		{
+			length = static_cast<std::uint32_t>(data.size());
+			heapData = std::move(data);
+			usesHeap = true;
+		}
+	}
+
+	CANMessagePayload::CANMessagePayload(std::initializer_list<std::uint8_t> data)
+	{
+		append(data.begin(), data.size());
+	}
+
+	CANMessagePayload::CANMessagePayload(const CANMessagePayload &other)
+	{
+		append(other.data(), other.size());
+	}
+
+	CANMessagePayload::CANMessagePayload(CANMessagePayload &&other) noexcept :
+	  inlineData(other.inlineData),
+	  heapData(std::move(other.heapData)),
+	  length(other.length),
+	  usesHeap(other.usesHeap)
+	{
+		other.heapData.clear();
+		other.length = 0;
+		other.usesHeap = false;
+	}
+
+	CANMessagePayload &CANMessagePayload::operator=(const CANMessagePayload &other)
+	{
+		if (this != &other)
+		{
+			clear();
+			append(other.data(), other.size());
+		}
+		return *this;
+	}
+
+	CANMessagePayload &CANMessagePayload::operator=(CANMessagePayload &&other) noexcept
+	{
+		if (this != &other)
+		{
+			inlineData = other.inlineData;
+			heapData = std::move(other.heapData);
+			length = other.length;
+			usesHeap = other.usesHeap;
+			other.heapData.clear();
+			other.length = 0;
+			other.usesHeap = false;
+		}
+		return *this;
+	}
+
+	std::size_t CANMessagePayload::size() const
+	{
+		return length;
+	}
+
+	bool CANMessagePayload::empty() const
+	{
+		return 0 == length;
+	}
+
+	bool CANMessagePayload::is_inline() const
+	{
+		return !usesHeap;
+	}
+
+	std::uint8_t *CANMessagePayload::data()
+	{
+		return usesHeap ? heapData.data() : inlineData.data();
+	}
+
+	const std::uint8_t *CANMessagePayload::data() const
+	{
+		return usesHeap ? heapData.data() : inlineData.data();
+	}
+
+	CANMessagePayload::iterator CANMessagePayload::begin()
+	{
+		return data();
+	}
+
+	CANMessagePayload::iterator CANMessagePayload::end()
+	{
+		return data() + length;
+	}
+
+	CANMessagePayload::const_iterator CANMessagePayload::begin() const
+	{
+		return data();
+	}
+
+	CANMessagePayload::const_iterator CANMessagePayload::end() const
+	{
+		return data() + length;
+	}
+
+	std::uint8_t &CANMessagePayload::operator[](std::size_t index)
+	{
+		return data()[index];
+	}
+
+	const std::uint8_t &CANMessagePayload::operator[](std::size_t index) const
+	{
+		return data()[index];
+	}
+
+	const std::uint8_t &CANMessagePayload::at(std::size_t index) const
+	{
+		if (index >= length)
+		{
+			throw std::out_of_range("CANMessagePayload::at() index out of range");
+		}
+		return data()[index];
+	}
+
+	void CANMessagePayload::resize(std::size_t newLength)
+	{
+		if (usesHeap)
+		{
+			heapData.resize(newLength);
+		}
+		else if (newLength <= INLINE_CAPACITY)
+		{
+			if (newLength > length)
+			{
+				std::fill(inlineData.begin() + length, inlineData.begin() + newLength, 0);
+			}
+		}
+		else
+		{
+			// Spill over to the heap, once there we stay there to avoid thrashing between the two
+			heapData.reserve(newLength);
+			heapData.assign(inlineData.begin(), inlineData.begin() + length);
+			heapData.resize(newLength);
+			usesHeap = true;
+		}
+		length = static_cast<std::uint32_t>(newLength);
+	}
+
+	void CANMessagePayload::append(const std::uint8_t *dataBuffer, std::size_t appendLength)
+	{
+		if ((nullptr != dataBuffer) && (0 != appendLength))
+		{
+			std::size_t oldLength = length;
+			resize(oldLength + appendLength);
+			memcpy(data() + oldLength, dataBuffer, appendLength);
+		}
+	}
+
+	void CANMessagePayload::clear()
+	{
+		heapData.clear();
+		length = 0;
+		usesHeap = false;
+	}
+
+	std::vector<std::uint8_t> CANMessagePayload::release()
+	{
+		std::vector<std::uint8_t> retVal;
+
+		if (usesHeap)
+		{
+			retVal = std::move(heapData);
+		}
+		else
+		{
+			retVal.assign(begin(), end());
+		}
+		clear();
+		return retVal;
+	}
+
+	CANMessagePayload::operator std::vector<std::uint8_t>() const
+	{
+		return std::vector<std::uint8_t>(begin(), end());
+	}
+
+	bool operator==(const CANMessagePayload &lhs, const CANMessagePayload &rhs)
+	{
+		return (lhs.size() == rhs.size()) && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+	}
+
+	bool operator!=(const CANMessagePayload &lhs, const CANMessagePayload &rhs)
+	{
+		return !(lhs == rhs);
+	}
+} // namespace isobus
@@ -0,0 +1,322 @@
+//================================================================================================
+/// @file can_message_view.cpp
+///
+/// @brief A non-owning, read-only view of a CAN message, which can be created from a
+/// CANMessage or directly from a received CAN frame without copying its data.
+/// @author Adrian Del Grosso
+/// @author Daan Steenbergen
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/isobus/can_message_view.hpp"
+#include "isobus/isobus/can_stack_logger.hpp"
+
+#include <cassert>
+#include <stdexcept>
+
+namespace isobus
+{
+	CANMessageView::CANMessageView(const CANMessage &message) :
+	  identifier(message.identifier),
+	  data(message.data.data(), message.data.size()),
+	  source(message.source.get()),
+	  destination(message.destination.get()),
+	  CANPortIndex(message.CANPortIndex)
+	{
+	}
+
+	CANMessageView::CANMessageView(const CANMessageFrame &frame, ControlFunction *source, ControlFunction *destination) :
+	  identifier(frame.identifier),
+	  data(frame.data, frame.dataLength),
+	  source(source),
+	  destination(destination),
+	  CANPortIndex(frame.channel)
+	{
+	}
+
+	CANIdentifier CANMessageView::get_identifier() const
+	{
+		return identifier;
+	}
+
+	bool CANMessageView::is_parameter_group_number(CANLibParameterGroupNumber parameterGroupNumber) const
+	{
+		return identifier.get_parameter_group_number() == static_cast<std::uint32_t>(parameterGroupNumber);
+	}
+
+	CANDataSpan CANMessageView::get_data() const
+	{
+		return data;
+	}
+
+	std::uint32_t CANMessageView::get_data_length() const
+	{
+		return static_cast<std::uint32_t>(data.size());
+	}
+
+	std::uint8_t CANMessageView::get_can_port_index() const
+	{
+		return CANPortIndex;
+	}
+
+	ControlFunction *CANMessageView::get_source_control_function() const
+	{
+		return source;
+	}
+
+	ControlFunction *CANMessageView::get_destination_control_function() const
+	{
+		return destination;
+	}
+
+	bool CANMessageView::is_source(const std::shared_ptr<ControlFunction> &controlFunction) const
+	{
+		return (nullptr != source) && source->get_address_valid() && (source == controlFunction.get());
+	}
+
+	bool CANMessageView::is_destination(const std::shared_ptr<ControlFunction> &controlFunction) const
+	{
+		return (nullptr != destination) && destination->get_address_valid() && (destination == controlFunction.get());
+	}
+
+	std::uint8_t CANMessageView::get_uint8_at(const std::uint32_t index) const
+	{
+		return byte_at(index);
+	}
+
+	std::int8_t CANMessageView::get_int8_at(const std::uint32_t index) const
+	{
+		return static_cast<std::int8_t>(byte_at(index));
+	}
+
+	std::uint16_t CANMessageView::get_uint16_at(const std::uint32_t index, const CANMessage::ByteFormat format) const
+	{
+		std::uint16_t retVal;
+		if (CANMessage::ByteFormat::LittleEndian == format)
+		{
+			retVal = byte_at(index);
+			retVal |= static_cast<std::uint16_t>(byte_at(index + 1)) << 8;
+		}
+		else
+		{
+			retVal = static_cast<std::uint16_t>(byte_at(index)) << 8;
+			retVal |= byte_at(index + 1);
+		}
+		return retVal;
+	}
+
+	std::int16_t CANMessageView::get_int16_at(const std::uint32_t index, const CANMessage::ByteFormat format) const
+	{
+		std::int16_t retVal;
+		if (CANMessage::ByteFormat::LittleEndian == format)
+		{
+			retVal = static_cast<std::int16_t>(byte_at(index));
+			retVal |= static_cast<std::int16_t>(byte_at(index + 1)) << 8;
+		}
+		else
+		{
+			retVal = static_cast<std::int16_t>(byte_at(index)) << 8;
+			retVal |= static_cast<std::int16_t>(byte_at(index + 1));
+		}
+		return retVal;
+	}
+
+	std::uint32_t CANMessageView::get_uint24_at(const std::uint32_t index, const CANMessage::ByteFormat format) const
+	{
+		std::uint32_t retVal;
+		if (CANMessage::ByteFormat::LittleEndian == format)
+		{
+			retVal = byte_at(index);
+			retVal |= static_cast<std::uint32_t>(byte_at(index + 1)) << 8;
+			retVal |= static_cast<std::uint32_t>(byte_at(index + 2)) << 16;
+		}
+		else
+		{
+			retVal = static_cast<std::uint32_t>(byte_at(index + 2)) << 16;
+			retVal |= static_cast<std::uint32_t>(byte_at(index + 1)) << 8;
+			retVal |= byte_at(index + 2);
+		}
+		return retVal;
+	}
+
+	std::int32_t CANMessageView::get_int24_at(const std::uint32_t index, const CANMessage::ByteFormat format) const
+	{
+		std::int32_t retVal;
+		if (CANMessage::ByteFormat::LittleEndian == format)
+		{
+			retVal = static_cast<std::int32_t>(byte_at(index));
+			retVal |= static_cast<std::int32_t>(byte_at(index + 1)) << 8;
+			retVal |= static_cast<std::int32_t>(byte_at(index + 2)) << 16;
+		}
+		else
+		{
+			retVal = static_cast<std::int32_t>(byte_at(index + 2)) << 16;
+			retVal |= static_cast<std::int32_t>(byte_at(index + 1)) << 8;
+			retVal |= static_cast<std::int32_t>(byte_at(index + 2));
+		}
+		return retVal;
+	}
+
+	std::uint32_t CANMessageView::get_uint32_at(const std::uint32_t index, const CANMessage::ByteFormat format) const
+	{
+		std::uint32_t retVal;
+		if (CANMessage::ByteFormat::LittleEndian == format)
+		{
+			retVal = byte_at(index);
+			retVal |= static_cast<std::uint32_t>(byte_at(index + 1)) << 8;
+			retVal |= static_cast<std::uint32_t>(byte_at(index + 2)) << 16;
+			retVal |= static_cast<std::uint32_t>(byte_at(index + 3)) << 24;
+		}
+		else
+		{
+			retVal = static_cast<std::uint32_t>(byte_at(index)) << 24;
+			retVal |= static_cast<std::uint32_t>(byte_at(index + 1)) << 16;
+			retVal |= static_cast<std::uint32_t>(byte_at(index + 2)) << 8;
+			retVal |= byte_at(index + 3);
+		}
+		return retVal;
+	}
+
+	std::int32_t CANMessageView::get_int32_at(const std::uint32_t index, const CANMessage::ByteFormat format) const
+	{
+		std::int32_t retVal;
+		if (CANMessage::ByteFormat::LittleEndian == format)
+		{
+			retVal = static_cast<std::int32_t>(byte_at(index));
+			retVal |= static_cast<std::int32_t>(byte_at(index + 1)) << 8;
+			retVal |= static_cast<std::int32_t>(byte_at(index + 2)) << 16;
+			retVal |= static_cast<std::int32_t>(byte_at(index + 3)) << 24;
+		}
+		else
+		{
+			retVal = static_cast<std::int32_t>(byte_at(index)) << 24;
+			retVal |= static_cast<std::int32_t>(byte_at(index + 1)) << 16;
+			retVal |= static_cast<std::int32_t>(byte_at(index + 2)) << 8;
+			retVal |= static_cast<std::int32_t>(byte_at(index + 3));
+		}
+		return retVal;
+	}
+
+	std::uint64_t CANMessageView::get_uint64_at(const std::uint32_t index, const CANMessage::ByteFormat format) const
+	{
+		std::uint64_t retVal;
+		if (CANMessage::ByteFormat::LittleEndian == format)
+		{
+			retVal = byte_at(index);
+			retVal |= static_cast<std::uint64_t>(byte_at(index + 1)) << 8;
+			retVal |= static_cast<std::uint64_t>(byte_at(index + 2)) << 16;
+			retVal |= static_cast<std::uint64_t>(byte_at(index + 3)) << 24;
+			retVal |= static_cast<std::uint64_t>(byte_at(index + 4)) << 32;
+			retVal |= static_cast<std::uint64_t>(byte_at(index + 5)) << 40;
+			retVal |= static_cast<std::uint64_t>(byte_at(index + 6)) << 48;
+			retVal |= static_cast<std::uint64_t>(byte_at(index + 7)) << 56;
+		}
+		else
+		{
+			retVal = static_cast<std::uint64_t>(byte_at(index)) << 56;
+			retVal |= static_cast<std::uint64_t>(byte_at(index + 1)) << 48;
+			retVal |= static_cast<std::uint64_t>(byte_at(index + 2)) << 40;
+			retVal |= static_cast<std::uint64_t>(byte_at(index + 3)) << 32;
+			retVal |= static_cast<std::uint64_t>(byte_at(index + 4)) << 24;
+			retVal |= static_cast<std::uint64_t>(byte_at(index + 5)) << 16;
+			retVal |= static_cast<std::uint64_t>(byte_at(index + 6)) << 8;
+			retVal |= byte_at(index + 7);
+		}
+		return retVal;
+	}
+
+	std::int64_t CANMessageView::get_int64_at(const std::uint32_t index, const CANMessage::ByteFormat format) const
+	{
+		std::int64_t retVal;
+		if (CANMessage::ByteFormat::LittleEndian == format)
+		{
+			retVal = static_cast<std::int64_t>(byte_at(index));
+			retVal |= static_cast<std::int64_t>(byte_at(index + 1)) << 8;
+			retVal |= static_cast<std::int64_t>(byte_at(index + 2)) << 16;
+			retVal |= static_cast<std::int64_t>(byte_at(index + 3)) << 24;
+			retVal |= static_cast<std::int64_t>(byte_at(index + 4)) << 32;
+			retVal |= static_cast<std::int64_t>(byte_at(index + 5)) << 40;
+			retVal |= static_cast<std::int64_t>(byte_at(index + 6)) << 48;
+			retVal |= static_cast<std::int64_t>(byte_at(index + 7)) << 56;
+		}
+		else
+		{
+			retVal = static_cast<std::int64_t>(byte_at(index)) << 56;
+			retVal |= static_cast<std::int64_t>(byte_at(index + 1)) << 48;
+			retVal |= static_cast<std::int64_t>(byte_at(index + 2)) << 40;
+			retVal |= static_cast<std::int64_t>(byte_at(index + 3)) << 32;
+			retVal |= static_cast<std::int64_t>(byte_at(index + 4)) << 24;
+			retVal |= static_cast<std::int64_t>(byte_at(index + 5)) << 16;
+			retVal |= static_cast<std::int64_t>(byte_at(index + 6)) << 8;
+			retVal |= static_cast<std::int64_t>(byte_at(index + 7));
+		}
+		return retVal;
+	}
+
+	bool CANMessageView::get_bool_at(const std::uint32_t byteIndex, const std::uint8_t bitIndex, const std::uint8_t length) const
+	{
+		assert(length <= 8 - bitIndex && "length must be less than or equal to 8 - bitIndex");
+		std::uint8_t mask = ((1 << length) - 1) << bitIndex;
+		return (get_uint8_at(byteIndex) & mask) == mask;
+	}
+
+	std::uint64_t CANMessageView::get_data_custom_length(const std::uint32_t startBitIndex, const std::uint32_t length, const CANMessage::ByteFormat format) const
+	{
+		std::uint64_t retVal = 0;
+		std::uint8_t currentByte = 0;
+		std::uint32_t endBitIndex = startBitIndex + length - 1;
+		std::uint32_t bitCounter = 0;
+		std::uint32_t amountOfBytesLeft = (length + 8 - 1) / 8;
+		std::uint32_t startAmountOfBytes = amountOfBytesLeft;
+		std::uint8_t indexOfFinalByteBit = 7;
+
+		if (endBitIndex > 8 * data.size() || length < 1 || startBitIndex >= 8 * data.size())
+		{
+			LOG_ERROR("End bit index is greater than length or startBitIndex is wrong or startBitIndex is greater than endBitIndex");
+			return retVal;
+		}
+
+		for (auto i = startBitIndex; i <= endBitIndex; i++)
+		{
+			auto byteIndex = i / 8;
+			auto bitIndexWithinByte = i % 8;
+			auto bit = (byte_at(byteIndex) >> (indexOfFinalByteBit - bitIndexWithinByte)) & 1;
+			if (length - bitCounter < 8)
+			{
+				currentByte |= static_cast<uint8_t>(bit) << (length - 1 - bitCounter);
+			}
+			else
+			{
+				currentByte |= static_cast<uint8_t>(bit) << (indexOfFinalByteBit - bitIndexWithinByte);
+			}
+
+			if ((bitCounter + 1) % 8 == 0 || i == endBitIndex)
+			{
+				if (CANMessage::ByteFormat::LittleEndian == format)
+				{
+					retVal |= (static_cast<uint64_t>(currentByte) << (startAmountOfBytes - amountOfBytesLeft) * 8);
+				}
+				else
+				{
+					retVal |= (static_cast<uint64_t>(currentByte) << ((amountOfBytesLeft * 8) - 8));
+				}
+				currentByte = 0;
+				amountOfBytesLeft--;
+			}
+
+			bitCounter++;
+		}
+
+		return retVal;
+	}
+
+	std::uint8_t CANMessageView::byte_at(const std::uint32_t index) const
+	{
+		if (index >= data.size())
+		{
+			throw std::out_of_range("CANMessageView index out of range");
+		}
+		return data[index];
+	}
+
+} // namespace isobus
@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstring>
 #include <numeric>
 
@@ -32,13 +33,13 @@ namespace isobus
 	void CANNetworkManager::initialize()
 	{
 		// Clear queues
-		while (!receivedMessageQueue.empty())
 		{
-			get_next_can_message_from_rx_queue();
+			LOCK_GUARD(Mutex, receivedMessageQueueMutex);
+			receivedMessageQueue = std::queue<CANMessage>();
 		}
-		while (!transmittedMessageQueue.empty())
 		{
-			get_next_can_message_from_tx_queue();
+			LOCK_GUARD(Mutex, transmittedMessageQueueMutex);
+			transmittedMessageQueue = std::queue<CANMessage>();
 		}
 		initialized = true;
 	}
@@ -47,7 +48,11 @@ namespace isobus
 	{
 		auto controlFunction = std::make_shared<InternalControlFunction>(desiredName, preferredAddress, CANPort);
 		controlFunction->pgnRequestProtocol.reset(new ParameterGroupNumberRequestProtocol(controlFunction));
-		internalControlFunctions.push_back(controlFunction);
+		{
+			// The port workers walk this list for every received message
+			LOCK_GUARD(RecursiveMutex, controlFunctionStateMutex);
+			internalControlFunctions.push_back(controlFunction);
+		}
 		heartBeatInterfaces.at(CANPort)->on_new_internal_control_function(controlFunction);
 		return controlFunction;
 	}
@@ -55,6 +60,9 @@ namespace isobus
 	std::shared_ptr<PartneredControlFunction> CANNetworkManager::create_partnered_control_function(std::uint8_t CANPort, const std::vector<NAMEFilter> NAMEFilters)
 	{
 		auto controlFunction = std::make_shared<PartneredControlFunction>(CANPort, NAMEFilters);
+
+		// The port workers walk this list for every received message
+		LOCK_GUARD(RecursiveMutex, controlFunctionStateMutex);
 		partneredControlFunctions.push_back(controlFunction);
 		return controlFunction;
 	}
@@ -64,29 +72,39 @@ namespace isobus
 		// We need to unregister the control function from the interfaces managed by the network manager first.
 		controlFunction->pgnRequestProtocol.reset();
 		heartBeatInterfaces.at(controlFunction->get_can_port())->on_destroyed_internal_control_function(controlFunction);
+
+		LOCK_GUARD(RecursiveMutex, controlFunctionStateMutex);
 		internalControlFunctions.erase(std::remove(internalControlFunctions.begin(), internalControlFunctions.end(), controlFunction), internalControlFunctions.end());
 		deactivate_control_function(std::static_pointer_cast<ControlFunction>(controlFunction));
 	}
 
 	void CANNetworkManager::deactivate_control_function(std::shared_ptr<PartneredControlFunction> controlFunction)
 	{
+		LOCK_GUARD(RecursiveMutex, controlFunctionStateMutex);
 		partneredControlFunctions.erase(std::remove(partneredControlFunctions.begin(), partneredControlFunctions.end(), controlFunction), partneredControlFunctions.end());
 		deactivate_control_function(std::static_pointer_cast<ControlFunction>(controlFunction));
 	}
 
 	void CANNetworkManager::add_global_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction)
 	{
-		globalParameterGroupNumberCallbacks.emplace_back(parameterGroupNumber, callback, parent, internalControlFunction);
+		globalParameterGroupNumberCallbacks.add_callback(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parent, internalControlFunction));
 	}
 
 	void CANNetworkManager::remove_global_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction)
 	{
 		ParameterGroupNumberCallbackData tempObject(parameterGroupNumber, callback, parent, internalControlFunction);
-		auto callbackLocation = std::find(globalParameterGroupNumberCallbacks.begin(), globalParameterGroupNumberCallbacks.end(), tempObject);
-		if (globalParameterGroupNumberCallbacks.end() != callbackLocation)
-		{
-			globalParameterGroupNumberCallbacks.erase(callbackLocation);
-		}
+		globalParameterGroupNumberCallbacks.remove_callback(tempObject);
+	}
+
+	void CANNetworkManager::add_global_parameter_group_number_view_callback(std::uint32_t parameterGroupNumber, CANMessageViewCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction)
+	{
+		globalParameterGroupNumberCallbacks.add_callback(ParameterGroupNumberCallbackData(parameterGroupNumber, nullptr, parent, internalControlFunction, callback));
+	}
+
+	void CANNetworkManager::remove_global_parameter_group_number_view_callback(std::uint32_t parameterGroupNumber, CANMessageViewCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction)
+	{
+		ParameterGroupNumberCallbackData tempObject(parameterGroupNumber, nullptr, parent, internalControlFunction, callback);
+		globalParameterGroupNumberCallbacks.remove_callback(tempObject);
 	}
 
 	std::size_t CANNetworkManager::get_number_global_parameter_group_number_callbacks() const
@@ -97,18 +115,27 @@ namespace isobus
 	void CANNetworkManager::add_any_control_function_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction)
 	{
 		LOCK_GUARD(Mutex, anyControlFunctionCallbacksMutex);
-		anyControlFunctionParameterGroupNumberCallbacks.emplace_back(parameterGroupNumber, callback, parent, internalControlFunction);
+		anyControlFunctionParameterGroupNumberCallbacks.add_callback(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parent, internalControlFunction));
 	}
 
 	void CANNetworkManager::remove_any_control_function_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction)
 	{
 		ParameterGroupNumberCallbackData tempObject(parameterGroupNumber, callback, parent, internalControlFunction);
 		LOCK_GUARD(Mutex, anyControlFunctionCallbacksMutex);
-		auto callbackLocation = std::find(anyControlFunctionParameterGroupNumberCallbacks.begin(), anyControlFunctionParameterGroupNumberCallbacks.end(), tempObject);
-		if (anyControlFunctionParameterGroupNumberCallbacks.end() != callbackLocation)
-		{
-			anyControlFunctionParameterGroupNumberCallbacks.erase(callbackLocation);
-		}
+		anyControlFunctionParameterGroupNumberCallbacks.remove_callback(tempObject);
+	}
+
+	void CANNetworkManager::add_any_control_function_parameter_group_number_view_callback(std::uint32_t parameterGroupNumber, CANMessageViewCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction)
+	{
+		LOCK_GUARD(Mutex, anyControlFunctionCallbacksMutex);
+		anyControlFunctionParameterGroupNumberCallbacks.add_callback(ParameterGroupNumberCallbackData(parameterGroupNumber, nullptr, parent, internalControlFunction, callback));
+	}
+
+	void CANNetworkManager::remove_any_control_function_parameter_group_number_view_callback(std::uint32_t parameterGroupNumber, CANMessageViewCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction)
+	{
+		ParameterGroupNumberCallbackData tempObject(parameterGroupNumber, nullptr, parent, internalControlFunction, callback);
+		LOCK_GUARD(Mutex, anyControlFunctionCallbacksMutex);
+		anyControlFunctionParameterGroupNumberCallbacks.remove_callback(tempObject);
 	}
 
 	EventDispatcher<CANMessage> &CANNetworkManager::get_transmitted_message_event_dispatcher()
@@ -230,14 +257,9 @@ namespace isobus
 
 		update_new_partners();
 
-		process_rx_messages();
-
-		// Update ISOBUS heartbeats (should be done before process_tx_messages
+		// Also updates ISOBUS heartbeats (should be done before process_tx_messages
 		// to minimize latency in safety critical paths)
-		for (std::uint32_t i = 0; i < CAN_PORT_MAXIMUM; i++)
-		{
-			heartBeatInterfaces.at(i)->update();
-		}
+		process_rx_messages();
 
 		process_tx_messages();
 
@@ -245,13 +267,7 @@ namespace isobus
 
 		prune_inactive_control_functions();
 
-		// Update transport protocols
-		for (std::uint32_t i = 0; i < CAN_PORT_MAXIMUM; i++)
-		{
-			transportProtocols[i]->update();
-			extendedTransportProtocols[i]->update();
-			fastPacketProtocol[i]->update();
-		}
+		run_port_update_task(&CANNetworkManager::update_port_protocols);
 		update_busload_history();
 		updateTimestamp_ms = SystemTiming::get_timestamp_ms();
 	}
@@ -268,20 +284,14 @@ namespace isobus
 		return send_can_message_raw(portIndex, sourceAddress, destAddress, parameterGroupNumber, priority, data, size);
 	}
 
-	ParameterGroupNumberCallbackData CANNetworkManager::get_global_parameter_group_number_callback(std::uint32_t index) const
+	void receive_can_message_frame_from_hardware(const CANMessageFrame &rxFrame)
 	{
-		ParameterGroupNumberCallbackData retVal(0, nullptr, nullptr, nullptr);
-
-		if (index < get_number_global_parameter_group_number_callbacks())
-		{
-			retVal = globalParameterGroupNumberCallbacks[index];
-		}
-		return retVal;
+		CANNetworkManager::CANNetwork.process_receive_can_message_frame(rxFrame);
 	}
 
-	void receive_can_message_frame_from_hardware(const CANMessageFrame &rxFrame)
+	void receive_can_message_frames_from_hardware(const CANMessageFrame *rxFrames, std::size_t numberOfFrames)
 	{
-		CANNetworkManager::CANNetwork.process_receive_can_message_frame(rxFrame);
+		CANNetworkManager::CANNetwork.process_receive_can_message_frames(rxFrames, numberOfFrames);
 	}
 
 	void on_transmit_can_message_frame_from_hardware(const CANMessageFrame &txFrame)
@@ -298,14 +308,7 @@ namespace isobus
 	{
 		update_control_functions(rxFrame);
 
-		CANIdentifier identifier(rxFrame.identifier);
-		CANMessage message(CANMessage::Type::Receive,
-		                   identifier,
-		                   rxFrame.data,
-		                   rxFrame.dataLength,
-		                   get_control_function(rxFrame.channel, identifier.get_source_address()),
-		                   get_control_function(rxFrame.channel, identifier.get_destination_address()),
-		                   rxFrame.channel);
+		CANMessage message = create_message_from_frame(CANMessage::Type::Receive, rxFrame);
 
 		update_busload(rxFrame.channel, rxFrame.get_number_bits_in_message());
 
@@ -316,18 +319,51 @@ namespace isobus
 		}
 	}
 
+	void CANNetworkManager::process_receive_can_message_frames(const CANMessageFrame *rxFrames, std::size_t numberOfFrames)
+	{
+		if (nullptr == rxFrames)
+		{
+			return;
+		}
+
+		// Control functions must be resolved per frame, as an earlier frame in the batch may be an address claim
+		LOCK_GUARD(Mutex, receivedFrameStagingMutex);
+		std::uint32_t busloadBits = 0;
+		receivedFrameStaging.clear();
+		for (std::size_t i = 0; i < numberOfFrames; i++)
+		{
+			update_control_functions(rxFrames[i]);
+			receivedFrameStaging.push_back(create_message_from_frame(CANMessage::Type::Receive, rxFrames[i]));
+
+			if ((i > 0) && (rxFrames[i].channel != rxFrames[i - 1].channel))
+			{
+				update_busload(rxFrames[i - 1].channel, busloadBits);
+				busloadBits = 0;
+			}
+			busloadBits += rxFrames[i].get_number_bits_in_message();
+		}
+
+		if (numberOfFrames > 0)
+		{
+			update_busload(rxFrames[numberOfFrames - 1].channel, busloadBits);
+		}
+
+		if (initialized)
+		{
+			LOCK_GUARD(Mutex, receivedMessageQueueMutex);
+			for (auto &message : receivedFrameStaging)
+			{
+				receivedMessageQueue.push(std::move(message));
+			}
+		}
+		receivedFrameStaging.clear();
+	}
+
 	void CANNetworkManager::process_transmitted_can_message_frame(const CANMessageFrame &txFrame)
 	{
 		update_busload(txFrame.channel, txFrame.get_number_bits_in_message());
 
-		CANIdentifier identifier(txFrame.identifier);
-		CANMessage message(CANMessage::Type::Transmit,
-		                   identifier,
-		                   txFrame.data,
-		                   txFrame.dataLength,
-		                   get_control_function(txFrame.channel, identifier.get_source_address()),
-		                   get_control_function(txFrame.channel, identifier.get_destination_address()),
-		                   txFrame.channel);
+		CANMessage message = create_message_from_frame(CANMessage::Type::Transmit, txFrame);
 
 		if (initialized)
 		{
@@ -338,11 +374,13 @@ namespace isobus
 
 	void CANNetworkManager::deactivate_control_function(std::shared_ptr<ControlFunction> controlFunction)
 	{
+		LOCK_GUARD(RecursiveMutex, controlFunctionStateMutex);
 		auto result = std::find(inactiveControlFunctions.begin(), inactiveControlFunctions.end(), controlFunction);
 		if (result != inactiveControlFunctions.end())
 		{
 			inactiveControlFunctions.erase(result);
 		}
+		remove_from_name_index(controlFunction);
 
 		for (std::uint8_t i = 0; i < NULL_CAN_ADDRESS; i++)
 		{
@@ -394,12 +432,12 @@ namespace isobus
 		}
 	}
 
-	const std::list<std::shared_ptr<InternalControlFunction>> &CANNetworkManager::get_internal_control_functions() const
+	const std::vector<std::shared_ptr<InternalControlFunction>> &CANNetworkManager::get_internal_control_functions() const
 	{
 		return internalControlFunctions;
 	}
 
-	const std::list<std::shared_ptr<PartneredControlFunction>> &CANNetworkManager::get_partnered_control_functions() const
+	const std::vector<std::shared_ptr<PartneredControlFunction>> &CANNetworkManager::get_partnered_control_functions() const
 	{
 		return partneredControlFunctions;
 	}
@@ -408,30 +446,19 @@ namespace isobus
 	{
 		std::list<std::shared_ptr<ControlFunction>> retVal;
 
-		for (std::uint8_t channelIndex = 0; channelIndex < CAN_PORT_MAXIMUM; channelIndex++)
-		{
-			for (std::uint8_t address = 0; address < NULL_CAN_ADDRESS; address++)
-			{
-				if (nullptr != controlFunctionTable[channelIndex][address])
-				{
-					retVal.push_back(controlFunctionTable[channelIndex][address]);
-				}
-			}
-		}
-
-		if (includingOffline)
-		{
-			retVal.insert(retVal.end(), inactiveControlFunctions.begin(), inactiveControlFunctions.end());
-		}
-
+		for_each_control_function(includingOffline, [&retVal](const std::shared_ptr<ControlFunction> &controlFunction) {
+			retVal.push_back(controlFunction);
+		});
 		return retVal;
 	}
 
 	std::list<std::shared_ptr<TransportProtocolSessionBase>> isobus::CANNetworkManager::get_active_transport_protocol_sessions(std::uint8_t canPortIndex) const
 	{
 		std::list<std::shared_ptr<TransportProtocolSessionBase>> retVal;
-		retVal.insert(retVal.end(), transportProtocols[canPortIndex]->get_sessions().begin(), transportProtocols[canPortIndex]->get_sessions().end());
-		retVal.insert(retVal.end(), extendedTransportProtocols[canPortIndex]->get_sessions().begin(), extendedTransportProtocols[canPortIndex]->get_sessions().end());
+
+		for_each_active_transport_protocol_session(canPortIndex, [&retVal](const std::shared_ptr<TransportProtocolSessionBase> &session) {
+			retVal.push_back(session);
+		});
 		return retVal;
 	}
 
@@ -440,6 +467,11 @@ namespace isobus
 		return fastPacketProtocol[canPortIndex];
 	}
 
+	std::shared_ptr<TransportProtocolBufferPool> CANNetworkManager::get_transport_protocol_buffer_pool() const
+	{
+		return transportProtocolBufferPool;
+	}
+
 	HeartbeatInterface &CANNetworkManager::get_heartbeat_interface(std::uint8_t canPortIndex)
 	{
 		assert(canPortIndex < CAN_PORT_MAXIMUM); // You passed in an out of range index!
@@ -461,9 +493,9 @@ namespace isobus
 		bool retVal = false;
 		ParameterGroupNumberCallbackData callbackInfo(parameterGroupNumber, callback, parentPointer, internalControlFunction);
 		LOCK_GUARD(Mutex, protocolPGNCallbacksMutex);
-		if ((nullptr != callback) && (protocolPGNCallbacks.end() == find(protocolPGNCallbacks.begin(), protocolPGNCallbacks.end(), callbackInfo)))
+		if ((nullptr != callback) && (!protocolPGNCallbacks.contains(callbackInfo)))
 		{
-			protocolPGNCallbacks.push_back(callbackInfo);
+			protocolPGNCallbacks.add_callback(callbackInfo);
 			retVal = true;
 		}
 		return retVal;
@@ -476,19 +508,13 @@ namespace isobus
 		LOCK_GUARD(Mutex, protocolPGNCallbacksMutex);
 		if (nullptr != callback)
 		{
-			std::list<ParameterGroupNumberCallbackData>::iterator callbackLocation;
-			callbackLocation = find(protocolPGNCallbacks.begin(), protocolPGNCallbacks.end(), callbackInfo);
-
-			if (protocolPGNCallbacks.end() != callbackLocation)
-			{
-				protocolPGNCallbacks.erase(callbackLocation);
-				retVal = true;
-			}
+			retVal = protocolPGNCallbacks.remove_callback(callbackInfo);
 		}
 		return retVal;
 	}
 
-	CANNetworkManager::CANNetworkManager()
+	CANNetworkManager::CANNetworkManager() :
+	  transportProtocolBufferPool(std::make_shared<TransportProtocolBufferPool>())
 	{
 		currentBusloadBitAccumulator.fill(0);
 		lastAddressClaimRequestTimestamp_ms.fill(0);
@@ -502,33 +528,57 @@ namespace isobus
 
 		for (std::uint8_t i = 0; i < CAN_PORT_MAXIMUM; i++)
 		{
-			auto receive_message_callback = [this, i](const CANMessage &message) {
-				// TODO: hack port_index for now, once network manager isn't a singleton, this can be removed
-				CANMessage tempMessage(CANMessage::Type::Receive,
-				                       message.get_identifier(),
-				                       message.get_data(),
-				                       message.get_source_control_function(),
-				                       message.get_destination_control_function(),
-				                       i);
+			auto receive_message_callback = [this](const CANMessage &message) {
 				this->protocol_message_callback(message);
 			};
-			transportProtocols.at(i).reset(new TransportProtocolManager(send_frame_callback, receive_message_callback, &configuration));
-			extendedTransportProtocols.at(i).reset(new ExtendedTransportProtocolManager(send_frame_callback, receive_message_callback, &configuration));
-			fastPacketProtocol.at(i).reset(new FastPacketProtocol(send_frame_callback));
+			transportProtocols.at(i).reset(new TransportProtocolManager(send_frame_callback, receive_message_callback, &configuration, transportProtocolBufferPool));
+			extendedTransportProtocols.at(i).reset(new ExtendedTransportProtocolManager(send_frame_callback, receive_message_callback, &configuration, transportProtocolBufferPool));
+			fastPacketProtocol.at(i).reset(new FastPacketProtocol(send_frame_callback, transportProtocolBufferPool));
 			heartBeatInterfaces.at(i).reset(new HeartbeatInterface(send_frame_callback));
 		}
 	}
 
+	CANNetworkManager::~CANNetworkManager()
+	{
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+		stop_port_workers();
+#endif
+	}
+
 	std::shared_ptr<ControlFunction> CANNetworkManager::create_external_control_function(NAME desiredName, std::uint8_t address, std::uint8_t CANPort)
 	{
 		auto controlFunction = std::make_shared<ControlFunction>(desiredName, address, CANPort, ControlFunction::Type::External);
+		LOCK_GUARD(RecursiveMutex, controlFunctionStateMutex);
 		if ((CANPort < CAN_PORT_MAXIMUM) && (address < NULL_CAN_ADDRESS))
 		{
 			controlFunctionTable[CANPort][address] = controlFunction;
 		}
+		add_to_name_index(controlFunction);
 		return controlFunction;
 	}
 
+	void CANNetworkManager::add_to_name_index(const std::shared_ptr<ControlFunction> &controlFunction)
+	{
+		if ((nullptr != controlFunction) && (controlFunction->get_can_port() < CAN_PORT_MAXIMUM))
+		{
+			controlFunctionNAMEIndex[controlFunction->get_can_port()][controlFunction->get_NAME().get_full_name()] = controlFunction;
+		}
+	}
+
+	void CANNetworkManager::remove_from_name_index(const std::shared_ptr<ControlFunction> &controlFunction)
+	{
+		if ((nullptr != controlFunction) && (controlFunction->get_can_port() < CAN_PORT_MAXIMUM))
+		{
+			auto &portIndex = controlFunctionNAMEIndex[controlFunction->get_can_port()];
+			auto result = portIndex.find(controlFunction->get_NAME().get_full_name());
+
+			if ((result != portIndex.end()) && (result->second == controlFunction))
+			{
+				portIndex.erase(result);
+			}
+		}
+	}
+
 	void CANNetworkManager::update_address_table(const CANMessage &message)
 	{
 		std::uint8_t channelIndex = message.get_can_port_index();
@@ -557,23 +607,23 @@ namespace isobus
 			{
 				targetControlFunction->claimedAddressSinceLastAddressClaimRequest = true;
 			}
-			else
+			else if (CAN_DATA_LENGTH == message.get_data_length())
 			{
-				// Look through all inactive CFs, maybe one of them has freshly claimed the address
-				for (auto currentControlFunction : inactiveControlFunctions)
+				// Maybe an inactive CF has freshly claimed the address, the claim contains its NAME
+				auto &portIndex = controlFunctionNAMEIndex[channelIndex];
+				auto result = portIndex.find(message.get_uint64_at(0));
+
+				if ((result != portIndex.end()) &&
+				    (result->second->get_address() == claimedAddress))
 				{
-					if ((currentControlFunction->get_address() == claimedAddress) &&
-					    (currentControlFunction->get_can_port() == channelIndex))
-					{
-						controlFunctionTable[channelIndex][claimedAddress] = currentControlFunction;
-						LOG_DEBUG("[NM]: %s CF '%016llx' is now active at address '%d' on channel '%d'.",
-						          currentControlFunction->get_type_string().c_str(),
-						          currentControlFunction->get_NAME().get_full_name(),
-						          claimedAddress,
-						          channelIndex);
-						process_control_function_state_change_callback(currentControlFunction, ControlFunctionState::Online);
-						break;
-					}
+					auto currentControlFunction = result->second;
+					controlFunctionTable[channelIndex][claimedAddress] = currentControlFunction;
+					LOG_DEBUG("[NM]: %s CF '%016llx' is now active at address '%d' on channel '%d'.",
+					          currentControlFunction->get_type_string().c_str(),
+					          currentControlFunction->get_NAME().get_full_name(),
+					          claimedAddress,
+					          channelIndex);
+					process_control_function_state_change_callback(currentControlFunction, ControlFunctionState::Online);
 				}
 			}
 		}
@@ -606,6 +656,7 @@ namespace isobus
 
 	void CANNetworkManager::update_internal_cfs()
 	{
+		LOCK_GUARD(RecursiveMutex, controlFunctionStateMutex);
 		for (const auto &currentInternalControlFunction : internalControlFunctions)
 		{
 			if (currentInternalControlFunction->update_address_claiming())
@@ -626,13 +677,15 @@ namespace isobus
 				if (nullptr != controlFunctionTable[channelIndex][claimedAddress])
 				{
 					// Someone is at that spot in the table, but their address was stolen by an internal control function
-					// Need to evict them from the table
+					// Need to evict them from the table and move them to the inactive list, so they're found again when they reclaim
 					controlFunctionTable[channelIndex][claimedAddress]->address = NULL_CAN_ADDRESS;
+					inactiveControlFunctions.push_back(controlFunctionTable[channelIndex][claimedAddress]);
 					controlFunctionTable[channelIndex][claimedAddress] = nullptr;
 				}
 
 				// ECU has claimed since the last update, add it to the table
 				controlFunctionTable[channelIndex][claimedAddress] = currentInternalControlFunction;
+				add_to_name_index(currentInternalControlFunction);
 			}
 		}
 	}
@@ -676,112 +729,117 @@ namespace isobus
 		    (CAN_DATA_LENGTH == rxFrame.dataLength) &&
 		    (rxFrame.channel < CAN_PORT_MAXIMUM))
 		{
-			std::uint64_t claimedNAME;
-			std::shared_ptr<ControlFunction> foundControlFunction = nullptr;
-			uint8_t claimedAddress = CANIdentifier(rxFrame.identifier).get_source_address();
-
-			claimedNAME = rxFrame.data[0];
-			claimedNAME |= (static_cast<std::uint64_t>(rxFrame.data[1]) << 8);
-			claimedNAME |= (static_cast<std::uint64_t>(rxFrame.data[2]) << 16);
-			claimedNAME |= (static_cast<std::uint64_t>(rxFrame.data[3]) << 24);
-			claimedNAME |= (static_cast<std::uint64_t>(rxFrame.data[4]) << 32);
-			claimedNAME |= (static_cast<std::uint64_t>(rxFrame.data[5]) << 40);
-			claimedNAME |= (static_cast<std::uint64_t>(rxFrame.data[6]) << 48);
-			claimedNAME |= (static_cast<std::uint64_t>(rxFrame.data[7]) << 56);
-
-			// Check if the claimed NAME is someone we already know about
-			auto activeResult = std::find_if(controlFunctionTable[rxFrame.channel].begin(),
-			                                 controlFunctionTable[rxFrame.channel].end(),
-			                                 [claimedNAME](const std::shared_ptr<ControlFunction> &cf) {
-				                                 return (nullptr != cf) && (cf->get_NAME().get_full_name() == claimedNAME);
-			                                 });
-			if (activeResult != controlFunctionTable[rxFrame.channel].end())
+			std::shared_ptr<ControlFunction> onlineControlFunction = nullptr;
 			{
-				foundControlFunction = *activeResult;
-			}
-			else
-			{
-				auto inActiveResult = std::find_if(inactiveControlFunctions.begin(),
-				                                   inactiveControlFunctions.end(),
-				                                   [claimedNAME, &rxFrame](const std::shared_ptr<ControlFunction> &cf) {
-					                                   return (cf->get_NAME().get_full_name() == claimedNAME) && (cf->get_can_port() == rxFrame.channel);
-				                                   });
-				if (inActiveResult != inactiveControlFunctions.end())
+				LOCK_GUARD(RecursiveMutex, controlFunctionStateMutex);
+				std::uint64_t claimedNAME;
+				std::shared_ptr<ControlFunction> foundControlFunction = nullptr;
+				uint8_t claimedAddress = CANIdentifier(rxFrame.identifier).get_source_address();
+
+				claimedNAME = rxFrame.data[0];
+				claimedNAME |= (static_cast<std::uint64_t>(rxFrame.data[1]) << 8);
+				claimedNAME |= (static_cast<std::uint64_t>(rxFrame.data[2]) << 16);
+				claimedNAME |= (static_cast<std::uint64_t>(rxFrame.data[3]) << 24);
+				claimedNAME |= (static_cast<std::uint64_t>(rxFrame.data[4]) << 32);
+				claimedNAME |= (static_cast<std::uint64_t>(rxFrame.data[5]) << 40);
+				claimedNAME |= (static_cast<std::uint64_t>(rxFrame.data[6]) << 48);
+				claimedNAME |= (static_cast<std::uint64_t>(rxFrame.data[7]) << 56);
+
+				// Check if the claimed NAME is someone we already know about
+				auto &portIndex = controlFunctionNAMEIndex[rxFrame.channel];
+				auto indexResult = portIndex.find(claimedNAME);
+				if (indexResult != portIndex.end())
 				{
-					foundControlFunction = *inActiveResult;
+					foundControlFunction = indexResult->second;
 				}
-			}
 
-			if (nullptr == foundControlFunction)
-			{
-				// If we still haven't found it, it might be a partner. Check the list of partners.
-				for (const auto &partner : partneredControlFunctions)
+				// Remove any CF that has the same address as the one claiming
+				// Active CFs are kept at their own address in the table, so only that one entry can hold the address
+				const auto &currentAddressHolder = controlFunctionTable[rxFrame.channel][claimedAddress];
+				if ((nullptr != currentAddressHolder) && (foundControlFunction != currentAddressHolder) && (currentAddressHolder->get_address() == claimedAddress))
+				{
+					// The claiming CF takes over its entry in the table, so the evicted one is forgotten
+					currentAddressHolder->address = CANIdentifier::NULL_ADDRESS;
+					remove_from_name_index(currentAddressHolder);
+				}
+
+				if (nullptr == foundControlFunction)
 				{
-					if ((partner->get_can_port() == rxFrame.channel) &&
-					    (partner->check_matches_name(NAME(claimedNAME))) &&
-					    (0 == partner->get_NAME().get_full_name()))
+					// If we still haven't found it, it might be a partner. Check the list of partners.
+					for (const auto &partner : partneredControlFunctions)
 					{
-						partner->controlFunctionNAME = NAME(claimedNAME);
-						foundControlFunction = partner;
-						controlFunctionTable[rxFrame.channel][claimedAddress] = foundControlFunction;
-						break;
+						if ((partner->get_can_port() == rxFrame.channel) &&
+						    (partner->check_matches_name(NAME(claimedNAME))) &&
+						    (0 == partner->get_NAME().get_full_name()))
+						{
+							partner->controlFunctionNAME = NAME(claimedNAME);
+							foundControlFunction = partner;
+							controlFunctionTable[rxFrame.channel][claimedAddress] = foundControlFunction;
+							add_to_name_index(foundControlFunction);
+							break;
+						}
 					}
 				}
-			}
 
-			// Remove any CF that has the same address as the one claiming
-			std::for_each(controlFunctionTable[rxFrame.channel].begin(),
-			              controlFunctionTable[rxFrame.channel].end(),
-			              [&foundControlFunction, &claimedAddress](const std::shared_ptr<ControlFunction> &cf) {
-				              if ((nullptr != cf) && (foundControlFunction != cf) && (cf->get_address() == claimedAddress))
-					              cf->address = CANIdentifier::NULL_ADDRESS;
-			              });
-
-			std::for_each(inactiveControlFunctions.begin(),
-			              inactiveControlFunctions.end(),
-			              [&rxFrame, &foundControlFunction, &claimedAddress](const std::shared_ptr<ControlFunction> &cf) {
-				              if ((foundControlFunction != cf) && (cf->get_address() == claimedAddress) && (cf->get_can_port() == rxFrame.channel))
-					              cf->address = CANIdentifier::NULL_ADDRESS;
-			              });
-
-			if (nullptr == foundControlFunction)
-			{
-				// New device, need to start keeping track of it
-				foundControlFunction = create_external_control_function(NAME(claimedNAME), claimedAddress, rxFrame.channel);
-				LOG_DEBUG("[NM]: A control function claimed address %u on channel %u", foundControlFunction->get_address(), foundControlFunction->get_can_port());
-			}
-			else if (foundControlFunction->get_address() != claimedAddress)
-			{
-				if (foundControlFunction->get_address_valid())
+				std::for_each(inactiveControlFunctions.begin(),
+				              inactiveControlFunctions.end(),
+				              [&rxFrame, &foundControlFunction, &claimedAddress](const std::shared_ptr<ControlFunction> &cf) {
+					              if ((foundControlFunction != cf) && (cf->get_address() == claimedAddress) && (cf->get_can_port() == rxFrame.channel))
+						              cf->address = CANIdentifier::NULL_ADDRESS;
+				              });
+
+				if (nullptr == foundControlFunction)
 				{
-					controlFunctionTable[rxFrame.channel][claimedAddress] = foundControlFunction;
-					controlFunctionTable[rxFrame.channel][foundControlFunction->get_address()] = nullptr;
-					LOG_INFO("[NM]: The %s control function at address %d changed it's address to %d on channel %u.",
-					         foundControlFunction->get_type_string().c_str(),
-					         foundControlFunction->get_address(),
-					         claimedAddress,
-					         foundControlFunction->get_can_port());
+					// New device, need to start keeping track of it
+					foundControlFunction = create_external_control_function(NAME(claimedNAME), claimedAddress, rxFrame.channel);
+					LOG_DEBUG("[NM]: A control function claimed address %u on channel %u", foundControlFunction->get_address(), foundControlFunction->get_can_port());
 				}
-				else
+				else if (foundControlFunction->get_address() != claimedAddress)
 				{
-					LOG_INFO("[NM]: %s control function with name %016llx has claimed address %u on channel %u.",
-					         foundControlFunction->get_type_string().c_str(),
-					         foundControlFunction->get_NAME().get_full_name(),
-					         claimedAddress,
-					         foundControlFunction->get_can_port());
-					process_control_function_state_change_callback(foundControlFunction, ControlFunctionState::Online);
+					if (foundControlFunction->get_address_valid())
+					{
+						controlFunctionTable[rxFrame.channel][claimedAddress] = foundControlFunction;
+						controlFunctionTable[rxFrame.channel][foundControlFunction->get_address()] = nullptr;
+						LOG_INFO("[NM]: The %s control function at address %d changed it's address to %d on channel %u.",
+						         foundControlFunction->get_type_string().c_str(),
+						         foundControlFunction->get_address(),
+						         claimedAddress,
+						         foundControlFunction->get_can_port());
+					}
+					else
+					{
+						LOG_INFO("[NM]: %s control function with name %016llx has claimed address %u on channel %u.",
+						         foundControlFunction->get_type_string().c_str(),
+						         foundControlFunction->get_NAME().get_full_name(),
+						         claimedAddress,
+						         foundControlFunction->get_can_port());
+						onlineControlFunction = foundControlFunction;
+					}
+					foundControlFunction->address = claimedAddress;
 				}
-				foundControlFunction->address = claimedAddress;
+			}
+
+			if (nullptr != onlineControlFunction)
+			{
+				// Called without the lock, so the receiving thread never runs application code while holding it
+				process_control_function_state_change_callback(onlineControlFunction, ControlFunctionState::Online);
 			}
 		}
 	}
 
 	void CANNetworkManager::update_new_partners()
 	{
-		for (const auto &partner : partneredControlFunctions)
+		LOCK_GUARD(RecursiveMutex, controlFunctionStateMutex);
+
+		// Indexed, so a state change callback that creates a partner doesn't invalidate the loop
+		for (std::size_t i = 0; i < partneredControlFunctions.size(); i++)
 		{
+			const auto &partner = partneredControlFunctions[i];
+
 			if (!partner->initialized)
 			{
+				partner->initialized = true;
+
 				// Remove any inactive CF that matches the partner's name
 				for (auto currentInactiveControlFunction = inactiveControlFunctions.begin(); currentInactiveControlFunction != inactiveControlFunctions.end(); currentInactiveControlFunction++)
 				{
@@ -789,6 +847,7 @@ namespace isobus
 					    (partner->get_can_port() == (*currentInactiveControlFunction)->get_can_port()) &&
 					    (ControlFunction::Type::External == (*currentInactiveControlFunction)->get_type()))
 					{
+						remove_from_name_index(*currentInactiveControlFunction);
 						inactiveControlFunctions.erase(currentInactiveControlFunction);
 						break;
 					}
@@ -804,18 +863,19 @@ namespace isobus
 						// Populate the partner's data
 						partner->address = currentActiveControlFunction->get_address();
 						partner->controlFunctionNAME = currentActiveControlFunction->get_NAME();
-						partner->initialized = true;
 						controlFunctionTable[partner->get_can_port()][partner->address] = std::shared_ptr<ControlFunction>(partner);
-						process_control_function_state_change_callback(partner, ControlFunctionState::Online);
+						add_to_name_index(partner);
 
 						LOG_INFO("[NM]: A partner with name %016llx has claimed address %u on channel %u.",
 						         partner->get_NAME().get_full_name(),
 						         partner->get_address(),
 						         partner->get_can_port());
+
+						// Last, as a callback that creates a partner can move the list's elements
+						process_control_function_state_change_callback(partner, ControlFunctionState::Online);
 						break;
 					}
 				}
-				partner->initialized = true;
 			}
 		}
 	}
@@ -886,57 +946,67 @@ namespace isobus
 
 		if ((address < NULL_CAN_ADDRESS) && (channelIndex < CAN_PORT_MAXIMUM))
 		{
+			LOCK_GUARD(RecursiveMutex, controlFunctionStateMutex);
 			retVal = controlFunctionTable[channelIndex][address];
 		}
 		return retVal;
 	}
 
-	CANMessage CANNetworkManager::get_next_can_message_from_rx_queue()
+	std::shared_ptr<ControlFunction> CANNetworkManager::get_control_function_by_name(std::uint8_t channelIndex, NAME controlFunctionNAME) const
 	{
-		LOCK_GUARD(Mutex, receivedMessageQueueMutex);
-		if (!receivedMessageQueue.empty())
+		std::shared_ptr<ControlFunction> retVal = nullptr;
+
+		if (channelIndex < CAN_PORT_MAXIMUM)
 		{
-			CANMessage retVal = std::move(receivedMessageQueue.front());
-			receivedMessageQueue.pop();
-			return retVal;
+			LOCK_GUARD(RecursiveMutex, controlFunctionStateMutex);
+			auto result = controlFunctionNAMEIndex[channelIndex].find(controlFunctionNAME.get_full_name());
+
+			if (result != controlFunctionNAMEIndex[channelIndex].end())
+			{
+				retVal = result->second;
+			}
 		}
-		return CANMessage::create_invalid_message();
+		return retVal;
 	}
 
-	CANMessage CANNetworkManager::get_next_can_message_from_tx_queue()
+	CANMessage CANNetworkManager::create_message_from_frame(CANMessage::Type type, const CANMessageFrame &frame) const
 	{
-		LOCK_GUARD(Mutex, transmittedMessageQueueMutex);
-		if (!transmittedMessageQueue.empty())
-		{
-			CANMessage retVal = std::move(transmittedMessageQueue.front());
-			transmittedMessageQueue.pop();
-			return retVal;
-		}
-		return CANMessage::create_invalid_message();
+		CANIdentifier identifier(frame.identifier);
+		return CANMessage(type,
+		                  identifier,
+		                  frame.data,
+		                  frame.dataLength,
+		                  get_control_function(frame.channel, identifier.get_source_address()),
+		                  get_control_function(frame.channel, identifier.get_destination_address()),
+		                  frame.channel);
 	}
 
 	void CANNetworkManager::process_any_control_function_pgn_callbacks(const CANMessage &currentMessage)
 	{
-		LOCK_GUARD(Mutex, anyControlFunctionCallbacksMutex);
-		for (const auto &currentCallback : anyControlFunctionParameterGroupNumberCallbacks)
+		if ((nullptr == currentMessage.get_destination_control_function()) ||
+		    (ControlFunction::Type::Internal == currentMessage.get_destination_control_function()->get_type()))
 		{
-			if ((currentCallback.get_parameter_group_number() == currentMessage.get_identifier().get_parameter_group_number()) &&
-			    ((nullptr == currentMessage.get_destination_control_function()) ||
-			     (ControlFunction::Type::Internal == currentMessage.get_destination_control_function()->get_type())))
-			{
-				currentCallback.get_callback()(currentMessage, currentCallback.get_parent());
-			}
+			LOCK_GUARD(Mutex, anyControlFunctionCallbacksMutex);
+			anyControlFunctionParameterGroupNumberCallbacks.for_each_callback(currentMessage.get_identifier().get_parameter_group_number(),
+			                                                                  [&currentMessage](const ParameterGroupNumberCallbackData &currentCallback) {
+				                                                                  currentCallback.invoke(currentMessage);
+			                                                                  });
 		}
 	}
 
 	void CANNetworkManager::process_can_message_for_address_violations(const CANMessage &currentMessage)
 	{
-		for (const auto &internalCF : internalControlFunctions)
+		// Indexed, so a listener that creates a control function doesn't invalidate the loop
+		for (std::size_t i = 0; i < internalControlFunctions.size(); i++)
 		{
+			const auto &internalCF = internalControlFunctions[i];
+
 			if ((nullptr != internalCF) &&
 			    internalCF->process_rx_message_for_address_violation(currentMessage))
 			{
-				addressViolationEventDispatcher.call(internalCF);
+				// Copied, as a listener that creates a control function can move the list's elements
+				const std::shared_ptr<InternalControlFunction> violatingControlFunction = internalCF;
+				addressViolationEventDispatcher.call(violatingControlFunction);
 			}
 		}
 	}
@@ -953,13 +1023,10 @@ namespace isobus
 	void CANNetworkManager::process_protocol_pgn_callbacks(const CANMessage &currentMessage)
 	{
 		LOCK_GUARD(Mutex, protocolPGNCallbacksMutex);
-		for (const auto &currentCallback : protocolPGNCallbacks)
-		{
-			if (currentCallback.get_parameter_group_number() == currentMessage.get_identifier().get_parameter_group_number())
-			{
-				currentCallback.get_callback()(currentMessage, currentCallback.get_parent());
-			}
-		}
+		protocolPGNCallbacks.for_each_callback(currentMessage.get_identifier().get_parameter_group_number(),
+		                                       [&currentMessage](const ParameterGroupNumberCallbackData &currentCallback) {
+			                                       currentCallback.invoke(currentMessage);
+		                                       });
 	}
 
 	void CANNetworkManager::process_can_message_for_global_and_partner_callbacks(const CANMessage &message)
@@ -971,73 +1038,250 @@ namespace isobus
 		      (NULL_CAN_ADDRESS == message.get_identifier().get_source_address()))))
 		{
 			// Message destined to global
-			for (std::size_t i = 0; i < get_number_global_parameter_group_number_callbacks(); i++)
-			{
-				auto glb = get_global_parameter_group_number_callback(i);
-				if ((message.get_identifier().get_parameter_group_number() == glb.get_parameter_group_number()) &&
-				    (nullptr != glb.get_callback()))
-				{
-					// We have a callback that matches this PGN
-					glb.get_callback()(message, glb.get_parent());
-				}
-			}
+			globalParameterGroupNumberCallbacks.for_each_callback(message.get_identifier().get_parameter_group_number(),
+			                                                      [&message](const ParameterGroupNumberCallbackData &glb) {
+				                                                      // We have a callback that matches this PGN
+				                                                      glb.invoke(message);
+			                                                      });
 		}
 		else if ((messageDestination != nullptr) && (messageDestination->get_type() == ControlFunction::Type::Internal))
 		{
 			// Message is destined to us
-			for (const auto &partner : partneredControlFunctions)
+			// The partners are shared by all ports, and the receiving thread can bind them at any time,
+			// so the ones on this port are copied under the lock, and their callbacks are run without it.
+			// Swapped out of the port's buffer so a callback that processes messages can't clobber it.
+			std::vector<std::shared_ptr<PartneredControlFunction>> matchingPartners;
+			matchingPartners.swap(portMatchingPartners[message.get_can_port_index()]);
 			{
-				if ((nullptr != partner) &&
-				    (partner->get_can_port() == message.get_can_port_index()))
+				LOCK_GUARD(RecursiveMutex, controlFunctionStateMutex);
+				for (const auto &partner : partneredControlFunctions)
 				{
-					// Message matches CAN port for a partnered control function
-					for (std::size_t k = 0; k < partner->get_number_parameter_group_number_callbacks(); k++)
+					if ((nullptr != partner) &&
+					    (partner->get_can_port() == message.get_can_port_index()))
 					{
-						const ParameterGroupNumberCallbackData &callbackData = partner->get_parameter_group_number_callback(k);
-						if ((message.get_identifier().get_parameter_group_number() == callbackData.get_parameter_group_number()) &&
-						    (nullptr != callbackData.get_callback()) &&
-						    ((nullptr == callbackData.get_internal_control_function()) ||
-						    (callbackData.get_internal_control_function()->get_address() == message.get_identifier().get_destination_address())))
-						{
-							// We have a callback matching this message
-							callbackData.get_callback()(message, callbackData.get_parent());
-						}
+						// Message matches CAN port for a partnered control function
+						matchingPartners.push_back(partner);
 					}
 				}
 			}
+
+			for (const auto &partner : matchingPartners)
+			{
+				partner->parameterGroupNumberCallbacks.for_each_callback(message.get_identifier().get_parameter_group_number(),
+				                                                         [&message](const ParameterGroupNumberCallbackData &callbackData) {
+					                                                         if ((callbackData.has_callback()) &&
+					                                                             ((nullptr == callbackData.get_internal_control_function()) ||
+					                                                              (callbackData.get_internal_control_function()->get_address() == message.get_identifier().get_destination_address())))
+					                                                         {
+						                                                         // We have a callback matching this message
+						                                                         callbackData.invoke(message);
+					                                                         }
+				                                                         });
+			}
+			matchingPartners.clear();
+			matchingPartners.swap(portMatchingPartners[message.get_can_port_index()]);
 		}
 	}
 
 	void CANNetworkManager::process_rx_messages()
 	{
-		// We may miss a message without locking the mutex when checking if empty, but that's okay. It will be picked up on the next iteration
-		while (!receivedMessageQueue.empty())
 		{
-			CANMessage currentMessage = get_next_can_message_from_rx_queue();
+			// Take the whole queue in one go, anything received while processing will be picked up on the next update
+			LOCK_GUARD(Mutex, receivedMessageQueueMutex);
+			receivedMessageBatch.swap(receivedMessageQueue);
+		}
+
+		while (!receivedMessageBatch.empty())
+		{
+			portReceivedMessageBatches.at(receivedMessageBatch.front().get_can_port_index()).push(std::move(receivedMessageBatch.front()));
+			receivedMessageBatch.pop();
+		}
+
+		run_port_update_task(&CANNetworkManager::update_port_rx_messages);
+	}
+
+	void CANNetworkManager::update_port_rx_messages(std::uint8_t canPortIndex)
+	{
+		std::queue<CANMessage> &messages = portReceivedMessageBatches[canPortIndex];
+
+		while (!messages.empty())
+		{
+			CANMessage currentMessage = std::move(messages.front());
+			messages.pop();
 
-			update_address_table(currentMessage);
-			process_can_message_for_address_violations(currentMessage);
-			process_rx_message_for_address_claiming(currentMessage);
+			{
+				// These touch control functions shared by all ports
+				LOCK_GUARD(RecursiveMutex, controlFunctionStateMutex);
+				update_address_table(currentMessage);
+				process_can_message_for_address_violations(currentMessage);
+				process_rx_message_for_address_claiming(currentMessage);
+			}
 
 			// Update Special Callbacks, like protocols and non-cf specific ones
-			transportProtocols.at(currentMessage.get_can_port_index())->process_message(currentMessage);
-			extendedTransportProtocols.at(currentMessage.get_can_port_index())->process_message(currentMessage);
-			fastPacketProtocol.at(currentMessage.get_can_port_index())->process_message(currentMessage);
-			heartBeatInterfaces.at(currentMessage.get_can_port_index())->process_rx_message(currentMessage);
+			transportProtocols[canPortIndex]->process_message(currentMessage);
+			extendedTransportProtocols[canPortIndex]->process_message(currentMessage);
+			fastPacketProtocol[canPortIndex]->process_message(currentMessage);
+			heartBeatInterfaces[canPortIndex]->process_rx_message(currentMessage);
 			process_protocol_pgn_callbacks(currentMessage);
 			process_any_control_function_pgn_callbacks(currentMessage);
 
 			// Update Others
 			process_can_message_for_global_and_partner_callbacks(currentMessage);
 		}
+
+		heartBeatInterfaces[canPortIndex]->update();
+	}
+
+	void CANNetworkManager::update_port_protocols(std::uint8_t canPortIndex)
+	{
+		transportProtocols[canPortIndex]->update();
+		extendedTransportProtocols[canPortIndex]->update();
+		fastPacketProtocol[canPortIndex]->update();
+	}
+
+	void CANNetworkManager::run_port_update_task(PortUpdateTask task)
+	{
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+		if (!portWorkerThreads.empty())
+		{
+			{
+				LOCK_GUARD(Mutex, portWorkerMutex);
+				portWorkerTask = task;
+				portWorkersBusy = portWorkerThreads.size();
+				portWorkerGeneration++;
+			}
+			portWorkerWakeupCondition.notify_all();
+
+			// The first port and any ports not in use are updated by this thread while the workers handle the others
+			(this->*task)(0);
+			for (std::size_t i = portWorkerThreads.size() + 1; i < CAN_PORT_MAXIMUM; i++)
+			{
+				(this->*task)(static_cast<std::uint8_t>(i));
+			}
+
+			std::unique_lock<std::mutex> lock(portWorkerMutex);
+			while (0 != portWorkersBusy)
+			{
+				portWorkerDoneCondition.wait_for(lock, std::chrono::milliseconds(PORT_WORKER_WAIT_TIMEOUT_MS));
+			}
+			return;
+		}
+#endif
+		for (std::uint8_t i = 0; i < CAN_PORT_MAXIMUM; i++)
+		{
+			(this->*task)(i);
+		}
 	}
 
+	bool CANNetworkManager::set_port_worker_threads_enabled(bool value, std::uint8_t numberOfPorts)
+	{
+		// Make sure we don't change the workers in the middle of an update
+		auto &processingMutex = ControlFunction::controlFunctionProcessingMutex;
+		LOCK_GUARD(Mutex, processingMutex);
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+		if (!portWorkerThreads.empty())
+		{
+			stop_port_workers();
+		}
+		if (value && (numberOfPorts > 1))
+		{
+			start_port_workers(numberOfPorts);
+		}
+		return (!value) || (!portWorkerThreads.empty());
+#else
+		(void)numberOfPorts;
+		return !value;
+#endif
+	}
+
+	bool CANNetworkManager::get_port_worker_threads_enabled() const
+	{
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+		return !portWorkerThreads.empty();
+#else
+		return false;
+#endif
+	}
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+	void CANNetworkManager::start_port_workers(std::uint8_t numberOfPorts)
+	{
+		std::uint32_t initialGeneration;
+		{
+			LOCK_GUARD(Mutex, portWorkerMutex);
+			portWorkersRunning = true;
+			initialGeneration = portWorkerGeneration;
+		}
+
+		for (std::uint8_t i = 1; (i < numberOfPorts) && (i < CAN_PORT_MAXIMUM); i++)
+		{
+			portWorkerThreads.emplace_back(&CANNetworkManager::port_worker_thread_function, this, i, initialGeneration);
+		}
+	}
+
+	void CANNetworkManager::stop_port_workers()
+	{
+		{
+			LOCK_GUARD(Mutex, portWorkerMutex);
+			portWorkersRunning = false;
+		}
+		portWorkerWakeupCondition.notify_all();
+
+		for (auto &worker : portWorkerThreads)
+		{
+			if (worker.joinable())
+			{
+				worker.join();
+			}
+		}
+		portWorkerThreads.clear();
+	}
+
+	void CANNetworkManager::port_worker_thread_function(std::uint8_t canPortIndex, std::uint32_t initialGeneration)
+	{
+		std::uint32_t lastGeneration = initialGeneration;
+		std::unique_lock<std::mutex> lock(portWorkerMutex);
+
+		while (true)
+		{
+			if (portWorkersRunning && (portWorkerGeneration == lastGeneration))
+			{
+				portWorkerWakeupCondition.wait_for(lock, std::chrono::milliseconds(PORT_WORKER_WAIT_TIMEOUT_MS));
+				continue;
+			}
+			if (!portWorkersRunning)
+			{
+				break;
+			}
+			lastGeneration = portWorkerGeneration;
+			PortUpdateTask task = portWorkerTask;
+
+			lock.unlock();
+			(this->*task)(canPortIndex);
+			lock.lock();
+
+			portWorkersBusy--;
+			if (0 == portWorkersBusy)
+			{
+				portWorkerDoneCondition.notify_all();
+			}
+		}
+	}
+#endif
+
 	void CANNetworkManager::process_tx_messages()
 	{
-		// We may miss a message without locking the mutex when checking if empty, but that's okay. It will be picked up on the next iteration
-		while (!transmittedMessageQueue.empty())
 		{
-			CANMessage currentMessage = get_next_can_message_from_tx_queue();
+			// Take the whole queue in one go, anything transmitted while processing will be picked up on the next update
+			LOCK_GUARD(Mutex, transmittedMessageQueueMutex);
+			transmittedMessageBatch.swap(transmittedMessageQueue);
+		}
+
+		while (!transmittedMessageBatch.empty())
+		{
+			CANMessage currentMessage = std::move(transmittedMessageBatch.front());
+			transmittedMessageBatch.pop();
 
 			// Update listen-only callbacks
 			messageTransmittedEventDispatcher.call(currentMessage);
@@ -1046,6 +1290,7 @@ namespace isobus
 
 	void CANNetworkManager::prune_inactive_control_functions()
 	{
+		LOCK_GUARD(RecursiveMutex, controlFunctionStateMutex);
 		for (std::uint_fast8_t channelIndex = 0; channelIndex < CAN_PORT_MAXIMUM; channelIndex++)
 		{
 			constexpr std::uint32_t MAX_ADDRESS_CLAIM_RESOLUTION_TIME = 755; // This is 250ms + RTxD + 250ms
@@ -1093,6 +1338,8 @@ namespace isobus
 	{
 		process_can_message_for_global_and_partner_callbacks(message);
 		process_any_control_function_pgn_callbacks(message);
+
+		LOCK_GUARD(RecursiveMutex, controlFunctionStateMutex);
 		process_rx_message_for_address_claiming(message);
 	}
 
@@ -12,14 +12,12 @@
 
 #include "isobus/isobus/can_constants.hpp"
 
-#include <algorithm>
-#include <cassert>
-
 namespace isobus
 {
 	PartneredControlFunction::PartneredControlFunction(std::uint8_t CANPort, const std::vector<NAMEFilter> NAMEFilters) :
 	  ControlFunction(NAME(0), NULL_CAN_ADDRESS, CANPort, Type::Partnered),
-	  NAMEFilterList(NAMEFilters)
+	  NAMEFilterList(NAMEFilters),
+	  NAMEFilterMatcher(NAMEFilters)
 	{
 		auto &processingMutex = ControlFunction::controlFunctionProcessingMutex;
 		LOCK_GUARD(Mutex, processingMutex);
@@ -27,17 +25,24 @@ namespace isobus
 
 	void PartneredControlFunction::add_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction)
 	{
-		parameterGroupNumberCallbacks.emplace_back(parameterGroupNumber, callback, parent, internalControlFunction);
+		parameterGroupNumberCallbacks.add_callback(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parent, internalControlFunction));
 	}
 
 	void PartneredControlFunction::remove_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction)
 	{
 		ParameterGroupNumberCallbackData tempObject(parameterGroupNumber, callback, parent, internalControlFunction);
-		auto callbackLocation = std::find(parameterGroupNumberCallbacks.begin(), parameterGroupNumberCallbacks.end(), tempObject);
-		if (parameterGroupNumberCallbacks.end() != callbackLocation)
-		{
-			parameterGroupNumberCallbacks.erase(callbackLocation);
-		}
+		parameterGroupNumberCallbacks.remove_callback(tempObject);
+	}
+
+	void PartneredControlFunction::add_parameter_group_number_view_callback(std::uint32_t parameterGroupNumber, CANMessageViewCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction)
+	{
+		parameterGroupNumberCallbacks.add_callback(ParameterGroupNumberCallbackData(parameterGroupNumber, nullptr, parent, internalControlFunction, callback));
+	}
+
+	void PartneredControlFunction::remove_parameter_group_number_view_callback(std::uint32_t parameterGroupNumber, CANMessageViewCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction)
+	{
+		ParameterGroupNumberCallbackData tempObject(parameterGroupNumber, nullptr, parent, internalControlFunction, callback);
+		parameterGroupNumberCallbacks.remove_callback(tempObject);
 	}
 
 	std::size_t PartneredControlFunction::get_number_parameter_group_number_callbacks() const
@@ -79,94 +84,7 @@ namespace isobus
 
 	bool PartneredControlFunction::check_matches_name(NAME NAMEToCheck) const
 	{
-		std::uint32_t currentFilterValue;
-		NAME::NAMEParameters currentFilterParameter;
-		bool retVal = true;
-
-		if (0 == get_number_name_filters())
-		{
-			retVal = false;
-		}
-
-		for (std::uint32_t i = 0; i < get_number_name_filters(); i++)
-		{
-			get_name_filter_parameter(i, currentFilterParameter, currentFilterValue);
-
-			switch (currentFilterParameter)
-			{
-				case NAME::NAMEParameters::IdentityNumber:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_identity_number());
-				}
-				break;
-
-				case NAME::NAMEParameters::ManufacturerCode:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_manufacturer_code());
-				}
-				break;
-
-				case NAME::NAMEParameters::EcuInstance:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_ecu_instance());
-				}
-				break;
-
-				case NAME::NAMEParameters::FunctionInstance:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_function_instance());
-				}
-				break;
-
-				case NAME::NAMEParameters::FunctionCode:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_function_code());
-				}
-				break;
-
-				case NAME::NAMEParameters::DeviceClass:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_device_class());
-				}
-				break;
-
-				case NAME::NAMEParameters::DeviceClassInstance:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_device_class_instance());
-				}
-				break;
-
-				case NAME::NAMEParameters::IndustryGroup:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_industry_group());
-				}
-				break;
-
-				case NAME::NAMEParameters::ArbitraryAddressCapable:
-				{
-					retVal = ((0 != currentFilterValue) == NAMEToCheck.get_arbitrary_address_capable());
-				}
-				break;
-
-				default:
-				{
-					retVal = false;
-				}
-				break;
-			}
-
-			if (false == retVal)
-			{
-				break;
-			}
-		}
-		return retVal;
-	}
-
-	ParameterGroupNumberCallbackData &PartneredControlFunction::get_parameter_group_number_callback(std::size_t index)
-	{
-		assert(index < get_number_parameter_group_number_callbacks());
-		return parameterGroupNumberCallbacks[index];
+		return NAMEFilterMatcher.matches(NAMEToCheck);
 	}
 
 } // namespace isobus
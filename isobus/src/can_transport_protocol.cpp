@@ -122,10 +122,12 @@ namespace isobus
 
 	TransportProtocolManager::TransportProtocolManager(const CANMessageFrameCallback &sendCANFrameCallback,
 	                                                   const CANMessageCallback &canMessageReceivedCallback,
-	                                                   const CANNetworkConfiguration *configuration) :
+	                                                   const CANNetworkConfiguration *configuration,
+	                                                   std::shared_ptr<TransportProtocolBufferPool> bufferPool) :
 	  sendCANFrameCallback(sendCANFrameCallback),
 	  canMessageReceivedCallback(canMessageReceivedCallback),
-	  configuration(configuration)
+	  configuration(configuration),
+	  bufferPool((nullptr != bufferPool) ? bufferPool : std::make_shared<TransportProtocolBufferPool>())
 	{
 	}
 
@@ -160,7 +162,7 @@ namespace isobus
 			}
 
 			auto newSession = std::make_shared<TransportProtocolSession>(TransportProtocolSession::Direction::Receive,
-			                                                             std::unique_ptr<CANMessageData>(new CANMessageDataVector(totalMessageSize)),
+			                                                             std::unique_ptr<CANMessageData>(new CANMessageDataVector(bufferPool->acquire(totalMessageSize))),
 			                                                             parameterGroupNumber,
 			                                                             totalMessageSize,
 			                                                             0xFF, // Arbitrary - unused for broadcast
@@ -172,11 +174,13 @@ namespace isobus
 			if (newSession->get_total_number_of_packets() != totalNumberOfPackets)
 			{
 				LOG_WARNING("[TP]: Received Broadcast Announcement Message (BAM) for 0x%05X with a bad number of packets, aborting...", parameterGroupNumber);
+				close_session(newSession, false);
 			}
 			else
 			{
 				newSession->set_state(StateMachineState::WaitForDataTransferPacket);
 				activeSessions.push_back(newSession);
+				sessionIndex.add(newSession);
 				update_state_machine(newSession);
 				LOG_DEBUG("[TP]: New rx broadcast message session for 0x%05X. Source: %hu", parameterGroupNumber, source->get_address());
 			}
@@ -215,8 +219,6 @@ namespace isobus
 				}
 			}
 
-			auto data = std::unique_ptr<CANMessageData>(new CANMessageDataVector(totalMessageSize));
-
 			if (clearToSendPacketMax > configuration->get_number_of_packets_per_cts_message())
 			{
 				LOG_DEBUG("[TP]: Received Request To Send (RTS) with a CTS packet count of %hu, which is greater than the configured maximum of %hu, using the configured maximum instead.",
@@ -226,7 +228,7 @@ namespace isobus
 			}
 
 			auto newSession = std::make_shared<TransportProtocolSession>(TransportProtocolSession::Direction::Receive,
-			                                                             std::unique_ptr<CANMessageData>(new CANMessageDataVector(totalMessageSize)),
+			                                                             std::unique_ptr<CANMessageData>(new CANMessageDataVector(bufferPool->acquire(totalMessageSize))),
 			                                                             parameterGroupNumber,
 			                                                             totalMessageSize,
 			                                                             clearToSendPacketMax,
@@ -244,6 +246,7 @@ namespace isobus
 			{
 				newSession->set_state(StateMachineState::SendClearToSend);
 				activeSessions.push_back(newSession);
+				sessionIndex.add(newSession);
 				LOG_DEBUG("[TP]: New rx session for 0x%05X. Source: %hu, destination: %hu", parameterGroupNumber, source->get_address(), destination->get_address());
 				update_state_machine(newSession);
 			}
@@ -534,6 +537,7 @@ namespace isobus
 					                            0);
 
 					canMessageReceivedCallback(completedMessage);
+					bufferPool->release(completedMessage.release_data());
 					close_session(session, true);
 					LOG_DEBUG("[TP]: Completed rx session for 0x%05X from %hu", session->get_parameter_group_number(), source->get_address());
 				}
@@ -630,6 +634,7 @@ namespace isobus
 			          destination->get_address());
 		}
 		activeSessions.push_back(session);
+		sessionIndex.add(session);
 		update_state_machine(session);
 		return true;
 	}
@@ -882,9 +887,16 @@ namespace isobus
 	{
 		session->complete(successful);
 
+		if (TransportProtocolSession::Direction::Receive == session->get_direction())
+		{
+			// Give the buffer back to the pool, it will be empty if it was already handed over to a completed message
+			bufferPool->release(std::move(static_cast<CANMessageDataVector &>(session->get_data())));
+		}
+
 		auto sessionLocation = std::find(activeSessions.begin(), activeSessions.end(), session);
 		if (activeSessions.end() != sessionLocation)
 		{
+			sessionIndex.remove(session);
 			activeSessions.erase(sessionLocation);
 			LOG_DEBUG("[TP]: Session Closed");
 		}
@@ -992,22 +1004,22 @@ namespace isobus
 
 	bool TransportProtocolManager::has_session(std::shared_ptr<ControlFunction> source, std::shared_ptr<ControlFunction> destination)
 	{
-		return std::any_of(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<TransportProtocolManager::TransportProtocolSession> &session) {
-			return session->matches(source, destination);
-		});
+		return nullptr != sessionIndex.find(source.get(), destination.get());
 	}
 
 	std::shared_ptr<TransportProtocolManager::TransportProtocolSession> TransportProtocolManager::get_session(std::shared_ptr<ControlFunction> source,
 	                                                                                                          std::shared_ptr<ControlFunction> destination)
 	{
-		auto result = std::find_if(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<TransportProtocolManager::TransportProtocolSession> &session) {
-			return session->matches(source, destination);
-		});
-		return (activeSessions.end() != result) ? (*result) : nullptr;
+		return std::static_pointer_cast<TransportProtocolManager::TransportProtocolSession>(sessionIndex.find(source.get(), destination.get()));
 	}
 
 	const std::vector<std::shared_ptr<TransportProtocolManager::TransportProtocolSession>> &TransportProtocolManager::get_sessions() const
 	{
 		return activeSessions;
 	}
+
+	std::shared_ptr<TransportProtocolBufferPool> TransportProtocolManager::get_buffer_pool() const
+	{
+		return bufferPool;
+	}
 }
@@ -11,6 +11,8 @@
 #include "isobus/isobus/can_internal_control_function.hpp"
 #include "isobus/utility/system_timing.hpp"
 
+#include <cstdint>
+
 namespace isobus
 {
 	TransportProtocolSessionBase::TransportProtocolSessionBase(TransportProtocolSessionBase::Direction direction,
@@ -103,4 +105,141 @@ namespace isobus
 			                        parent);
 		}
 	}
-}
+
+	TransportProtocolSessionIndex::TransportProtocolSessionIndex(bool keyIncludesParameterGroupNumber) :
+	  keyIncludesParameterGroupNumber(keyIncludesParameterGroupNumber)
+	{
+	}
+
+	void TransportProtocolSessionIndex::add(std::shared_ptr<TransportProtocolSessionBase> session)
+	{
+		if (nullptr != session)
+		{
+			// Keep the load factor at or below one half, so probe sequences stay short
+			if (2 * (numberOfSessions + 1) > slots.size())
+			{
+				resize(slots.empty() ? MINIMUM_INDEX_SIZE : (2 * slots.size()));
+			}
+			insert_into_slots(std::move(session));
+			numberOfSessions++;
+		}
+	}
+
+	bool TransportProtocolSessionIndex::remove(const std::shared_ptr<TransportProtocolSessionBase> &session)
+	{
+		if ((nullptr == session) || slots.empty())
+		{
+			return false;
+		}
+
+		const std::size_t mask = slots.size() - 1;
+		const std::uint32_t parameterGroupNumber = keyIncludesParameterGroupNumber ? session->get_parameter_group_number() : 0;
+		std::size_t slot = hash_slot(session->get_source().get(), session->get_destination().get(), parameterGroupNumber);
+
+		while ((nullptr != slots[slot].session) && (session != slots[slot].session))
+		{
+			slot = (slot + 1) & mask;
+		}
+
+		if (nullptr == slots[slot].session)
+		{
+			return false;
+		}
+
+		// Backward shift deletion, move later entries of the probe sequence into the hole so lookups never need tombstones
+		std::size_t hole = slot;
+		std::size_t next = (hole + 1) & mask;
+		while (nullptr != slots[next].session)
+		{
+			const std::size_t home = hash_slot(slots[next].source, slots[next].destination, slots[next].parameterGroupNumber);
+			const std::size_t distanceFromHome = (next - home) & mask;
+			const std::size_t distanceFromHole = (next - hole) & mask;
+
+			if (distanceFromHome >= distanceFromHole)
+			{
+				slots[hole] = std::move(slots[next]);
+				hole = next;
+			}
+			next = (next + 1) & mask;
+		}
+		slots[hole] = Slot{ nullptr, nullptr, 0, nullptr };
+		numberOfSessions--;
+		return true;
+	}
+
+	std::shared_ptr<TransportProtocolSessionBase> TransportProtocolSessionIndex::find(const ControlFunction *source,
+	                                                                                  const ControlFunction *destination,
+	                                                                                  std::uint32_t parameterGroupNumber) const
+	{
+		if (!slots.empty())
+		{
+			const std::size_t mask = slots.size() - 1;
+
+			if (!keyIncludesParameterGroupNumber)
+			{
+				parameterGroupNumber = 0;
+			}
+
+			for (std::size_t slot = hash_slot(source, destination, parameterGroupNumber); nullptr != slots[slot].session; slot = (slot + 1) & mask)
+			{
+				if ((source == slots[slot].source) &&
+				    (destination == slots[slot].destination) &&
+				    (parameterGroupNumber == slots[slot].parameterGroupNumber))
+				{
+					return slots[slot].session;
+				}
+			}
+		}
+		return nullptr;
+	}
+
+	std::size_t TransportProtocolSessionIndex::size() const
+	{
+		return numberOfSessions;
+	}
+
+	void TransportProtocolSessionIndex::clear()
+	{
+		slots.clear();
+		numberOfSessions = 0;
+	}
+
+	std::size_t TransportProtocolSessionIndex::hash_slot(const ControlFunction *source, const ControlFunction *destination, std::uint32_t parameterGroupNumber) const
+	{
+		// Combine the key parts with Fibonacci hashing, pointers are aligned so their low bits carry little information
+		std::uint64_t key = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(source));
+		key = (key * 0x9E3779B97F4A7C15ull) ^ static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(destination));
+		key = (key * 0x9E3779B97F4A7C15ull) ^ parameterGroupNumber;
+		key *= 0x9E3779B97F4A7C15ull;
+		return static_cast<std::size_t>(key >> 32) & (slots.size() - 1);
+	}
+
+	void TransportProtocolSessionIndex::insert_into_slots(std::shared_ptr<TransportProtocolSessionBase> session)
+	{
+		const std::size_t mask = slots.size() - 1;
+		const ControlFunction *source = session->get_source().get();
+		const ControlFunction *destination = session->get_destination().get();
+		const std::uint32_t parameterGroupNumber = keyIncludesParameterGroupNumber ? session->get_parameter_group_number() : 0;
+		std::size_t slot = hash_slot(source, destination, parameterGroupNumber);
+
+		while (nullptr != slots[slot].session)
+		{
+			slot = (slot + 1) & mask;
+		}
+		slots[slot] = Slot{ source, destination, parameterGroupNumber, std::move(session) };
+	}
+
+	void TransportProtocolSessionIndex::resize(std::size_t newSize)
+	{
+		std::vector<Slot> oldSlots(newSize, Slot{ nullptr, nullptr, 0, nullptr });
+		slots.swap(oldSlots);
+
+		for (auto &slot : oldSlots)
+		{
+			if (nullptr != slot.session)
+			{
+				insert_into_slots(std::move(slot.session));
+			}
+		}
+	}
+} // namespace isobus
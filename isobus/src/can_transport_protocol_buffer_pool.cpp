@@ -0,0 +1,149 @@
+//================================================================================================
+/// @file can_transport_protocol_buffer_pool.cpp
+///
+/// @brief A pool of reusable receive buffers for the transport protocols.
+/// @author Adrian Del Grosso
+/// @author Daan Steenbergen
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/isobus/can_transport_protocol_buffer_pool.hpp"
+
+#include <algorithm>
+
+namespace isobus
+{
+	std::vector<std::uint8_t> TransportProtocolBufferPool::acquire(std::size_t size)
+	{
+		std::vector<std::uint8_t> retVal;
+		const std::size_t sizeClass = get_size_class_for_size(size);
+		bool reused = false;
+
+		{
+			LOCK_GUARD(Mutex, poolMutex);
+			if ((sizeClass < NUMBER_OF_SIZE_CLASSES) && (!freeBuffers[sizeClass].empty()))
+			{
+				retVal = std::move(freeBuffers[sizeClass].back());
+				freeBuffers[sizeClass].pop_back();
+				statistics.retainedBytes -= std::min(statistics.retainedBytes, retVal.capacity());
+				statistics.hits++;
+				reused = true;
+			}
+			else
+			{
+				statistics.misses++;
+			}
+		}
+
+		if (!reused)
+		{
+			// Allocate a full size class, so the buffer can serve any request of the same class later on
+			retVal.reserve(get_buffer_size_for_size(size));
+		}
+		retVal.assign(size, 0);
+
+		LOCK_GUARD(Mutex, poolMutex);
+		statistics.bytesInUse += get_buffer_size_for_size(size);
+		statistics.highWaterBytes = std::max(statistics.highWaterBytes, statistics.bytesInUse);
+		return retVal;
+	}
+
+	void TransportProtocolBufferPool::release(std::vector<std::uint8_t> &&buffer)
+	{
+		std::vector<std::uint8_t> releasedBuffer(std::move(buffer));
+		const std::size_t capacity = releasedBuffer.capacity();
+
+		if (0 != capacity)
+		{
+			const std::size_t sizeClass = get_size_class_for_capacity(capacity);
+
+			LOCK_GUARD(Mutex, poolMutex);
+			// Small payloads are copied out of their buffer when a message is built, so the buffer that comes back
+			// can be a different one. Its size still matches the request though, so that's what gets counted.
+			statistics.bytesInUse -= std::min(statistics.bytesInUse, get_buffer_size_for_size(releasedBuffer.size()));
+
+			if ((sizeClass < NUMBER_OF_SIZE_CLASSES) && ((statistics.retainedBytes + capacity) <= maximumRetainedBytes))
+			{
+				releasedBuffer.clear();
+				statistics.retainedBytes += capacity;
+				freeBuffers[sizeClass].push_back(std::move(releasedBuffer));
+			}
+		}
+	}
+
+	void TransportProtocolBufferPool::set_maximum_retained_bytes(std::size_t maximumRetainedBytes)
+	{
+		LOCK_GUARD(Mutex, poolMutex);
+		this->maximumRetainedBytes = maximumRetainedBytes;
+		trim_to_maximum_retained_bytes();
+	}
+
+	std::size_t TransportProtocolBufferPool::get_maximum_retained_bytes() const
+	{
+		LOCK_GUARD(Mutex, poolMutex);
+		return maximumRetainedBytes;
+	}
+
+	TransportProtocolBufferPool::Statistics TransportProtocolBufferPool::get_statistics() const
+	{
+		LOCK_GUARD(Mutex, poolMutex);
+		return statistics;
+	}
+
+	void TransportProtocolBufferPool::clear()
+	{
+		LOCK_GUARD(Mutex, poolMutex);
+		for (auto &buffers : freeBuffers)
+		{
+			buffers.clear();
+		}
+		statistics.retainedBytes = 0;
+	}
+
+	std::size_t TransportProtocolBufferPool::get_size_class_for_size(std::size_t size)
+	{
+		std::size_t retVal = 0;
+		std::size_t classSize = MINIMUM_POOLED_BUFFER_SIZE;
+
+		while ((classSize < size) && (retVal < NUMBER_OF_SIZE_CLASSES))
+		{
+			classSize <<= 1;
+			retVal++;
+		}
+		return retVal;
+	}
+
+	std::size_t TransportProtocolBufferPool::get_buffer_size_for_size(std::size_t size)
+	{
+		const std::size_t sizeClass = get_size_class_for_size(size);
+		return (sizeClass < NUMBER_OF_SIZE_CLASSES) ? (MINIMUM_POOLED_BUFFER_SIZE << sizeClass) : size;
+	}
+
+	std::size_t TransportProtocolBufferPool::get_size_class_for_capacity(std::size_t capacity)
+	{
+		std::size_t retVal = NUMBER_OF_SIZE_CLASSES;
+
+		if ((capacity >= MINIMUM_POOLED_BUFFER_SIZE) && (capacity < (2 * MAXIMUM_POOLED_BUFFER_SIZE)))
+		{
+			retVal = 0;
+			while ((MINIMUM_POOLED_BUFFER_SIZE << (retVal + 1)) <= capacity)
+			{
+				retVal++;
+			}
+		}
+		return retVal;
+	}
+
+	void TransportProtocolBufferPool::trim_to_maximum_retained_bytes()
+	{
+		for (std::size_t i = NUMBER_OF_SIZE_CLASSES; (i > 0) && (statistics.retainedBytes > maximumRetainedBytes); i--)
+		{
+			auto &buffers = freeBuffers[i - 1];
+			while ((!buffers.empty()) && (statistics.retainedBytes > maximumRetainedBytes))
+			{
+				statistics.retainedBytes -= std::min(statistics.retainedBytes, buffers.back().capacity());
+				buffers.pop_back();
+			}
+		}
+	}
+} // namespace isobus
@@ -11,16 +11,141 @@
 #include "isobus/isobus/can_constants.hpp"
 #include "isobus/isobus/can_stack_logger.hpp"
 #include "isobus/utility/platform_endianness.hpp"
+#include "isobus/utility/thread_synchronization.hpp"
 #include "isobus/utility/to_string.hpp"
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <cstring>
 #include <iomanip>
 #include <sstream>
+#include <utility>
 
 namespace isobus
 {
+	//================================================================================================
+	/// @class DeviceDescriptorObjectPool::ObjectArena
+	///
+	/// @brief Hands out memory for DDOP objects from large blocks that are freed together
+	/// @details Memory is never given back to the arena one object at a time, the blocks are
+	/// freed when the arena is destroyed. Every object allocated from the arena holds a reference
+	/// to it, so that only happens once the DDOP and all of its objects are gone.
+	//================================================================================================
+	class DeviceDescriptorObjectPool::ObjectArena
+	{
+	public:
+		/// @brief Allocates memory from the arena
+		/// @param[in] size The number of bytes to allocate
+		/// @param[in] alignment The alignment the memory needs, at most that of std::max_align_t
+		/// @returns The allocated memory
+		void *allocate(std::size_t size, std::size_t alignment)
+		{
+			assert(alignment <= alignof(std::max_align_t)); // New blocks are only aligned this much
+
+			LOCK_GUARD(Mutex, arenaMutex);
+			std::size_t offset = (usedBytes + alignment - 1) & ~(alignment - 1);
+
+			if (blocks.empty() || ((offset + size) > currentBlockSize))
+			{
+				// Objects bigger than a block get a block of their own
+				currentBlockSize = std::max(size, BLOCK_SIZE);
+				blocks.emplace_back(new std::uint8_t[currentBlockSize]);
+				offset = 0;
+			}
+			usedBytes = offset + size;
+			return blocks.back().get() + offset;
+		}
+
+	private:
+		static constexpr std::size_t BLOCK_SIZE = 4096; ///< The size of each block, enough for a few dozen objects
+
+		std::vector<std::unique_ptr<std::uint8_t[]>> blocks; ///< The blocks memory is handed out from, the last one is being filled
+		std::size_t currentBlockSize = 0; ///< The size of the block being filled
+		std::size_t usedBytes = 0; ///< The number of bytes handed out from the block being filled
+		Mutex arenaMutex; ///< Copies of a DDOP share their arena, so allocations are serialized
+	};
+
+	//================================================================================================
+	/// @class DeviceDescriptorObjectPool::ObjectArenaAllocator
+	///
+	/// @brief A standard allocator that allocates from an object arena, and keeps the arena alive
+	//================================================================================================
+	template<typename T>
+	class DeviceDescriptorObjectPool::ObjectArenaAllocator
+	{
+	public:
+		using value_type = T; ///< The type this allocator allocates
+
+		/// @brief Constructor for the allocator
+		/// @param[in] objectArena The arena to allocate from
+		explicit ObjectArenaAllocator(std::shared_ptr<ObjectArena> objectArena) :
+		  arena(std::move(objectArena))
+		{
+		}
+
+		/// @brief Constructs an allocator for one type from an allocator of another type
+		/// @param[in] other The allocator to copy the arena from
+		template<typename U>
+		ObjectArenaAllocator(const ObjectArenaAllocator<U> &other) :
+		  arena(other.arena)
+		{
+		}
+
+		/// @brief Allocates memory for a number of objects from the arena
+		/// @param[in] count The number of objects to allocate memory for
+		/// @returns The allocated memory
+		T *allocate(std::size_t count)
+		{
+			return static_cast<T *>(arena->allocate(count * sizeof(T), alignof(T)));
+		}
+
+		/// @brief Does nothing, memory is freed when the arena is destroyed
+		void deallocate(T *, std::size_t)
+		{
+		}
+
+		/// @brief Returns if two allocators allocate from the same arena
+		/// @param[in] other The allocator to compare against
+		/// @returns true if both allocators allocate from the same arena
+		template<typename U>
+		bool operator==(const ObjectArenaAllocator<U> &other) const
+		{
+			return arena == other.arena;
+		}
+
+		/// @brief Returns if two allocators allocate from different arenas
+		/// @param[in] other The allocator to compare against
+		/// @returns true if the allocators allocate from different arenas
+		template<typename U>
+		bool operator!=(const ObjectArenaAllocator<U> &other) const
+		{
+			return arena != other.arena;
+		}
+
+		std::shared_ptr<ObjectArena> arena; ///< The arena to allocate from
+	};
+
+	template<typename T, typename... Args>
+	std::shared_ptr<T> DeviceDescriptorObjectPool::create_object(Args &&...args)
+	{
+		std::shared_ptr<T> retVal;
+
+		if (objectArenaEnabled)
+		{
+			if (nullptr == objectArena)
+			{
+				objectArena = std::make_shared<ObjectArena>();
+			}
+			retVal = std::allocate_shared<T>(ObjectArenaAllocator<T>(objectArena), std::forward<Args>(args)...);
+		}
+		else
+		{
+			retVal = std::make_shared<T>(std::forward<Args>(args)...);
+		}
+		return retVal;
+	}
+
 	DeviceDescriptorObjectPool::DeviceDescriptorObjectPool(std::uint8_t taskControllerServerVersion) :
 	  taskControllerCompatibilityLevel(taskControllerServerVersion)
 	{
@@ -117,14 +242,15 @@ namespace isobus
 			{
 				LOG_WARNING("[DDOP]: Device localization label byte 7 must be the reserved value 0xFF. This value will be enforced when DDOP binary is generated.");
 			}
-			objectList.emplace_back(new task_controller_object::DeviceObject(deviceDesignator,
-			                                                                 deviceSoftwareVersion,
-			                                                                 deviceSerialNumber,
-			                                                                 deviceStructureLabel,
-			                                                                 deviceLocalizationLabel,
-			                                                                 deviceExtendedStructureLabel,
-			                                                                 clientIsoNAME,
-			                                                                 (taskControllerCompatibilityLevel >= 4)));
+			objectList.emplace_back(create_object<task_controller_object::DeviceObject>(std::move(deviceDesignator),
+			                                                                            std::move(deviceSoftwareVersion),
+			                                                                            std::move(deviceSerialNumber),
+			                                                                            std::move(deviceStructureLabel),
+			                                                                            deviceLocalizationLabel,
+			                                                                            std::move(deviceExtendedStructureLabel),
+			                                                                            clientIsoNAME,
+			                                                                            (taskControllerCompatibilityLevel >= 4)));
+			index_last_object();
 		}
 		else
 		{
@@ -162,11 +288,12 @@ namespace isobus
 				deviceElementDesignator.resize(task_controller_object::Object::MAX_DESIGNATOR_LENGTH);
 			}
 
-			objectList.emplace_back(new task_controller_object::DeviceElementObject(deviceElementDesignator,
-			                                                                        deviceElementNumber,
-			                                                                        parentObjectID,
-			                                                                        deviceElementType,
-			                                                                        uniqueID));
+			objectList.emplace_back(create_object<task_controller_object::DeviceElementObject>(std::move(deviceElementDesignator),
+			                                                                                   deviceElementNumber,
+			                                                                                   parentObjectID,
+			                                                                                   deviceElementType,
+			                                                                                   uniqueID));
+			index_last_object();
 		}
 		else
 		{
@@ -223,12 +350,13 @@ namespace isobus
 				         " Please verify your DDOP configuration meets this requirement.");
 			}
 
-			objectList.emplace_back(new task_controller_object::DeviceProcessDataObject(processDataDesignator,
-			                                                                            processDataDDI,
-			                                                                            deviceValuePresentationObjectID,
-			                                                                            processDataProperties,
-			                                                                            processDataTriggerMethods,
-			                                                                            uniqueID));
+			objectList.emplace_back(create_object<task_controller_object::DeviceProcessDataObject>(std::move(processDataDesignator),
+			                                                                                       processDataDDI,
+			                                                                                       deviceValuePresentationObjectID,
+			                                                                                       processDataProperties,
+			                                                                                       processDataTriggerMethods,
+			                                                                                       uniqueID));
+			index_last_object();
 		}
 		else
 		{
@@ -277,11 +405,12 @@ namespace isobus
 				         " Please verify your DDOP configuration meets this requirement.");
 			}
 
-			objectList.emplace_back(new task_controller_object::DevicePropertyObject(propertyDesignator,
-			                                                                         propertyValue,
-			                                                                         propertyDDI,
-			                                                                         valuePresentationObject,
-			                                                                         uniqueID));
+			objectList.emplace_back(create_object<task_controller_object::DevicePropertyObject>(std::move(propertyDesignator),
+			                                                                                    propertyValue,
+			                                                                                    propertyDDI,
+			                                                                                    valuePresentationObject,
+			                                                                                    uniqueID));
+			index_last_object();
 		}
 		else
 		{
@@ -330,11 +459,12 @@ namespace isobus
 				         " Please verify your DDOP configuration meets this requirement.");
 			}
 
-			objectList.emplace_back(new task_controller_object::DeviceValuePresentationObject(unitDesignator,
-			                                                                                  offsetValue,
-			                                                                                  scaleFactor,
-			                                                                                  numberDecimals,
-			                                                                                  uniqueID));
+			objectList.emplace_back(create_object<task_controller_object::DeviceValuePresentationObject>(std::move(unitDesignator),
+			                                                                                             offsetValue,
+			                                                                                             scaleFactor,
+			                                                                                             numberDecimals,
+			                                                                                             uniqueID));
+			index_last_object();
 		}
 		else
 		{
@@ -366,10 +496,7 @@ namespace isobus
 				// Verify there's enough data to read the XML namespace
 				if (binaryPoolSizeBytes > 3)
 				{
-					std::string xmlNameSpace;
-					xmlNameSpace.push_back(static_cast<char>(binaryPool[0]));
-					xmlNameSpace.push_back(static_cast<char>(binaryPool[1]));
-					xmlNameSpace.push_back(static_cast<char>(binaryPool[2]));
+					const std::string xmlNameSpace(reinterpret_cast<const char *>(binaryPool), 3);
 
 					if ("DVC" == xmlNameSpace)
 					{
@@ -443,15 +570,9 @@ namespace isobus
 							std::vector<std::uint8_t> extendedStructureLabel;
 							std::uint64_t ddopClientNAME = 0;
 
-							for (std::uint16_t i = 0; i < numberDesignatorBytes; i++)
-							{
-								deviceDesignator.push_back(binaryPool[6 + i]);
-							}
+							deviceDesignator.assign(reinterpret_cast<const char *>(&binaryPool[6]), numberDesignatorBytes);
 
-							for (std::uint16_t i = 0; i < numberSoftwareVersionBytes; i++)
-							{
-								deviceSoftwareVersion.push_back(binaryPool[7 + numberDesignatorBytes + i]);
-							}
+							deviceSoftwareVersion.assign(reinterpret_cast<const char *>(&binaryPool[7 + numberDesignatorBytes]), numberSoftwareVersionBytes);
 
 							for (std::uint8_t i = 0; i < 8; i++)
 							{
@@ -469,27 +590,18 @@ namespace isobus
 								clientNAME.set_full_name(ddopClientNAME);
 							}
 
-							for (std::uint16_t i = 0; i < numberDeviceSerialNumberBytes; i++)
-							{
-								deviceSerialNumber.push_back(binaryPool[16 + numberDesignatorBytes + numberSoftwareVersionBytes + i]);
-							}
+							deviceSerialNumber.assign(reinterpret_cast<const char *>(&binaryPool[16 + numberDesignatorBytes + numberSoftwareVersionBytes]), numberDeviceSerialNumberBytes);
 
-							for (std::uint16_t i = 0; i < 7; i++)
-							{
-								deviceStructureLabel.push_back(binaryPool[16 + numberDeviceSerialNumberBytes + numberDesignatorBytes + numberSoftwareVersionBytes + i]);
-							}
+							deviceStructureLabel.assign(reinterpret_cast<const char *>(&binaryPool[16 + numberDeviceSerialNumberBytes + numberDesignatorBytes + numberSoftwareVersionBytes]), 7);
 
 							for (std::uint16_t i = 0; i < 7; i++)
 							{
 								localizationLabel.at(i) = (binaryPool[23 + numberDeviceSerialNumberBytes + numberDesignatorBytes + numberSoftwareVersionBytes + i]);
 							}
 
-							for (std::uint16_t i = 0; i < numberExtendedStructureLabelBytes; i++)
-							{
-								extendedStructureLabel.push_back(binaryPool[31 + numberDeviceSerialNumberBytes + numberDesignatorBytes + numberSoftwareVersionBytes + i]);
-							}
+							extendedStructureLabel.assign(&binaryPool[31 + numberDeviceSerialNumberBytes + numberDesignatorBytes + numberSoftwareVersionBytes], &binaryPool[31 + numberDeviceSerialNumberBytes + numberDesignatorBytes + numberSoftwareVersionBytes] + numberExtendedStructureLabelBytes);
 
-							if (add_device(deviceDesignator, deviceSoftwareVersion, deviceSerialNumber, deviceStructureLabel, localizationLabel, extendedStructureLabel, clientNAME.get_full_name()))
+							if (add_device(std::move(deviceDesignator), std::move(deviceSoftwareVersion), std::move(deviceSerialNumber), std::move(deviceStructureLabel), localizationLabel, std::move(extendedStructureLabel), clientNAME.get_full_name()))
 							{
 								binaryPoolSizeBytes -= expectedSize;
 								binaryPool += expectedSize;
@@ -548,12 +660,9 @@ namespace isobus
 							std::uint16_t elementNumber = static_cast<std::uint16_t>(binaryPool[7 + numberDesignatorBytes]) | (static_cast<std::uint16_t>(binaryPool[8 + numberDesignatorBytes]) << 8);
 							auto type = static_cast<task_controller_object::DeviceElementObject::Type>(binaryPool[5]);
 
-							for (std::uint16_t i = 0; i < numberDesignatorBytes; i++)
-							{
-								deviceElementDesignator.push_back(binaryPool[7 + i]);
-							}
+							deviceElementDesignator.assign(reinterpret_cast<const char *>(&binaryPool[7]), numberDesignatorBytes);
 
-							if (add_device_element(deviceElementDesignator, elementNumber, parentObject, type, uniqueID))
+							if (add_device_element(std::move(deviceElementDesignator), elementNumber, parentObject, type, uniqueID))
 							{
 								auto DETObject = std::static_pointer_cast<task_controller_object::DeviceElementObject>(get_object_by_id(uniqueID));
 
@@ -606,12 +715,9 @@ namespace isobus
 							std::uint16_t uniqueID = static_cast<std::uint16_t>(static_cast<std::uint16_t>(binaryPool[3]) | (static_cast<std::uint16_t>(binaryPool[4]) << 8));
 							std::uint16_t presentationObjectID = static_cast<std::uint16_t>(static_cast<std::uint16_t>(binaryPool[10 + numberDesignatorBytes]) | (static_cast<std::uint16_t>(binaryPool[11 + numberDesignatorBytes]) << 8));
 
-							for (std::uint16_t i = 0; i < numberDesignatorBytes; i++)
-							{
-								processDataDesignator.push_back(binaryPool[10 + i]);
-							}
+							processDataDesignator.assign(reinterpret_cast<const char *>(&binaryPool[10]), numberDesignatorBytes);
 
-							if (add_device_process_data(processDataDesignator, DDI, presentationObjectID, binaryPool[7], binaryPool[8], uniqueID))
+							if (add_device_process_data(std::move(processDataDesignator), DDI, presentationObjectID, binaryPool[7], binaryPool[8], uniqueID))
 							{
 								binaryPoolSizeBytes -= expectedSize;
 								binaryPool += expectedSize;
@@ -656,12 +762,9 @@ namespace isobus
 							std::uint16_t uniqueID = static_cast<std::uint16_t>(static_cast<std::uint16_t>(binaryPool[3]) | (static_cast<std::uint16_t>(binaryPool[4]) << 8));
 							std::uint16_t presentationObjectID = static_cast<std::uint16_t>(static_cast<std::uint16_t>(binaryPool[12 + numberDesignatorBytes]) | (static_cast<std::uint16_t>(binaryPool[13 + numberDesignatorBytes]) << 8));
 
-							for (std::uint16_t i = 0; i < numberDesignatorBytes; i++)
-							{
-								designator.push_back(binaryPool[12 + i]);
-							}
+							designator.assign(reinterpret_cast<const char *>(&binaryPool[12]), numberDesignatorBytes);
 
-							if (add_device_property(designator, propertyValue, DDI, presentationObjectID, uniqueID))
+							if (add_device_property(std::move(designator), propertyValue, DDI, presentationObjectID, uniqueID))
 							{
 								binaryPoolSizeBytes -= expectedSize;
 								binaryPool += expectedSize;
@@ -718,12 +821,9 @@ namespace isobus
 
 							memcpy(&scale, scaleBytes.data(), sizeof(float));
 
-							for (std::uint16_t i = 0; i < numberDesignatorBytes; i++)
-							{
-								designator.push_back(binaryPool[15 + i]);
-							}
+							designator.assign(reinterpret_cast<const char *>(&binaryPool[15]), numberDesignatorBytes);
 
-							if (add_device_value_presentation(designator, offset, scale, binaryPool[13], uniqueID))
+							if (add_device_value_presentation(std::move(designator), offset, scale, binaryPool[13], uniqueID))
 							{
 								binaryPoolSizeBytes -= expectedSize;
 								binaryPool += expectedSize;
@@ -985,14 +1085,11 @@ namespace isobus
 	std::shared_ptr<task_controller_object::Object> DeviceDescriptorObjectPool::get_object_by_id(std::uint16_t objectID)
 	{
 		std::shared_ptr<task_controller_object::Object> retVal;
+		const std::uint32_t position = find_object(objectID);
 
-		for (auto &currentObject : objectList)
+		if (NO_OBJECT != position)
 		{
-			if (currentObject->get_object_id() == objectID)
-			{
-				retVal = currentObject;
-				break;
-			}
+			retVal = objectList[position - 1];
 		}
 		return retVal;
 	}
@@ -1011,15 +1108,14 @@ namespace isobus
 	bool DeviceDescriptorObjectPool::remove_object_by_id(std::uint16_t objectID)
 	{
 		bool retVal = false;
+		const std::uint32_t position = find_object(objectID);
 
-		for (auto object = objectList.begin(); object != objectList.end(); object++)
+		if (NO_OBJECT != position)
 		{
-			if ((nullptr != *object) && (*object)->get_object_id() == objectID)
-			{
-				objectList.erase(object);
-				retVal = true;
-				break;
-			}
+			// Removing an object moves the ones after it, so their positions in the index have to be updated
+			objectList.erase(objectList.begin() + (position - 1));
+			rebuild_object_index();
+			retVal = true;
 		}
 		return retVal;
 	}
@@ -1051,6 +1147,8 @@ namespace isobus
 	void DeviceDescriptorObjectPool::clear()
 	{
 		objectList.clear();
+		objectIndex.clear();
+		objectArena.reset(); // Freed as soon as nothing else holds one of the objects
 	}
 
 	std::uint16_t DeviceDescriptorObjectPool::size() const
@@ -1058,6 +1156,16 @@ namespace isobus
 		return static_cast<std::uint16_t>(objectList.size());
 	}
 
+	void DeviceDescriptorObjectPool::set_object_arena_enabled(bool enabled)
+	{
+		objectArenaEnabled = enabled;
+	}
+
+	bool DeviceDescriptorObjectPool::get_object_arena_enabled() const
+	{
+		return objectArenaEnabled;
+	}
+
 	bool DeviceDescriptorObjectPool::resolve_parent_ids_to_objects()
 	{
 		bool retVal = true;
@@ -1217,14 +1325,7 @@ namespace isobus
 
 		if ((0 != uniqueID) && (NULL_OBJECT_ID != uniqueID))
 		{
-			for (auto &currentObject : objectList)
-			{
-				if (uniqueID == currentObject->get_object_id())
-				{
-					retVal = false;
-					break;
-				}
-			}
+			retVal = (NO_OBJECT == find_object(uniqueID));
 		}
 		else
 		{
@@ -1233,4 +1334,58 @@ namespace isobus
 		return retVal;
 	}
 
+	std::uint32_t DeviceDescriptorObjectPool::find_object(std::uint16_t objectID) const
+	{
+		std::uint32_t retVal = NO_OBJECT;
+
+		if (objectIndexIDChangeCount != task_controller_object::Object::get_object_id_change_count())
+		{
+			// Object IDs can be changed through the objects after they're added
+			rebuild_object_index();
+		}
+
+		if (objectID < objectIndex.size())
+		{
+			retVal = objectIndex[objectID];
+		}
+		return retVal;
+	}
+
+	void DeviceDescriptorObjectPool::index_last_object()
+	{
+		const std::uint16_t objectID = objectList.back()->get_object_id();
+
+		if (objectID >= objectIndex.size())
+		{
+			objectIndex.resize(static_cast<std::size_t>(objectID) + 1, NO_OBJECT);
+		}
+
+		if (NO_OBJECT == objectIndex[objectID])
+		{
+			objectIndex[objectID] = static_cast<std::uint32_t>(objectList.size());
+		}
+	}
+
+	void DeviceDescriptorObjectPool::rebuild_object_index() const
+	{
+		objectIndexIDChangeCount = task_controller_object::Object::get_object_id_change_count();
+		std::fill(objectIndex.begin(), objectIndex.end(), NO_OBJECT);
+
+		for (std::size_t i = 0; i < objectList.size(); i++)
+		{
+			const std::uint16_t objectID = objectList[i]->get_object_id();
+
+			if (objectID >= objectIndex.size())
+			{
+				objectIndex.resize(static_cast<std::size_t>(objectID) + 1, NO_OBJECT);
+			}
+
+			if (NO_OBJECT == objectIndex[objectID])
+			{
+				// Like a search from the front, the first object with an ID wins
+				objectIndex[objectID] = static_cast<std::uint32_t>(i + 1);
+			}
+		}
+	}
+
 } // namespace isobus
@@ -894,6 +894,20 @@ namespace isobus
 		measurementMinimumThresholdCommands.clear();
 		measurementMaximumThresholdCommands.clear();
 		measurementOnChangeThresholdCommands.clear();
+
+		for (auto &slot : measurementTimerWheel)
+		{
+			slot.clear();
+		}
+		for (auto &publishedValue : publishedValues)
+		{
+			// The published values themselves stay, since they're still the application's latest values
+			publishedValue.second.maximumThresholdCommand = nullptr;
+			publishedValue.second.minimumThresholdCommand = nullptr;
+			publishedValue.second.changeThresholdCommand = nullptr;
+			publishedValue.second.changed = false;
+		}
+		changedPublishedValues.clear();
 	}
 
 	bool TaskControllerClient::get_was_ddop_supplied() const
@@ -1037,15 +1051,11 @@ namespace isobus
 		while (!queuedValueRequests.empty() && transmitSuccessful)
 		{
 			const auto &currentRequest = queuedValueRequests.front();
+			std::int32_t newValue = 0;
 
-			for (auto &currentCallback : requestValueCallbacks)
+			if (get_process_data_value(currentRequest.elementNumber, currentRequest.ddi, newValue))
 			{
-				std::int32_t newValue = 0;
-				if (currentCallback.callback(currentRequest.elementNumber, currentRequest.ddi, newValue, currentCallback.parent))
-				{
-					transmitSuccessful = send_value_command(currentRequest.elementNumber, currentRequest.ddi, newValue);
-					break;
-				}
+				transmitSuccessful = send_value_command(currentRequest.elementNumber, currentRequest.ddi, newValue);
 			}
 			queuedValueRequests.pop_front();
 		}
@@ -1072,112 +1082,344 @@ namespace isobus
 
 	void TaskControllerClient::process_queued_threshold_commands()
 	{
-		bool transmitSuccessful = false;
+		// The network manager schedules and links commands into the wheel and published values as they arrive
+		LOCK_GUARD(Mutex, clientMutex);
+		process_measurement_timer_wheel();
+		process_published_values();
 
-		for (auto &measurementTimeCommand : measurementTimeIntervalCommands)
+		// Threshold commands for values the application doesn't publish still have to be polled
+		for (auto &measurementMaxCommand : measurementMaximumThresholdCommands)
+		{
+			if (!measurementMaxCommand.valueIsPublished)
+			{
+				std::int32_t newValue = 0;
+				get_process_data_value(measurementMaxCommand.elementNumber, measurementMaxCommand.ddi, newValue);
+				process_threshold_command(ProcessDataCommands::MeasurementMaximumWithinThreshold, measurementMaxCommand, newValue);
+			}
+		}
+		for (auto &measurementMinCommand : measurementMinimumThresholdCommands)
 		{
-			if (SystemTiming::time_expired_ms(static_cast<std::uint32_t>(measurementTimeCommand.lastValue), static_cast<std::uint32_t>(measurementTimeCommand.processDataValue)))
+			if (!measurementMinCommand.valueIsPublished)
 			{
-				// Time to update this time interval variable
-				transmitSuccessful = false;
-				for (auto &currentCallback : requestValueCallbacks)
+				std::int32_t newValue = 0;
+				get_process_data_value(measurementMinCommand.elementNumber, measurementMinCommand.ddi, newValue);
+				process_threshold_command(ProcessDataCommands::MeasurementMinimumWithinThreshold, measurementMinCommand, newValue);
+			}
+		}
+		for (auto &measurementChangeCommand : measurementOnChangeThresholdCommands)
+		{
+			if (!measurementChangeCommand.valueIsPublished)
+			{
+				std::int32_t newValue = 0;
+				get_process_data_value(measurementChangeCommand.elementNumber, measurementChangeCommand.ddi, newValue);
+				process_threshold_command(ProcessDataCommands::MeasurementChangeThreshold, measurementChangeCommand, newValue);
+			}
+		}
+	}
+
+	void TaskControllerClient::process_measurement_timer_wheel()
+	{
+		const std::uint32_t currentTimestamp_ms = SystemTiming::get_timestamp_ms();
+		std::uint32_t millisecondsToProcess = currentTimestamp_ms - measurementTimerWheelTimestamp_ms;
+
+		if (millisecondsToProcess > MEASUREMENT_TIMER_WHEEL_SLOTS)
+		{
+			// Every slot gets visited once, commands that are due later stay where they are
+			millisecondsToProcess = MEASUREMENT_TIMER_WHEEL_SLOTS;
+		}
+		measurementTimerWheelTimestamp_ms = currentTimestamp_ms;
+
+		// Visit the slots oldest first, so a command rescheduled into the next millisecond isn't visited again
+		for (std::uint32_t i = millisecondsToProcess; i > 0; i--)
+		{
+			auto &slot = measurementTimerWheel[(currentTimestamp_ms - i + 1) % MEASUREMENT_TIMER_WHEEL_SLOTS];
+
+			if (!slot.empty())
+			{
+				measurementTimerWheelSlotBeingProcessed.swap(slot);
+
+				for (auto measurementTimeCommand : measurementTimerWheelSlotBeingProcessed)
 				{
-					std::int32_t newValue = 0;
-					if (currentCallback.callback(measurementTimeCommand.elementNumber, measurementTimeCommand.ddi, newValue, currentCallback.parent))
+					if (SystemTiming::time_expired_ms(static_cast<std::uint32_t>(measurementTimeCommand->lastValue), static_cast<std::uint32_t>(measurementTimeCommand->processDataValue)))
 					{
-						transmitSuccessful = send_value_command(measurementTimeCommand.elementNumber, measurementTimeCommand.ddi, newValue);
-						break;
+						// Time to update this time interval variable
+						std::int32_t newValue = 0;
+
+						if (get_process_data_value(measurementTimeCommand->elementNumber, measurementTimeCommand->ddi, newValue) &&
+						    send_value_command(measurementTimeCommand->elementNumber, measurementTimeCommand->ddi, newValue))
+						{
+							measurementTimeCommand->lastValue = static_cast<std::int32_t>(SystemTiming::get_timestamp_ms());
+						}
+						schedule_time_interval_command(*measurementTimeCommand);
+					}
+					else
+					{
+						// Due in a later turn of the wheel
+						slot.push_back(measurementTimeCommand);
 					}
 				}
+				measurementTimerWheelSlotBeingProcessed.clear();
+			}
+		}
+	}
 
-				if (transmitSuccessful)
+	void TaskControllerClient::process_published_values()
+	{
+		{
+			LOCK_GUARD(Mutex, publishedValuesMutex);
+			publishedValuesBeingProcessed.swap(pendingPublishedValues);
+		}
+
+		for (const auto &newValue : publishedValuesBeingProcessed)
+		{
+			auto result = publishedValues.find(newValue.first);
+
+			if (publishedValues.end() == result)
+			{
+				PublishedValueInfo publishedValue = { newValue.second, nullptr, nullptr, nullptr, false };
+				auto &insertedValue = publishedValues.emplace(newValue.first, publishedValue).first->second;
+
+				// Threshold commands the TC already set for this variable don't need to be polled anymore
+				for (auto &measurementMaxCommand : measurementMaximumThresholdCommands)
+				{
+					if (newValue.first == get_published_value_key(measurementMaxCommand.elementNumber, measurementMaxCommand.ddi))
+					{
+						measurementMaxCommand.valueIsPublished = true;
+						insertedValue.maximumThresholdCommand = &measurementMaxCommand;
+					}
+				}
+				for (auto &measurementMinCommand : measurementMinimumThresholdCommands)
+				{
+					if (newValue.first == get_published_value_key(measurementMinCommand.elementNumber, measurementMinCommand.ddi))
+					{
+						measurementMinCommand.valueIsPublished = true;
+						insertedValue.minimumThresholdCommand = &measurementMinCommand;
+					}
+				}
+				for (auto &measurementChangeCommand : measurementOnChangeThresholdCommands)
 				{
-					measurementTimeCommand.lastValue = static_cast<std::int32_t>(SystemTiming::get_timestamp_ms());
+					if (newValue.first == get_published_value_key(measurementChangeCommand.elementNumber, measurementChangeCommand.ddi))
+					{
+						measurementChangeCommand.valueIsPublished = true;
+						insertedValue.changeThresholdCommand = &measurementChangeCommand;
+					}
 				}
+				mark_published_value_changed(insertedValue);
+			}
+			else if (newValue.second != result->second.value)
+			{
+				result->second.value = newValue.second;
+				mark_published_value_changed(result->second);
 			}
 		}
-		for (auto &measurementMaxCommand : measurementMaximumThresholdCommands)
+		publishedValuesBeingProcessed.clear();
+
+		// Values whose threshold sends failed stay in the list so they're retried on the next update
+		std::size_t numberOfUnsentValues = 0;
+		for (std::size_t i = 0; i < changedPublishedValues.size(); i++)
 		{
-			// Get the current process data value
-			std::int32_t newValue = 0;
-			for (auto &currentCallback : requestValueCallbacks)
+			auto publishedValue = changedPublishedValues[i];
+			bool allSent = true;
+
+			if (nullptr != publishedValue->maximumThresholdCommand)
 			{
-				if (currentCallback.callback(measurementMaxCommand.elementNumber, measurementMaxCommand.ddi, newValue, currentCallback.parent))
-				{
-					break;
-				}
+				allSent = process_threshold_command(ProcessDataCommands::MeasurementMaximumWithinThreshold, *publishedValue->maximumThresholdCommand, publishedValue->value) && allSent;
+			}
+			if (nullptr != publishedValue->minimumThresholdCommand)
+			{
+				allSent = process_threshold_command(ProcessDataCommands::MeasurementMinimumWithinThreshold, *publishedValue->minimumThresholdCommand, publishedValue->value) && allSent;
+			}
+			if (nullptr != publishedValue->changeThresholdCommand)
+			{
+				allSent = process_threshold_command(ProcessDataCommands::MeasurementChangeThreshold, *publishedValue->changeThresholdCommand, publishedValue->value) && allSent;
 			}
 
-			if (!measurementMaxCommand.thresholdPassed)
+			if (allSent)
 			{
-				if ((newValue > measurementMaxCommand.processDataValue) &&
-				    (send_value_command(measurementMaxCommand.elementNumber, measurementMaxCommand.ddi, newValue)))
-				{
-					measurementMaxCommand.thresholdPassed = true;
-				}
+				publishedValue->changed = false;
 			}
 			else
 			{
-				if (newValue < measurementMaxCommand.processDataValue)
-				{
-					measurementMaxCommand.thresholdPassed = false;
-				}
+				changedPublishedValues[numberOfUnsentValues] = publishedValue;
+				numberOfUnsentValues++;
 			}
 		}
-		for (auto &measurementMinCommand : measurementMinimumThresholdCommands)
+		changedPublishedValues.resize(numberOfUnsentValues);
+	}
+
+	std::uint32_t TaskControllerClient::get_published_value_key(std::uint16_t elementNumber, std::uint16_t DDI)
+	{
+		return ((static_cast<std::uint32_t>(elementNumber) << 16) | DDI);
+	}
+
+	bool TaskControllerClient::get_process_data_value(std::uint16_t elementNumber, std::uint16_t DDI, std::int32_t &value)
+	{
+		bool retVal = false;
+		auto result = publishedValues.find(get_published_value_key(elementNumber, DDI));
+
+		if (publishedValues.end() != result)
+		{
+			value = result->second.value;
+			retVal = true;
+		}
+		else
 		{
-			// Get the current process data value
-			std::int32_t newValue = 0;
 			for (auto &currentCallback : requestValueCallbacks)
 			{
-				if (currentCallback.callback(measurementMinCommand.elementNumber, measurementMinCommand.ddi, newValue, currentCallback.parent))
+				if (currentCallback.callback(elementNumber, DDI, value, currentCallback.parent))
 				{
+					retVal = true;
 					break;
 				}
 			}
+		}
+		return retVal;
+	}
 
-			if (!measurementMinCommand.thresholdPassed)
+	bool TaskControllerClient::process_threshold_command(ProcessDataCommands commandType, ProcessDataCallbackInfo &command, std::int32_t newValue)
+	{
+		bool retVal = true;
+
+		switch (commandType)
+		{
+			case ProcessDataCommands::MeasurementMaximumWithinThreshold:
 			{
-				if ((newValue < measurementMinCommand.processDataValue) &&
-				    (send_value_command(measurementMinCommand.elementNumber, measurementMinCommand.ddi, newValue)))
+				if (!command.thresholdPassed)
 				{
-					measurementMinCommand.thresholdPassed = true;
+					if (newValue > command.processDataValue)
+					{
+						command.thresholdPassed = send_value_command(command.elementNumber, command.ddi, newValue);
+						retVal = command.thresholdPassed;
+					}
 				}
-			}
-			else
-			{
-				if (newValue > measurementMinCommand.processDataValue)
+				else
 				{
-					measurementMinCommand.thresholdPassed = false;
+					if (newValue < command.processDataValue)
+					{
+						command.thresholdPassed = false;
+					}
 				}
 			}
-		}
-		for (auto &measurementChangeCommand : measurementOnChangeThresholdCommands)
-		{
-			// Get the current process data value
-			std::int32_t newValue = 0;
-			for (auto &currentCallback : requestValueCallbacks)
+			break;
+
+			case ProcessDataCommands::MeasurementMinimumWithinThreshold:
 			{
-				if (currentCallback.callback(measurementChangeCommand.elementNumber, measurementChangeCommand.ddi, newValue, currentCallback.parent))
+				if (!command.thresholdPassed)
 				{
-					break;
+					if (newValue < command.processDataValue)
+					{
+						command.thresholdPassed = send_value_command(command.elementNumber, command.ddi, newValue);
+						retVal = command.thresholdPassed;
+					}
+				}
+				else
+				{
+					if (newValue > command.processDataValue)
+					{
+						command.thresholdPassed = false;
+					}
 				}
 			}
+			break;
 
-			std::int64_t lowerLimit = (static_cast<int64_t>(measurementChangeCommand.lastValue) - measurementChangeCommand.processDataValue);
-			if (lowerLimit < 0)
+			case ProcessDataCommands::MeasurementChangeThreshold:
 			{
-				lowerLimit = 0;
+				std::int64_t lowerLimit = (static_cast<int64_t>(command.lastValue) - command.processDataValue);
+				if (lowerLimit < 0)
+				{
+					lowerLimit = 0;
+				}
+
+				if ((newValue != command.lastValue) &&
+				    ((newValue >= (command.lastValue + command.processDataValue)) ||
+				     (newValue <= lowerLimit)))
+				{
+					if (send_value_command(command.elementNumber, command.ddi, newValue))
+					{
+						command.lastValue = newValue;
+					}
+					else
+					{
+						retVal = false;
+					}
+				}
 			}
+			break;
 
-			if ((newValue != measurementChangeCommand.lastValue) &&
-			    ((newValue >= (measurementChangeCommand.lastValue + measurementChangeCommand.processDataValue)) ||
-			     (newValue <= lowerLimit)))
+			default:
+				break;
+		}
+		return retVal;
+	}
+
+	void TaskControllerClient::link_threshold_command_to_published_value(ProcessDataCommands commandType, ProcessDataCallbackInfo &command)
+	{
+		auto result = publishedValues.find(get_published_value_key(command.elementNumber, command.ddi));
+
+		if (publishedValues.end() != result)
+		{
+			command.valueIsPublished = true;
+
+			switch (commandType)
 			{
-				if (send_value_command(measurementChangeCommand.elementNumber, measurementChangeCommand.ddi, newValue))
+				case ProcessDataCommands::MeasurementMaximumWithinThreshold:
 				{
-					measurementChangeCommand.lastValue = newValue;
+					result->second.maximumThresholdCommand = &command;
 				}
+				break;
+
+				case ProcessDataCommands::MeasurementMinimumWithinThreshold:
+				{
+					result->second.minimumThresholdCommand = &command;
+				}
+				break;
+
+				case ProcessDataCommands::MeasurementChangeThreshold:
+				{
+					result->second.changeThresholdCommand = &command;
+				}
+				break;
+
+				default:
+					break;
+			}
+
+			// Check the new threshold against the current value on the next update, like a polled one would be
+			mark_published_value_changed(result->second);
+		}
+	}
+
+	void TaskControllerClient::mark_published_value_changed(PublishedValueInfo &publishedValue)
+	{
+		if (!publishedValue.changed)
+		{
+			publishedValue.changed = true;
+			changedPublishedValues.push_back(&publishedValue);
+		}
+	}
+
+	void TaskControllerClient::schedule_time_interval_command(ProcessDataCallbackInfo &command)
+	{
+		std::uint32_t dueTimestamp_ms = static_cast<std::uint32_t>(command.lastValue) + static_cast<std::uint32_t>(command.processDataValue);
+
+		if (static_cast<std::int32_t>(dueTimestamp_ms - measurementTimerWheelTimestamp_ms) <= 0)
+		{
+			// Already due, so it goes in the next slot the wheel will process
+			dueTimestamp_ms = measurementTimerWheelTimestamp_ms + 1;
+		}
+		measurementTimerWheel[dueTimestamp_ms % MEASUREMENT_TIMER_WHEEL_SLOTS].push_back(&command);
+	}
+
+	void TaskControllerClient::unschedule_time_interval_command(const ProcessDataCallbackInfo &command)
+	{
+		for (auto &slot : measurementTimerWheel)
+		{
+			auto scheduledCommand = std::find(slot.begin(), slot.end(), &command);
+
+			if (slot.end() != scheduledCommand)
+			{
+				slot.erase(scheduledCommand);
+				break;
 			}
 		}
 	}
@@ -1559,7 +1801,7 @@ namespace isobus
 
 						case ProcessDataCommands::RequestValue:
 						{
-							ProcessDataCallbackInfo requestData = { 0, 0, 0, 0, false, false };
+							ProcessDataCallbackInfo requestData = { 0, 0, 0, 0, false, false, false };
 							LOCK_GUARD(Mutex, clientMutex);
 
 							requestData.ackRequested = false;
@@ -1576,7 +1818,7 @@ namespace isobus
 
 						case ProcessDataCommands::Value:
 						{
-							ProcessDataCallbackInfo requestData = { 0, 0, 0, 0, false, false };
+							ProcessDataCallbackInfo requestData = { 0, 0, 0, 0, false, false, false };
 							LOCK_GUARD(Mutex, clientMutex);
 
 							requestData.ackRequested = false;
@@ -1593,7 +1835,7 @@ namespace isobus
 
 						case ProcessDataCommands::SetValueAndAcknowledge:
 						{
-							ProcessDataCallbackInfo requestData = { 0, 0, 0, 0, false, false };
+							ProcessDataCallbackInfo requestData = { 0, 0, 0, 0, false, false, false };
 							LOCK_GUARD(Mutex, clientMutex);
 
 							requestData.ackRequested = true;
@@ -1610,7 +1852,7 @@ namespace isobus
 
 						case ProcessDataCommands::MeasurementTimeInterval:
 						{
-							ProcessDataCallbackInfo commandData = { 0, 0, 0, 0, false, false };
+							ProcessDataCallbackInfo commandData = { 0, 0, 0, 0, false, false, false };
 							LOCK_GUARD(Mutex, clientMutex);
 
 							commandData.elementNumber = (static_cast<std::uint16_t>(messageData[0] >> 4) | (static_cast<std::uint16_t>(messageData[1]) << 4));
@@ -1626,6 +1868,7 @@ namespace isobus
 							if (parentTC->measurementTimeIntervalCommands.end() == previousCommand)
 							{
 								parentTC->measurementTimeIntervalCommands.push_back(commandData);
+								parentTC->schedule_time_interval_command(parentTC->measurementTimeIntervalCommands.back());
 								LOG_DEBUG("[TC]: TC Requests element: " +
 								          isobus::to_string(static_cast<int>(commandData.elementNumber)) +
 								          " DDI: " +
@@ -1637,7 +1880,9 @@ namespace isobus
 							else
 							{
 								// Use the existing one and update the value
+								parentTC->unschedule_time_interval_command(*previousCommand);
 								previousCommand->processDataValue = commandData.processDataValue;
+								parentTC->schedule_time_interval_command(*previousCommand);
 								LOG_DEBUG("[TC]: TC Altered time interval request for element: " +
 								          isobus::to_string(static_cast<int>(commandData.elementNumber)) +
 								          " DDI: " +
@@ -1651,7 +1896,7 @@ namespace isobus
 
 						case ProcessDataCommands::MeasurementMaximumWithinThreshold:
 						{
-							ProcessDataCallbackInfo commandData = { 0, 0, 0, 0, false, false };
+							ProcessDataCallbackInfo commandData = { 0, 0, 0, 0, false, false, false };
 							LOCK_GUARD(Mutex, clientMutex);
 
 							commandData.elementNumber = (static_cast<std::uint16_t>(messageData[0] >> 4) | (static_cast<std::uint16_t>(messageData[1]) << 4));
@@ -1666,6 +1911,7 @@ namespace isobus
 							if (parentTC->measurementMaximumThresholdCommands.end() == previousCommand)
 							{
 								parentTC->measurementMaximumThresholdCommands.push_back(commandData);
+								parentTC->link_threshold_command_to_published_value(ProcessDataCommands::MeasurementMaximumWithinThreshold, parentTC->measurementMaximumThresholdCommands.back());
 								LOG_DEBUG("[TC]: TC Requests element: " +
 								          isobus::to_string(static_cast<int>(commandData.elementNumber)) +
 								          " DDI: " +
@@ -1678,13 +1924,14 @@ namespace isobus
 								// Just update the existing one with the new value
 								previousCommand->processDataValue = commandData.processDataValue;
 								previousCommand->thresholdPassed = false;
+								parentTC->link_threshold_command_to_published_value(ProcessDataCommands::MeasurementMaximumWithinThreshold, *previousCommand);
 							}
 						}
 						break;
 
 						case ProcessDataCommands::MeasurementMinimumWithinThreshold:
 						{
-							ProcessDataCallbackInfo commandData = { 0, 0, 0, 0, false, false };
+							ProcessDataCallbackInfo commandData = { 0, 0, 0, 0, false, false, false };
 							LOCK_GUARD(Mutex, clientMutex);
 
 							commandData.elementNumber = (static_cast<std::uint16_t>(messageData[0] >> 4) | (static_cast<std::uint16_t>(messageData[1]) << 4));
@@ -1699,6 +1946,7 @@ namespace isobus
 							if (parentTC->measurementMinimumThresholdCommands.end() == previousCommand)
 							{
 								parentTC->measurementMinimumThresholdCommands.push_back(commandData);
+								parentTC->link_threshold_command_to_published_value(ProcessDataCommands::MeasurementMinimumWithinThreshold, parentTC->measurementMinimumThresholdCommands.back());
 								LOG_DEBUG("[TC]: TC Requests Element " +
 								          isobus::to_string(static_cast<int>(commandData.elementNumber)) +
 								          " DDI: " +
@@ -1711,13 +1959,14 @@ namespace isobus
 								// Just update the existing one with the new value
 								previousCommand->processDataValue = commandData.processDataValue;
 								previousCommand->thresholdPassed = false;
+								parentTC->link_threshold_command_to_published_value(ProcessDataCommands::MeasurementMinimumWithinThreshold, *previousCommand);
 							}
 						}
 						break;
 
 						case ProcessDataCommands::MeasurementChangeThreshold:
 						{
-							ProcessDataCallbackInfo commandData = { 0, 0, 0, 0, false, false };
+							ProcessDataCallbackInfo commandData = { 0, 0, 0, 0, false, false, false };
 							LOCK_GUARD(Mutex, clientMutex);
 
 							commandData.elementNumber = (static_cast<std::uint16_t>(messageData[0] >> 4) | (static_cast<std::uint16_t>(messageData[1]) << 4));
@@ -1732,6 +1981,7 @@ namespace isobus
 							if (parentTC->measurementOnChangeThresholdCommands.end() == previousCommand)
 							{
 								parentTC->measurementOnChangeThresholdCommands.push_back(commandData);
+								parentTC->link_threshold_command_to_published_value(ProcessDataCommands::MeasurementChangeThreshold, parentTC->measurementOnChangeThresholdCommands.back());
 								LOG_DEBUG("[TC]: TC Requests element " +
 								          isobus::to_string(static_cast<int>(commandData.elementNumber)) +
 								          " DDI: " +
@@ -1744,6 +1994,7 @@ namespace isobus
 								// Just update the existing one with the new value
 								previousCommand->processDataValue = commandData.processDataValue;
 								previousCommand->thresholdPassed = false;
+								parentTC->link_threshold_command_to_published_value(ProcessDataCommands::MeasurementChangeThreshold, *previousCommand);
 							}
 						}
 						break;
@@ -2150,7 +2401,7 @@ namespace isobus
 
 	void TaskControllerClient::on_value_changed_trigger(std::uint16_t elementNumber, std::uint16_t DDI)
 	{
-		ProcessDataCallbackInfo requestData = { 0, 0, 0, 0, false, false };
+		ProcessDataCallbackInfo requestData = { 0, 0, 0, 0, false, false, false };
 		LOCK_GUARD(Mutex, clientMutex);
 
 		requestData.ackRequested = false;
@@ -2160,6 +2411,12 @@ namespace isobus
 		queuedValueRequests.push_back(requestData);
 	}
 
+	void TaskControllerClient::publish_process_data_value(std::uint16_t elementNumber, std::uint16_t DDI, std::int32_t value)
+	{
+		LOCK_GUARD(Mutex, publishedValuesMutex);
+		pendingPublishedValues.emplace_back(get_published_value_key(elementNumber, DDI), value);
+	}
+
 	bool TaskControllerClient::request_task_controller_identification() const
 	{
 		constexpr std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(ProcessDataCommands::TechnicalCapabilities) |
@@ -14,13 +14,14 @@
 #include <algorithm>
 #include <array>
 #include <cstring>
+#include <utility>
 
 namespace isobus
 {
 	namespace task_controller_object
 	{
 		Object::Object(std::string objectDesignator, std::uint16_t uniqueID) :
-		  designator(objectDesignator),
+		  designator(std::move(objectDesignator)),
 		  objectID(uniqueID)
 		{
 		}
@@ -40,9 +41,20 @@ namespace isobus
 			return objectID;
 		}
 
+		std::atomic<std::uint32_t> Object::objectIDChangeCount = { 0 };
+
 		void Object::set_object_id(std::uint16_t id)
 		{
-			objectID = id;
+			if (id != objectID)
+			{
+				objectID = id;
+				objectIDChangeCount++;
+			}
+		}
+
+		std::uint32_t Object::get_object_id_change_count()
+		{
+			return objectIDChangeCount;
 		}
 
 		const std::string DeviceObject::tableID = "DVC";
@@ -55,12 +67,12 @@ namespace isobus
 		                           std::vector<std::uint8_t> deviceExtendedStructureLabel,
 		                           std::uint64_t clientIsoNAME,
 		                           bool shouldUseExtendedStructureLabel) :
-		  Object(deviceDesignator, 0),
-		  serialNumber(deviceSerialNumber),
-		  softwareVersion(deviceSoftwareVersion),
-		  structureLabel(deviceStructureLabel),
+		  Object(std::move(deviceDesignator), 0),
+		  serialNumber(std::move(deviceSerialNumber)),
+		  softwareVersion(std::move(deviceSoftwareVersion)),
+		  structureLabel(std::move(deviceStructureLabel)),
 		  localizationLabel(deviceLocalizationLabel),
-		  extendedStructureLabel(deviceExtendedStructureLabel),
+		  extendedStructureLabel(std::move(deviceExtendedStructureLabel)),
 		  NAME(clientIsoNAME),
 		  useExtendedStructureLabel(shouldUseExtendedStructureLabel)
 		{
@@ -224,7 +236,7 @@ namespace isobus
 		                                         std::uint16_t parentObjectID,
 		                                         Type deviceEelementType,
 		                                         std::uint16_t uniqueID) :
-		  Object(deviceElementDesignator, uniqueID),
+		  Object(std::move(deviceElementDesignator), uniqueID),
 		  elementNumber(deviceElementNumber),
 		  parentObject(parentObjectID),
 		  elementType(deviceEelementType)
@@ -342,7 +354,7 @@ namespace isobus
 		                                                 std::uint8_t processDataProperties,
 		                                                 std::uint8_t processDataTriggerMethods,
 		                                                 std::uint16_t uniqueID) :
-		  Object(processDataDesignator, uniqueID),
+		  Object(std::move(processDataDesignator), uniqueID),
 		  ddi(processDataDDI),
 		  deviceValuePresentationObject(deviceValuePresentationObjectID),
 		  propertiesBitfield(processDataProperties),
@@ -432,7 +444,7 @@ namespace isobus
 		                                           std::uint16_t propertyDDI,
 		                                           std::uint16_t valuePresentationObject,
 		                                           std::uint16_t uniqueID) :
-		  Object(propertyDesignator, uniqueID),
+		  Object(std::move(propertyDesignator), uniqueID),
 		  value(propertyValue),
 		  ddi(propertyDDI),
 		  deviceValuePresentationObject(valuePresentationObject)
@@ -513,7 +525,7 @@ namespace isobus
 		                                                             float scaleFactor,
 		                                                             std::uint8_t numberDecimals,
 		                                                             std::uint16_t uniqueID) :
-		  Object(unitDesignator, uniqueID),
+		  Object(std::move(unitDesignator), uniqueID),
 		  offset(offsetValue),
 		  scale(scaleFactor),
 		  numberOfDecimals(numberDecimals)
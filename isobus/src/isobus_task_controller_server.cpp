@@ -15,7 +15,11 @@
 #include "isobus/isobus/can_stack_logger.hpp"
 #include "isobus/utility/system_timing.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <set>
+#include <utility>
 
 namespace isobus
 {
@@ -38,6 +42,9 @@ namespace isobus
 	TaskControllerServer::~TaskControllerServer()
 	{
 		terminate();
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+		stop_worker_threads();
+#endif
 	}
 
 	bool TaskControllerServer::send_request_value(std::shared_ptr<ControlFunction> clientControlFunction, std::uint16_t dataDescriptionIndex, std::uint16_t elementNumber) const
@@ -93,6 +100,49 @@ namespace isobus
 		return send_measurement_command(clientControlFunction, static_cast<std::uint8_t>(ProcessDataCommands::Value), dataDescriptionIndex, elementNumber, processDataValue);
 	}
 
+	std::size_t TaskControllerServer::send_process_data_commands(const std::vector<ClientProcessDataCommand> &commands) const
+	{
+		std::size_t retVal = 0;
+		std::vector<bool> isCoalesced(commands.size(), false);
+		std::set<std::pair<const ControlFunction *, std::uint32_t>> newerCommands;
+
+		// Walk backwards so the last command for each client, DDI, element and command type is the one that's kept
+		for (std::size_t i = commands.size(); i > 0; i--)
+		{
+			const auto &command = commands[i - 1];
+			const std::uint32_t key = ((static_cast<std::uint32_t>(command.command) << 28) |
+			                           (static_cast<std::uint32_t>(command.elementNumber & 0x0FFF) << 16) |
+			                           command.dataDescriptionIndex);
+
+			isCoalesced[i - 1] = !newerCommands.emplace(command.clientControlFunction.get(), key).second;
+		}
+
+		for (std::size_t i = 0; i < commands.size(); i++)
+		{
+			const auto &command = commands[i];
+			bool sent = false;
+
+			if (isCoalesced[i])
+			{
+				// A later command in the list replaces this one
+			}
+			else if (ProcessDataCommands::RequestValue == command.command)
+			{
+				sent = send_request_value(command.clientControlFunction, command.dataDescriptionIndex, command.elementNumber);
+			}
+			else
+			{
+				sent = send_measurement_command(command.clientControlFunction, static_cast<std::uint8_t>(command.command), command.dataDescriptionIndex, command.elementNumber, command.processDataValue);
+			}
+
+			if (sent)
+			{
+				retVal++;
+			}
+		}
+		return retVal;
+	}
+
 	void TaskControllerServer::set_task_totals_active(bool isTaskActive)
 	{
 		if (isTaskActive != get_task_totals_active())
@@ -108,6 +158,40 @@ namespace isobus
 		return (0 != (currentStatusByte & static_cast<std::uint8_t>(ServerStatusBit::TaskTotalsActive)));
 	}
 
+	bool TaskControllerServer::set_number_of_worker_threads(std::uint8_t numberOfThreads)
+	{
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+		if (numberOfThreads != workerThreads.size())
+		{
+			stop_worker_threads();
+
+			std::uint32_t initialGeneration;
+			{
+				const std::lock_guard<std::mutex> lock(workerMutex);
+				workersRunning = true;
+				initialGeneration = workerGeneration;
+			}
+
+			for (std::uint8_t i = 0; i < numberOfThreads; i++)
+			{
+				workerThreads.emplace_back(&TaskControllerServer::worker_thread_function, this, initialGeneration);
+			}
+		}
+		return true;
+#else
+		return 0 == numberOfThreads;
+#endif
+	}
+
+	std::uint8_t TaskControllerServer::get_number_of_worker_threads() const
+	{
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+		return static_cast<std::uint8_t>(workerThreads.size());
+#else
+		return 0;
+#endif
+	}
+
 	void TaskControllerServer::initialize()
 	{
 		if (!initialized)
@@ -157,13 +241,15 @@ namespace isobus
 		}
 
 		// Remove any clients that have timed out.
+		LOCK_GUARD(Mutex, activeClientsMutex);
 		activeClients.erase(std::remove_if(activeClients.begin(),
 		                                   activeClients.end(),
-		                                   [](std::shared_ptr<ActiveClient> clientInfo) {
+		                                   [this](std::shared_ptr<ActiveClient> clientInfo) {
 			                                   constexpr std::uint32_t CLIENT_TASK_TIMEOUT_MS = 6000;
 			                                   if (SystemTiming::time_expired_ms(clientInfo->lastStatusMessageTimestamp_ms, CLIENT_TASK_TIMEOUT_MS))
 			                                   {
 				                                   LOG_WARNING("[TC Server]: Client 0x%02X has timed out. Removing from active client list.", clientInfo->clientControlFunction->get_address());
+				                                   activeClientIndex[clientInfo->clientControlFunction->get_can_port()].erase(clientInfo->clientControlFunction->get_NAME().get_full_name());
 				                                   return true;
 			                                   }
 			                                   return false;
@@ -194,521 +280,671 @@ namespace isobus
 
 	void TaskControllerServer::process_rx_messages()
 	{
+		{
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
-		const std::lock_guard<std::mutex> lock(messagesMutex);
+			const std::lock_guard<std::mutex> lock(messagesMutex);
 #endif
-		while (!rxMessageQueue.empty())
+			// Take the whole queue so the CAN stack can keep queueing messages while they're processed
+			std::swap(rxMessageQueue, messagesBeingProcessed);
+		}
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+		if (!workerThreads.empty())
 		{
-			const auto &rxMessage = rxMessageQueue.front();
-			auto &rxData = rxMessage.get_data();
+			process_rx_messages_on_workers();
+		}
+		else
+#endif
+		{
+			for (const auto &rxMessage : messagesBeingProcessed)
+			{
+				process_rx_message(rxMessage);
+			}
+		}
+		messagesBeingProcessed.clear();
+	}
 
-			switch (rxMessage.get_identifier().get_parameter_group_number())
+	void TaskControllerServer::process_rx_message(const CANMessage &rxMessage)
+	{
+		auto &rxData = rxMessage.get_data();
+
+		switch (rxMessage.get_identifier().get_parameter_group_number())
+		{
+			case static_cast<std::uint32_t>(CANLibParameterGroupNumber::ProcessData):
 			{
-				case static_cast<std::uint32_t>(CANLibParameterGroupNumber::ProcessData):
+				switch (static_cast<ProcessDataCommands>(rxData[0] & 0x0F))
 				{
-					switch (static_cast<ProcessDataCommands>(rxData[0] & 0x0F))
+					case ProcessDataCommands::TechnicalCapabilities:
 					{
-						case ProcessDataCommands::TechnicalCapabilities:
+						if ((rxData[0] >> 4) <= static_cast<std::uint8_t>(TechnicalDataCommandParameters::IdentifyTaskController))
 						{
-							if ((rxData[0] >> 4) <= static_cast<std::uint8_t>(TechnicalDataCommandParameters::IdentifyTaskController))
+							switch (static_cast<TechnicalDataCommandParameters>(rxData[0] >> 4))
 							{
-								switch (static_cast<TechnicalDataCommandParameters>(rxData[0] >> 4))
+								case TechnicalDataCommandParameters::RequestVersion:
 								{
-									case TechnicalDataCommandParameters::RequestVersion:
+									if (serverControlFunction == rxMessage.get_destination_control_function())
 									{
-										if (serverControlFunction == rxMessage.get_destination_control_function())
-										{
-											send_version(rxMessage.get_source_control_function());
-											send_generic_process_data_default_payload(static_cast<std::uint8_t>(TechnicalDataCommandParameters::RequestVersion), rxMessage.get_source_control_function());
-										}
+										send_version(rxMessage.get_source_control_function());
+										send_generic_process_data_default_payload(static_cast<std::uint8_t>(TechnicalDataCommandParameters::RequestVersion), rxMessage.get_source_control_function());
 									}
-									break;
+								}
+								break;
 
-									case TechnicalDataCommandParameters::ParameterVersion:
+								case TechnicalDataCommandParameters::ParameterVersion:
+								{
+									if (CAN_DATA_LENGTH == rxMessage.get_data_length())
 									{
-										if (CAN_DATA_LENGTH == rxMessage.get_data_length())
-										{
-											// Not sure if we care about this one, since we'll treat clients the same regardless.
-											LOG_DEBUG("[TC Server]: Client reports that its version is %u", rxData[1]);
-										}
+										// Not sure if we care about this one, since we'll treat clients the same regardless.
+										LOG_DEBUG("[TC Server]: Client reports that its version is %u", rxData[1]);
 									}
-									break;
+								}
+								break;
 
-									case TechnicalDataCommandParameters::IdentifyTaskController:
+								case TechnicalDataCommandParameters::IdentifyTaskController:
+								{
+									LOG_INFO("[TC Server]: Received identify task controller command from 0x%02X. We are TC number %u", rxMessage.get_source_control_function()->get_address(), serverControlFunction->get_NAME().get_function_instance());
+									if (serverControlFunction == rxMessage.get_destination_control_function())
 									{
-										LOG_INFO("[TC Server]: Received identify task controller command from 0x%02X. We are TC number %u", rxMessage.get_source_control_function()->get_address(), serverControlFunction->get_NAME().get_function_instance());
-										if (serverControlFunction == rxMessage.get_destination_control_function())
-										{
-											send_generic_process_data_default_payload(rxData[0], rxMessage.get_source_control_function());
-											identify_task_controller(serverControlFunction->get_NAME().get_function_instance() + 1);
-										}
-										else
-										{
-											// No response needed for a global request.
-											identify_task_controller(serverControlFunction->get_NAME().get_function_instance() + 1);
-										}
+										send_generic_process_data_default_payload(rxData[0], rxMessage.get_source_control_function());
+										identify_task_controller(serverControlFunction->get_NAME().get_function_instance() + 1);
+									}
+									else
+									{
+										// No response needed for a global request.
+										identify_task_controller(serverControlFunction->get_NAME().get_function_instance() + 1);
 									}
-									break;
 								}
+								break;
 							}
-							else
-							{
-								LOG_WARNING("[TC Server]: Unknown technical capabilities command received: 0x%02X", rxData[0]);
-							}
 						}
-						break;
+						else
+						{
+							LOG_WARNING("[TC Server]: Unknown technical capabilities command received: 0x%02X", rxData[0]);
+						}
+					}
+					break;
 
-						case ProcessDataCommands::DeviceDescriptor:
+					case ProcessDataCommands::DeviceDescriptor:
+					{
+						if ((rxData[0] >> 4) <= static_cast<std::uint8_t>(DeviceDescriptorCommandParameters::ChangeDesignatorResponse))
 						{
-							if ((rxData[0] >> 4) <= static_cast<std::uint8_t>(DeviceDescriptorCommandParameters::ChangeDesignatorResponse))
+							if ((rxMessage.get_data_length() >= CAN_DATA_LENGTH) &&
+							    (nullptr != rxMessage.get_source_control_function()) &&
+							    (nullptr != rxMessage.get_destination_control_function()))
 							{
-								if ((rxMessage.get_data_length() >= CAN_DATA_LENGTH) &&
-								    (nullptr != rxMessage.get_source_control_function()) &&
-								    (nullptr != rxMessage.get_destination_control_function()))
+								switch (static_cast<DeviceDescriptorCommandParameters>(rxData[0] >> 4))
 								{
-									switch (static_cast<DeviceDescriptorCommandParameters>(rxData[0] >> 4))
+									case DeviceDescriptorCommandParameters::RequestStructureLabel:
 									{
-										case DeviceDescriptorCommandParameters::RequestStructureLabel:
+										if (nullptr != get_active_client(rxMessage.get_source_control_function()))
 										{
-											if (nullptr != get_active_client(rxMessage.get_source_control_function()))
-											{
-												std::vector<std::uint8_t> structureLabel;
-												std::vector<std::uint8_t> extendedStructureLabel;
+											std::vector<std::uint8_t> structureLabel;
+											std::vector<std::uint8_t> extendedStructureLabel;
 
-												for (std::uint8_t i = 0; i < CAN_DATA_LENGTH - 1; i++)
-												{
-													structureLabel.push_back(rxData[i + 1]);
-												}
+											for (std::uint8_t i = 0; i < CAN_DATA_LENGTH - 1; i++)
+											{
+												structureLabel.push_back(rxData[i + 1]);
+											}
 
-												if (rxMessage.get_data_length() > CAN_DATA_LENGTH)
+											if (rxMessage.get_data_length() > CAN_DATA_LENGTH)
+											{
+												// If the length is greater than 8, then an extended label is being requested.
+												for (std::size_t i = 0; i < (rxMessage.get_data_length() - CAN_DATA_LENGTH); i++)
 												{
-													// If the length is greater than 8, then an extended label is being requested.
-													for (std::size_t i = 0; i < (rxMessage.get_data_length() - CAN_DATA_LENGTH); i++)
-													{
-														extendedStructureLabel.push_back(rxData[CAN_DATA_LENGTH + i]);
-													}
+													extendedStructureLabel.push_back(rxData[CAN_DATA_LENGTH + i]);
 												}
+											}
 
-												if (get_is_stored_device_descriptor_object_pool_by_structure_label(rxMessage.get_source_control_function(), structureLabel, extendedStructureLabel))
-												{
-													LOG_INFO("[TC Server]:Client 0x%02X structure label(s) matched.", rxMessage.get_source_control_function()->get_address());
-													send_structure_label(rxMessage.get_source_control_function(), structureLabel, extendedStructureLabel);
-												}
-												else
-												{
-													// No object pool found. Send FFs as the structure label.
-													LOG_INFO("[TC Server]:Client 0x%02X structure label(s) did not match. Sending 0xFFs as the structure label.", rxMessage.get_source_control_function()->get_address());
-													send_generic_process_data_default_payload((static_cast<std::uint8_t>(ProcessDataCommands::DeviceDescriptor) | (static_cast<std::uint8_t>(DeviceDescriptorCommandParameters::StructureLabel) << 4)), rxMessage.get_source_control_function());
-												}
+											if (get_is_stored_device_descriptor_object_pool_by_structure_label(rxMessage.get_source_control_function(), structureLabel, extendedStructureLabel))
+											{
+												LOG_INFO("[TC Server]:Client 0x%02X structure label(s) matched.", rxMessage.get_source_control_function()->get_address());
+												send_structure_label(rxMessage.get_source_control_function(), structureLabel, extendedStructureLabel);
 											}
 											else
 											{
-												nack_process_data_command(rxMessage.get_source_control_function());
+												// No object pool found. Send FFs as the structure label.
+												LOG_INFO("[TC Server]:Client 0x%02X structure label(s) did not match. Sending 0xFFs as the structure label.", rxMessage.get_source_control_function()->get_address());
+												send_generic_process_data_default_payload((static_cast<std::uint8_t>(ProcessDataCommands::DeviceDescriptor) | (static_cast<std::uint8_t>(DeviceDescriptorCommandParameters::StructureLabel) << 4)), rxMessage.get_source_control_function());
 											}
 										}
-										break;
+										else
+										{
+											nack_process_data_command(rxMessage.get_source_control_function());
+										}
+									}
+									break;
 
-										case DeviceDescriptorCommandParameters::RequestLocalizationLabel:
+									case DeviceDescriptorCommandParameters::RequestLocalizationLabel:
+									{
+										if (nullptr != get_active_client(rxMessage.get_source_control_function()))
 										{
-											if (nullptr != get_active_client(rxMessage.get_source_control_function()))
+											const std::array<std::uint8_t, 7> localizationLabel = { rxData.at(1), rxData.at(2), rxData.at(3), rxData.at(4), rxData.at(5), rxData.at(6), rxData.at(7) };
+											if (get_is_stored_device_descriptor_object_pool_by_localization_label(rxMessage.get_source_control_function(), localizationLabel))
 											{
-												const std::array<std::uint8_t, 7> localizationLabel = { rxData.at(1), rxData.at(2), rxData.at(3), rxData.at(4), rxData.at(5), rxData.at(6), rxData.at(7) };
-												if (get_is_stored_device_descriptor_object_pool_by_localization_label(rxMessage.get_source_control_function(), localizationLabel))
-												{
-													LOG_INFO("[TC Server]:Client 0x%02X localization label matched.", rxMessage.get_source_control_function()->get_address());
-													send_localization_label(rxMessage.get_source_control_function(), localizationLabel);
-												}
-												else
-												{
-													// No object pool found. Send FFs as the localization label.
-													LOG_INFO("[TC Server]: No object pool found for client 0x%02X localization label. Sending FFs as the localization label.", rxMessage.get_source_control_function()->get_address());
-													send_generic_process_data_default_payload(static_cast<std::uint8_t>(ProcessDataCommands::DeviceDescriptor) | static_cast<std::uint8_t>(DeviceDescriptorCommandParameters::LocalizationLabel) << 4, rxMessage.get_source_control_function());
-												}
+												LOG_INFO("[TC Server]:Client 0x%02X localization label matched.", rxMessage.get_source_control_function()->get_address());
+												send_localization_label(rxMessage.get_source_control_function(), localizationLabel);
 											}
 											else
 											{
-												nack_process_data_command(rxMessage.get_source_control_function());
+												// No object pool found. Send FFs as the localization label.
+												LOG_INFO("[TC Server]: No object pool found for client 0x%02X localization label. Sending FFs as the localization label.", rxMessage.get_source_control_function()->get_address());
+												send_generic_process_data_default_payload(static_cast<std::uint8_t>(ProcessDataCommands::DeviceDescriptor) | static_cast<std::uint8_t>(DeviceDescriptorCommandParameters::LocalizationLabel) << 4, rxMessage.get_source_control_function());
 											}
 										}
-										break;
+										else
+										{
+											nack_process_data_command(rxMessage.get_source_control_function());
+										}
+									}
+									break;
 
-										case DeviceDescriptorCommandParameters::RequestObjectPoolTransfer:
+									case DeviceDescriptorCommandParameters::RequestObjectPoolTransfer:
+									{
+										if (nullptr != get_active_client(rxMessage.get_source_control_function()))
 										{
-											if (nullptr != get_active_client(rxMessage.get_source_control_function()))
-											{
-												std::uint32_t requestedSize = rxMessage.get_uint32_at(1);
+											std::uint32_t requestedSize = rxMessage.get_uint32_at(1);
 
-												if ((requestedSize <= CANMessage::ABSOLUTE_MAX_MESSAGE_LENGTH) &&
-												    (get_is_enough_memory_available(requestedSize)))
-												{
-													LOG_INFO("[TC Server]: Client 0x%02X requests object pool transfer of %u bytes", rxMessage.get_source_control_function()->get_address(), requestedSize);
+											if ((requestedSize <= CANMessage::ABSOLUTE_MAX_MESSAGE_LENGTH) &&
+											    (get_is_enough_memory_available(requestedSize)))
+											{
+												LOG_INFO("[TC Server]: Client 0x%02X requests object pool transfer of %u bytes", rxMessage.get_source_control_function()->get_address(), requestedSize);
 
-													get_active_client(rxMessage.get_source_control_function())->clientDDOPsize_bytes = requestedSize;
-													send_request_object_pool_transfer_response(rxMessage.get_source_control_function(), true);
-												}
-												else
-												{
-													LOG_ERROR("[TC Server]: Client 0x%02X requests object pool transfer of %u bytes but there is not enough memory available.", rxMessage.get_source_control_function()->get_address(), requestedSize);
-													send_request_object_pool_transfer_response(rxMessage.get_source_control_function(), false);
-												}
+												get_active_client(rxMessage.get_source_control_function())->clientDDOPsize_bytes = requestedSize;
+												send_request_object_pool_transfer_response(rxMessage.get_source_control_function(), true);
 											}
 											else
 											{
-												nack_process_data_command(rxMessage.get_source_control_function());
+												LOG_ERROR("[TC Server]: Client 0x%02X requests object pool transfer of %u bytes but there is not enough memory available.", rxMessage.get_source_control_function()->get_address(), requestedSize);
+												send_request_object_pool_transfer_response(rxMessage.get_source_control_function(), false);
 											}
 										}
-										break;
+										else
+										{
+											nack_process_data_command(rxMessage.get_source_control_function());
+										}
+									}
+									break;
 
-										case DeviceDescriptorCommandParameters::ObjectPoolTransfer:
+									case DeviceDescriptorCommandParameters::ObjectPoolTransfer:
+									{
+										if (nullptr != get_active_client(rxMessage.get_source_control_function()))
 										{
-											if (nullptr != get_active_client(rxMessage.get_source_control_function()))
-											{
-												std::vector<std::uint8_t> objectPool = rxData;
-												objectPool.erase(objectPool.begin()); // Strip the command byte from the front of the object pool
+											std::vector<std::uint8_t> objectPool(rxData.begin() + 1, rxData.end()); // Strip the command byte from the front of the object pool
 
-												if (0 == get_active_client(rxMessage.get_source_control_function())->clientDDOPsize_bytes)
-												{
-													LOG_WARNING("[TC Server]: Client 0x%02X sent object pool transfer without first requesting a transfer!", rxMessage.get_source_control_function()->get_address());
-												}
+											if (0 == get_active_client(rxMessage.get_source_control_function())->clientDDOPsize_bytes)
+											{
+												LOG_WARNING("[TC Server]: Client 0x%02X sent object pool transfer without first requesting a transfer!", rxMessage.get_source_control_function()->get_address());
+											}
 
-												if (store_device_descriptor_object_pool(rxMessage.get_source_control_function(), objectPool, 0 != get_active_client(rxMessage.get_source_control_function())->numberOfObjectPoolSegments))
-												{
-													LOG_INFO("[TC Server]: Stored DDOP segment for client 0x%02X", rxMessage.get_source_control_function()->get_address());
-													send_object_pool_transfer_response(rxMessage.get_source_control_function(), 0, static_cast<std::uint32_t>(objectPool.size())); // No error, transfer OK
-												}
-												else
-												{
-													LOG_ERROR("[TC Server]: Failed to store DDOP segment for client 0x%02X. Reporting to the client as \"Any other error\"", rxMessage.get_source_control_function()->get_address());
-													send_object_pool_transfer_response(rxMessage.get_source_control_function(), 2, static_cast<std::uint32_t>(objectPool.size()));
-												}
+											if (store_device_descriptor_object_pool(rxMessage.get_source_control_function(), objectPool, 0 != get_active_client(rxMessage.get_source_control_function())->numberOfObjectPoolSegments))
+											{
+												LOG_INFO("[TC Server]: Stored DDOP segment for client 0x%02X", rxMessage.get_source_control_function()->get_address());
+												send_object_pool_transfer_response(rxMessage.get_source_control_function(), 0, static_cast<std::uint32_t>(objectPool.size())); // No error, transfer OK
 											}
 											else
 											{
-												nack_process_data_command(rxMessage.get_source_control_function());
+												LOG_ERROR("[TC Server]: Failed to store DDOP segment for client 0x%02X. Reporting to the client as \"Any other error\"", rxMessage.get_source_control_function()->get_address());
+												send_object_pool_transfer_response(rxMessage.get_source_control_function(), 2, static_cast<std::uint32_t>(objectPool.size()));
 											}
 										}
-										break;
+										else
+										{
+											nack_process_data_command(rxMessage.get_source_control_function());
+										}
+									}
+									break;
 
-										case DeviceDescriptorCommandParameters::ObjectPoolActivateDeactivate:
+									case DeviceDescriptorCommandParameters::ObjectPoolActivateDeactivate:
+									{
+										if (nullptr != get_active_client(rxMessage.get_source_control_function()))
 										{
-											if (nullptr != get_active_client(rxMessage.get_source_control_function()))
+											constexpr std::uint8_t ACTIVATE = 0xFF;
+											constexpr std::uint8_t DEACTIVATE = 0x00;
+											ObjectPoolActivationError activationError = ObjectPoolActivationError::NoErrors;
+											ObjectPoolErrorCodes errorCode = ObjectPoolErrorCodes::NoErrors;
+											std::uint16_t faultingParentObject = 0;
+											std::uint16_t faultingObject = 0;
+
+											if (ACTIVATE == rxData[1])
 											{
-												constexpr std::uint8_t ACTIVATE = 0xFF;
-												constexpr std::uint8_t DEACTIVATE = 0x00;
-												ObjectPoolActivationError activationError = ObjectPoolActivationError::NoErrors;
-												ObjectPoolErrorCodes errorCode = ObjectPoolErrorCodes::NoErrors;
-												std::uint16_t faultingParentObject = 0;
-												std::uint16_t faultingObject = 0;
-
-												if (ACTIVATE == rxData[1])
+												LOG_INFO("[TC Server]: Client 0x%02X requests activation of object pool", rxMessage.get_source_control_function()->get_address());
+												auto client = get_active_client(rxMessage.get_source_control_function());
+
+												if (activate_object_pool(rxMessage.get_source_control_function(), activationError, errorCode, faultingParentObject, faultingObject))
+												{
+													LOG_INFO("[TC Server]: Object pool activated for client 0x%02X", rxMessage.get_source_control_function()->get_address());
+													client->isDDOPActive = true;
+													send_object_pool_activate_deactivate_response(rxMessage.get_source_control_function(), 0, 0, 0xFFFF, 0xFFFF);
+												}
+												else
 												{
-													LOG_INFO("[TC Server]: Client 0x%02X requests activation of object pool", rxMessage.get_source_control_function()->get_address());
-													auto client = get_active_client(rxMessage.get_source_control_function());
-
-													if (activate_object_pool(rxMessage.get_source_control_function(), activationError, errorCode, faultingParentObject, faultingObject))
-													{
-														LOG_INFO("[TC Server]: Object pool activated for client 0x%02X", rxMessage.get_source_control_function()->get_address());
-														client->isDDOPActive = true;
-														send_object_pool_activate_deactivate_response(rxMessage.get_source_control_function(), 0, 0, 0xFFFF, 0xFFFF);
-													}
-													else
-													{
-														LOG_ERROR("[TC Server]: Failed to activate object pool for client 0x%02X. Error code: %u, Faulty object: %u, Parent of faulty object: %u", rxMessage.get_source_control_function()->get_address(), static_cast<std::uint8_t>(activationError), faultingObject, faultingParentObject);
-														send_object_pool_activate_deactivate_response(rxMessage.get_source_control_function(), static_cast<std::uint8_t>(activationError), static_cast<std::uint8_t>(errorCode), faultingParentObject, faultingObject);
-													}
+													LOG_ERROR("[TC Server]: Failed to activate object pool for client 0x%02X. Error code: %u, Faulty object: %u, Parent of faulty object: %u", rxMessage.get_source_control_function()->get_address(), static_cast<std::uint8_t>(activationError), faultingObject, faultingParentObject);
+													send_object_pool_activate_deactivate_response(rxMessage.get_source_control_function(), static_cast<std::uint8_t>(activationError), static_cast<std::uint8_t>(errorCode), faultingParentObject, faultingObject);
 												}
-												else if (DEACTIVATE == rxData[1])
+											}
+											else if (DEACTIVATE == rxData[1])
+											{
+												LOG_INFO("[TC Server]: Client 0x%02X requests deactivation of object pool", rxMessage.get_source_control_function()->get_address());
+
+												if (deactivate_object_pool(rxMessage.get_source_control_function()))
 												{
-													LOG_INFO("[TC Server]: Client 0x%02X requests deactivation of object pool", rxMessage.get_source_control_function()->get_address());
-
-													if (deactivate_object_pool(rxMessage.get_source_control_function()))
-													{
-														LOG_INFO("[TC Server]: Object pool deactivated for client 0x%02X", rxMessage.get_source_control_function()->get_address());
-														get_active_client(rxMessage.get_source_control_function())->isDDOPActive = false;
-														send_object_pool_activate_deactivate_response(rxMessage.get_source_control_function(), 0, 0, 0xFFFF, 0xFFFF);
-													}
-													else
-													{
-														LOG_ERROR("[TC Server]: Failed to deactivate object pool for client 0x%02X", rxMessage.get_source_control_function()->get_address());
-														send_object_pool_activate_deactivate_response(rxMessage.get_source_control_function(), static_cast<std::uint8_t>(ObjectPoolActivationError::AnyOtherError), 0, 0xFFFF, 0xFFFF);
-													}
+													LOG_INFO("[TC Server]: Object pool deactivated for client 0x%02X", rxMessage.get_source_control_function()->get_address());
+													get_active_client(rxMessage.get_source_control_function())->isDDOPActive = false;
+													send_object_pool_activate_deactivate_response(rxMessage.get_source_control_function(), 0, 0, 0xFFFF, 0xFFFF);
 												}
 												else
 												{
-													LOG_ERROR("[TC Server]: Client 0x%02X requests activation/deactivation of object pool with invalid value: 0x%02X", rxMessage.get_source_control_function()->get_address(), rxData[1]);
+													LOG_ERROR("[TC Server]: Failed to deactivate object pool for client 0x%02X", rxMessage.get_source_control_function()->get_address());
+													send_object_pool_activate_deactivate_response(rxMessage.get_source_control_function(), static_cast<std::uint8_t>(ObjectPoolActivationError::AnyOtherError), 0, 0xFFFF, 0xFFFF);
 												}
 											}
 											else
 											{
-												nack_process_data_command(rxMessage.get_source_control_function());
+												LOG_ERROR("[TC Server]: Client 0x%02X requests activation/deactivation of object pool with invalid value: 0x%02X", rxMessage.get_source_control_function()->get_address(), rxData[1]);
 											}
 										}
-										break;
+										else
+										{
+											nack_process_data_command(rxMessage.get_source_control_function());
+										}
+									}
+									break;
 
-										case DeviceDescriptorCommandParameters::DeleteObjectPool:
+									case DeviceDescriptorCommandParameters::DeleteObjectPool:
+									{
+										if (nullptr != get_active_client(rxMessage.get_source_control_function()))
 										{
-											if (nullptr != get_active_client(rxMessage.get_source_control_function()))
-											{
-												ObjectPoolDeletionErrors errorCode = ObjectPoolDeletionErrors::ErrorDetailsNotAvailable;
+											ObjectPoolDeletionErrors errorCode = ObjectPoolDeletionErrors::ErrorDetailsNotAvailable;
 
-												if (delete_device_descriptor_object_pool(rxMessage.get_source_control_function(), errorCode))
-												{
-													LOG_INFO("[TC Server]: Deleted object pool for client 0x%02X", rxMessage.get_source_control_function()->get_address());
-													send_delete_object_pool_response(rxMessage.get_source_control_function(), true, static_cast<std::uint8_t>(ObjectPoolDeletionErrors::ErrorDetailsNotAvailable));
-												}
-												else
-												{
-													LOG_ERROR("[TC Server]: Failed to delete object pool for client 0x%02X. Error code: %u", rxMessage.get_source_control_function()->get_address(), static_cast<std::uint8_t>(errorCode));
-													send_delete_object_pool_response(rxMessage.get_source_control_function(), false, static_cast<std::uint8_t>(errorCode));
-												}
+											if (delete_device_descriptor_object_pool(rxMessage.get_source_control_function(), errorCode))
+											{
+												LOG_INFO("[TC Server]: Deleted object pool for client 0x%02X", rxMessage.get_source_control_function()->get_address());
+												send_delete_object_pool_response(rxMessage.get_source_control_function(), true, static_cast<std::uint8_t>(ObjectPoolDeletionErrors::ErrorDetailsNotAvailable));
 											}
 											else
 											{
-												nack_process_data_command(rxMessage.get_source_control_function());
+												LOG_ERROR("[TC Server]: Failed to delete object pool for client 0x%02X. Error code: %u", rxMessage.get_source_control_function()->get_address(), static_cast<std::uint8_t>(errorCode));
+												send_delete_object_pool_response(rxMessage.get_source_control_function(), false, static_cast<std::uint8_t>(errorCode));
 											}
 										}
-										break;
+										else
+										{
+											nack_process_data_command(rxMessage.get_source_control_function());
+										}
+									}
+									break;
 
-										case DeviceDescriptorCommandParameters::ChangeDesignator:
+									case DeviceDescriptorCommandParameters::ChangeDesignator:
+									{
+										if (nullptr != get_active_client(rxMessage.get_source_control_function()))
 										{
-											if (nullptr != get_active_client(rxMessage.get_source_control_function()))
+											if (get_active_client(rxMessage.get_source_control_function())->isDDOPActive)
 											{
-												if (get_active_client(rxMessage.get_source_control_function())->isDDOPActive)
+												std::uint16_t objectID = rxMessage.get_uint16_at(1);
+												std::vector<std::uint8_t> newDesignatorUTF8Bytes;
+
+												for (std::size_t i = 0; i < rxData.size() - 3; i++)
 												{
-													std::uint16_t objectID = rxMessage.get_uint16_at(1);
-													std::vector<std::uint8_t> newDesignatorUTF8Bytes;
-
-													for (std::size_t i = 0; i < rxData.size() - 3; i++)
-													{
-														newDesignatorUTF8Bytes.push_back(rxData[3 + i]);
-													}
-
-													if (change_designator(rxMessage.get_source_control_function(), objectID, newDesignatorUTF8Bytes))
-													{
-														LOG_INFO("[TC Server]: Changed designator for client 0x%02X. Object ID: %u", rxMessage.get_source_control_function()->get_address(), objectID);
-														send_change_designator_response(rxMessage.get_source_control_function(), objectID, 0);
-													}
-													else
-													{
-														LOG_ERROR("[TC Server]: Failed to change designator for client 0x%02X. Object ID: %u", rxMessage.get_source_control_function()->get_address(), objectID);
-														send_change_designator_response(rxMessage.get_source_control_function(), objectID, 1);
-													}
+													newDesignatorUTF8Bytes.push_back(rxData[3 + i]);
+												}
+
+												if (change_designator(rxMessage.get_source_control_function(), objectID, newDesignatorUTF8Bytes))
+												{
+													LOG_INFO("[TC Server]: Changed designator for client 0x%02X. Object ID: %u", rxMessage.get_source_control_function()->get_address(), objectID);
+													send_change_designator_response(rxMessage.get_source_control_function(), objectID, 0);
 												}
 												else
 												{
-													LOG_ERROR("[TC Server]: Client 0x%02X requests change to change a designator but the object pool is not active.", rxMessage.get_source_control_function()->get_address());
+													LOG_ERROR("[TC Server]: Failed to change designator for client 0x%02X. Object ID: %u", rxMessage.get_source_control_function()->get_address(), objectID);
+													send_change_designator_response(rxMessage.get_source_control_function(), objectID, 1);
 												}
 											}
 											else
 											{
-												nack_process_data_command(rxMessage.get_source_control_function());
+												LOG_ERROR("[TC Server]: Client 0x%02X requests change to change a designator but the object pool is not active.", rxMessage.get_source_control_function()->get_address());
 											}
 										}
-										break;
-
-										case DeviceDescriptorCommandParameters::StructureLabel:
-										case DeviceDescriptorCommandParameters::LocalizationLabel:
-										case DeviceDescriptorCommandParameters::RequestObjectPoolTransferResponse:
-										case DeviceDescriptorCommandParameters::ObjectPoolTransferResponse:
-										case DeviceDescriptorCommandParameters::ObjectPoolActivateDeactivateResponse:
-										case DeviceDescriptorCommandParameters::DeleteObjectPoolResponse:
-										case DeviceDescriptorCommandParameters::ChangeDesignatorResponse:
+										else
 										{
-											// Nack server side messages
 											nack_process_data_command(rxMessage.get_source_control_function());
 										}
-										break;
 									}
-								}
-								else
-								{
-									LOG_WARNING("[TC Server]: Device descriptor message received with invalid DLC. DLC must be at least 8.");
-								}
-							}
-							else
-							{
-								LOG_WARNING("[TC Server]: Unknown device descriptor command received: 0x%02X", rxData[0]);
-							}
-						}
-						break;
-
-						case ProcessDataCommands::Value:
-						case ProcessDataCommands::SetValueAndAcknowledge:
-						{
-							if (nullptr != get_active_client(rxMessage.get_source_control_function()))
-							{
-								if (get_active_client(rxMessage.get_source_control_function())->isDDOPActive)
-								{
-									std::uint16_t DDI = rxMessage.get_uint16_at(2);
-									std::uint16_t elementNumber = static_cast<std::uint16_t>(rxData[0] >> 4) | (static_cast<std::uint16_t>(rxData[1]) << 4);
-									std::int32_t processVariableValue = rxMessage.get_int32_at(4);
-									std::uint8_t errorCodes = 0;
+									break;
 
-									if (on_value_command(rxMessage.get_source_control_function(), DDI, elementNumber, processVariableValue, errorCodes))
+									case DeviceDescriptorCommandParameters::StructureLabel:
+									case DeviceDescriptorCommandParameters::LocalizationLabel:
+									case DeviceDescriptorCommandParameters::RequestObjectPoolTransferResponse:
+									case DeviceDescriptorCommandParameters::ObjectPoolTransferResponse:
+									case DeviceDescriptorCommandParameters::ObjectPoolActivateDeactivateResponse:
+									case DeviceDescriptorCommandParameters::DeleteObjectPoolResponse:
+									case DeviceDescriptorCommandParameters::ChangeDesignatorResponse:
 									{
-										LOG_DEBUG("[TC Server]: Client 0x%02X value command for element %u DDI %u and value %d OK.", rxMessage.get_source_control_function()->get_address(), elementNumber, DDI, processVariableValue);
-
-										if (ProcessDataCommands::SetValueAndAcknowledge == static_cast<ProcessDataCommands>(rxData[0] & 0x0F))
-										{
-											send_process_data_acknowledge(rxMessage.get_source_control_function(), DDI, elementNumber, 0, static_cast<ProcessDataCommands>(rxData[0] & 0x0F));
-										}
-									}
-									else
-									{
-										LOG_ERROR("[TC Server]: Client 0x%02X value command for element %u DDI %u and value %d failed.", rxMessage.get_source_control_function()->get_address(), elementNumber, DDI, processVariableValue);
-
-										if (0 == errorCodes)
-										{
-											LOG_ERROR("[TC Server]: Your derived TC server class must set errorCodes to a non-zero value if a value command fails.");
-											errorCodes = static_cast<std::uint8_t>(ProcessDataAcknowledgeErrorCodes::DDINotSupportedByElement); // Like this!
-											assert(false); // See above error message.
-										}
-										send_process_data_acknowledge(rxMessage.get_source_control_function(), DDI, elementNumber, errorCodes, static_cast<ProcessDataCommands>(rxData[0] & 0x0F));
+										// Nack server side messages
+										nack_process_data_command(rxMessage.get_source_control_function());
 									}
-								}
-								else
-								{
-									LOG_ERROR("[TC Server]: Client 0x%02X sent a value command but the object pool is not active.", rxMessage.get_source_control_function()->get_address());
+									break;
 								}
 							}
 							else
 							{
-								nack_process_data_command(rxMessage.get_source_control_function());
+								LOG_WARNING("[TC Server]: Device descriptor message received with invalid DLC. DLC must be at least 8.");
 							}
 						}
-						break;
+						else
+						{
+							LOG_WARNING("[TC Server]: Unknown device descriptor command received: 0x%02X", rxData[0]);
+						}
+					}
+					break;
 
-						case ProcessDataCommands::Acknowledge:
+					case ProcessDataCommands::Value:
+					case ProcessDataCommands::SetValueAndAcknowledge:
+					{
+						if (nullptr != get_active_client(rxMessage.get_source_control_function()))
 						{
-							if (nullptr != get_active_client(rxMessage.get_source_control_function()))
+							if (get_active_client(rxMessage.get_source_control_function())->isDDOPActive)
 							{
 								std::uint16_t DDI = rxMessage.get_uint16_at(2);
 								std::uint16_t elementNumber = static_cast<std::uint16_t>(rxData[0] >> 4) | (static_cast<std::uint16_t>(rxData[1]) << 4);
+								std::int32_t processVariableValue = rxMessage.get_int32_at(4);
+								std::uint8_t errorCodes = 0;
 
-								if (get_active_client(rxMessage.get_source_control_function())->isDDOPActive)
+								if (on_value_command(rxMessage.get_source_control_function(), DDI, elementNumber, processVariableValue, errorCodes))
 								{
-									on_process_data_acknowledge(rxMessage.get_source_control_function(), DDI, elementNumber, rxData[4], static_cast<ProcessDataCommands>(rxData[0] & 0x0F));
+									LOG_DEBUG("[TC Server]: Client 0x%02X value command for element %u DDI %u and value %d OK.", rxMessage.get_source_control_function()->get_address(), elementNumber, DDI, processVariableValue);
+
+									if (ProcessDataCommands::SetValueAndAcknowledge == static_cast<ProcessDataCommands>(rxData[0] & 0x0F))
+									{
+										send_process_data_acknowledge(rxMessage.get_source_control_function(), DDI, elementNumber, 0, static_cast<ProcessDataCommands>(rxData[0] & 0x0F));
+									}
 								}
 								else
 								{
-									LOG_ERROR("[TC Server]: Client 0x%02X sent an acknowledge command but the object pool is not active.", rxMessage.get_source_control_function()->get_address());
-									send_process_data_acknowledge(rxMessage.get_source_control_function(), DDI, elementNumber, static_cast<std::uint8_t>(ProcessDataAcknowledgeErrorCodes::ProcessDataNotSettable), static_cast<ProcessDataCommands>(rxData[0] & 0x0F));
+									LOG_ERROR("[TC Server]: Client 0x%02X value command for element %u DDI %u and value %d failed.", rxMessage.get_source_control_function()->get_address(), elementNumber, DDI, processVariableValue);
+
+									if (0 == errorCodes)
+									{
+										LOG_ERROR("[TC Server]: Your derived TC server class must set errorCodes to a non-zero value if a value command fails.");
+										errorCodes = static_cast<std::uint8_t>(ProcessDataAcknowledgeErrorCodes::DDINotSupportedByElement); // Like this!
+										assert(false); // See above error message.
+									}
+									send_process_data_acknowledge(rxMessage.get_source_control_function(), DDI, elementNumber, errorCodes, static_cast<ProcessDataCommands>(rxData[0] & 0x0F));
 								}
 							}
 							else
 							{
-								nack_process_data_command(rxMessage.get_source_control_function());
+								LOG_ERROR("[TC Server]: Client 0x%02X sent a value command but the object pool is not active.", rxMessage.get_source_control_function()->get_address());
 							}
 						}
-						break;
-
-						case ProcessDataCommands::MeasurementTimeInterval:
-						case ProcessDataCommands::MeasurementDistanceInterval:
-						case ProcessDataCommands::MeasurementMinimumWithinThreshold:
-						case ProcessDataCommands::MeasurementMaximumWithinThreshold:
-						case ProcessDataCommands::MeasurementChangeThreshold:
+						else
 						{
-							if (CAN_DATA_LENGTH == rxMessage.get_data_length())
-							{
-								std::uint16_t DDI = static_cast<std::uint16_t>(rxData[2]) | (static_cast<std::uint16_t>(rxData[3]) << 8);
-								std::uint16_t elementNumber = static_cast<std::uint16_t>(rxData[0] >> 4) | (static_cast<std::uint16_t>(rxData[1]) << 4);
-								LOG_ERROR("[TC Server]: Client 0x%02X is sending measurement commands?", rxMessage.get_source_control_function()->get_address());
-								send_process_data_acknowledge(rxMessage.get_source_control_function(), DDI, elementNumber, static_cast<std::uint8_t>(ProcessDataAcknowledgeErrorCodes::ProcessDataCommandNotSupported), static_cast<ProcessDataCommands>(rxData[0] & 0x0F));
-							}
-							else
-							{
-								LOG_ERROR("[TC Server]: Client 0x%02X is sending measurement commands with invalid lengths, which is very unusual.", rxMessage.get_source_control_function()->get_address());
-							}
+							nack_process_data_command(rxMessage.get_source_control_function());
 						}
-						break;
+					}
+					break;
 
-						case ProcessDataCommands::Status:
-						case ProcessDataCommands::RequestValue:
+					case ProcessDataCommands::Acknowledge:
+					{
+						if (nullptr != get_active_client(rxMessage.get_source_control_function()))
 						{
-							// Ignore server side messages
-						}
-						break;
+							std::uint16_t DDI = rxMessage.get_uint16_at(2);
+							std::uint16_t elementNumber = static_cast<std::uint16_t>(rxData[0] >> 4) | (static_cast<std::uint16_t>(rxData[1]) << 4);
 
-						case ProcessDataCommands::ClientTask:
-						{
-							if (CAN_DATA_LENGTH == rxMessage.get_data_length())
+							if (get_active_client(rxMessage.get_source_control_function())->isDDOPActive)
 							{
-								for (const auto &activeClient : activeClients)
-								{
-									if ((nullptr != activeClient) &&
-									    (activeClient->clientControlFunction == rxMessage.get_source_control_function()))
-									{
-										std::uint32_t status = rxData[4];
-										status |= static_cast<std::uint32_t>(rxData[5]) << 8;
-										status |= static_cast<std::uint32_t>(rxData[6]) << 16;
-										status |= static_cast<std::uint32_t>(rxData[7]) << 24;
-										activeClient->lastStatusMessageTimestamp_ms = SystemTiming::get_timestamp_ms();
-										activeClient->statusBitfield = status;
-									}
-								}
+								on_process_data_acknowledge(rxMessage.get_source_control_function(), DDI, elementNumber, rxData[4], static_cast<ProcessDataCommands>(rxData[0] & 0x0F));
 							}
 							else
 							{
-								LOG_WARNING("[TC Server]: client task message received with invalid DLC. DLC must be 8.");
+								LOG_ERROR("[TC Server]: Client 0x%02X sent an acknowledge command but the object pool is not active.", rxMessage.get_source_control_function()->get_address());
+								send_process_data_acknowledge(rxMessage.get_source_control_function(), DDI, elementNumber, static_cast<std::uint8_t>(ProcessDataAcknowledgeErrorCodes::ProcessDataNotSettable), static_cast<ProcessDataCommands>(rxData[0] & 0x0F));
 							}
 						}
-						break;
-
-						case ProcessDataCommands::PeerControlAssignment:
+						else
 						{
-							LOG_WARNING("[TC Server]: Peer Control is currently not supported");
+							nack_process_data_command(rxMessage.get_source_control_function());
 						}
-						break;
+					}
+					break;
 
-						case ProcessDataCommands::Reserved:
-						case ProcessDataCommands::Reserved2:
+					case ProcessDataCommands::MeasurementTimeInterval:
+					case ProcessDataCommands::MeasurementDistanceInterval:
+					case ProcessDataCommands::MeasurementMinimumWithinThreshold:
+					case ProcessDataCommands::MeasurementMaximumWithinThreshold:
+					case ProcessDataCommands::MeasurementChangeThreshold:
+					{
+						if (CAN_DATA_LENGTH == rxMessage.get_data_length())
 						{
-							LOG_WARNING("[TC Server]: Reserved command received: 0x%02X", rxData[0]);
+							std::uint16_t DDI = static_cast<std::uint16_t>(rxData[2]) | (static_cast<std::uint16_t>(rxData[3]) << 8);
+							std::uint16_t elementNumber = static_cast<std::uint16_t>(rxData[0] >> 4) | (static_cast<std::uint16_t>(rxData[1]) << 4);
+							LOG_ERROR("[TC Server]: Client 0x%02X is sending measurement commands?", rxMessage.get_source_control_function()->get_address());
+							send_process_data_acknowledge(rxMessage.get_source_control_function(), DDI, elementNumber, static_cast<std::uint8_t>(ProcessDataAcknowledgeErrorCodes::ProcessDataCommandNotSupported), static_cast<ProcessDataCommands>(rxData[0] & 0x0F));
 						}
-						break;
-
-						default:
+						else
 						{
-							LOG_WARNING("[TC Server]: Unknown ProcessData command received: 0x%02X", rxData[0]);
+							LOG_ERROR("[TC Server]: Client 0x%02X is sending measurement commands with invalid lengths, which is very unusual.", rxMessage.get_source_control_function()->get_address());
 						}
-						break;
 					}
-				}
-				break;
+					break;
 
-				case static_cast<std::uint32_t>(CANLibParameterGroupNumber::WorkingSetMaster):
-				{
-					if (CAN_DATA_LENGTH == rxMessage.get_data_length())
+					case ProcessDataCommands::Status:
+					case ProcessDataCommands::RequestValue:
 					{
-						std::uint8_t numberOfWorkingSetMembers = rxData[0];
+						// Ignore server side messages
+					}
+					break;
 
-						if (1 == numberOfWorkingSetMembers)
+					case ProcessDataCommands::ClientTask:
+					{
+						if (CAN_DATA_LENGTH == rxMessage.get_data_length())
 						{
-							if (nullptr == get_active_client(rxMessage.get_source_control_function()))
+							auto activeClient = get_active_client(rxMessage.get_source_control_function());
+
+							if (nullptr != activeClient)
 							{
-								activeClients.push_back(std::make_shared<ActiveClient>(rxMessage.get_source_control_function()));
+								std::uint32_t status = rxData[4];
+								status |= static_cast<std::uint32_t>(rxData[5]) << 8;
+								status |= static_cast<std::uint32_t>(rxData[6]) << 16;
+								status |= static_cast<std::uint32_t>(rxData[7]) << 24;
+								activeClient->lastStatusMessageTimestamp_ms = SystemTiming::get_timestamp_ms();
+								activeClient->statusBitfield = status;
 							}
 						}
 						else
 						{
-							LOG_ERROR("[TC Server]: Working set master message received with unsupported number of working set members: %u", numberOfWorkingSetMembers);
+							LOG_WARNING("[TC Server]: client task message received with invalid DLC. DLC must be 8.");
+						}
+					}
+					break;
+
+					case ProcessDataCommands::PeerControlAssignment:
+					{
+						LOG_WARNING("[TC Server]: Peer Control is currently not supported");
+					}
+					break;
+
+					case ProcessDataCommands::Reserved:
+					case ProcessDataCommands::Reserved2:
+					{
+						LOG_WARNING("[TC Server]: Reserved command received: 0x%02X", rxData[0]);
+					}
+					break;
+
+					default:
+					{
+						LOG_WARNING("[TC Server]: Unknown ProcessData command received: 0x%02X", rxData[0]);
+					}
+					break;
+				}
+			}
+			break;
+
+			case static_cast<std::uint32_t>(CANLibParameterGroupNumber::WorkingSetMaster):
+			{
+				if (CAN_DATA_LENGTH == rxMessage.get_data_length())
+				{
+					std::uint8_t numberOfWorkingSetMembers = rxData[0];
+
+					if (1 == numberOfWorkingSetMembers)
+					{
+						auto source = rxMessage.get_source_control_function();
+
+						if ((nullptr != source) &&
+						    (source->get_can_port() < CAN_PORT_MAXIMUM) &&
+						    (nullptr == get_active_client(source)))
+						{
+							// Only this client's own messages can add it, so nothing can add it in between
+							auto newClient = std::make_shared<ActiveClient>(source);
+							LOCK_GUARD(Mutex, activeClientsMutex);
+							activeClients.push_back(newClient);
+							activeClientIndex[source->get_can_port()][source->get_NAME().get_full_name()] = newClient;
 						}
 					}
 					else
 					{
-						LOG_ERROR("[TC Server]: Working set master message received with invalid DLC. DLC should be 8.");
+						LOG_ERROR("[TC Server]: Working set master message received with unsupported number of working set members: %u", numberOfWorkingSetMembers);
 					}
 				}
-				break;
+				else
+				{
+					LOG_ERROR("[TC Server]: Working set master message received with invalid DLC. DLC should be 8.");
+				}
+			}
+			break;
 
-				default:
+			default:
+			{
+			}
+			break;
+		}
+	}
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+	void TaskControllerServer::process_rx_messages_on_workers()
+	{
+		std::size_t numberOfStreams = 0;
+
+		// Split the messages up by client, keeping the order of each client's messages
+		for (const auto &rxMessage : messagesBeingProcessed)
+		{
+			auto source = rxMessage.get_source_control_function();
+			std::size_t streamIndex = 0;
+
+			while ((streamIndex < numberOfStreams) && (clientMessageStreams[streamIndex].clientControlFunction != source))
+			{
+				streamIndex++;
+			}
+
+			if (streamIndex == numberOfStreams)
+			{
+				if (clientMessageStreams.size() == numberOfStreams)
 				{
+					clientMessageStreams.emplace_back();
 				}
+				clientMessageStreams[streamIndex].clientControlFunction = source;
+				numberOfStreams++;
+			}
+			clientMessageStreams[streamIndex].messages.push_back(&rxMessage);
+		}
+
+		{
+			const std::lock_guard<std::mutex> lock(workerMutex);
+			numberOfClientMessageStreams = numberOfStreams;
+			nextClientMessageStream = 0;
+			workersBusy = workerThreads.size();
+			workerGeneration++;
+		}
+		workerWakeupCondition.notify_all();
+
+		// This thread helps, rather than just waiting for the workers
+		process_client_message_streams();
+
+		{
+			std::unique_lock<std::mutex> lock(workerMutex);
+			while (0 != workersBusy)
+			{
+				workerDoneCondition.wait_for(lock, std::chrono::milliseconds(WORKER_WAIT_TIMEOUT_MS));
+			}
+		}
+
+		for (std::size_t i = 0; i < numberOfStreams; i++)
+		{
+			// Keep the vectors' capacity for the next update
+			clientMessageStreams[i].clientControlFunction.reset();
+			clientMessageStreams[i].messages.clear();
+		}
+	}
+
+	void TaskControllerServer::process_client_message_streams()
+	{
+		while (true)
+		{
+			std::size_t streamIndex;
+			{
+				const std::lock_guard<std::mutex> lock(workerMutex);
+				if (nextClientMessageStream >= numberOfClientMessageStreams)
+				{
+					break;
+				}
+				streamIndex = nextClientMessageStream;
+				nextClientMessageStream++;
+			}
+
+			for (const auto rxMessage : clientMessageStreams[streamIndex].messages)
+			{
+				process_rx_message(*rxMessage);
+			}
+		}
+	}
+
+	void TaskControllerServer::stop_worker_threads()
+	{
+		{
+			const std::lock_guard<std::mutex> lock(workerMutex);
+			workersRunning = false;
+		}
+		workerWakeupCondition.notify_all();
+
+		for (auto &worker : workerThreads)
+		{
+			if (worker.joinable())
+			{
+				worker.join();
+			}
+		}
+		workerThreads.clear();
+	}
+
+	void TaskControllerServer::worker_thread_function(std::uint32_t initialGeneration)
+	{
+		std::uint32_t lastGeneration = initialGeneration;
+		std::unique_lock<std::mutex> lock(workerMutex);
+
+		while (true)
+		{
+			if (workersRunning && (workerGeneration == lastGeneration))
+			{
+				workerWakeupCondition.wait_for(lock, std::chrono::milliseconds(WORKER_WAIT_TIMEOUT_MS));
+				continue;
+			}
+			if (!workersRunning)
+			{
 				break;
 			}
-			rxMessageQueue.pop_front();
+			lastGeneration = workerGeneration;
+
+			lock.unlock();
+			process_client_message_streams();
+			lock.lock();
+
+			workersBusy--;
+			if (0 == workersBusy)
+			{
+				workerDoneCondition.notify_all();
+			}
 		}
 	}
+#endif
 
 	bool TaskControllerServer::send_generic_process_data_default_payload(std::uint8_t multiplexer, std::shared_ptr<ControlFunction> destination) const
 	{
@@ -804,18 +1040,21 @@ namespace isobus
 
 	std::shared_ptr<TaskControllerServer::ActiveClient> TaskControllerServer::get_active_client(std::shared_ptr<ControlFunction> clientControlFunction) const
 	{
-		for (const auto &activeClient : activeClients)
+		std::shared_ptr<ActiveClient> retVal;
+
+		if ((nullptr != clientControlFunction) &&
+		    (clientControlFunction->get_can_port() < CAN_PORT_MAXIMUM))
 		{
-			if ((nullptr != activeClient) &&
-			    (nullptr != activeClient->clientControlFunction) &&
-			    (nullptr != clientControlFunction) &&
-			    (activeClient->clientControlFunction->get_NAME() == clientControlFunction->get_NAME()) &&
-			    (activeClient->clientControlFunction->get_can_port() == clientControlFunction->get_can_port()))
+			LOCK_GUARD(Mutex, activeClientsMutex);
+			const auto &portClients = activeClientIndex[clientControlFunction->get_can_port()];
+			auto result = portClients.find(clientControlFunction->get_NAME().get_full_name());
+
+			if (portClients.end() != result)
 			{
-				return activeClient;
+				retVal = result->second;
 			}
 		}
-		return nullptr;
+		return retVal;
 	}
 
 	bool TaskControllerServer::nack_process_data_command(std::shared_ptr<ControlFunction> clientControlFunction) const
@@ -836,6 +1075,7 @@ namespace isobus
 			};
 
 			LOG_WARNING("[TC Server]: NACKing process data command from 0x%02X because they are not known to us. Clients must send the working set master message first.", clientControlFunction->get_address());
+			LOCK_GUARD(Mutex, transmitMutex);
 			retVal = CANNetworkManager::CANNetwork.send_can_message(static_cast<std::uint32_t>(CANLibParameterGroupNumber::Acknowledge),
 			                                                        payload.data(),
 			                                                        payload.size(),
@@ -1052,6 +1292,7 @@ namespace isobus
 
 		if ((nullptr != dataBuffer) && (dataLength > 0))
 		{
+			LOCK_GUARD(Mutex, transmitMutex);
 			retVal = CANNetworkManager::CANNetwork.send_can_message(static_cast<std::uint32_t>(CANLibParameterGroupNumber::ProcessData),
 			                                                        dataBuffer,
 			                                                        dataLength,
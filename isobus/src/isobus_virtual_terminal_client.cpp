@@ -11,13 +11,16 @@
 #include "isobus/isobus/can_general_parameter_group_numbers.hpp"
 #include "isobus/isobus/can_network_manager.hpp"
 #include "isobus/isobus/can_stack_logger.hpp"
+#include "isobus/utility/iop_file_interface.hpp"
 #include "isobus/utility/platform_endianness.hpp"
 #include "isobus/utility/system_timing.hpp"
 #include "isobus/utility/to_string.hpp"
 
 #include <algorithm>
 #include <cassert>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <functional>
 #include <limits>
 #include <map>
@@ -263,6 +266,44 @@ namespace isobus
 		return (functionObjectID == other.functionObjectID) && (inputObjectID == other.inputObjectID) && (functionType == other.functionType);
 	}
 
+	void VirtualTerminalClient::set_command_coalescing(bool enabled)
+	{
+		commandCoalescing = enabled;
+	}
+
+	bool VirtualTerminalClient::get_command_coalescing() const
+	{
+		return commandCoalescing;
+	}
+
+	void VirtualTerminalClient::set_maximum_commands_in_flight(std::uint8_t maximumCommands)
+	{
+		if (0 == maximumCommands)
+		{
+			maximumCommands = 1;
+		}
+		else if (maximumCommands > MAX_COMMANDS_IN_FLIGHT)
+		{
+			maximumCommands = MAX_COMMANDS_IN_FLIGHT;
+		}
+		maximumCommandsInFlight = maximumCommands;
+	}
+
+	std::uint8_t VirtualTerminalClient::get_maximum_commands_in_flight() const
+	{
+		return maximumCommandsInFlight;
+	}
+
+	std::uint8_t VirtualTerminalClient::get_number_of_commands_in_flight() const
+	{
+		return numberOfCommandsInFlight;
+	}
+
+	bool VirtualTerminalClient::get_command_pipelining_fallback_active() const
+	{
+		return commandPipeliningFallback;
+	}
+
 	bool VirtualTerminalClient::send_hide_show_object(std::uint16_t objectID, HideShowObjectCommand command)
 	{
 		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::HideShowObjectCommand),
@@ -1251,6 +1292,11 @@ namespace isobus
 		}
 	}
 
+	void VirtualTerminalClient::set_object_pool(std::uint8_t poolIndex, DataSpan<const std::uint8_t> pool, std::string version)
+	{
+		set_object_pool(poolIndex, pool.begin(), static_cast<std::uint32_t>(pool.size()), version);
+	}
+
 	void VirtualTerminalClient::set_object_pool(std::uint8_t poolIndex, const std::vector<std::uint8_t> *pool, std::string version)
 	{
 		if ((nullptr != pool) &&
@@ -1290,6 +1336,36 @@ namespace isobus
 		objectPools[poolIndex].autoScaleSoftKeyDesignatorOriginalHeight = originalSoftKyeDesignatorHeight_px;
 	}
 
+	void VirtualTerminalClient::set_streaming_object_pool_scaling(bool enabled)
+	{
+		streamingObjectPoolScaling = enabled;
+	}
+
+	bool VirtualTerminalClient::get_streaming_object_pool_scaling() const
+	{
+		return streamingObjectPoolScaling;
+	}
+
+	void VirtualTerminalClient::set_object_pool_scaling_thread_count(std::uint8_t threadCount)
+	{
+		objectPoolScalingThreadCount = threadCount;
+	}
+
+	std::uint8_t VirtualTerminalClient::get_object_pool_scaling_thread_count() const
+	{
+		return objectPoolScalingThreadCount;
+	}
+
+	void VirtualTerminalClient::set_scaled_object_pool_cache_directory(const std::string &directory)
+	{
+		scaledObjectPoolCacheDirectory = directory;
+	}
+
+	const std::string &VirtualTerminalClient::get_scaled_object_pool_cache_directory() const
+	{
+		return scaledObjectPoolCacheDirectory;
+	}
+
 	void VirtualTerminalClient::register_object_pool_data_chunk_callback(std::uint8_t poolIndex, std::uint32_t poolTotalSize, DataChunkCallback value, std::string version)
 	{
 		if ((nullptr != value) &&
@@ -1471,7 +1547,7 @@ namespace isobus
 						LOG_ERROR("[VT]: Get Versions Timeout");
 					}
 					else if ((!objectPools.empty()) &&
-					         (!objectPools[0].versionLabel.empty()) &&
+					         (!get_object_pool_version_label().empty()) &&
 					         (send_get_versions()))
 					{
 						set_state(StateMachineState::WaitForGetVersionsResponse);
@@ -1510,9 +1586,10 @@ namespace isobus
 						tempVersionBuffer[5] = ' ';
 						tempVersionBuffer[6] = ' ';
 
-						for (std::size_t i = 0; ((i < VERSION_LABEL_LENGTH) && (i < objectPools[0].versionLabel.size())); i++)
+						const std::string versionLabel = get_object_pool_version_label();
+						for (std::size_t i = 0; ((i < VERSION_LABEL_LENGTH) && (i < versionLabel.size())); i++)
 						{
-							tempVersionBuffer[i] = objectPools[0].versionLabel[i];
+							tempVersionBuffer[i] = versionLabel[i];
 						}
 
 						if (send_load_version(tempVersionBuffer))
@@ -1554,9 +1631,10 @@ namespace isobus
 						tempVersionBuffer[5] = ' ';
 						tempVersionBuffer[6] = ' ';
 
-						for (std::size_t i = 0; ((i < VERSION_LABEL_LENGTH) && (i < objectPools[0].versionLabel.size())); i++)
+						const std::string versionLabel = get_object_pool_version_label();
+						for (std::size_t i = 0; ((i < VERSION_LABEL_LENGTH) && (i < versionLabel.size())); i++)
 						{
-							tempVersionBuffer[i] = objectPools[0].versionLabel[i];
+							tempVersionBuffer[i] = versionLabel[i];
 						}
 
 						if (send_store_version(tempVersionBuffer))
@@ -1585,8 +1663,8 @@ namespace isobus
 					{
 						if (get_any_pool_needs_scaling())
 						{
-							// Scale object pools before upload.
-							if (!scale_object_pools())
+							// Scale object pools before upload, or load them from the cache
+							if (!prepare_scaled_object_pools())
 							{
 								set_state(StateMachineState::Failed);
 							}
@@ -1608,6 +1686,8 @@ namespace isobus
 							{
 								if (!objectPools[i].uploaded)
 								{
+									reset_streaming_object_pool_scaler(i);
+
 									bool transmitSuccessful = CANNetworkManager::CANNetwork.send_can_message(static_cast<std::uint32_t>(CANLibParameterGroupNumber::ECUtoVirtualTerminal),
 									                                                                         nullptr,
 									                                                                         objectPools[i].objectPoolSize + 1, // Account for Mux byte
@@ -2136,6 +2216,11 @@ namespace isobus
 		if (StateMachineState::Disconnected == value)
 		{
 			lastVTStatusTimestamp_ms = 0;
+			{
+				LOCK_GUARD(Mutex, commandsInFlightMutex);
+				numberOfCommandsInFlight = 0;
+				commandPipeliningFallback = false;
+			}
 			for (std::size_t i = 0; i < objectPools.size(); i++)
 			{
 				objectPools[i].uploaded = false;
@@ -2849,7 +2934,7 @@ namespace isobus
 								// Check if we need to ask for pool versions
 								// Ony check the first pool, all pools are labeled the same per working set.
 								if ((!parentVT->objectPools.empty()) &&
-								    (!parentVT->objectPools[0].versionLabel.empty()))
+								    (!parentVT->get_object_pool_version_label().empty()))
 								{
 									parentVT->set_state(StateMachineState::SendGetVersions);
 								}
@@ -2877,6 +2962,19 @@ namespace isobus
 
 									if (message.get_data_length() >= remainingLength)
 									{
+										std::string actualLabel(parentVT->get_object_pool_version_label());
+
+										// Check if we need to manipulate our label by padding with spaces
+										while (actualLabel.size() < LABEL_LENGTH)
+										{
+											actualLabel.push_back(' ');
+										}
+
+										if (actualLabel.size() > LABEL_LENGTH)
+										{
+											actualLabel.resize(LABEL_LENGTH);
+										}
+
 										for (std::uint_fast8_t i = 0; i < numberOfLabels; i++)
 										{
 											char tempStringLabel[8] = { 0 };
@@ -2889,20 +2987,8 @@ namespace isobus
 											tempStringLabel[6] = message.get_uint8_at(8 + (LABEL_LENGTH * i));
 											tempStringLabel[7] = '\0';
 											std::string labelDecoded(tempStringLabel);
-											std::string tempActualLabel(parentVT->objectPools[0].versionLabel);
 
-											// Check if we need to manipulate the passed in label by padding with spaces
-											while (tempActualLabel.size() < LABEL_LENGTH)
-											{
-												tempActualLabel.push_back(' ');
-											}
-
-											if (tempActualLabel.size() > LABEL_LENGTH)
-											{
-												tempActualLabel.resize(LABEL_LENGTH);
-											}
-
-											if (tempActualLabel == labelDecoded)
+											if (actualLabel == labelDecoded)
 											{
 												labelMatched = true;
 												parentVT->set_state(StateMachineState::SendLoadVersion);
@@ -3074,9 +3160,10 @@ namespace isobus
 									{
 										objectPool.scaledObjectPool.clear();
 									}
+									parentVT->reset_streaming_object_pool_scaler(0);
 
 									// Check if we need to store this pool
-									if (!parentVT->objectPools[0].versionLabel.empty())
+									if (!parentVT->get_object_pool_version_label().empty())
 									{
 										parentVT->set_state(StateMachineState::SendStoreVersion);
 									}
@@ -3158,7 +3245,7 @@ namespace isobus
 							if ((parentVT->myControlFunction == message.get_destination_control_function()) &&
 							    (parentVT->partnerControlFunction == message.get_source_control_function()))
 							{
-								parentVT->commandAwaitingResponse = false;
+								parentVT->process_command_response(message);
 								parentVT->process_command_queue();
 							}
 						}
@@ -3298,17 +3385,34 @@ namespace isobus
 				// We've got more data to transfer
 				if ((0 != parentVTClient->objectPools[poolIndex].autoScaleDataMaskOriginalDimension) && (0 != parentVTClient->objectPools[poolIndex].autoScaleSoftKeyDesignatorOriginalHeight))
 				{
-					// Object pool has been pre-scaled. Use the scaling buffer instead
-					retVal = true;
-					if (0 == bytesOffset)
+					if (parentVTClient->objectPools[poolIndex].scaledObjectPool.empty())
 					{
-						chunkBuffer[0] = static_cast<std::uint8_t>(Function::ObjectPoolTransferMessage);
-						memcpy(&chunkBuffer[1], &parentVTClient->objectPools[poolIndex].scaledObjectPool[bytesOffset], numberOfBytesNeeded - 1);
+						// Scale the objects in this chunk as they are needed
+						if (0 == bytesOffset)
+						{
+							chunkBuffer[0] = static_cast<std::uint8_t>(Function::ObjectPoolTransferMessage);
+							retVal = parentVTClient->get_streamed_scaled_object_pool_bytes(poolIndex, bytesOffset, numberOfBytesNeeded - 1, &chunkBuffer[1]);
+						}
+						else
+						{
+							// Subtract off 1 to account for the mux in the first byte of the message
+							retVal = parentVTClient->get_streamed_scaled_object_pool_bytes(poolIndex, bytesOffset - 1, numberOfBytesNeeded, chunkBuffer);
+						}
 					}
 					else
 					{
-						// Subtract off 1 to account for the mux in the first byte of the message
-						memcpy(chunkBuffer, &parentVTClient->objectPools[poolIndex].scaledObjectPool[bytesOffset - 1], numberOfBytesNeeded);
+						// Object pool has been pre-scaled. Use the scaling buffer instead
+						retVal = true;
+						if (0 == bytesOffset)
+						{
+							chunkBuffer[0] = static_cast<std::uint8_t>(Function::ObjectPoolTransferMessage);
+							memcpy(&chunkBuffer[1], &parentVTClient->objectPools[poolIndex].scaledObjectPool[bytesOffset], numberOfBytesNeeded - 1);
+						}
+						else
+						{
+							// Subtract off 1 to account for the mux in the first byte of the message
+							memcpy(chunkBuffer, &parentVTClient->objectPools[poolIndex].scaledObjectPool[bytesOffset - 1], numberOfBytesNeeded);
+						}
 					}
 				}
 				else
@@ -3370,79 +3474,539 @@ namespace isobus
 
 		for (auto &objectPool : objectPools)
 		{
-			// Step 1: Make a read/write copy of the pool
+			retVal = scale_object_pool(objectPool);
+
+			if (!retVal)
+			{
+				break;
+			}
+		}
+		return retVal;
+	}
+
+	bool VirtualTerminalClient::scale_object_pool(ObjectPoolDataStruct &objectPool)
+	{
+		bool retVal = true;
+
+		// Step 1: Make a read/write copy of the pool.
+		// The zeroed lookahead after the pool keeps a malformed last object from being parsed out of bounds.
+		objectPool.scaledObjectPool.assign(static_cast<std::size_t>(objectPool.objectPoolSize) + OBJECT_SIZE_LOOKAHEAD, 0);
+
+		if (nullptr != objectPool.objectPoolDataPointer)
+		{
+			memcpy(objectPool.scaledObjectPool.data(), objectPool.objectPoolDataPointer, objectPool.objectPoolSize);
+		}
+		else if (nullptr != objectPool.objectPoolVectorPointer)
+		{
+			std::copy(objectPool.objectPoolVectorPointer->begin(), objectPool.objectPoolVectorPointer->end(), objectPool.scaledObjectPool.begin());
+		}
+		else if (objectPool.useDataCallback)
+		{
+			std::uint32_t callbackIndex = 0;
+
+			for (std::uint32_t i = 0; (i < objectPool.objectPoolSize) && retVal; i += OBJECT_POOL_COPY_CHUNK_SIZE)
+			{
+				const std::uint32_t remainingBytes = objectPool.objectPoolSize - i;
+				const std::uint32_t chunkSize = (remainingBytes < OBJECT_POOL_COPY_CHUNK_SIZE) ? remainingBytes : OBJECT_POOL_COPY_CHUNK_SIZE;
+				retVal = objectPool.dataCallback(callbackIndex, i, chunkSize, &objectPool.scaledObjectPool[i], this);
+				callbackIndex++;
+			}
+		}
+
+		// Step 2: Index the pool, scaling doesn't change the size of any object so this stays valid
+		std::vector<std::uint32_t> objectOffsets;
+		std::uint32_t objectOffset = 0;
+
+		while ((objectOffset < objectPool.objectPoolSize) && retVal)
+		{
+			const std::uint32_t objectSize = get_number_bytes_in_object(&objectPool.scaledObjectPool[objectOffset]);
+
+			if ((0 == objectSize) || (objectSize > (objectPool.objectPoolSize - objectOffset)))
+			{
+				LOG_ERROR("[VT]: Failed to index an object pool for scaling, invalid object at offset " + isobus::to_string(objectOffset));
+				retVal = false;
+			}
+			else
+			{
+				objectOffsets.push_back(objectOffset);
+				objectOffset += objectSize;
+			}
+		}
+
+		// Step 3: Resize each object, split over the worker threads if there are enough objects
+		if (retVal)
+		{
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+			const std::size_t threadCount = std::min<std::size_t>(std::max<std::uint8_t>(objectPoolScalingThreadCount, 1),
+			                                                       std::max<std::size_t>(objectOffsets.size() / MINIMUM_OBJECTS_PER_SCALING_THREAD, 1));
+
+			if (threadCount > 1)
+			{
+				const std::size_t objectsPerThread = (objectOffsets.size() + threadCount - 1) / threadCount;
+				std::vector<std::uint8_t> threadResults(threadCount, 0);
+				std::vector<std::thread> scalingThreads;
+
+				scalingThreads.reserve(threadCount - 1);
+				for (std::size_t i = 1; i < threadCount; i++)
+				{
+					scalingThreads.emplace_back([this, &objectPool, &objectOffsets, &threadResults, objectsPerThread, i]() {
+						threadResults[i] = scale_object_range(objectPool,
+						                                      objectOffsets,
+						                                      std::min(i * objectsPerThread, objectOffsets.size()),
+						                                      std::min((i + 1) * objectsPerThread, objectOffsets.size()));
+					});
+				}
+				threadResults[0] = scale_object_range(objectPool, objectOffsets, 0, objectsPerThread);
+
+				for (auto &scalingThread : scalingThreads)
+				{
+					scalingThread.join();
+				}
+
+				for (auto threadResult : threadResults)
+				{
+					retVal &= (0 != threadResult);
+				}
+			}
+			else
+#endif
+			{
+				retVal = scale_object_range(objectPool, objectOffsets, 0, objectOffsets.size());
+			}
+		}
+		return retVal;
+	}
+
+	bool VirtualTerminalClient::prepare_scaled_object_pools()
+	{
+		bool retVal = true;
+
+		for (std::uint32_t i = 0; (i < objectPools.size()) && retVal; i++)
+		{
+			auto &objectPool = objectPools[i];
+			objectPool.scaledObjectPool.clear();
+
+			if ((0 != objectPool.autoScaleDataMaskOriginalDimension) &&
+			    (0 != objectPool.autoScaleSoftKeyDesignatorOriginalHeight))
+			{
+				const std::string cachePath = scaledObjectPoolCacheDirectory.empty() ? std::string() : get_scaled_object_pool_cache_path(i);
+
+				if ((!cachePath.empty()) && load_scaled_object_pool_from_cache(i, cachePath))
+				{
+					LOG_INFO("[VT]: Loaded scaled object pool %u from the cache, skipping scaling.", i + 1);
+				}
+				else if (!cachePath.empty())
+				{
+					// The whole scaled pool is needed to store it
+					retVal = scale_object_pool(objectPool);
+
+					if (retVal)
+					{
+						store_scaled_object_pool_in_cache(i, cachePath);
+					}
+				}
+				else if (!streamingObjectPoolScaling)
+				{
+					retVal = scale_object_pool(objectPool);
+				}
+				else
+				{
+					// The pool will be scaled while it's uploaded
+				}
+			}
+		}
+		return retVal;
+	}
+
+	std::string VirtualTerminalClient::get_object_pool_hash(std::uint32_t poolIndex)
+	{
+		auto &objectPool = objectPools[poolIndex];
+		std::string retVal = objectPool.poolHash;
+
+		if (retVal.empty())
+		{
+			IOPFileInterface::VersionHasher hasher(objectPool.objectPoolSize);
+			bool readSuccessful = true;
+
 			if (nullptr != objectPool.objectPoolDataPointer)
 			{
-				objectPool.scaledObjectPool.resize(objectPool.objectPoolSize);
-				memcpy(&objectPool.scaledObjectPool[0], objectPool.objectPoolDataPointer, objectPool.objectPoolSize);
+				hasher.update(objectPool.objectPoolDataPointer, objectPool.objectPoolSize);
 			}
 			else if (nullptr != objectPool.objectPoolVectorPointer)
 			{
-				objectPool.scaledObjectPool.resize(objectPool.objectPoolVectorPointer->size());
-				std::copy(objectPool.objectPoolVectorPointer->begin(), objectPool.objectPoolVectorPointer->end(), objectPool.scaledObjectPool.begin());
+				hasher.update(objectPool.objectPoolVectorPointer->data(), objectPool.objectPoolVectorPointer->size());
 			}
 			else if (objectPool.useDataCallback)
 			{
-				objectPool.scaledObjectPool.resize(objectPool.objectPoolSize);
+				std::vector<std::uint8_t> chunk(OBJECT_POOL_COPY_CHUNK_SIZE);
+				std::uint32_t callbackIndex = 0;
 
-				for (std::uint32_t i = 0; i < objectPool.objectPoolSize; i++)
+				for (std::uint32_t i = 0; (i < objectPool.objectPoolSize) && readSuccessful; i += OBJECT_POOL_COPY_CHUNK_SIZE)
 				{
-					retVal &= objectPool.dataCallback(i, i, 1, &objectPool.scaledObjectPool[i], this);
+					const std::uint32_t remainingBytes = objectPool.objectPoolSize - i;
+					const std::uint32_t chunkSize = (remainingBytes < OBJECT_POOL_COPY_CHUNK_SIZE) ? remainingBytes : OBJECT_POOL_COPY_CHUNK_SIZE;
+					readSuccessful = objectPool.dataCallback(callbackIndex, i, chunkSize, chunk.data(), this);
+					hasher.update(chunk.data(), chunkSize);
+					callbackIndex++;
 				}
+			}
 
-				if (!retVal)
+			if (readSuccessful)
+			{
+				retVal = hasher.get_version();
+
+				// Vectors and callbacks can provide different data later on, so only constant buffers are remembered
+				if (nullptr != objectPool.objectPoolDataPointer)
 				{
-					break;
+					objectPool.poolHash = retVal;
 				}
 			}
+		}
+		return retVal;
+	}
 
-			// Step 2, Parse the pool and resize each object as we iterate through it
-			auto poolIterator = objectPool.scaledObjectPool.begin();
+	std::string VirtualTerminalClient::get_scaled_object_pool_key(std::uint32_t poolIndex)
+	{
+		const auto &objectPool = objectPools[poolIndex];
+		const std::string poolHash = get_object_pool_hash(poolIndex);
+		std::string retVal;
 
-			while ((poolIterator != objectPool.scaledObjectPool.end()) &&
-			       retVal)
+		if (!poolHash.empty())
+		{
+			retVal = poolHash +
+			  "_" + isobus::to_string(xPixels) + "x" + isobus::to_string(yPixels) +
+			  "_" + isobus::to_string(static_cast<int>(softKeyXAxisPixels)) + "x" + isobus::to_string(static_cast<int>(softKeyYAxisPixels)) +
+			  "_" + isobus::to_string(static_cast<int>(smallFontSizesBitfield)) + "-" + isobus::to_string(static_cast<int>(largeFontSizesBitfield)) +
+			  "_" + isobus::to_string(objectPool.autoScaleDataMaskOriginalDimension) + "x" + isobus::to_string(objectPool.autoScaleSoftKeyDesignatorOriginalHeight);
+		}
+		return retVal;
+	}
+
+	std::string VirtualTerminalClient::get_object_pool_version_label()
+	{
+		std::string retVal;
+
+		if (!objectPools.empty())
+		{
+			retVal = objectPools[0].versionLabel;
+
+			if ((!retVal.empty()) && get_any_pool_needs_scaling())
 			{
-				if (VirtualTerminalObjectType::Key == static_cast<VirtualTerminalObjectType>(poolIterator[2]))
+				constexpr std::size_t VERSION_LABEL_LENGTH = 7;
+				constexpr char LABEL_CHARACTERS[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+				constexpr std::uint64_t NUMBER_OF_LABEL_CHARACTERS = sizeof(LABEL_CHARACTERS) - 1;
+				std::string labelKey = retVal;
+
+				bool allKeysValid = true;
+
+				for (std::uint32_t i = 0; (i < objectPools.size()) && allKeysValid; i++)
 				{
-					retVal &= resize_object(&poolIterator[0],
-					                        static_cast<float>(get_softkey_x_axis_pixels()) / static_cast<float>(objectPool.autoScaleSoftKeyDesignatorOriginalHeight),
-					                        static_cast<VirtualTerminalObjectType>(poolIterator[2]));
+					if ((0 != objectPools[i].autoScaleDataMaskOriginalDimension) &&
+					    (0 != objectPools[i].autoScaleSoftKeyDesignatorOriginalHeight))
+					{
+						const std::string scalingKey = get_scaled_object_pool_key(i);
+						allKeysValid = !scalingKey.empty();
+						labelKey += "|" + scalingKey;
+					}
+				}
+
+				retVal.clear();
+				if (allKeysValid)
+				{
+					// FNV-1a, so the label is the same on every platform and every run
+					std::uint64_t labelHash = 0xCBF29CE484222325ULL;
+					for (char character : labelKey)
+					{
+						labelHash ^= static_cast<std::uint8_t>(character);
+						labelHash *= 0x100000001B3ULL;
+					}
+
+					for (std::size_t i = 0; i < VERSION_LABEL_LENGTH; i++)
+					{
+						retVal.push_back(LABEL_CHARACTERS[labelHash % NUMBER_OF_LABEL_CHARACTERS]);
+						labelHash /= NUMBER_OF_LABEL_CHARACTERS;
+					}
 				}
 				else
 				{
-					retVal &= resize_object(&poolIterator[0],
-					                        static_cast<float>(get_number_x_pixels()) / static_cast<float>(objectPool.autoScaleDataMaskOriginalDimension),
-					                        static_cast<VirtualTerminalObjectType>(poolIterator[2]));
+					LOG_WARNING("[VT]: Unable to hash an auto-scaled object pool, it will not be stored on the VT.");
+				}
+			}
+		}
+		return retVal;
+	}
+
+	std::string VirtualTerminalClient::get_scaled_object_pool_cache_path(std::uint32_t poolIndex)
+	{
+		const std::string scalingKey = get_scaled_object_pool_key(poolIndex);
+		std::string retVal;
+
+		if (!scalingKey.empty())
+		{
+			retVal = scaledObjectPoolCacheDirectory;
+
+			if ((!retVal.empty()) && ('/' != retVal.back()) && ('\\' != retVal.back()))
+			{
+				retVal.push_back('/');
+			}
+			retVal += scalingKey + ".iop";
+		}
+		return retVal;
+	}
+
+	bool VirtualTerminalClient::load_scaled_object_pool_from_cache(std::uint32_t poolIndex, const std::string &cachePath)
+	{
+		bool retVal = false;
+		auto &objectPool = objectPools[poolIndex];
+		std::vector<std::uint8_t> cachedPool = IOPFileInterface::read_iop_file(cachePath);
+
+		// Scaling never changes the size of a pool, and the pool is followed by its own hash,
+		// so a file that doesn't match both is a stale or damaged one
+		if (cachedPool.size() > objectPool.objectPoolSize)
+		{
+			const std::string storedHash(cachedPool.begin() + objectPool.objectPoolSize, cachedPool.end());
+
+			if (storedHash == IOPFileInterface::hash_object_pool_to_version(cachedPool.data(), objectPool.objectPoolSize))
+			{
+				cachedPool.resize(objectPool.objectPoolSize);
+				objectPool.scaledObjectPool = std::move(cachedPool);
+				retVal = true;
+			}
+		}
+
+		if (!retVal)
+		{
+			LOG_DEBUG("[VT]: No valid scaled object pool in the cache at " + cachePath);
+		}
+		return retVal;
+	}
+
+	void VirtualTerminalClient::store_scaled_object_pool_in_cache(std::uint32_t poolIndex, const std::string &cachePath)
+	{
+		const auto &objectPool = objectPools[poolIndex];
+		const std::string temporaryPath = cachePath + ".tmp";
+		bool writeSuccessful = false;
+
+		// Write to a temporary file first so an interrupted write never leaves a partial pool behind
+		{
+			std::ofstream cacheFile(temporaryPath, std::ios::binary | std::ios::trunc);
+
+			if (cacheFile.is_open())
+			{
+				const std::string poolHash = IOPFileInterface::hash_object_pool_to_version(objectPool.scaledObjectPool.data(), objectPool.objectPoolSize);
+
+				cacheFile.write(reinterpret_cast<const char *>(objectPool.scaledObjectPool.data()), objectPool.objectPoolSize);
+				cacheFile.write(poolHash.data(), static_cast<std::streamsize>(poolHash.size()));
+				writeSuccessful = cacheFile.good();
+			}
+		}
+
+		if (writeSuccessful)
+		{
+			std::remove(cachePath.c_str());
+			writeSuccessful = (0 == std::rename(temporaryPath.c_str(), cachePath.c_str()));
+		}
+
+		if (!writeSuccessful)
+		{
+			std::remove(temporaryPath.c_str());
+			LOG_WARNING("[VT]: Failed to store a scaled object pool in the cache at " + cachePath);
+		}
+	}
+
+	bool VirtualTerminalClient::scale_object_range(ObjectPoolDataStruct &objectPool,
+	                                               const std::vector<std::uint32_t> &objectOffsets,
+	                                               std::size_t firstObject,
+	                                               std::size_t endObject)
+	{
+		bool retVal = true;
+
+		for (std::size_t i = firstObject; (i < endObject) && retVal; i++)
+		{
+			retVal = scale_object(&objectPool.scaledObjectPool[objectOffsets[i]], objectPool);
+		}
+		return retVal;
+	}
+
+	bool VirtualTerminalClient::scale_object(std::uint8_t *buffer, const ObjectPoolDataStruct &objectPool)
+	{
+		bool retVal;
+		const auto objectType = static_cast<VirtualTerminalObjectType>(buffer[2]);
+		const int objectID = static_cast<int>(buffer[0]) | (static_cast<int>(buffer[1]) << 8);
+
+		if (VirtualTerminalObjectType::Key == objectType)
+		{
+			retVal = resize_object(buffer,
+			                       static_cast<float>(get_softkey_x_axis_pixels()) / static_cast<float>(objectPool.autoScaleSoftKeyDesignatorOriginalHeight),
+			                       objectType);
+		}
+		else
+		{
+			retVal = resize_object(buffer,
+			                       static_cast<float>(get_number_x_pixels()) / static_cast<float>(objectPool.autoScaleDataMaskOriginalDimension),
+			                       objectType);
+		}
+
+		if (retVal)
+		{
+			if (get_is_object_scalable(objectType))
+			{
+				LOG_DEBUG("[VT]: Resized an object: " +
+				          isobus::to_string(objectID) +
+				          " with type " +
+				          isobus::to_string(static_cast<int>(objectType)) +
+				          " with size " +
+				          isobus::to_string(static_cast<int>(get_number_bytes_in_object(buffer))));
+			}
+		}
+		else
+		{
+			LOG_ERROR("[VT]: Failed to resize an object: " +
+			          isobus::to_string(objectID) +
+			          " with type " +
+			          isobus::to_string(static_cast<int>(objectType)) +
+			          " with size " +
+			          isobus::to_string(static_cast<int>(get_number_bytes_in_object(buffer))));
+		}
+		return retVal;
+	}
+
+	bool VirtualTerminalClient::get_streamed_scaled_object_pool_bytes(std::uint32_t poolIndex,
+	                                                                  std::uint32_t offset,
+	                                                                  std::uint32_t length,
+	                                                                  std::uint8_t *destination)
+	{
+		bool retVal = (poolIndex < objectPools.size()) &&
+		  (nullptr != destination) &&
+		  (length <= objectPools[poolIndex].objectPoolSize) &&
+		  (offset <= (objectPools[poolIndex].objectPoolSize - length));
+
+		if (retVal)
+		{
+			auto &scaler = streamingObjectPoolScaler;
+
+			if ((poolIndex != scaler.poolIndex) || (offset < scaler.scaledWindowStart))
+			{
+				// The data we need has already been dropped, so start over
+				reset_streaming_object_pool_scaler(poolIndex);
+			}
+
+			// Drop scaled bytes we won't need anymore, in large steps to keep the number of moves low
+			std::uint32_t scaledWindowEnd = scaler.scaledWindowStart + static_cast<std::uint32_t>(scaler.scaledWindow.size());
+			if (offset > (scaler.scaledWindowStart + 2 * STREAMING_SCALER_HISTORY_BYTES))
+			{
+				const std::uint32_t newWindowStart = std::min(offset - STREAMING_SCALER_HISTORY_BYTES, scaledWindowEnd);
+				scaler.scaledWindow.erase(scaler.scaledWindow.begin(), scaler.scaledWindow.begin() + (newWindowStart - scaler.scaledWindowStart));
+				scaler.scaledWindowStart = newWindowStart;
+			}
+
+			// Scale objects until the requested range is covered
+			while (retVal && (scaledWindowEnd < (offset + length)))
+			{
+				const std::uint8_t *source = get_object_pool_source_bytes(poolIndex, scaledWindowEnd, 0);
+				std::uint32_t objectSize = 0;
+
+				if (nullptr != source)
+				{
+					objectSize = get_number_bytes_in_object(const_cast<std::uint8_t *>(source));
 				}
 
-				std::uint32_t objectSize = get_number_bytes_in_object(&poolIterator[0]);
-				if (retVal)
+				if ((0 == objectSize) || (objectSize > (objectPools[poolIndex].objectPoolSize - scaledWindowEnd)))
 				{
-					if (get_is_object_scalable(static_cast<VirtualTerminalObjectType>(*(poolIterator + 2))))
-					{
-						LOG_DEBUG("[VT]: Resized an object: " +
-						          isobus::to_string(static_cast<int>((*poolIterator)) | (static_cast<int>((*poolIterator + 1))) << 8) +
-						          " with type " +
-						          isobus::to_string(static_cast<int>((*(poolIterator + 2)))) +
-						          " with size " +
-						          isobus::to_string(static_cast<int>(objectSize)));
-					}
+					LOG_ERROR("[VT]: Failed to scale an object pool while uploading it, invalid object at offset " + isobus::to_string(scaledWindowEnd));
+					retVal = false;
 				}
 				else
 				{
-					LOG_ERROR("[VT]: Failed to resize an object: " +
-					          isobus::to_string(static_cast<int>((*poolIterator)) | (static_cast<int>((*poolIterator + 1))) << 8) +
-					          " with type " +
-					          isobus::to_string(static_cast<int>((*poolIterator + 2))) +
-					          " with size " +
-					          isobus::to_string(static_cast<int>(objectSize)));
+					source = get_object_pool_source_bytes(poolIndex, scaledWindowEnd, objectSize);
+					retVal = (nullptr != source);
+
+					if (retVal)
+					{
+						const std::size_t objectStart = scaler.scaledWindow.size();
+						scaler.scaledWindow.insert(scaler.scaledWindow.end(), source, source + objectSize);
+						retVal = scale_object(&scaler.scaledWindow[objectStart], objectPools[poolIndex]);
+						scaledWindowEnd += objectSize;
+					}
 				}
-				poolIterator += objectSize;
+			}
+
+			if (retVal)
+			{
+				memcpy(destination, &scaler.scaledWindow[offset - scaler.scaledWindowStart], length);
 			}
 		}
 		return retVal;
 	}
 
+	const std::uint8_t *VirtualTerminalClient::get_object_pool_source_bytes(std::uint32_t poolIndex, std::uint32_t offset, std::uint32_t length)
+	{
+		const std::uint8_t *retVal = nullptr;
+		auto &objectPool = objectPools[poolIndex];
+		auto &scaler = streamingObjectPoolScaler;
+		const std::uint8_t *poolData = objectPool.objectPoolDataPointer;
+		const std::uint64_t requiredEnd = static_cast<std::uint64_t>(offset) + length + OBJECT_SIZE_LOOKAHEAD;
+
+		if ((nullptr == poolData) && (nullptr != objectPool.objectPoolVectorPointer))
+		{
+			poolData = objectPool.objectPoolVectorPointer->data();
+		}
+
+		if ((nullptr != poolData) && (requiredEnd <= objectPool.objectPoolSize))
+		{
+			// The pool is in memory, and the lookahead is too, so it can be read directly
+			retVal = poolData + offset;
+		}
+		else if ((offset >= scaler.sourceWindowStart) &&
+		         (requiredEnd <= (static_cast<std::uint64_t>(scaler.sourceWindowStart) + scaler.sourceWindow.size())))
+		{
+			retVal = &scaler.sourceWindow[offset - scaler.sourceWindowStart];
+		}
+		else
+		{
+			// Refill the window starting at the requested offset, zero padded past the end of the pool
+			const std::size_t windowSize = std::max<std::size_t>(static_cast<std::size_t>(length) + OBJECT_SIZE_LOOKAHEAD, STREAMING_SCALER_SOURCE_CHUNK_SIZE);
+			const std::uint32_t bytesToRead = static_cast<std::uint32_t>(std::min<std::size_t>(windowSize, objectPool.objectPoolSize - offset));
+			bool readSuccessful = true;
+
+			scaler.sourceWindow.assign(windowSize, 0);
+			scaler.sourceWindowStart = offset;
+
+			if (nullptr != poolData)
+			{
+				memcpy(scaler.sourceWindow.data(), poolData + offset, bytesToRead);
+			}
+			else if (objectPool.useDataCallback && (0 != bytesToRead))
+			{
+				readSuccessful = objectPool.dataCallback(scaler.callbackIndex, offset, bytesToRead, scaler.sourceWindow.data(), this);
+				scaler.callbackIndex++;
+			}
+
+			if (readSuccessful)
+			{
+				retVal = scaler.sourceWindow.data();
+			}
+			else
+			{
+				scaler.sourceWindow.clear();
+			}
+		}
+		return retVal;
+	}
+
+	void VirtualTerminalClient::reset_streaming_object_pool_scaler(std::uint32_t poolIndex)
+	{
+		auto &scaler = streamingObjectPoolScaler;
+
+		// Swap with empty vectors to give the memory back, a pool upload can take a while to come around again
+		std::vector<std::uint8_t>().swap(scaler.scaledWindow);
+		std::vector<std::uint8_t>().swap(scaler.sourceWindow);
+		scaler.poolIndex = poolIndex;
+		scaler.scaledWindowStart = 0;
+		scaler.sourceWindowStart = 0;
+		scaler.callbackIndex = 0;
+	}
+
 	bool VirtualTerminalClient::get_is_object_scalable(VirtualTerminalObjectType type)
 	{
 		bool retVal = false;
@@ -4460,32 +5024,86 @@ namespace isobus
 
 	bool VirtualTerminalClient::send_command(const std::vector<std::uint8_t> &data)
 	{
-		if (commandAwaitingResponse)
+		if (!get_is_connected())
 		{
-			if (SystemTiming::time_expired_ms(lastCommandTimestamp_ms, 1500))
+			LOG_ERROR("[VT]: Cannot send command, not connected");
+			return false;
+		}
+
+		CommandInFlight newCommand;
+		newCommand.functionCode = data[0];
+		newCommand.pipelined = get_pipelined_command_object_id(data.data(), data.size(), false, newCommand.objectID);
+
+		{
+			LOCK_GUARD(Mutex, commandsInFlightMutex);
+			std::uint8_t remainingCommands = 0;
+			bool commandTimedOut = false;
+
+			for (std::uint8_t i = 0; i < numberOfCommandsInFlight; i++)
 			{
-				LOG_WARNING("[VT]: Server response to a command timed out");
-				commandAwaitingResponse = false;
+				if (SystemTiming::time_expired_ms(commandsInFlight[i].timestamp_ms, COMMAND_RESPONSE_TIMEOUT_MS))
+				{
+					LOG_WARNING("[VT]: Server response to a command timed out");
+					commandTimedOut = true;
+				}
+				else
+				{
+					commandsInFlight[remainingCommands] = commandsInFlight[i];
+					remainingCommands++;
+				}
 			}
-			else
+
+			if (commandTimedOut && (numberOfCommandsInFlight > 1) && (!commandPipeliningFallback))
 			{
-				// We're still waiting for a response to the last command, so we can't send another one yet
+				LOG_WARNING("[VT]: Server lost a pipelined command, sending commands one at a time until reconnected");
+				commandPipeliningFallback = true;
+			}
+			numberOfCommandsInFlight = remainingCommands;
+
+			if (numberOfCommandsInFlight >= get_effective_maximum_commands_in_flight())
+			{
+				// We're still waiting for responses, so we can't send another command yet
 				return false;
 			}
-		}
 
-		if (!get_is_connected())
-		{
-			LOG_ERROR("[VT]: Cannot send command, not connected");
-			return false;
+			for (std::uint8_t i = 0; i < numberOfCommandsInFlight; i++)
+			{
+				if ((!newCommand.pipelined) ||
+				    (!commandsInFlight[i].pipelined) ||
+				    (newCommand.objectID == commandsInFlight[i].objectID))
+				{
+					// Only commands to different objects can share the bus with each other
+					return false;
+				}
+			}
+
+			newCommand.timestamp_ms = SystemTiming::get_timestamp_ms();
+			commandsInFlight[numberOfCommandsInFlight] = newCommand;
+			numberOfCommandsInFlight++;
 		}
 
 		bool success = send_message_to_vt(data.data(), data.size());
 
-		if (success)
+		if (!success)
 		{
-			commandAwaitingResponse = true;
-			lastCommandTimestamp_ms = SystemTiming::get_timestamp_ms();
+			LOCK_GUARD(Mutex, commandsInFlightMutex);
+
+			for (std::uint8_t i = numberOfCommandsInFlight; i > 0; i--)
+			{
+				const CommandInFlight &command = commandsInFlight[i - 1];
+
+				if ((command.functionCode == newCommand.functionCode) &&
+				    (command.objectID == newCommand.objectID) &&
+				    (command.timestamp_ms == newCommand.timestamp_ms))
+				{
+					for (std::uint8_t j = i; j < numberOfCommandsInFlight; j++)
+					{
+						commandsInFlight[j - 1] = commandsInFlight[j];
+					}
+					numberOfCommandsInFlight--;
+					break;
+				}
+			}
 		}
 		return success;
 	}
@@ -4498,67 +5116,171 @@ namespace isobus
 			return false;
 		}
 
-		if (get_is_connected() && send_command(data))
+		LOCK_GUARD(Mutex, commandQueueMutex);
+
+		// Commands only skip the queue if nothing is waiting in it, so they can't overtake older commands to the same object
+		if (commandQueue.empty() && get_is_connected() && send_command(data))
 		{
 			return true;
 		}
 
-		LOCK_GUARD(Mutex, commandQueueMutex);
 		if (replace && replace_command(data))
 		{
 			return true;
 		}
-		commandQueue.emplace_back(data);
+		commandQueue.push(data, commandCoalescing);
 		return true;
 	}
 
 	bool VirtualTerminalClient::replace_command(const std::vector<std::uint8_t> &data)
 	{
-		bool alreadyReplaced = false;
-		for (auto it = commandQueue.begin(); it != commandQueue.end();)
+		return commandQueue.replace_function(data);
+	}
+
+	void VirtualTerminalClient::process_command_queue()
+	{
+		if (!get_is_connected())
+		{
+			return;
+		}
+		LOCK_GUARD(Mutex, commandQueueMutex);
+		for (std::size_t i = 0; i < commandQueue.size();)
+		{
+			const std::vector<std::uint8_t> &command = commandQueue.at(i);
+			std::uint16_t objectID = NULL_OBJECT_ID;
+
+			if (send_command(command))
+			{
+				commandQueue.remove(i);
+			}
+			else if (get_pipelined_command_object_id(command.data(), command.size(), false, objectID))
+			{
+				// Later commands to other objects may still fit in the pipeline
+				i++;
+			}
+			else
+			{
+				// Nothing may overtake a command that isn't pipelined
+				break;
+			}
+		}
+	}
+
+	bool VirtualTerminalClient::get_pipelined_command_object_id(const std::uint8_t *data, std::size_t length, bool isResponse, std::uint16_t &objectID)
+	{
+		std::size_t objectIDOffset = 1;
+		bool retVal = false;
+
+		if ((nullptr != data) && (0 != length))
 		{
-			bool matchesFunctionCode = (it->at(0) == data[0]);
-			if (matchesFunctionCode)
+			switch (data[0])
 			{
-				if (!alreadyReplaced)
+				case static_cast<std::uint8_t>(Function::ChangeStringValueCommand):
 				{
-					*it = data;
-					alreadyReplaced = true;
-					it++;
+					// The response puts the object ID after two reserved bytes
+					objectIDOffset = isResponse ? 3 : 1;
+					retVal = true;
 				}
-				else
+				break;
+
+				case static_cast<std::uint8_t>(Function::HideShowObjectCommand):
+				case static_cast<std::uint8_t>(Function::EnableDisableObjectCommand):
+				case static_cast<std::uint8_t>(Function::ChangeChildLocationCommand):
+				case static_cast<std::uint8_t>(Function::ChangeChildPositionCommand):
+				case static_cast<std::uint8_t>(Function::ChangeSizeCommand):
+				case static_cast<std::uint8_t>(Function::ChangeBackgroundColourCommand):
+				case static_cast<std::uint8_t>(Function::ChangeNumericValueCommand):
+				case static_cast<std::uint8_t>(Function::ChangeEndPointCommand):
+				case static_cast<std::uint8_t>(Function::ChangeFontAttributesCommand):
+				case static_cast<std::uint8_t>(Function::ChangeLineAttributesCommand):
+				case static_cast<std::uint8_t>(Function::ChangeFillAttributesCommand):
+				case static_cast<std::uint8_t>(Function::ChangeAttributeCommand):
+				case static_cast<std::uint8_t>(Function::ChangePriorityCommand):
+				case static_cast<std::uint8_t>(Function::ChangeListItemCommand):
+				case static_cast<std::uint8_t>(Function::ChangeObjectLabelCommand):
+				case static_cast<std::uint8_t>(Function::ChangePolygonPointCommand):
+				case static_cast<std::uint8_t>(Function::ChangePolygonScaleCommand):
+				case static_cast<std::uint8_t>(Function::GraphicsContextCommand):
+				case static_cast<std::uint8_t>(Function::GetAttributeValueMessage):
+				{
+					// These commands and their responses start with the ID of the object they change
+					retVal = true;
+				}
+				break;
+
+				default:
 				{
-					it = commandQueue.erase(it);
+					// Masks, macros, audio, input focus and pool management affect more than one object
 				}
+				break;
+			}
+
+			if (retVal && (length >= (objectIDOffset + 2)))
+			{
+				objectID = static_cast<std::uint16_t>(data[objectIDOffset]) | (static_cast<std::uint16_t>(data[objectIDOffset + 1]) << 8);
 			}
 			else
 			{
-				it++;
+				retVal = false;
 			}
 		}
-		return alreadyReplaced;
+		return retVal;
 	}
 
-	void VirtualTerminalClient::process_command_queue()
+	void VirtualTerminalClient::process_command_response(const CANMessage &message)
 	{
-		if (!get_is_connected())
-		{
-			return;
-		}
-		LOCK_GUARD(Mutex, commandQueueMutex);
-		for (auto it = commandQueue.begin(); it != commandQueue.end();)
+		LOCK_GUARD(Mutex, commandsInFlightMutex);
+
+		if (0 != numberOfCommandsInFlight)
 		{
-			if (send_command(*it))
+			const std::uint8_t functionCode = message.get_uint8_at(0);
+			std::uint8_t matchingCommand = 0;
+
+			if (get_effective_maximum_commands_in_flight() > 1)
 			{
-				it = commandQueue.erase(it);
+				std::uint16_t objectID = NULL_OBJECT_ID;
+				const bool pipelined = get_pipelined_command_object_id(message.get_data().data(), message.get_data_length(), true, objectID);
+				bool foundMatch = false;
+
+				for (std::uint8_t i = 0; i < numberOfCommandsInFlight; i++)
+				{
+					if ((functionCode == commandsInFlight[i].functionCode) &&
+					    ((!pipelined) || (objectID == commandsInFlight[i].objectID)))
+					{
+						matchingCommand = i;
+						foundMatch = true;
+						break;
+					}
+				}
+
+				if (!foundMatch)
+				{
+					// Assume the VT answered the oldest command, but stop trusting it with more than one
+					LOG_WARNING("[VT]: Server response doesn't match any command in flight, sending commands one at a time until reconnected");
+					commandPipeliningFallback = true;
+				}
 			}
-			else
+			// Otherwise only one command is sent at a time, so any response answers the oldest one
+
+			for (std::uint8_t i = matchingCommand + 1; i < numberOfCommandsInFlight; i++)
 			{
-				it++;
+				commandsInFlight[i - 1] = commandsInFlight[i];
 			}
+			numberOfCommandsInFlight--;
 		}
 	}
 
+	std::uint8_t VirtualTerminalClient::get_effective_maximum_commands_in_flight() const
+	{
+		std::uint8_t retVal = maximumCommandsInFlight;
+
+		if (commandPipeliningFallback || (0 != (busyCodesBitfield & SERIAL_COMMAND_BUSY_CODES)))
+		{
+			retVal = 1;
+		}
+		return retVal;
+	}
+
 	void VirtualTerminalClient::worker_thread_function()
 	{
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
@@ -0,0 +1,237 @@
+//================================================================================================
+/// @file isobus_virtual_terminal_client_command_queue.cpp
+///
+/// @brief Implements the queue a VT client uses to hold commands until the VT can accept them.
+/// @author Adrian Del Grosso
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/isobus/isobus_virtual_terminal_client_command_queue.hpp"
+
+#include "isobus/isobus/isobus_virtual_terminal_client.hpp"
+
+#include <utility>
+
+namespace isobus
+{
+	VirtualTerminalClientCommandQueue::VirtualTerminalClientCommandQueue(std::size_t initialCapacity) :
+	  slots((0 != initialCapacity) ? initialCapacity : 1)
+	{
+	}
+
+	bool VirtualTerminalClientCommandQueue::push(const std::vector<std::uint8_t> &data, bool coalesce)
+	{
+		std::uint64_t key = 0;
+		const bool canCoalesce = get_coalescing_key(data, key);
+		bool retVal = false;
+
+		if (coalesce && canCoalesce)
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				const QueuedCommand &queuedCommand = get_slot(i);
+
+				if (queuedCommand.canCoalesce && (key == queuedCommand.coalescingKey))
+				{
+					// The newer command still has to follow the commands queued after the old one, which may change the same state
+					remove(i);
+					numberOfCoalescedCommands++;
+					retVal = true;
+					break;
+				}
+			}
+		}
+
+		if (count == slots.size())
+		{
+			grow();
+		}
+
+		QueuedCommand &newCommand = get_slot(count);
+		newCommand.data.assign(data.begin(), data.end());
+		newCommand.coalescingKey = key;
+		newCommand.canCoalesce = canCoalesce;
+		count++;
+		return retVal;
+	}
+
+	bool VirtualTerminalClientCommandQueue::replace_function(const std::vector<std::uint8_t> &data)
+	{
+		bool alreadyReplaced = false;
+		std::size_t i = 0;
+
+		while ((!data.empty()) && (i < count))
+		{
+			QueuedCommand &queuedCommand = get_slot(i);
+
+			if ((!queuedCommand.data.empty()) && (queuedCommand.data[0] == data[0]))
+			{
+				if (!alreadyReplaced)
+				{
+					queuedCommand.data.assign(data.begin(), data.end());
+					queuedCommand.canCoalesce = get_coalescing_key(data, queuedCommand.coalescingKey);
+					alreadyReplaced = true;
+					i++;
+				}
+				else
+				{
+					remove(i);
+				}
+			}
+			else
+			{
+				i++;
+			}
+		}
+		return alreadyReplaced;
+	}
+
+	const std::vector<std::uint8_t> &VirtualTerminalClientCommandQueue::at(std::size_t index) const
+	{
+		return get_slot(index).data;
+	}
+
+	void VirtualTerminalClientCommandQueue::remove(std::size_t index)
+	{
+		if (0 == index)
+		{
+			// Removing the front is the common case, and only needs the head to move
+			if (0 != count)
+			{
+				get_slot(0).data.clear();
+				head = (head + 1) % slots.size();
+				count--;
+			}
+		}
+		else if (index < count)
+		{
+			// Shift the commands behind the removed one forward, swapping so every slot keeps its buffer
+			for (std::size_t i = index; (i + 1) < count; i++)
+			{
+				std::swap(get_slot(i), get_slot(i + 1));
+			}
+			get_slot(count - 1).data.clear();
+			count--;
+		}
+	}
+
+	void VirtualTerminalClientCommandQueue::clear()
+	{
+		for (std::size_t i = 0; i < count; i++)
+		{
+			get_slot(i).data.clear();
+		}
+		head = 0;
+		count = 0;
+	}
+
+	std::size_t VirtualTerminalClientCommandQueue::size() const
+	{
+		return count;
+	}
+
+	bool VirtualTerminalClientCommandQueue::empty() const
+	{
+		return 0 == count;
+	}
+
+	std::size_t VirtualTerminalClientCommandQueue::capacity() const
+	{
+		return slots.size();
+	}
+
+	std::uint32_t VirtualTerminalClientCommandQueue::get_number_of_coalesced_commands() const
+	{
+		return numberOfCoalescedCommands;
+	}
+
+	bool VirtualTerminalClientCommandQueue::get_coalescing_key(const std::vector<std::uint8_t> &data, std::uint64_t &key)
+	{
+		constexpr std::size_t MINIMUM_COMMAND_LENGTH = 5;
+		bool retVal = false;
+
+		if (data.size() >= MINIMUM_COMMAND_LENGTH)
+		{
+			const std::uint64_t functionCode = data[0];
+			const std::uint64_t objectID = (static_cast<std::uint16_t>(data[1]) | (static_cast<std::uint16_t>(data[2]) << 8));
+			std::uint64_t subKey = 0;
+			retVal = true;
+
+			switch (static_cast<VirtualTerminalClient::Function>(data[0]))
+			{
+				case VirtualTerminalClient::Function::HideShowObjectCommand:
+				case VirtualTerminalClient::Function::EnableDisableObjectCommand:
+				case VirtualTerminalClient::Function::ChangeSizeCommand:
+				case VirtualTerminalClient::Function::ChangeBackgroundColourCommand:
+				case VirtualTerminalClient::Function::ChangeNumericValueCommand:
+				case VirtualTerminalClient::Function::ChangeEndPointCommand:
+				case VirtualTerminalClient::Function::ChangeFontAttributesCommand:
+				case VirtualTerminalClient::Function::ChangeLineAttributesCommand:
+				case VirtualTerminalClient::Function::ChangeFillAttributesCommand:
+				case VirtualTerminalClient::Function::ChangeActiveMaskCommand:
+				case VirtualTerminalClient::Function::ChangePriorityCommand:
+				case VirtualTerminalClient::Function::ChangeStringValueCommand:
+				case VirtualTerminalClient::Function::ChangeObjectLabelCommand:
+				case VirtualTerminalClient::Function::ChangePolygonScaleCommand:
+				{
+					// The command sets the whole state it changes on the object
+				}
+				break;
+
+				case VirtualTerminalClient::Function::ChangeAttributeCommand:
+				case VirtualTerminalClient::Function::ChangeListItemCommand:
+				case VirtualTerminalClient::Function::ChangePolygonPointCommand:
+				{
+					// The attribute ID, list index or point index
+					subKey = data[3];
+				}
+				break;
+
+				case VirtualTerminalClient::Function::ChangeChildPositionCommand:
+				{
+					// The object ID is the parent, and the child is what actually moves
+					subKey = (static_cast<std::uint16_t>(data[3]) | (static_cast<std::uint16_t>(data[4]) << 8));
+				}
+				break;
+
+				case VirtualTerminalClient::Function::ChangeSoftKeyMaskCommand:
+				{
+					// The mask type comes before the object ID in this command
+					subKey = (static_cast<std::uint16_t>(data[2]) | (static_cast<std::uint16_t>(data[3]) << 8));
+				}
+				break;
+
+				default:
+				{
+					// Relative changes, one-shot actions and requests can't be dropped
+					retVal = false;
+				}
+				break;
+			}
+			key = ((functionCode << 32) | (objectID << 16) | subKey);
+		}
+		return retVal;
+	}
+
+	VirtualTerminalClientCommandQueue::QueuedCommand &VirtualTerminalClientCommandQueue::get_slot(std::size_t index)
+	{
+		return slots[(head + index) % slots.size()];
+	}
+
+	const VirtualTerminalClientCommandQueue::QueuedCommand &VirtualTerminalClientCommandQueue::get_slot(std::size_t index) const
+	{
+		return slots[(head + index) % slots.size()];
+	}
+
+	void VirtualTerminalClientCommandQueue::grow()
+	{
+		std::vector<QueuedCommand> newSlots(slots.size() * 2);
+
+		for (std::size_t i = 0; i < count; i++)
+		{
+			newSlots[i] = std::move(get_slot(i));
+		}
+		slots = std::move(newSlots);
+		head = 0;
+	}
+} // namespace isobus
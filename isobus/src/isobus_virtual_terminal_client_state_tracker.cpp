@@ -43,35 +43,250 @@ namespace isobus
 
 	void VirtualTerminalClientStateTracker::add_tracked_numeric_value(std::uint16_t objectId, std::uint32_t initialValue)
 	{
-		if (numericValueStates.find(objectId) != numericValueStates.end())
+		TrackedObject *trackedObject = add_tracked_state(objectId, TrackedState::NumericValue, "add_tracked_numeric_value");
+		if (nullptr != trackedObject)
 		{
-			LOG_WARNING("[VTStateHelper] add_tracked_numeric_value: objectId '%lu' already tracked", objectId);
+			trackedObject->current.numericValue = initialValue;
+			trackedObject->initial.numericValue = initialValue;
+		}
+	}
+
+	void VirtualTerminalClientStateTracker::remove_tracked_numeric_value(std::uint16_t objectId)
+	{
+		remove_tracked_state(objectId, TrackedState::NumericValue, "remove_tracked_numeric_value");
+	}
+
+	std::uint32_t VirtualTerminalClientStateTracker::get_numeric_value(std::uint16_t objectId) const
+	{
+		const TrackedObject *trackedObject = get_tracked_object(objectId, TrackedState::NumericValue);
+		if (nullptr == trackedObject)
+		{
+			LOG_WARNING("[VTStateHelper] get_numeric_value: objectId '%lu' not tracked", objectId);
+			return 0;
+		}
+
+		return trackedObject->current.numericValue;
+	}
+
+	void VirtualTerminalClientStateTracker::add_tracked_visibility(std::uint16_t objectId, bool initiallyShown)
+	{
+		TrackedObject *trackedObject = add_tracked_state(objectId, TrackedState::Shown, "add_tracked_visibility");
+		if (nullptr != trackedObject)
+		{
+			trackedObject->current.shown = initiallyShown;
+			trackedObject->initial.shown = initiallyShown;
+		}
+	}
+
+	void VirtualTerminalClientStateTracker::remove_tracked_visibility(std::uint16_t objectId)
+	{
+		remove_tracked_state(objectId, TrackedState::Shown, "remove_tracked_visibility");
+	}
+
+	bool VirtualTerminalClientStateTracker::is_object_shown(std::uint16_t objectId) const
+	{
+		const TrackedObject *trackedObject = get_tracked_object(objectId, TrackedState::Shown);
+		if (nullptr == trackedObject)
+		{
+			LOG_WARNING("[VTStateHelper] is_object_shown: objectId '%lu' not tracked", objectId);
+			return false;
+		}
+
+		return trackedObject->current.shown;
+	}
+
+	void VirtualTerminalClientStateTracker::add_tracked_enable_state(std::uint16_t objectId, bool initiallyEnabled)
+	{
+		TrackedObject *trackedObject = add_tracked_state(objectId, TrackedState::Enabled, "add_tracked_enable_state");
+		if (nullptr != trackedObject)
+		{
+			trackedObject->current.enabled = initiallyEnabled;
+			trackedObject->initial.enabled = initiallyEnabled;
+		}
+	}
+
+	void VirtualTerminalClientStateTracker::remove_tracked_enable_state(std::uint16_t objectId)
+	{
+		remove_tracked_state(objectId, TrackedState::Enabled, "remove_tracked_enable_state");
+	}
+
+	bool VirtualTerminalClientStateTracker::is_object_enabled(std::uint16_t objectId) const
+	{
+		const TrackedObject *trackedObject = get_tracked_object(objectId, TrackedState::Enabled);
+		if (nullptr == trackedObject)
+		{
+			LOG_WARNING("[VTStateHelper] is_object_enabled: objectId '%lu' not tracked", objectId);
+			return false;
+		}
+
+		return trackedObject->current.enabled;
+	}
+
+	void VirtualTerminalClientStateTracker::add_tracked_position(std::uint16_t objectId, std::uint16_t parentId, std::uint16_t initialX, std::uint16_t initialY)
+	{
+		TrackedObject *trackedObject = add_tracked_state(objectId, TrackedState::Position, "add_tracked_position");
+		if (nullptr != trackedObject)
+		{
+			trackedObject->parentId = parentId;
+			trackedObject->current.xPosition = initialX;
+			trackedObject->current.yPosition = initialY;
+			trackedObject->initial.xPosition = initialX;
+			trackedObject->initial.yPosition = initialY;
+		}
+	}
+
+	void VirtualTerminalClientStateTracker::remove_tracked_position(std::uint16_t objectId)
+	{
+		remove_tracked_state(objectId, TrackedState::Position, "remove_tracked_position");
+	}
+
+	std::pair<std::uint16_t, std::uint16_t> VirtualTerminalClientStateTracker::get_position(std::uint16_t objectId) const
+	{
+		const TrackedObject *trackedObject = get_tracked_object(objectId, TrackedState::Position);
+		if (nullptr == trackedObject)
+		{
+			LOG_WARNING("[VTStateHelper] get_position: objectId '%lu' not tracked", objectId);
+			return std::make_pair<std::uint16_t, std::uint16_t>(0, 0);
+		}
+
+		return std::make_pair(trackedObject->current.xPosition, trackedObject->current.yPosition);
+	}
+
+	void VirtualTerminalClientStateTracker::add_tracked_size(std::uint16_t objectId, std::uint16_t initialWidth, std::uint16_t initialHeight)
+	{
+		TrackedObject *trackedObject = add_tracked_state(objectId, TrackedState::Size, "add_tracked_size");
+		if (nullptr != trackedObject)
+		{
+			trackedObject->current.width = initialWidth;
+			trackedObject->current.height = initialHeight;
+			trackedObject->initial.width = initialWidth;
+			trackedObject->initial.height = initialHeight;
+		}
+	}
+
+	void VirtualTerminalClientStateTracker::remove_tracked_size(std::uint16_t objectId)
+	{
+		remove_tracked_state(objectId, TrackedState::Size, "remove_tracked_size");
+	}
+
+	std::pair<std::uint16_t, std::uint16_t> VirtualTerminalClientStateTracker::get_size(std::uint16_t objectId) const
+	{
+		const TrackedObject *trackedObject = get_tracked_object(objectId, TrackedState::Size);
+		if (nullptr == trackedObject)
+		{
+			LOG_WARNING("[VTStateHelper] get_size: objectId '%lu' not tracked", objectId);
+			return std::make_pair<std::uint16_t, std::uint16_t>(0, 0);
+		}
+
+		return std::make_pair(trackedObject->current.width, trackedObject->current.height);
+	}
+
+	void VirtualTerminalClientStateTracker::add_tracked_background_colour(std::uint16_t objectId, std::uint8_t initialColour)
+	{
+		TrackedObject *trackedObject = add_tracked_state(objectId, TrackedState::BackgroundColour, "add_tracked_background_colour");
+		if (nullptr != trackedObject)
+		{
+			trackedObject->current.backgroundColour = initialColour;
+			trackedObject->initial.backgroundColour = initialColour;
+		}
+	}
+
+	void VirtualTerminalClientStateTracker::remove_tracked_background_colour(std::uint16_t objectId)
+	{
+		remove_tracked_state(objectId, TrackedState::BackgroundColour, "remove_tracked_background_colour");
+	}
+
+	std::uint8_t VirtualTerminalClientStateTracker::get_background_colour(std::uint16_t objectId) const
+	{
+		const TrackedObject *trackedObject = get_tracked_object(objectId, TrackedState::BackgroundColour);
+		if (nullptr == trackedObject)
+		{
+			LOG_WARNING("[VTStateHelper] get_background_colour: objectId '%lu' not tracked", objectId);
+			return 0;
+		}
+
+		return trackedObject->current.backgroundColour;
+	}
+
+	void VirtualTerminalClientStateTracker::add_tracked_string_value(std::uint16_t objectId, const std::string &initialValue)
+	{
+		bool inserted = false;
+		TrackedStringValue &stringValue = find_or_insert_state(stringValueStates, objectId, inserted);
+		if (!inserted)
+		{
+			LOG_WARNING("[VTStateHelper] add_tracked_string_value: objectId '%lu' already tracked", objectId);
 			return;
 		}
 
-		numericValueStates[objectId] = initialValue;
+		stringValue.current = initialValue;
+		stringValue.initial = initialValue;
 	}
 
-	void VirtualTerminalClientStateTracker::remove_tracked_numeric_value(std::uint16_t objectId)
+	void VirtualTerminalClientStateTracker::remove_tracked_string_value(std::uint16_t objectId)
 	{
-		if (numericValueStates.find(objectId) == numericValueStates.end())
+		auto stringValue = find_state(stringValueStates, objectId);
+		if (stringValue == stringValueStates.end())
 		{
-			LOG_WARNING("[VTStateHelper] remove_tracked_numeric_value: objectId '%lu' was not tracked", objectId);
+			LOG_WARNING("[VTStateHelper] remove_tracked_string_value: objectId '%lu' was not tracked", objectId);
 			return;
 		}
 
-		numericValueStates.erase(objectId);
+		stringValueStates.erase(stringValue);
 	}
 
-	std::uint32_t VirtualTerminalClientStateTracker::get_numeric_value(std::uint16_t objectId) const
+	std::string VirtualTerminalClientStateTracker::get_string_value(std::uint16_t objectId) const
 	{
-		if (numericValueStates.find(objectId) == numericValueStates.end())
+		auto stringValue = find_state(stringValueStates, objectId);
+		if (stringValue == stringValueStates.end())
 		{
-			LOG_WARNING("[VTStateHelper] get_numeric_value: objectId '%lu' not tracked", objectId);
-			return 0;
+			LOG_WARNING("[VTStateHelper] get_string_value: objectId '%lu' not tracked", objectId);
+			return std::string();
+		}
+
+		return stringValue->current;
+	}
+
+	void VirtualTerminalClientStateTracker::add_tracked_list_item(std::uint16_t objectId, std::uint8_t index, std::uint16_t initialItem)
+	{
+		bool inserted = false;
+		TrackedListItem &listItem = find_or_insert_state(listItemStates, (static_cast<std::uint32_t>(objectId) << 8) | index, inserted);
+		if (!inserted)
+		{
+			LOG_WARNING("[VTStateHelper] add_tracked_list_item: index '%lu' of objectId '%lu' already tracked", index, objectId);
+			return;
+		}
+
+		listItem.current = initialItem;
+		listItem.initial = initialItem;
+	}
+
+	void VirtualTerminalClientStateTracker::remove_tracked_list_item(std::uint16_t objectId, std::uint8_t index)
+	{
+		auto listItem = find_state(listItemStates, (static_cast<std::uint32_t>(objectId) << 8) | index);
+		if (listItem == listItemStates.end())
+		{
+			LOG_WARNING("[VTStateHelper] remove_tracked_list_item: index '%lu' of objectId '%lu' was not tracked", index, objectId);
+			return;
+		}
+
+		listItemStates.erase(listItem);
+	}
+
+	std::uint16_t VirtualTerminalClientStateTracker::get_list_item(std::uint16_t objectId, std::uint8_t index) const
+	{
+		auto listItem = find_state(listItemStates, (static_cast<std::uint32_t>(objectId) << 8) | index);
+		if (listItem == listItemStates.end())
+		{
+			LOG_WARNING("[VTStateHelper] get_list_item: index '%lu' of objectId '%lu' not tracked", index, objectId);
+			return NULL_OBJECT_ID;
 		}
 
-		return numericValueStates.at(objectId);
+		return listItem->current;
+	}
+
+	std::uint16_t VirtualTerminalClientStateTracker::get_selected_input_object() const
+	{
+		return selectedInputObject;
 	}
 
 	std::uint16_t VirtualTerminalClientStateTracker::get_active_mask() const
@@ -103,6 +318,7 @@ namespace isobus
 		}
 
 		softKeyMasks[dataOrAlarmMaskId] = initialSoftKeyMaskId;
+		initialSoftKeyMasks[dataOrAlarmMaskId] = initialSoftKeyMaskId;
 	}
 
 	void VirtualTerminalClientStateTracker::remove_tracked_soft_key_mask(std::uint16_t dataOrAlarmMaskId)
@@ -114,6 +330,7 @@ namespace isobus
 		}
 
 		softKeyMasks.erase(dataOrAlarmMaskId);
+		initialSoftKeyMasks.erase(dataOrAlarmMaskId);
 	}
 
 	std::uint16_t VirtualTerminalClientStateTracker::get_active_soft_key_mask() const
@@ -145,55 +362,93 @@ namespace isobus
 
 	void VirtualTerminalClientStateTracker::add_tracked_attribute(std::uint16_t objectId, std::uint8_t attribute, std::uint32_t initialValue)
 	{
-		if (attributeStates.find(objectId) == attributeStates.end())
-		{
-			attributeStates[objectId] = {};
-		}
-
-		auto &attributeMap = attributeStates.at(objectId);
-		if (attributeMap.find(attribute) != attributeMap.end())
+		bool inserted = false;
+		TrackedAttribute &trackedAttribute = find_or_insert_state(attributeStates, (static_cast<std::uint32_t>(objectId) << 8) | attribute, inserted);
+		if (!inserted)
 		{
 			LOG_WARNING("[VTStateHelper] add_tracked_attribute: attribute '%lu' of objectId '%lu' already tracked", attribute, objectId);
 			return;
 		}
 
-		attributeMap[attribute] = initialValue;
+		trackedAttribute.current = initialValue;
+		trackedAttribute.initial = initialValue;
 	}
 
 	void VirtualTerminalClientStateTracker::remove_tracked_attribute(std::uint16_t objectId, std::uint8_t attribute)
 	{
-		if (attributeStates.find(objectId) == attributeStates.end())
-		{
-			LOG_WARNING("[VTStateHelper] remove_tracked_attribute: objectId '%lu' was not tracked", objectId);
-			return;
-		}
-
-		auto &attributeMap = attributeStates.at(objectId);
-		if (attributeMap.find(attribute) == attributeMap.end())
+		auto trackedAttribute = find_state(attributeStates, (static_cast<std::uint32_t>(objectId) << 8) | attribute);
+		if (trackedAttribute == attributeStates.end())
 		{
 			LOG_WARNING("[VTStateHelper] remove_tracked_attribute: attribute '%lu' of objectId '%lu' was not tracked", attribute, objectId);
 			return;
 		}
 
-		attributeMap.erase(attribute);
+		attributeStates.erase(trackedAttribute);
 	}
 
 	std::uint32_t VirtualTerminalClientStateTracker::get_attribute(std::uint16_t objectId, std::uint8_t attribute) const
 	{
-		if (attributeStates.find(objectId) == attributeStates.end())
+		auto trackedAttribute = find_state(attributeStates, (static_cast<std::uint32_t>(objectId) << 8) | attribute);
+		if (trackedAttribute == attributeStates.end())
 		{
-			LOG_WARNING("[VTStateHelper] get_attribute: objectId '%lu' not tracked", objectId);
+			LOG_WARNING("[VTStateHelper] get_attribute: attribute '%lu' of objectId '%lu' not tracked", attribute, objectId);
 			return 0;
 		}
 
-		const auto &attributeMap = attributeStates.at(objectId);
-		if (attributeMap.find(attribute) == attributeMap.end())
+		return trackedAttribute->current;
+	}
+
+	VirtualTerminalClientStateTracker::TrackedObject *VirtualTerminalClientStateTracker::get_tracked_object(std::uint16_t objectId, TrackedState state)
+	{
+		auto trackedObject = find_state(trackedObjects, objectId);
+		if ((trackedObject == trackedObjects.end()) ||
+		    (0 == (trackedObject->trackedStates & static_cast<std::uint8_t>(state))))
 		{
-			LOG_WARNING("[VTStateHelper] get_attribute: attribute '%lu' of objectId '%lu' not tracked", attribute, objectId);
-			return 0;
+			return nullptr;
+		}
+		return &(*trackedObject);
+	}
+
+	const VirtualTerminalClientStateTracker::TrackedObject *VirtualTerminalClientStateTracker::get_tracked_object(std::uint16_t objectId, TrackedState state) const
+	{
+		auto trackedObject = find_state(trackedObjects, objectId);
+		if ((trackedObject == trackedObjects.end()) ||
+		    (0 == (trackedObject->trackedStates & static_cast<std::uint8_t>(state))))
+		{
+			return nullptr;
+		}
+		return &(*trackedObject);
+	}
+
+	VirtualTerminalClientStateTracker::TrackedObject *VirtualTerminalClientStateTracker::add_tracked_state(std::uint16_t objectId, TrackedState state, const char *functionName)
+	{
+		bool inserted = false;
+		TrackedObject &trackedObject = find_or_insert_state(trackedObjects, objectId, inserted);
+		if (0 != (trackedObject.trackedStates & static_cast<std::uint8_t>(state)))
+		{
+			LOG_WARNING("[VTStateHelper] %s: objectId '%lu' already tracked", functionName, objectId);
+			return nullptr;
+		}
+
+		trackedObject.trackedStates |= static_cast<std::uint8_t>(state);
+		return &trackedObject;
+	}
+
+	void VirtualTerminalClientStateTracker::remove_tracked_state(std::uint16_t objectId, TrackedState state, const char *functionName)
+	{
+		auto trackedObject = find_state(trackedObjects, objectId);
+		if ((trackedObject == trackedObjects.end()) ||
+		    (0 == (trackedObject->trackedStates & static_cast<std::uint8_t>(state))))
+		{
+			LOG_WARNING("[VTStateHelper] %s: objectId '%lu' was not tracked", functionName, objectId);
+			return;
 		}
 
-		return attributeMap.at(attribute);
+		trackedObject->trackedStates &= static_cast<std::uint8_t>(~static_cast<std::uint8_t>(state));
+		if (0 == trackedObject->trackedStates)
+		{
+			trackedObjects.erase(trackedObject);
+		}
 	}
 
 	void VirtualTerminalClientStateTracker::cache_active_mask(std::uint16_t maskId)
@@ -310,11 +565,10 @@ namespace isobus
 					auto errorCode = message.get_uint8_at(3);
 					if (errorCode == 0)
 					{
-						std::uint16_t objectId = message.get_uint16_at(1);
-						if (numericValueStates.find(objectId) != numericValueStates.end())
+						TrackedObject *trackedObject = get_tracked_object(message.get_uint16_at(1), TrackedState::NumericValue);
+						if (nullptr != trackedObject)
 						{
-							std::uint32_t value = message.get_uint32_at(4);
-							numericValueStates[objectId] = value;
+							trackedObject->current.numericValue = message.get_uint32_at(4);
 						}
 					}
 				}
@@ -322,14 +576,125 @@ namespace isobus
 			break;
 
 			case static_cast<std::uint8_t>(VirtualTerminalClient::Function::VTChangeNumericValueMessage):
+			{
+				if (CAN_DATA_LENGTH == message.get_data_length())
+				{
+					TrackedObject *trackedObject = get_tracked_object(message.get_uint16_at(1), TrackedState::NumericValue);
+					if (nullptr != trackedObject)
+					{
+						trackedObject->current.numericValue = message.get_uint32_at(4);
+					}
+				}
+			}
+			break;
+
+			case static_cast<std::uint8_t>(VirtualTerminalClient::Function::HideShowObjectCommand):
+			{
+				if (CAN_DATA_LENGTH == message.get_data_length())
+				{
+					auto errorCode = message.get_uint8_at(4);
+					if (errorCode == 0)
+					{
+						TrackedObject *trackedObject = get_tracked_object(message.get_uint16_at(1), TrackedState::Shown);
+						if (nullptr != trackedObject)
+						{
+							trackedObject->current.shown = (0 != message.get_uint8_at(3));
+						}
+					}
+				}
+			}
+			break;
+
+			case static_cast<std::uint8_t>(VirtualTerminalClient::Function::EnableDisableObjectCommand):
+			{
+				if (CAN_DATA_LENGTH == message.get_data_length())
+				{
+					auto errorCode = message.get_uint8_at(4);
+					if (errorCode == 0)
+					{
+						TrackedObject *trackedObject = get_tracked_object(message.get_uint16_at(1), TrackedState::Enabled);
+						if (nullptr != trackedObject)
+						{
+							trackedObject->current.enabled = (0 != message.get_uint8_at(3));
+						}
+					}
+				}
+			}
+			break;
+
+			case static_cast<std::uint8_t>(VirtualTerminalClient::Function::SelectInputObjectCommand):
+			{
+				if (CAN_DATA_LENGTH == message.get_data_length())
+				{
+					auto errorCode = message.get_uint8_at(4);
+					if ((errorCode == 0) && (0 != message.get_uint8_at(3)))
+					{
+						selectedInputObject = message.get_uint16_at(1);
+					}
+				}
+			}
+			break;
+
+			case static_cast<std::uint8_t>(VirtualTerminalClient::Function::VTSelectInputObjectMessage):
 			{
 				if (CAN_DATA_LENGTH == message.get_data_length())
 				{
 					std::uint16_t objectId = message.get_uint16_at(1);
-					if (numericValueStates.find(objectId) != numericValueStates.end())
+					if (0x01 == message.get_uint8_at(3))
 					{
-						std::uint32_t value = message.get_uint32_at(4);
-						numericValueStates[objectId] = value;
+						selectedInputObject = objectId;
+					}
+					else if (selectedInputObject == objectId)
+					{
+						selectedInputObject = NULL_OBJECT_ID;
+					}
+				}
+			}
+			break;
+
+			case static_cast<std::uint8_t>(VirtualTerminalClient::Function::ChangeBackgroundColourCommand):
+			{
+				if (CAN_DATA_LENGTH == message.get_data_length())
+				{
+					auto errorCode = message.get_uint8_at(4);
+					if (errorCode == 0)
+					{
+						TrackedObject *trackedObject = get_tracked_object(message.get_uint16_at(1), TrackedState::BackgroundColour);
+						if (nullptr != trackedObject)
+						{
+							trackedObject->current.backgroundColour = message.get_uint8_at(3);
+						}
+					}
+				}
+			}
+			break;
+
+			case static_cast<std::uint8_t>(VirtualTerminalClient::Function::ChangeListItemCommand):
+			{
+				if (CAN_DATA_LENGTH == message.get_data_length())
+				{
+					auto errorCode = message.get_uint8_at(6);
+					if (errorCode == 0)
+					{
+						auto listItem = find_state(listItemStates, (static_cast<std::uint32_t>(message.get_uint16_at(1)) << 8) | message.get_uint8_at(3));
+						if (listItem != listItemStates.end())
+						{
+							listItem->current = message.get_uint16_at(4);
+						}
+					}
+				}
+			}
+			break;
+
+			case static_cast<std::uint8_t>(VirtualTerminalClient::Function::VTChangeStringValueMessage):
+			{
+				if (message.get_data_length() >= 4)
+				{
+					auto stringValue = find_state(stringValueStates, message.get_uint16_at(1));
+					std::uint8_t stringLength = message.get_uint8_at(3);
+					if ((stringValue != stringValueStates.end()) && (message.get_data_length() >= (4u + stringLength)))
+					{
+						stringValue->current.assign(message.get_data().begin() + 4, message.get_data().begin() + 4 + stringLength);
 					}
 				}
 			}
@@ -344,17 +709,19 @@ namespace isobus
 					{
 						std::uint16_t objectId = message.get_uint16_at(1);
 						std::uint8_t attribute = message.get_uint8_at(3);
-						std::uint8_t error = message.get_uint8_at(4);
 
-						if (pendingChangeAttributeCommands.find(message.get_destination_control_function()) != pendingChangeAttributeCommands.end())
+						auto pendingCommand = pendingChangeAttributeCommands.find(message.get_destination_control_function());
+						if (pendingCommand != pendingChangeAttributeCommands.end())
 						{
-							const auto &pendingCommand = pendingChangeAttributeCommands.at(message.get_source_control_function());
-							if ((pendingCommand.objectId == objectId) && (pendingCommand.attribute == attribute) && (0 == error))
+							if ((pendingCommand->second.objectId == objectId) && (pendingCommand->second.attribute == attribute))
 							{
-								std::uint32_t value = message.get_uint32_at(5);
-								attributeStates[objectId][attribute] = value;
+								auto trackedAttribute = find_state(attributeStates, (static_cast<std::uint32_t>(objectId) << 8) | attribute);
+								if (trackedAttribute != attributeStates.end())
+								{
+									trackedAttribute->current = pendingCommand->second.value;
+								}
 							}
-							pendingChangeAttributeCommands.erase(message.get_destination_control_function());
+							pendingChangeAttributeCommands.erase(pendingCommand);
 						}
 					}
 				}
@@ -379,8 +746,7 @@ namespace isobus
 					std::uint8_t attribute = message.get_uint8_at(3);
 
 					// Only track the change if the attribute should be tracked
-					if ((attributeStates.find(objectId) != attributeStates.end()) &&
-					    (attributeStates.at(objectId).find(attribute) != attributeStates.at(objectId).end()))
+					if (find_state(attributeStates, (static_cast<std::uint32_t>(objectId) << 8) | attribute) != attributeStates.end())
 					{
 						std::uint32_t value = message.get_uint32_at(4);
 						pendingChangeAttributeCommands[message.get_source_control_function()] = { value, objectId, attribute };
@@ -389,6 +755,49 @@ namespace isobus
 			}
 			break;
 
+			// The responses to the following commands don't repeat the new state, so it's taken from the command itself
+			case static_cast<std::uint8_t>(VirtualTerminalClient::Function::ChangeChildPositionCommand):
+			{
+				if (message.get_data_length() >= 9)
+				{
+					TrackedObject *trackedObject = get_tracked_object(message.get_uint16_at(3), TrackedState::Position);
+					if ((nullptr != trackedObject) && (trackedObject->parentId == message.get_uint16_at(1)))
+					{
+						trackedObject->current.xPosition = message.get_uint16_at(5);
+						trackedObject->current.yPosition = message.get_uint16_at(7);
+					}
+				}
+			}
+			break;
+
+			case static_cast<std::uint8_t>(VirtualTerminalClient::Function::ChangeSizeCommand):
+			{
+				if (message.get_data_length() >= 7)
+				{
+					TrackedObject *trackedObject = get_tracked_object(message.get_uint16_at(1), TrackedState::Size);
+					if (nullptr != trackedObject)
+					{
+						trackedObject->current.width = message.get_uint16_at(3);
+						trackedObject->current.height = message.get_uint16_at(5);
+					}
+				}
+			}
+			break;
+
+			case static_cast<std::uint8_t>(VirtualTerminalClient::Function::ChangeStringValueCommand):
+			{
+				if (message.get_data_length() >= 5)
+				{
+					auto stringValue = find_state(stringValueStates, message.get_uint16_at(1));
+					std::uint16_t stringLength = message.get_uint16_at(3);
+					if ((stringValue != stringValueStates.end()) && (message.get_data_length() >= (5u + stringLength)))
+					{
+						stringValue->current.assign(message.get_data().begin() + 5, message.get_data().begin() + 5 + stringLength);
+					}
+				}
+			}
+			break;
+
 			default:
 				break;
 		}
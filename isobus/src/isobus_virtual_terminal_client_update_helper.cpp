@@ -41,12 +41,13 @@ namespace isobus
 			LOG_ERROR("[VTStateHelper] set_numeric_value: client is nullptr");
 			return false;
 		}
-		if (numericValueStates.find(object_id) == numericValueStates.end())
+		TrackedObject *trackedObject = get_tracked_object(object_id, TrackedState::NumericValue);
+		if (nullptr == trackedObject)
 		{
 			LOG_WARNING("[VTStateHelper] set_numeric_value: objectId %lu not tracked", object_id);
 			return false;
 		}
-		if (numericValueStates.at(object_id) == value)
+		if (trackedObject->current.numericValue == value)
 		{
 			return true;
 		}
@@ -54,7 +55,7 @@ namespace isobus
 		bool success = vtClient->send_change_numeric_value(object_id, value);
 		if (success)
 		{
-			numericValueStates[object_id] = value;
+			trackedObject->current.numericValue = value;
 		}
 		return success;
 	}
@@ -76,13 +77,14 @@ namespace isobus
 
 	void VirtualTerminalClientUpdateHelper::process_numeric_value_change_event(const VirtualTerminalClient::VTChangeNumericValueEvent &event)
 	{
-		if (numericValueStates.find(event.objectID) == numericValueStates.end())
+		const TrackedObject *trackedObject = get_tracked_object(event.objectID, TrackedState::NumericValue);
+		if (nullptr == trackedObject)
 		{
 			// Only proccess numeric value changes for tracked objects.
 			return;
 		}
 
-		if (numericValueStates.at(event.objectID) == event.value)
+		if (trackedObject->current.numericValue == event.value)
 		{
 			// Do not process the event if the value has not changed.
 			return;
@@ -92,11 +94,16 @@ namespace isobus
 		if ((callbackValidateNumericValue != nullptr) && callbackValidateNumericValue(event.objectID, event.value))
 		{
 			// If the callback function returns false, reject the change by sending the previous value.
-			targetValue = numericValueStates.at(event.objectID);
+			targetValue = trackedObject->current.numericValue;
 		}
 		vtClient->send_change_numeric_value(event.objectID, targetValue);
 	}
 
+	void VirtualTerminalClientUpdateHelper::set_initial_active_mask(std::uint16_t dataOrAlarmMaskId)
+	{
+		initialDataOrAlarmMask = dataOrAlarmMaskId;
+	}
+
 	bool VirtualTerminalClientUpdateHelper::set_active_data_or_alarm_mask(std::uint16_t workingSetId, std::uint16_t dataOrAlarmMaskId)
 	{
 		if (nullptr == client)
@@ -106,6 +113,8 @@ namespace isobus
 		}
 		if (activeDataOrAlarmMask == dataOrAlarmMaskId)
 		{
+			workingSetObjectId = workingSetId;
+			selectedDataOrAlarmMask = dataOrAlarmMaskId;
 			return true;
 		}
 
@@ -113,6 +122,8 @@ namespace isobus
 		if (success)
 		{
 			activeDataOrAlarmMask = dataOrAlarmMaskId;
+			workingSetObjectId = workingSetId;
+			selectedDataOrAlarmMask = dataOrAlarmMaskId;
 		}
 		return success;
 	}
@@ -131,6 +142,7 @@ namespace isobus
 		}
 		if (softKeyMasks.at(maskId) == softKeyMaskId)
 		{
+			selectedSoftKeyMasks[maskId] = std::make_pair(maskType, softKeyMaskId);
 			return true;
 		}
 
@@ -138,6 +150,7 @@ namespace isobus
 		if (success)
 		{
 			softKeyMasks[maskId] = softKeyMaskId;
+			selectedSoftKeyMasks[maskId] = std::make_pair(maskType, softKeyMaskId);
 		}
 		return success;
 	}
@@ -149,27 +162,459 @@ namespace isobus
 			LOG_ERROR("[VTStateHelper] set_attribute: client is nullptr");
 			return false;
 		}
-		if (attributeStates.find(objectId) == attributeStates.end())
+		auto trackedAttribute = find_state(attributeStates, (static_cast<std::uint32_t>(objectId) << 8) | attribute);
+		if (trackedAttribute == attributeStates.end())
 		{
-			LOG_ERROR("[VTStateHelper] set_attribute: objectId %lu not tracked", objectId);
+			LOG_WARNING("[VTStateHelper] set_attribute: attribute %lu of objectId %lu not tracked", attribute, objectId);
 			return false;
 		}
-		if (attributeStates.at(objectId).find(attribute) == attributeStates.at(objectId).end())
+		if (trackedAttribute->current == value)
 		{
-			LOG_WARNING("[VTStateHelper] set_attribute: attribute %lu of objectId %lu not tracked", attribute, objectId);
+			return true;
+		}
+
+		bool success = vtClient->send_change_attribute(objectId, attribute, value);
+		if (success)
+		{
+			trackedAttribute->current = value;
+		}
+		return success;
+	}
+
+	bool VirtualTerminalClientUpdateHelper::set_object_shown(std::uint16_t objectId, bool shown)
+	{
+		if (nullptr == client)
+		{
+			LOG_ERROR("[VTStateHelper] set_object_shown: client is nullptr");
+			return false;
+		}
+		TrackedObject *trackedObject = get_tracked_object(objectId, TrackedState::Shown);
+		if (nullptr == trackedObject)
+		{
+			LOG_WARNING("[VTStateHelper] set_object_shown: objectId %lu not tracked", objectId);
 			return false;
 		}
-		if (attributeStates.at(objectId).at(attribute) == value)
+		if (trackedObject->current.shown == shown)
 		{
 			return true;
 		}
 
-		bool success = vtClient->send_change_attribute(objectId, attribute, value);
+		bool success = vtClient->send_hide_show_object(objectId, shown ? VirtualTerminalClient::HideShowObjectCommand::ShowObject : VirtualTerminalClient::HideShowObjectCommand::HideObject);
+		if (success)
+		{
+			trackedObject->current.shown = shown;
+		}
+		return success;
+	}
+
+	bool VirtualTerminalClientUpdateHelper::set_object_enabled(std::uint16_t objectId, bool enabled)
+	{
+		if (nullptr == client)
+		{
+			LOG_ERROR("[VTStateHelper] set_object_enabled: client is nullptr");
+			return false;
+		}
+		TrackedObject *trackedObject = get_tracked_object(objectId, TrackedState::Enabled);
+		if (nullptr == trackedObject)
+		{
+			LOG_WARNING("[VTStateHelper] set_object_enabled: objectId %lu not tracked", objectId);
+			return false;
+		}
+		if (trackedObject->current.enabled == enabled)
+		{
+			return true;
+		}
+
+		bool success = vtClient->send_enable_disable_object(objectId, enabled ? VirtualTerminalClient::EnableDisableObjectCommand::EnableObject : VirtualTerminalClient::EnableDisableObjectCommand::DisableObject);
+		if (success)
+		{
+			trackedObject->current.enabled = enabled;
+		}
+		return success;
+	}
+
+	bool VirtualTerminalClientUpdateHelper::set_position(std::uint16_t objectId, std::uint16_t xPosition, std::uint16_t yPosition)
+	{
+		if (nullptr == client)
+		{
+			LOG_ERROR("[VTStateHelper] set_position: client is nullptr");
+			return false;
+		}
+		TrackedObject *trackedObject = get_tracked_object(objectId, TrackedState::Position);
+		if (nullptr == trackedObject)
+		{
+			LOG_WARNING("[VTStateHelper] set_position: objectId %lu not tracked", objectId);
+			return false;
+		}
+		if ((trackedObject->current.xPosition == xPosition) && (trackedObject->current.yPosition == yPosition))
+		{
+			return true;
+		}
+
+		bool success = vtClient->send_change_child_position(objectId, trackedObject->parentId, xPosition, yPosition);
+		if (success)
+		{
+			trackedObject->current.xPosition = xPosition;
+			trackedObject->current.yPosition = yPosition;
+		}
+		return success;
+	}
+
+	bool VirtualTerminalClientUpdateHelper::set_size(std::uint16_t objectId, std::uint16_t width, std::uint16_t height)
+	{
+		if (nullptr == client)
+		{
+			LOG_ERROR("[VTStateHelper] set_size: client is nullptr");
+			return false;
+		}
+		TrackedObject *trackedObject = get_tracked_object(objectId, TrackedState::Size);
+		if (nullptr == trackedObject)
+		{
+			LOG_WARNING("[VTStateHelper] set_size: objectId %lu not tracked", objectId);
+			return false;
+		}
+		if ((trackedObject->current.width == width) && (trackedObject->current.height == height))
+		{
+			return true;
+		}
+
+		bool success = vtClient->send_change_size_command(objectId, width, height);
+		if (success)
+		{
+			trackedObject->current.width = width;
+			trackedObject->current.height = height;
+		}
+		return success;
+	}
+
+	bool VirtualTerminalClientUpdateHelper::set_background_colour(std::uint16_t objectId, std::uint8_t colour)
+	{
+		if (nullptr == client)
+		{
+			LOG_ERROR("[VTStateHelper] set_background_colour: client is nullptr");
+			return false;
+		}
+		TrackedObject *trackedObject = get_tracked_object(objectId, TrackedState::BackgroundColour);
+		if (nullptr == trackedObject)
+		{
+			LOG_WARNING("[VTStateHelper] set_background_colour: objectId %lu not tracked", objectId);
+			return false;
+		}
+		if (trackedObject->current.backgroundColour == colour)
+		{
+			return true;
+		}
+
+		bool success = vtClient->send_change_background_colour(objectId, colour);
+		if (success)
+		{
+			trackedObject->current.backgroundColour = colour;
+		}
+		return success;
+	}
+
+	bool VirtualTerminalClientUpdateHelper::set_string_value(std::uint16_t objectId, const std::string &value)
+	{
+		if (nullptr == client)
+		{
+			LOG_ERROR("[VTStateHelper] set_string_value: client is nullptr");
+			return false;
+		}
+		auto stringValue = find_state(stringValueStates, objectId);
+		if (stringValue == stringValueStates.end())
+		{
+			LOG_WARNING("[VTStateHelper] set_string_value: objectId %lu not tracked", objectId);
+			return false;
+		}
+		if (stringValue->current == value)
+		{
+			return true;
+		}
+
+		bool success = vtClient->send_change_string_value(objectId, value);
+		if (success)
+		{
+			stringValue->current = value;
+		}
+		return success;
+	}
+
+	bool VirtualTerminalClientUpdateHelper::set_list_item(std::uint16_t objectId, std::uint8_t index, std::uint16_t item)
+	{
+		if (nullptr == client)
+		{
+			LOG_ERROR("[VTStateHelper] set_list_item: client is nullptr");
+			return false;
+		}
+		auto listItem = find_state(listItemStates, (static_cast<std::uint32_t>(objectId) << 8) | index);
+		if (listItem == listItemStates.end())
+		{
+			LOG_WARNING("[VTStateHelper] set_list_item: index %lu of objectId %lu not tracked", index, objectId);
+			return false;
+		}
+		if (listItem->current == item)
+		{
+			return true;
+		}
+
+		bool success = vtClient->send_change_list_item(objectId, index, item);
 		if (success)
 		{
-			attributeStates[objectId][attribute] = value;
+			listItem->current = item;
 		}
 		return success;
 	}
 
+	bool VirtualTerminalClientUpdateHelper::apply_desired_state(const DesiredState &desiredState)
+	{
+		bool retVal = true;
+
+		for (const auto &entry : desiredState.entries)
+		{
+			bool success = false;
+
+			switch (entry.type)
+			{
+				case DesiredState::StateType::NumericValue:
+				{
+					success = set_numeric_value(entry.objectId, entry.value);
+				}
+				break;
+
+				case DesiredState::StateType::Shown:
+				{
+					success = set_object_shown(entry.objectId, 0 != entry.value);
+				}
+				break;
+
+				case DesiredState::StateType::Enabled:
+				{
+					success = set_object_enabled(entry.objectId, 0 != entry.value);
+				}
+				break;
+
+				case DesiredState::StateType::Position:
+				{
+					success = set_position(entry.objectId, static_cast<std::uint16_t>(entry.value & 0xFFFF), static_cast<std::uint16_t>(entry.value >> 16));
+				}
+				break;
+
+				case DesiredState::StateType::Size:
+				{
+					success = set_size(entry.objectId, static_cast<std::uint16_t>(entry.value & 0xFFFF), static_cast<std::uint16_t>(entry.value >> 16));
+				}
+				break;
+
+				case DesiredState::StateType::BackgroundColour:
+				{
+					success = set_background_colour(entry.objectId, static_cast<std::uint8_t>(entry.value));
+				}
+				break;
+
+				case DesiredState::StateType::StringValue:
+				{
+					success = set_string_value(entry.objectId, desiredState.stringValues[entry.value]);
+				}
+				break;
+
+				case DesiredState::StateType::ListItem:
+				{
+					success = set_list_item(entry.objectId, entry.subId, static_cast<std::uint16_t>(entry.value));
+				}
+				break;
+
+				case DesiredState::StateType::Attribute:
+				{
+					success = set_attribute(entry.objectId, entry.subId, entry.value);
+				}
+				break;
+
+				case DesiredState::StateType::ActiveMask:
+				{
+					success = set_active_data_or_alarm_mask(static_cast<std::uint16_t>(entry.value >> 16), static_cast<std::uint16_t>(entry.value & 0xFFFF));
+				}
+				break;
+			}
+			retVal = retVal && success;
+		}
+		return retVal;
+	}
+
+	bool VirtualTerminalClientUpdateHelper::restore_tracked_state()
+	{
+		if (nullptr == client)
+		{
+			LOG_ERROR("[VTStateHelper] restore_tracked_state: client is nullptr");
+			return false;
+		}
+
+		bool retVal = true;
+		for (const auto &trackedObject : trackedObjects)
+		{
+			const std::uint16_t objectId = static_cast<std::uint16_t>(trackedObject.key);
+			const ObjectStates &current = trackedObject.current;
+			const ObjectStates &initial = trackedObject.initial;
+
+			if ((0 != (trackedObject.trackedStates & static_cast<std::uint8_t>(TrackedState::NumericValue))) &&
+			    (current.numericValue != initial.numericValue))
+			{
+				retVal = vtClient->send_change_numeric_value(objectId, current.numericValue) && retVal;
+			}
+			if ((0 != (trackedObject.trackedStates & static_cast<std::uint8_t>(TrackedState::Shown))) &&
+			    (current.shown != initial.shown))
+			{
+				retVal = vtClient->send_hide_show_object(objectId, current.shown ? VirtualTerminalClient::HideShowObjectCommand::ShowObject : VirtualTerminalClient::HideShowObjectCommand::HideObject) && retVal;
+			}
+			if ((0 != (trackedObject.trackedStates & static_cast<std::uint8_t>(TrackedState::Enabled))) &&
+			    (current.enabled != initial.enabled))
+			{
+				retVal = vtClient->send_enable_disable_object(objectId, current.enabled ? VirtualTerminalClient::EnableDisableObjectCommand::EnableObject : VirtualTerminalClient::EnableDisableObjectCommand::DisableObject) && retVal;
+			}
+			if ((0 != (trackedObject.trackedStates & static_cast<std::uint8_t>(TrackedState::Position))) &&
+			    ((current.xPosition != initial.xPosition) || (current.yPosition != initial.yPosition)))
+			{
+				retVal = vtClient->send_change_child_position(objectId, trackedObject.parentId, current.xPosition, current.yPosition) && retVal;
+			}
+			if ((0 != (trackedObject.trackedStates & static_cast<std::uint8_t>(TrackedState::Size))) &&
+			    ((current.width != initial.width) || (current.height != initial.height)))
+			{
+				retVal = vtClient->send_change_size_command(objectId, current.width, current.height) && retVal;
+			}
+			if ((0 != (trackedObject.trackedStates & static_cast<std::uint8_t>(TrackedState::BackgroundColour))) &&
+			    (current.backgroundColour != initial.backgroundColour))
+			{
+				retVal = vtClient->send_change_background_colour(objectId, current.backgroundColour) && retVal;
+			}
+		}
+
+		for (const auto &trackedAttribute : attributeStates)
+		{
+			if (trackedAttribute.current != trackedAttribute.initial)
+			{
+				retVal = vtClient->send_change_attribute(static_cast<std::uint16_t>(trackedAttribute.key >> 8), static_cast<std::uint8_t>(trackedAttribute.key & 0xFF), trackedAttribute.current) && retVal;
+			}
+		}
+
+		for (const auto &listItem : listItemStates)
+		{
+			if (listItem.current != listItem.initial)
+			{
+				retVal = vtClient->send_change_list_item(static_cast<std::uint16_t>(listItem.key >> 8), static_cast<std::uint8_t>(listItem.key & 0xFF), listItem.current) && retVal;
+			}
+		}
+
+		for (const auto &stringValue : stringValueStates)
+		{
+			if (stringValue.current != stringValue.initial)
+			{
+				retVal = vtClient->send_change_string_value(static_cast<std::uint16_t>(stringValue.key), stringValue.current) && retVal;
+			}
+		}
+
+		// Status messages from the reloaded pool overwrite the tracked masks, so the masks last set through this helper are restored instead
+		if ((NULL_OBJECT_ID != selectedDataOrAlarmMask) && (selectedDataOrAlarmMask != initialDataOrAlarmMask))
+		{
+			retVal = vtClient->send_change_active_mask(workingSetObjectId, selectedDataOrAlarmMask) && retVal;
+		}
+
+		for (const auto &selectedSoftKeyMask : selectedSoftKeyMasks)
+		{
+			auto initialSoftKeyMask = initialSoftKeyMasks.find(selectedSoftKeyMask.first);
+
+			if ((initialSoftKeyMasks.end() != initialSoftKeyMask) &&
+			    (initialSoftKeyMask->second != selectedSoftKeyMask.second.second))
+			{
+				retVal = vtClient->send_change_softkey_mask(selectedSoftKeyMask.second.first, selectedSoftKeyMask.first, selectedSoftKeyMask.second.second) && retVal;
+			}
+		}
+		return retVal;
+	}
+
+	void VirtualTerminalClientUpdateHelper::DesiredState::set_numeric_value(std::uint16_t objectId, std::uint32_t value)
+	{
+		set(StateType::NumericValue, objectId, 0, value);
+	}
+
+	void VirtualTerminalClientUpdateHelper::DesiredState::set_shown(std::uint16_t objectId, bool shown)
+	{
+		set(StateType::Shown, objectId, 0, shown ? 1 : 0);
+	}
+
+	void VirtualTerminalClientUpdateHelper::DesiredState::set_enabled(std::uint16_t objectId, bool enabled)
+	{
+		set(StateType::Enabled, objectId, 0, enabled ? 1 : 0);
+	}
+
+	void VirtualTerminalClientUpdateHelper::DesiredState::set_position(std::uint16_t objectId, std::uint16_t xPosition, std::uint16_t yPosition)
+	{
+		set(StateType::Position, objectId, 0, static_cast<std::uint32_t>(xPosition) | (static_cast<std::uint32_t>(yPosition) << 16));
+	}
+
+	void VirtualTerminalClientUpdateHelper::DesiredState::set_size(std::uint16_t objectId, std::uint16_t width, std::uint16_t height)
+	{
+		set(StateType::Size, objectId, 0, static_cast<std::uint32_t>(width) | (static_cast<std::uint32_t>(height) << 16));
+	}
+
+	void VirtualTerminalClientUpdateHelper::DesiredState::set_background_colour(std::uint16_t objectId, std::uint8_t colour)
+	{
+		set(StateType::BackgroundColour, objectId, 0, colour);
+	}
+
+	void VirtualTerminalClientUpdateHelper::DesiredState::set_string_value(std::uint16_t objectId, const std::string &value)
+	{
+		Entry &entry = set(StateType::StringValue, objectId, 0, static_cast<std::uint32_t>(stringValues.size()));
+		if (entry.value == stringValues.size())
+		{
+			stringValues.push_back(value);
+		}
+		else
+		{
+			stringValues[entry.value] = value;
+		}
+	}
+
+	void VirtualTerminalClientUpdateHelper::DesiredState::set_list_item(std::uint16_t objectId, std::uint8_t index, std::uint16_t item)
+	{
+		set(StateType::ListItem, objectId, index, item);
+	}
+
+	void VirtualTerminalClientUpdateHelper::DesiredState::set_attribute(std::uint16_t objectId, std::uint8_t attribute, std::uint32_t value)
+	{
+		set(StateType::Attribute, objectId, attribute, value);
+	}
+
+	void VirtualTerminalClientUpdateHelper::DesiredState::set_active_data_or_alarm_mask(std::uint16_t workingSetId, std::uint16_t dataOrAlarmMaskId)
+	{
+		// There is only one active mask, so it isn't keyed by an object
+		set(StateType::ActiveMask, NULL_OBJECT_ID, 0, static_cast<std::uint32_t>(dataOrAlarmMaskId) | (static_cast<std::uint32_t>(workingSetId) << 16));
+	}
+
+	void VirtualTerminalClientUpdateHelper::DesiredState::clear()
+	{
+		entries.clear();
+		stringValues.clear();
+	}
+
+	std::size_t VirtualTerminalClientUpdateHelper::DesiredState::size() const
+	{
+		return entries.size();
+	}
+
+	VirtualTerminalClientUpdateHelper::DesiredState::Entry &VirtualTerminalClientUpdateHelper::DesiredState::set(StateType type, std::uint16_t objectId, std::uint8_t subId, std::uint32_t value)
+	{
+		for (auto &entry : entries)
+		{
+			if ((entry.type == type) && (entry.objectId == objectId) && (entry.subId == subId))
+			{
+				if (StateType::StringValue != type)
+				{
+					entry.value = value;
+				}
+				return entry;
+			}
+		}
+		entries.push_back({ value, objectId, type, subId });
+		return entries.back();
+	}
+
 } // namespace isobus
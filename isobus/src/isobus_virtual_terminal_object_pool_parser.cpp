@@ -0,0 +1,1027 @@
+//================================================================================================
+/// @file isobus_virtual_terminal_object_pool_parser.cpp
+///
+/// @brief Implements a parser that turns binary (IOP) VT object pool data into VT objects.
+/// @author Adrian Del Grosso
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/isobus/isobus_virtual_terminal_object_pool_parser.hpp"
+
+#include "isobus/isobus/can_stack_logger.hpp"
+#include "isobus/utility/to_string.hpp"
+
+#include <cstring>
+#include <unordered_set>
+
+namespace isobus
+{
+	namespace
+	{
+		/// @brief Reads little endian values out of a byte span, refusing to read past its end
+		/// @details Once a read would run past the end, the reader is marked as failed and every read
+		/// after that returns zero, so an object can be read field by field and checked once at the end.
+		class PoolReader
+		{
+		public:
+			PoolReader(const std::uint8_t *data, std::size_t size) :
+			  data(data),
+			  size(size)
+			{
+			}
+
+			std::uint8_t read_uint8()
+			{
+				const std::uint8_t *bytes = read_bytes(1);
+				return (nullptr != bytes) ? bytes[0] : 0;
+			}
+
+			std::uint16_t read_uint16()
+			{
+				const std::uint8_t *bytes = read_bytes(2);
+				return (nullptr != bytes) ? static_cast<std::uint16_t>(static_cast<std::uint16_t>(bytes[0]) | (static_cast<std::uint16_t>(bytes[1]) << 8)) : 0;
+			}
+
+			std::int16_t read_int16()
+			{
+				return static_cast<std::int16_t>(read_uint16());
+			}
+
+			std::uint32_t read_uint32()
+			{
+				const std::uint8_t *bytes = read_bytes(4);
+				std::uint32_t retVal = 0;
+
+				if (nullptr != bytes)
+				{
+					retVal = (static_cast<std::uint32_t>(bytes[0]) |
+					          (static_cast<std::uint32_t>(bytes[1]) << 8) |
+					          (static_cast<std::uint32_t>(bytes[2]) << 16) |
+					          (static_cast<std::uint32_t>(bytes[3]) << 24));
+				}
+				return retVal;
+			}
+
+			float read_float()
+			{
+				const std::uint32_t rawValue = read_uint32();
+				float retVal;
+				memcpy(&retVal, &rawValue, sizeof(retVal));
+				return retVal;
+			}
+
+			std::string read_string(std::size_t length)
+			{
+				const std::uint8_t *bytes = read_bytes(length);
+				return (nullptr != bytes) ? std::string(reinterpret_cast<const char *>(bytes), length) : std::string();
+			}
+
+			/// @brief Consumes a number of bytes
+			/// @returns A pointer to the consumed bytes inside the span, or nullptr if there weren't enough bytes left
+			const std::uint8_t *read_bytes(std::size_t count)
+			{
+				const std::uint8_t *retVal = nullptr;
+
+				if ((!failed) && (count <= (size - offset)))
+				{
+					retVal = data + offset;
+					offset += count;
+				}
+				else
+				{
+					failed = true;
+				}
+				return retVal;
+			}
+
+			void skip(std::size_t count)
+			{
+				read_bytes(count);
+			}
+
+			bool get_failed() const
+			{
+				return failed;
+			}
+
+			std::size_t get_offset() const
+			{
+				return offset;
+			}
+
+			bool get_at_end() const
+			{
+				return offset >= size;
+			}
+
+		private:
+			const std::uint8_t *data; ///< The data being read
+			std::size_t size; ///< The number of bytes in data
+			std::size_t offset = 0; ///< The offset of the next byte to read
+			bool failed = false; ///< Set once a read ran past the end of the data
+		};
+
+		/// @brief Reads a list of children that each have an object ID and a relative position
+		void read_positioned_children(PoolReader &reader, VTObject &object, std::uint8_t numberOfChildren)
+		{
+			for (std::uint_fast8_t i = 0; (i < numberOfChildren) && (!reader.get_failed()); i++)
+			{
+				const std::uint16_t childID = reader.read_uint16();
+				const std::int16_t childX = reader.read_int16();
+				const std::int16_t childY = reader.read_int16();
+				object.add_child(childID, childX, childY);
+			}
+		}
+
+		/// @brief Reads a list of children that are just object IDs, like the keys of a soft key mask or the items of a list
+		void read_child_ids(PoolReader &reader, VTObject &object, std::uint8_t numberOfChildren)
+		{
+			for (std::uint_fast8_t i = 0; (i < numberOfChildren) && (!reader.get_failed()); i++)
+			{
+				object.add_child(reader.read_uint16(), 0, 0);
+			}
+		}
+
+		/// @brief Reads an object's list of macro references
+		void read_macros(PoolReader &reader, VTObject &object, std::uint8_t numberOfMacros)
+		{
+			for (std::uint_fast8_t i = 0; (i < numberOfMacros) && (!reader.get_failed()); i++)
+			{
+				MacroMetadata macro;
+				macro.event = static_cast<EventID>(reader.read_uint8());
+				macro.macroID = reader.read_uint8();
+				object.add_macro(macro);
+			}
+		}
+
+		/// @brief Splits the command bytes of a macro object into its individual command packets
+		/// @details Commands are 8 bytes long, except for the ones that carry a variable length string
+		/// or a 16 bit position pair. A command cut short by the end of the macro is kept as-is, and
+		/// is then rejected by the macro's own validation.
+		void read_macro_commands(PoolReader &reader, Macro &macro, std::uint16_t numberOfBytes)
+		{
+			constexpr std::uint8_t CHANGE_STRING_VALUE_COMMAND = 0xB3;
+			constexpr std::uint8_t CHANGE_CHILD_POSITION_COMMAND = 0xB4;
+			constexpr std::size_t STANDARD_COMMAND_LENGTH = 8;
+			const std::uint8_t *commands = reader.read_bytes(numberOfBytes);
+			std::size_t offset = 0;
+
+			while ((nullptr != commands) && (offset < numberOfBytes))
+			{
+				std::size_t commandLength = STANDARD_COMMAND_LENGTH;
+
+				if ((CHANGE_STRING_VALUE_COMMAND == commands[offset]) && ((offset + 5) <= numberOfBytes))
+				{
+					commandLength = 5 + (static_cast<std::size_t>(commands[offset + 3]) | (static_cast<std::size_t>(commands[offset + 4]) << 8));
+				}
+				else if (CHANGE_CHILD_POSITION_COMMAND == commands[offset])
+				{
+					commandLength = 9;
+				}
+
+				if (commandLength > (numberOfBytes - offset))
+				{
+					commandLength = numberOfBytes - offset;
+				}
+
+				if (!macro.add_command_packet(std::vector<std::uint8_t>(commands + offset, commands + offset + commandLength)))
+				{
+					break;
+				}
+				offset += commandLength;
+			}
+		}
+
+		/// @brief Steps over an object that has no VTObject class
+		/// @returns true if the object type is one that can be stepped over
+		bool skip_unsupported_object(PoolReader &reader, VirtualTerminalObjectType type)
+		{
+			bool retVal = true;
+
+			switch (type)
+			{
+				case VirtualTerminalObjectType::GraphicsContext:
+				{
+					reader.skip(31);
+				}
+				break;
+
+				case VirtualTerminalObjectType::Animation:
+				{
+					reader.skip(12);
+					const std::uint8_t numberOfObjects = reader.read_uint8();
+					const std::uint8_t numberOfMacros = reader.read_uint8();
+					reader.skip((6 * static_cast<std::size_t>(numberOfObjects)) + (2 * static_cast<std::size_t>(numberOfMacros)));
+				}
+				break;
+
+				case VirtualTerminalObjectType::ObjectLabelRefrenceList:
+				{
+					reader.skip(7 * static_cast<std::size_t>(reader.read_uint16()));
+				}
+				break;
+
+				case VirtualTerminalObjectType::ExternalObjectDefinition:
+				{
+					reader.skip(9);
+					reader.skip(2 * static_cast<std::size_t>(reader.read_uint8()));
+				}
+				break;
+
+				case VirtualTerminalObjectType::ExternalReferenceNAME:
+				{
+					reader.skip(9);
+				}
+				break;
+
+				case VirtualTerminalObjectType::GraphicData:
+				{
+					reader.skip(1);
+					reader.skip(reader.read_uint32());
+				}
+				break;
+
+				case VirtualTerminalObjectType::ScaledGraphic:
+				{
+					reader.skip(8);
+					reader.skip(2 * static_cast<std::size_t>(reader.read_uint8()));
+				}
+				break;
+
+				default:
+				{
+					retVal = false;
+				}
+				break;
+			}
+			return retVal;
+		}
+
+		/// @brief Reads the body of an object, which is everything after its ID and type
+		/// @returns The object, or nullptr if the object type has no VTObject class
+		std::shared_ptr<VTObject> read_object(PoolReader &reader, VirtualTerminalObjectType type, bool &valid)
+		{
+			std::shared_ptr<VTObject> retVal;
+			valid = true;
+
+			switch (type)
+			{
+				case VirtualTerminalObjectType::WorkingSet:
+				{
+					auto workingSet = std::make_shared<WorkingSet>();
+					workingSet->set_background_color(reader.read_uint8());
+					workingSet->set_selectable(0 != reader.read_uint8());
+					workingSet->set_active_mask(reader.read_uint16());
+					const std::uint8_t numberOfObjects = reader.read_uint8();
+					const std::uint8_t numberOfMacros = reader.read_uint8();
+					const std::uint8_t numberOfLanguages = reader.read_uint8();
+					read_positioned_children(reader, *workingSet, numberOfObjects);
+					read_macros(reader, *workingSet, numberOfMacros);
+					reader.skip(2 * static_cast<std::size_t>(numberOfLanguages));
+					retVal = workingSet;
+				}
+				break;
+
+				case VirtualTerminalObjectType::DataMask:
+				{
+					auto dataMask = std::make_shared<DataMask>();
+					dataMask->set_background_color(reader.read_uint8());
+					dataMask->set_soft_key_mask(reader.read_uint16());
+					const std::uint8_t numberOfObjects = reader.read_uint8();
+					const std::uint8_t numberOfMacros = reader.read_uint8();
+					read_positioned_children(reader, *dataMask, numberOfObjects);
+					read_macros(reader, *dataMask, numberOfMacros);
+					retVal = dataMask;
+				}
+				break;
+
+				case VirtualTerminalObjectType::AlarmMask:
+				{
+					auto alarmMask = std::make_shared<AlarmMask>();
+					alarmMask->set_background_color(reader.read_uint8());
+					alarmMask->set_soft_key_mask(reader.read_uint16());
+					alarmMask->set_mask_priority(static_cast<AlarmMask::Priority>(reader.read_uint8()));
+					alarmMask->set_signal_priority(static_cast<AlarmMask::AcousticSignal>(reader.read_uint8()));
+					const std::uint8_t numberOfObjects = reader.read_uint8();
+					const std::uint8_t numberOfMacros = reader.read_uint8();
+					read_positioned_children(reader, *alarmMask, numberOfObjects);
+					read_macros(reader, *alarmMask, numberOfMacros);
+					retVal = alarmMask;
+				}
+				break;
+
+				case VirtualTerminalObjectType::Container:
+				{
+					auto container = std::make_shared<Container>();
+					container->set_width(reader.read_uint16());
+					container->set_height(reader.read_uint16());
+					container->set_hidden(0 != reader.read_uint8());
+					const std::uint8_t numberOfObjects = reader.read_uint8();
+					const std::uint8_t numberOfMacros = reader.read_uint8();
+					read_positioned_children(reader, *container, numberOfObjects);
+					read_macros(reader, *container, numberOfMacros);
+					retVal = container;
+				}
+				break;
+
+				case VirtualTerminalObjectType::SoftKeyMask:
+				{
+					auto softKeyMask = std::make_shared<SoftKeyMask>();
+					softKeyMask->set_background_color(reader.read_uint8());
+					const std::uint8_t numberOfObjects = reader.read_uint8();
+					const std::uint8_t numberOfMacros = reader.read_uint8();
+					read_child_ids(reader, *softKeyMask, numberOfObjects);
+					read_macros(reader, *softKeyMask, numberOfMacros);
+					retVal = softKeyMask;
+				}
+				break;
+
+				case VirtualTerminalObjectType::Key:
+				{
+					auto key = std::make_shared<Key>();
+					key->set_background_color(reader.read_uint8());
+					key->set_key_code(reader.read_uint8());
+					const std::uint8_t numberOfObjects = reader.read_uint8();
+					const std::uint8_t numberOfMacros = reader.read_uint8();
+					read_positioned_children(reader, *key, numberOfObjects);
+					read_macros(reader, *key, numberOfMacros);
+					retVal = key;
+				}
+				break;
+
+				case VirtualTerminalObjectType::Button:
+				{
+					auto button = std::make_shared<Button>();
+					button->set_width(reader.read_uint16());
+					button->set_height(reader.read_uint16());
+					button->set_background_color(reader.read_uint8());
+					button->set_border_colour(reader.read_uint8());
+					button->set_key_code(reader.read_uint8());
+					button->set_options(reader.read_uint8());
+					const std::uint8_t numberOfObjects = reader.read_uint8();
+					const std::uint8_t numberOfMacros = reader.read_uint8();
+					read_positioned_children(reader, *button, numberOfObjects);
+					read_macros(reader, *button, numberOfMacros);
+					retVal = button;
+				}
+				break;
+
+				case VirtualTerminalObjectType::InputBoolean:
+				{
+					auto inputBoolean = std::make_shared<InputBoolean>();
+					inputBoolean->set_background_color(reader.read_uint8());
+					inputBoolean->set_width(reader.read_uint16());
+					inputBoolean->set_foreground_colour_object_id(reader.read_uint16());
+					inputBoolean->set_variable_reference(reader.read_uint16());
+					inputBoolean->set_value(reader.read_uint8());
+					inputBoolean->set_enabled(0 != reader.read_uint8());
+					read_macros(reader, *inputBoolean, reader.read_uint8());
+					retVal = inputBoolean;
+				}
+				break;
+
+				case VirtualTerminalObjectType::InputString:
+				{
+					auto inputString = std::make_shared<InputString>();
+					inputString->set_width(reader.read_uint16());
+					inputString->set_height(reader.read_uint16());
+					inputString->set_background_color(reader.read_uint8());
+					inputString->set_font_attributes(reader.read_uint16());
+					inputString->set_input_attributes(reader.read_uint16());
+					inputString->set_options(reader.read_uint8());
+					inputString->set_variable_reference(reader.read_uint16());
+					inputString->set_justification_bitfield(reader.read_uint8());
+					inputString->set_value(reader.read_string(reader.read_uint8()));
+					inputString->set_enabled(0 != reader.read_uint8());
+					read_macros(reader, *inputString, reader.read_uint8());
+					retVal = inputString;
+				}
+				break;
+
+				case VirtualTerminalObjectType::InputNumber:
+				{
+					auto inputNumber = std::make_shared<InputNumber>();
+					inputNumber->set_width(reader.read_uint16());
+					inputNumber->set_height(reader.read_uint16());
+					inputNumber->set_background_color(reader.read_uint8());
+					inputNumber->set_font_attributes(reader.read_uint16());
+					inputNumber->set_options(reader.read_uint8());
+					inputNumber->set_variable_reference(reader.read_uint16());
+					inputNumber->set_value(reader.read_uint32());
+					inputNumber->set_minimum_value(reader.read_uint32());
+					inputNumber->set_maximum_value(reader.read_uint32());
+					inputNumber->set_offset(static_cast<std::int32_t>(reader.read_uint32()));
+					inputNumber->set_scale(reader.read_float());
+					inputNumber->set_number_of_decimals(reader.read_uint8());
+					inputNumber->set_format(0 != reader.read_uint8());
+					inputNumber->set_justification_bitfield(reader.read_uint8());
+					inputNumber->set_options2(reader.read_uint8());
+					read_macros(reader, *inputNumber, reader.read_uint8());
+					retVal = inputNumber;
+				}
+				break;
+
+				case VirtualTerminalObjectType::InputList:
+				{
+					auto inputList = std::make_shared<InputList>();
+					inputList->set_width(reader.read_uint16());
+					inputList->set_height(reader.read_uint16());
+					inputList->set_variable_reference(reader.read_uint16());
+					inputList->set_value(reader.read_uint8());
+					const std::uint8_t numberOfItems = reader.read_uint8();
+					inputList->set_options(reader.read_uint8());
+					const std::uint8_t numberOfMacros = reader.read_uint8();
+					inputList->set_number_of_list_items(numberOfItems);
+					read_child_ids(reader, *inputList, numberOfItems);
+					read_macros(reader, *inputList, numberOfMacros);
+					retVal = inputList;
+				}
+				break;
+
+				case VirtualTerminalObjectType::OutputString:
+				{
+					auto outputString = std::make_shared<OutputString>();
+					outputString->set_width(reader.read_uint16());
+					outputString->set_height(reader.read_uint16());
+					outputString->set_background_color(reader.read_uint8());
+					outputString->set_font_attributes(reader.read_uint16());
+					outputString->set_options(reader.read_uint8());
+					outputString->set_variable_reference(reader.read_uint16());
+					outputString->set_justification_bitfield(reader.read_uint8());
+					outputString->set_value(reader.read_string(reader.read_uint16()));
+					read_macros(reader, *outputString, reader.read_uint8());
+					retVal = outputString;
+				}
+				break;
+
+				case VirtualTerminalObjectType::OutputNumber:
+				{
+					auto outputNumber = std::make_shared<OutputNumber>();
+					outputNumber->set_width(reader.read_uint16());
+					outputNumber->set_height(reader.read_uint16());
+					outputNumber->set_background_color(reader.read_uint8());
+					outputNumber->set_font_attributes(reader.read_uint16());
+					outputNumber->set_options(reader.read_uint8());
+					outputNumber->set_variable_reference(reader.read_uint16());
+					outputNumber->set_value(reader.read_uint32());
+					outputNumber->set_offset(static_cast<std::int32_t>(reader.read_uint32()));
+					outputNumber->set_scale(reader.read_float());
+					outputNumber->set_number_of_decimals(reader.read_uint8());
+					outputNumber->set_format(0 != reader.read_uint8());
+					outputNumber->set_justification_bitfield(reader.read_uint8());
+					read_macros(reader, *outputNumber, reader.read_uint8());
+					retVal = outputNumber;
+				}
+				break;
+
+				case VirtualTerminalObjectType::OutputList:
+				{
+					auto outputList = std::make_shared<OutputList>();
+					outputList->set_width(reader.read_uint16());
+					outputList->set_height(reader.read_uint16());
+					outputList->set_variable_reference(reader.read_uint16());
+					outputList->set_value(reader.read_uint8());
+					const std::uint8_t numberOfItems = reader.read_uint8();
+					const std::uint8_t numberOfMacros = reader.read_uint8();
+					outputList->set_number_of_list_items(numberOfItems);
+					read_child_ids(reader, *outputList, numberOfItems);
+					read_macros(reader, *outputList, numberOfMacros);
+					retVal = outputList;
+				}
+				break;
+
+				case VirtualTerminalObjectType::OutputLine:
+				{
+					auto outputLine = std::make_shared<OutputLine>();
+					outputLine->set_line_attributes(reader.read_uint16());
+					outputLine->set_width(reader.read_uint16());
+					outputLine->set_height(reader.read_uint16());
+					outputLine->set_line_direction(static_cast<OutputLine::LineDirection>(reader.read_uint8()));
+					read_macros(reader, *outputLine, reader.read_uint8());
+					retVal = outputLine;
+				}
+				break;
+
+				case VirtualTerminalObjectType::OutputRectangle:
+				{
+					auto outputRectangle = std::make_shared<OutputRectangle>();
+					outputRectangle->set_line_attributes(reader.read_uint16());
+					outputRectangle->set_width(reader.read_uint16());
+					outputRectangle->set_height(reader.read_uint16());
+					outputRectangle->set_line_suppression_bitfield(reader.read_uint8());
+					outputRectangle->set_fill_attributes(reader.read_uint16());
+					read_macros(reader, *outputRectangle, reader.read_uint8());
+					retVal = outputRectangle;
+				}
+				break;
+
+				case VirtualTerminalObjectType::OutputEllipse:
+				{
+					auto outputEllipse = std::make_shared<OutputEllipse>();
+					outputEllipse->set_line_attributes(reader.read_uint16());
+					outputEllipse->set_width(reader.read_uint16());
+					outputEllipse->set_height(reader.read_uint16());
+					outputEllipse->set_ellipse_type(static_cast<OutputEllipse::EllipseType>(reader.read_uint8()));
+					outputEllipse->set_start_angle(reader.read_uint8());
+					outputEllipse->set_end_angle(reader.read_uint8());
+					outputEllipse->set_fill_attributes(reader.read_uint16());
+					read_macros(reader, *outputEllipse, reader.read_uint8());
+					retVal = outputEllipse;
+				}
+				break;
+
+				case VirtualTerminalObjectType::OutputPolygon:
+				{
+					auto outputPolygon = std::make_shared<OutputPolygon>();
+					outputPolygon->set_width(reader.read_uint16());
+					outputPolygon->set_height(reader.read_uint16());
+					outputPolygon->set_line_attributes(reader.read_uint16());
+					outputPolygon->set_fill_attributes(reader.read_uint16());
+					outputPolygon->set_type(static_cast<OutputPolygon::PolygonType>(reader.read_uint8()));
+					const std::uint8_t numberOfPoints = reader.read_uint8();
+					const std::uint8_t numberOfMacros = reader.read_uint8();
+
+					for (std::uint_fast8_t i = 0; (i < numberOfPoints) && (!reader.get_failed()); i++)
+					{
+						const std::uint16_t x = reader.read_uint16();
+						const std::uint16_t y = reader.read_uint16();
+						outputPolygon->add_point(x, y);
+					}
+					read_macros(reader, *outputPolygon, numberOfMacros);
+					retVal = outputPolygon;
+				}
+				break;
+
+				case VirtualTerminalObjectType::OutputMeter:
+				{
+					auto outputMeter = std::make_shared<OutputMeter>();
+					outputMeter->set_width(reader.read_uint16());
+					outputMeter->set_needle_colour(reader.read_uint8());
+					outputMeter->set_border_colour(reader.read_uint8());
+					outputMeter->set_arc_and_tick_colour(reader.read_uint8());
+					outputMeter->set_options(reader.read_uint8());
+					outputMeter->set_number_of_ticks(reader.read_uint8());
+					outputMeter->set_start_angle(reader.read_uint8());
+					outputMeter->set_end_angle(reader.read_uint8());
+					outputMeter->set_min_value(reader.read_uint16());
+					outputMeter->set_max_value(reader.read_uint16());
+					outputMeter->set_variable_reference(reader.read_uint16());
+					outputMeter->set_value(reader.read_uint16());
+					read_macros(reader, *outputMeter, reader.read_uint8());
+					retVal = outputMeter;
+				}
+				break;
+
+				case VirtualTerminalObjectType::OutputLinearBarGraph:
+				{
+					auto barGraph = std::make_shared<OutputLinearBarGraph>();
+					barGraph->set_width(reader.read_uint16());
+					barGraph->set_height(reader.read_uint16());
+					barGraph->set_colour(reader.read_uint8());
+					barGraph->set_target_line_colour(reader.read_uint8());
+					barGraph->set_options(reader.read_uint8());
+					barGraph->set_number_of_ticks(reader.read_uint8());
+					barGraph->set_min_value(reader.read_uint16());
+					barGraph->set_max_value(reader.read_uint16());
+					barGraph->set_variable_reference(reader.read_uint16());
+					barGraph->set_value(reader.read_uint16());
+					barGraph->set_target_value_reference(reader.read_uint16());
+					barGraph->set_target_value(reader.read_uint16());
+					read_macros(reader, *barGraph, reader.read_uint8());
+					retVal = barGraph;
+				}
+				break;
+
+				case VirtualTerminalObjectType::OutputArchedBarGraph:
+				{
+					auto barGraph = std::make_shared<OutputArchedBarGraph>();
+					barGraph->set_width(reader.read_uint16());
+					barGraph->set_height(reader.read_uint16());
+					barGraph->set_colour(reader.read_uint8());
+					barGraph->set_target_line_colour(reader.read_uint8());
+					barGraph->set_options(reader.read_uint8());
+					barGraph->set_start_angle(reader.read_uint8());
+					barGraph->set_end_angle(reader.read_uint8());
+					barGraph->set_bar_graph_width(reader.read_uint16());
+					barGraph->set_min_value(reader.read_uint16());
+					barGraph->set_max_value(reader.read_uint16());
+					barGraph->set_variable_reference(reader.read_uint16());
+					barGraph->set_value(reader.read_uint16());
+					barGraph->set_target_value_reference(reader.read_uint16());
+					barGraph->set_target_value(reader.read_uint16());
+					read_macros(reader, *barGraph, reader.read_uint8());
+					retVal = barGraph;
+				}
+				break;
+
+				case VirtualTerminalObjectType::PictureGraphic:
+				{
+					auto pictureGraphic = std::make_shared<PictureGraphic>();
+					pictureGraphic->set_width(reader.read_uint16());
+					pictureGraphic->set_actual_width(reader.read_uint16());
+					pictureGraphic->set_actual_height(reader.read_uint16());
+					pictureGraphic->set_format(static_cast<PictureGraphic::Format>(reader.read_uint8()));
+					pictureGraphic->set_options(reader.read_uint8());
+					pictureGraphic->set_transparency_colour(reader.read_uint8());
+					const std::uint32_t numberOfRawBytes = reader.read_uint32();
+					const std::uint8_t numberOfMacros = reader.read_uint8();
+					const std::uint8_t *rawData = reader.read_bytes(numberOfRawBytes);
+
+					if (nullptr != rawData)
+					{
+						pictureGraphic->set_number_of_bytes_in_raw_data(numberOfRawBytes);
+						pictureGraphic->set_raw_data(rawData, numberOfRawBytes);
+					}
+					read_macros(reader, *pictureGraphic, numberOfMacros);
+					retVal = pictureGraphic;
+				}
+				break;
+
+				case VirtualTerminalObjectType::NumberVariable:
+				{
+					auto numberVariable = std::make_shared<NumberVariable>();
+					numberVariable->set_value(reader.read_uint32());
+					retVal = numberVariable;
+				}
+				break;
+
+				case VirtualTerminalObjectType::StringVariable:
+				{
+					auto stringVariable = std::make_shared<StringVariable>();
+					stringVariable->set_value(reader.read_string(reader.read_uint16()));
+					retVal = stringVariable;
+				}
+				break;
+
+				case VirtualTerminalObjectType::FontAttributes:
+				{
+					auto fontAttributes = std::make_shared<FontAttributes>();
+					fontAttributes->set_colour(reader.read_uint8());
+					fontAttributes->set_size(static_cast<FontAttributes::FontSize>(reader.read_uint8()));
+					fontAttributes->set_type(static_cast<FontAttributes::FontType>(reader.read_uint8()));
+					fontAttributes->set_style(reader.read_uint8());
+					read_macros(reader, *fontAttributes, reader.read_uint8());
+					retVal = fontAttributes;
+				}
+				break;
+
+				case VirtualTerminalObjectType::LineAttributes:
+				{
+					auto lineAttributes = std::make_shared<LineAttributes>();
+					lineAttributes->set_background_color(reader.read_uint8());
+					lineAttributes->set_width(reader.read_uint8());
+					lineAttributes->set_line_art_bit_pattern(reader.read_uint16());
+					read_macros(reader, *lineAttributes, reader.read_uint8());
+					retVal = lineAttributes;
+				}
+				break;
+
+				case VirtualTerminalObjectType::FillAttributes:
+				{
+					auto fillAttributes = std::make_shared<FillAttributes>();
+					fillAttributes->set_type(static_cast<FillAttributes::FillType>(reader.read_uint8()));
+					fillAttributes->set_background_color(reader.read_uint8());
+					fillAttributes->set_fill_pattern(reader.read_uint16());
+					read_macros(reader, *fillAttributes, reader.read_uint8());
+					retVal = fillAttributes;
+				}
+				break;
+
+				case VirtualTerminalObjectType::InputAttributes:
+				{
+					auto inputAttributes = std::make_shared<InputAttributes>();
+					inputAttributes->set_validation_type(static_cast<InputAttributes::ValidationType>(reader.read_uint8()));
+					inputAttributes->set_validation_string(reader.read_string(reader.read_uint8()));
+					read_macros(reader, *inputAttributes, reader.read_uint8());
+					retVal = inputAttributes;
+				}
+				break;
+
+				case VirtualTerminalObjectType::ExtendedInputAttributes:
+				{
+					auto extendedInputAttributes = std::make_shared<ExtendedInputAttributes>();
+					extendedInputAttributes->set_validation_type(static_cast<ExtendedInputAttributes::ValidationType>(reader.read_uint8()));
+					const std::uint8_t numberOfCodePlanes = reader.read_uint8();
+					extendedInputAttributes->set_number_of_code_planes(numberOfCodePlanes);
+
+					// The object has no storage for the character ranges yet, so they are only stepped over
+					for (std::uint_fast8_t i = 0; (i < numberOfCodePlanes) && (!reader.get_failed()); i++)
+					{
+						reader.skip(1);
+						reader.skip(4 * static_cast<std::size_t>(reader.read_uint8()));
+					}
+					retVal = extendedInputAttributes;
+				}
+				break;
+
+				case VirtualTerminalObjectType::ObjectPointer:
+				{
+					auto objectPointer = std::make_shared<ObjectPointer>();
+					objectPointer->set_value(reader.read_uint16());
+					retVal = objectPointer;
+				}
+				break;
+
+				case VirtualTerminalObjectType::ExternalObjectPointer:
+				{
+					auto externalObjectPointer = std::make_shared<ExternalObjectPointer>();
+					externalObjectPointer->set_default_object_id(reader.read_uint16());
+					externalObjectPointer->set_external_reference_name_id(reader.read_uint16());
+					externalObjectPointer->set_external_object_id(reader.read_uint16());
+					retVal = externalObjectPointer;
+				}
+				break;
+
+				case VirtualTerminalObjectType::Macro:
+				{
+					auto macro = std::make_shared<Macro>();
+					read_macro_commands(reader, *macro, reader.read_uint16());
+					retVal = macro;
+				}
+				break;
+
+				case VirtualTerminalObjectType::ColourMap:
+				{
+					auto colourMap = std::make_shared<ColourMap>();
+					const std::uint16_t numberOfIndexes = reader.read_uint16();
+					const std::uint8_t *indexes = reader.read_bytes(numberOfIndexes);
+					valid = colourMap->set_number_of_colour_indexes(numberOfIndexes);
+
+					for (std::uint16_t i = 0; (nullptr != indexes) && valid && (i < numberOfIndexes); i++)
+					{
+						colourMap->set_colour_map_index(static_cast<std::uint8_t>(i), indexes[i]);
+					}
+					retVal = colourMap;
+				}
+				break;
+
+				case VirtualTerminalObjectType::WindowMask:
+				{
+					auto windowMask = std::make_shared<WindowMask>();
+					windowMask->set_width(reader.read_uint8());
+					windowMask->set_height(reader.read_uint8());
+					windowMask->set_window_type(static_cast<WindowMask::WindowType>(reader.read_uint8()));
+					windowMask->set_background_color(reader.read_uint8());
+					windowMask->set_options(reader.read_uint8());
+					windowMask->set_name_object_id(reader.read_uint16());
+					windowMask->set_title_object_id(reader.read_uint16());
+					windowMask->set_icon_object_id(reader.read_uint16());
+					const std::uint8_t numberOfReferences = reader.read_uint8();
+					const std::uint8_t numberOfObjects = reader.read_uint8();
+					const std::uint8_t numberOfMacros = reader.read_uint8();
+					read_child_ids(reader, *windowMask, numberOfReferences);
+					read_positioned_children(reader, *windowMask, numberOfObjects);
+					read_macros(reader, *windowMask, numberOfMacros);
+					retVal = windowMask;
+				}
+				break;
+
+				case VirtualTerminalObjectType::KeyGroup:
+				{
+					auto keyGroup = std::make_shared<KeyGroup>();
+					keyGroup->set_options(reader.read_uint8());
+					keyGroup->set_name_object_id(reader.read_uint16());
+					keyGroup->set_key_group_icon(reader.read_uint16());
+					const std::uint8_t numberOfObjects = reader.read_uint8();
+					const std::uint8_t numberOfMacros = reader.read_uint8();
+					read_child_ids(reader, *keyGroup, numberOfObjects);
+					read_macros(reader, *keyGroup, numberOfMacros);
+					retVal = keyGroup;
+				}
+				break;
+
+				case VirtualTerminalObjectType::AuxiliaryFunctionType1:
+				{
+					auto auxiliaryFunction = std::make_shared<AuxiliaryFunctionType1>();
+					auxiliaryFunction->set_background_color(reader.read_uint8());
+					auxiliaryFunction->set_function_type(static_cast<AuxiliaryFunctionType1::FunctionType>(reader.read_uint8()));
+					read_positioned_children(reader, *auxiliaryFunction, reader.read_uint8());
+					retVal = auxiliaryFunction;
+				}
+				break;
+
+				case VirtualTerminalObjectType::AuxiliaryInputType1:
+				{
+					auto auxiliaryInput = std::make_shared<AuxiliaryInputType1>();
+					auxiliaryInput->set_background_color(reader.read_uint8());
+					auxiliaryInput->set_function_type(static_cast<AuxiliaryInputType1::FunctionType>(reader.read_uint8()));
+					valid = auxiliaryInput->set_input_id(reader.read_uint8());
+					read_positioned_children(reader, *auxiliaryInput, reader.read_uint8());
+					retVal = auxiliaryInput;
+				}
+				break;
+
+				case VirtualTerminalObjectType::AuxiliaryFunctionType2:
+				{
+					auto auxiliaryFunction = std::make_shared<AuxiliaryFunctionType2>();
+					auxiliaryFunction->set_background_color(reader.read_uint8());
+					const std::uint8_t functionAttributes = reader.read_uint8();
+					auxiliaryFunction->set_function_type(static_cast<AuxiliaryFunctionType2::FunctionType>(functionAttributes & 0x1F));
+					auxiliaryFunction->set_function_attribute(AuxiliaryFunctionType2::FunctionAttribute::CriticalControl, 0 != (functionAttributes & 0x20));
+					auxiliaryFunction->set_function_attribute(AuxiliaryFunctionType2::FunctionAttribute::AssignmentRestriction, 0 != (functionAttributes & 0x40));
+					auxiliaryFunction->set_function_attribute(AuxiliaryFunctionType2::FunctionAttribute::SingleAssignment, 0 != (functionAttributes & 0x80));
+					read_positioned_children(reader, *auxiliaryFunction, reader.read_uint8());
+					retVal = auxiliaryFunction;
+				}
+				break;
+
+				case VirtualTerminalObjectType::AuxiliaryInputType2:
+				{
+					auto auxiliaryInput = std::make_shared<AuxiliaryInputType2>();
+					auxiliaryInput->set_background_color(reader.read_uint8());
+					const std::uint8_t functionAttributes = reader.read_uint8();
+					auxiliaryInput->set_function_type(static_cast<AuxiliaryFunctionType2::FunctionType>(functionAttributes & 0x1F));
+					auxiliaryInput->set_function_attribute(AuxiliaryInputType2::FunctionAttribute::CriticalControl, 0 != (functionAttributes & 0x20));
+					auxiliaryInput->set_function_attribute(AuxiliaryInputType2::FunctionAttribute::AssignmentRestriction, 0 != (functionAttributes & 0x40));
+					auxiliaryInput->set_function_attribute(AuxiliaryInputType2::FunctionAttribute::SingleAssignment, 0 != (functionAttributes & 0x80));
+					read_positioned_children(reader, *auxiliaryInput, reader.read_uint8());
+					retVal = auxiliaryInput;
+				}
+				break;
+
+				case VirtualTerminalObjectType::AuxiliaryControlDesignatorType2:
+				{
+					auto designator = std::make_shared<AuxiliaryControlDesignatorType2>();
+					designator->set_pointer_type(reader.read_uint8());
+					designator->set_auxiliary_object_id(reader.read_uint16());
+					retVal = designator;
+				}
+				break;
+
+				default:
+				{
+					// No VTObject class for this type, the caller will try to step over it instead
+				}
+				break;
+			}
+			return retVal;
+		}
+
+		/// @brief Checks that every child and macro an object references is in the pool, or was stepped over
+		bool get_are_references_resolved(const VTObject &object, const VTObjectPool &objectPool, const std::unordered_set<std::uint16_t> &skippedObjectIDs)
+		{
+			bool retVal = true;
+
+			for (std::uint16_t i = 0; (i < object.get_number_children()) && retVal; i++)
+			{
+				const std::uint16_t childID = object.get_child_id(i);
+				retVal = ((NULL_OBJECT_ID == childID) || objectPool.contains(childID) || (0 != skippedObjectIDs.count(childID)));
+			}
+
+			for (std::uint8_t i = 0; (i < object.get_number_macros()) && retVal; i++)
+			{
+				const VTObject *macro = VTObject::get_object_by_id(object.get_macro(i).macroID, objectPool);
+				retVal = ((nullptr != macro) && (VirtualTerminalObjectType::Macro == macro->get_object_type()));
+			}
+			return retVal;
+		}
+	}
+
+	VTObjectPoolParser::Result VTObjectPoolParser::parse(DataSpan<const std::uint8_t> iopData, VTObjectPool &objectPool, bool validateObjects)
+	{
+		constexpr std::size_t OBJECT_HEADER_LENGTH = 3; // Object ID and type
+		Result retVal;
+		PoolReader reader(iopData.begin(), iopData.size());
+		std::vector<std::size_t> objectOffsets;
+		std::unordered_set<std::uint16_t> skippedObjectIDs;
+
+		while ((Error::None == retVal.error) && (!reader.get_at_end()))
+		{
+			const std::size_t objectOffset = reader.get_offset();
+			const std::uint16_t objectID = reader.read_uint16();
+			const auto objectType = static_cast<VirtualTerminalObjectType>(reader.read_uint8());
+			bool objectValid = true;
+			std::shared_ptr<VTObject> object;
+
+			if (reader.get_failed())
+			{
+				retVal.error = Error::Truncated;
+			}
+			else if (NULL_OBJECT_ID == objectID)
+			{
+				retVal.error = Error::InvalidObject;
+			}
+			else if (objectPool.contains(objectID) || (0 != skippedObjectIDs.count(objectID)))
+			{
+				retVal.error = Error::DuplicateObjectID;
+			}
+			else
+			{
+				object = read_object(reader, objectType, objectValid);
+
+				if ((nullptr == object) && (!skip_unsupported_object(reader, objectType)))
+				{
+					retVal.error = Error::UnknownObjectType;
+				}
+				else if (reader.get_failed())
+				{
+					retVal.error = Error::Truncated;
+				}
+				else if (!objectValid)
+				{
+					retVal.error = Error::InvalidObject;
+				}
+				else if (nullptr != object)
+				{
+					object->set_id(objectID);
+					objectPool.add_object(object);
+					objectOffsets.push_back(objectOffset);
+					retVal.numberOfParsedObjects++;
+				}
+				else
+				{
+					// Other objects can still reference it
+					skippedObjectIDs.insert(objectID);
+					retVal.numberOfSkippedObjects++;
+				}
+			}
+
+			if (Error::None != retVal.error)
+			{
+				retVal.errorOffset = objectOffset;
+				retVal.errorObjectID = (objectOffset + OBJECT_HEADER_LENGTH <= iopData.size()) ? objectID : NULL_OBJECT_ID;
+			}
+		}
+
+		if ((Error::None == retVal.error) && validateObjects)
+		{
+			// Objects may reference objects later in the pool, so validation has to wait for the whole pool.
+			// The offsets line up with the pool's objects because nothing has been removed from it since.
+			const auto &objects = objectPool.get_objects();
+			const std::size_t firstParsedObject = objects.size() - objectOffsets.size();
+
+			for (std::size_t i = 0; (i < objectOffsets.size()) && (Error::None == retVal.error); i++)
+			{
+				const VTObject &object = *objects[firstParsedObject + i];
+
+				if (!get_are_references_resolved(object, objectPool, skippedObjectIDs))
+				{
+					retVal.error = Error::UnresolvedReference;
+				}
+				else if (!object.get_is_valid(objectPool))
+				{
+					retVal.error = Error::InvalidObject;
+				}
+
+				if (Error::None != retVal.error)
+				{
+					retVal.errorOffset = objectOffsets[i];
+					retVal.errorObjectID = object.get_id();
+				}
+			}
+		}
+
+		if (Error::None != retVal.error)
+		{
+			LOG_ERROR("[VT]: Object pool failed to parse: " + std::string(get_error_description(retVal.error)) +
+			          " at object " + isobus::to_string(static_cast<int>(retVal.errorObjectID)) +
+			          ", byte offset " + isobus::to_string(retVal.errorOffset));
+		}
+		return retVal;
+	}
+
+	const char *VTObjectPoolParser::get_error_description(Error error)
+	{
+		const char *retVal = "Unknown error";
+
+		switch (error)
+		{
+			case Error::None:
+			{
+				retVal = "No error";
+			}
+			break;
+
+			case Error::Truncated:
+			{
+				retVal = "Object is truncated";
+			}
+			break;
+
+			case Error::UnknownObjectType:
+			{
+				retVal = "Unknown object type";
+			}
+			break;
+
+			case Error::DuplicateObjectID:
+			{
+				retVal = "Duplicate object ID";
+			}
+			break;
+
+			case Error::InvalidObject:
+			{
+				retVal = "Object is not valid";
+			}
+			break;
+
+			case Error::UnresolvedReference:
+			{
+				retVal = "Object references an object that is not in the pool";
+			}
+			break;
+		}
+		return retVal;
+	}
+} // namespace isobus
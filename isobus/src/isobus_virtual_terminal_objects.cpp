@@ -59,6 +59,112 @@ namespace isobus
 		colourTable.at(colourIndex) = newColour;
 	}
 
+	bool VTObjectPool::add_object(std::shared_ptr<VTObject> object)
+	{
+		bool retVal = false;
+
+		if (nullptr != object)
+		{
+			const std::uint16_t objectID = object->get_id();
+
+			if (objectID >= objectIndex.size())
+			{
+				objectIndex.resize(static_cast<std::size_t>(objectID) + 1, NO_OBJECT);
+			}
+
+			if (NO_OBJECT != objectIndex[objectID])
+			{
+				objects[objectIndex[objectID] - 1] = std::move(object);
+			}
+			else
+			{
+				objects.push_back(std::move(object));
+				objectIndex[objectID] = static_cast<std::uint32_t>(objects.size());
+			}
+			retVal = true;
+		}
+		return retVal;
+	}
+
+	bool VTObjectPool::remove_object(std::uint16_t objectID)
+	{
+		bool retVal = false;
+
+		if (contains(objectID))
+		{
+			const std::uint32_t position = objectIndex[objectID] - 1;
+
+			// Move the last object into the gap to keep the storage contiguous
+			if (position != (objects.size() - 1))
+			{
+				objects[position] = std::move(objects.back());
+				objectIndex[objects[position]->get_id()] = position + 1;
+			}
+			objects.pop_back();
+			objectIndex[objectID] = NO_OBJECT;
+			retVal = true;
+		}
+		return retVal;
+	}
+
+	VTObject *VTObjectPool::get_object_by_id(std::uint16_t objectID) const
+	{
+		VTObject *retVal = nullptr;
+
+		if (contains(objectID))
+		{
+			retVal = objects[objectIndex[objectID] - 1].get();
+		}
+		return retVal;
+	}
+
+	std::shared_ptr<VTObject> VTObjectPool::get_shared_object_by_id(std::uint16_t objectID) const
+	{
+		std::shared_ptr<VTObject> retVal = nullptr;
+
+		if (contains(objectID))
+		{
+			retVal = objects[objectIndex[objectID] - 1];
+		}
+		return retVal;
+	}
+
+	bool VTObjectPool::contains(std::uint16_t objectID) const
+	{
+		return (objectID < objectIndex.size()) && (NO_OBJECT != objectIndex[objectID]);
+	}
+
+	const std::vector<std::shared_ptr<VTObject>> &VTObjectPool::get_objects() const
+	{
+		return objects;
+	}
+
+	std::size_t VTObjectPool::size() const
+	{
+		return objects.size();
+	}
+
+	bool VTObjectPool::empty() const
+	{
+		return objects.empty();
+	}
+
+	void VTObjectPool::clear()
+	{
+		objects.clear();
+		objectIndex.clear();
+	}
+
+	std::vector<std::shared_ptr<VTObject>>::const_iterator VTObjectPool::begin() const
+	{
+		return objects.cbegin();
+	}
+
+	std::vector<std::shared_ptr<VTObject>>::const_iterator VTObjectPool::end() const
+	{
+		return objects.cend();
+	}
+
 	std::uint16_t VTObject::get_id() const
 	{
 		return objectID;
@@ -215,17 +321,13 @@ namespace isobus
 		}
 	}
 
-	std::shared_ptr<VTObject> VTObject::get_object_by_id(std::uint16_t objectID, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool)
+	VTObject *VTObject::get_object_by_id(std::uint16_t objectID, const VTObjectPool &objectPool)
 	{
-		std::shared_ptr<VTObject> retVal = nullptr;
+		VTObject *retVal = nullptr;
 
-		if ((NULL_OBJECT_ID != objectID) && (objectPool.find(objectID) != objectPool.end()))
+		if (NULL_OBJECT_ID != objectID)
 		{
-			auto object = objectPool.at(objectID);
-			if (nullptr != object)
-			{
-				retVal = object;
-			}
+			retVal = objectPool.get_object_by_id(objectID);
 		}
 		return retVal;
 	}
@@ -249,7 +351,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool WorkingSet::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool WorkingSet::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -291,7 +393,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool WorkingSet::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool WorkingSet::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -410,7 +512,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool DataMask::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool DataMask::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 		std::uint8_t numberOfSoftKeyMasks = 0;
@@ -423,6 +525,7 @@ namespace isobus
 				switch (childObject->get_object_type())
 				{
 					case VirtualTerminalObjectType::WorkingSet:
+					case VirtualTerminalObjectType::Container:
 					case VirtualTerminalObjectType::Button:
 					case VirtualTerminalObjectType::InputBoolean:
 					case VirtualTerminalObjectType::InputString:
@@ -477,7 +580,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool DataMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool DataMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -552,7 +655,7 @@ namespace isobus
 		return retVal;
 	}
 
-	bool DataMask::change_soft_key_mask(std::uint16_t newMaskID, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool)
+	bool DataMask::change_soft_key_mask(std::uint16_t newMaskID, const VTObjectPool &objectPool)
 	{
 		bool retVal = false;
 
@@ -561,12 +664,16 @@ namespace isobus
 			set_soft_key_mask(newMaskID);
 			retVal = true;
 		}
-		else if ((objectPool.end() != objectPool.find(newMaskID)) &&
-		         (nullptr != objectPool.at(newMaskID)) &&
-		         (VirtualTerminalObjectType::SoftKeyMask == objectPool.at(newMaskID)->get_object_type()))
+		else
 		{
-			set_soft_key_mask(newMaskID);
-			retVal = true;
+			const VTObject *newMask = objectPool.get_object_by_id(newMaskID);
+
+			if ((nullptr != newMask) &&
+			    (VirtualTerminalObjectType::SoftKeyMask == newMask->get_object_type()))
+			{
+				set_soft_key_mask(newMaskID);
+				retVal = true;
+			}
 		}
 		return retVal;
 	}
@@ -591,7 +698,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool AlarmMask::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool AlarmMask::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -603,6 +710,7 @@ namespace isobus
 				switch (childObject->get_object_type())
 				{
 					case VirtualTerminalObjectType::WorkingSet:
+					case VirtualTerminalObjectType::Container:
 					case VirtualTerminalObjectType::Button:
 					case VirtualTerminalObjectType::InputBoolean:
 					case VirtualTerminalObjectType::InputString:
@@ -645,7 +753,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool AlarmMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool AlarmMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -782,7 +890,7 @@ namespace isobus
 		signalPriority = value;
 	}
 
-	bool AlarmMask::change_soft_key_mask(std::uint16_t newMaskID, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool)
+	bool AlarmMask::change_soft_key_mask(std::uint16_t newMaskID, const VTObjectPool &objectPool)
 	{
 		bool retVal = false;
 
@@ -791,11 +899,16 @@ namespace isobus
 			set_soft_key_mask(newMaskID);
 			retVal = true;
 		}
-		else if ((nullptr != objectPool.at(newMaskID)) &&
-		         (VirtualTerminalObjectType::SoftKeyMask == objectPool.at(newMaskID)->get_object_type()))
+		else
 		{
-			set_soft_key_mask(newMaskID);
-			retVal = true;
+			const VTObject *newMask = objectPool.get_object_by_id(newMaskID);
+
+			if ((nullptr != newMask) &&
+			    (VirtualTerminalObjectType::SoftKeyMask == newMask->get_object_type()))
+			{
+				set_soft_key_mask(newMaskID);
+				retVal = true;
+			}
 		}
 		return retVal;
 	}
@@ -820,7 +933,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool Container::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool Container::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -874,7 +987,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool Container::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool Container::set_attribute(std::uint8_t, std::uint32_t, const VTObjectPool &, AttributeError &returnedError)
 	{
 		// All attributes are read only
 		returnedError = AttributeError::InvalidAttributeID;
@@ -947,7 +1060,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool SoftKeyMask::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool SoftKeyMask::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -979,7 +1092,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool SoftKeyMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool SoftKeyMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -1050,7 +1163,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool Key::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool Key::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -1096,7 +1209,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool Key::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool Key::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -1191,7 +1304,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool KeyGroup::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool KeyGroup::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -1213,7 +1326,7 @@ namespace isobus
 
 						case VirtualTerminalObjectType::ObjectPointer:
 						{
-							auto objectPointer = std::static_pointer_cast<ObjectPointer>(childObject);
+							auto objectPointer = static_cast<ObjectPointer *>(childObject);
 
 							if (NULL_OBJECT_ID != objectPointer->get_value())
 							{
@@ -1256,7 +1369,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool KeyGroup::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool KeyGroup::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -1275,10 +1388,9 @@ namespace isobus
 				{
 					returnedError = AttributeError::InvalidValue;
 
-					if (objectPool.find(objectID) != objectPool.end())
+					if (objectPool.contains(objectID))
 					{
 						auto newName = static_cast<std::uint16_t>(rawAttributeData);
-						auto newNameObject = objectPool.at(newName);
 
 						if (validate_name(newName, objectPool))
 						{
@@ -1388,9 +1500,9 @@ namespace isobus
 		}
 	}
 
-	bool KeyGroup::validate_name(std::uint16_t nameIDToValidate, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool KeyGroup::validate_name(std::uint16_t nameIDToValidate, const VTObjectPool &objectPool) const
 	{
-		auto newNameObject = objectPool.at(nameIDToValidate);
+		auto newNameObject = objectPool.get_object_by_id(nameIDToValidate);
 		bool retVal = false;
 
 		if ((NULL_OBJECT_ID != nameIDToValidate) &&
@@ -1400,15 +1512,12 @@ namespace isobus
 		{
 			if (VirtualTerminalObjectType::ObjectPointer == newNameObject->get_object_type())
 			{
-				if (newNameObject->get_number_children() > 0)
-				{
-					auto label = objectPool.at(std::static_pointer_cast<ObjectPointer>(newNameObject)->get_child_id(0));
+				auto label = objectPool.get_object_by_id(static_cast<ObjectPointer *>(newNameObject)->get_value());
 
-					if ((nullptr != label) &&
-					    (VirtualTerminalObjectType::OutputString == label->get_object_type()))
-					{
-						retVal = true;
-					}
+				if ((nullptr != label) &&
+				    (VirtualTerminalObjectType::OutputString == label->get_object_type()))
+				{
+					retVal = true;
 				}
 			}
 			else
@@ -1429,7 +1538,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool Button::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool Button::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -1474,7 +1583,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool Button::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool Button::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -1657,7 +1766,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool InputBoolean::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool InputBoolean::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -1711,7 +1820,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool InputBoolean::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool InputBoolean::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -1742,10 +1851,10 @@ namespace isobus
 						set_foreground_colour_object_id(static_cast<std::uint16_t>(rawAttributeData));
 						retVal = true;
 					}
-					else if (objectPool.find(static_cast<std::uint16_t>(rawAttributeData)) != objectPool.end())
+					else if (objectPool.contains(static_cast<std::uint16_t>(rawAttributeData)))
 					{
-						if (nullptr != objectPool.at(static_cast<std::uint16_t>(rawAttributeData)) &&
-						    (VirtualTerminalObjectType::FontAttributes == objectPool.at(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()))
+						if (nullptr != objectPool.get_object_by_id(static_cast<std::uint16_t>(rawAttributeData)) &&
+						    (VirtualTerminalObjectType::FontAttributes == objectPool.get_object_by_id(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()))
 						{
 							set_foreground_colour_object_id(static_cast<std::uint16_t>(rawAttributeData));
 							retVal = true;
@@ -1767,10 +1876,10 @@ namespace isobus
 						set_variable_reference(static_cast<std::uint16_t>(rawAttributeData));
 						retVal = true;
 					}
-					else if (objectPool.find(static_cast<std::uint16_t>(rawAttributeData)) != objectPool.end())
+					else if (objectPool.contains(static_cast<std::uint16_t>(rawAttributeData)))
 					{
-						if (nullptr != objectPool.at(static_cast<std::uint16_t>(rawAttributeData)) &&
-						    (VirtualTerminalObjectType::NumberVariable == objectPool.at(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()))
+						if (nullptr != objectPool.get_object_by_id(static_cast<std::uint16_t>(rawAttributeData)) &&
+						    (VirtualTerminalObjectType::NumberVariable == objectPool.get_object_by_id(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()))
 						{
 							set_variable_reference(static_cast<std::uint16_t>(rawAttributeData));
 							retVal = true;
@@ -1928,7 +2037,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool InputString::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool InputString::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -1997,7 +2106,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool InputString::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool InputString::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -2300,7 +2409,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool InputNumber::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool InputNumber::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -2354,7 +2463,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool InputNumber::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool InputNumber::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -2782,7 +2891,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool InputList::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool InputList::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -2827,7 +2936,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool InputList::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool InputList::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -2987,7 +3096,7 @@ namespace isobus
 		value = inputValue;
 	}
 
-	bool InputList::change_list_item(std::uint8_t index, std::uint16_t newListItem, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool)
+	bool InputList::change_list_item(std::uint8_t index, std::uint16_t newListItem, const VTObjectPool &objectPool)
 	{
 		bool retVal = false;
 
@@ -3068,7 +3177,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputString::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputString::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -3122,7 +3231,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputString::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputString::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -3366,7 +3475,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputNumber::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputNumber::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -3420,7 +3529,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputNumber::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputNumber::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -3764,7 +3873,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputList::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputList::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -3835,7 +3944,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool OutputList::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputList::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -3969,7 +4078,7 @@ namespace isobus
 		value = aValue;
 	}
 
-	bool OutputList::change_list_item(std::uint8_t index, std::uint16_t newListItem, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool)
+	bool OutputList::change_list_item(std::uint8_t index, std::uint16_t newListItem, const VTObjectPool &objectPool)
 	{
 		bool retVal = false;
 
@@ -3999,7 +4108,7 @@ namespace isobus
 		return VirtualTerminalObjectType::OutputLine;
 	}
 
-	bool OutputLine::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputLine::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -4035,7 +4144,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputLine::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputLine::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -4191,7 +4300,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputRectangle::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputRectangle::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -4245,7 +4354,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputRectangle::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputRectangle::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -4424,7 +4533,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputEllipse::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputEllipse::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -4478,7 +4587,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputEllipse::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputEllipse::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -4712,7 +4821,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputPolygon::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputPolygon::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -4766,7 +4875,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputPolygon::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputPolygon::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -4973,7 +5082,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputMeter::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputMeter::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -5009,7 +5118,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputMeter::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputMeter::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -5367,7 +5476,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputLinearBarGraph::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputLinearBarGraph::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -5421,7 +5530,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputLinearBarGraph::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputLinearBarGraph::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -5769,7 +5878,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputArchedBarGraph::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputArchedBarGraph::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -5823,7 +5932,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputArchedBarGraph::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputArchedBarGraph::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -6205,12 +6314,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool PictureGraphic::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool PictureGraphic::get_is_valid(const VTObjectPool &) const
 	{
 		return true;
 	}
 
-	bool PictureGraphic::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool PictureGraphic::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -6424,12 +6533,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool NumberVariable::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool NumberVariable::get_is_valid(const VTObjectPool &) const
 	{
 		return true;
 	}
 
-	bool NumberVariable::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool NumberVariable::set_attribute(std::uint8_t, std::uint32_t, const VTObjectPool &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false;
@@ -6487,12 +6596,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool StringVariable::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool StringVariable::get_is_valid(const VTObjectPool &) const
 	{
 		return true;
 	}
 
-	bool StringVariable::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool StringVariable::set_attribute(std::uint8_t, std::uint32_t, const VTObjectPool &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false;
@@ -6543,12 +6652,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool FontAttributes::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool FontAttributes::get_is_valid(const VTObjectPool &) const
 	{
 		return true;
 	}
 
-	bool FontAttributes::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool FontAttributes::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -6872,12 +6981,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool LineAttributes::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool LineAttributes::get_is_valid(const VTObjectPool &) const
 	{
 		return true;
 	}
 
-	bool LineAttributes::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool LineAttributes::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -6986,14 +7095,14 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool FillAttributes::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool FillAttributes::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		return ((NULL_OBJECT_ID == get_fill_pattern()) ||
 		        ((nullptr != get_object_by_id(get_fill_pattern(), objectPool)) &&
 		         (VirtualTerminalObjectType::PictureGraphic == get_object_by_id(get_fill_pattern(), objectPool)->get_object_type())));
 	}
 
-	bool FillAttributes::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool FillAttributes::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -7134,12 +7243,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool InputAttributes::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool InputAttributes::get_is_valid(const VTObjectPool &) const
 	{
 		return true;
 	}
 
-	bool InputAttributes::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool InputAttributes::set_attribute(std::uint8_t, std::uint32_t, const VTObjectPool &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false;
@@ -7207,12 +7316,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool ExtendedInputAttributes::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool ExtendedInputAttributes::get_is_valid(const VTObjectPool &) const
 	{
 		return true;
 	}
 
-	bool ExtendedInputAttributes::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool ExtendedInputAttributes::set_attribute(std::uint8_t, std::uint32_t, const VTObjectPool &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false;
@@ -7280,12 +7389,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool ObjectPointer::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool ObjectPointer::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		return ((NULL_OBJECT_ID == value) || (nullptr != get_object_by_id(value, objectPool)));
 	}
 
-	bool ObjectPointer::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool ObjectPointer::set_attribute(std::uint8_t, std::uint32_t, const VTObjectPool &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false;
@@ -7349,16 +7458,16 @@ namespace isobus
 		return 9;
 	}
 
-	bool ExternalObjectPointer::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool ExternalObjectPointer::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool isDefaultObjectValid = (NULL_OBJECT_ID == get_default_object_id()) ||
-		  (nullptr != objectPool.at(get_default_object_id()));
+		  (nullptr != objectPool.get_object_by_id(get_default_object_id()));
 		bool isExternalNAMEIDValid = (NULL_OBJECT_ID == get_external_reference_name_id()) ||
-		  (nullptr != objectPool.at(get_external_reference_name_id()));
+		  (nullptr != objectPool.get_object_by_id(get_external_reference_name_id()));
 		return (isDefaultObjectValid && isExternalNAMEIDValid);
 	}
 
-	bool ExternalObjectPointer::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool ExternalObjectPointer::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -7533,12 +7642,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool Macro::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool Macro::get_is_valid(const VTObjectPool &) const
 	{
 		return get_are_command_packets_valid();
 	}
 
-	bool Macro::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool Macro::set_attribute(std::uint8_t, std::uint32_t, const VTObjectPool &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false;
@@ -7653,12 +7762,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool ColourMap::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool ColourMap::get_is_valid(const VTObjectPool &) const
 	{
 		return true;
 	}
 
-	bool ColourMap::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool ColourMap::set_attribute(std::uint8_t, std::uint32_t, const VTObjectPool &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false;
@@ -7748,7 +7857,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool WindowMask::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool WindowMask::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -7767,23 +7876,15 @@ namespace isobus
 					}
 					else if (VirtualTerminalObjectType::ObjectPointer == titleObject->get_object_type())
 					{
-						if (0 == titleObject->get_number_children())
+						auto child = get_object_by_id(static_cast<ObjectPointer *>(titleObject)->get_value(), objectPool);
+
+						if ((nullptr != child) && (VirtualTerminalObjectType::OutputString == child->get_object_type()))
 						{
-							anyWrongChildType = true;
+							// Valid
 						}
 						else
 						{
-							std::uint16_t titleObjectPointedTo = std::static_pointer_cast<ObjectPointer>(titleObject)->get_child_id(0);
-							auto child = get_object_by_id(titleObjectPointedTo, objectPool);
-
-							if ((nullptr != child) && (VirtualTerminalObjectType::OutputString == child->get_object_type()))
-							{
-								// Valid
-							}
-							else
-							{
-								anyWrongChildType = true;
-							}
+							anyWrongChildType = true;
 						}
 					}
 					else
@@ -7814,23 +7915,15 @@ namespace isobus
 					}
 					else if (VirtualTerminalObjectType::ObjectPointer == nameObject->get_object_type())
 					{
-						if (0 == nameObject->get_number_children())
+						auto child = get_object_by_id(static_cast<ObjectPointer *>(nameObject)->get_value(), objectPool);
+
+						if ((nullptr != child) && (VirtualTerminalObjectType::OutputString == child->get_object_type()))
 						{
-							anyWrongChildType = true;
+							// Valid
 						}
 						else
 						{
-							std::uint16_t titleObjectPointedTo = std::static_pointer_cast<ObjectPointer>(nameObject)->get_child_id(0);
-							auto child = get_object_by_id(titleObjectPointedTo, objectPool);
-
-							if ((nullptr != child) && (VirtualTerminalObjectType::OutputString == child->get_object_type()))
-							{
-								// Valid
-							}
-							else
-							{
-								anyWrongChildType = true;
-							}
+							anyWrongChildType = true;
 						}
 					}
 					else
@@ -8105,7 +8198,7 @@ namespace isobus
 		return !anyWrongChildType;
 	}
 
-	bool WindowMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool WindowMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -8269,7 +8362,7 @@ namespace isobus
 		return 6;
 	}
 
-	bool AuxiliaryFunctionType1::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool AuxiliaryFunctionType1::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		// Despite modern VTs not using this object, we still have to validate it.
 		bool anyWrongChildType = false;
@@ -8310,7 +8403,7 @@ namespace isobus
 		return !anyWrongChildType;
 	}
 
-	bool AuxiliaryFunctionType1::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool AuxiliaryFunctionType1::set_attribute(std::uint8_t, std::uint32_t, const VTObjectPool &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false; // All attributes are read only
@@ -8348,7 +8441,7 @@ namespace isobus
 		return 6;
 	}
 
-	bool AuxiliaryFunctionType2::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool AuxiliaryFunctionType2::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -8394,7 +8487,7 @@ namespace isobus
 		return !anyWrongChildType;
 	}
 
-	bool AuxiliaryFunctionType2::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool AuxiliaryFunctionType2::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -8484,7 +8577,7 @@ namespace isobus
 		return 7;
 	}
 
-	bool AuxiliaryInputType1::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool AuxiliaryInputType1::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -8524,7 +8617,7 @@ namespace isobus
 		return !anyWrongChildType;
 	}
 
-	bool AuxiliaryInputType1::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool AuxiliaryInputType1::set_attribute(std::uint8_t, std::uint32_t, const VTObjectPool &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false; // All attributes are read only
@@ -8579,7 +8672,7 @@ namespace isobus
 		return 6;
 	}
 
-	bool AuxiliaryInputType2::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool AuxiliaryInputType2::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -8625,7 +8718,7 @@ namespace isobus
 		return !anyWrongChildType;
 	}
 
-	bool AuxiliaryInputType2::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool AuxiliaryInputType2::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -8728,7 +8821,7 @@ namespace isobus
 		return 6;
 	}
 
-	bool AuxiliaryControlDesignatorType2::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool AuxiliaryControlDesignatorType2::get_is_valid(const VTObjectPool &objectPool) const
 	{
 		bool retVal = (((NULL_OBJECT_ID == auxiliaryObjectID) || ((nullptr != get_object_by_id(auxiliaryObjectID, objectPool)))) && (pointerType <= 3));
 
@@ -8750,7 +8843,7 @@ namespace isobus
 		return retVal;
 	}
 
-	bool AuxiliaryControlDesignatorType2::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool AuxiliaryControlDesignatorType2::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectPool &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 		returnedError = AttributeError::InvalidAttributeID;
@@ -8759,8 +8852,8 @@ namespace isobus
 		{
 			if ((NULL_OBJECT_ID == rawAttributeData) ||
 			    ((nullptr != get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool)) &&
-			     ((VirtualTerminalObjectType::AuxiliaryFunctionType2 == objectPool.at(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()) ||
-			      (VirtualTerminalObjectType::AuxiliaryInputType2 == objectPool.at(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()))))
+			     ((VirtualTerminalObjectType::AuxiliaryFunctionType2 == objectPool.get_object_by_id(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()) ||
+			      (VirtualTerminalObjectType::AuxiliaryInputType2 == objectPool.get_object_by_id(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()))))
 			{
 				set_auxiliary_object_id(static_cast<std::uint16_t>(rawAttributeData));
 				retVal = true;
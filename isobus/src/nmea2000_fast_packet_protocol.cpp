@@ -102,11 +102,18 @@ namespace isobus
 		return numberOfFrames;
 	}
 
-	FastPacketProtocol::FastPacketProtocol(const CANMessageFrameCallback &sendCANFrameCallback) :
-	  sendCANFrameCallback(sendCANFrameCallback)
+	FastPacketProtocol::FastPacketProtocol(const CANMessageFrameCallback &sendCANFrameCallback,
+	                                       std::shared_ptr<TransportProtocolBufferPool> bufferPool) :
+	  sendCANFrameCallback(sendCANFrameCallback),
+	  bufferPool((nullptr != bufferPool) ? bufferPool : std::make_shared<TransportProtocolBufferPool>())
 	{
 	}
 
+	std::shared_ptr<TransportProtocolBufferPool> FastPacketProtocol::get_buffer_pool() const
+	{
+		return bufferPool;
+	}
+
 	void FastPacketProtocol::register_multipacket_message_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction)
 	{
 		parameterGroupNumberCallbacks.emplace_back(parameterGroupNumber, callback, parent, internalControlFunction);
@@ -184,6 +191,7 @@ namespace isobus
 
 		LOCK_GUARD(Mutex, sessionMutex);
 		activeSessions.push_back(session);
+		sessionIndex.add(session);
 		return true;
 	}
 
@@ -244,9 +252,16 @@ namespace isobus
 			session->complete(successful);
 			add_session_history(session);
 
+			if (FastPacketProtocolSession::Direction::Receive == session->get_direction())
+			{
+				// Give the buffer back to the pool, it will be empty if it was already handed over to a completed message
+				bufferPool->release(std::move(static_cast<CANMessageDataVector &>(session->get_data())));
+			}
+
 			auto sessionLocation = std::find(activeSessions.begin(), activeSessions.end(), session);
 			if (activeSessions.end() != sessionLocation)
 			{
+				sessionIndex.remove(session);
 				activeSessions.erase(sessionLocation);
 			}
 		}
@@ -361,6 +376,7 @@ namespace isobus
 							callback.get_callback()(completedMessage, callback.get_parent());
 						}
 					}
+					bufferPool->release(completedMessage.release_data());
 					close_session(session, true);
 				}
 			}
@@ -392,7 +408,7 @@ namespace isobus
 
 				// Create a new session
 				session = std::make_shared<FastPacketProtocolSession>(FastPacketProtocolSession::Direction::Receive,
-				                                                      std::unique_ptr<CANMessageData>(new CANMessageDataVector(messageLength)),
+				                                                      std::unique_ptr<CANMessageData>(new CANMessageDataVector(bufferPool->acquire(messageLength))),
 				                                                      message.get_identifier().get_parameter_group_number(),
 				                                                      messageLength,
 				                                                      (message.get_uint8_at(0) & SEQUENCE_NUMBER_BIT_MASK),
@@ -413,6 +429,7 @@ namespace isobus
 
 				LOCK_GUARD(Mutex, sessionMutex);
 				activeSessions.push_back(session);
+				sessionIndex.add(session);
 			}
 		}
 	}
@@ -494,9 +511,7 @@ namespace isobus
 	bool FastPacketProtocol::has_session(std::uint32_t parameterGroupNumber, std::shared_ptr<ControlFunction> source, std::shared_ptr<ControlFunction> destination)
 	{
 		LOCK_GUARD(Mutex, sessionMutex);
-		return std::any_of(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<FastPacketProtocolSession> &session) {
-			return session->matches(source, destination) && (session->get_parameter_group_number() == parameterGroupNumber);
-		});
+		return nullptr != sessionIndex.find(source.get(), destination.get(), parameterGroupNumber);
 	}
 
 	std::shared_ptr<FastPacketProtocol::FastPacketProtocolSession> FastPacketProtocol::get_session(std::uint32_t parameterGroupNumber,
@@ -504,10 +519,7 @@ namespace isobus
 	                                                                                               std::shared_ptr<ControlFunction> destination)
 	{
 		LOCK_GUARD(Mutex, sessionMutex);
-		auto result = std::find_if(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<FastPacketProtocolSession> &session) {
-			return session->matches(source, destination) && (session->get_parameter_group_number() == parameterGroupNumber);
-		});
-		return (activeSessions.end() != result) ? (*result) : nullptr;
+		return std::static_pointer_cast<FastPacketProtocolSession>(sessionIndex.find(source.get(), destination.get(), parameterGroupNumber));
 	}
 
 } // namespace isobus
@@ -7,6 +7,7 @@
 #include "isobus/hardware_integration/virtual_can_plugin.hpp"
 #include "isobus/isobus/can_message.hpp"
 #include "isobus/isobus/can_message_frame.hpp"
+#include "isobus/isobus/can_message_view.hpp"
 #include "isobus/isobus/can_network_manager.hpp"
 
 using namespace isobus;
@@ -71,3 +72,114 @@ TEST(CAN_MESSAGE_TESTS, DataCorrectnessTest)
 	CANNetworkManager::CANNetwork.remove_global_parameter_group_number_callback(0xE100, callback, nullptr);
 	CANHardwareInterface::stop();
 }
+
+TEST(CAN_MESSAGE_TESTS, PayloadStorage)
+{
+	// Single frame payloads are stored inline
+	const std::uint8_t frameData[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	CANMessage message(CANMessage::Type::Receive, CANIdentifier(0x18EFFF80), frameData, sizeof(frameData), nullptr, nullptr, 0);
+	EXPECT_TRUE(message.get_data().is_inline());
+	EXPECT_EQ(8, message.get_data_length());
+	EXPECT_EQ(0x0201, message.get_uint16_at(0));
+	EXPECT_THROW(message.get_data().at(8), std::out_of_range);
+
+	// Growing past a single frame spills to the heap and keeps the existing data
+	message.set_data_size(20);
+	EXPECT_FALSE(message.get_data().is_inline());
+	EXPECT_EQ(20, message.get_data_length());
+	EXPECT_EQ(8, message.get_uint8_at(7));
+	EXPECT_EQ(0, message.get_uint8_at(19));
+
+	// Large payloads are moved in without copying the buffer
+	std::vector<std::uint8_t> largeData(100, 0xAA);
+	const std::uint8_t *largeDataBuffer = largeData.data();
+	CANMessage largeMessage(CANMessage::Type::Receive, CANIdentifier(0x18EFFF80), std::move(largeData), nullptr, nullptr, 0);
+	EXPECT_FALSE(largeMessage.get_data().is_inline());
+	EXPECT_EQ(largeDataBuffer, largeMessage.get_data().data());
+	EXPECT_EQ(100, largeMessage.get_data_length());
+
+	// Copies and moves keep the data intact
+	CANMessage copiedMessage = message;
+	EXPECT_TRUE(copiedMessage.get_data() == message.get_data());
+	CANMessage movedMessage = std::move(copiedMessage);
+	EXPECT_EQ(20, movedMessage.get_data_length());
+	EXPECT_EQ(0x0403, movedMessage.get_uint16_at(2));
+
+	// Converting to a vector copies, so it has to be asked for explicitly
+	std::vector<std::uint8_t> dataAsVector(movedMessage.get_data());
+	EXPECT_EQ(20, dataAsVector.size());
+	EXPECT_EQ(5, dataAsVector.at(4));
+
+	CANMessagePayload payload;
+	EXPECT_TRUE(payload.empty());
+	payload.append(frameData, 4);
+	payload.append(frameData, 4);
+	EXPECT_TRUE(payload.is_inline());
+	EXPECT_EQ(8, payload.size());
+	EXPECT_EQ(4, payload[3]);
+	EXPECT_EQ(1, payload[4]);
+	payload.clear();
+	EXPECT_TRUE(payload.empty());
+	EXPECT_TRUE(payload.is_inline());
+}
+
+static std::size_t viewCallbackCount = 0;
+static std::uint16_t viewCallbackValue = 0;
+static void test_view_callback(const CANMessageView &message, void *)
+{
+	viewCallbackCount++;
+	viewCallbackValue = message.get_uint16_at(0);
+}
+
+TEST(CAN_MESSAGE_TESTS, MessageView)
+{
+	CANMessageFrame frame = {};
+	frame.identifier = 0x18FEF081;
+	frame.isExtendedFrame = true;
+	frame.dataLength = 8;
+	frame.channel = 2;
+	for (std::uint8_t i = 0; i < 8; i++)
+	{
+		frame.data[i] = i + 1;
+	}
+
+	// A view over a frame reads directly from the frame's data
+	CANMessageView frameView(frame, nullptr, nullptr);
+	EXPECT_EQ(0xFEF0, frameView.get_identifier().get_parameter_group_number());
+	EXPECT_EQ(8, frameView.get_data_length());
+	EXPECT_EQ(2, frameView.get_can_port_index());
+	EXPECT_EQ(&frame.data[0], &frameView.get_data()[0]);
+	EXPECT_EQ(0x0201, frameView.get_uint16_at(0));
+	EXPECT_EQ(0x0102, frameView.get_uint16_at(0, CANMessage::ByteFormat::BigEndian));
+	EXPECT_EQ(0x08070605, frameView.get_uint32_at(4));
+	EXPECT_EQ(0x0807060504030201, frameView.get_uint64_at(0));
+	EXPECT_EQ(770, frameView.get_data_custom_length(8, 16));
+	EXPECT_THROW(frameView.get_uint32_at(6), std::out_of_range);
+
+	// A view over a message gives the same results as the message itself
+	CANMessage message(CANMessage::Type::Receive, CANIdentifier(frame.identifier), frame.data, frame.dataLength, nullptr, nullptr, frame.channel);
+	CANMessageView messageView(message);
+	EXPECT_EQ(message.get_data().data(), &messageView.get_data()[0]);
+	EXPECT_EQ(message.get_uint64_at(0), messageView.get_uint64_at(0));
+	EXPECT_EQ(message.get_int16_at(2, CANMessage::ByteFormat::BigEndian), messageView.get_int16_at(2, CANMessage::ByteFormat::BigEndian));
+	EXPECT_EQ(message.get_bool_at(0, 0), messageView.get_bool_at(0, 0));
+
+	// View callbacks are dispatched like regular callbacks
+	CANNetworkManager::CANNetwork.update(); // Make sure the network manager is initialized
+	CANNetworkManager::CANNetwork.add_any_control_function_parameter_group_number_view_callback(0xFEF0, test_view_callback, nullptr);
+	viewCallbackCount = 0;
+	CANNetworkManager::CANNetwork.process_receive_can_message_frame(frame);
+	CANNetworkManager::CANNetwork.update();
+	EXPECT_EQ(1, viewCallbackCount);
+	EXPECT_EQ(0x0201, viewCallbackValue);
+
+	CANNetworkManager::CANNetwork.remove_any_control_function_parameter_group_number_view_callback(0xFEF0, test_view_callback, nullptr);
+	CANNetworkManager::CANNetwork.process_receive_can_message_frame(frame);
+	CANNetworkManager::CANNetwork.update();
+	EXPECT_EQ(1, viewCallbackCount);
+
+	// A view callback is stored alongside an empty regular callback
+	ParameterGroupNumberCallbackData viewCallbackData(0xFEF0, nullptr, nullptr, nullptr, test_view_callback);
+	EXPECT_EQ(nullptr, viewCallbackData.get_callback());
+	EXPECT_EQ(test_view_callback, viewCallbackData.get_view_callback());
+}
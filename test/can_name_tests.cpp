@@ -106,3 +106,64 @@ TEST(CAN_NAME_TESTS, FilterMatches)
 	TestDeviceNAME.set_arbitrary_address_capable(true);
 	EXPECT_TRUE(filterArbitraryAddressCapable.check_name_matches_filter(TestDeviceNAME));
 }
+
+TEST(CAN_NAME_TESTS, FilterOutOfRangeValue)
+{
+	// An ECU instance is only 3 bits, so a filter for 8 can never match
+	NAMEFilter filterECUInstance(NAME::NAMEParameters::EcuInstance, 8);
+	NAME TestDeviceNAME(0xFFFFFFFFFFFFFFFF);
+	std::uint64_t mask = 0;
+	std::uint64_t value = 0;
+	EXPECT_FALSE(filterECUInstance.get_mask_and_value(mask, value));
+	EXPECT_FALSE(filterECUInstance.check_name_matches_filter(TestDeviceNAME));
+
+	NAMEFilter filterFunctionCode(NAME::NAMEParameters::FunctionCode, 0x81);
+	EXPECT_TRUE(filterFunctionCode.get_mask_and_value(mask, value));
+	EXPECT_EQ(0x0000FF0000000000, mask);
+	EXPECT_EQ(0x0000810000000000, value);
+}
+
+TEST(CAN_NAME_TESTS, NAMEMatcher)
+{
+	NAME TestDeviceNAME(0);
+	TestDeviceNAME.set_function_code(5);
+	TestDeviceNAME.set_device_class(6);
+	TestDeviceNAME.set_arbitrary_address_capable(true);
+
+	NAMEMatcher emptyMatcher(std::vector<NAMEFilter>{});
+	EXPECT_FALSE(emptyMatcher.get_can_match());
+	EXPECT_FALSE(emptyMatcher.matches(TestDeviceNAME));
+
+	NAMEMatcher matcher({ NAMEFilter(NAME::NAMEParameters::FunctionCode, 5),
+	                      NAMEFilter(NAME::NAMEParameters::DeviceClass, 6),
+	                      NAMEFilter(NAME::NAMEParameters::ArbitraryAddressCapable, 1) });
+	EXPECT_TRUE(matcher.get_can_match());
+	EXPECT_TRUE(matcher.matches(TestDeviceNAME));
+
+	// All filters have to match
+	TestDeviceNAME.set_device_class(7);
+	EXPECT_FALSE(matcher.matches(TestDeviceNAME));
+	TestDeviceNAME.set_device_class(6);
+	TestDeviceNAME.set_arbitrary_address_capable(false);
+	EXPECT_FALSE(matcher.matches(TestDeviceNAME));
+	TestDeviceNAME.set_arbitrary_address_capable(true);
+
+	// Components that aren't filtered don't matter
+	TestDeviceNAME.set_identity_number(1234);
+	TestDeviceNAME.set_ecu_instance(3);
+	EXPECT_TRUE(matcher.matches(TestDeviceNAME));
+
+	// Repeating a filter is fine, but two different values for one component can never match
+	NAMEMatcher repeatedMatcher({ NAMEFilter(NAME::NAMEParameters::FunctionCode, 5),
+	                              NAMEFilter(NAME::NAMEParameters::FunctionCode, 5) });
+	EXPECT_TRUE(repeatedMatcher.matches(TestDeviceNAME));
+
+	NAMEMatcher conflictingMatcher({ NAMEFilter(NAME::NAMEParameters::FunctionCode, 5),
+	                                 NAMEFilter(NAME::NAMEParameters::FunctionCode, 6) });
+	EXPECT_FALSE(conflictingMatcher.get_can_match());
+	EXPECT_FALSE(conflictingMatcher.matches(TestDeviceNAME));
+
+	NAMEMatcher outOfRangeMatcher({ NAMEFilter(NAME::NAMEParameters::FunctionCode, 5),
+	                                NAMEFilter(NAME::NAMEParameters::EcuInstance, 11) });
+	EXPECT_FALSE(outOfRangeMatcher.matches(TestDeviceNAME));
+}
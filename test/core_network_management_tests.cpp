@@ -290,3 +290,381 @@ TEST(CORE_TESTS, SimilarControlFunctions)
 	EXPECT_EQ(TestPartner->get_NAME().get_full_name(), 0xa0000F000425e9f8);
 	CANNetworkManager::CANNetwork.deactivate_control_function(TestPartner);
 }
+
+static std::vector<std::uintptr_t> callbackTableHits;
+static void test_callback_table_callback(const CANMessage &, void *parent)
+{
+	callbackTableHits.push_back(reinterpret_cast<std::uintptr_t>(parent));
+}
+
+TEST(CORE_TESTS, ParameterGroupNumberCallbackTable)
+{
+	ParameterGroupNumberCallbackTable table;
+	EXPECT_EQ(0, table.size());
+	EXPECT_EQ(0, table.get_number_callbacks(0xEF00));
+
+	// Register a lot of PGNs, with a few of them getting more than one callback
+	for (std::uintptr_t i = 0; i < 500; i++)
+	{
+		table.add_callback(ParameterGroupNumberCallbackData(0xFF00 - static_cast<std::uint32_t>(i), test_callback_table_callback, reinterpret_cast<void *>(i), nullptr));
+	}
+	table.add_callback(ParameterGroupNumberCallbackData(0xFEFF, test_callback_table_callback, reinterpret_cast<void *>(1000), nullptr));
+	table.add_callback(ParameterGroupNumberCallbackData(0xFEFF, test_callback_table_callback, reinterpret_cast<void *>(1001), nullptr));
+	EXPECT_EQ(502, table.size());
+	EXPECT_EQ(3, table.get_number_callbacks(0xFEFF));
+	EXPECT_EQ(1, table.get_number_callbacks(0xFF00));
+	EXPECT_EQ(0, table.get_number_callbacks(0xEF00));
+
+	// Callbacks must be sorted by PGN in the table
+	for (std::size_t i = 1; i < table.size(); i++)
+	{
+		EXPECT_LE(table.get_callback(i - 1).get_parameter_group_number(), table.get_callback(i).get_parameter_group_number());
+	}
+
+	// Callbacks for a PGN are called in the order they were added
+	CANMessage testMessage = CANMessage::create_invalid_message();
+	callbackTableHits.clear();
+	table.for_each_callback(0xFEFF, [&testMessage](const ParameterGroupNumberCallbackData &callback) {
+		callback.get_callback()(testMessage, callback.get_parent());
+	});
+	ASSERT_EQ(3, callbackTableHits.size());
+	EXPECT_EQ(1, callbackTableHits[0]);
+	EXPECT_EQ(1000, callbackTableHits[1]);
+	EXPECT_EQ(1001, callbackTableHits[2]);
+
+	callbackTableHits.clear();
+	table.for_each_callback(0xEF00, [&testMessage](const ParameterGroupNumberCallbackData &callback) {
+		callback.get_callback()(testMessage, callback.get_parent());
+	});
+	EXPECT_TRUE(callbackTableHits.empty());
+
+	EXPECT_TRUE(table.contains(ParameterGroupNumberCallbackData(0xFEFF, test_callback_table_callback, reinterpret_cast<void *>(1000), nullptr)));
+	EXPECT_TRUE(table.remove_callback(ParameterGroupNumberCallbackData(0xFEFF, test_callback_table_callback, reinterpret_cast<void *>(1000), nullptr)));
+	EXPECT_FALSE(table.remove_callback(ParameterGroupNumberCallbackData(0xFEFF, test_callback_table_callback, reinterpret_cast<void *>(1000), nullptr)));
+	EXPECT_FALSE(table.contains(ParameterGroupNumberCallbackData(0xFEFF, test_callback_table_callback, reinterpret_cast<void *>(1000), nullptr)));
+	EXPECT_EQ(2, table.get_number_callbacks(0xFEFF));
+
+	for (std::uintptr_t i = 0; i < 500; i++)
+	{
+		EXPECT_TRUE(table.remove_callback(ParameterGroupNumberCallbackData(0xFF00 - static_cast<std::uint32_t>(i), test_callback_table_callback, reinterpret_cast<void *>(i), nullptr)));
+	}
+	EXPECT_EQ(1, table.size());
+	EXPECT_EQ(1, table.get_number_callbacks(0xFEFF));
+	EXPECT_EQ(0, table.get_number_callbacks(0xFF00));
+
+	// Changes made while dispatching only apply from the next dispatch on
+	table.add_callback(ParameterGroupNumberCallbackData(0xFEFF, test_callback_table_callback, reinterpret_cast<void *>(1002), nullptr));
+	callbackTableHits.clear();
+	table.for_each_callback(0xFEFF, [&testMessage, &table](const ParameterGroupNumberCallbackData &callback) {
+		if (1001 == reinterpret_cast<std::uintptr_t>(callback.get_parent()))
+		{
+			EXPECT_TRUE(table.remove_callback(callback));
+			table.add_callback(ParameterGroupNumberCallbackData(0xFEFF, test_callback_table_callback, reinterpret_cast<void *>(1003), nullptr));
+		}
+		callback.get_callback()(testMessage, callback.get_parent());
+	});
+	ASSERT_EQ(2, callbackTableHits.size());
+	EXPECT_EQ(1001, callbackTableHits[0]);
+	EXPECT_EQ(1002, callbackTableHits[1]);
+
+	callbackTableHits.clear();
+	table.for_each_callback(0xFEFF, [&testMessage](const ParameterGroupNumberCallbackData &callback) {
+		callback.get_callback()(testMessage, callback.get_parent());
+	});
+	ASSERT_EQ(2, callbackTableHits.size());
+	EXPECT_EQ(1002, callbackTableHits[0]);
+	EXPECT_EQ(1003, callbackTableHits[1]);
+}
+
+static std::uint64_t batchedMessageSourceNAME = 0;
+static std::size_t batchedMessageCount = 0;
+static void test_batched_frames_callback(const CANMessage &message, void *)
+{
+	batchedMessageCount++;
+	if (nullptr != message.get_source_control_function())
+	{
+		batchedMessageSourceNAME = message.get_source_control_function()->get_NAME().get_full_name();
+	}
+}
+
+TEST(CORE_TESTS, ReceiveFramesInBatch)
+{
+	CANNetworkManager::CANNetwork.update(); // Make sure the network manager is initialized
+	CANNetworkManager::CANNetwork.add_global_parameter_group_number_callback(0xFEF0, test_batched_frames_callback, nullptr);
+
+	constexpr std::uint64_t rawNAME = 0xa00c81045a20021b;
+	auto sender = test_helpers::create_mock_control_function(0x9A);
+
+	// An address claim followed by a message from that address, the message must resolve to the newly claimed CF
+	std::vector<CANMessageFrame> frames;
+	frames.push_back(test_helpers::create_message_frame_broadcast(
+	  6,
+	  0xEE00, // Address Claim PGN
+	  sender,
+	  {
+	    static_cast<std::uint8_t>(rawNAME),
+	    static_cast<std::uint8_t>(rawNAME >> 8),
+	    static_cast<std::uint8_t>(rawNAME >> 16),
+	    static_cast<std::uint8_t>(rawNAME >> 24),
+	    static_cast<std::uint8_t>(rawNAME >> 32),
+	    static_cast<std::uint8_t>(rawNAME >> 40),
+	    static_cast<std::uint8_t>(rawNAME >> 48),
+	    static_cast<std::uint8_t>(rawNAME >> 56),
+	  }));
+	for (std::uint8_t i = 0; i < 10; i++)
+	{
+		frames.push_back(test_helpers::create_message_frame_broadcast(6, 0xFEF0, sender, { i, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF }));
+	}
+
+	batchedMessageCount = 0;
+	batchedMessageSourceNAME = 0;
+	CANNetworkManager::CANNetwork.process_receive_can_message_frames(frames.data(), frames.size());
+	CANNetworkManager::CANNetwork.process_receive_can_message_frames(nullptr, 5); // Should be ignored
+	CANNetworkManager::CANNetwork.update();
+
+	EXPECT_EQ(10, batchedMessageCount);
+	EXPECT_EQ(rawNAME, batchedMessageSourceNAME);
+
+	CANNetworkManager::CANNetwork.remove_global_parameter_group_number_callback(0xFEF0, test_batched_frames_callback, nullptr);
+}
+
+static std::array<std::size_t, CAN_PORT_MAXIMUM> portWorkerMessageCounts;
+static std::array<std::thread::id, CAN_PORT_MAXIMUM> portWorkerThreadIds;
+static void test_port_worker_callback(const CANMessage &message, void *)
+{
+	// Each port is only ever touched by one thread, so no locking is needed here
+	portWorkerMessageCounts[message.get_can_port_index()]++;
+	portWorkerThreadIds[message.get_can_port_index()] = std::this_thread::get_id();
+}
+
+TEST(CORE_TESTS, PortWorkerThreads)
+{
+	CANNetworkManager::CANNetwork.update(); // Make sure the network manager is initialized
+	CANNetworkManager::CANNetwork.add_any_control_function_parameter_group_number_callback(0xFEF1, test_port_worker_callback, nullptr);
+
+	EXPECT_FALSE(CANNetworkManager::CANNetwork.get_port_worker_threads_enabled());
+	EXPECT_FALSE(CANNetworkManager::CANNetwork.set_port_worker_threads_enabled(true, 1));
+	EXPECT_FALSE(CANNetworkManager::CANNetwork.get_port_worker_threads_enabled());
+	EXPECT_TRUE(CANNetworkManager::CANNetwork.set_port_worker_threads_enabled(true, CAN_PORT_MAXIMUM));
+	EXPECT_TRUE(CANNetworkManager::CANNetwork.get_port_worker_threads_enabled());
+
+	portWorkerMessageCounts.fill(0);
+	for (std::uint8_t round = 0; round < 3; round++)
+	{
+		for (std::uint8_t port = 0; port < CAN_PORT_MAXIMUM; port++)
+		{
+			for (std::uint8_t i = 0; i <= port; i++)
+			{
+				CANMessageFrame frame = test_helpers::create_message_frame_raw(0x18FEF1A0 | port, { i, round, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF });
+				frame.channel = port;
+				CANNetworkManager::CANNetwork.process_receive_can_message_frame(frame);
+			}
+		}
+		CANNetworkManager::CANNetwork.update();
+	}
+
+	for (std::uint8_t port = 0; port < CAN_PORT_MAXIMUM; port++)
+	{
+		EXPECT_EQ(3u * (port + 1u), portWorkerMessageCounts[port]);
+	}
+	// The first port is updated by the caller, and each of the others by its own worker
+	EXPECT_EQ(std::this_thread::get_id(), portWorkerThreadIds[0]);
+	for (std::uint8_t port = 1; port < CAN_PORT_MAXIMUM; port++)
+	{
+		EXPECT_NE(std::this_thread::get_id(), portWorkerThreadIds[port]);
+		for (std::uint8_t otherPort = port + 1; otherPort < CAN_PORT_MAXIMUM; otherPort++)
+		{
+			EXPECT_NE(portWorkerThreadIds[otherPort], portWorkerThreadIds[port]);
+		}
+	}
+
+	// Only the ports in use get a worker, the others are updated by the caller
+	EXPECT_TRUE(CANNetworkManager::CANNetwork.set_port_worker_threads_enabled(true, 2));
+	EXPECT_TRUE(CANNetworkManager::CANNetwork.get_port_worker_threads_enabled());
+	portWorkerThreadIds.fill(std::thread::id());
+	for (std::uint8_t port = 1; port < 4; port += 2)
+	{
+		CANMessageFrame frame = test_helpers::create_message_frame_raw(0x18FEF1A0 | port, { 0, 0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF });
+		frame.channel = port;
+		CANNetworkManager::CANNetwork.process_receive_can_message_frame(frame);
+	}
+	CANNetworkManager::CANNetwork.update();
+	EXPECT_EQ(7, portWorkerMessageCounts[1]);
+	EXPECT_EQ(13, portWorkerMessageCounts[3]);
+	EXPECT_NE(std::this_thread::get_id(), portWorkerThreadIds[1]);
+	EXPECT_EQ(std::this_thread::get_id(), portWorkerThreadIds[3]);
+
+	// Turning it off processes everything on the calling thread again
+	EXPECT_TRUE(CANNetworkManager::CANNetwork.set_port_worker_threads_enabled(false, 2));
+	EXPECT_FALSE(CANNetworkManager::CANNetwork.get_port_worker_threads_enabled());
+	CANMessageFrame frame = test_helpers::create_message_frame_raw(0x18FEF1A1, { 0, 0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF });
+	frame.channel = 1;
+	CANNetworkManager::CANNetwork.process_receive_can_message_frame(frame);
+	CANNetworkManager::CANNetwork.update();
+	EXPECT_EQ(8, portWorkerMessageCounts[1]);
+	EXPECT_EQ(std::this_thread::get_id(), portWorkerThreadIds[1]);
+
+	CANNetworkManager::CANNetwork.remove_any_control_function_parameter_group_number_callback(0xFEF1, test_port_worker_callback, nullptr);
+}
+
+TEST(CORE_TESTS, AddressClaimStorm)
+{
+	CANNetworkManager::CANNetwork.update(); // Make sure the network manager is initialized
+
+	constexpr std::uint8_t NUMBER_OF_ECUS = 30;
+	constexpr std::uint8_t FIRST_ADDRESS = 0xC0;
+
+	// A partner that should pick out one of the ECUs by its NAME
+	const std::vector<NAMEFilter> nameFilters = { NAMEFilter(NAME::NAMEParameters::FunctionCode, 200),
+		                                          NAMEFilter(NAME::NAMEParameters::IdentityNumber, 17) };
+	auto partner = CANNetworkManager::CANNetwork.create_partnered_control_function(0, nameFilters);
+	CANNetworkManager::CANNetwork.update();
+
+	// Lots of ECUs powering up together all claim at once
+	auto claim_all = [](std::uint8_t firstAddress) {
+		std::vector<CANMessageFrame> frames;
+		for (std::uint8_t i = 0; i < NUMBER_OF_ECUS; i++)
+		{
+			NAME ecuNAME(0);
+			ecuNAME.set_identity_number(i);
+			ecuNAME.set_function_code(200);
+			ecuNAME.set_industry_group(2);
+			const std::uint64_t rawNAME = ecuNAME.get_full_name();
+			frames.push_back(test_helpers::create_message_frame_broadcast(
+			  6,
+			  0xEE00, // Address Claim PGN
+			  test_helpers::create_mock_control_function(firstAddress + i),
+			  {
+			    static_cast<std::uint8_t>(rawNAME),
+			    static_cast<std::uint8_t>(rawNAME >> 8),
+			    static_cast<std::uint8_t>(rawNAME >> 16),
+			    static_cast<std::uint8_t>(rawNAME >> 24),
+			    static_cast<std::uint8_t>(rawNAME >> 32),
+			    static_cast<std::uint8_t>(rawNAME >> 40),
+			    static_cast<std::uint8_t>(rawNAME >> 48),
+			    static_cast<std::uint8_t>(rawNAME >> 56),
+			  }));
+		}
+		CANNetworkManager::CANNetwork.process_receive_can_message_frames(frames.data(), frames.size());
+		CANNetworkManager::CANNetwork.update();
+	};
+	claim_all(FIRST_ADDRESS);
+
+	std::vector<std::shared_ptr<ControlFunction>> ecus;
+	for (std::uint8_t i = 0; i < NUMBER_OF_ECUS; i++)
+	{
+		auto ecu = CANNetworkManager::CANNetwork.get_control_function(0, FIRST_ADDRESS + i);
+		ASSERT_NE(nullptr, ecu);
+		EXPECT_EQ(i, ecu->get_NAME().get_identity_number());
+		EXPECT_EQ(FIRST_ADDRESS + i, ecu->get_address());
+		EXPECT_EQ(ecu, CANNetworkManager::CANNetwork.get_control_function_by_name(0, ecu->get_NAME()));
+		EXPECT_EQ(nullptr, CANNetworkManager::CANNetwork.get_control_function_by_name(1, ecu->get_NAME()));
+		ecus.push_back(ecu);
+	}
+	EXPECT_EQ(partner, ecus.at(17));
+	EXPECT_EQ(ControlFunction::Type::Partnered, ecus.at(17)->get_type());
+	EXPECT_EQ(ControlFunction::Type::External, ecus.at(16)->get_type());
+
+	// Claiming again at new addresses has to resolve to the same control functions
+	claim_all(FIRST_ADDRESS + NUMBER_OF_ECUS);
+	for (std::uint8_t i = 0; i < NUMBER_OF_ECUS; i++)
+	{
+		EXPECT_EQ(nullptr, CANNetworkManager::CANNetwork.get_control_function(0, FIRST_ADDRESS + i));
+		EXPECT_EQ(ecus.at(i), CANNetworkManager::CANNetwork.get_control_function(0, FIRST_ADDRESS + NUMBER_OF_ECUS + i));
+		EXPECT_EQ(FIRST_ADDRESS + NUMBER_OF_ECUS + i, ecus.at(i)->get_address());
+	}
+
+	// A deactivated partner is replaced in the index by an external control function with its NAME
+	const NAME partnerNAME = partner->get_NAME();
+	CANNetworkManager::CANNetwork.deactivate_control_function(partner);
+	auto replacement = CANNetworkManager::CANNetwork.get_control_function_by_name(0, partnerNAME);
+	ASSERT_NE(nullptr, replacement);
+	EXPECT_NE(std::static_pointer_cast<ControlFunction>(partner), replacement);
+	EXPECT_EQ(ControlFunction::Type::External, replacement->get_type());
+	EXPECT_EQ(replacement, CANNetworkManager::CANNetwork.get_control_function(0, FIRST_ADDRESS + NUMBER_OF_ECUS + 17));
+
+	auto claim_one = [](NAME ecuNAME, std::uint8_t address) {
+		const std::uint64_t rawNAME = ecuNAME.get_full_name();
+		CANNetworkManager::CANNetwork.process_receive_can_message_frame(test_helpers::create_message_frame_broadcast(
+		  6,
+		  0xEE00, // Address Claim PGN
+		  test_helpers::create_mock_control_function(address),
+		  {
+		    static_cast<std::uint8_t>(rawNAME),
+		    static_cast<std::uint8_t>(rawNAME >> 8),
+		    static_cast<std::uint8_t>(rawNAME >> 16),
+		    static_cast<std::uint8_t>(rawNAME >> 24),
+		    static_cast<std::uint8_t>(rawNAME >> 32),
+		    static_cast<std::uint8_t>(rawNAME >> 40),
+		    static_cast<std::uint8_t>(rawNAME >> 48),
+		    static_cast<std::uint8_t>(rawNAME >> 56),
+		  }));
+		CANNetworkManager::CANNetwork.update();
+	};
+
+	// Another ECU taking over the address evicts the replacement, and it's forgotten
+	NAME intruderNAME(0);
+	intruderNAME.set_identity_number(99);
+	intruderNAME.set_function_code(201);
+	intruderNAME.set_industry_group(2);
+	claim_one(intruderNAME, FIRST_ADDRESS + NUMBER_OF_ECUS + 17);
+	EXPECT_EQ(NULL_CAN_ADDRESS, replacement->get_address());
+	EXPECT_EQ(nullptr, CANNetworkManager::CANNetwork.get_control_function_by_name(0, partnerNAME));
+	auto intruder = CANNetworkManager::CANNetwork.get_control_function_by_name(0, intruderNAME);
+	ASSERT_NE(nullptr, intruder);
+	EXPECT_EQ(intruder, CANNetworkManager::CANNetwork.get_control_function(0, FIRST_ADDRESS + NUMBER_OF_ECUS + 17));
+
+	// So a new partner gets bound when the evicted ECU claims again
+	auto newPartner = CANNetworkManager::CANNetwork.create_partnered_control_function(0, nameFilters);
+	CANNetworkManager::CANNetwork.update();
+	claim_one(partnerNAME, FIRST_ADDRESS - 1);
+	EXPECT_EQ(newPartner, CANNetworkManager::CANNetwork.get_control_function(0, FIRST_ADDRESS - 1));
+	EXPECT_EQ(newPartner, CANNetworkManager::CANNetwork.get_control_function_by_name(0, partnerNAME));
+	CANNetworkManager::CANNetwork.deactivate_control_function(newPartner);
+}
+
+TEST(CORE_TESTS, IterateWithoutAllocating)
+{
+	CANNetworkManager::CANNetwork.update(); // Make sure the network manager is initialized
+
+	constexpr std::uint64_t rawNAME = 0xa00c81045a20031b;
+	CANNetworkManager::CANNetwork.process_receive_can_message_frame(test_helpers::create_message_frame_broadcast(
+	  6,
+	  0xEE00, // Address Claim PGN
+	  test_helpers::create_mock_control_function(0x9C),
+	  {
+	    static_cast<std::uint8_t>(rawNAME),
+	    static_cast<std::uint8_t>(rawNAME >> 8),
+	    static_cast<std::uint8_t>(rawNAME >> 16),
+	    static_cast<std::uint8_t>(rawNAME >> 24),
+	    static_cast<std::uint8_t>(rawNAME >> 32),
+	    static_cast<std::uint8_t>(rawNAME >> 40),
+	    static_cast<std::uint8_t>(rawNAME >> 48),
+	    static_cast<std::uint8_t>(rawNAME >> 56),
+	  }));
+	CANNetworkManager::CANNetwork.update();
+
+	// The visitor has to see the same control functions, in the same order, as the list
+	for (bool includingOffline : { false, true })
+	{
+		std::vector<std::shared_ptr<ControlFunction>> visited;
+		CANNetworkManager::CANNetwork.for_each_control_function(includingOffline, [&visited](const std::shared_ptr<ControlFunction> &controlFunction) {
+			visited.push_back(controlFunction);
+		});
+
+		auto controlFunctions = CANNetworkManager::CANNetwork.get_control_functions(includingOffline);
+		ASSERT_EQ(controlFunctions.size(), visited.size());
+		EXPECT_TRUE(std::equal(controlFunctions.begin(), controlFunctions.end(), visited.begin()));
+		EXPECT_NE(visited.end(), std::find(visited.begin(), visited.end(), CANNetworkManager::CANNetwork.get_control_function(0, 0x9C)));
+	}
+
+	std::size_t numberOfSessions = 0;
+	auto count_sessions = [&numberOfSessions](const std::shared_ptr<TransportProtocolSessionBase> &) {
+		numberOfSessions++;
+	};
+	CANNetworkManager::CANNetwork.for_each_active_transport_protocol_session(0, count_sessions);
+	EXPECT_EQ(CANNetworkManager::CANNetwork.get_active_transport_protocol_sessions(0).size(), numberOfSessions);
+	numberOfSessions = 0;
+	CANNetworkManager::CANNetwork.for_each_active_transport_protocol_session(CAN_PORT_MAXIMUM, count_sessions);
+	EXPECT_EQ(0, numberOfSessions);
+}
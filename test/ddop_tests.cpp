@@ -728,3 +728,128 @@ TEST(DDOP_TESTS, ISOXMLOutput)
 )ISOXML";
 	EXPECT_EQ(textXML, isoxml);
 }
+
+TEST(DDOP_TESTS, LargeDDOPRoundTrip)
+{
+	LanguageCommandInterface testLanguageInterface(nullptr, nullptr);
+
+	// Large sprayers have an element per nozzle section, make sure pools of that size parse, resolve and serialize
+	for (std::uint16_t numberOfObjects : { 100, 1000, 10000 })
+	{
+		DeviceDescriptorObjectPool testDDOP;
+		const std::uint16_t numberOfSections = (numberOfObjects - 2) / 2;
+
+		ASSERT_TRUE(testDDOP.add_device("AgIsoStack++ UnitTest", "1.0.0", "123", "I++1.0", testLanguageInterface.get_localization_raw_data(), std::vector<std::uint8_t>(), 0));
+		ASSERT_TRUE(testDDOP.add_device_element("Sprayer", 0, 0, task_controller_object::DeviceElementObject::Type::Device, 1));
+		for (std::uint16_t i = 0; i < numberOfSections; i++)
+		{
+			const std::uint16_t sectionID = 2 + (2 * i);
+			ASSERT_TRUE(testDDOP.add_device_element("Section", (i % 4000) + 1, 1, task_controller_object::DeviceElementObject::Type::Section, sectionID));
+			ASSERT_TRUE(testDDOP.add_device_property("Width", 1067, static_cast<std::uint16_t>(DataDescriptionIndex::ActualWorkingWidth), NULL_OBJECT_ID, sectionID + 1));
+			std::static_pointer_cast<task_controller_object::DeviceElementObject>(testDDOP.get_object_by_id(sectionID))->add_reference_to_child_object(sectionID + 1);
+		}
+		EXPECT_EQ(numberOfObjects, testDDOP.size());
+
+		// Adding an ID that's already used has to be caught by the index
+		EXPECT_FALSE(testDDOP.add_device_property("Duplicate", 0, 0, NULL_OBJECT_ID, numberOfSections));
+
+		std::vector<std::uint8_t> binaryDDOP;
+		ASSERT_TRUE(testDDOP.generate_binary_object_pool(binaryDDOP));
+
+		DeviceDescriptorObjectPool parsedDDOP;
+		ASSERT_TRUE(parsedDDOP.deserialize_binary_object_pool(binaryDDOP, NAME(0)));
+		EXPECT_EQ(numberOfObjects, parsedDDOP.size());
+
+		std::vector<std::uint8_t> reserializedDDOP;
+		ASSERT_TRUE(parsedDDOP.generate_binary_object_pool(reserializedDDOP));
+		EXPECT_EQ(binaryDDOP, reserializedDDOP);
+
+		auto lastSection = parsedDDOP.get_object_by_id(2 + (2 * (numberOfSections - 1)));
+		ASSERT_NE(nullptr, lastSection);
+		EXPECT_EQ(task_controller_object::ObjectTypes::DeviceElement, lastSection->get_object_type());
+		EXPECT_EQ(nullptr, parsedDDOP.get_object_by_id(numberOfObjects));
+	}
+}
+
+TEST(DDOP_TESTS, ObjectIndexStaysCurrent)
+{
+	DeviceDescriptorObjectPool testDDOP;
+	LanguageCommandInterface testLanguageInterface(nullptr, nullptr);
+
+	ASSERT_TRUE(testDDOP.add_device("AgIsoStack++ UnitTest", "1.0.0", "123", "I++1.0", testLanguageInterface.get_localization_raw_data(), std::vector<std::uint8_t>(), 0));
+	ASSERT_TRUE(testDDOP.add_device_element("Sprayer", 0, 0, task_controller_object::DeviceElementObject::Type::Device, 1));
+	ASSERT_TRUE(testDDOP.add_device_property("A", 1, 0, NULL_OBJECT_ID, 2));
+	ASSERT_TRUE(testDDOP.add_device_property("B", 2, 0, NULL_OBJECT_ID, 3));
+	ASSERT_TRUE(testDDOP.add_device_property("C", 3, 0, NULL_OBJECT_ID, 4));
+
+	// Removing an object moves the ones after it
+	EXPECT_TRUE(testDDOP.remove_object_by_id(2));
+	EXPECT_FALSE(testDDOP.remove_object_by_id(2));
+	EXPECT_EQ(nullptr, testDDOP.get_object_by_id(2));
+	ASSERT_NE(nullptr, testDDOP.get_object_by_id(3));
+	EXPECT_EQ("B", testDDOP.get_object_by_id(3)->get_designator());
+	ASSERT_NE(nullptr, testDDOP.get_object_by_id(4));
+	EXPECT_EQ("C", testDDOP.get_object_by_id(4)->get_designator());
+	EXPECT_EQ(testDDOP.get_object_by_index(3), testDDOP.get_object_by_id(4));
+
+	// Changing an ID through the object is picked up
+	testDDOP.get_object_by_id(3)->set_object_id(5);
+	EXPECT_EQ(nullptr, testDDOP.get_object_by_id(3));
+	ASSERT_NE(nullptr, testDDOP.get_object_by_id(5));
+	EXPECT_EQ("B", testDDOP.get_object_by_id(5)->get_designator());
+	EXPECT_FALSE(testDDOP.add_device_property("E", 5, 0, NULL_OBJECT_ID, 5));
+	EXPECT_TRUE(testDDOP.add_device_property("D", 4, 0, NULL_OBJECT_ID, 3));
+	EXPECT_EQ("D", testDDOP.get_object_by_id(3)->get_designator());
+
+	std::vector<std::uint8_t> binaryDDOP;
+	testDDOP.generate_binary_object_pool(binaryDDOP);
+	ASSERT_NE(nullptr, testDDOP.get_object_by_id(5));
+	EXPECT_EQ("B", testDDOP.get_object_by_id(5)->get_designator());
+
+	testDDOP.clear();
+	EXPECT_EQ(nullptr, testDDOP.get_object_by_id(4));
+	EXPECT_EQ(0, testDDOP.size());
+}
+
+TEST(DDOP_TESTS, ObjectArena)
+{
+	LanguageCommandInterface testLanguageInterface(nullptr, nullptr);
+	DeviceDescriptorObjectPool sourceDDOP;
+	std::vector<std::uint8_t> binaryDDOP;
+
+	ASSERT_TRUE(sourceDDOP.add_device("AgIsoStack++ UnitTest", "1.0.0", "123", "I++1.0", testLanguageInterface.get_localization_raw_data(), std::vector<std::uint8_t>(), 0));
+	ASSERT_TRUE(sourceDDOP.add_device_element("Sprayer", 0, 0, task_controller_object::DeviceElementObject::Type::Device, 1));
+	for (std::uint16_t i = 0; i < 200; i++)
+	{
+		// Long designators so they don't fit in the strings themselves
+		ASSERT_TRUE(sourceDDOP.add_device_property("A property designator that is long " + isobus::to_string(static_cast<int>(i)), i, static_cast<std::uint16_t>(DataDescriptionIndex::ActualWorkingWidth), NULL_OBJECT_ID, 2 + i));
+		std::static_pointer_cast<task_controller_object::DeviceElementObject>(sourceDDOP.get_object_by_id(1))->add_reference_to_child_object(2 + i);
+	}
+	ASSERT_TRUE(sourceDDOP.generate_binary_object_pool(binaryDDOP));
+
+	DeviceDescriptorObjectPool arenaDDOP;
+	EXPECT_FALSE(arenaDDOP.get_object_arena_enabled());
+	arenaDDOP.set_object_arena_enabled(true);
+	EXPECT_TRUE(arenaDDOP.get_object_arena_enabled());
+	ASSERT_TRUE(arenaDDOP.deserialize_binary_object_pool(binaryDDOP, NAME(0)));
+	EXPECT_EQ(202, arenaDDOP.size());
+
+	std::vector<std::uint8_t> reserializedDDOP;
+	ASSERT_TRUE(arenaDDOP.generate_binary_object_pool(reserializedDDOP));
+	EXPECT_EQ(binaryDDOP, reserializedDDOP);
+
+	// Objects held elsewhere stay valid after the DDOP lets go of the arena
+	auto heldObject = arenaDDOP.get_object_by_id(201);
+	ASSERT_NE(nullptr, heldObject);
+	arenaDDOP.clear();
+	EXPECT_EQ("A property designator that is long 199", heldObject->get_designator());
+	EXPECT_EQ(201, heldObject->get_object_id());
+
+	// The DDOP keeps working with a fresh arena
+	ASSERT_TRUE(arenaDDOP.deserialize_binary_object_pool(binaryDDOP, NAME(0)));
+	EXPECT_TRUE(arenaDDOP.remove_object_by_id(100));
+	EXPECT_EQ(201, arenaDDOP.size());
+	EXPECT_EQ(nullptr, arenaDDOP.get_object_by_id(100));
+	ASSERT_NE(nullptr, arenaDDOP.get_object_by_id(101));
+	EXPECT_EQ("A property designator that is long 99", arenaDDOP.get_object_by_id(101)->get_designator());
+}
@@ -4,10 +4,16 @@
 #include "isobus/hardware_integration/virtual_can_plugin.hpp"
 #include "isobus/utility/system_timing.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <future>
 #include <thread>
 
+#if defined __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 using namespace isobus;
 
 TEST(HARDWARE_INTERFACE_TESTS, SendMessageToHardware)
@@ -172,3 +178,270 @@ TEST(HARDWARE_INTERFACE_TESTS, PeriodicUpdateIntervalSetting)
 
 	CANHardwareInterface::stop();
 }
+
+/// @brief A CAN driver that refuses to transmit until it is released, and records what it transmits
+class HeldTransmitPlugin : public CANHardwarePlugin
+{
+public:
+	bool get_is_valid() const override
+	{
+		return true;
+	}
+
+	void close() override
+	{
+	}
+
+	void open() override
+	{
+	}
+
+	bool read_frame(isobus::CANMessageFrame &) override
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		return false;
+	}
+
+	bool write_frame(const isobus::CANMessageFrame &canFrame) override
+	{
+		if (holdTransmit)
+		{
+			return false;
+		}
+		LOCK_GUARD(Mutex, transmittedMutex);
+		transmittedIdentifiers.push_back(canFrame.identifier);
+		return true;
+	}
+
+	std::size_t write_frames(const isobus::CANMessageFrame *canFrames, std::size_t numberOfFrames) override
+	{
+		std::size_t numberWritten = CANHardwarePlugin::write_frames(canFrames, numberOfFrames);
+		if (numberWritten > largestWrittenBatch)
+		{
+			largestWrittenBatch = numberWritten;
+		}
+		return numberWritten;
+	}
+
+	std::vector<std::uint32_t> get_transmitted_identifiers()
+	{
+		LOCK_GUARD(Mutex, transmittedMutex);
+		return transmittedIdentifiers;
+	}
+
+	std::atomic_bool holdTransmit = { true };
+	std::atomic<std::size_t> largestWrittenBatch = { 0 };
+
+private:
+	std::vector<std::uint32_t> transmittedIdentifiers;
+	Mutex transmittedMutex;
+};
+
+TEST(HARDWARE_INTERFACE_TESTS, PriorityTransmitLanes)
+{
+	auto device = std::make_shared<HeldTransmitPlugin>();
+	CANHardwareInterface::set_number_of_can_channels(0);
+	CANHardwareInterface::set_number_of_can_channels(1, 4);
+	CANHardwareInterface::assign_can_channel_frame_handler(0, device);
+	CANHardwareInterface::start();
+
+	CANMessageFrame frame = {};
+	frame.isExtendedFrame = true;
+	frame.dataLength = 8;
+	frame.channel = 0;
+
+	// Fill the lowest priority lane from several threads at once
+	std::atomic<std::uint32_t> acceptedFrames = { 0 };
+	std::vector<std::thread> producers;
+	for (std::uint32_t i = 0; i < 3; i++)
+	{
+		producers.emplace_back([&acceptedFrames, frame, i]() mutable {
+			for (std::uint32_t j = 0; j < 2; j++)
+			{
+				frame.identifier = 0x1CEBFF00 | (i << 4) | j; // Priority 7
+				if (CANHardwareInterface::transmit_can_frame(frame))
+				{
+					acceptedFrames++;
+				}
+			}
+		});
+	}
+	for (auto &producer : producers)
+	{
+		producer.join();
+	}
+	EXPECT_EQ(4, acceptedFrames);
+
+	// A full low priority lane doesn't stop high priority frames
+	frame.identifier = 0x0CFE4900; // Priority 3
+	EXPECT_TRUE(CANHardwareInterface::transmit_can_frame(frame));
+	frame.identifier = 0x0CFE4901; // Priority 3
+	EXPECT_TRUE(CANHardwareInterface::transmit_can_frame(frame));
+
+	CANHardwareInterface::TransmitLaneStatistics lowPriorityLane = CANHardwareInterface::get_transmit_lane_statistics(0, 7);
+	EXPECT_EQ(4, lowPriorityLane.framesQueued);
+	EXPECT_EQ(2, lowPriorityLane.queueFullCount);
+	EXPECT_EQ(0, lowPriorityLane.framesDropped);
+	CANHardwareInterface::TransmitLaneStatistics highPriorityLane = CANHardwareInterface::get_transmit_lane_statistics(0, 3);
+	EXPECT_EQ(2, highPriorityLane.framesQueued);
+	EXPECT_EQ(0, highPriorityLane.queueFullCount);
+
+	// Once the hardware accepts frames, the high priority ones go first, in the order they were queued
+	device->holdTransmit = false;
+	auto future = std::async(std::launch::async, [&device] { while ((device->get_transmitted_identifiers().size() < 6) && CANHardwareInterface::is_running()); });
+	EXPECT_TRUE(future.wait_for(std::chrono::seconds(5)) != std::future_status::timeout);
+
+	std::vector<std::uint32_t> transmitted = device->get_transmitted_identifiers();
+	ASSERT_EQ(6, transmitted.size());
+	EXPECT_EQ(0x0CFE4900, transmitted[0]);
+	EXPECT_EQ(0x0CFE4901, transmitted[1]);
+	for (std::size_t i = 2; i < transmitted.size(); i++)
+	{
+		EXPECT_EQ(0x1CEBFF00, transmitted[i] & 0xFFFFFF00);
+	}
+	EXPECT_EQ(4, device->largestWrittenBatch); // Each lane is written to the driver as one batch
+
+	// Frames still queued when the interface stops are counted as dropped
+	device->holdTransmit = true;
+	frame.identifier = 0x18EAFF00; // Priority 6
+	EXPECT_TRUE(CANHardwareInterface::transmit_can_frame(frame));
+	CANHardwareInterface::stop();
+	EXPECT_EQ(1, CANHardwareInterface::get_transmit_lane_statistics(0, 6).framesDropped);
+	EXPECT_EQ(0, CANHardwareInterface::get_transmit_lane_statistics(0, 8).framesQueued);
+	EXPECT_EQ(0, CANHardwareInterface::get_transmit_lane_statistics(1, 6).framesQueued);
+
+	CANHardwareInterface::set_number_of_can_channels(0);
+}
+
+#if defined __linux__
+/// @brief A CAN driver backed by a pipe, so it can be waited on like a socket
+class PipeCANPlugin : public CANHardwarePlugin
+{
+public:
+	PipeCANPlugin()
+	{
+		if (0 != pipe(pipeDescriptors))
+		{
+			pipeDescriptors[0] = -1;
+			pipeDescriptors[1] = -1;
+		}
+		fcntl(pipeDescriptors[0], F_SETFL, O_NONBLOCK);
+	}
+
+	~PipeCANPlugin()
+	{
+		::close(pipeDescriptors[0]);
+		::close(pipeDescriptors[1]);
+	}
+
+	bool get_is_valid() const override
+	{
+		return pipeDescriptors[0] >= 0;
+	}
+
+	void close() override
+	{
+	}
+
+	void open() override
+	{
+	}
+
+	bool read_frame(isobus::CANMessageFrame &canFrame) override
+	{
+		std::uint8_t data = 0;
+		if (1 == read(pipeDescriptors[0], &data, 1))
+		{
+			canFrame = {};
+			canFrame.identifier = 0x0CFE4900 | data;
+			canFrame.isExtendedFrame = true;
+			canFrame.dataLength = 8;
+			return true;
+		}
+		return false;
+	}
+
+	bool write_frame(const isobus::CANMessageFrame &) override
+	{
+		return true;
+	}
+
+	int get_file_descriptor() const override
+	{
+		return pipeDescriptors[0];
+	}
+
+	void write_frame_as_if_received(std::uint8_t sourceAddress)
+	{
+		EXPECT_EQ(1, write(pipeDescriptors[1], &sourceAddress, 1));
+	}
+
+private:
+	int pipeDescriptors[2];
+};
+
+TEST(HARDWARE_INTERFACE_TESTS, EventDrivenMultiplexedReceive)
+{
+	auto firstDevice = std::make_shared<PipeCANPlugin>();
+	auto secondDevice = std::make_shared<PipeCANPlugin>();
+	CANHardwareInterface::set_number_of_can_channels(0);
+	CANHardwareInterface::set_number_of_can_channels(2, 4); // Small receive queues, so they can be filled up
+	CANHardwareInterface::assign_can_channel_frame_handler(0, firstDevice);
+	CANHardwareInterface::assign_can_channel_frame_handler(1, secondDevice);
+	EXPECT_TRUE(CANHardwareInterface::set_receive_multiplexing_enabled(true));
+	EXPECT_TRUE(CANHardwareInterface::get_receive_multiplexing_enabled());
+	CANHardwareInterface::set_event_driven_update_enabled(true);
+	EXPECT_TRUE(CANHardwareInterface::get_event_driven_update_enabled());
+	CANHardwareInterface::set_periodic_update_interval(2000);
+
+	std::atomic<std::uint32_t> updateCount = { 0 };
+	std::atomic<std::uint32_t> receivedOnFirstChannel = { 0 };
+	std::atomic<std::uint32_t> receivedOnSecondChannel = { 0 };
+	std::function<void()> periodicCallback = [&updateCount]() {
+		updateCount++;
+	};
+	std::function<void(const CANMessageFrame &)> receivedCallback = [&](const CANMessageFrame &frame) {
+		if (0 == frame.channel)
+		{
+			receivedOnFirstChannel++;
+		}
+		else
+		{
+			receivedOnSecondChannel++;
+		}
+	};
+	CANHardwareInterface::get_periodic_update_event_dispatcher().add_listener(periodicCallback);
+	CANHardwareInterface::get_can_frame_received_event_dispatcher().add_listener(receivedCallback);
+
+	CANHardwareInterface::start();
+	EXPECT_FALSE(CANHardwareInterface::set_receive_multiplexing_enabled(false));
+
+	std::uint32_t updatesBeforeReceive = updateCount;
+
+	// Frames on both channels are picked up by the shared receive thread, and trigger an update right away
+	firstDevice->write_frame_as_if_received(0x81);
+	firstDevice->write_frame_as_if_received(0x82);
+	secondDevice->write_frame_as_if_received(0x83);
+	std::uint32_t startTime = SystemTiming::get_timestamp_ms();
+	auto future = std::async(std::launch::async, [&] { while (((receivedOnFirstChannel < 2) || (receivedOnSecondChannel < 1) || (updateCount == updatesBeforeReceive)) && CANHardwareInterface::is_running()); });
+	EXPECT_TRUE(future.wait_for(std::chrono::seconds(5)) != std::future_status::timeout);
+	EXPECT_LT(SystemTiming::get_time_elapsed_ms(startTime), 1000);
+	EXPECT_EQ(2, receivedOnFirstChannel);
+	EXPECT_EQ(1, receivedOnSecondChannel);
+
+	// A burst larger than the receive queue is still received completely once the queue has been emptied
+	for (std::uint8_t i = 0; i < 200; i++)
+	{
+		firstDevice->write_frame_as_if_received(i);
+	}
+	future = std::async(std::launch::async, [&] { while ((receivedOnFirstChannel < 202) && CANHardwareInterface::is_running()); });
+	EXPECT_TRUE(future.wait_for(std::chrono::seconds(5)) != std::future_status::timeout);
+	EXPECT_EQ(202, receivedOnFirstChannel);
+
+	CANHardwareInterface::stop();
+	EXPECT_TRUE(CANHardwareInterface::set_receive_multiplexing_enabled(false));
+	CANHardwareInterface::set_event_driven_update_enabled(false);
+	CANHardwareInterface::set_periodic_update_interval(4);
+	CANHardwareInterface::set_number_of_can_channels(0);
+}
+#endif
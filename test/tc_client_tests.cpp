@@ -9,6 +9,8 @@
 
 #include "helpers/control_function_helpers.hpp"
 
+#include <map>
+
 using namespace isobus;
 
 class DerivedTestTCClient : public TaskControllerClient
@@ -1690,6 +1692,205 @@ TEST(TASK_CONTROLLER_CLIENT_TESTS, CallbackTests)
 	CANNetworkManager::CANNetwork.deactivate_control_function(internalECU);
 }
 
+static std::uint32_t numberOfPolledValues = 0;
+
+static bool count_polled_values_callback(std::uint16_t, std::uint16_t, std::int32_t &value, void *)
+{
+	numberOfPolledValues++;
+	value = 0;
+	return true;
+}
+
+static void send_measurement_command(std::uint8_t command, std::uint16_t element, std::uint16_t DDI, std::int32_t value)
+{
+	CANMessageFrame testFrame = {};
+	testFrame.identifier = 0x18CB86F7;
+	testFrame.isExtendedFrame = true;
+	testFrame.dataLength = 8;
+	testFrame.data[0] = static_cast<std::uint8_t>(command | ((element & 0x0F) << 4));
+	testFrame.data[1] = static_cast<std::uint8_t>(element >> 4);
+	testFrame.data[2] = static_cast<std::uint8_t>(DDI & 0xFF);
+	testFrame.data[3] = static_cast<std::uint8_t>(DDI >> 8);
+	testFrame.data[4] = static_cast<std::uint8_t>(value & 0xFF);
+	testFrame.data[5] = static_cast<std::uint8_t>((value >> 8) & 0xFF);
+	testFrame.data[6] = static_cast<std::uint8_t>((value >> 16) & 0xFF);
+	testFrame.data[7] = static_cast<std::uint8_t>((value >> 24) & 0xFF);
+	CANNetworkManager::CANNetwork.process_receive_can_message_frame(testFrame);
+	CANNetworkManager::CANNetwork.update();
+}
+
+static std::map<std::uint16_t, std::vector<std::int32_t>> read_sent_values(VirtualCANPlugin &serverTC)
+{
+	std::map<std::uint16_t, std::vector<std::int32_t>> retVal;
+	CANMessageFrame testFrame = {};
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	while (!serverTC.get_queue_empty())
+	{
+		serverTC.read_frame(testFrame);
+
+		if ((0xCBF786 == (testFrame.identifier & 0xFFFFFF)) && (0x03 == (testFrame.data[0] & 0x0F)))
+		{
+			const std::uint16_t element = static_cast<std::uint16_t>((testFrame.data[0] >> 4) | (static_cast<std::uint16_t>(testFrame.data[1]) << 4));
+			retVal[element].push_back(static_cast<std::int32_t>(static_cast<std::uint32_t>(testFrame.data[4]) |
+			                                                    (static_cast<std::uint32_t>(testFrame.data[5]) << 8) |
+			                                                    (static_cast<std::uint32_t>(testFrame.data[6]) << 16) |
+			                                                    (static_cast<std::uint32_t>(testFrame.data[7]) << 24)));
+		}
+	}
+	return retVal;
+}
+
+TEST(TASK_CONTROLLER_CLIENT_TESTS, PublishedValues)
+{
+	VirtualCANPlugin serverTC;
+	serverTC.open();
+
+	CANHardwareInterface::set_number_of_can_channels(1);
+	CANHardwareInterface::assign_can_channel_frame_handler(0, std::make_shared<VirtualCANPlugin>());
+	CANHardwareInterface::start();
+
+	auto internalECU = test_helpers::claim_internal_control_function(0x86, 0);
+	auto TestPartnerTC = test_helpers::force_claim_partnered_control_function(0xF7, 0);
+
+	DerivedTestTCClient interfaceUnderTest(TestPartnerTC, internalECU);
+	interfaceUnderTest.initialize(false);
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	// Get the virtual CAN plugin back to a known state
+	CANMessageFrame testFrame = {};
+	while (!serverTC.get_queue_empty())
+	{
+		serverTC.read_frame(testFrame);
+	}
+	ASSERT_TRUE(serverTC.get_queue_empty());
+
+	auto blankDDOP = std::make_shared<DeviceDescriptorObjectPool>();
+	interfaceUnderTest.configure(blankDDOP, 1, 32, 32, true, false, true, false, true);
+	interfaceUnderTest.add_request_value_callback(count_polled_values_callback, nullptr);
+	interfaceUnderTest.test_wrapper_set_state(TaskControllerClient::StateMachineState::Connected);
+
+	// Status message
+	testFrame.identifier = 0x18CBFFF7;
+	testFrame.isExtendedFrame = true;
+	testFrame.dataLength = 8;
+	testFrame.data[0] = 0xFE; // Status mux
+	testFrame.data[1] = 0xFF; // Element number, set to not available
+	testFrame.data[2] = 0xFF; // DDI (N/A)
+	testFrame.data[3] = 0xFF; // DDI (N/A)
+	testFrame.data[4] = 0x01; // Status (task active)
+	testFrame.data[5] = 0x00; // Command address
+	testFrame.data[6] = 0x00; // Command
+	testFrame.data[7] = 0xFF; // Reserved
+	CANNetworkManager::CANNetwork.process_receive_can_message_frame(testFrame);
+	CANNetworkManager::CANNetwork.update();
+
+	constexpr std::uint16_t NUMBER_OF_COMMANDS = 1000;
+	constexpr std::uint16_t TEST_DDI = 0x0101;
+
+	// Publish a value for every element before the TC asks for them
+	for (std::uint16_t i = 0; i < NUMBER_OF_COMMANDS; i++)
+	{
+		interfaceUnderTest.publish_process_data_value(i, TEST_DDI, 0);
+	}
+	interfaceUnderTest.update();
+
+	// 1000 on change threshold commands, with a change threshold of 10
+	for (std::uint16_t i = 0; i < NUMBER_OF_COMMANDS; i++)
+	{
+		send_measurement_command(0x08, i, TEST_DDI, 10);
+	}
+
+	for (std::uint8_t i = 0; i < 10; i++)
+	{
+		interfaceUnderTest.update();
+	}
+
+	// None of the values have changed, so nothing should have been polled or sent
+	EXPECT_EQ(0, numberOfPolledValues);
+	EXPECT_TRUE(read_sent_values(serverTC).empty());
+
+	// Only a change of at least 10 should be sent
+	interfaceUnderTest.publish_process_data_value(7, TEST_DDI, 25);
+	interfaceUnderTest.publish_process_data_value(8, TEST_DDI, 5);
+	interfaceUnderTest.update();
+	interfaceUnderTest.update();
+
+	auto sentValues = read_sent_values(serverTC);
+	ASSERT_EQ(1, sentValues.size());
+	ASSERT_EQ(1, sentValues[7].size());
+	EXPECT_EQ(25, sentValues[7].at(0));
+
+	// A maximum threshold command for a value that's already published
+	interfaceUnderTest.publish_process_data_value(NUMBER_OF_COMMANDS, TEST_DDI, 50);
+	interfaceUnderTest.update();
+	send_measurement_command(0x07, NUMBER_OF_COMMANDS, TEST_DDI, 100);
+	interfaceUnderTest.update();
+	interfaceUnderTest.publish_process_data_value(NUMBER_OF_COMMANDS, TEST_DDI, 150);
+	interfaceUnderTest.update();
+	interfaceUnderTest.publish_process_data_value(NUMBER_OF_COMMANDS, TEST_DDI, 160);
+	interfaceUnderTest.update();
+	interfaceUnderTest.publish_process_data_value(NUMBER_OF_COMMANDS, TEST_DDI, 50);
+	interfaceUnderTest.update();
+	interfaceUnderTest.publish_process_data_value(NUMBER_OF_COMMANDS, TEST_DDI, 200);
+	interfaceUnderTest.update();
+
+	sentValues = read_sent_values(serverTC);
+	ASSERT_EQ(1, sentValues.size());
+	ASSERT_EQ(2, sentValues[NUMBER_OF_COMMANDS].size());
+	EXPECT_EQ(150, sentValues[NUMBER_OF_COMMANDS].at(0));
+	EXPECT_EQ(200, sentValues[NUMBER_OF_COMMANDS].at(1));
+
+	// A triggered threshold that can't be sent is retried on the next update, even without a new value
+	CANHardwareInterface::stop();
+	interfaceUnderTest.publish_process_data_value(7, TEST_DDI, 50);
+	interfaceUnderTest.update();
+	CANHardwareInterface::assign_can_channel_frame_handler(0, std::make_shared<VirtualCANPlugin>());
+	CANHardwareInterface::start();
+	interfaceUnderTest.update();
+
+	sentValues = read_sent_values(serverTC);
+	ASSERT_EQ(1, sentValues.size());
+	ASSERT_EQ(1, sentValues[7].size());
+	EXPECT_EQ(50, sentValues[7].at(0));
+
+	// Value requests are answered with the published value
+	send_measurement_command(0x02, 8, TEST_DDI, 0);
+	interfaceUnderTest.update();
+
+	sentValues = read_sent_values(serverTC);
+	ASSERT_EQ(1, sentValues.size());
+	ASSERT_EQ(1, sentValues[8].size());
+	EXPECT_EQ(5, sentValues[8].at(0));
+
+	// A 5ms time interval command for a published value
+	interfaceUnderTest.publish_process_data_value(NUMBER_OF_COMMANDS + 1, TEST_DDI, 42);
+	send_measurement_command(0x04, NUMBER_OF_COMMANDS + 1, TEST_DDI, 5);
+
+	for (std::uint8_t i = 0; i < 30; i++)
+	{
+		interfaceUnderTest.update();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	sentValues = read_sent_values(serverTC);
+	ASSERT_EQ(1, sentValues.size());
+	EXPECT_LE(2, sentValues[NUMBER_OF_COMMANDS + 1].size());
+	for (auto sentValue : sentValues[NUMBER_OF_COMMANDS + 1])
+	{
+		EXPECT_EQ(42, sentValue);
+	}
+
+	// Every value was published, so the application never had to be polled
+	EXPECT_EQ(0, numberOfPolledValues);
+
+	CANHardwareInterface::stop();
+
+	CANNetworkManager::CANNetwork.deactivate_control_function(TestPartnerTC);
+	CANNetworkManager::CANNetwork.deactivate_control_function(internalECU);
+}
+
 TEST(TASK_CONTROLLER_CLIENT_TESTS, LanguageCommandFallback)
 {
 	VirtualCANPlugin serverTC;
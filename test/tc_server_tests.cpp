@@ -18,6 +18,9 @@
 #include "helpers/control_function_helpers.hpp"
 #include "helpers/messaging_helpers.hpp"
 
+#include <map>
+#include <mutex>
+
 using namespace isobus;
 
 // clang-format off
@@ -279,6 +282,11 @@ public:
 		return send_status_message();
 	}
 
+	std::shared_ptr<ActiveClient> test_get_active_client(std::shared_ptr<ControlFunction> clientControlFunction) const
+	{
+		return get_active_client(clientControlFunction);
+	}
+
 	std::vector<std::uint8_t> testStructureLabel;
 	std::array<std::uint8_t, 7> testLocalizationLabel = { 0 };
 	std::uint8_t identifyTC = 0xFF;
@@ -315,6 +323,11 @@ bool readFrameFilterStatus(VirtualCANPlugin &plugin, CANMessageFrame &frame)
 		EXPECT_TRUE(retVal);
 		retVal = plugin.read_frame(frame);
 	}
+	if (retVal && (0xEE == ((frame.identifier >> 16) & 0xFF)))
+	{
+		// Filter out address violations, which can be transmitted after higher priority responses
+		retVal = plugin.read_frame(frame);
+	}
 	return retVal;
 }
 
@@ -942,12 +955,6 @@ TEST(TASK_CONTROLLER_SERVER_TESTS, MessageEncoding)
 		server.update();
 		EXPECT_TRUE(readFrameFilterStatus(testPlugin, testFrame));
 
-		if (0xEE == ((testFrame.identifier >> 16) & 0xFF))
-		{
-			// Filter out address violations
-			EXPECT_TRUE(readFrameFilterStatus(testPlugin, testFrame));
-		}
-
 		EXPECT_EQ(0x91, testFrame.data[0]); // Response to activate object pool
 		EXPECT_EQ(0x00, testFrame.data[1]); // No errors
 		EXPECT_EQ(0xFF, testFrame.data[2]); // Parent object
@@ -1373,3 +1380,218 @@ TEST(TASK_CONTROLLER_SERVER_TESTS, DDOPHelper_NoFunctions)
 	EXPECT_EQ(3000, implement.booms.at(0).sections.at(0).yOffset_mm.get());
 	EXPECT_EQ(4000, implement.booms.at(0).sections.at(0).zOffset_mm.get());
 }
+
+class WorkerThreadTestClient : public ControlFunction
+{
+public:
+	WorkerThreadTestClient(NAME name, std::uint8_t address) :
+	  ControlFunction(name, address, 0)
+	{
+	}
+};
+
+class WorkerThreadTcServer : public DerivedTcServer
+{
+public:
+	explicit WorkerThreadTcServer(std::shared_ptr<InternalControlFunction> internalControlFunction) :
+	  DerivedTcServer(internalControlFunction, 4, 255, 16, TaskControllerOptions())
+	{
+	}
+
+	bool on_value_command(std::shared_ptr<ControlFunction> partner, std::uint16_t, std::uint16_t, std::int32_t value, std::uint8_t &) override
+	{
+		if (requeueValue == value)
+		{
+			// Queueing a message from a handler must not block on the message queue
+			test_receive_message(create_value_command(partner, value + 1), this);
+		}
+
+		const std::lock_guard<std::mutex> lock(valuesMutex);
+		receivedValues[partner->get_NAME().get_full_name()].push_back(value);
+		return true;
+	}
+
+	CANMessage create_value_command(std::shared_ptr<ControlFunction> client, std::int32_t value) const
+	{
+		std::vector<std::uint8_t> data = {
+			static_cast<std::uint8_t>(ProcessDataCommands::Value),
+			0x00,
+			0x86,
+			0x00,
+			static_cast<std::uint8_t>(value),
+			static_cast<std::uint8_t>(value >> 8),
+			static_cast<std::uint8_t>(value >> 16),
+			static_cast<std::uint8_t>(value >> 24)
+		};
+		return CANMessage(CANMessage::Type::Receive, CANIdentifier(test_helpers::create_ext_can_id(5, 0xCB00, serverControlFunction, client)), data, client, serverControlFunction, 0);
+	}
+
+	std::vector<std::int32_t> get_received_values(std::shared_ptr<ControlFunction> client)
+	{
+		const std::lock_guard<std::mutex> lock(valuesMutex);
+		return receivedValues[client->get_NAME().get_full_name()];
+	}
+
+	std::int32_t requeueValue = -1;
+
+private:
+	std::mutex valuesMutex;
+	std::map<std::uint64_t, std::vector<std::int32_t>> receivedValues;
+};
+
+TEST(TASK_CONTROLLER_SERVER_TESTS, WorkerThreads)
+{
+	auto internalECU = test_helpers::create_mock_internal_control_function(0x87);
+	WorkerThreadTcServer server(internalECU);
+	std::vector<std::shared_ptr<ControlFunction>> clients;
+
+	for (std::uint8_t i = 0; i < 6; i++)
+	{
+		NAME clientNAME(0);
+		clientNAME.set_identity_number(i + 1);
+		clients.push_back(std::make_shared<WorkerThreadTestClient>(clientNAME, 0x90 + i));
+	}
+
+	EXPECT_EQ(0, server.get_number_of_worker_threads());
+	EXPECT_TRUE(server.set_number_of_worker_threads(3));
+	EXPECT_EQ(3, server.get_number_of_worker_threads());
+
+	// Connect and activate every client, then interleave their value commands
+	for (const auto &client : clients)
+	{
+		std::vector<std::uint8_t> workingSetMaster = { 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+		std::vector<std::uint8_t> activate = { 0x81, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+		server.test_receive_message(CANMessage(CANMessage::Type::Receive, CANIdentifier(test_helpers::create_ext_can_id_broadcast(6, 0xFE0D, client)), workingSetMaster, client, nullptr, 0), &server);
+		server.test_receive_message(CANMessage(CANMessage::Type::Receive, CANIdentifier(test_helpers::create_ext_can_id(5, 0xCB00, internalECU, client)), activate, client, internalECU, 0), &server);
+	}
+	for (std::int32_t value = 0; value < 100; value++)
+	{
+		for (const auto &client : clients)
+		{
+			server.test_receive_message(server.create_value_command(client, value), &server);
+		}
+	}
+	server.update();
+
+	// Each client's messages are processed in the order they were received
+	for (const auto &client : clients)
+	{
+		auto values = server.get_received_values(client);
+		ASSERT_EQ(100, values.size());
+		for (std::int32_t value = 0; value < 100; value++)
+		{
+			EXPECT_EQ(value, values.at(value));
+		}
+	}
+
+	// A message queued while messages are processed waits for the next update
+	server.requeueValue = 1000;
+	server.test_receive_message(server.create_value_command(clients.front(), 1000), &server);
+	server.update();
+	EXPECT_EQ(1000, server.get_received_values(clients.front()).back());
+	server.update();
+	EXPECT_EQ(1001, server.get_received_values(clients.front()).back());
+
+	// Process everything on the updating thread again
+	EXPECT_TRUE(server.set_number_of_worker_threads(0));
+	EXPECT_EQ(0, server.get_number_of_worker_threads());
+	server.test_receive_message(server.create_value_command(clients.back(), 1000), &server);
+	server.update();
+	EXPECT_EQ(1000, server.get_received_values(clients.back()).back());
+	server.update();
+	EXPECT_EQ(1001, server.get_received_values(clients.back()).back());
+	EXPECT_EQ(102, server.get_received_values(clients.back()).size());
+}
+
+TEST(TASK_CONTROLLER_SERVER_TESTS, ManyClients)
+{
+	auto internalECU = test_helpers::create_mock_internal_control_function(0x87);
+	WorkerThreadTcServer server(internalECU);
+	std::vector<std::shared_ptr<ControlFunction>> clients;
+
+	for (std::uint8_t i = 0; i < 40; i++)
+	{
+		NAME clientNAME(0);
+		clientNAME.set_identity_number(i + 1);
+		clients.push_back(std::make_shared<WorkerThreadTestClient>(clientNAME, 0x90 + i));
+
+		std::vector<std::uint8_t> workingSetMaster = { 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+		server.test_receive_message(CANMessage(CANMessage::Type::Receive, CANIdentifier(test_helpers::create_ext_can_id_broadcast(6, 0xFE0D, clients.back())), workingSetMaster, clients.back(), nullptr, 0), &server);
+	}
+	server.update();
+
+	for (const auto &client : clients)
+	{
+		auto activeClient = server.test_get_active_client(client);
+		ASSERT_NE(nullptr, activeClient);
+		EXPECT_EQ(client, activeClient->clientControlFunction);
+	}
+
+	// Clients are found by NAME and CAN port, not by the control function object
+	NAME unknownNAME(0);
+	unknownNAME.set_identity_number(1000);
+	EXPECT_EQ(nullptr, server.test_get_active_client(std::make_shared<WorkerThreadTestClient>(unknownNAME, 0x80)));
+	EXPECT_EQ(server.test_get_active_client(clients.at(5)), server.test_get_active_client(std::make_shared<WorkerThreadTestClient>(clients.at(5)->get_NAME(), 0x81)));
+	EXPECT_EQ(nullptr, server.test_get_active_client(nullptr));
+
+	// A client task message only updates the client that sent it
+	std::vector<std::uint8_t> clientTask = { 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0x00, 0x00, 0x00 };
+	server.test_receive_message(CANMessage(CANMessage::Type::Receive, CANIdentifier(test_helpers::create_ext_can_id(5, 0xCB00, internalECU, clients.at(7))), clientTask, clients.at(7), internalECU, 0), &server);
+	server.update();
+	for (std::size_t i = 0; i < clients.size(); i++)
+	{
+		EXPECT_EQ((7 == i) ? 1u : 0u, server.test_get_active_client(clients.at(i))->statusBitfield);
+	}
+}
+
+TEST(TASK_CONTROLLER_SERVER_TESTS, SendProcessDataCommands)
+{
+	VirtualCANPlugin testPlugin;
+	testPlugin.open();
+
+	CANHardwareInterface::set_number_of_can_channels(1);
+	CANHardwareInterface::assign_can_channel_frame_handler(0, std::make_shared<VirtualCANPlugin>());
+	CANHardwareInterface::start();
+
+	auto internalECU = test_helpers::claim_internal_control_function(0x8C, 0);
+	auto partnerClient = test_helpers::force_claim_partnered_control_function(0x8D, 0);
+
+	DerivedTcServer server(internalECU, 4, 255, 16, TaskControllerOptions());
+	testPlugin.clear_queue();
+
+	using Command = TaskControllerServer::ProcessDataCommands;
+	std::vector<TaskControllerServer::ClientProcessDataCommand> commands = {
+		{ partnerClient, Command::Value, 1, 1, 10 },
+		{ partnerClient, Command::Value, 1, 2, 20 },
+		{ partnerClient, Command::Value, 1, 1, 11 }, // Replaces the first command
+		{ partnerClient, Command::RequestValue, 2, 1, 0 },
+		{ partnerClient, Command::MeasurementTimeInterval, 1, 1, 1000 }, // Different command, so it's not coalesced
+		{ nullptr, Command::Value, 1, 1, 10 } // Can't be sent
+	};
+	EXPECT_EQ(4, server.send_process_data_commands(commands));
+	CANNetworkManager::CANNetwork.update();
+
+	CANMessageFrame testFrame = {};
+	const std::array<std::array<std::uint8_t, 8>, 4> expectedPayloads = { {
+	  { 0x23, 0x00, 0x01, 0x00, 20, 0x00, 0x00, 0x00 },
+	  { 0x13, 0x00, 0x01, 0x00, 11, 0x00, 0x00, 0x00 },
+	  { 0x12, 0x00, 0x02, 0x00, 0xFF, 0xFF, 0xFF, 0xFF },
+	  { 0x14, 0x00, 0x01, 0x00, 0xE8, 0x03, 0x00, 0x00 } } };
+	for (const auto &expectedPayload : expectedPayloads)
+	{
+		ASSERT_TRUE(readFrameFilterStatus(testPlugin, testFrame));
+		EXPECT_EQ(0x14CB8D8C, testFrame.identifier);
+		EXPECT_EQ(8, testFrame.dataLength);
+		for (std::size_t i = 0; i < expectedPayload.size(); i++)
+		{
+			EXPECT_EQ(expectedPayload[i], testFrame.data[i]);
+		}
+	}
+	EXPECT_FALSE(testPlugin.read_frame(testFrame));
+	EXPECT_EQ(0, server.send_process_data_commands({}));
+
+	CANNetworkManager::CANNetwork.deactivate_control_function(partnerClient);
+	CANNetworkManager::CANNetwork.deactivate_control_function(internalECU);
+	CANHardwareInterface::stop();
+	testPlugin.close();
+}
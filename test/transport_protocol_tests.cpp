@@ -2123,3 +2123,279 @@ TEST(TRANSPORT_PROTOCOL_TESTS, DestinationSpecificOverwriteSession)
 	// After the transmission is finished, the sessions should be removed as indication that connection is closed
 	ASSERT_FALSE(manager.has_session(originator, receiver));
 }
+
+// Stress test with hundreds of destination specific sessions in flight at the same time,
+// like a task controller server that receives object pools from many clients at once
+TEST(TRANSPORT_PROTOCOL_TESTS, DestinationSpecificManyConcurrentSessions)
+{
+	constexpr std::uint32_t pgnToReceive = 0xCB00;
+	constexpr std::size_t NUMBER_OF_ORIGINATORS = 20;
+	constexpr std::size_t NUMBER_OF_RECEIVERS = 16;
+	constexpr std::size_t NUMBER_OF_SESSIONS = NUMBER_OF_ORIGINATORS * NUMBER_OF_RECEIVERS;
+
+	std::vector<std::shared_ptr<InternalControlFunction>> originators;
+	std::vector<std::shared_ptr<InternalControlFunction>> receivers;
+	for (std::size_t i = 0; i < NUMBER_OF_ORIGINATORS; i++)
+	{
+		originators.push_back(test_helpers::create_mock_internal_control_function(static_cast<std::uint8_t>(0x10 + i)));
+	}
+	for (std::size_t i = 0; i < NUMBER_OF_RECEIVERS; i++)
+	{
+		receivers.push_back(test_helpers::create_mock_internal_control_function(static_cast<std::uint8_t>(0x80 + i)));
+	}
+
+	std::deque<CANMessage> originatingQueue;
+	std::deque<CANMessage> receivingQueue;
+	std::vector<bool> completedSessions(NUMBER_OF_SESSIONS, false);
+	std::size_t numberOfCompletedSessions = 0;
+
+	auto receiveMessageCallback = [&](const CANMessage &message) {
+		EXPECT_EQ(message.get_identifier().get_parameter_group_number(), pgnToReceive);
+		ASSERT_EQ(message.get_data_length(), 17);
+
+		// The first two bytes identify the session, the rest is a pattern derived from them
+		std::size_t originatorIndex = message.get_uint8_at(0);
+		std::size_t receiverIndex = message.get_uint8_at(1);
+		ASSERT_LT(originatorIndex, NUMBER_OF_ORIGINATORS);
+		ASSERT_LT(receiverIndex, NUMBER_OF_RECEIVERS);
+		EXPECT_EQ(message.get_source_control_function(), originators[originatorIndex]);
+		EXPECT_EQ(message.get_destination_control_function(), receivers[receiverIndex]);
+		for (std::size_t i = 2; i < message.get_data_length(); i++)
+		{
+			EXPECT_EQ(message.get_uint8_at(i), static_cast<std::uint8_t>(originatorIndex + receiverIndex + i));
+		}
+
+		std::size_t sessionIndex = originatorIndex * NUMBER_OF_RECEIVERS + receiverIndex;
+		EXPECT_FALSE(completedSessions[sessionIndex]);
+		completedSessions[sessionIndex] = true;
+		numberOfCompletedSessions++;
+	};
+
+	auto sendFrameCallback = [&](std::uint32_t parameterGroupNumber,
+	                             CANDataSpan data,
+	                             std::shared_ptr<InternalControlFunction> sourceControlFunction,
+	                             std::shared_ptr<ControlFunction> destinationControlFunction,
+	                             CANIdentifier::CANPriority priority) {
+		CANMessage message = test_helpers::create_message(static_cast<std::uint8_t>(priority),
+		                                                  parameterGroupNumber,
+		                                                  destinationControlFunction,
+		                                                  sourceControlFunction,
+		                                                  data.begin(),
+		                                                  data.size());
+
+		if (originators.end() != std::find(originators.begin(), originators.end(), sourceControlFunction))
+		{
+			originatingQueue.push_back(message);
+		}
+		else
+		{
+			receivingQueue.push_back(message);
+		}
+		return true;
+	};
+
+	CANNetworkConfiguration configuration;
+	configuration.set_max_number_transport_protocol_sessions(NUMBER_OF_SESSIONS);
+	TransportProtocolManager txManager(sendFrameCallback, nullptr, &configuration);
+	TransportProtocolManager rxManager(sendFrameCallback, receiveMessageCallback, &configuration);
+
+	for (std::size_t originatorIndex = 0; originatorIndex < NUMBER_OF_ORIGINATORS; originatorIndex++)
+	{
+		for (std::size_t receiverIndex = 0; receiverIndex < NUMBER_OF_RECEIVERS; receiverIndex++)
+		{
+			std::vector<std::uint8_t> dataToSend(17);
+			dataToSend[0] = static_cast<std::uint8_t>(originatorIndex);
+			dataToSend[1] = static_cast<std::uint8_t>(receiverIndex);
+			for (std::size_t i = 2; i < dataToSend.size(); i++)
+			{
+				dataToSend[i] = static_cast<std::uint8_t>(originatorIndex + receiverIndex + i);
+			}
+			auto data = std::unique_ptr<CANMessageData>(new CANMessageDataVector(dataToSend));
+			ASSERT_TRUE(txManager.protocol_transmit_message(pgnToReceive, data, originators[originatorIndex], receivers[receiverIndex], nullptr, nullptr));
+		}
+	}
+	EXPECT_EQ(txManager.get_sessions().size(), NUMBER_OF_SESSIONS);
+
+	// A new session between a pair that already has one must be rejected
+	auto duplicateData = std::unique_ptr<CANMessageData>(new CANMessageDataVector(std::vector<std::uint8_t>(17, 0xAA)));
+	EXPECT_FALSE(txManager.protocol_transmit_message(pgnToReceive, duplicateData, originators[3], receivers[7], nullptr, nullptr));
+
+	for (std::size_t originatorIndex = 0; originatorIndex < NUMBER_OF_ORIGINATORS; originatorIndex++)
+	{
+		for (std::size_t receiverIndex = 0; receiverIndex < NUMBER_OF_RECEIVERS; receiverIndex++)
+		{
+			ASSERT_TRUE(txManager.has_session(originators[originatorIndex], receivers[receiverIndex]));
+			ASSERT_FALSE(txManager.has_session(receivers[receiverIndex], originators[originatorIndex]));
+		}
+	}
+
+	std::uint32_t time = SystemTiming::get_timestamp_ms();
+	while ((numberOfCompletedSessions < NUMBER_OF_SESSIONS) && (SystemTiming::get_time_elapsed_ms(time) < 5000))
+	{
+		while (!originatingQueue.empty())
+		{
+			rxManager.process_message(originatingQueue.front());
+			originatingQueue.pop_front();
+		}
+		while (!receivingQueue.empty())
+		{
+			txManager.process_message(receivingQueue.front());
+			receivingQueue.pop_front();
+		}
+		txManager.update();
+		rxManager.update();
+	}
+
+	EXPECT_EQ(numberOfCompletedSessions, NUMBER_OF_SESSIONS);
+
+	// Let the final acknowledgements reach the transmitting side
+	while (!receivingQueue.empty())
+	{
+		txManager.process_message(receivingQueue.front());
+		receivingQueue.pop_front();
+	}
+	EXPECT_TRUE(txManager.get_sessions().empty());
+	EXPECT_TRUE(rxManager.get_sessions().empty());
+	for (std::size_t originatorIndex = 0; originatorIndex < NUMBER_OF_ORIGINATORS; originatorIndex++)
+	{
+		for (std::size_t receiverIndex = 0; receiverIndex < NUMBER_OF_RECEIVERS; receiverIndex++)
+		{
+			EXPECT_FALSE(txManager.has_session(originators[originatorIndex], receivers[receiverIndex]));
+			EXPECT_FALSE(rxManager.has_session(originators[originatorIndex], receivers[receiverIndex]));
+		}
+	}
+}
+
+// Test case for reusing receive buffers between sessions
+TEST(TRANSPORT_PROTOCOL_TESTS, ReceiveBufferReuse)
+{
+	constexpr std::uint8_t NUMBER_OF_TRANSFERS = 5;
+
+	auto originator = test_helpers::create_mock_control_function(0x01);
+
+	std::uint8_t messageCount = 0;
+	std::vector<const std::uint8_t *> receivedBuffers;
+	auto receiveMessageCallback = [&](const CANMessage &message) {
+		ASSERT_EQ(message.get_data_length(), 17);
+		for (std::uint8_t i = 0; i < 17; i++)
+		{
+			EXPECT_EQ(message.get_uint8_at(i), static_cast<std::uint8_t>(messageCount + i));
+		}
+		receivedBuffers.push_back(message.get_data().data());
+		messageCount++;
+	};
+
+	CANNetworkConfiguration defaultConfiguration;
+	auto bufferPool = std::make_shared<TransportProtocolBufferPool>();
+	TransportProtocolManager manager(nullptr, receiveMessageCallback, &defaultConfiguration, bufferPool);
+	EXPECT_EQ(manager.get_buffer_pool(), bufferPool);
+
+	for (std::uint8_t transfer = 0; transfer < NUMBER_OF_TRANSFERS; transfer++)
+	{
+		manager.process_message(test_helpers::create_message_broadcast(
+		  7,
+		  0xEC00, // Transport Protocol Connection Management
+		  originator,
+		  {
+		    32, // BAM Mux
+		    17, // Data Length
+		    0, // Data Length MSB
+		    3, // Packet count
+		    0xFF, // Reserved
+		    0xEC, // PGN LSB
+		    0xFE, // PGN middle byte
+		    0x00, // PGN MSB
+		  }));
+
+		for (std::uint8_t packet = 0; packet < 3; packet++)
+		{
+			std::array<std::uint8_t, 8> frame;
+			frame[0] = packet + 1; // Sequence number
+			for (std::uint8_t i = 0; i < 7; i++)
+			{
+				frame[1 + i] = static_cast<std::uint8_t>(transfer + (7 * packet) + i);
+			}
+			manager.process_message(test_helpers::create_message_broadcast(7, 0xEB00, originator, frame.data(), frame.size()));
+		}
+	}
+	ASSERT_EQ(messageCount, NUMBER_OF_TRANSFERS);
+
+	// Every message should have been delivered in the same buffer, which only had to be allocated once
+	EXPECT_TRUE(std::all_of(receivedBuffers.begin(), receivedBuffers.end(), [&](const std::uint8_t *buffer) { return buffer == receivedBuffers.front(); }));
+	auto statistics = bufferPool->get_statistics();
+	EXPECT_EQ(statistics.misses, 1);
+	EXPECT_EQ(statistics.hits, NUMBER_OF_TRANSFERS - 1);
+	EXPECT_EQ(statistics.bytesInUse, 0);
+	EXPECT_EQ(statistics.highWaterBytes, 32); // 17 bytes are rounded up to the 32 byte size class
+	EXPECT_EQ(statistics.retainedBytes, 32);
+
+	// An aborted session gives its buffer back as well
+	manager.process_message(test_helpers::create_message_broadcast(
+	  7,
+	  0xEC00, // Transport Protocol Connection Management
+	  originator,
+	  {
+	    32, // BAM Mux
+	    17, // Data Length
+	    0, // Data Length MSB
+	    4, // Bad packet count
+	    0xFF, // Reserved
+	    0xEC, // PGN LSB
+	    0xFE, // PGN middle byte
+	    0x00, // PGN MSB
+	  }));
+	EXPECT_FALSE(manager.has_session(originator, nullptr));
+	statistics = bufferPool->get_statistics();
+	EXPECT_EQ(statistics.hits, NUMBER_OF_TRANSFERS);
+	EXPECT_EQ(statistics.bytesInUse, 0);
+	EXPECT_EQ(statistics.retainedBytes, 32);
+}
+
+TEST(TRANSPORT_PROTOCOL_TESTS, BufferPoolSizeClasses)
+{
+	TransportProtocolBufferPool pool;
+
+	auto buffer = pool.acquire(100);
+	EXPECT_EQ(buffer.size(), 100);
+	EXPECT_TRUE(std::all_of(buffer.begin(), buffer.end(), [](std::uint8_t value) { return 0 == value; }));
+	EXPECT_GE(buffer.capacity(), 128);
+	std::fill(buffer.begin(), buffer.end(), 0xAA);
+	pool.release(std::move(buffer));
+
+	// A smaller request of the same size class reuses the buffer, and it's cleared again
+	buffer = pool.acquire(65);
+	EXPECT_EQ(buffer.size(), 65);
+	EXPECT_TRUE(std::all_of(buffer.begin(), buffer.end(), [](std::uint8_t value) { return 0 == value; }));
+	auto statistics = pool.get_statistics();
+	EXPECT_EQ(statistics.hits, 1);
+	EXPECT_EQ(statistics.misses, 1);
+
+	// A different size class needs its own buffer
+	auto otherBuffer = pool.acquire(200);
+	statistics = pool.get_statistics();
+	EXPECT_EQ(statistics.misses, 2);
+	EXPECT_GE(statistics.highWaterBytes, 128 + 256);
+	pool.release(std::move(buffer));
+	pool.release(std::move(otherBuffer));
+	EXPECT_EQ(pool.get_statistics().bytesInUse, 0);
+	EXPECT_EQ(pool.get_statistics().retainedBytes, 128 + 256);
+
+	// Buffers that are too large for the pool are never kept
+	auto largeBuffer = pool.acquire(TransportProtocolBufferPool::MAXIMUM_POOLED_BUFFER_SIZE * 3);
+	EXPECT_EQ(largeBuffer.size(), TransportProtocolBufferPool::MAXIMUM_POOLED_BUFFER_SIZE * 3);
+	pool.release(std::move(largeBuffer));
+	EXPECT_EQ(pool.get_statistics().retainedBytes, 128 + 256);
+
+	// Lowering the retention limit frees the largest buffers first
+	pool.set_maximum_retained_bytes(200);
+	EXPECT_EQ(pool.get_maximum_retained_bytes(), 200);
+	EXPECT_EQ(pool.get_statistics().retainedBytes, 128);
+	pool.clear();
+	EXPECT_EQ(pool.get_statistics().retainedBytes, 0);
+
+	// Small payloads are copied into the message, so a different buffer comes back, but it's still counted the same
+	CANMessagePayload smallPayload(pool.acquire(6));
+	EXPECT_TRUE(smallPayload.is_inline());
+	pool.release(smallPayload.release());
+	EXPECT_EQ(pool.get_statistics().bytesInUse, 0);
+}
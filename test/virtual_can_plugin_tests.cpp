@@ -70,3 +70,30 @@ TEST(VIRTUAL_CAN_PLUGIN_TESTS, OtherReceivesMessage)
 	EXPECT_EQ(receiveFrame.data[7], 0x08);
 	EXPECT_EQ(receiveFrame.dataLength, 8);
 }
+
+TEST(VIRTUAL_CAN_PLUGIN_TESTS, BatchedFrameFallbacks)
+{
+	VirtualCANPlugin testPlugin;
+	VirtualCANPlugin otherPlugin;
+
+	CANMessageFrame sentFrames[3] = {};
+	for (std::uint8_t i = 0; i < 3; i++)
+	{
+		sentFrames[i].identifier = 0x18FFA200 | i;
+		sentFrames[i].isExtendedFrame = true;
+		sentFrames[i].dataLength = 1;
+		sentFrames[i].data[0] = i;
+	}
+	EXPECT_EQ(3, testPlugin.write_frames(sentFrames, 3));
+	EXPECT_EQ(0, testPlugin.write_frames(nullptr, 3));
+
+	// The default implementation reads one frame at a time
+	CANMessageFrame receiveFrames[8] = {};
+	for (std::uint8_t i = 0; i < 3; i++)
+	{
+		EXPECT_EQ(1, otherPlugin.read_frames(receiveFrames, 8));
+		EXPECT_EQ(0x18FFA200 | i, receiveFrames[0].identifier);
+		EXPECT_EQ(i, receiveFrames[0].data[0]);
+	}
+	EXPECT_EQ(0, otherPlugin.read_frames(receiveFrames, 0));
+}
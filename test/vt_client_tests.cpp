@@ -6,10 +6,14 @@
 #include "isobus/isobus/can_general_parameter_group_numbers.hpp"
 #include "isobus/isobus/can_network_manager.hpp"
 #include "isobus/isobus/isobus_virtual_terminal_client.hpp"
+#include "isobus/isobus/isobus_virtual_terminal_client_update_helper.hpp"
 #include "isobus/utility/system_timing.hpp"
 
 #include "helpers/control_function_helpers.hpp"
 
+#include <cstdio>
+#include <fstream>
+
 using namespace isobus;
 
 class DerivedTestVTClient : public VirtualTerminalClient
@@ -69,6 +73,44 @@ public:
 		largeFontSizesBitfield = largeFontsBitfield;
 	}
 
+	void test_wrapper_set_screen_size(std::uint16_t dataMaskSize, std::uint8_t softKeyWidth)
+	{
+		xPixels = dataMaskSize;
+		yPixels = dataMaskSize;
+		softKeyXAxisPixels = softKeyWidth;
+	}
+
+	bool test_wrapper_get_streamed_scaled_object_pool_bytes(std::uint32_t poolIndex, std::uint32_t offset, std::uint32_t length, std::uint8_t *destination)
+	{
+		return get_streamed_scaled_object_pool_bytes(poolIndex, offset, length, destination);
+	}
+
+	bool test_wrapper_prepare_scaled_object_pools()
+	{
+		return prepare_scaled_object_pools();
+	}
+
+	std::string test_wrapper_get_object_pool_version_label()
+	{
+		return get_object_pool_version_label();
+	}
+
+	std::string test_wrapper_get_scaled_object_pool_cache_path(std::uint32_t poolIndex)
+	{
+		return get_scaled_object_pool_cache_path(poolIndex);
+	}
+
+	bool test_wrapper_get_scaled_object_pool_empty(std::uint32_t poolIndex) const
+	{
+		return objectPools[poolIndex].scaledObjectPool.empty();
+	}
+
+	std::vector<std::uint8_t> test_wrapper_get_scaled_object_pool(std::uint32_t poolIndex) const
+	{
+		const auto &objectPool = objectPools[poolIndex];
+		return std::vector<std::uint8_t>(objectPool.scaledObjectPool.begin(), objectPool.scaledObjectPool.begin() + objectPool.objectPoolSize);
+	}
+
 	void test_wrapper_set_state(VirtualTerminalClient::StateMachineState value)
 	{
 		VirtualTerminalClient::set_state(value);
@@ -90,6 +132,16 @@ public:
 	{
 		VirtualTerminalClient::process_command_queue();
 	}
+
+	const VirtualTerminalClientCommandQueue &test_wrapper_get_command_queue() const
+	{
+		return commandQueue;
+	}
+
+	void test_wrapper_clear_command_queue()
+	{
+		commandQueue.clear();
+	}
 };
 
 std::vector<std::uint8_t> DerivedTestVTClient::staticTestPool;
@@ -975,3 +1027,660 @@ TEST(VIRTUAL_TERMINAL_TESTS, MessageConstruction)
 	CANNetworkManager::CANNetwork.deactivate_control_function(vtPartner);
 	CANNetworkManager::CANNetwork.deactivate_control_function(internalECU);
 }
+
+TEST(VIRTUAL_TERMINAL_TESTS, CommandQueueCoalescing)
+{
+	VirtualTerminalClientCommandQueue queue(4);
+	EXPECT_TRUE(queue.empty());
+	EXPECT_EQ(4, queue.capacity());
+
+	auto numericValue = [](std::uint16_t objectID, std::uint32_t value) {
+		return std::vector<std::uint8_t>{ 0xA8, static_cast<std::uint8_t>(objectID & 0xFF), static_cast<std::uint8_t>(objectID >> 8), 0xFF, static_cast<std::uint8_t>(value & 0xFF), static_cast<std::uint8_t>((value >> 8) & 0xFF), static_cast<std::uint8_t>((value >> 16) & 0xFF), static_cast<std::uint8_t>(value >> 24) };
+	};
+	auto changeAttribute = [](std::uint16_t objectID, std::uint8_t attributeID, std::uint8_t value) {
+		return std::vector<std::uint8_t>{ 0xAF, static_cast<std::uint8_t>(objectID & 0xFF), static_cast<std::uint8_t>(objectID >> 8), attributeID, value, 0, 0, 0 };
+	};
+
+	// Newer values for the same object take the place of the queued one
+	for (std::uint32_t i = 0; i < 50; i++)
+	{
+		queue.push(numericValue(1000, i), true);
+	}
+	ASSERT_EQ(1, queue.size());
+	EXPECT_EQ(numericValue(1000, 49), queue.at(0));
+	EXPECT_EQ(49, queue.get_number_of_coalesced_commands());
+
+	// Different objects and different attributes are kept apart
+	EXPECT_FALSE(queue.push(numericValue(1001, 5), true));
+	EXPECT_FALSE(queue.push(changeAttribute(1000, 1, 5), true));
+	EXPECT_FALSE(queue.push(changeAttribute(1000, 2, 5), true));
+	EXPECT_TRUE(queue.push(changeAttribute(1000, 1, 6), true));
+	ASSERT_EQ(4, queue.size());
+	EXPECT_EQ(changeAttribute(1000, 2, 5), queue.at(2));
+	EXPECT_EQ(changeAttribute(1000, 1, 6), queue.at(3));
+
+	// Relative moves can't be coalesced, and neither can anything when coalescing is off
+	const std::vector<std::uint8_t> changeChildLocation = { 0xA5, 0x01, 0x00, 0x02, 0x00, 130, 130, 0xFF };
+	EXPECT_FALSE(queue.push(changeChildLocation, true));
+	EXPECT_FALSE(queue.push(changeChildLocation, true));
+	EXPECT_FALSE(queue.push(numericValue(1000, 50), false));
+	ASSERT_EQ(7, queue.size());
+	EXPECT_EQ(8, queue.capacity());
+
+	// Sent commands leave from the front, and the order of the rest is kept while the ring wraps around
+	queue.remove(0);
+	queue.remove(0);
+	EXPECT_EQ(changeAttribute(1000, 2, 5), queue.at(0));
+	EXPECT_EQ(changeAttribute(1000, 1, 6), queue.at(1));
+	for (std::uint16_t i = 0; i < 3; i++)
+	{
+		queue.push(numericValue(2000 + i, i), true);
+	}
+	ASSERT_EQ(8, queue.size());
+	EXPECT_EQ(8, queue.capacity());
+	EXPECT_EQ(numericValue(1000, 50), queue.at(4));
+	EXPECT_EQ(numericValue(2002, 2), queue.at(7));
+
+	// Removing from the middle keeps the order too
+	queue.remove(4);
+	EXPECT_EQ(numericValue(2000, 0), queue.at(4));
+	EXPECT_EQ(7, queue.size());
+
+	// The function code based replacement removes the extra copies
+	EXPECT_TRUE(queue.replace_function(changeChildLocation));
+	EXPECT_EQ(6, queue.size());
+	EXPECT_FALSE(queue.replace_function({ 0xA0, 0x01, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF }));
+
+	queue.clear();
+	EXPECT_TRUE(queue.empty());
+	EXPECT_EQ(8, queue.capacity());
+
+	// A coalesced command stays behind the commands queued in between, like a relative move of the same child
+	const std::vector<std::uint8_t> firstChildPosition = { 0xB4, 0x01, 0x00, 0x02, 0x00, 10, 0, 10, 0 };
+	const std::vector<std::uint8_t> secondChildPosition = { 0xB4, 0x01, 0x00, 0x02, 0x00, 20, 0, 20, 0 };
+	EXPECT_FALSE(queue.push(firstChildPosition, true));
+	EXPECT_FALSE(queue.push(changeChildLocation, true));
+	EXPECT_TRUE(queue.push(secondChildPosition, true));
+	ASSERT_EQ(2, queue.size());
+	EXPECT_EQ(changeChildLocation, queue.at(0));
+	EXPECT_EQ(secondChildPosition, queue.at(1));
+	queue.clear();
+
+	// The client coalesces commands it can't send yet
+	VirtualCANPlugin serverVT;
+	serverVT.open();
+
+	CANHardwareInterface::set_number_of_can_channels(1);
+	CANHardwareInterface::assign_can_channel_frame_handler(0, std::make_shared<VirtualCANPlugin>());
+	CANHardwareInterface::start();
+
+	auto internalECU = test_helpers::claim_internal_control_function(0x37, 0);
+	auto vtPartner = test_helpers::force_claim_partnered_control_function(0x26, 0);
+	DerivedTestVTClient interfaceUnderTest(vtPartner, internalECU);
+	EXPECT_TRUE(interfaceUnderTest.get_command_coalescing());
+
+	for (std::uint32_t i = 0; i < 50; i++)
+	{
+		EXPECT_TRUE(interfaceUnderTest.send_change_numeric_value(1234, i));
+	}
+	ASSERT_EQ(1, interfaceUnderTest.test_wrapper_get_command_queue().size());
+	EXPECT_EQ(numericValue(1234, 49), interfaceUnderTest.test_wrapper_get_command_queue().at(0));
+
+	interfaceUnderTest.set_command_coalescing(false);
+	EXPECT_FALSE(interfaceUnderTest.get_command_coalescing());
+	EXPECT_TRUE(interfaceUnderTest.send_change_numeric_value(1234, 50));
+	EXPECT_EQ(2, interfaceUnderTest.test_wrapper_get_command_queue().size());
+
+	CANNetworkManager::CANNetwork.deactivate_control_function(vtPartner);
+	CANNetworkManager::CANNetwork.deactivate_control_function(internalECU);
+	serverVT.close();
+	CANHardwareInterface::stop();
+}
+
+TEST(VIRTUAL_TERMINAL_TESTS, PipelinedCommands)
+{
+	VirtualCANPlugin serverVT;
+	serverVT.open();
+
+	CANHardwareInterface::set_number_of_can_channels(1);
+	CANHardwareInterface::assign_can_channel_frame_handler(0, std::make_shared<VirtualCANPlugin>());
+	CANHardwareInterface::start();
+
+	auto internalECU = test_helpers::claim_internal_control_function(0x37, 0);
+	auto vtPartner = test_helpers::force_claim_partnered_control_function(0x26, 0);
+
+	DerivedTestVTClient interfaceUnderTest(vtPartner, internalECU);
+	interfaceUnderTest.initialize(false);
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	CANMessageFrame testFrame = {};
+	while (!serverVT.get_queue_empty())
+	{
+		serverVT.read_frame(testFrame);
+	}
+	interfaceUnderTest.test_wrapper_set_state(VirtualTerminalClient::StateMachineState::Connected);
+
+	EXPECT_EQ(1, interfaceUnderTest.get_maximum_commands_in_flight());
+	interfaceUnderTest.set_maximum_commands_in_flight(0);
+	EXPECT_EQ(1, interfaceUnderTest.get_maximum_commands_in_flight());
+	interfaceUnderTest.set_maximum_commands_in_flight(200);
+	EXPECT_EQ(16, interfaceUnderTest.get_maximum_commands_in_flight());
+	interfaceUnderTest.set_maximum_commands_in_flight(3);
+
+	// The simulated VT answers a command by echoing its function code and first object ID, like most responses do
+	auto respond = [](std::uint8_t functionCode, std::uint16_t objectID) {
+		CANMessageFrame responseFrame = {};
+		responseFrame.identifier = 0x14E63726; // VT->ECU
+		responseFrame.dataLength = CAN_DATA_LENGTH;
+		responseFrame.isExtendedFrame = true;
+		responseFrame.data[0] = functionCode;
+		responseFrame.data[1] = objectID & 0xFF;
+		responseFrame.data[2] = (objectID >> 8) & 0xFF;
+		responseFrame.data[3] = 0; // No errors
+		for (std::uint8_t i = 4; i < CAN_DATA_LENGTH; i++)
+		{
+			responseFrame.data[i] = 0xFF;
+		}
+		CANNetworkManager::CANNetwork.process_receive_can_message_frame(responseFrame);
+		CANNetworkManager::CANNetwork.update();
+	};
+	auto send_status = [](std::uint8_t busyCodes) {
+		CANMessageFrame statusFrame = {};
+		statusFrame.identifier = 0x14E63726; // VT->ECU
+		statusFrame.dataLength = CAN_DATA_LENGTH;
+		statusFrame.isExtendedFrame = true;
+		statusFrame.data[0] = 0xFE; // VT status message
+		statusFrame.data[1] = 0x37; // Active working set master
+		statusFrame.data[2] = 0xFF;
+		statusFrame.data[3] = 0xFF;
+		statusFrame.data[4] = 0xFF;
+		statusFrame.data[5] = 0xFF;
+		statusFrame.data[6] = busyCodes;
+		statusFrame.data[7] = 0xFF;
+		CANNetworkManager::CANNetwork.process_receive_can_message_frame(statusFrame);
+		CANNetworkManager::CANNetwork.update();
+	};
+	auto read_command_object = [&serverVT, &testFrame](std::uint8_t expectedFunctionCode) -> std::uint16_t {
+		EXPECT_TRUE(serverVT.read_frame(testFrame));
+		EXPECT_EQ(expectedFunctionCode, testFrame.data[0]);
+		return static_cast<std::uint16_t>(testFrame.data[1]) | (static_cast<std::uint16_t>(testFrame.data[2]) << 8);
+	};
+	constexpr std::uint8_t NUMERIC_VALUE = static_cast<std::uint8_t>(VirtualTerminalClient::Function::ChangeNumericValueCommand);
+	constexpr std::uint8_t ACTIVE_MASK = static_cast<std::uint8_t>(VirtualTerminalClient::Function::ChangeActiveMaskCommand);
+
+	// Three commands to different objects go out without waiting for responses, the rest queue
+	for (std::uint16_t objectID = 1000; objectID < 1005; objectID++)
+	{
+		EXPECT_TRUE(interfaceUnderTest.send_change_numeric_value(objectID, objectID));
+	}
+	EXPECT_EQ(3, interfaceUnderTest.get_number_of_commands_in_flight());
+	EXPECT_EQ(2, interfaceUnderTest.test_wrapper_get_command_queue().size());
+	EXPECT_EQ(1000, read_command_object(NUMERIC_VALUE));
+	EXPECT_EQ(1001, read_command_object(NUMERIC_VALUE));
+	EXPECT_EQ(1002, read_command_object(NUMERIC_VALUE));
+
+	// Responses are matched by object, so they can arrive in any order
+	respond(NUMERIC_VALUE, 1001);
+	EXPECT_EQ(1003, read_command_object(NUMERIC_VALUE));
+	respond(NUMERIC_VALUE, 1000);
+	EXPECT_EQ(1004, read_command_object(NUMERIC_VALUE));
+	respond(NUMERIC_VALUE, 1002);
+	EXPECT_EQ(2, interfaceUnderTest.get_number_of_commands_in_flight());
+	EXPECT_TRUE(interfaceUnderTest.test_wrapper_get_command_queue().empty());
+	EXPECT_FALSE(interfaceUnderTest.get_command_pipelining_fallback_active());
+
+	// A command to an object that already has one in flight waits for it
+	EXPECT_TRUE(interfaceUnderTest.send_change_numeric_value(1003, 1));
+	EXPECT_EQ(2, interfaceUnderTest.get_number_of_commands_in_flight());
+	EXPECT_EQ(1, interfaceUnderTest.test_wrapper_get_command_queue().size());
+	respond(NUMERIC_VALUE, 1003);
+	EXPECT_EQ(1003, read_command_object(NUMERIC_VALUE));
+
+	// Commands that aren't about one object wait for the pipeline to drain, and nothing overtakes them
+	EXPECT_TRUE(interfaceUnderTest.send_change_active_mask(123, 456));
+	EXPECT_TRUE(interfaceUnderTest.send_change_numeric_value(1005, 1));
+	EXPECT_EQ(2, interfaceUnderTest.test_wrapper_get_command_queue().size());
+	respond(NUMERIC_VALUE, 1004);
+	respond(NUMERIC_VALUE, 1003);
+	EXPECT_EQ(123, read_command_object(ACTIVE_MASK));
+	EXPECT_EQ(1, interfaceUnderTest.get_number_of_commands_in_flight());
+	respond(ACTIVE_MASK, 456);
+	EXPECT_EQ(1005, read_command_object(NUMERIC_VALUE));
+	respond(NUMERIC_VALUE, 1005);
+	EXPECT_EQ(0, interfaceUnderTest.get_number_of_commands_in_flight());
+
+	// While the VT is busy executing a command, commands go out one at a time
+	send_status(0x04);
+	EXPECT_TRUE(interfaceUnderTest.send_change_numeric_value(2000, 1));
+	EXPECT_TRUE(interfaceUnderTest.send_change_numeric_value(2001, 1));
+	EXPECT_EQ(1, interfaceUnderTest.get_number_of_commands_in_flight());
+	EXPECT_EQ(2000, read_command_object(NUMERIC_VALUE));
+	send_status(0x00);
+	interfaceUnderTest.test_wrapper_process_command_queue();
+	EXPECT_EQ(2001, read_command_object(NUMERIC_VALUE));
+	EXPECT_EQ(2, interfaceUnderTest.get_number_of_commands_in_flight());
+
+	// A response that matches nothing in flight makes the client stop pipelining until it reconnects
+	respond(NUMERIC_VALUE, 3000);
+	EXPECT_TRUE(interfaceUnderTest.get_command_pipelining_fallback_active());
+	EXPECT_EQ(1, interfaceUnderTest.get_number_of_commands_in_flight());
+	EXPECT_TRUE(interfaceUnderTest.send_change_numeric_value(2002, 1));
+	EXPECT_EQ(1, interfaceUnderTest.get_number_of_commands_in_flight());
+	respond(NUMERIC_VALUE, 2001);
+	EXPECT_EQ(2002, read_command_object(NUMERIC_VALUE));
+
+	interfaceUnderTest.test_wrapper_set_state(VirtualTerminalClient::StateMachineState::Disconnected);
+	EXPECT_FALSE(interfaceUnderTest.get_command_pipelining_fallback_active());
+	EXPECT_EQ(0, interfaceUnderTest.get_number_of_commands_in_flight());
+
+	CANNetworkManager::CANNetwork.deactivate_control_function(vtPartner);
+	CANNetworkManager::CANNetwork.deactivate_control_function(internalECU);
+	serverVT.close();
+	CANHardwareInterface::stop();
+}
+
+TEST(VIRTUAL_TERMINAL_TESTS, DesiredStateSync)
+{
+	VirtualCANPlugin serverVT;
+	serverVT.open();
+
+	CANHardwareInterface::set_number_of_can_channels(1);
+	CANHardwareInterface::assign_can_channel_frame_handler(0, std::make_shared<VirtualCANPlugin>());
+	CANHardwareInterface::start();
+
+	auto internalECU = test_helpers::claim_internal_control_function(0x37, 0);
+	auto vtPartner = test_helpers::force_claim_partnered_control_function(0x26, 0);
+
+	// The client isn't connected, so every command it's asked to send waits in its queue where we can count it
+	auto vtClient = std::make_shared<DerivedTestVTClient>(vtPartner, internalECU);
+	vtClient->set_command_coalescing(false);
+	const VirtualTerminalClientCommandQueue &sentCommands = vtClient->test_wrapper_get_command_queue();
+
+	using Dimensions = std::pair<std::uint16_t, std::uint16_t>;
+	VirtualTerminalClientUpdateHelper helper(vtClient);
+	helper.add_tracked_numeric_value(1000, 5);
+	helper.add_tracked_visibility(2000, true);
+	helper.add_tracked_enable_state(3000, true);
+	helper.add_tracked_position(4000, 4001, 10, 20);
+	helper.add_tracked_size(4000, 100, 50);
+	helper.add_tracked_background_colour(4000, 1);
+	helper.add_tracked_string_value(5000, "Seeder");
+	helper.add_tracked_list_item(6000, 2, 6002);
+	helper.add_tracked_attribute(7000, 3, 12);
+
+	// Tracking the same state twice keeps the first initial value
+	helper.add_tracked_numeric_value(1000, 6);
+	EXPECT_EQ(5, helper.get_numeric_value(1000));
+
+	EXPECT_TRUE(helper.is_object_shown(2000));
+	EXPECT_TRUE(helper.is_object_enabled(3000));
+	EXPECT_EQ(Dimensions(10, 20), helper.get_position(4000));
+	EXPECT_EQ(Dimensions(100, 50), helper.get_size(4000));
+	EXPECT_EQ(1, helper.get_background_colour(4000));
+	EXPECT_EQ("Seeder", helper.get_string_value(5000));
+	EXPECT_EQ(6002, helper.get_list_item(6000, 2));
+	EXPECT_EQ(12, helper.get_attribute(7000, 3));
+	EXPECT_EQ(NULL_OBJECT_ID, helper.get_selected_input_object());
+
+	// Only the states that differ from the tracked ones are sent
+	VirtualTerminalClientUpdateHelper::DesiredState desiredState;
+	desiredState.set_numeric_value(1000, 5);
+	desiredState.set_shown(2000, false);
+	desiredState.set_enabled(3000, true);
+	desiredState.set_position(4000, 10, 20);
+	desiredState.set_size(4000, 120, 50);
+	desiredState.set_background_colour(4000, 1);
+	desiredState.set_string_value(5000, "Sprayer");
+	desiredState.set_list_item(6000, 2, 6002);
+	desiredState.set_attribute(7000, 3, 12);
+	desiredState.set_numeric_value(1000, 7); // Replaces the earlier numeric value of the same object
+	EXPECT_EQ(9, desiredState.size());
+
+	EXPECT_TRUE(helper.apply_desired_state(desiredState));
+	ASSERT_EQ(4, sentCommands.size());
+	EXPECT_EQ(static_cast<std::uint8_t>(VirtualTerminalClient::Function::ChangeNumericValueCommand), sentCommands.at(0)[0]);
+	EXPECT_EQ(static_cast<std::uint8_t>(VirtualTerminalClient::Function::HideShowObjectCommand), sentCommands.at(1)[0]);
+	EXPECT_EQ(static_cast<std::uint8_t>(VirtualTerminalClient::Function::ChangeSizeCommand), sentCommands.at(2)[0]);
+	EXPECT_EQ(static_cast<std::uint8_t>(VirtualTerminalClient::Function::ChangeStringValueCommand), sentCommands.at(3)[0]);
+	EXPECT_EQ(7, helper.get_numeric_value(1000));
+	EXPECT_FALSE(helper.is_object_shown(2000));
+	EXPECT_EQ(Dimensions(120, 50), helper.get_size(4000));
+	EXPECT_EQ("Sprayer", helper.get_string_value(5000));
+
+	// Applying the same state again sends nothing
+	EXPECT_TRUE(helper.apply_desired_state(desiredState));
+	EXPECT_EQ(4, sentCommands.size());
+
+	// States that aren't tracked can't be diffed
+	desiredState.clear();
+	desiredState.set_numeric_value(1234, 1);
+	EXPECT_FALSE(helper.apply_desired_state(desiredState));
+	EXPECT_EQ(4, sentCommands.size());
+
+	// After a reconnection, only the states that differ from the object pool are restored
+	EXPECT_TRUE(helper.set_list_item(6000, 2, 6003));
+	EXPECT_EQ(5, sentCommands.size());
+	vtClient->test_wrapper_clear_command_queue();
+	EXPECT_TRUE(helper.restore_tracked_state());
+	EXPECT_EQ(5, sentCommands.size());
+
+	// The active mask and soft key masks are restored after the other states, unless they match the object pool
+	helper.set_initial_active_mask(100);
+	helper.add_tracked_soft_key_mask(100, 200);
+	helper.add_tracked_soft_key_mask(101, 300);
+	EXPECT_TRUE(helper.set_active_data_or_alarm_mask(1, 101));
+	EXPECT_TRUE(helper.set_active_soft_key_mask(VirtualTerminalClient::MaskType::DataMask, 100, 201));
+	EXPECT_TRUE(helper.set_active_soft_key_mask(VirtualTerminalClient::MaskType::DataMask, 101, 300));
+	vtClient->test_wrapper_clear_command_queue();
+	EXPECT_TRUE(helper.restore_tracked_state());
+	ASSERT_EQ(7, sentCommands.size());
+	EXPECT_EQ(static_cast<std::uint8_t>(VirtualTerminalClient::Function::ChangeActiveMaskCommand), sentCommands.at(5)[0]);
+	EXPECT_EQ(101, sentCommands.at(5)[3] | (sentCommands.at(5)[4] << 8));
+	EXPECT_EQ(static_cast<std::uint8_t>(VirtualTerminalClient::Function::ChangeSoftKeyMaskCommand), sentCommands.at(6)[0]);
+	EXPECT_EQ(201, sentCommands.at(6)[4] | (sentCommands.at(6)[5] << 8));
+
+	// Going back to the object pool's masks leaves nothing to restore for them
+	EXPECT_TRUE(helper.set_active_data_or_alarm_mask(1, 100));
+	EXPECT_TRUE(helper.set_active_soft_key_mask(VirtualTerminalClient::MaskType::DataMask, 100, 200));
+	vtClient->test_wrapper_clear_command_queue();
+	EXPECT_TRUE(helper.restore_tracked_state());
+	EXPECT_EQ(5, sentCommands.size());
+
+	// Removing one state of an object keeps the others tracked
+	helper.remove_tracked_size(4000);
+	EXPECT_EQ(Dimensions(10, 20), helper.get_position(4000));
+	EXPECT_EQ(Dimensions(0, 0), helper.get_size(4000));
+
+	CANNetworkManager::CANNetwork.deactivate_control_function(vtPartner);
+	CANNetworkManager::CANNetwork.deactivate_control_function(internalECU);
+	serverVT.close();
+	CANHardwareInterface::stop();
+}
+
+TEST(VIRTUAL_TERMINAL_TESTS, MappedIOPFile)
+{
+	MappedIOPFile mappedPool("../../examples/virtual_terminal/version3_object_pool/VT3TestPool.iop");
+	std::vector<std::uint8_t> testPool = isobus::IOPFileInterface::read_iop_file("../../examples/virtual_terminal/version3_object_pool/VT3TestPool.iop");
+
+	if (!mappedPool.is_valid())
+	{
+		// Try a different path to mitigate differences between how IDEs run the unit test
+		mappedPool = MappedIOPFile("../examples/virtual_terminal/version3_object_pool/VT3TestPool.iop");
+		testPool = isobus::IOPFileInterface::read_iop_file("../examples/virtual_terminal/version3_object_pool/VT3TestPool.iop");
+	}
+
+	ASSERT_TRUE(mappedPool.is_valid());
+	ASSERT_EQ(mappedPool.size(), testPool.size());
+	EXPECT_TRUE(std::equal(testPool.begin(), testPool.end(), mappedPool.data()));
+	EXPECT_EQ(mappedPool.get_data().size(), testPool.size());
+
+	// The version must not change between releases, otherwise VTs would have to reload every stored pool
+	EXPECT_EQ("e7a4936e17c6865e", isobus::IOPFileInterface::hash_object_pool_to_version(testPool));
+	EXPECT_EQ("e7a4936e17c6865e", mappedPool.get_version());
+	std::vector<std::uint8_t> smallData = { 0x00, 0x01, 0x02, 0x03, 0xFE, 0xFF, 0x80, 0x7F };
+	EXPECT_EQ("55fca7fc66a51148", isobus::IOPFileInterface::hash_object_pool_to_version(smallData));
+
+	// Hashing in pieces gives the same result as hashing everything at once
+	IOPFileInterface::VersionHasher hasher(testPool.size());
+	for (std::size_t offset = 0; offset < testPool.size(); offset += 1000)
+	{
+		hasher.update(testPool.data() + offset, std::min<std::size_t>(1000, testPool.size() - offset));
+	}
+	EXPECT_EQ(mappedPool.get_version(), hasher.get_version());
+
+	// Moving the mapping leaves the source invalid
+	MappedIOPFile movedPool(std::move(mappedPool));
+	EXPECT_FALSE(mappedPool.is_valid());
+	EXPECT_EQ(nullptr, mappedPool.data());
+	ASSERT_TRUE(movedPool.is_valid());
+
+	MappedIOPFile missingPool("this_file_does_not_exist.iop");
+	EXPECT_FALSE(missingPool.is_valid());
+	EXPECT_EQ(0, missingPool.size());
+	EXPECT_TRUE(missingPool.get_version().empty());
+
+	// The mapped data can be used as an object pool directly
+	NAME clientNAME(0);
+	clientNAME.set_arbitrary_address_capable(true);
+	clientNAME.set_industry_group(1);
+	clientNAME.set_function_code(static_cast<std::uint8_t>(isobus::NAME::Function::OilSystemMonitor));
+	clientNAME.set_identity_number(1);
+	clientNAME.set_ecu_instance(1);
+	clientNAME.set_manufacturer_code(69);
+	auto internalECU = CANNetworkManager::CANNetwork.create_internal_control_function(clientNAME, 0, 0x26);
+
+	std::vector<isobus::NAMEFilter> vtNameFilters;
+	const isobus::NAMEFilter testFilter(isobus::NAME::NAMEParameters::FunctionCode, static_cast<std::uint8_t>(isobus::NAME::Function::VirtualTerminal));
+	vtNameFilters.push_back(testFilter);
+	auto vtPartner = CANNetworkManager::CANNetwork.create_partnered_control_function(0, vtNameFilters);
+
+	DerivedTestVTClient clientUnderTest(vtPartner, internalECU);
+	clientUnderTest.set_object_pool(0, movedPool.get_data(), movedPool.get_version());
+	EXPECT_EQ(false, clientUnderTest.test_wrapper_get_any_pool_needs_scaling());
+	clientUnderTest.set_object_pool_scaling(0, 240, 240);
+	EXPECT_EQ(true, clientUnderTest.test_wrapper_get_any_pool_needs_scaling());
+	EXPECT_EQ(true, clientUnderTest.test_wrapper_scale_object_pools());
+
+	CANNetworkManager::CANNetwork.deactivate_control_function(vtPartner);
+	CANNetworkManager::CANNetwork.deactivate_control_function(internalECU);
+}
+
+TEST(VIRTUAL_TERMINAL_TESTS, StreamingAutoscalingMatchesFullPoolAutoscaling)
+{
+	NAME clientNAME(0);
+	clientNAME.set_arbitrary_address_capable(true);
+	clientNAME.set_industry_group(1);
+	clientNAME.set_function_code(static_cast<std::uint8_t>(isobus::NAME::Function::OilSystemMonitor));
+	clientNAME.set_identity_number(1);
+	clientNAME.set_ecu_instance(1);
+	clientNAME.set_manufacturer_code(69);
+	auto internalECU = CANNetworkManager::CANNetwork.create_internal_control_function(clientNAME, 0, 0x26);
+
+	std::vector<isobus::NAMEFilter> vtNameFilters;
+	const isobus::NAMEFilter testFilter(isobus::NAME::NAMEParameters::FunctionCode, static_cast<std::uint8_t>(isobus::NAME::Function::VirtualTerminal));
+	vtNameFilters.push_back(testFilter);
+	auto vtPartner = CANNetworkManager::CANNetwork.create_partnered_control_function(0, vtNameFilters);
+
+	DerivedTestVTClient::staticTestPool = isobus::IOPFileInterface::read_iop_file("../../examples/virtual_terminal/version3_object_pool/VT3TestPool.iop");
+
+	if (0 == DerivedTestVTClient::staticTestPool.size())
+	{
+		// Try a different path to mitigate differences between how IDEs run the unit test
+		DerivedTestVTClient::staticTestPool = isobus::IOPFileInterface::read_iop_file("../examples/virtual_terminal/version3_object_pool/VT3TestPool.iop");
+	}
+	const auto &testPool = DerivedTestVTClient::staticTestPool;
+	ASSERT_NE(0, testPool.size());
+	const auto poolSize = static_cast<std::uint32_t>(testPool.size());
+
+	DerivedTestVTClient clientUnderTest(vtPartner, internalECU);
+	EXPECT_TRUE(clientUnderTest.get_streaming_object_pool_scaling());
+	EXPECT_EQ(1, clientUnderTest.get_object_pool_scaling_thread_count());
+	clientUnderTest.test_wrapper_set_screen_size(480, 80);
+	clientUnderTest.test_wrapper_set_supported_fonts(0xFF, 0xFF);
+	clientUnderTest.set_object_pool(0, DataSpan<const std::uint8_t>(testPool.data(), testPool.size()));
+	clientUnderTest.set_object_pool_scaling(0, 200, 60);
+
+	// Scaling the whole pool up front gives the reference result
+	ASSERT_TRUE(clientUnderTest.test_wrapper_scale_object_pools());
+	const std::vector<std::uint8_t> referencePool = clientUnderTest.test_wrapper_get_scaled_object_pool(0);
+	EXPECT_NE(testPool, referencePool);
+
+	// Splitting the objects over multiple threads doesn't change the result
+	clientUnderTest.set_object_pool_scaling_thread_count(4);
+	EXPECT_EQ(4, clientUnderTest.get_object_pool_scaling_thread_count());
+	ASSERT_TRUE(clientUnderTest.test_wrapper_scale_object_pools());
+	EXPECT_EQ(referencePool, clientUnderTest.test_wrapper_get_scaled_object_pool(0));
+
+	// Reads the pool the way the transport protocol does, in packets of 7 bytes, with a retransmission now and then
+	auto stream_pool = [&clientUnderTest, poolSize]() {
+		std::vector<std::uint8_t> streamedPool(poolSize, 0);
+		bool success = true;
+
+		for (std::uint32_t offset = 0; (offset < poolSize) && success; offset += 7)
+		{
+			const std::uint32_t length = std::min<std::uint32_t>(7, poolSize - offset);
+			success = clientUnderTest.test_wrapper_get_streamed_scaled_object_pool_bytes(0, offset, length, &streamedPool[offset]);
+
+			if (success && (0 == (offset % 7000)) && (offset >= 1785))
+			{
+				// Go back a full ETP window, which must still be in the scaled history
+				std::uint8_t retransmittedPacket[7];
+				const std::uint32_t retransmitOffset = offset - 1785;
+				success = clientUnderTest.test_wrapper_get_streamed_scaled_object_pool_bytes(0, retransmitOffset, 7, retransmittedPacket);
+				success = success && std::equal(retransmittedPacket, retransmittedPacket + 7, &streamedPool[retransmitOffset]);
+			}
+		}
+		EXPECT_TRUE(success);
+		return streamedPool;
+	};
+	EXPECT_EQ(referencePool, stream_pool());
+
+	// Seeking back beyond the history restarts scaling from the start of the pool
+	std::uint8_t firstPacket[7];
+	ASSERT_TRUE(clientUnderTest.test_wrapper_get_streamed_scaled_object_pool_bytes(0, 0, 7, firstPacket));
+	EXPECT_TRUE(std::equal(firstPacket, firstPacket + 7, referencePool.begin()));
+	EXPECT_FALSE(clientUnderTest.test_wrapper_get_streamed_scaled_object_pool_bytes(0, poolSize - 6, 7, firstPacket));
+
+	// A pool supplied through a data chunk callback streams the same result
+	clientUnderTest.register_object_pool_data_chunk_callback(0, poolSize, DerivedTestVTClient::testWrapperDataChunkCallback);
+	clientUnderTest.set_object_pool_scaling(0, 200, 60);
+	EXPECT_EQ(referencePool, stream_pool());
+
+	ASSERT_TRUE(clientUnderTest.test_wrapper_scale_object_pools());
+	EXPECT_EQ(referencePool, clientUnderTest.test_wrapper_get_scaled_object_pool(0));
+
+	CANNetworkManager::CANNetwork.deactivate_control_function(vtPartner);
+	CANNetworkManager::CANNetwork.deactivate_control_function(internalECU);
+}
+
+static std::vector<std::uint8_t> make_scaled_object_pool_cache_file(const std::vector<std::uint8_t> &pool)
+{
+	const std::string poolHash = isobus::IOPFileInterface::hash_object_pool_to_version(pool.data(), pool.size());
+	std::vector<std::uint8_t> retVal = pool;
+	retVal.insert(retVal.end(), poolHash.begin(), poolHash.end());
+	return retVal;
+}
+
+static bool failing_object_pool_data_callback(std::uint32_t, std::uint32_t, std::uint32_t, std::uint8_t *, void *)
+{
+	return false;
+}
+
+TEST(VIRTUAL_TERMINAL_TESTS, ScaledObjectPoolCache)
+{
+	NAME clientNAME(0);
+	clientNAME.set_arbitrary_address_capable(true);
+	clientNAME.set_industry_group(1);
+	clientNAME.set_function_code(static_cast<std::uint8_t>(isobus::NAME::Function::OilSystemMonitor));
+	clientNAME.set_identity_number(1);
+	clientNAME.set_ecu_instance(1);
+	clientNAME.set_manufacturer_code(69);
+	auto internalECU = CANNetworkManager::CANNetwork.create_internal_control_function(clientNAME, 0, 0x26);
+
+	std::vector<isobus::NAMEFilter> vtNameFilters;
+	const isobus::NAMEFilter testFilter(isobus::NAME::NAMEParameters::FunctionCode, static_cast<std::uint8_t>(isobus::NAME::Function::VirtualTerminal));
+	vtNameFilters.push_back(testFilter);
+	auto vtPartner = CANNetworkManager::CANNetwork.create_partnered_control_function(0, vtNameFilters);
+
+	std::vector<std::uint8_t> testPool = isobus::IOPFileInterface::read_iop_file("../../examples/virtual_terminal/version3_object_pool/VT3TestPool.iop");
+
+	if (0 == testPool.size())
+	{
+		// Try a different path to mitigate differences between how IDEs run the unit test
+		testPool = isobus::IOPFileInterface::read_iop_file("../examples/virtual_terminal/version3_object_pool/VT3TestPool.iop");
+	}
+	ASSERT_NE(0, testPool.size());
+
+	DerivedTestVTClient clientUnderTest(vtPartner, internalECU);
+	clientUnderTest.test_wrapper_set_screen_size(480, 80);
+	clientUnderTest.test_wrapper_set_supported_fonts(0xFF, 0xFF);
+	clientUnderTest.set_object_pool(0, DataSpan<const std::uint8_t>(testPool.data(), testPool.size()), "TEST");
+
+	// Without scaling, the configured label is used as is
+	EXPECT_EQ("TEST", clientUnderTest.test_wrapper_get_object_pool_version_label());
+
+	// With scaling, the label is derived from the VT capabilities
+	clientUnderTest.set_object_pool_scaling(0, 200, 60);
+	const std::string scaledLabel = clientUnderTest.test_wrapper_get_object_pool_version_label();
+	EXPECT_EQ(7, scaledLabel.size());
+	EXPECT_NE("TEST", scaledLabel);
+	EXPECT_EQ(scaledLabel, clientUnderTest.test_wrapper_get_object_pool_version_label());
+
+	// Without a cache, streaming scaling doesn't need to prepare anything
+	EXPECT_TRUE(clientUnderTest.get_scaled_object_pool_cache_directory().empty());
+	ASSERT_TRUE(clientUnderTest.test_wrapper_prepare_scaled_object_pools());
+	EXPECT_TRUE(clientUnderTest.test_wrapper_get_scaled_object_pool_empty(0));
+
+	// Reference result, scaled from scratch
+	ASSERT_TRUE(clientUnderTest.test_wrapper_scale_object_pools());
+	const std::vector<std::uint8_t> referencePool = clientUnderTest.test_wrapper_get_scaled_object_pool(0);
+
+	// The first connection misses the cache, scales the pool and stores it
+	clientUnderTest.set_scaled_object_pool_cache_directory(::testing::TempDir());
+	EXPECT_EQ(::testing::TempDir(), clientUnderTest.get_scaled_object_pool_cache_directory());
+	const std::string cachePath = clientUnderTest.test_wrapper_get_scaled_object_pool_cache_path(0);
+	std::remove(cachePath.c_str());
+	ASSERT_TRUE(clientUnderTest.test_wrapper_prepare_scaled_object_pools());
+	EXPECT_EQ(referencePool, clientUnderTest.test_wrapper_get_scaled_object_pool(0));
+	EXPECT_EQ(make_scaled_object_pool_cache_file(referencePool), isobus::IOPFileInterface::read_iop_file(cachePath));
+
+	// A reconnect to the same VT loads the pool from the cache instead of scaling it
+	std::vector<std::uint8_t> markedPool(testPool.size(), 0xAA);
+	std::vector<std::uint8_t> markedCacheFile = make_scaled_object_pool_cache_file(markedPool);
+	{
+		std::ofstream cacheFile(cachePath, std::ios::binary | std::ios::trunc);
+		cacheFile.write(reinterpret_cast<const char *>(markedCacheFile.data()), markedCacheFile.size());
+	}
+	ASSERT_TRUE(clientUnderTest.test_wrapper_prepare_scaled_object_pools());
+	EXPECT_EQ(markedPool, clientUnderTest.test_wrapper_get_scaled_object_pool(0));
+
+	// A damaged cache file of the right size is scaled again and replaced
+	markedCacheFile[10] ^= 0xFF;
+	{
+		std::ofstream cacheFile(cachePath, std::ios::binary | std::ios::trunc);
+		cacheFile.write(reinterpret_cast<const char *>(markedCacheFile.data()), markedCacheFile.size());
+	}
+	ASSERT_TRUE(clientUnderTest.test_wrapper_prepare_scaled_object_pools());
+	EXPECT_EQ(referencePool, clientUnderTest.test_wrapper_get_scaled_object_pool(0));
+	EXPECT_EQ(make_scaled_object_pool_cache_file(referencePool), isobus::IOPFileInterface::read_iop_file(cachePath));
+
+	// A VT with a different resolution gets its own cache entry and version label
+	clientUnderTest.test_wrapper_set_screen_size(800, 80);
+	const std::string otherCachePath = clientUnderTest.test_wrapper_get_scaled_object_pool_cache_path(0);
+	EXPECT_NE(cachePath, otherCachePath);
+	EXPECT_NE(scaledLabel, clientUnderTest.test_wrapper_get_object_pool_version_label());
+	std::remove(otherCachePath.c_str());
+	ASSERT_TRUE(clientUnderTest.test_wrapper_prepare_scaled_object_pools());
+	EXPECT_NE(markedPool, clientUnderTest.test_wrapper_get_scaled_object_pool(0));
+	EXPECT_EQ(make_scaled_object_pool_cache_file(clientUnderTest.test_wrapper_get_scaled_object_pool(0)), isobus::IOPFileInterface::read_iop_file(otherCachePath));
+
+	// The label only depends on the key, so a new client derives the same one
+	DerivedTestVTClient otherClient(vtPartner, internalECU);
+	otherClient.test_wrapper_set_screen_size(480, 80);
+	otherClient.test_wrapper_set_supported_fonts(0xFF, 0xFF);
+	otherClient.set_object_pool(0, DataSpan<const std::uint8_t>(testPool.data(), testPool.size()), "TEST");
+	otherClient.set_object_pool_scaling(0, 200, 60);
+	EXPECT_EQ(scaledLabel, otherClient.test_wrapper_get_object_pool_version_label());
+
+	// A pool set from a vector gets a new key when the vector's contents change
+	std::vector<std::uint8_t> changingPool = testPool;
+	otherClient.set_object_pool(0, &changingPool, "TEST");
+	otherClient.set_object_pool_scaling(0, 200, 60);
+	const std::string vectorPoolCachePath = otherClient.test_wrapper_get_scaled_object_pool_cache_path(0);
+	EXPECT_EQ(scaledLabel, otherClient.test_wrapper_get_object_pool_version_label());
+	changingPool.back() ^= 0xFF;
+	EXPECT_NE(vectorPoolCachePath, otherClient.test_wrapper_get_scaled_object_pool_cache_path(0));
+	EXPECT_NE(scaledLabel, otherClient.test_wrapper_get_object_pool_version_label());
+
+	// A pool that can't be hashed gets neither a cache entry nor a version label
+	otherClient.register_object_pool_data_chunk_callback(0, static_cast<std::uint32_t>(testPool.size()), failing_object_pool_data_callback, "TEST");
+	otherClient.set_object_pool_scaling(0, 200, 60);
+	EXPECT_TRUE(otherClient.test_wrapper_get_scaled_object_pool_cache_path(0).empty());
+	EXPECT_TRUE(otherClient.test_wrapper_get_object_pool_version_label().empty());
+
+	std::remove(cachePath.c_str());
+	std::remove(otherCachePath.c_str());
+	CANNetworkManager::CANNetwork.deactivate_control_function(vtPartner);
+	CANNetworkManager::CANNetwork.deactivate_control_function(internalECU);
+}
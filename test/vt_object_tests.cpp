@@ -8,7 +8,11 @@
 //================================================================================================
 #include <gtest/gtest.h>
 
+#include "isobus/isobus/isobus_virtual_terminal_object_pool_parser.hpp"
 #include "isobus/isobus/isobus_virtual_terminal_objects.hpp"
+#include "isobus/utility/iop_file_interface.hpp"
+
+#include <random>
 
 using namespace isobus;
 
@@ -38,7 +42,7 @@ static void run_baseline_tests(VTObject *objectUnderTest)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, WorkingSetTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	VTColourTable colourTable;
 	auto ws = std::make_shared<WorkingSet>();
 
@@ -78,20 +82,20 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, WorkingSetTests)
 	// Test the validity checker
 	EXPECT_FALSE(ws->get_is_valid(objects));
 	ws->set_id(10);
-	objects[ws->get_id()] = ws;
+	objects.add_object(ws);
 	EXPECT_TRUE(ws->get_is_valid(objects));
 
 	// Add a valid object, a container
 	auto container = std::make_shared<Container>();
 	container->set_id(20);
-	objects[container->get_id()] = container;
+	objects.add_object(container);
 	ws->add_child(container->get_id(), 0, 0);
 	EXPECT_TRUE(ws->get_is_valid(objects));
 
 	// Add an invalid object, a Key
 	auto key = std::make_shared<Key>();
 	key->set_id(30);
-	objects[key->get_id()] = key;
+	objects.add_object(key);
 	ws->add_child(key->get_id(), 0, 0);
 	EXPECT_FALSE(ws->get_is_valid(objects));
 
@@ -128,7 +132,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, WorkingSetTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, DataMaskTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	DataMask mask;
 
 	run_baseline_tests(&mask);
@@ -151,25 +155,25 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, DataMaskTests)
 	// We'll make a new shared pointer to an data mask
 	auto dataMask2 = std::make_shared<DataMask>();
 	dataMask2->set_id(1); // Arbitrary ID
-	objects[dataMask2->get_id()] = dataMask2;
+	objects.add_object(dataMask2);
 
 	// Let's add a soft key mask to the alarm mask
 	auto softKeyMask = std::make_shared<SoftKeyMask>();
 	softKeyMask->set_id(100);
 	dataMask2->add_child(softKeyMask->get_id(), 0, 0);
-	objects[softKeyMask->get_id()] = softKeyMask;
+	objects.add_object(softKeyMask);
 
 	// now let's make a different soft key mask that we'll use to replace the old one
 	auto softKeyMask2 = std::make_shared<SoftKeyMask>();
 	softKeyMask2->set_id(200);
-	objects[softKeyMask2->get_id()] = softKeyMask2;
+	objects.add_object(softKeyMask2);
 
 	EXPECT_TRUE(dataMask2->get_is_valid(objects));
 
 	// Add an invalid object, another data mask
 	auto dataMask3 = std::make_shared<DataMask>();
 	dataMask3->set_id(2); // Arbitrary ID
-	objects[dataMask3->get_id()] = dataMask3;
+	objects.add_object(dataMask3);
 	dataMask2->add_child(dataMask3->get_id(), 0, 0);
 	EXPECT_FALSE(dataMask2->get_is_valid(objects));
 
@@ -205,7 +209,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, DataMaskTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ContainerTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	Container container;
 
 	run_baseline_tests(&container);
@@ -249,14 +253,14 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ContainerTests)
 	// Add a valid child object, a Button
 	auto button = std::make_shared<Button>();
 	button->set_id(200);
-	objects[button->get_id()] = button;
+	objects.add_object(button);
 	container.add_child(button->get_id(), 0, 0);
 	EXPECT_TRUE(container.get_is_valid(objects));
 
 	// Add an invalid object, a data mask
 	auto dataMask = std::make_shared<DataMask>();
 	dataMask->set_id(300);
-	objects[dataMask->get_id()] = dataMask;
+	objects.add_object(dataMask);
 	container.add_child(dataMask->get_id(), 0, 0);
 	EXPECT_FALSE(container.get_is_valid(objects));
 
@@ -276,7 +280,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ContainerTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AlarmMaskTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	AlarmMask alarmMask;
 
 	run_baseline_tests(&alarmMask);
@@ -288,18 +292,18 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AlarmMaskTests)
 	// We'll make a new shared pointer to an alarm mask
 	auto alarmMask2 = std::make_shared<AlarmMask>();
 	alarmMask2->set_id(1); // Arbitrary ID
-	objects[alarmMask2->get_id()] = alarmMask2;
+	objects.add_object(alarmMask2);
 
 	// Let's add a soft key mask to the alarm mask
 	auto softKeyMask = std::make_shared<SoftKeyMask>();
 	softKeyMask->set_id(100);
 	alarmMask2->add_child(softKeyMask->get_id(), 0, 0);
-	objects[softKeyMask->get_id()] = softKeyMask;
+	objects.add_object(softKeyMask);
 
 	// now let's make a different soft key mask that we'll use to replace the old one
 	auto softKeyMask2 = std::make_shared<SoftKeyMask>();
 	softKeyMask2->set_id(200);
-	objects[softKeyMask2->get_id()] = softKeyMask2;
+	objects.add_object(softKeyMask2);
 
 	VTObject::AttributeError error = VTObject::AttributeError::AnyOtherError;
 	EXPECT_TRUE(alarmMask2->set_attribute(static_cast<std::uint8_t>(AlarmMask::AttributeName::SoftKeyMask), 200, objects, error));
@@ -335,7 +339,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AlarmMaskTests)
 	// Add an invalid object, another Alarm Mask
 	auto alarmMask3 = std::make_shared<AlarmMask>();
 	alarmMask3->set_id(2); // Arbitrary ID
-	objects[alarmMask3->get_id()] = alarmMask3;
+	objects.add_object(alarmMask3);
 	alarmMask2->add_child(alarmMask3->get_id(), 0, 0);
 	EXPECT_FALSE(alarmMask2->get_is_valid(objects));
 
@@ -369,7 +373,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AlarmMaskTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, SoftKeyMaskTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto softKeyMask = std::make_shared<SoftKeyMask>();
 
 	run_baseline_tests(softKeyMask.get());
@@ -391,14 +395,14 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, SoftKeyMaskTests)
 	EXPECT_NE(0, static_cast<std::uint8_t>(error));
 
 	softKeyMask->set_id(100);
-	objects[softKeyMask->get_id()] = softKeyMask;
+	objects.add_object(softKeyMask);
 
 	EXPECT_TRUE(softKeyMask->get_is_valid(objects));
 
 	// Add an invalid object, a container
 	auto container = std::make_shared<Container>();
 	container->set_id(200);
-	objects[container->get_id()] = container;
+	objects.add_object(container);
 	softKeyMask->add_child(container->get_id(), 0, 0);
 	EXPECT_FALSE(softKeyMask->get_is_valid(objects));
 	softKeyMask->remove_child(200, 0, 0);
@@ -406,7 +410,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, SoftKeyMaskTests)
 	// Add a valid object, a Key
 	auto key = std::make_shared<Key>();
 	key->set_id(300);
-	objects[key->get_id()] = key;
+	objects.add_object(key);
 	softKeyMask->add_child(key->get_id(), 0, 0);
 	EXPECT_TRUE(softKeyMask->get_is_valid(objects));
 
@@ -420,7 +424,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, SoftKeyMaskTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, SoftKeyTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto softKey = std::make_shared<Key>();
 
 	run_baseline_tests(softKey.get());
@@ -449,19 +453,19 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, SoftKeyTests)
 	EXPECT_NE(0, static_cast<std::uint8_t>(error));
 
 	softKey->set_id(100);
-	objects[softKey->get_id()] = softKey;
+	objects.add_object(softKey);
 
 	// Add a valid child, a picture graphic
 	auto pictureGraphic = std::make_shared<PictureGraphic>();
 	pictureGraphic->set_id(200);
-	objects[pictureGraphic->get_id()] = pictureGraphic;
+	objects.add_object(pictureGraphic);
 	softKey->add_child(pictureGraphic->get_id(), 0, 0);
 	EXPECT_TRUE(softKey->get_is_valid(objects));
 
 	// Add an invalid object, a data mask
 	auto dataMask = std::make_shared<DataMask>();
 	dataMask->set_id(300);
-	objects[dataMask->get_id()] = dataMask;
+	objects.add_object(dataMask);
 	softKey->add_child(dataMask->get_id(), 0, 0);
 	EXPECT_FALSE(softKey->get_is_valid(objects));
 
@@ -478,7 +482,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, SoftKeyTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ButtonTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto button = std::make_shared<Button>();
 
 	run_baseline_tests(button.get());
@@ -525,19 +529,19 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ButtonTests)
 	EXPECT_FALSE(button->get_option(Button::Options::NoBorder));
 
 	button->set_id(100);
-	objects[button->get_id()] = button;
+	objects.add_object(button);
 
 	// Add a valid child, a picture graphic
 	auto pictureGraphic = std::make_shared<PictureGraphic>();
 	pictureGraphic->set_id(200);
-	objects[pictureGraphic->get_id()] = pictureGraphic;
+	objects.add_object(pictureGraphic);
 	button->add_child(pictureGraphic->get_id(), 0, 0);
 	EXPECT_TRUE(button->get_is_valid(objects));
 
 	// Add an invalid object, a data mask
 	auto dataMask = std::make_shared<DataMask>();
 	dataMask->set_id(300);
-	objects[dataMask->get_id()] = dataMask;
+	objects.add_object(dataMask);
 	button->add_child(dataMask->get_id(), 0, 0);
 	EXPECT_FALSE(button->get_is_valid(objects));
 
@@ -566,7 +570,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ButtonTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, KeyGroupTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto keyGroup = std::make_shared<KeyGroup>();
 	auto testName = std::make_shared<OutputString>();
 
@@ -574,11 +578,11 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, KeyGroupTests)
 	EXPECT_EQ(keyGroup->get_object_type(), VirtualTerminalObjectType::KeyGroup);
 
 	keyGroup->set_id(100);
-	objects[keyGroup->get_id()] = keyGroup;
+	objects.add_object(keyGroup);
 	EXPECT_EQ(100, keyGroup->get_id());
 
 	testName->set_id(200);
-	objects[testName->get_id()] = testName;
+	objects.add_object(testName);
 	keyGroup->set_name_object_id(200);
 
 	keyGroup->set_key_group_icon(500);
@@ -598,7 +602,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, KeyGroupTests)
 	// Add a key
 	auto key = std::make_shared<Key>();
 	key->set_id(300);
-	objects[key->get_id()] = key;
+	objects.add_object(key);
 	keyGroup->add_child(key->get_id(), 0, 0);
 
 	// It should still be valid
@@ -607,7 +611,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, KeyGroupTests)
 	// Add an object pointer that isn't a key
 	auto objectPointer = std::make_shared<ObjectPointer>();
 	objectPointer->set_id(400);
-	objects[objectPointer->get_id()] = objectPointer;
+	objects.add_object(objectPointer);
 	objectPointer->add_child(key->get_id(), 0, 0);
 	keyGroup->add_child(objectPointer->get_id(), 0, 0);
 
@@ -617,7 +621,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, KeyGroupTests)
 	// Change the object pointer to some random thing
 	auto container = std::make_shared<Container>();
 	container->set_id(500);
-	objects[container->get_id()] = container;
+	objects.add_object(container);
 	objectPointer->remove_child(key->get_id(), 0, 0);
 	objectPointer->set_value(container->get_id());
 
@@ -632,7 +636,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, KeyGroupTests)
 	// Make an output string we can use to test the name of the key group
 	auto outputString = std::make_shared<OutputString>();
 	outputString->set_id(600);
-	objects[outputString->get_id()] = outputString;
+	objects.add_object(outputString);
 	keyGroup->add_child(outputString->get_id(), 0, 0);
 
 	// Now let's change the name of the key group
@@ -660,7 +664,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, KeyGroupTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputBooleanTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto inputBoolean = std::make_shared<InputBoolean>();
 
 	run_baseline_tests(inputBoolean.get());
@@ -696,7 +700,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputBooleanTests)
 	// First, let's make a font attributes object
 	auto fontAttribute = std::make_shared<FontAttributes>();
 	fontAttribute->set_id(1); // Arbitrary
-	objects[fontAttribute->get_id()] = fontAttribute;
+	objects.add_object(fontAttribute);
 
 	// Add it
 	inputBoolean->set_foreground_colour_object_id(fontAttribute->get_id());
@@ -705,7 +709,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputBooleanTests)
 	// Now lets replace it with a different font attributes object using set_attribute
 	auto fontAttribute2 = std::make_shared<FontAttributes>();
 	fontAttribute2->set_id(2); // Arbitrary
-	objects[fontAttribute2->get_id()] = fontAttribute2;
+	objects.add_object(fontAttribute2);
 
 	EXPECT_TRUE(inputBoolean->set_attribute(static_cast<std::uint8_t>(InputBoolean::AttributeName::ForegroundColour), fontAttribute2->get_id(), objects, error));
 	EXPECT_EQ(inputBoolean->get_foreground_colour_object_id(), fontAttribute2->get_id()); // Now the 2nd font attribute should be used for the foreground colour
@@ -718,12 +722,12 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputBooleanTests)
 	EXPECT_TRUE(inputBoolean->set_attribute(static_cast<std::uint8_t>(InputBoolean::AttributeName::VariableReference), 0xFFFF, objects, error));
 
 	inputBoolean->set_id(100);
-	objects[inputBoolean->get_id()] = inputBoolean;
+	objects.add_object(inputBoolean);
 
 	// Add a variable reference
 	auto numberVariable = std::make_shared<NumberVariable>();
 	numberVariable->set_id(200);
-	objects[numberVariable->get_id()] = numberVariable;
+	objects.add_object(numberVariable);
 	inputBoolean->set_variable_reference(numberVariable->get_id());
 	EXPECT_EQ(inputBoolean->get_variable_reference(), 200);
 	EXPECT_TRUE(inputBoolean->get_is_valid(objects));
@@ -731,7 +735,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputBooleanTests)
 	// Add an invalid variable reference, a container
 	auto container = std::make_shared<Container>();
 	container->set_id(300);
-	objects[container->get_id()] = container;
+	objects.add_object(container);
 	inputBoolean->set_variable_reference(container->get_id());
 	EXPECT_EQ(300, inputBoolean->get_variable_reference());
 	EXPECT_FALSE(inputBoolean->get_is_valid(objects));
@@ -761,7 +765,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputBooleanTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputStringTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto inputString = std::make_shared<InputString>();
 
 	run_baseline_tests(inputString.get());
@@ -811,12 +815,12 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputStringTests)
 	// Test input string font attribute
 	auto fontAttribute = std::make_shared<FontAttributes>();
 	fontAttribute->set_id(1); // Arbitrary
-	objects[fontAttribute->get_id()] = fontAttribute;
+	objects.add_object(fontAttribute);
 
 	// Test input string input attributes
 	auto inputAttribute = std::make_shared<InputAttributes>();
 	inputAttribute->set_id(5); // Arbitrary
-	objects[inputAttribute->get_id()] = inputAttribute;
+	objects.add_object(inputAttribute);
 
 	// Add it
 	inputString->set_font_attributes(fontAttribute->get_id());
@@ -825,7 +829,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputStringTests)
 	// Now lets replace it with a different font attributes object using set_attribute
 	auto fontAttribute2 = std::make_shared<FontAttributes>();
 	fontAttribute2->set_id(2); // Arbitrary
-	objects[fontAttribute2->get_id()] = fontAttribute2;
+	objects.add_object(fontAttribute2);
 
 	EXPECT_TRUE(inputString->set_attribute(static_cast<std::uint8_t>(InputString::AttributeName::FontAttributes), fontAttribute2->get_id(), objects, error));
 	EXPECT_TRUE(inputString->set_attribute(static_cast<std::uint8_t>(InputString::AttributeName::InputAttributes), inputAttribute->get_id(), objects, error));
@@ -843,13 +847,13 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputStringTests)
 	EXPECT_TRUE(inputString->get_option(InputString::Options::Transparent));
 
 	inputString->set_id(100);
-	objects[inputString->get_id()] = inputString;
+	objects.add_object(inputString);
 	EXPECT_TRUE(inputString->get_is_valid(objects));
 
 	// Add an invalid object, a picture graphic
 	auto pictureGraphic = std::make_shared<PictureGraphic>();
 	pictureGraphic->set_id(200);
-	objects[pictureGraphic->get_id()] = pictureGraphic;
+	objects.add_object(pictureGraphic);
 	inputString->add_child(pictureGraphic->get_id(), 0, 0);
 	EXPECT_FALSE(inputString->get_is_valid(objects));
 
@@ -887,7 +891,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputStringTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputNumberTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto inputNumber = std::make_shared<InputNumber>();
 
 	run_baseline_tests(inputNumber.get());
@@ -985,7 +989,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputNumberTests)
 	// Test input number font attribute
 	auto fontAttribute = std::make_shared<FontAttributes>();
 	fontAttribute->set_id(1); // Arbitrary
-	objects[fontAttribute->get_id()] = fontAttribute;
+	objects.add_object(fontAttribute);
 
 	// Add it
 	inputNumber->set_font_attributes(fontAttribute->get_id());
@@ -994,18 +998,18 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputNumberTests)
 	// Now lets replace it with a different font attributes object using set_attribute
 	auto fontAttribute2 = std::make_shared<FontAttributes>();
 	fontAttribute2->set_id(2); // Arbitrary
-	objects[fontAttribute2->get_id()] = fontAttribute2;
+	objects.add_object(fontAttribute2);
 	EXPECT_TRUE(inputNumber->set_attribute(static_cast<std::uint8_t>(InputNumber::AttributeName::FontAttributes), fontAttribute2->get_id(), objects, error));
 
 	inputNumber->set_id(100);
-	objects[inputNumber->get_id()] = inputNumber;
+	objects.add_object(inputNumber);
 
 	EXPECT_TRUE(inputNumber->get_is_valid(objects));
 
 	// Add an invalid object, a FillAttributes object
 	auto fillAttributes = std::make_shared<FillAttributes>();
 	fillAttributes->set_id(200);
-	objects[fillAttributes->get_id()] = fillAttributes;
+	objects.add_object(fillAttributes);
 	inputNumber->add_child(fillAttributes->get_id(), 0, 0);
 	EXPECT_FALSE(inputNumber->get_is_valid(objects));
 
@@ -1061,7 +1065,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputNumberTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputListTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto inputList = std::make_shared<InputList>();
 
 	run_baseline_tests(inputList.get());
@@ -1114,12 +1118,12 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputListTests)
 	EXPECT_EQ(inputList->get_variable_reference(), 386);
 
 	inputList->set_id(100);
-	objects[inputList->get_id()] = inputList;
+	objects.add_object(inputList);
 
 	// Add a valid child object, an output string
 	auto outputString = std::make_shared<OutputString>();
 	outputString->set_id(200);
-	objects[outputString->get_id()] = outputString;
+	objects.add_object(outputString);
 	inputList->add_child(outputString->get_id(), 0, 0);
 	EXPECT_TRUE(inputList->get_is_valid(objects));
 
@@ -1132,7 +1136,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputListTests)
 	// Add an invalid object, a Soft Key Mask
 	auto softKeyMask = std::make_shared<SoftKeyMask>();
 	softKeyMask->set_id(300);
-	objects[softKeyMask->get_id()] = softKeyMask;
+	objects.add_object(softKeyMask);
 	inputList->add_child(softKeyMask->get_id(), 0, 0);
 	EXPECT_FALSE(inputList->get_is_valid(objects));
 
@@ -1158,7 +1162,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputListTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputStringTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto outputString = std::make_shared<OutputString>();
 
 	run_baseline_tests(outputString.get());
@@ -1205,7 +1209,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputStringTests)
 	// Test output string font attribute
 	auto fontAttribute = std::make_shared<FontAttributes>();
 	fontAttribute->set_id(1); // Arbitrary
-	objects[fontAttribute->get_id()] = fontAttribute;
+	objects.add_object(fontAttribute);
 
 	// Add it
 	outputString->set_font_attributes(fontAttribute->get_id());
@@ -1214,7 +1218,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputStringTests)
 	// Now lets replace it with a different font attributes object using set_attribute
 	auto fontAttribute2 = std::make_shared<FontAttributes>();
 	fontAttribute2->set_id(2); // Arbitrary
-	objects[fontAttribute2->get_id()] = fontAttribute2;
+	objects.add_object(fontAttribute2);
 	EXPECT_TRUE(outputString->set_attribute(static_cast<std::uint8_t>(OutputString::AttributeName::FontAttributes), fontAttribute2->get_id(), objects, error));
 
 	// Test output string justification attribute
@@ -1226,14 +1230,14 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputStringTests)
 	EXPECT_EQ(outputString->get_vertical_justification(), OutputString::VerticalJustification::PositionTop);
 
 	outputString->set_id(100);
-	objects[outputString->get_id()] = outputString;
+	objects.add_object(outputString);
 
 	EXPECT_EQ(outputString->get_is_valid(objects), true);
 
 	// Add an invalid child, an Input String
 	auto inputString = std::make_shared<InputString>();
 	inputString->set_id(200);
-	objects[inputString->get_id()] = inputString;
+	objects.add_object(inputString);
 	outputString->set_font_attributes(inputString->get_id());
 	EXPECT_FALSE(outputString->get_is_valid(objects));
 
@@ -1265,7 +1269,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputStringTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputNumberTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto outputNumber = std::make_shared<OutputNumber>();
 
 	run_baseline_tests(outputNumber.get());
@@ -1317,7 +1321,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputNumberTests)
 	// Test output number font attribute
 	auto fontAttribute = std::make_shared<FontAttributes>();
 	fontAttribute->set_id(1); // Arbitrary
-	objects[fontAttribute->get_id()] = fontAttribute;
+	objects.add_object(fontAttribute);
 
 	// Add it
 	outputNumber->set_font_attributes(fontAttribute->get_id());
@@ -1326,7 +1330,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputNumberTests)
 	// Now lets replace it with a different font attributes object using set_attribute
 	auto fontAttribute2 = std::make_shared<FontAttributes>();
 	fontAttribute2->set_id(2); // Arbitrary
-	objects[fontAttribute2->get_id()] = fontAttribute2;
+	objects.add_object(fontAttribute2);
 	EXPECT_TRUE(outputNumber->set_attribute(static_cast<std::uint8_t>(OutputNumber::AttributeName::FontAttributes), fontAttribute2->get_id(), objects, error));
 
 	// Test output number justification attribute
@@ -1355,14 +1359,14 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputNumberTests)
 	EXPECT_EQ(outputNumber->get_value(), 6);
 
 	outputNumber->set_id(100);
-	objects[outputNumber->get_id()] = outputNumber;
+	objects.add_object(outputNumber);
 
 	EXPECT_TRUE(outputNumber->get_is_valid(objects));
 
 	// Add an invalid child, an Input Attributes
 	auto inputAttributes = std::make_shared<InputAttributes>();
 	inputAttributes->set_id(200);
-	objects[inputAttributes->get_id()] = inputAttributes;
+	objects.add_object(inputAttributes);
 	outputNumber->set_font_attributes(inputAttributes->get_id());
 	EXPECT_FALSE(outputNumber->get_is_valid(objects));
 
@@ -1403,7 +1407,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputNumberTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputListTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto outputList = std::make_shared<OutputList>();
 
 	run_baseline_tests(outputList.get());
@@ -1452,21 +1456,21 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputListTests)
 
 	// Test validity with some real objects
 	outputList->set_id(100);
-	objects[outputList->get_id()] = outputList;
+	objects.add_object(outputList);
 
 	// Create 4 output strings
 	auto outputString1 = std::make_shared<OutputString>();
 	outputString1->set_id(1);
-	objects[outputString1->get_id()] = outputString1;
+	objects.add_object(outputString1);
 	auto outputString2 = std::make_shared<OutputString>();
 	outputString2->set_id(2);
-	objects[outputString2->get_id()] = outputString2;
+	objects.add_object(outputString2);
 	auto outputString3 = std::make_shared<OutputString>();
 	outputString3->set_id(3);
-	objects[outputString3->get_id()] = outputString3;
+	objects.add_object(outputString3);
 	auto outputString4 = std::make_shared<OutputString>();
 	outputString4->set_id(4);
-	objects[outputString4->get_id()] = outputString4;
+	objects.add_object(outputString4);
 
 	// Add the valid children and test validity
 	outputList->add_child(outputString1->get_id(), 0, 0);
@@ -1482,7 +1486,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputListTests)
 	// Add an invalid obejct, a Data Mask object
 	auto dataMask = std::make_shared<DataMask>();
 	dataMask->set_id(200);
-	objects[dataMask->get_id()] = dataMask;
+	objects.add_object(dataMask);
 	outputList->add_child(dataMask->get_id(), 0, 0);
 	EXPECT_FALSE(outputList->get_is_valid(objects));
 
@@ -1516,7 +1520,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputListTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputLineTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto outputLine = std::make_shared<OutputLine>();
 
 	run_baseline_tests(outputLine.get());
@@ -1547,7 +1551,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputLineTests)
 	// Test output line line attribute
 	auto lineAttribute = std::make_shared<LineAttributes>();
 	lineAttribute->set_id(1); // Arbitrary
-	objects[lineAttribute->get_id()] = lineAttribute;
+	objects.add_object(lineAttribute);
 
 	// Add it
 	outputLine->set_line_attributes(lineAttribute->get_id());
@@ -1555,7 +1559,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputLineTests)
 	// Now lets replace it with a different line attributes object using set_attribute
 	auto lineAttribute2 = std::make_shared<LineAttributes>();
 	lineAttribute2->set_id(2); // Arbitrary
-	objects[lineAttribute2->get_id()] = lineAttribute2;
+	objects.add_object(lineAttribute2);
 	EXPECT_TRUE(outputLine->set_attribute(static_cast<std::uint8_t>(OutputLine::AttributeName::LineAttributes), lineAttribute2->get_id(), objects, error));
 
 	EXPECT_EQ(outputLine->get_line_attributes(), lineAttribute2->get_id()); // Now the 2nd line attribute should be used for the line attributes
@@ -1564,14 +1568,14 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputLineTests)
 	EXPECT_EQ(OutputLine::LineDirection::BottomLeftToTopRight, outputLine->get_line_direction());
 
 	outputLine->set_id(100);
-	objects[outputLine->get_id()] = outputLine;
+	objects.add_object(outputLine);
 
 	EXPECT_TRUE(outputLine->get_is_valid(objects));
 
 	// Add an invalid line attributes object, an Input Attributes object
 	auto inputAttributes = std::make_shared<InputAttributes>();
 	inputAttributes->set_id(200);
-	objects[inputAttributes->get_id()] = inputAttributes;
+	objects.add_object(inputAttributes);
 	outputLine->set_line_attributes(inputAttributes->get_id());
 	EXPECT_FALSE(outputLine->get_is_valid(objects));
 
@@ -1597,7 +1601,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputLineTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputRectangleTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto outputRectangle = std::make_shared<OutputRectangle>();
 
 	run_baseline_tests(outputRectangle.get());
@@ -1624,7 +1628,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputRectangleTests)
 	// Test output rectangle line attribute
 	auto lineAttribute = std::make_shared<LineAttributes>();
 	lineAttribute->set_id(1); // Arbitrary
-	objects[lineAttribute->get_id()] = lineAttribute;
+	objects.add_object(lineAttribute);
 
 	// Add it
 	outputRectangle->set_line_attributes(lineAttribute->get_id());
@@ -1633,7 +1637,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputRectangleTests)
 	// Now lets replace it with a different line attributes object using set_attribute
 	auto lineAttribute2 = std::make_shared<LineAttributes>();
 	lineAttribute2->set_id(2); // Arbitrary
-	objects[lineAttribute2->get_id()] = lineAttribute2;
+	objects.add_object(lineAttribute2);
 	EXPECT_TRUE(outputRectangle->set_attribute(static_cast<std::uint8_t>(OutputRectangle::AttributeName::LineAttributes), lineAttribute2->get_id(), objects, error));
 	EXPECT_EQ(outputRectangle->get_line_attributes(), lineAttribute2->get_id()); // Now the 2nd line attribute should be used for the line attributes
 
@@ -1649,7 +1653,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputRectangleTests)
 	EXPECT_EQ(16, outputRectangle->get_child_y(0));
 
 	outputRectangle->set_id(100);
-	objects[outputRectangle->get_id()] = outputRectangle;
+	objects.add_object(outputRectangle);
 
 	outputRectangle->remove_child(1, 15, 16);
 	outputRectangle->remove_child(2, 20, 50);
@@ -1658,7 +1662,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputRectangleTests)
 	// Add an invalid object, a Data Mask
 	auto dataMask = std::make_shared<DataMask>();
 	dataMask->set_id(200);
-	objects[dataMask->get_id()] = dataMask;
+	objects.add_object(dataMask);
 	outputRectangle->set_line_attributes(dataMask->get_id());
 	EXPECT_FALSE(outputRectangle->get_is_valid(objects));
 
@@ -1694,7 +1698,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputRectangleTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputEllipseTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto outputEllipse = std::make_shared<OutputEllipse>();
 
 	run_baseline_tests(outputEllipse.get());
@@ -1736,7 +1740,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputEllipseTests)
 	// Test output ellipse line attribute
 	auto lineAttribute = std::make_shared<LineAttributes>();
 	lineAttribute->set_id(1); // Arbitrary
-	objects[lineAttribute->get_id()] = lineAttribute;
+	objects.add_object(lineAttribute);
 
 	// Add it
 	outputEllipse->set_line_attributes(lineAttribute->get_id());
@@ -1744,14 +1748,14 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputEllipseTests)
 	// Now lets replace it with a different line attributes object using set_attribute
 	auto lineAttribute2 = std::make_shared<LineAttributes>();
 	lineAttribute2->set_id(2); // Arbitrary
-	objects[lineAttribute2->get_id()] = lineAttribute2;
+	objects.add_object(lineAttribute2);
 	EXPECT_TRUE(outputEllipse->set_attribute(static_cast<std::uint8_t>(OutputEllipse::AttributeName::LineAttributes), lineAttribute2->get_id(), objects, error));
 	EXPECT_EQ(outputEllipse->get_line_attributes(), lineAttribute2->get_id()); // Now the 2nd line attribute should be used for the line attributes
 
 	// Test output ellipse fill attribute
 	auto fillAttribute = std::make_shared<FillAttributes>();
 	fillAttribute->set_id(3); // Arbitrary
-	objects[fillAttribute->get_id()] = fillAttribute;
+	objects.add_object(fillAttribute);
 
 	// Add it
 	outputEllipse->set_fill_attributes(fillAttribute->get_id());
@@ -1759,19 +1763,19 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputEllipseTests)
 	// Now lets replace it with a different fill attributes object using set_attribute
 	auto fillAttribute2 = std::make_shared<FillAttributes>();
 	fillAttribute2->set_id(4); // Arbitrary
-	objects[fillAttribute2->get_id()] = fillAttribute2;
+	objects.add_object(fillAttribute2);
 	EXPECT_TRUE(outputEllipse->set_attribute(static_cast<std::uint8_t>(OutputEllipse::AttributeName::FillAttributes), fillAttribute2->get_id(), objects, error));
 	EXPECT_EQ(outputEllipse->get_fill_attributes(), fillAttribute2->get_id()); // Now the 2nd fill attribute should be used for the line attributes
 
 	outputEllipse->set_id(100);
-	objects[outputEllipse->get_id()] = outputEllipse;
+	objects.add_object(outputEllipse);
 
 	EXPECT_TRUE(outputEllipse->get_is_valid(objects));
 
 	// Add an invalid object, an alarm mask
 	auto alarmMask = std::make_shared<AlarmMask>();
 	alarmMask->set_id(200);
-	objects[alarmMask->get_id()] = alarmMask;
+	objects.add_object(alarmMask);
 	outputEllipse->set_fill_attributes(alarmMask->get_id());
 	EXPECT_FALSE(outputEllipse->get_is_valid(objects));
 
@@ -1806,7 +1810,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputEllipseTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputPolygonTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto outputPolygon = std::make_shared<OutputPolygon>();
 
 	run_baseline_tests(outputPolygon.get());
@@ -1833,7 +1837,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputPolygonTests)
 	// Test output polygon line attribute
 	auto lineAttribute = std::make_shared<LineAttributes>();
 	lineAttribute->set_id(1); // Arbitrary
-	objects[lineAttribute->get_id()] = lineAttribute;
+	objects.add_object(lineAttribute);
 
 	// Add it
 	outputPolygon->set_line_attributes(lineAttribute->get_id());
@@ -1841,14 +1845,14 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputPolygonTests)
 	// Now lets replace it with a different line attributes object using set_attribute
 	auto lineAttribute2 = std::make_shared<LineAttributes>();
 	lineAttribute2->set_id(2); // Arbitrary
-	objects[lineAttribute2->get_id()] = lineAttribute2;
+	objects.add_object(lineAttribute2);
 	EXPECT_TRUE(outputPolygon->set_attribute(static_cast<std::uint8_t>(OutputPolygon::AttributeName::LineAttributes), lineAttribute2->get_id(), objects, error));
 	EXPECT_EQ(outputPolygon->get_line_attributes(), lineAttribute2->get_id()); // Now the 2nd line attribute should be used for the line attributes
 
 	// Test output polygon fill attribute
 	auto fillAttribute = std::make_shared<FillAttributes>();
 	fillAttribute->set_id(3); // Arbitrary
-	objects[fillAttribute->get_id()] = fillAttribute;
+	objects.add_object(fillAttribute);
 
 	// Add it
 	outputPolygon->set_fill_attributes(fillAttribute->get_id());
@@ -1856,19 +1860,19 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputPolygonTests)
 	// Now lets replace it with a different fill attributes object using set_attribute
 	auto fillAttribute2 = std::make_shared<FillAttributes>();
 	fillAttribute2->set_id(4); // Arbitrary
-	objects[fillAttribute2->get_id()] = fillAttribute2;
+	objects.add_object(fillAttribute2);
 	EXPECT_TRUE(outputPolygon->set_attribute(static_cast<std::uint8_t>(OutputPolygon::AttributeName::FillAttributes), fillAttribute2->get_id(), objects, error));
 	EXPECT_EQ(outputPolygon->get_fill_attributes(), fillAttribute2->get_id()); // Now the 2nd fill attribute should be used for the line attributes
 
 	outputPolygon->set_id(100);
-	objects[outputPolygon->get_id()] = outputPolygon;
+	objects.add_object(outputPolygon);
 
 	EXPECT_TRUE(outputPolygon->get_is_valid(objects));
 
 	// Add an invalid object, an alarm mask
 	auto alarmMask = std::make_shared<AlarmMask>();
 	alarmMask->set_id(200);
-	objects[alarmMask->get_id()] = alarmMask;
+	objects.add_object(alarmMask);
 	outputPolygon->set_fill_attributes(alarmMask->get_id());
 	EXPECT_FALSE(outputPolygon->get_is_valid(objects));
 
@@ -1918,7 +1922,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputPolygonTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputMeterTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto outputMeter = std::make_shared<OutputMeter>();
 
 	run_baseline_tests(outputMeter.get());
@@ -1985,14 +1989,14 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputMeterTests)
 	EXPECT_TRUE(outputMeter->get_option(OutputMeter::Options::DeflectionDirection));
 
 	outputMeter->set_id(100);
-	objects[outputMeter->get_id()] = outputMeter;
+	objects.add_object(outputMeter);
 
 	EXPECT_TRUE(outputMeter->get_is_valid(objects));
 
 	// Add an invalid object, a container
 	auto container = std::make_shared<Container>();
 	container->set_id(200);
-	objects[container->get_id()] = container;
+	objects.add_object(container);
 	outputMeter->add_child(container->get_id(), 0, 0);
 	EXPECT_FALSE(outputMeter->get_is_valid(objects));
 
@@ -2039,7 +2043,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputMeterTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputLinearBarGraphTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	OutputLinearBarGraph outputLinearBarGraph;
 
 	run_baseline_tests(&outputLinearBarGraph);
@@ -2133,7 +2137,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputLinearBarGraphTests)
 	// Create and add a number variable so that the test for setting the variable reference passes
 	auto numberVariable = std::make_shared<NumberVariable>();
 	numberVariable->set_id(100);
-	objects[numberVariable->get_id()] = numberVariable;
+	objects.add_object(numberVariable);
 
 	EXPECT_TRUE(outputLinearBarGraph.set_attribute(static_cast<std::uint8_t>(OutputLinearBarGraph::AttributeName::VariableReference), 100, objects, error));
 	EXPECT_TRUE(outputLinearBarGraph.get_attribute(static_cast<std::uint8_t>(OutputLinearBarGraph::AttributeName::VariableReference), testValue));
@@ -2151,7 +2155,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputLinearBarGraphTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputArchedBarGraphTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	OutputArchedBarGraph outputArchedBarGraph;
 
 	run_baseline_tests(&outputArchedBarGraph);
@@ -2273,7 +2277,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, OutputArchedBarGraphTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, PictureGraphicTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	PictureGraphic pictureGraphic;
 
 	run_baseline_tests(&pictureGraphic);
@@ -2365,7 +2369,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, PictureGraphicTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, NumberVariableTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	NumberVariable numberVariable;
 
 	run_baseline_tests(&numberVariable);
@@ -2400,7 +2404,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, NumberVariableTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, StringVariableTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	StringVariable stringVariable;
 
 	run_baseline_tests(&stringVariable);
@@ -2426,7 +2430,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, StringVariableTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, FontAttributesTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	FontAttributes fontAttributes;
 
 	run_baseline_tests(&fontAttributes);
@@ -2543,7 +2547,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, FontAttributesTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, LineAttributesTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	LineAttributes lineAttributes;
 
 	run_baseline_tests(&lineAttributes);
@@ -2590,12 +2594,12 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, LineAttributesTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, FillAttributesTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	FillAttributes fillAttributes;
 	auto fillPattern = std::make_shared<PictureGraphic>();
 
 	fillPattern->set_id(3);
-	objects[fillPattern->get_id()] = fillPattern;
+	objects.add_object(fillPattern);
 
 	run_baseline_tests(&fillAttributes);
 	EXPECT_EQ(fillAttributes.get_object_type(), VirtualTerminalObjectType::FillAttributes);
@@ -2638,7 +2642,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, FillAttributesTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputAttributesTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	InputAttributes inputAttributes;
 
 	run_baseline_tests(&inputAttributes);
@@ -2676,7 +2680,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, InputAttributesTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ExtendedInputAttributesTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	ExtendedInputAttributes extendedInputAttributes;
 
 	run_baseline_tests(&extendedInputAttributes);
@@ -2708,7 +2712,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ExtendedInputAttributesTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, MacroTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	Macro macro;
 
 	run_baseline_tests(&macro);
@@ -2749,7 +2753,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, MacroTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ColourMapTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	ColourMap colourMap;
 
 	run_baseline_tests(&colourMap);
@@ -2785,7 +2789,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ColourMapTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, WindowMaskTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto windowMask = std::make_shared<WindowMask>();
 
 	run_baseline_tests(windowMask.get());
@@ -2832,12 +2836,12 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, WindowMaskTests)
 	EXPECT_FALSE(windowMask->get_is_valid(objects));
 
 	windowMask->set_id(50);
-	objects[windowMask->get_id()] = windowMask;
+	objects.add_object(windowMask);
 
 	// Add a valid title object
 	auto title = std::make_shared<OutputString>();
 	title->set_id(100);
-	objects[title->get_id()] = title;
+	objects.add_object(title);
 	windowMask->set_title_object_id(100);
 
 	// Should still be invalid because we have no name
@@ -2846,7 +2850,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, WindowMaskTests)
 	// Add a name
 	auto name = std::make_shared<OutputString>();
 	name->set_id(101);
-	objects[name->get_id()] = name;
+	objects.add_object(name);
 	EXPECT_TRUE(windowMask->set_attribute(static_cast<std::uint8_t>(WindowMask::AttributeName::Name), name->get_id(), objects, error));
 
 	// Should still be invalid because we have no icon
@@ -2855,7 +2859,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, WindowMaskTests)
 	// Add an icon
 	auto icon = std::make_shared<PictureGraphic>();
 	icon->set_id(102);
-	objects[icon->get_id()] = icon;
+	objects.add_object(icon);
 	windowMask->set_icon_object_id(102);
 
 	// Because this is an input number window mask, it should still be invalid until we add an input number as a child
@@ -2864,7 +2868,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, WindowMaskTests)
 	// Add an input number
 	auto inputNumber = std::make_shared<InputNumber>();
 	inputNumber->set_id(103);
-	objects[inputNumber->get_id()] = inputNumber;
+	objects.add_object(inputNumber);
 	windowMask->add_child(inputNumber->get_id(), 0, 0);
 
 	// Now it should be valid
@@ -2879,7 +2883,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, WindowMaskTests)
 	// Add a units object
 	auto units = std::make_shared<OutputString>();
 	units->set_id(104);
-	objects[units->get_id()] = units;
+	objects.add_object(units);
 	windowMask->add_child(104, 0, 0);
 
 	// Now it should be valid again
@@ -2901,7 +2905,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, WindowMaskTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ExternalObjectPointerTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto externalObject = std::make_shared<ExternalObjectPointer>();
 
 	run_baseline_tests(externalObject.get());
@@ -2957,7 +2961,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ExternalObjectPointerTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ObjectPointerTests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto externalObject = std::make_shared<ObjectPointer>();
 
 	run_baseline_tests(externalObject.get());
@@ -2978,7 +2982,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ObjectPointerTests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryInputType1Tests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto auxiliaryInput = std::make_shared<AuxiliaryInputType1>();
 
 	run_baseline_tests(auxiliaryInput.get());
@@ -3004,12 +3008,12 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryInputType1Tests)
 	EXPECT_EQ(testValue, static_cast<std::uint8_t>(VirtualTerminalObjectType::AuxiliaryInputType1));
 
 	auxiliaryInput->set_id(5);
-	objects[auxiliaryInput->get_id()] = auxiliaryInput;
+	objects.add_object(auxiliaryInput);
 
 	// Add a valid object, an output rectangle
 	auto outputRectangle = std::make_shared<OutputRectangle>();
 	outputRectangle->set_id(10);
-	objects[outputRectangle->get_id()] = outputRectangle;
+	objects.add_object(outputRectangle);
 
 	auxiliaryInput->add_child(outputRectangle->get_id(), 0, 0);
 
@@ -3018,7 +3022,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryInputType1Tests)
 	// Add an invalid object, a data mask
 	auto dataMask = std::make_shared<DataMask>();
 	dataMask->set_id(11);
-	objects[dataMask->get_id()] = dataMask;
+	objects.add_object(dataMask);
 
 	auxiliaryInput->add_child(dataMask->get_id(), 0, 0);
 
@@ -3027,7 +3031,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryInputType1Tests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryInputType2Tests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto auxiliaryInput = std::make_shared<AuxiliaryInputType2>();
 
 	run_baseline_tests(auxiliaryInput.get());
@@ -3070,12 +3074,12 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryInputType2Tests)
 
 	// Test validity
 	auxiliaryInput->set_id(5);
-	objects[auxiliaryInput->get_id()] = auxiliaryInput;
+	objects.add_object(auxiliaryInput);
 
 	// Add a valid object, an output rectangle
 	auto outputRectangle = std::make_shared<OutputRectangle>();
 	outputRectangle->set_id(10);
-	objects[outputRectangle->get_id()] = outputRectangle;
+	objects.add_object(outputRectangle);
 
 	auxiliaryInput->add_child(outputRectangle->get_id(), 0, 0);
 
@@ -3084,7 +3088,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryInputType2Tests)
 	// Add an invalid object, a data mask
 	auto dataMask = std::make_shared<DataMask>();
 	dataMask->set_id(11);
-	objects[dataMask->get_id()] = dataMask;
+	objects.add_object(dataMask);
 
 	auxiliaryInput->add_child(dataMask->get_id(), 0, 0);
 
@@ -3093,7 +3097,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryInputType2Tests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryFunctionType1Tests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto auxiliaryFunction = std::make_shared<AuxiliaryFunctionType1>();
 
 	run_baseline_tests(auxiliaryFunction.get());
@@ -3115,7 +3119,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryFunctionType1Tests)
 	// Add a valid object, an output rectangle
 	auto outputRectangle = std::make_shared<OutputRectangle>();
 	outputRectangle->set_id(10);
-	objects[outputRectangle->get_id()] = outputRectangle;
+	objects.add_object(outputRectangle);
 
 	auxiliaryFunction->add_child(outputRectangle->get_id(), 0, 0);
 
@@ -3124,7 +3128,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryFunctionType1Tests)
 	// Add an invalid object, a data mask
 	auto dataMask = std::make_shared<DataMask>();
 	dataMask->set_id(11);
-	objects[dataMask->get_id()] = dataMask;
+	objects.add_object(dataMask);
 
 	auxiliaryFunction->add_child(dataMask->get_id(), 0, 0);
 
@@ -3133,7 +3137,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryFunctionType1Tests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryFunctionType2Tests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto auxiliaryFunction = std::make_shared<AuxiliaryFunctionType2>();
 
 	run_baseline_tests(auxiliaryFunction.get());
@@ -3171,12 +3175,12 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryFunctionType2Tests)
 
 	// Test validity
 	auxiliaryFunction->set_id(5);
-	objects[auxiliaryFunction->get_id()] = auxiliaryFunction;
+	objects.add_object(auxiliaryFunction);
 
 	// Add a valid object, an output rectangle
 	auto outputRectangle = std::make_shared<OutputRectangle>();
 	outputRectangle->set_id(10);
-	objects[outputRectangle->get_id()] = outputRectangle;
+	objects.add_object(outputRectangle);
 
 	auxiliaryFunction->add_child(outputRectangle->get_id(), 0, 0);
 
@@ -3185,7 +3189,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryFunctionType2Tests)
 	// Add an invalid object, a data mask
 	auto dataMask = std::make_shared<DataMask>();
 	dataMask->set_id(11);
-	objects[dataMask->get_id()] = dataMask;
+	objects.add_object(dataMask);
 
 	auxiliaryFunction->add_child(dataMask->get_id(), 0, 0);
 
@@ -3194,7 +3198,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryFunctionType2Tests)
 
 TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryControlDesignatorType2Tests)
 {
-	std::map<std::uint16_t, std::shared_ptr<VTObject>> objects;
+	VTObjectPool objects;
 	auto auxiliaryControlDesignator = std::make_shared<AuxiliaryControlDesignatorType2>();
 
 	run_baseline_tests(auxiliaryControlDesignator.get());
@@ -3206,15 +3210,15 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryControlDesignatorType2Tests)
 
 	uint32_t testValue = 0;
 	auxiliaryControlDesignator->set_id(10);
-	objects[auxiliaryControlDesignator->get_id()] = auxiliaryControlDesignator;
+	objects.add_object(auxiliaryControlDesignator);
 
 	auto testChild1 = std::make_shared<isobus::AuxiliaryFunctionType2>();
 	testChild1->set_id(100);
-	objects[testChild1->get_id()] = testChild1;
+	objects.add_object(testChild1);
 
 	auto testChild2 = std::make_shared<isobus::AuxiliaryInputType2>();
 	testChild2->set_id(200);
-	objects[testChild2->get_id()] = testChild2;
+	objects.add_object(testChild2);
 
 	EXPECT_TRUE(auxiliaryControlDesignator->set_attribute(static_cast<std::uint8_t>(AuxiliaryControlDesignatorType2::AttributeName::AuxiliaryObjectID), 100, objects, error));
 	EXPECT_EQ(100, auxiliaryControlDesignator->get_auxiliary_object_id());
@@ -3223,7 +3227,7 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryControlDesignatorType2Tests)
 
 	auto testChild3 = std::make_shared<isobus::DataMask>();
 	testChild3->set_id(300);
-	objects[testChild3->get_id()] = testChild3;
+	objects.add_object(testChild3);
 
 	EXPECT_FALSE(auxiliaryControlDesignator->set_attribute(static_cast<std::uint8_t>(AuxiliaryControlDesignatorType2::AttributeName::AuxiliaryObjectID), 300, objects, error));
 	EXPECT_EQ(200, auxiliaryControlDesignator->get_auxiliary_object_id());
@@ -3237,3 +3241,250 @@ TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, AuxiliaryControlDesignatorType2Tests)
 	auxiliaryControlDesignator->get_attribute(static_cast<std::uint8_t>(AuxiliaryControlDesignatorType2::AttributeName::PointerType), testValue);
 	EXPECT_EQ(3, testValue);
 }
+
+TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ObjectPoolContainerTests)
+{
+	VTObjectPool objects;
+	EXPECT_TRUE(objects.empty());
+	EXPECT_FALSE(objects.add_object(nullptr));
+	EXPECT_EQ(nullptr, objects.get_object_by_id(0));
+	EXPECT_EQ(nullptr, objects.get_object_by_id(NULL_OBJECT_ID));
+
+	// Build a pool of containers that each hold a large number of other containers
+	constexpr std::uint16_t NUMBER_OF_MASKS = 10;
+	constexpr std::uint16_t CONTAINERS_PER_MASK = 300;
+
+	for (std::uint16_t i = 0; i < NUMBER_OF_MASKS; i++)
+	{
+		auto mask = std::make_shared<Container>();
+		mask->set_id(i);
+
+		for (std::uint16_t j = 0; j < CONTAINERS_PER_MASK; j++)
+		{
+			auto container = std::make_shared<Container>();
+			container->set_id(static_cast<std::uint16_t>(1000 + (i * CONTAINERS_PER_MASK) + j));
+			container->set_width(10);
+			container->set_height(10);
+			EXPECT_TRUE(objects.add_object(container));
+			mask->add_child(container->get_id(), 0, 0);
+		}
+		EXPECT_TRUE(objects.add_object(mask));
+	}
+	EXPECT_EQ(NUMBER_OF_MASKS * (CONTAINERS_PER_MASK + 1), objects.size());
+
+	// Validate the whole pool, which looks up every child by ID
+	for (const auto &object : objects)
+	{
+		EXPECT_TRUE(object->get_is_valid(objects));
+	}
+
+	// Lookups hand out the object owned by the pool
+	auto lookedUpObject = objects.get_object_by_id(1005);
+	ASSERT_NE(nullptr, lookedUpObject);
+	EXPECT_EQ(1005, lookedUpObject->get_id());
+	EXPECT_EQ(VirtualTerminalObjectType::Container, lookedUpObject->get_object_type());
+	EXPECT_EQ(lookedUpObject, objects.get_shared_object_by_id(1005).get());
+	EXPECT_EQ(lookedUpObject, VTObject::get_object_by_id(1005, objects));
+
+	// Adding an object with an existing ID replaces it
+	auto replacement = std::make_shared<SoftKeyMask>();
+	replacement->set_id(1005);
+	EXPECT_TRUE(objects.add_object(replacement));
+	EXPECT_EQ(NUMBER_OF_MASKS * (CONTAINERS_PER_MASK + 1), objects.size());
+	EXPECT_EQ(replacement.get(), objects.get_object_by_id(1005));
+
+	// Removing an object keeps every other object reachable
+	EXPECT_TRUE(objects.remove_object(9));
+	EXPECT_FALSE(objects.remove_object(9));
+	EXPECT_FALSE(objects.contains(9));
+	EXPECT_EQ(NUMBER_OF_MASKS * (CONTAINERS_PER_MASK + 1) - 1, objects.size());
+
+	for (const auto &object : objects)
+	{
+		EXPECT_EQ(object.get(), objects.get_object_by_id(object->get_id()));
+	}
+
+	// The replaced child has a type a container can't hold
+	ASSERT_NE(nullptr, objects.get_object_by_id(0));
+	EXPECT_FALSE(objects.get_object_by_id(0)->get_is_valid(objects));
+	EXPECT_TRUE(objects.get_object_by_id(1)->get_is_valid(objects));
+
+	objects.clear();
+	EXPECT_TRUE(objects.empty());
+	EXPECT_FALSE(objects.contains(1005));
+}
+
+static std::vector<std::uint8_t> read_example_pool(const std::string &path)
+{
+	std::vector<std::uint8_t> retVal = IOPFileInterface::read_iop_file("../../examples/" + path);
+
+	if (retVal.empty())
+	{
+		// Try again with a different path, depending on where the tests are run from
+		retVal = IOPFileInterface::read_iop_file("../examples/" + path);
+	}
+	return retVal;
+}
+
+TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ObjectPoolParserExamplePools)
+{
+	const std::vector<std::string> examplePools = {
+		"virtual_terminal/version3_object_pool/VT3TestPool.iop",
+		"virtual_terminal/esp32_platformio_object_pool/src/object_pool/object_pool.iop",
+		"virtual_terminal/aux_functions/aux_functions_pooldata.iop",
+		"virtual_terminal/aux_inputs/aux_inputs_pooldata.iop",
+		"seeder_example/BasePool.iop"
+	};
+
+	for (const auto &path : examplePools)
+	{
+		std::vector<std::uint8_t> iopData = read_example_pool(path);
+		ASSERT_FALSE(iopData.empty()) << path;
+
+		VTObjectPool objects;
+		auto result = VTObjectPoolParser::parse(DataSpan<const std::uint8_t>(iopData.data(), iopData.size()), objects);
+		EXPECT_EQ(VTObjectPoolParser::Error::None, result.error) << path << " failed at offset " << result.errorOffset << ", object " << result.errorObjectID;
+		EXPECT_EQ(result.numberOfParsedObjects, objects.size()) << path;
+		EXPECT_NE(0, result.numberOfParsedObjects) << path;
+
+		// Every pool has exactly one working set
+		std::size_t numberOfWorkingSets = 0;
+		for (const auto &object : objects)
+		{
+			if (VirtualTerminalObjectType::WorkingSet == object->get_object_type())
+			{
+				numberOfWorkingSets++;
+			}
+		}
+		EXPECT_EQ(1, numberOfWorkingSets) << path;
+	}
+
+	// Spot check some objects in the version 3 test pool
+	std::vector<std::uint8_t> iopData = read_example_pool(examplePools.front());
+	VTObjectPool objects;
+	ASSERT_EQ(VTObjectPoolParser::Error::None, VTObjectPoolParser::parse(DataSpan<const std::uint8_t>(iopData.data(), iopData.size()), objects).error);
+
+	ASSERT_TRUE(objects.contains(0));
+	auto workingSet = static_cast<WorkingSet *>(objects.get_object_by_id(0));
+	EXPECT_EQ(VirtualTerminalObjectType::WorkingSet, workingSet->get_object_type());
+	ASSERT_TRUE(objects.contains(workingSet->get_active_mask()));
+	EXPECT_EQ(VirtualTerminalObjectType::DataMask, objects.get_object_by_id(workingSet->get_active_mask())->get_object_type());
+
+	// Parsing into a pool that already has the objects reports the duplicate
+	auto result = VTObjectPoolParser::parse(DataSpan<const std::uint8_t>(iopData.data(), iopData.size()), objects);
+	EXPECT_EQ(VTObjectPoolParser::Error::DuplicateObjectID, result.error);
+	EXPECT_EQ(0, result.errorOffset);
+	EXPECT_EQ(0, result.errorObjectID);
+}
+
+TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ObjectPoolParserMalformedPools)
+{
+	VTObjectPool objects;
+
+	// An object type that doesn't exist
+	const std::vector<std::uint8_t> unknownType = { 0x01, 0x00, 0x64, 0x00, 0x00 };
+	auto result = VTObjectPoolParser::parse(DataSpan<const std::uint8_t>(unknownType.data(), unknownType.size()), objects);
+	EXPECT_EQ(VTObjectPoolParser::Error::UnknownObjectType, result.error);
+	EXPECT_EQ(1, result.errorObjectID);
+	EXPECT_TRUE(objects.empty());
+
+	// A string variable that claims more characters than there are
+	const std::vector<std::uint8_t> truncatedString = { 0x02, 0x00, 0x16, 0x05, 0x00, 'a', 'b' };
+	result = VTObjectPoolParser::parse(DataSpan<const std::uint8_t>(truncatedString.data(), truncatedString.size()), objects);
+	EXPECT_EQ(VTObjectPoolParser::Error::Truncated, result.error);
+	EXPECT_EQ(2, result.errorObjectID);
+
+	// An object pointer to an object that isn't in the pool, followed by a number variable
+	const std::vector<std::uint8_t> danglingPointer = { 0x03, 0x00, 0x1B, 0x07, 0x00, 0x04, 0x00, 0x15, 0x01, 0x00, 0x00, 0x00 };
+	result = VTObjectPoolParser::parse(DataSpan<const std::uint8_t>(danglingPointer.data(), danglingPointer.size()), objects);
+	EXPECT_EQ(VTObjectPoolParser::Error::InvalidObject, result.error);
+	EXPECT_EQ(3, result.errorObjectID);
+	EXPECT_EQ(2, result.numberOfParsedObjects);
+
+	// Without validation the same pool parses fine
+	objects.clear();
+	result = VTObjectPoolParser::parse(DataSpan<const std::uint8_t>(danglingPointer.data(), danglingPointer.size()), objects, false);
+	EXPECT_EQ(VTObjectPoolParser::Error::None, result.error);
+	EXPECT_EQ(2, objects.size());
+	ASSERT_TRUE(objects.contains(4));
+	EXPECT_EQ(1, static_cast<NumberVariable *>(objects.get_object_by_id(4))->get_value());
+
+	// A graphics context has no object class, so it is stepped over
+	std::vector<std::uint8_t> graphicsContext(34, 0);
+	graphicsContext[2] = static_cast<std::uint8_t>(VirtualTerminalObjectType::GraphicsContext);
+	objects.clear();
+	result = VTObjectPoolParser::parse(DataSpan<const std::uint8_t>(graphicsContext.data(), graphicsContext.size()), objects);
+	EXPECT_EQ(VTObjectPoolParser::Error::None, result.error);
+	EXPECT_EQ(0, result.numberOfParsedObjects);
+	EXPECT_EQ(1, result.numberOfSkippedObjects);
+
+	// A data mask that has the stepped over graphics context as a child
+	std::vector<std::uint8_t> maskWithGraphicsContext = { 0x05, 0x00, static_cast<std::uint8_t>(VirtualTerminalObjectType::DataMask), 0x00, 0xFF, 0xFF, 0x01, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00 };
+	graphicsContext[0] = 0x06;
+	maskWithGraphicsContext.insert(maskWithGraphicsContext.end(), graphicsContext.begin(), graphicsContext.end());
+	objects.clear();
+	result = VTObjectPoolParser::parse(DataSpan<const std::uint8_t>(maskWithGraphicsContext.data(), maskWithGraphicsContext.size()), objects);
+	EXPECT_EQ(VTObjectPoolParser::Error::None, result.error);
+	EXPECT_EQ(1, result.numberOfParsedObjects);
+	EXPECT_EQ(1, result.numberOfSkippedObjects);
+
+	// A stepped over object's ID still has to be unique
+	maskWithGraphicsContext.insert(maskWithGraphicsContext.end(), graphicsContext.begin(), graphicsContext.end());
+	objects.clear();
+	result = VTObjectPoolParser::parse(DataSpan<const std::uint8_t>(maskWithGraphicsContext.data(), maskWithGraphicsContext.size()), objects);
+	EXPECT_EQ(VTObjectPoolParser::Error::DuplicateObjectID, result.error);
+	EXPECT_EQ(6, result.errorObjectID);
+}
+
+TEST(VIRTUAL_TERMINAL_OBJECT_TESTS, ObjectPoolParserFuzzing)
+{
+	const std::vector<std::uint8_t> iopData = read_example_pool("virtual_terminal/version3_object_pool/VT3TestPool.iop");
+	ASSERT_FALSE(iopData.empty());
+
+	// Every truncation of a valid pool either parses, or reports the object that was cut off
+	for (std::size_t length = 0; length < iopData.size(); length += 1 + (iopData.size() / 150))
+	{
+		VTObjectPool objects;
+		auto result = VTObjectPoolParser::parse(DataSpan<const std::uint8_t>(iopData.data(), length), objects);
+
+		if (VTObjectPoolParser::Error::None != result.error)
+		{
+			EXPECT_LE(result.errorOffset, length);
+		}
+	}
+
+	// Randomly corrupted pools must never be read past their end. A fixed seed keeps failures reproducible.
+	std::mt19937 randomGenerator(11783);
+	std::uniform_int_distribution<std::size_t> offsetDistribution(0, iopData.size() - 1);
+	std::uniform_int_distribution<int> byteDistribution(0, 255);
+
+	for (std::size_t i = 0; i < 200; i++)
+	{
+		std::vector<std::uint8_t> corruptedData(iopData.begin(), iopData.begin() + static_cast<std::ptrdiff_t>(offsetDistribution(randomGenerator) + 1));
+
+		for (std::size_t j = 0; j < 8; j++)
+		{
+			corruptedData[offsetDistribution(randomGenerator) % corruptedData.size()] = static_cast<std::uint8_t>(byteDistribution(randomGenerator));
+		}
+
+		VTObjectPool objects;
+		auto result = VTObjectPoolParser::parse(DataSpan<const std::uint8_t>(corruptedData.data(), corruptedData.size()), objects);
+		EXPECT_LE(result.errorOffset, corruptedData.size());
+		EXPECT_EQ(result.numberOfParsedObjects, objects.size());
+	}
+
+	// Pure noise
+	for (std::size_t i = 0; i < 200; i++)
+	{
+		std::vector<std::uint8_t> noise(1 + (offsetDistribution(randomGenerator) % 512));
+
+		for (auto &byte : noise)
+		{
+			byte = static_cast<std::uint8_t>(byteDistribution(randomGenerator));
+		}
+
+		VTObjectPool objects;
+		auto result = VTObjectPoolParser::parse(DataSpan<const std::uint8_t>(noise.data(), noise.size()), objects);
+		EXPECT_LE(result.errorOffset, noise.size());
+	}
+}
@@ -10,6 +10,9 @@
 #ifndef IOP_FILE_INTERFACE_HPP
 #define IOP_FILE_INTERFACE_HPP
 
+#include "isobus/utility/data_span.hpp"
+
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -37,6 +40,107 @@ namespace isobus
 		/// @param[in] iopData The object pool to hash and generate a version for
 		/// @returns A 7 character string that is probably somewhat unique for this pool
 		static std::string hash_object_pool_to_version(std::vector<std::uint8_t> &iopData);
+
+		/// @brief Reads an object pool and generates a string version by hashing it
+		/// @details Produces the same version as the vector based overload.
+		/// @param[in] iopData A pointer to the object pool to hash
+		/// @param[in] size The size of the object pool in bytes
+		/// @returns A 7 character string that is probably somewhat unique for this pool
+		static std::string hash_object_pool_to_version(const std::uint8_t *iopData, std::size_t size);
+
+		//================================================================================================
+		/// @class VersionHasher
+		///
+		/// @brief Computes the same version as hash_object_pool_to_version, but one piece at a time
+		/// @details Useful to hash an object pool while it is being read or received, instead of
+		/// going over all of the data again afterwards.
+		//================================================================================================
+		class VersionHasher
+		{
+		public:
+			/// @brief Constructor for the hasher
+			/// @param[in] totalSize The size of the complete object pool in bytes, it is part of the hash
+			explicit VersionHasher(std::size_t totalSize);
+
+			/// @brief Adds the next piece of the object pool to the hash
+			/// @param[in] data A pointer to the next bytes of the object pool
+			/// @param[in] size The number of bytes to add
+			void update(const std::uint8_t *data, std::size_t size);
+
+			/// @brief Returns the version string for the data added so far
+			/// @returns A 7 character string that is probably somewhat unique for this pool
+			std::string get_version() const;
+
+		private:
+			std::size_t seed; ///< The running hash value
+		};
+	};
+
+	//================================================================================================
+	/// @class MappedIOPFile
+	///
+	/// @brief Provides read-only access to an IOP file without copying it into memory.
+	/// @details Where the platform supports it, the file is memory mapped, so the operating system
+	/// pages the object pool in while it is hashed and uploaded, and no heap buffer is needed.
+	/// The data can be given straight to the VT client with `set_object_pool`, as long as this object
+	/// outlives the upload. The version hash is computed in the same pass that loads the file.
+	/// On platforms without memory mapping the file is read into a buffer owned by this object instead.
+	//================================================================================================
+	class MappedIOPFile
+	{
+	public:
+		/// @brief Maps an IOP file given a file name/path
+		/// @param[in] filename A string filepath for the IOP file to map
+		explicit MappedIOPFile(const std::string &filename);
+
+		/// @brief Unmaps the file
+		~MappedIOPFile();
+
+		/// @brief Deleted copy constructor, the mapping can only have one owner
+		MappedIOPFile(const MappedIOPFile &) = delete;
+
+		/// @brief Deleted copy assignment, the mapping can only have one owner
+		/// @returns Nothing, this function is deleted
+		MappedIOPFile &operator=(const MappedIOPFile &) = delete;
+
+		/// @brief Move constructor
+		/// @param[in] other The mapping to take over, it will be invalid afterwards
+		MappedIOPFile(MappedIOPFile &&other) noexcept;
+
+		/// @brief Move assignment
+		/// @param[in] other The mapping to take over, it will be invalid afterwards
+		/// @returns A reference to this object
+		MappedIOPFile &operator=(MappedIOPFile &&other) noexcept;
+
+		/// @brief Returns if the file was loaded and is not empty
+		/// @returns `true` if the object pool can be used, otherwise `false`
+		bool is_valid() const;
+
+		/// @brief Returns a pointer to the start of the object pool
+		/// @returns A pointer to the object pool, or nullptr if the file could not be loaded
+		const std::uint8_t *data() const;
+
+		/// @brief Returns the size of the object pool
+		/// @returns The size of the object pool in bytes
+		std::size_t size() const;
+
+		/// @brief Returns the object pool as a span
+		/// @returns A read-only span over the object pool
+		DataSpan<const std::uint8_t> get_data() const;
+
+		/// @brief Returns the version of the object pool, computed while loading the file
+		/// @returns The same version string as IOPFileInterface::hash_object_pool_to_version would return
+		const std::string &get_version() const;
+
+	private:
+		/// @brief Releases the mapping or buffer, and resets this object to an invalid state
+		void close();
+
+		const std::uint8_t *mappedData = nullptr; ///< The start of the object pool
+		std::size_t mappedSize = 0; ///< The size of the object pool in bytes
+		void *mappingHandle = nullptr; ///< A platform specific handle to the mapping, if the platform needs one
+		std::vector<std::uint8_t> fallbackData; ///< Holds the object pool on platforms that can't map files
+		std::string version; ///< The version hash of the object pool
 	};
 }
 
@@ -10,6 +10,8 @@
 #define THREAD_SYNCHRONIZATION_HPP
 
 #if defined CAN_STACK_DISABLE_THREADS || defined ARDUINO
+#include <deque>
+#include <limits>
 #include <queue>
 
 namespace isobus
@@ -78,6 +80,13 @@ public:
 		return false;
 	}
 
+	/// @brief Get the number of items that can still be pushed to the queue.
+	/// @return Always returns the maximum size, since this version of the queue is not limited in size.
+	std::size_t available_space() const
+	{
+		return std::numeric_limits<std::size_t>::max();
+	}
+
 	/// @brief Clear the queue.
 	void clear()
 	{
@@ -88,10 +97,110 @@ private:
 	std::queue<T> queue; ///< The queue
 };
 
+/// @brief A template class for a bounded queue that may be pushed to from multiple threads, since threads are disabled this is a simple queue.
+/// @tparam T The item type for the queue.
+template<typename T>
+class LockFreeMultiProducerQueue
+{
+public:
+	/// @brief Constructor for the queue.
+	/// @param size The maximum number of items the queue can hold.
+	explicit LockFreeMultiProducerQueue(std::size_t size) :
+	  capacity(size > 0 ? size : 1)
+	{
+	}
+
+	/// @brief Push an item to the queue.
+	/// @param item The item to push to the queue.
+	/// @return True if the item was pushed to the queue, false if the queue is full.
+	bool push(const T &item)
+	{
+		if (queue.size() >= capacity)
+		{
+			return false;
+		}
+		queue.push_back(item);
+		return true;
+	}
+
+	/// @brief Peek at the next item in the queue.
+	/// @param item The item to peek at in the queue.
+	/// @return True if the item was peeked at in the queue, false if the queue is empty.
+	bool peek(T &item)
+	{
+		if (queue.empty())
+		{
+			return false;
+		}
+
+		item = queue.front();
+		return true;
+	}
+
+	/// @brief Pop an item from the queue.
+	/// @return True if the item was popped from the queue, false if the queue is empty.
+	bool pop()
+	{
+		if (queue.empty())
+		{
+			return false;
+		}
+
+		queue.pop_front();
+		return true;
+	}
+
+	/// @brief Peek at several items at the front of the queue.
+	/// @param items The buffer to copy the items to.
+	/// @param maxItems The maximum number of items to copy.
+	/// @return The number of items copied.
+	std::size_t peek_many(T *items, std::size_t maxItems)
+	{
+		std::size_t numberOfItems = 0;
+		while ((numberOfItems < maxItems) && (numberOfItems < queue.size()))
+		{
+			items[numberOfItems] = queue[numberOfItems];
+			numberOfItems++;
+		}
+		return numberOfItems;
+	}
+
+	/// @brief Pop several items from the queue.
+	/// @param numberOfItems The number of items to pop.
+	/// @return The number of items popped, which is less than requested if the queue ran empty.
+	std::size_t pop_many(std::size_t numberOfItems)
+	{
+		std::size_t numberPopped = 0;
+		while ((numberPopped < numberOfItems) && pop())
+		{
+			numberPopped++;
+		}
+		return numberPopped;
+	}
+
+	/// @brief Check if the queue is empty.
+	/// @return True if the queue is empty, false if the queue is not empty.
+	bool is_empty() const
+	{
+		return queue.empty();
+	}
+
+	/// @brief Clear the queue.
+	void clear()
+	{
+		queue.clear();
+	}
+
+private:
+	std::deque<T> queue; ///< The queue
+	const std::size_t capacity; ///< The maximum number of items in the queue
+};
+
 #else
 
 #include <atomic>
 #include <cassert>
+#include <memory>
 #include <mutex>
 #include <vector>
 namespace isobus
@@ -179,6 +288,14 @@ public:
 		return nextIndex(writeIndex.load(std::memory_order_acquire)) == readIndex.load(std::memory_order_acquire);
 	}
 
+	/// @brief Get the number of items that can still be pushed to the queue.
+	/// @return The number of items that can still be pushed to the queue.
+	std::size_t available_space() const
+	{
+		const auto usedSpace = (writeIndex.load(std::memory_order_acquire) + capacity - readIndex.load(std::memory_order_acquire)) % capacity;
+		return capacity - 1 - usedSpace;
+	}
+
 	/// @brief Clear the queue.
 	void clear()
 	{
@@ -201,6 +318,166 @@ private:
 	}
 };
 
+/// @brief A template class for a bounded lock free queue that may be pushed to from multiple threads.
+/// @details Only one thread may consume items (peek/pop/clear) at a time. Each slot carries a sequence number
+/// which tells producers if the slot is free for the position they claimed, and tells the consumer
+/// if the item in the slot has been completely written.
+/// @tparam T The item type for the queue.
+template<typename T>
+class LockFreeMultiProducerQueue
+{
+public:
+	/// @brief Constructor for the lock free queue.
+	/// @param size The maximum number of items the queue can hold.
+	explicit LockFreeMultiProducerQueue(std::size_t size) :
+	  buffer(new Slot[size > 0 ? size : 1]), capacity(size > 0 ? size : 1)
+	{
+		assert(size > 0 && "The size of the queue must be greater than 0.");
+		for (std::size_t i = 0; i < capacity; i++)
+		{
+			buffer[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	/// @brief Push an item to the queue, safe to call from multiple threads.
+	/// @param item The item to push to the queue.
+	/// @return True if the item was pushed to the queue, false if the queue is full.
+	bool push(const T &item)
+	{
+		auto position = writePosition.load(std::memory_order_relaxed);
+		Slot *slot = nullptr;
+
+		while (true)
+		{
+			slot = &buffer[position % capacity];
+			const auto sequence = slot->sequence.load(std::memory_order_acquire);
+
+			if (sequence == position)
+			{
+				// The slot is free, try to claim it
+				if (writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (sequence < position)
+			{
+				// The slot still holds an item from the previous lap, so the buffer is full.
+				return false;
+			}
+			else
+			{
+				// Another producer claimed this position first
+				position = writePosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		slot->item = item;
+		slot->sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// @brief Peek at the next item in the queue.
+	/// @param item The item to peek at in the queue.
+	/// @return True if the item was peeked at in the queue, false if the queue is empty.
+	bool peek(T &item)
+	{
+		const auto position = readPosition.load(std::memory_order_relaxed);
+		const Slot &slot = buffer[position % capacity];
+
+		if (slot.sequence.load(std::memory_order_acquire) != position + 1)
+		{
+			// The buffer is empty, or the next item is still being written.
+			return false;
+		}
+
+		item = slot.item;
+		return true;
+	}
+
+	/// @brief Pop an item from the queue.
+	/// @return True if the item was popped from the queue, false if the queue is empty.
+	bool pop()
+	{
+		const auto position = readPosition.load(std::memory_order_relaxed);
+		Slot &slot = buffer[position % capacity];
+
+		if (slot.sequence.load(std::memory_order_acquire) != position + 1)
+		{
+			// The buffer is empty, or the next item is still being written.
+			return false;
+		}
+
+		// Hand the slot back to the producers for the next lap
+		slot.sequence.store(position + capacity, std::memory_order_release);
+		readPosition.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// @brief Peek at several items at the front of the queue.
+	/// @param items The buffer to copy the items to.
+	/// @param maxItems The maximum number of items to copy.
+	/// @return The number of items copied, which stops at the first item that isn't completely written yet.
+	std::size_t peek_many(T *items, std::size_t maxItems)
+	{
+		const auto position = readPosition.load(std::memory_order_relaxed);
+		std::size_t numberOfItems = 0;
+
+		while ((numberOfItems < maxItems) && (numberOfItems < capacity))
+		{
+			const Slot &slot = buffer[(position + numberOfItems) % capacity];
+			if (slot.sequence.load(std::memory_order_acquire) != position + numberOfItems + 1)
+			{
+				break;
+			}
+			items[numberOfItems] = slot.item;
+			numberOfItems++;
+		}
+		return numberOfItems;
+	}
+
+	/// @brief Pop several items from the queue.
+	/// @param numberOfItems The number of items to pop.
+	/// @return The number of items popped, which is less than requested if the queue ran empty.
+	std::size_t pop_many(std::size_t numberOfItems)
+	{
+		std::size_t numberPopped = 0;
+		while ((numberPopped < numberOfItems) && pop())
+		{
+			numberPopped++;
+		}
+		return numberPopped;
+	}
+
+	/// @brief Check if the queue is empty.
+	/// @return True if the queue is empty, false if the queue is not empty.
+	bool is_empty() const
+	{
+		return readPosition.load(std::memory_order_acquire) == writePosition.load(std::memory_order_acquire);
+	}
+
+	/// @brief Clear the queue.
+	void clear()
+	{
+		while (pop())
+		{
+		}
+	}
+
+private:
+	/// @brief A slot in the circular buffer
+	struct Slot
+	{
+		std::atomic<std::size_t> sequence = { 0 }; ///< The position this slot is ready for, see the class details.
+		T item; ///< The item stored in the slot.
+	};
+
+	std::unique_ptr<Slot[]> buffer; ///< The buffer for the circular buffer.
+	std::atomic<std::size_t> readPosition = { 0 }; ///< The position of the next item to read, only advanced by the consumer.
+	std::atomic<std::size_t> writePosition = { 0 }; ///< The position of the next slot for producers to claim.
+	const std::size_t capacity; ///< The capacity of the circular buffer.
+};
+
 #endif
 
 #endif // THREAD_SYNCHRONIZATION_HPP
@@ -8,50 +8,277 @@
 //================================================================================================
 #include "isobus/utility/iop_file_interface.hpp"
 
+#include <array>
 #include <fstream>
-#include <iomanip>
-#include <iterator>
-#include <sstream>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace isobus
 {
+	namespace
+	{
+		/// @brief Holds the per-byte part of the version hash for every possible byte value
+		/// @details The hash mixes each byte on its own before combining it with the seed,
+		/// so that part can be looked up instead of computed for every byte of the pool.
+		struct VersionHashTable
+		{
+			VersionHashTable()
+			{
+				for (std::uint32_t i = 0; i < mixedBytes.size(); i++)
+				{
+					std::uint32_t x = i;
+					x = ((x >> 16) ^ x) * 0x45d9f3b;
+					x = ((x >> 16) ^ x) * 0x45d9f3b;
+					x = (x >> 16) ^ x;
+					mixedBytes[i] = x + 0x9e3779b9;
+				}
+			}
+
+			std::array<std::uint32_t, 256> mixedBytes; ///< The mixed value of each byte, with the golden ratio constant already added
+		};
+
+		const VersionHashTable &get_version_hash_table()
+		{
+			static const VersionHashTable table;
+			return table;
+		}
+	}
+
 	std::vector<std::uint8_t> IOPFileInterface::read_iop_file(const std::string &filename)
 	{
 		std::vector<std::uint8_t> retVal;
-		std::streampos fileSize;
 
 		std::ifstream file(filename, std::ios::binary);
 
 		if (file.is_open())
 		{
-			// Ignore newlines
-			file.unsetf(std::ios::skipws);
-
 			file.seekg(0, std::ios::end);
-			fileSize = file.tellg();
+			std::streamoff fileSize = file.tellg();
 			file.seekg(0, std::ios::beg);
 
-			retVal.reserve(fileSize);
-
-			// Read in the data
-			retVal.insert(retVal.begin(), std::istream_iterator<std::uint8_t>(file), std::istream_iterator<std::uint8_t>());
+			if (fileSize > 0)
+			{
+				// Read the whole file in one go, instead of extracting it byte by byte
+				retVal.resize(static_cast<std::size_t>(fileSize));
+				file.read(reinterpret_cast<char *>(retVal.data()), fileSize);
+				retVal.resize(static_cast<std::size_t>(file.gcount()));
+			}
 		}
 		return retVal;
 	}
 
 	std::string IOPFileInterface::hash_object_pool_to_version(std::vector<std::uint8_t> &iopData)
 	{
-		std::size_t seed = iopData.size();
-		std::stringstream stream;
+		return hash_object_pool_to_version(iopData.data(), iopData.size());
+	}
+
+	std::string IOPFileInterface::hash_object_pool_to_version(const std::uint8_t *iopData, std::size_t size)
+	{
+		VersionHasher hasher(size);
+		hasher.update(iopData, size);
+		return hasher.get_version();
+	}
+
+	IOPFileInterface::VersionHasher::VersionHasher(std::size_t totalSize) :
+	  seed(totalSize)
+	{
+	}
+
+	void IOPFileInterface::VersionHasher::update(const std::uint8_t *data, std::size_t size)
+	{
+		if (nullptr != data)
+		{
+			const auto &mixedBytes = get_version_hash_table().mixedBytes;
+
+			for (std::size_t i = 0; i < size; i++)
+			{
+				seed ^= mixedBytes[data[i]] + (seed << 6) + (seed >> 2);
+			}
+		}
+	}
+
+	std::string IOPFileInterface::VersionHasher::get_version() const
+	{
+		constexpr char HEX_DIGITS[] = "0123456789abcdef";
+		std::string retVal;
+		std::size_t remainingValue = seed;
+
+		// Format as lower case hex without leading zeros
+		do
+		{
+			retVal.insert(retVal.begin(), HEX_DIGITS[remainingValue & 0x0F]);
+			remainingValue >>= 4;
+		} while (0 != remainingValue);
+		return retVal;
+	}
+
+	MappedIOPFile::MappedIOPFile(const std::string &filename)
+	{
+#if defined(_WIN32)
+		HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+		if (INVALID_HANDLE_VALUE != file)
+		{
+			LARGE_INTEGER fileSize;
+
+			if ((0 != GetFileSizeEx(file, &fileSize)) && (fileSize.QuadPart > 0))
+			{
+				HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+				if (nullptr != mapping)
+				{
+					void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+					if (nullptr != view)
+					{
+						mappedData = static_cast<const std::uint8_t *>(view);
+						mappedSize = static_cast<std::size_t>(fileSize.QuadPart);
+						mappingHandle = mapping;
+					}
+					else
+					{
+						CloseHandle(mapping);
+					}
+				}
+			}
+			// The mapping keeps its own reference to the file
+			CloseHandle(file);
+		}
+#elif defined(__unix__) || defined(__APPLE__)
+		int fileDescriptor = open(filename.c_str(), O_RDONLY);
+
+		if (fileDescriptor >= 0)
+		{
+			struct stat fileStatus;
+
+			if ((0 == fstat(fileDescriptor, &fileStatus)) && (fileStatus.st_size > 0))
+			{
+				void *mapping = mmap(nullptr, static_cast<std::size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+
+				if (MAP_FAILED != mapping)
+				{
+					mappedData = static_cast<const std::uint8_t *>(mapping);
+					mappedSize = static_cast<std::size_t>(fileStatus.st_size);
+
+					// The pool is hashed and uploaded front to back, so let the kernel read ahead aggressively
+					madvise(mapping, mappedSize, MADV_SEQUENTIAL);
+				}
+			}
+			// The mapping keeps its own reference to the file
+			::close(fileDescriptor);
+		}
+#else
+		fallbackData = IOPFileInterface::read_iop_file(filename);
+
+		if (!fallbackData.empty())
+		{
+			mappedData = fallbackData.data();
+			mappedSize = fallbackData.size();
+		}
+#endif
+
+		if (nullptr != mappedData)
+		{
+			// This is the pass that pages in the file, so the upload afterwards doesn't have to wait on the disk
+			IOPFileInterface::VersionHasher hasher(mappedSize);
+			hasher.update(mappedData, mappedSize);
+			version = hasher.get_version();
+		}
+	}
+
+	MappedIOPFile::~MappedIOPFile()
+	{
+		close();
+	}
+
+	MappedIOPFile::MappedIOPFile(MappedIOPFile &&other) noexcept :
+	  mappedData(other.mappedData),
+	  mappedSize(other.mappedSize),
+	  mappingHandle(other.mappingHandle),
+	  fallbackData(std::move(other.fallbackData)),
+	  version(std::move(other.version))
+	{
+		other.mappedData = nullptr;
+		other.mappedSize = 0;
+		other.mappingHandle = nullptr;
+	}
+
+	MappedIOPFile &MappedIOPFile::operator=(MappedIOPFile &&other) noexcept
+	{
+		if (this != &other)
+		{
+			close();
+			mappedData = other.mappedData;
+			mappedSize = other.mappedSize;
+			mappingHandle = other.mappingHandle;
+			fallbackData = std::move(other.fallbackData);
+			version = std::move(other.version);
+			other.mappedData = nullptr;
+			other.mappedSize = 0;
+			other.mappingHandle = nullptr;
+		}
+		return *this;
+	}
 
-		for (std::uint32_t x : iopData)
+	bool MappedIOPFile::is_valid() const
+	{
+		return (nullptr != mappedData) && (0 != mappedSize);
+	}
+
+	const std::uint8_t *MappedIOPFile::data() const
+	{
+		return mappedData;
+	}
+
+	std::size_t MappedIOPFile::size() const
+	{
+		return mappedSize;
+	}
+
+	DataSpan<const std::uint8_t> MappedIOPFile::get_data() const
+	{
+		return DataSpan<const std::uint8_t>(mappedData, mappedSize);
+	}
+
+	const std::string &MappedIOPFile::get_version() const
+	{
+		return version;
+	}
+
+	void MappedIOPFile::close()
+	{
+#if defined(_WIN32)
+		if (nullptr != mappedData)
+		{
+			UnmapViewOfFile(mappedData);
+		}
+		if (nullptr != mappingHandle)
+		{
+			CloseHandle(static_cast<HANDLE>(mappingHandle));
+		}
+#elif defined(__unix__) || defined(__APPLE__)
+		if (nullptr != mappedData)
 		{
-			x = ((x >> 16) ^ x) * 0x45d9f3b;
-			x = ((x >> 16) ^ x) * 0x45d9f3b;
-			x = (x >> 16) ^ x;
-			seed ^= x + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			munmap(const_cast<std::uint8_t *>(mappedData), mappedSize);
 		}
-		stream << std::hex << seed;
-		return stream.str();
+#endif
+		mappedData = nullptr;
+		mappedSize = 0;
+		mappingHandle = nullptr;
+		fallbackData.clear();
+		version.clear();
 	}
 }